@@ -7,13 +7,31 @@ device management and pattern generation infrastructure while adding
 the stateful management needed for web API operations.
 """
 
+import io
 import threading
 import time
 from typing import Any
 
+import numpy as np
+from PIL import Image
+
+from bmd_sg.charts.color_types import (
+    ColorSpace,
+    ColorValue,
+    PatternType,
+    TransferFunction,
+)
+from bmd_sg.charts.loaders import load_chart
+from bmd_sg.charts.scene import ChartFileWatcher, ChartScene
 from bmd_sg.cli.shared import validate_color
 from bmd_sg.decklink.bmd_decklink import BMDDeckLink, DecklinkSettings
 from bmd_sg.image_generators.checkerboard import PatternGenerator
+from bmd_sg.image_generators.overlays import (
+    crosshair_sprite,
+    label_sprite,
+    marker_sprite,
+)
+from bmd_sg.utilities.tracing import tracer
 
 
 class APIDeviceManager:
@@ -94,7 +112,15 @@ class APIDeviceManager:
         self._generator: PatternGenerator | None = None
         self._settings: DecklinkSettings | None = None
         self._current_colors: list[list[int]] = []
+        self._overlays: dict[int, dict[str, Any]] = {}
+        self._chart: ChartScene | None = None
+        self._chart_path: str | None = None
+        self._chart_watcher: ChartFileWatcher | None = None
         self._operation_lock = threading.Lock()
+        # Encoded thumbnails by (format, quality), for one capture sequence
+        self._thumbnail_lock = threading.Lock()
+        self._thumbnail_sequence = -1
+        self._thumbnail_cache: dict[tuple[str, int], bytes] = {}
         self._initialized = False
         self._start_time = time.time()
 
@@ -139,6 +165,7 @@ class APIDeviceManager:
             self._generator = generator
             self._settings = settings
             self._current_colors = []
+            self._overlays = {}
             self._initialized = True
 
     def is_initialized(self) -> bool:
@@ -206,13 +233,15 @@ class APIDeviceManager:
                     validate_color(color, self._device)
 
                 # Generate new pattern with validated colors
-                image = self._generator.generate(colors)
+                with tracer.span("generate", "generate", colors=len(colors)):
+                    image = self._generator.generate(colors)
 
                 # Display the pattern
                 self._device.display_frame(image)
 
                 # Update stored state
                 self._current_colors = colors.copy()
+                self._close_chart()
 
                 return {
                     "success": True,
@@ -227,6 +256,344 @@ class APIDeviceManager:
                     "updated_colors": self._current_colors,
                 }
 
+    def _refresh_overlays(self) -> None:
+        """Re-display the current pattern with the current overlays."""
+        shown = self._current_colors or self._chart is not None
+        if shown and self._device is not None:
+            self._device.update_overlays()
+
+    def _overlay_result(
+        self, success: bool, message: str, overlay_id: int | None = None
+    ) -> dict[str, Any]:
+        return {
+            "success": success,
+            "message": message,
+            "overlay_id": overlay_id,
+            "overlays": [
+                {"id": oid, **{k: v for k, v in info.items() if k != "offset"}}
+                for oid, info in self._overlays.items()
+            ],
+        }
+
+    def add_overlay(
+        self,
+        kind: str,
+        x: int,
+        y: int,
+        color: list[int],
+        size: int = 64,
+        thickness: int = 1,
+        text: str | None = None,
+        enabled: bool = True,
+    ) -> dict[str, Any]:
+        """
+        Add a crosshair, marker or label overlay to the output.
+
+        The overlay is composited into the packed frame; the pattern itself
+        is not regenerated.
+
+        Parameters
+        ----------
+        kind : str
+            "crosshair", "marker" or "label"
+        x, y : int
+            Overlay centre (top-left corner for labels)
+        color : List[int]
+            RGB code values at the device bit depth
+        size : int, optional
+            Crosshair / marker size, or label font size. Default is 64.
+        thickness : int, optional
+            Crosshair line thickness. Default is 1.
+        text : str, optional
+            Label text, required for labels
+        enabled : bool, optional
+            Whether the overlay is shown immediately. Default is True.
+
+        Returns
+        -------
+        Dict[str, Any]
+            Result dictionary with success status, message, the new overlay
+            id and the list of overlays
+        """
+        with self._operation_lock:
+            if not self.is_initialized() or self._device is None:
+                return self._overlay_result(False, "Device manager not initialized")
+
+            try:
+                validate_color(color, self._device)
+                if kind == "crosshair":
+                    sprite = crosshair_sprite(size, color, thickness=thickness)
+                elif kind == "marker":
+                    sprite = marker_sprite(size, color)
+                elif kind == "label":
+                    if not text:
+                        raise ValueError("Labels require text")
+                    sprite = label_sprite(text, color, font_size=size)
+                else:
+                    raise ValueError(f"Unknown overlay kind '{kind}'")
+
+                left, top = x, y
+                if kind != "label":
+                    left -= sprite.shape[1] // 2
+                    top -= sprite.shape[0] // 2
+                overlay_id = self._device.add_overlay(sprite, left, top, enabled)
+                self._overlays[overlay_id] = {
+                    "kind": kind,
+                    "x": x,
+                    "y": y,
+                    "offset": [x - left, y - top],
+                    "enabled": enabled,
+                }
+                if enabled:
+                    self._refresh_overlays()
+                return self._overlay_result(
+                    True, f"Added {kind} overlay {overlay_id}", overlay_id
+                )
+
+            except Exception as e:
+                return self._overlay_result(False, f"Failed to add overlay: {e!s}")
+
+    def update_overlay(
+        self,
+        overlay_id: int,
+        enabled: bool | None = None,
+        x: int | None = None,
+        y: int | None = None,
+    ) -> dict[str, Any]:
+        """
+        Toggle or move an overlay without regenerating the pattern.
+
+        Parameters
+        ----------
+        overlay_id : int
+            Id returned by ``add_overlay``
+        enabled : bool, optional
+            Show or hide the overlay
+        x, y : int, optional
+            New position; both must be given to move the overlay
+
+        Returns
+        -------
+        Dict[str, Any]
+            Result dictionary with success status, message and overlays
+        """
+        with self._operation_lock:
+            if not self.is_initialized() or self._device is None:
+                return self._overlay_result(False, "Device manager not initialized")
+            info = self._overlays.get(overlay_id)
+            if info is None:
+                return self._overlay_result(False, f"Unknown overlay {overlay_id}")
+
+            try:
+                if (x is None) != (y is None):
+                    raise ValueError("Both x and y are needed to move an overlay")
+                if x is not None and y is not None:
+                    dx, dy = info["offset"]
+                    self._device.move_overlay(overlay_id, x - dx, y - dy)
+                    info["x"], info["y"] = x, y
+                if enabled is not None:
+                    self._device.set_overlay_enabled(overlay_id, enabled)
+                    info["enabled"] = enabled
+                self._refresh_overlays()
+                return self._overlay_result(
+                    True, f"Updated overlay {overlay_id}", overlay_id
+                )
+
+            except Exception as e:
+                return self._overlay_result(
+                    False, f"Failed to update overlay: {e!s}", overlay_id
+                )
+
+    def remove_overlay(self, overlay_id: int) -> dict[str, Any]:
+        """
+        Remove an overlay.
+
+        Parameters
+        ----------
+        overlay_id : int
+            Id returned by ``add_overlay``
+
+        Returns
+        -------
+        Dict[str, Any]
+            Result dictionary with success status, message and overlays
+        """
+        with self._operation_lock:
+            if not self.is_initialized() or self._device is None:
+                return self._overlay_result(False, "Device manager not initialized")
+            if overlay_id not in self._overlays:
+                return self._overlay_result(False, f"Unknown overlay {overlay_id}")
+
+            try:
+                self._device.remove_overlay(overlay_id)
+                del self._overlays[overlay_id]
+                self._refresh_overlays()
+                return self._overlay_result(True, f"Removed overlay {overlay_id}")
+
+            except Exception as e:
+                return self._overlay_result(
+                    False, f"Failed to remove overlay: {e!s}", overlay_id
+                )
+
+    def _close_chart(self) -> None:
+        """Stop watching and forget the displayed chart."""
+        if self._chart_watcher is not None:
+            # The lock is held, so the thread cannot be joined here
+            self._chart_watcher.stop(wait=False)
+            self._chart_watcher = None
+        self._chart = None
+        self._chart_path = None
+
+    def _chart_result(self, success: bool, message: str) -> dict[str, Any]:
+        chart = self._chart
+        watcher = self._chart_watcher
+        return {
+            "success": success,
+            "message": message,
+            "path": self._chart_path,
+            "patches": [p.name for p in chart.layout.patches] if chart else [],
+            "watching": watcher is not None and watcher.running,
+            "reloads": watcher.reloads if watcher else 0,
+            "last_error": watcher.last_error if watcher else None,
+        }
+
+    def _present_chart(self, regions: list[tuple[int, int, int, int]]) -> None:
+        """Send changed chart regions to the device (lock held)."""
+        if self._chart is not None and self._device is not None:
+            self._chart.present(self._device, regions)
+
+    def load_chart(
+        self,
+        path: str,
+        colorspace: str = ColorSpace.REC709.value,
+        transfer: str = TransferFunction.SRGB.value,
+        white_nits: float = 100.0,
+        labels: bool = True,
+        watch: bool = False,
+    ) -> dict[str, Any]:
+        """
+        Display a YAML chart, optionally reloading it when the file changes.
+
+        The chart is kept as a ``ChartScene``, so later patch updates and
+        file reloads re-render and repack only the patches that changed.
+
+        Parameters
+        ----------
+        path : str
+            YAML chart file
+        colorspace : str, optional
+            Target color space, as a ``ColorSpace`` value. Default is
+            "ITU-R BT.709".
+        transfer : str, optional
+            Transfer function, as a ``TransferFunction`` value. Default is
+            "sRGB".
+        white_nits : float, optional
+            Reference white luminance in nits. Default is 100.
+        labels : bool, optional
+            Whether patch labels are drawn. Default is True.
+        watch : bool, optional
+            Reload the chart whenever the file changes. Default is False.
+
+        Returns
+        -------
+        Dict[str, Any]
+            Result dictionary with success status, message and chart state
+        """
+        with self._operation_lock:
+            if not self.is_initialized():
+                return self._chart_result(False, "Device manager not initialized")
+            try:
+                if (
+                    self._generator is None
+                    or self._device is None
+                    or self._settings is None
+                ):
+                    raise RuntimeError("Device or generator not properly initialized")
+                scene = ChartScene(
+                    load_chart(path, include_labels=labels),
+                    output_width=self._settings.width,
+                    output_height=self._settings.height,
+                    bit_depth=self._generator.bit_depth,
+                    target_space=ColorSpace.parse(colorspace),
+                    transfer_function=TransferFunction.parse(transfer),
+                    reference_white_Y=white_nits,
+                    include_labels=labels,
+                )
+                self._close_chart()
+                self._device.display_frame(scene.image)
+                self._chart = scene
+                self._chart_path = path
+                self._current_colors = []
+                if watch:
+                    self._chart_watcher = ChartFileWatcher(
+                        path, scene, self._present_chart, lock=self._operation_lock
+                    )
+                    self._chart_watcher.start()
+                return self._chart_result(True, f"Displaying chart {path}")
+
+            except Exception as e:
+                return self._chart_result(False, f"Failed to load chart: {e!s}")
+
+    def update_chart_patch(
+        self,
+        patch: int | str,
+        color: list[float] | None = None,
+        space: str | None = None,
+        pattern: str | None = None,
+    ) -> dict[str, Any]:
+        """
+        Change one patch of the displayed chart.
+
+        Only the patch and its label are re-rendered, and only the output
+        rows they cover are repacked.
+
+        Parameters
+        ----------
+        patch : int | str
+            Patch index or name
+        color : List[float], optional
+            New color: normalized RGB, or XYZ when ``space`` is "XYZ"
+        space : str, optional
+            ``ColorSpace`` value of ``color``. Default is the patch's
+            current color space.
+        pattern : str, optional
+            New ``PatternType`` value
+
+        Returns
+        -------
+        Dict[str, Any]
+            Result dictionary with success status, message and chart state
+        """
+        with self._operation_lock:
+            if not self.is_initialized():
+                return self._chart_result(False, "Device manager not initialized")
+            if self._chart is None:
+                return self._chart_result(False, "No chart is displayed")
+            try:
+                index = self._chart.find_patch(patch)
+                value = None
+                if color is not None:
+                    if len(color) != 3:
+                        raise ValueError(f"Color must have 3 values, got {len(color)}")
+                    current = self._chart.layout.patches[index].color.space
+                    value = ColorValue(
+                        values=np.array(color, dtype=np.float64),
+                        space=ColorSpace.parse(space) if space else current,
+                    )
+                regions = self._chart.update_patch(
+                    index,
+                    color=value,
+                    pattern=PatternType.parse(pattern) if pattern else None,
+                )
+                self._present_chart(regions)
+                name = self._chart.layout.patches[index].name
+                return self._chart_result(True, f"Updated patch {name}")
+
+            except ValueError as e:
+                return self._chart_result(False, str(e))
+            except Exception as e:
+                return self._chart_result(False, f"Failed to update patch: {e!s}")
+
     def get_status(self) -> dict[str, Any]:
         """
         Get current device and pattern status.
@@ -265,6 +632,7 @@ class APIDeviceManager:
                 if self._settings.pixel_format
                 else "Auto"
             )
+            frame_stats = self._device.frame_stats()
 
             # Build status response
             return {
@@ -288,8 +656,56 @@ class APIDeviceManager:
                 }
                 if not self._settings.no_hdr
                 else {},
+                "memory": self._device.memory_stats(),
+                "frame_stats": frame_stats.to_dict() if frame_stats.valid else None,
             }
 
+    def get_thumbnail(
+        self, image_format: str = "png", quality: int = 85
+    ) -> tuple[bytes, int] | None:
+        """
+        Get the latest output thumbnail encoded as PNG or JPEG.
+
+        The library captures the thumbnail as frames are output; it is
+        encoded at most once per capture and format.
+
+        Parameters
+        ----------
+        image_format : str
+            "png" or "jpeg"
+        quality : int
+            JPEG quality (1-95); ignored for PNG
+
+        Returns
+        -------
+        tuple[bytes, int] | None
+            Encoded image and the capture sequence number, or None if the
+            device is not initialized or nothing has been output yet
+        """
+        device = self._device
+        if not self.is_initialized() or device is None:
+            return None
+        captured = device.thumbnail()
+        if captured is None:
+            return None
+        image, info = captured
+        key = (image_format, quality if image_format == "jpeg" else 0)
+
+        with self._thumbnail_lock:
+            if info.sequence != self._thumbnail_sequence:
+                self._thumbnail_sequence = info.sequence
+                self._thumbnail_cache = {}
+            encoded = self._thumbnail_cache.get(key)
+            if encoded is None:
+                buffer = io.BytesIO()
+                options = {"quality": quality} if image_format == "jpeg" else {}
+                Image.fromarray(image).save(
+                    buffer, format=image_format.upper(), **options
+                )
+                encoded = buffer.getvalue()
+                self._thumbnail_cache[key] = encoded
+            return encoded, info.sequence
+
     def get_health(self) -> dict[str, Any]:
         """
         Get API server health information.
@@ -330,6 +746,9 @@ class APIDeviceManager:
             self._generator = None
             self._settings = None
             self._current_colors = []
+            self._overlays = {}
+            self._close_chart()
+            self._thumbnail_cache = {}
             self._initialized = False
 
 
@@ -7,20 +7,30 @@ integrates with the existing BMD device management infrastructure while
 providing a stateful web interface.
 """
 
+import json
+import time
 from contextlib import asynccontextmanager
-from typing import Any
+from typing import Annotated, Any, Literal
 
-from fastapi import FastAPI, HTTPException, Request, status
+from fastapi import FastAPI, Header, HTTPException, Query, Request, Response, status
 from fastapi.responses import JSONResponse
 
 from bmd_sg.api.device_manager import device_manager
 from bmd_sg.api.models import (
+    ChartLoadRequest,
+    ChartPatchUpdateRequest,
+    ChartResponse,
     ColorUpdateRequest,
     ColorUpdateResponse,
     DeviceStatusResponse,
     ErrorResponse,
     HealthResponse,
+    OverlayCreateRequest,
+    OverlayResponse,
+    OverlayUpdateRequest,
 )
+from bmd_sg.api.session import RecordedRequest, session_recorder
+from bmd_sg.utilities.tracing import tracer
 
 
 @asynccontextmanager
@@ -61,6 +71,78 @@ app = FastAPI(
 )
 
 
+@app.middleware("http")
+async def record_session(request: Request, call_next):
+    """
+    Record each request to the active session file, if any.
+
+    Parameters
+    ----------
+    request : Request
+        The incoming request
+    call_next
+        Next handler in the middleware chain
+
+    Returns
+    -------
+    Response
+        The unmodified response
+    """
+    if not session_recorder.active:
+        return await call_next(request)
+
+    arrived = session_recorder.elapsed()
+    raw = await request.body()
+    start = time.perf_counter()
+    response = await call_next(request)
+    duration_ms = (time.perf_counter() - start) * 1000.0
+
+    try:
+        body = json.loads(raw) if raw else None
+    except ValueError:
+        body = raw.decode("utf-8", errors="replace")
+    route = request.scope.get("route")
+    session_recorder.record(
+        RecordedRequest(
+            t=arrived,
+            method=request.method,
+            path=request.url.path,
+            route=getattr(route, "path", request.url.path),
+            query=request.url.query,
+            body=body,
+            status=response.status_code,
+            duration_ms=duration_ms,
+        )
+    )
+    return response
+
+
+@app.middleware("http")
+async def trace_request(request: Request, call_next):
+    """
+    Trace each request as a frame while a trace is running.
+
+    Everything the request does, down to the library's completion callbacks
+    for the frames it displays, is linked to the request in the trace.
+
+    Parameters
+    ----------
+    request : Request
+        The incoming request
+    call_next
+        Next handler in the middleware chain
+
+    Returns
+    -------
+    Response
+        The unmodified response
+    """
+    if not tracer.active:
+        return await call_next(request)
+    with tracer.frame(f"{request.method} {request.url.path}", "api"):
+        return await call_next(request)
+
+
 @app.exception_handler(HTTPException)
 async def http_exception_handler(_request: Request, exc: HTTPException) -> JSONResponse:
     """
@@ -197,6 +279,226 @@ async def update_color(request: ColorUpdateRequest) -> ColorUpdateResponse:
         ) from e
 
 
+def _overlay_response(result: dict[str, Any]) -> OverlayResponse:
+    """Convert a device manager overlay result, raising on failure."""
+    if not result["success"]:
+        code = (
+            status.HTTP_404_NOT_FOUND
+            if result["message"].startswith("Unknown overlay")
+            else status.HTTP_400_BAD_REQUEST
+        )
+        raise HTTPException(status_code=code, detail=result["message"])
+    return OverlayResponse(**result)
+
+
+def _require_initialized() -> None:
+    if not device_manager.is_initialized():
+        raise HTTPException(
+            status_code=status.HTTP_400_BAD_REQUEST,
+            detail="Device not initialized. Start API server via CLI first.",
+        )
+
+
+@app.post(
+    "/overlays",
+    response_model=OverlayResponse,
+    summary="Add an overlay",
+    description="Add a crosshair, marker or label composited over the current pattern",
+)
+async def add_overlay(request: OverlayCreateRequest) -> OverlayResponse:
+    """
+    Add an overlay to the output.
+
+    The overlay is composited into the packed frame, so the pattern itself is
+    not regenerated or repacked.
+
+    Parameters
+    ----------
+    request : OverlayCreateRequest
+        Overlay type, position, color and options
+
+    Returns
+    -------
+    OverlayResponse
+        Result with the new overlay id and the current overlays
+
+    Raises
+    ------
+    HTTPException
+        400: If the device is not initialized or the overlay is invalid
+
+    Examples
+    --------
+    >>> POST /overlays
+    >>> {"kind": "crosshair", "x": 960, "y": 540, "color": [4095, 0, 0]}
+    """
+    _require_initialized()
+    return _overlay_response(device_manager.add_overlay(**request.model_dump()))
+
+
+@app.patch(
+    "/overlays/{overlay_id}",
+    response_model=OverlayResponse,
+    summary="Toggle or move an overlay",
+    description="Show, hide or move an overlay without regenerating the pattern",
+)
+async def update_overlay(
+    overlay_id: int, request: OverlayUpdateRequest
+) -> OverlayResponse:
+    """
+    Toggle or move an overlay.
+
+    Parameters
+    ----------
+    overlay_id : int
+        Id returned when the overlay was added
+    request : OverlayUpdateRequest
+        New visibility and/or position
+
+    Returns
+    -------
+    OverlayResponse
+        Result with the current overlays
+
+    Raises
+    ------
+    HTTPException
+        400: If the device is not initialized or the update fails
+        404: If the overlay does not exist
+
+    Examples
+    --------
+    >>> PATCH /overlays/1
+    >>> {"enabled": false}
+    """
+    _require_initialized()
+    return _overlay_response(
+        device_manager.update_overlay(overlay_id, **request.model_dump())
+    )
+
+
+@app.delete(
+    "/overlays/{overlay_id}",
+    response_model=OverlayResponse,
+    summary="Remove an overlay",
+    description="Remove an overlay from the output",
+)
+async def remove_overlay(overlay_id: int) -> OverlayResponse:
+    """
+    Remove an overlay.
+
+    Parameters
+    ----------
+    overlay_id : int
+        Id returned when the overlay was added
+
+    Returns
+    -------
+    OverlayResponse
+        Result with the remaining overlays
+
+    Raises
+    ------
+    HTTPException
+        400: If the device is not initialized
+        404: If the overlay does not exist
+    """
+    _require_initialized()
+    return _overlay_response(device_manager.remove_overlay(overlay_id))
+
+
+def _chart_response(result: dict[str, Any]) -> ChartResponse:
+    """Convert a device manager chart result, raising on failure."""
+    if not result["success"]:
+        code = (
+            status.HTTP_404_NOT_FOUND
+            if result["message"].startswith("Unknown patch")
+            else status.HTTP_400_BAD_REQUEST
+        )
+        raise HTTPException(status_code=code, detail=result["message"])
+    return ChartResponse(**result)
+
+
+@app.post(
+    "/chart",
+    response_model=ChartResponse,
+    summary="Display a chart",
+    description="Display a YAML chart, optionally reloading it when the file changes",
+)
+async def load_chart(request: ChartLoadRequest) -> ChartResponse:
+    """
+    Display a YAML chart.
+
+    With ``watch`` set, edits to the file are applied as they are saved:
+    only the patches that changed are re-rendered and repacked.
+
+    Parameters
+    ----------
+    request : ChartLoadRequest
+        Chart file and rendering options
+
+    Returns
+    -------
+    ChartResponse
+        Result with the chart's patch names
+
+    Raises
+    ------
+    HTTPException
+        400: If the device is not initialized or the chart cannot be loaded
+
+    Examples
+    --------
+    >>> POST /chart
+    >>> {"path": "data/luminance_ramp_cv.yaml", "watch": true}
+    """
+    _require_initialized()
+    return _chart_response(device_manager.load_chart(**request.model_dump()))
+
+
+@app.patch(
+    "/chart/patches/{patch}",
+    response_model=ChartResponse,
+    summary="Change a chart patch",
+    description="Change one patch of the displayed chart without re-rendering it",
+)
+async def update_chart_patch(
+    patch: str, request: ChartPatchUpdateRequest
+) -> ChartResponse:
+    """
+    Change one patch of the displayed chart.
+
+    Parameters
+    ----------
+    patch : str
+        Patch name, or its index if all digits
+    request : ChartPatchUpdateRequest
+        New color and/or pattern
+
+    Returns
+    -------
+    ChartResponse
+        Result with the chart state
+
+    Raises
+    ------
+    HTTPException
+        400: If the device is not initialized, no chart is displayed or the
+        update is invalid
+        404: If the patch does not exist
+
+    Examples
+    --------
+    >>> PATCH /chart/patches/GS50
+    >>> {"color": [0.5, 0.5, 0.5]}
+    """
+    _require_initialized()
+    key: int | str = int(patch) if patch.isdigit() else patch
+    return _chart_response(
+        device_manager.update_chart_patch(key, **request.model_dump())
+    )
+
+
 @app.get(
     "/status",
     response_model=DeviceStatusResponse,
@@ -236,6 +538,72 @@ async def get_status() -> DeviceStatusResponse:
         ) from e
 
 
+@app.get(
+    "/thumbnail",
+    summary="Get an output thumbnail",
+    description="Small sRGB preview of the frame currently being output",
+    response_class=Response,
+    responses={
+        200: {"content": {"image/png": {}, "image/jpeg": {}}},
+        304: {"description": "Unchanged since the ETag in If-None-Match"},
+        404: {"description": "No frame has been output yet"},
+    },
+)
+async def get_thumbnail(
+    image_format: Annotated[Literal["png", "jpeg"], Query(alias="format")] = "png",
+    quality: Annotated[int, Query(ge=1, le=95)] = 85,
+    if_none_match: Annotated[str | None, Header()] = None,
+) -> Response:
+    """
+    Get a thumbnail of the output for monitoring.
+
+    The library captures the thumbnail while frames are output (after
+    overlays), so fetching it costs no frame pass. Each capture is encoded
+    once per format; the ETag changes with every capture, so pollers can
+    send If-None-Match and receive ``304`` while the output is unchanged.
+
+    Parameters
+    ----------
+    image_format : str
+        ``png`` (default) or ``jpeg``, from the ``format`` query parameter
+    quality : int
+        JPEG quality (1-95)
+    if_none_match : str | None
+        ETag of the thumbnail the client already has
+
+    Returns
+    -------
+    Response
+        The encoded image, or an empty ``304`` response
+
+    Raises
+    ------
+    HTTPException
+        400: If the device is not initialized
+        404: If no frame has been output yet
+
+    Examples
+    --------
+    >>> GET /thumbnail?format=jpeg&quality=80
+    """
+    _require_initialized()
+    thumbnail = device_manager.get_thumbnail(image_format, quality)
+    if thumbnail is None:
+        raise HTTPException(
+            status_code=status.HTTP_404_NOT_FOUND,
+            detail="No frame has been output yet",
+        )
+    encoded, sequence = thumbnail
+    variant = f"jpeg-{quality}" if image_format == "jpeg" else image_format
+    etag = f'"{sequence}-{variant}"'
+    headers = {"ETag": etag, "Cache-Control": "no-cache"}
+    if if_none_match == etag:
+        return Response(status_code=status.HTTP_304_NOT_MODIFIED, headers=headers)
+    return Response(
+        content=encoded, media_type=f"image/{image_format}", headers=headers
+    )
+
+
 @app.get(
     "/health",
     response_model=HealthResponse,
@@ -306,7 +674,13 @@ async def root() -> dict[str, Any]:
         "description": "Real-time pattern updates for Blackmagic Design DeckLink devices",
         "endpoints": {
             "POST /update_color": "Update pattern colors (1-4 colors)",
+            "POST /overlays": "Add a crosshair, marker or label overlay",
+            "PATCH /overlays/{id}": "Show, hide or move an overlay",
+            "DELETE /overlays/{id}": "Remove an overlay",
+            "POST /chart": "Display a YAML chart, optionally reloading on edits",
+            "PATCH /chart/patches/{patch}": "Change one patch of the displayed chart",
             "GET /status": "Get device and pattern status",
+            "GET /thumbnail": "PNG or JPEG preview of the output",
             "GET /health": "Health check endpoint",
             "GET /docs": "OpenAPI documentation",
         },
@@ -5,7 +5,7 @@ This module defines request and response models for the FastAPI interface,
 providing type safety and automatic validation for all API endpoints.
 """
 
-from typing import ClassVar
+from typing import ClassVar, Literal
 
 from pydantic import BaseModel, Field
 
@@ -109,6 +109,197 @@ class ColorUpdateResponse(BaseModel):
     )
 
 
+class OverlayCreateRequest(BaseModel):
+    """
+    Request model for adding an overlay to the output.
+
+    Overlays are composited into the already packed frame, so adding,
+    moving or toggling one does not regenerate the underlying pattern.
+
+    Parameters
+    ----------
+    kind : str
+        Overlay type: "crosshair", "marker" or "label"
+    x, y : int
+        Frame position of the overlay centre (top-left corner for labels)
+    color : List[int]
+        RGB code values at the device bit depth
+    size : int, optional
+        Crosshair / marker size in pixels, or label font size
+    thickness : int, optional
+        Crosshair line thickness in pixels
+    text : str, optional
+        Label text (required for labels)
+    enabled : bool, optional
+        Whether the overlay is shown immediately
+
+    Examples
+    --------
+    >>> request = OverlayCreateRequest(
+    ...     kind="crosshair", x=960, y=540, color=[4095, 0, 0]
+    ... )
+    """
+
+    kind: Literal["crosshair", "marker", "label"] = Field(
+        ..., description="Overlay type"
+    )
+    x: int = Field(..., description="X position (centre; left edge for labels)")
+    y: int = Field(..., description="Y position (centre; top edge for labels)")
+    color: list[int] = Field(
+        ..., description="RGB code values [R,G,B]", min_length=3, max_length=3
+    )
+    size: int = Field(default=64, ge=1, le=4096, description="Size in pixels")
+    thickness: int = Field(default=1, ge=1, description="Crosshair line width")
+    text: str | None = Field(default=None, description="Label text")
+    enabled: bool = Field(default=True, description="Show the overlay")
+
+    class Config:
+        json_schema_extra: ClassVar[dict] = {
+            "example": {
+                "kind": "crosshair",
+                "x": 960,
+                "y": 540,
+                "color": [4095, 0, 0],
+                "size": 64,
+            }
+        }
+
+
+class OverlayUpdateRequest(BaseModel):
+    """
+    Request model for toggling or moving an overlay.
+
+    Parameters
+    ----------
+    enabled : bool, optional
+        Show or hide the overlay
+    x, y : int, optional
+        New position, in the same convention as ``OverlayCreateRequest``.
+        Both must be given to move the overlay.
+
+    Examples
+    --------
+    >>> request = OverlayUpdateRequest(enabled=False)
+    """
+
+    enabled: bool | None = Field(default=None, description="Show the overlay")
+    x: int | None = Field(default=None, description="New X position")
+    y: int | None = Field(default=None, description="New Y position")
+
+
+class OverlayResponse(BaseModel):
+    """
+    Response model for overlay operations.
+
+    Parameters
+    ----------
+    success : bool
+        Whether the operation succeeded
+    message : str
+        Human-readable status message
+    overlay_id : int, optional
+        Id of the overlay that was created or changed
+    overlays : List[dict]
+        All overlays after the operation
+    """
+
+    success: bool = Field(..., description="Whether the operation succeeded")
+    message: str = Field(..., description="Status message describing the result")
+    overlay_id: int | None = Field(default=None, description="Overlay id")
+    overlays: list[dict] = Field(default_factory=list, description="Current overlays")
+
+
+class ChartLoadRequest(BaseModel):
+    """
+    Request model for displaying a YAML chart.
+
+    Parameters
+    ----------
+    path : str
+        YAML chart file on the server
+    colorspace : str, optional
+        Target color space ("ITU-R BT.709", "P3-D65" or "ITU-R BT.2020")
+    transfer : str, optional
+        Transfer function ("sRGB", "gamma2.2", "linear", "ST.2084" or "HLG")
+    white_nits : float, optional
+        Reference white luminance in nits
+    labels : bool, optional
+        Whether patch labels are drawn
+    watch : bool, optional
+        Reload the chart whenever the file changes
+
+    Examples
+    --------
+    >>> request = ChartLoadRequest(path="data/luminance_ramp_cv.yaml", watch=True)
+    """
+
+    path: str = Field(..., description="YAML chart file")
+    colorspace: str = Field(default="ITU-R BT.709", description="Target color space")
+    transfer: str = Field(default="sRGB", description="Transfer function")
+    white_nits: float = Field(
+        default=100.0, gt=0, description="Reference white luminance in nits"
+    )
+    labels: bool = Field(default=True, description="Draw patch labels")
+    watch: bool = Field(default=False, description="Reload when the file changes")
+
+
+class ChartPatchUpdateRequest(BaseModel):
+    """
+    Request model for changing one patch of the displayed chart.
+
+    Parameters
+    ----------
+    color : List[float], optional
+        New color: normalized RGB, or XYZ when ``space`` is "XYZ"
+    space : str, optional
+        Color space of ``color``; defaults to the patch's current one
+    pattern : str, optional
+        New pattern ("solid", "checkerboard_25", "checkerboard_50" or
+        "checkerboard_75")
+
+    Examples
+    --------
+    >>> request = ChartPatchUpdateRequest(color=[0.5, 0.5, 0.5])
+    """
+
+    color: list[float] | None = Field(
+        default=None, description="New color values", min_length=3, max_length=3
+    )
+    space: str | None = Field(default=None, description="Color space of color")
+    pattern: str | None = Field(default=None, description="New pattern")
+
+
+class ChartResponse(BaseModel):
+    """
+    Response model for chart operations.
+
+    Parameters
+    ----------
+    success : bool
+        Whether the operation succeeded
+    message : str
+        Human-readable status message
+    path : str, optional
+        File of the displayed chart
+    patches : List[str]
+        Patch names of the displayed chart, in index order
+    watching : bool
+        Whether the file is being watched for changes
+    reloads : int
+        Reloads since the chart was loaded
+    last_error : str, optional
+        Error of the last failed reload
+    """
+
+    success: bool = Field(..., description="Whether the operation succeeded")
+    message: str = Field(..., description="Status message describing the result")
+    path: str | None = Field(default=None, description="Displayed chart file")
+    patches: list[str] = Field(default_factory=list, description="Patch names")
+    watching: bool = Field(default=False, description="Whether the file is watched")
+    reloads: int = Field(default=0, description="Reloads since loading")
+    last_error: str | None = Field(default=None, description="Last reload error")
+
+
 class DeviceStatusResponse(BaseModel):
     """
     Response model for device status information.
@@ -132,6 +323,10 @@ class DeviceStatusResponse(BaseModel):
         Whether HDR metadata is enabled
     hdr_metadata : dict, optional
         Current HDR metadata parameters
+    memory : dict, optional
+        Library heap usage per subsystem (see ``BMDDeckLink.memory_stats``)
+    frame_stats : dict, optional
+        Statistics of the last displayed frame (see ``FrameStats.to_dict``)
 
     Examples
     --------
@@ -154,6 +349,14 @@ class DeviceStatusResponse(BaseModel):
     hdr_metadata: dict = Field(
         default_factory=dict, description="HDR metadata parameters"
     )
+    memory: dict = Field(
+        default_factory=dict,
+        description="Library heap usage per subsystem (current, peak, live blocks)",
+    )
+    frame_stats: dict | None = Field(
+        default=None,
+        description="Last frame's APL, min/max, clip counts and MaxCLL/MaxFALL",
+    )
 
 
 class HealthResponse(BaseModel):
@@ -220,4 +423,7 @@ __all__ = [
     "DeviceStatusResponse",
     "ErrorResponse",
     "HealthResponse",
+    "OverlayCreateRequest",
+    "OverlayResponse",
+    "OverlayUpdateRequest",
 ]
@@ -0,0 +1,328 @@
+"""
+API session recording and replay.
+
+A session is a JSON Lines file with one entry per API request, written by
+:class:`SessionRecorder` while the server runs (``api-server --record``).
+:func:`replay_session` re-issues a recorded session against a server, at the
+recorded pace, N times faster or as fast as possible, and reports latency
+distributions and throughput, so real calibration sessions can be used as
+benchmark workloads for the API server and device manager.
+
+Requests are replayed in order and one at a time, since later requests
+depend on the device state left by earlier ones (overlay ids in particular).
+Replay against a freshly started server for ids to line up.
+"""
+
+import json
+import threading
+import time
+from dataclasses import asdict, dataclass, field
+from pathlib import Path
+from typing import Any, TextIO
+
+import numpy as np
+import requests
+
+SESSION_VERSION = 1
+
+
+@dataclass
+class RecordedRequest:
+    """
+    One recorded API request.
+
+    Attributes
+    ----------
+    t : float
+        Seconds from the start of the session to the request arriving
+    method : str
+        HTTP method
+    path : str
+        Request path, e.g. ``/overlays/3``
+    route : str
+        Matched route template, e.g. ``/overlays/{overlay_id}``; equal to
+        ``path`` if no route matched
+    query : str
+        Raw query string
+    body : Any
+        Decoded JSON body, or None if the request had no body
+    status : int
+        Response status code
+    duration_ms : float
+        Time the server spent handling the request
+    """
+
+    t: float
+    method: str
+    path: str
+    route: str
+    query: str
+    body: Any
+    status: int
+    duration_ms: float
+
+
+class SessionRecorder:
+    """
+    Appends API requests to a session file.
+
+    The recorder is inactive until :meth:`start` is called; the API's request
+    middleware checks :attr:`active` and skips recording otherwise. Entries are
+    flushed as they are written, so a session survives the server being
+    killed.
+    """
+
+    def __init__(self) -> None:
+        self._file: TextIO | None = None
+        self._start = 0.0
+        self._lock = threading.Lock()
+
+    @property
+    def active(self) -> bool:
+        """Whether requests are currently being recorded."""
+        return self._file is not None
+
+    def start(self, path: Path) -> None:
+        """
+        Start recording to ``path``, replacing any existing file.
+
+        Parameters
+        ----------
+        path : Path
+            Session file to write
+
+        Raises
+        ------
+        RuntimeError
+            If a recording is already in progress
+        """
+        with self._lock:
+            if self._file is not None:
+                raise RuntimeError("A session is already being recorded")
+            self._file = path.open("w", encoding="utf-8")
+            self._start = time.perf_counter()
+            header = {
+                "session": SESSION_VERSION,
+                "started": time.strftime("%Y-%m-%dT%H:%M:%S%z"),
+            }
+            self._file.write(json.dumps(header) + "\n")
+            self._file.flush()
+
+    def elapsed(self) -> float:
+        """Seconds since recording started."""
+        return time.perf_counter() - self._start
+
+    def record(self, entry: RecordedRequest) -> None:
+        """Append one request to the session file."""
+        with self._lock:
+            if self._file is None:
+                return
+            self._file.write(json.dumps(asdict(entry)) + "\n")
+            self._file.flush()
+
+    def stop(self) -> None:
+        """Stop recording and close the session file."""
+        with self._lock:
+            if self._file is not None:
+                self._file.close()
+                self._file = None
+
+
+def load_session(path: Path) -> list[RecordedRequest]:
+    """
+    Read a recorded session.
+
+    Parameters
+    ----------
+    path : Path
+        Session file written by :class:`SessionRecorder`
+
+    Returns
+    -------
+    list[RecordedRequest]
+        Recorded requests in arrival order
+
+    Raises
+    ------
+    RuntimeError
+        If the file is not a session file or has an unsupported version
+    """
+    with path.open(encoding="utf-8") as f:
+        lines = [line for line in f if line.strip()]
+    if not lines:
+        raise RuntimeError(f"{path} is empty")
+    header = json.loads(lines[0])
+    if header.get("session") != SESSION_VERSION:
+        raise RuntimeError(f"{path} is not a version {SESSION_VERSION} session file")
+    return [RecordedRequest(**json.loads(line)) for line in lines[1:]]
+
+
+@dataclass
+class LatencyStats:
+    """Latency distribution of a group of requests, in milliseconds."""
+
+    count: int
+    mean: float
+    p50: float
+    p90: float
+    p99: float
+    max: float
+
+    @classmethod
+    def from_samples(cls, samples: list[float]) -> "LatencyStats":
+        """Summarise a list of latencies."""
+        if not samples:
+            return cls(0, 0.0, 0.0, 0.0, 0.0, 0.0)
+        data = np.asarray(samples, dtype=np.float64)
+        p50, p90, p99 = np.percentile(data, [50, 90, 99])
+        return cls(
+            count=len(samples),
+            mean=float(data.mean()),
+            p50=float(p50),
+            p90=float(p90),
+            p99=float(p99),
+            max=float(data.max()),
+        )
+
+
+@dataclass
+class ReplayReport:
+    """
+    Result of replaying a session.
+
+    Attributes
+    ----------
+    requests : int
+        Number of requests issued
+    errors : int
+        Requests that failed to connect or time out
+    status_mismatches : int
+        Requests whose status code differed from the recording
+    wall_seconds : float
+        Time from the first request to the last response
+    throughput : float
+        Requests per second over ``wall_seconds``
+    max_lag_ms : float
+        Largest delay between a request's scheduled and actual send time;
+        non-zero lag at 1x means the server could not keep up
+    latency : LatencyStats
+        Client-side latency of all requests
+    recorded : LatencyStats
+        Server-side handling time of the same requests when recorded
+    routes : dict[str, LatencyStats]
+        Client-side latency per ``METHOD route``
+    """
+
+    requests: int
+    errors: int
+    status_mismatches: int
+    wall_seconds: float
+    throughput: float
+    max_lag_ms: float
+    latency: LatencyStats
+    recorded: LatencyStats
+    routes: dict[str, LatencyStats] = field(default_factory=dict)
+
+    def to_dict(self) -> dict[str, Any]:
+        """Convert the report to JSON-serialisable types."""
+        return asdict(self)
+
+
+def replay_session(
+    session: list[RecordedRequest],
+    base_url: str,
+    speed: float | None = 1.0,
+    timeout: float = 10.0,
+) -> ReplayReport:
+    """
+    Re-issue a recorded session against an API server.
+
+    Parameters
+    ----------
+    session : list[RecordedRequest]
+        Requests from :func:`load_session`
+    base_url : str
+        Server to replay against, e.g. ``http://127.0.0.1:4844``
+    speed : float | None, optional
+        Playback speed relative to the recording; None sends each request as
+        soon as the previous one completes. Default is 1.0.
+    timeout : float, optional
+        Per-request timeout in seconds. Default is 10.0.
+
+    Returns
+    -------
+    ReplayReport
+        Latency distributions and throughput of the replay
+
+    Raises
+    ------
+    ValueError
+        If ``speed`` is not positive
+    """
+    if speed is not None and speed <= 0:
+        raise ValueError("speed must be positive")
+
+    base_url = base_url.rstrip("/")
+    latencies: list[float] = []
+    by_route: dict[str, list[float]] = {}
+    errors = 0
+    mismatches = 0
+    max_lag = 0.0
+    t0 = session[0].t if session else 0.0
+
+    with requests.Session() as http:
+        start = time.perf_counter()
+        for entry in session:
+            if speed is not None:
+                due = start + (entry.t - t0) / speed
+                now = time.perf_counter()
+                if due > now:
+                    time.sleep(due - now)
+                else:
+                    max_lag = max(max_lag, now - due)
+
+            url = base_url + entry.path
+            if entry.query:
+                url += "?" + entry.query
+            sent = time.perf_counter()
+            try:
+                response = http.request(
+                    entry.method, url, json=entry.body, timeout=timeout
+                )
+            except requests.RequestException:
+                errors += 1
+                continue
+            elapsed_ms = (time.perf_counter() - sent) * 1000.0
+
+            latencies.append(elapsed_ms)
+            by_route.setdefault(f"{entry.method} {entry.route}", []).append(elapsed_ms)
+            if response.status_code != entry.status:
+                mismatches += 1
+        wall = time.perf_counter() - start
+
+    return ReplayReport(
+        requests=len(session),
+        errors=errors,
+        status_mismatches=mismatches,
+        wall_seconds=wall,
+        throughput=len(latencies) / wall if wall > 0 else 0.0,
+        max_lag_ms=max_lag * 1000.0,
+        latency=LatencyStats.from_samples(latencies),
+        recorded=LatencyStats.from_samples([e.duration_ms for e in session]),
+        routes={k: LatencyStats.from_samples(v) for k, v in sorted(by_route.items())},
+    )
+
+
+# Global recorder used by the API middleware
+session_recorder = SessionRecorder()
+
+
+__all__ = [
+    "LatencyStats",
+    "RecordedRequest",
+    "ReplayReport",
+    "SessionRecorder",
+    "load_session",
+    "replay_session",
+    "session_recorder",
+]
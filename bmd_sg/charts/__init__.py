@@ -9,17 +9,24 @@ with spectroradiometers and colorimeters.
 
 from bmd_sg.charts.color_types import ChartLayout, ColorValue, Patch
 from bmd_sg.charts.conversion import xyz_to_display_rgb
-from bmd_sg.charts.renderer import render_chart
+from bmd_sg.charts.renderer import render_chart, render_chart_tiled
+from bmd_sg.charts.scene import ChartFileWatcher, ChartScene
+from bmd_sg.charts.sweep import cache_sweep_clip, render_chart_sweep
 from bmd_sg.charts.tiff_reader import TiffMetadata, load_chart_tiff
 from bmd_sg.charts.tiff_writer import write_chart_tiff
 
 __all__ = [
+    "ChartFileWatcher",
     "ChartLayout",
+    "ChartScene",
     "ColorValue",
     "Patch",
     "TiffMetadata",
+    "cache_sweep_clip",
     "load_chart_tiff",
     "render_chart",
+    "render_chart_sweep",
+    "render_chart_tiled",
     "write_chart_tiff",
     "xyz_to_display_rgb",
 ]
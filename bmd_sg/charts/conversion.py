@@ -5,6 +5,8 @@ This module wraps the colour-science library for XYZ to RGB conversion
 with proper illuminant handling and transfer function encoding.
 """
 
+from collections.abc import Sequence
+
 import colour
 import numpy as np
 from numpy.typing import NDArray
@@ -136,19 +138,8 @@ def xyz_to_display_rgb(
             target_light_source=simulation_light_source,
         )
 
-    # Map our ColorSpace enum to colour-science colorspace names
-    colorspace_map = {
-        ColorSpace.REC709: "ITU-R BT.709",
-        ColorSpace.P3_D65: "P3-D65",
-        ColorSpace.REC2020: "ITU-R BT.2020",
-    }
-    cs_name = colorspace_map.get(target_space)
-    if cs_name is None:
-        msg = f"Unsupported target colorspace: {target_space}"
-        raise ValueError(msg)
-
     # Get the colorspace definition
-    cs = colour.RGB_COLOURSPACES[cs_name]
+    cs = _rgb_colourspace(target_space)
 
     # Get the illuminant for XYZ→RGB conversion
     # IMPORTANT: After chromatic adaptation, we want the color shift to remain
@@ -177,6 +168,127 @@ def xyz_to_display_rgb(
     # Clip to gamut
     linear_rgb = np.clip(linear_rgb, 0.0, 1.0)
 
+    return _encode(linear_rgb, transfer_function)
+
+
+def light_source_xy(light_sources: Sequence[LightSource]) -> NDArray[np.float64]:
+    """
+    CIE 1931 xy chromaticities of several light sources at once.
+
+    Equivalent to calling ``LightSource.to_xy`` on each, but the CCTs are
+    converted in a single vectorized call.
+
+    Parameters
+    ----------
+    light_sources : Sequence[LightSource]
+        Light sources, by CCT or illuminant.
+
+    Returns
+    -------
+    NDArray[np.float64]
+        Array of shape (N, 2).
+    """
+    xy = np.empty((len(light_sources), 2), dtype=np.float64)
+    by_cct = [i for i, light in enumerate(light_sources) if light.cct is not None]
+    if by_cct:
+        ccts = np.array([light_sources[i].cct for i in by_cct], dtype=np.float64)
+        xy[by_cct] = colour.temperature.CCT_to_xy(ccts, method="Kang 2002")
+    for i, light in enumerate(light_sources):
+        if light.cct is None:
+            assert light.illuminant is not None
+            xy[i] = colour.CCS_ILLUMINANTS["CIE 1931 2 Degree Standard Observer"][
+                light.illuminant.value
+            ]
+    return xy
+
+
+def xyz_to_display_rgb_sweep(
+    xyz: NDArray[np.float64],
+    light_sources: Sequence[LightSource],
+    target_space: ColorSpace = ColorSpace.REC709,
+    transfer_function: TransferFunction = TransferFunction.SRGB,
+    reference_white_Y: float = 100.0,
+    illuminant: Illuminant = Illuminant.D65,
+    transform: str = "Bradford",
+) -> NDArray[np.float64]:
+    """
+    Convert XYZ colors to display RGB as simulated under several light sources.
+
+    Gives the result of ``xyz_to_display_rgb`` with each
+    ``simulation_light_source`` in turn, for every color. The adaptation
+    matrices of all light sources are computed in one call and each step
+    runs once over the whole (light source, color) array.
+
+    Parameters
+    ----------
+    xyz : NDArray[np.float64]
+        XYZ colors, shape (P, 3), scaled so ``reference_white_Y`` is white.
+    light_sources : Sequence[LightSource]
+        Light sources to simulate.
+    target_space : ColorSpace
+        Target RGB color space.
+    transfer_function : TransferFunction
+        Transfer function to apply (encoding).
+    reference_white_Y : float
+        The Y value that corresponds to white.
+    illuminant : Illuminant
+        The CIE standard illuminant the XYZ values are referenced to.
+    transform : str
+        Chromatic adaptation transform. Default is "Bradford".
+
+    Returns
+    -------
+    NDArray[np.float64]
+        Encoded RGB values in range [0, 1], shape (N, P, 3).
+
+    Examples
+    --------
+    >>> lights = [LightSource(cct=cct) for cct in range(2700, 6600, 100)]
+    >>> rgb = xyz_to_display_rgb_sweep(patch_xyz, lights)
+    """
+    xyz_normalized = np.asarray(xyz, dtype=np.float64).reshape(-1, 3)
+    xyz_normalized = xyz_normalized / reference_white_Y
+
+    # One Von Kries matrix per light source, shape (N, 3, 3)
+    source_XYZ = colour.xy_to_XYZ(
+        colour.CCS_ILLUMINANTS["CIE 1931 2 Degree Standard Observer"][illuminant.value]
+    )
+    target_XYZ = colour.xy_to_XYZ(light_source_xy(light_sources))
+    matrices = colour.adaptation.matrix_chromatic_adaptation_VonKries(
+        source_XYZ, target_XYZ, transform=transform
+    )
+    adapted_xyz = np.einsum("nij,pj->npi", matrices, xyz_normalized)
+
+    # As in xyz_to_display_rgb: the colorspace's own white point keeps the
+    # simulated color shift visible
+    cs = _rgb_colourspace(target_space)
+    linear_rgb = colour.XYZ_to_RGB(
+        adapted_xyz, colourspace=cs, illuminant=cs.whitepoint
+    )
+    linear_rgb = np.clip(linear_rgb, 0.0, 1.0)
+
+    return _encode(linear_rgb, transfer_function)
+
+
+def _rgb_colourspace(target_space: ColorSpace) -> colour.RGB_Colourspace:
+    """colour-science definition of a target RGB color space."""
+    # Map our ColorSpace enum to colour-science colorspace names
+    colorspace_map = {
+        ColorSpace.REC709: "ITU-R BT.709",
+        ColorSpace.P3_D65: "P3-D65",
+        ColorSpace.REC2020: "ITU-R BT.2020",
+    }
+    cs_name = colorspace_map.get(target_space)
+    if cs_name is None:
+        msg = f"Unsupported target colorspace: {target_space}"
+        raise ValueError(msg)
+    return colour.RGB_COLOURSPACES[cs_name]
+
+
+def _encode(
+    linear_rgb: NDArray[np.float64], transfer_function: TransferFunction
+) -> NDArray[np.float64]:
+    """Apply a transfer function to clipped linear RGB."""
     # Apply transfer function (encoding)
     if transfer_function == TransferFunction.LINEAR:
         encoded_rgb = linear_rgb
@@ -5,6 +5,11 @@ Renders charts to numpy arrays with optional text labels for
 measurement validation.
 """
 
+import functools
+import os
+import threading
+from concurrent.futures import ThreadPoolExecutor
+
 import numpy as np
 from numpy.typing import NDArray
 from PIL import Image, ImageDraw, ImageFont
@@ -15,12 +20,35 @@ from bmd_sg.charts.color_types import (
     ColorSpace,
     Illuminant,
     LightSource,
+    Patch,
     PatternType,
     TransferFunction,
 )
 from bmd_sg.charts.conversion import xyz_to_display_rgb
+from bmd_sg.utilities.tracing import traced
+
+_CHECKERBOARDS = (
+    PatternType.CHECKERBOARD_25,
+    PatternType.CHECKERBOARD_50,
+    PatternType.CHECKERBOARD_75,
+)
+
+# Canvases above UHD are rendered in tiles by render_chart
+_TILED_MIN_PIXELS = 3840 * 2160
+
+# Extra pixels around text bounding boxes for antialiasing
+_TEXT_MARGIN = 2
+
+# Text drawn over a chart: (center, text, fill, font), anchored "mm"
+ChartText = tuple[
+    tuple[int, int],
+    str,
+    tuple[int, int, int],
+    ImageFont.ImageFont | ImageFont.FreeTypeFont,
+]
 
 
+@traced("render_chart", "render")
 def render_chart(
     layout: ChartLayout,
     output_width: int | None = None,
@@ -40,6 +68,9 @@ def render_chart(
     differ from the canvas size, the chart is embedded pixel-for-pixel centered
     in the output frame with the surround color filling the remaining area.
 
+    Canvases larger than UHD are handed to ``render_chart_tiled``, which
+    gives the same pixels with far less scratch memory.
+
     Parameters
     ----------
     layout : ChartLayout
@@ -71,13 +102,23 @@ def render_chart(
     canvas = layout.canvas if layout.canvas else Canvas()
     canvas_width = canvas.width
     canvas_height = canvas.height
-    surround = canvas.surround
 
     # Determine output dimensions
     out_width = output_width if output_width is not None else canvas_width
     out_height = output_height if output_height is not None else canvas_height
 
-    max_value = 2**bit_depth - 1
+    if canvas_width * canvas_height > _TILED_MIN_PIXELS:
+        return render_chart_tiled(
+            layout,
+            output_width=out_width,
+            output_height=out_height,
+            bit_depth=bit_depth,
+            target_space=target_space,
+            transfer_function=transfer_function,
+            reference_white_Y=reference_white_Y,
+            include_labels=include_labels,
+            simulation_light_source=simulation_light_source,
+        )
 
     # Render chart at canvas size first
     chart_image = _render_chart_content(
@@ -98,11 +139,8 @@ def render_chart(
 
     # Otherwise, embed chart at top-left of output frame with surround color
     # Create output frame filled with surround color
-    surround_rgb = np.array(surround, dtype=np.float64)
-    surround_uint16 = np.clip(surround_rgb * max_value, 0, max_value).astype(np.uint16)
-
     output_image = np.zeros((out_height, out_width, 3), dtype=np.uint16)
-    output_image[:, :] = surround_uint16
+    output_image[:, :] = _surround_code_values(canvas, bit_depth)
 
     # Place chart at top-left corner
     output_image[0:canvas_height, 0:canvas_width] = chart_image
@@ -110,6 +148,149 @@ def render_chart(
     return output_image
 
 
+@traced("render_chart_tiled", "render")
+def render_chart_tiled(
+    layout: ChartLayout,
+    output_width: int | None = None,
+    output_height: int | None = None,
+    bit_depth: int = 12,
+    target_space: ColorSpace = ColorSpace.REC709,
+    transfer_function: TransferFunction = TransferFunction.SRGB,
+    reference_white_Y: float = 100.0,
+    include_labels: bool = False,
+    simulation_light_source: LightSource | None = None,
+    tile_size: int = 256,
+    workers: int | None = None,
+) -> NDArray[np.uint16]:
+    """
+    Render a chart layout tile by tile on a thread pool.
+
+    Gives the same pixels as ``render_chart``. Each tile is filled in a
+    float buffer of its own size (1.5 MB at the default tile size) and
+    written straight into the output, so the output is the only array the
+    size of the frame. NumPy releases the GIL while filling and converting,
+    which lets tiles render in parallel; text is drawn one tile at a time,
+    as Pillow fonts cannot be shared between threads.
+
+    Parameters
+    ----------
+    layout : ChartLayout
+        The chart layout to render.
+    output_width, output_height : int | None
+        Output frame size, at least the canvas size; None uses the canvas
+        size.
+    bit_depth : int
+        Output bit depth (8, 10, 12, or 16).
+    target_space : ColorSpace
+        Target RGB color space for conversion.
+    transfer_function : TransferFunction
+        Transfer function for encoding.
+    reference_white_Y : float
+        Reference white Y value for XYZ normalization.
+    include_labels : bool
+        Whether to render text labels on patches.
+    simulation_light_source : LightSource | None
+        If provided, the light source to simulate, as in ``render_chart``.
+    tile_size : int, optional
+        Tile edge in pixels. Default is 256.
+    workers : int | None, optional
+        Number of threads; None uses one per CPU.
+
+    Returns
+    -------
+    NDArray[np.uint16]
+        Image data as uint16 array of shape (output_height, output_width, 3).
+
+    Raises
+    ------
+    ValueError
+        If the tile size is not positive or the output is smaller than the
+        canvas.
+    """
+    canvas = layout.canvas if layout.canvas else Canvas()
+    width, height = canvas.width, canvas.height
+    out_width = output_width if output_width is not None else width
+    out_height = output_height if output_height is not None else height
+    if tile_size < 1:
+        raise ValueError(f"Tile size must be positive, got {tile_size}")
+    if out_width < width or out_height < height:
+        raise ValueError(
+            f"Output {out_width}x{out_height} is smaller than the "
+            f"{width}x{height} canvas"
+        )
+
+    output = np.empty((out_height, out_width, 3), dtype=np.uint16)
+    if out_width != width or out_height != height:
+        # Chart at top-left, surround color on the rest
+        surround = _surround_code_values(canvas, bit_depth)
+        output[height:] = surround
+        output[:height, width:] = surround
+
+    colors = _patch_colors(
+        layout,
+        target_space,
+        transfer_function,
+        reference_white_Y,
+        simulation_light_source,
+    )
+    texts = _label_texts(layout, width, height) if include_labels else []
+    texts += _annotation_texts(
+        layout,
+        width,
+        height,
+        bit_depth,
+        target_space,
+        transfer_function,
+        reference_white_Y,
+        simulation_light_source,
+    )
+    bounds = [text_bounds(text, _TEXT_MARGIN) for text in texts]
+    text_lock = threading.Lock()
+
+    def render_tile(tile: tuple[int, int, int, int]) -> None:
+        x0, y0, x1, y1 = tile
+        pixels = _render_chart_content(
+            layout,
+            width,
+            height,
+            bit_depth,
+            target_space,
+            transfer_function,
+            reference_white_Y,
+            include_labels,
+            window=tile,
+            patch_colors=colors,
+            texts=[],
+        )
+        inside = [
+            text
+            for text, (tx0, ty0, tx1, ty1) in zip(texts, bounds, strict=True)
+            if tx0 < x1 and x0 < tx1 and ty0 < y1 and y0 < ty1
+        ]
+        if inside:
+            with text_lock:
+                pixels = _draw_texts(pixels, inside, bit_depth, origin=(x0, y0))
+        output[y0:y1, x0:x1] = pixels
+
+    tiles = [
+        (x, y, min(x + tile_size, width), min(y + tile_size, height))
+        for y in range(0, height, tile_size)
+        for x in range(0, width, tile_size)
+    ]
+    with ThreadPoolExecutor(max_workers=workers or os.cpu_count()) as pool:
+        # list() re-raises the first error from a tile
+        list(pool.map(render_tile, tiles))
+
+    return output
+
+
+def _surround_code_values(canvas: Canvas, bit_depth: int) -> NDArray[np.uint16]:
+    """Code values of the area around an embedded chart."""
+    max_value = 2**bit_depth - 1
+    surround_rgb = np.array(canvas.surround, dtype=np.float64)
+    return np.clip(surround_rgb * max_value, 0, max_value).astype(np.uint16)
+
+
 def _render_chart_content(
     layout: ChartLayout,
     width: int,
@@ -120,65 +301,74 @@ def _render_chart_content(
     reference_white_Y: float,
     include_labels: bool,
     simulation_light_source: LightSource | None = None,
+    window: tuple[int, int, int, int] | None = None,
+    patch_colors: list[NDArray[np.float64]] | None = None,
+    texts: list[ChartText] | None = None,
 ) -> NDArray[np.uint16]:
     """
     Render chart content at specified dimensions.
 
     This is an internal function that renders the actual chart content
-    without frame embedding logic.
+    without frame embedding logic. With ``window`` given as
+    (x0, y0, x1, y1), only that part of the chart is rendered, with the
+    same pixels a full render has there. ``patch_colors`` (from
+    ``_patch_colors``) skips the color conversion, and ``texts`` replaces
+    the labels and annotation stripes.
     """
     max_value = 2**bit_depth - 1
+    wx0, wy0, wx1, wy1 = window if window is not None else (0, 0, width, height)
 
     # Create image as float first
-    image = np.zeros((height, width, 3), dtype=np.float64)
+    image = np.zeros((wy1 - wy0, wx1 - wx0, 3), dtype=np.float64)
 
     # Get illuminant from chart colorimetry (default to D65)
     illuminant = Illuminant.D65
     if layout.colorimetry is not None:
         illuminant = layout.colorimetry.illuminant
 
-    for patch in layout.patches:
-        # Calculate pixel bounds
-        x0 = int(patch.x_pct * width)
-        y0 = int(patch.y_pct * height)
-        x1 = int((patch.x_pct + patch.width_pct) * width)
-        y1 = int((patch.y_pct + patch.height_pct) * height)
+    for i, patch in enumerate(layout.patches):
+        # Calculate pixel bounds, then the part inside the window
+        x0, y0, x1, y1 = patch_bounds(patch, width, height)
+        cx0, cy0 = max(x0, wx0), max(y0, wy0)
+        cx1, cy1 = min(x1, wx1), min(y1, wy1)
+        if cx0 >= cx1 or cy0 >= cy1:
+            continue
 
-        # Convert color to target space
-        if patch.color.space == ColorSpace.XYZ:
-            rgb = xyz_to_display_rgb(
-                patch.color,
+        if patch_colors is not None:
+            rgb = patch_colors[i]
+        else:
+            rgb = _patch_rgb(
+                patch,
                 target_space=target_space,
                 transfer_function=transfer_function,
                 reference_white_Y=reference_white_Y,
                 illuminant=illuminant,
                 simulation_light_source=simulation_light_source,
             )
-        elif patch.color.space == target_space:
-            # Already in target space, just apply transfer function
-            if transfer_function == TransferFunction.LINEAR:
-                rgb = patch.color.values
-            elif transfer_function == TransferFunction.SRGB:
-                import colour
-
-                rgb = colour.cctf_encoding(patch.color.values, function="sRGB")
-            elif transfer_function == TransferFunction.GAMMA_22:
-                rgb = np.power(patch.color.values, 1.0 / 2.2)
-            else:
-                rgb = patch.color.values
-        else:
-            # Need cross-colorspace conversion - for now just use values directly
-            rgb = patch.color.values
 
         # Fill patch area based on pattern type
-        _fill_patch_region(image, x0, y0, x1, y1, rgb, patch.pattern)
+        _fill_patch_region(
+            image,
+            cx0 - wx0,
+            cy0 - wy0,
+            cx1 - wx0,
+            cy1 - wy0,
+            rgb,
+            patch.pattern,
+            phase=(cy0 - y0, cx0 - x0),
+        )
 
     # Convert to uint16
     image_uint16 = np.clip(image * max_value, 0, max_value).astype(np.uint16)
 
+    if texts is not None:
+        return _draw_texts(image_uint16, texts, bit_depth, origin=(wx0, wy0))
+
     # Add text labels on patches if requested
     if include_labels:
-        image_uint16 = _add_labels(image_uint16, layout, width, height, bit_depth)
+        image_uint16 = _add_labels(
+            image_uint16, layout, width, height, bit_depth, origin=(wx0, wy0)
+        )
 
     # Always add annotation stripes (critical encoding/chart metadata)
     image_uint16 = _add_annotation_stripes(
@@ -191,11 +381,92 @@ def _render_chart_content(
         transfer_function=transfer_function,
         reference_white_Y=reference_white_Y,
         simulation_light_source=simulation_light_source,
+        origin=(wx0, wy0),
     )
 
     return image_uint16
 
 
+def patch_bounds(patch: Patch, width: int, height: int) -> tuple[int, int, int, int]:
+    """
+    Pixel rectangle of a patch on a canvas.
+
+    Parameters
+    ----------
+    patch : Patch
+        The patch.
+    width, height : int
+        Canvas size in pixels.
+
+    Returns
+    -------
+    tuple[int, int, int, int]
+        (x0, y0, x1, y1), right and bottom edges exclusive.
+    """
+    x0 = int(patch.x_pct * width)
+    y0 = int(patch.y_pct * height)
+    x1 = int((patch.x_pct + patch.width_pct) * width)
+    y1 = int((patch.y_pct + patch.height_pct) * height)
+    return x0, y0, x1, y1
+
+
+def _patch_colors(
+    layout: ChartLayout,
+    target_space: ColorSpace,
+    transfer_function: TransferFunction,
+    reference_white_Y: float,
+    simulation_light_source: LightSource | None,
+) -> list[NDArray[np.float64]]:
+    """Encoded RGB of every patch in layout order, as _patch_rgb gives it."""
+    illuminant = Illuminant.D65
+    if layout.colorimetry is not None:
+        illuminant = layout.colorimetry.illuminant
+    return [
+        _patch_rgb(
+            patch,
+            target_space=target_space,
+            transfer_function=transfer_function,
+            reference_white_Y=reference_white_Y,
+            illuminant=illuminant,
+            simulation_light_source=simulation_light_source,
+        )
+        for patch in layout.patches
+    ]
+
+
+def _patch_rgb(
+    patch: Patch,
+    target_space: ColorSpace,
+    transfer_function: TransferFunction,
+    reference_white_Y: float,
+    illuminant: Illuminant,
+    simulation_light_source: LightSource | None,
+) -> NDArray[np.float64]:
+    """Encoded RGB of a patch's color in the target space."""
+    if patch.color.space == ColorSpace.XYZ:
+        return xyz_to_display_rgb(
+            patch.color,
+            target_space=target_space,
+            transfer_function=transfer_function,
+            reference_white_Y=reference_white_Y,
+            illuminant=illuminant,
+            simulation_light_source=simulation_light_source,
+        )
+    if patch.color.space == target_space:
+        # Already in target space, just apply transfer function
+        if transfer_function == TransferFunction.LINEAR:
+            return patch.color.values
+        if transfer_function == TransferFunction.SRGB:
+            import colour
+
+            return colour.cctf_encoding(patch.color.values, function="sRGB")
+        if transfer_function == TransferFunction.GAMMA_22:
+            return np.power(patch.color.values, 1.0 / 2.2)
+        return patch.color.values
+    # Need cross-colorspace conversion - for now just use values directly
+    return patch.color.values
+
+
 def _fill_patch_region(
     image: NDArray[np.float64],
     x0: int,
@@ -204,6 +475,7 @@ def _fill_patch_region(
     y1: int,
     rgb: NDArray[np.float64],
     pattern: PatternType,
+    phase: tuple[int, int] = (0, 0),
 ) -> None:
     """
     Fill a patch region with solid color or checkerboard pattern.
@@ -223,49 +495,66 @@ def _fill_patch_region(
         RGB color values (used for solid, ignored for checkerboard).
     pattern : PatternType
         The pattern type to render.
+    phase : tuple[int, int]
+        Row and column of (y0, x0) within the patch, so a region that starts
+        inside a patch keeps its checkerboard phase.
     """
-    if pattern == PatternType.SOLID:
+    is_white = checkerboard_mask(pattern, y1 - y0, x1 - x0, phase)
+    if is_white is None:
         image[y0:y1, x0:x1, :] = rgb
-    else:
-        # Checkerboard patterns use white (1.0) and black (0.0)
-        white = np.array([1.0, 1.0, 1.0])
-        black = np.array([0.0, 0.0, 0.0])
-
-        # Create coordinate grids for the patch region
-        height = y1 - y0
-        width = x1 - x0
-
-        if height == 0 or width == 0:
-            return
-
-        # Generate pattern based on coordinate parity
-        y_coords = np.arange(height).reshape(-1, 1)
-        x_coords = np.arange(width).reshape(1, -1)
-
-        # Compute parity for each pixel (0-3 for 2×2 pattern)
-        # Position in 2×2 tile: (y % 2) * 2 + (x % 2)
-        tile_pos = (y_coords % 2) * 2 + (x_coords % 2)
-
-        # Define which positions are white for each pattern
-        # Tile positions: 0=top-left, 1=top-right, 2=bottom-left, 3=bottom-right
-        if pattern == PatternType.CHECKERBOARD_50:
-            # Diagonal checkerboard: positions 0 and 3 are white
-            is_white = (tile_pos == 0) | (tile_pos == 3)
-        elif pattern == PatternType.CHECKERBOARD_25:
-            # Only position 0 is white (1 white, 3 black = 25%)
-            is_white = tile_pos == 0
-        elif pattern == PatternType.CHECKERBOARD_75:
-            # Positions 0, 1, 2 are white (3 white, 1 black = 75%)
-            is_white = tile_pos != 3
-        else:
-            # Default to solid fill for unknown patterns
-            image[y0:y1, x0:x1, :] = rgb
-            return
+        return
 
-        # Fill the patch region
-        patch_region = image[y0:y1, x0:x1, :]
-        patch_region[is_white] = white
-        patch_region[~is_white] = black
+    # Checkerboard patterns use white (1.0) and black (0.0)
+    patch_region = image[y0:y1, x0:x1, :]
+    patch_region[is_white] = 1.0
+    patch_region[~is_white] = 0.0
+
+
+def checkerboard_mask(
+    pattern: PatternType,
+    height: int,
+    width: int,
+    phase: tuple[int, int] = (0, 0),
+) -> NDArray[np.bool_] | None:
+    """
+    White pixels of a checkerboard patch region.
+
+    Parameters
+    ----------
+    pattern : PatternType
+        The pattern type.
+    height, width : int
+        Size of the region.
+    phase : tuple[int, int]
+        Row and column of the region's top-left pixel within the patch.
+
+    Returns
+    -------
+    NDArray[np.bool_] | None
+        Boolean array of shape (height, width), or None for patterns that
+        are filled solid.
+    """
+    if pattern not in _CHECKERBOARDS:
+        return None
+
+    # Generate pattern based on coordinate parity
+    y_coords = np.arange(phase[0], phase[0] + height).reshape(-1, 1)
+    x_coords = np.arange(phase[1], phase[1] + width).reshape(1, -1)
+
+    # Compute parity for each pixel (0-3 for 2×2 pattern)
+    # Position in 2×2 tile: (y % 2) * 2 + (x % 2)
+    tile_pos = (y_coords % 2) * 2 + (x_coords % 2)
+
+    # Define which positions are white for each pattern
+    # Tile positions: 0=top-left, 1=top-right, 2=bottom-left, 3=bottom-right
+    if pattern == PatternType.CHECKERBOARD_50:
+        # Diagonal checkerboard: positions 0 and 3 are white
+        return (tile_pos == 0) | (tile_pos == 3)
+    if pattern == PatternType.CHECKERBOARD_25:
+        # Only position 0 is white (1 white, 3 black = 25%)
+        return tile_pos == 0
+    # Positions 0, 1, 2 are white (3 white, 1 black = 75%)
+    return tile_pos != 3
 
 
 def _add_labels(
@@ -274,6 +563,7 @@ def _add_labels(
     width: int,
     height: int,
     bit_depth: int,
+    origin: tuple[int, int] = (0, 0),
 ) -> NDArray[np.uint16]:
     """
     Add text labels to the rendered image using Pillow.
@@ -290,34 +580,27 @@ def _add_labels(
         Image height.
     bit_depth : int
         Bit depth for scaling.
+    origin : tuple[int, int]
+        Chart position (x, y) of the image's top-left pixel, when the image
+        is a window of the chart.
 
     Returns
     -------
     NDArray[np.uint16]
         Image with labels added.
     """
-    # Convert to 8-bit for Pillow (scale down)
-    image_8bit = (image >> (bit_depth - 8)).astype(np.uint8)
+    return _draw_texts(image, _label_texts(layout, width, height), bit_depth, origin)
 
-    # Create Pillow image
-    pil_image = Image.fromarray(image_8bit, mode="RGB")
-    draw = ImageDraw.Draw(pil_image)
 
-    # Try to load a font, fall back to default
-    try:
-        font_size = max(12, min(width, height) // 50)
-        font = ImageFont.truetype("/System/Library/Fonts/Helvetica.ttc", font_size)
-    except OSError:
-        font = ImageFont.load_default()
+def _label_texts(layout: ChartLayout, width: int, height: int) -> list[ChartText]:
+    """Patch labels of a chart, in drawing order."""
+    font = label_font(width, height)
+    texts: list[ChartText] = []
 
     for patch in layout.patches:
         if not patch.label_text:
             continue
 
-        # Calculate patch center
-        x_center = int((patch.x_pct + patch.width_pct / 2) * width)
-        y_center = int((patch.y_pct + patch.height_pct / 2) * height)
-
         # Determine text color based on patch luminance
         # Use contrasting color (white for dark patches, black for light)
         if patch.color.space == ColorSpace.XYZ:
@@ -330,12 +613,40 @@ def _add_labels(
         text_color = (0, 0, 0) if luminance > 0.5 else (255, 255, 255)
 
         # Draw text centered on patch
+        texts.append(
+            (label_center(patch, width, height), patch.label_text, text_color, font)
+        )
+
+    return texts
+
+
+def _draw_texts(
+    image: NDArray[np.uint16],
+    texts: list[ChartText],
+    bit_depth: int,
+    origin: tuple[int, int] = (0, 0),
+) -> NDArray[np.uint16]:
+    """
+    Draw centered text items with Pillow.
+
+    The image goes through 8 bits and back, so every pixel is truncated to
+    its top 8 bits, not only the ones under the text.
+    """
+    if not texts:
+        # Same truncation, without the trip through Pillow
+        shift = bit_depth - 8
+        return (image >> shift) << shift
+
+    # Convert to 8-bit for Pillow (scale down)
+    image_8bit = (image >> (bit_depth - 8)).astype(np.uint8)
+
+    # Create Pillow image
+    pil_image = Image.fromarray(image_8bit, mode="RGB")
+    draw = ImageDraw.Draw(pil_image)
+
+    for (x, y), text, fill, font in texts:
         draw.text(
-            (x_center, y_center),
-            patch.label_text,
-            fill=text_color,
-            font=font,
-            anchor="mm",
+            (x - origin[0], y - origin[1]), text, fill=fill, font=font, anchor="mm"
         )
 
     # Convert back to bit depth
@@ -345,6 +656,55 @@ def _add_labels(
     return result
 
 
+@functools.lru_cache(maxsize=8)
+def label_font(width: int, height: int) -> ImageFont.ImageFont | ImageFont.FreeTypeFont:
+    """Font of the patch labels on a canvas of the given size."""
+    # Try to load a font, fall back to default
+    try:
+        font_size = max(12, min(width, height) // 50)
+        return ImageFont.truetype("/System/Library/Fonts/Helvetica.ttc", font_size)
+    except OSError:
+        return ImageFont.load_default()
+
+
+@functools.lru_cache(maxsize=8)
+def annotation_font(
+    width: int, height: int
+) -> ImageFont.ImageFont | ImageFont.FreeTypeFont:
+    """Font of the annotation stripes on a canvas of the given size."""
+    # Load font - slightly smaller for annotation text
+    try:
+        font_size = max(14, min(width, height) // 60)
+        return ImageFont.truetype("/System/Library/Fonts/Helvetica.ttc", font_size)
+    except OSError:
+        return ImageFont.load_default()
+
+
+def label_center(patch: Patch, width: int, height: int) -> tuple[int, int]:
+    """Pixel position a patch's label is centered on."""
+    x_center = int((patch.x_pct + patch.width_pct / 2) * width)
+    y_center = int((patch.y_pct + patch.height_pct / 2) * height)
+    return x_center, y_center
+
+
+def text_bounds(text: ChartText, margin: int = 0) -> tuple[int, int, int, int]:
+    """
+    Pixel rectangle (x0, y0, x1, y1) a text item covers, edges exclusive.
+
+    ``margin`` extra pixels are added on each side, to be sure of covering
+    antialiased edges.
+    """
+    draw = ImageDraw.Draw(Image.new("L", (1, 1)))
+    center, string, _, font = text
+    left, top, right, bottom = draw.textbbox(center, string, font=font, anchor="mm")
+    return (
+        int(left) - margin,
+        int(top) - margin,
+        int(right) + 1 + margin,
+        int(bottom) + 1 + margin,
+    )
+
+
 def _add_annotation_stripes(
     image: NDArray[np.uint16],
     layout: ChartLayout,
@@ -355,6 +715,7 @@ def _add_annotation_stripes(
     transfer_function: TransferFunction,
     reference_white_Y: float,
     simulation_light_source: LightSource | None = None,
+    origin: tuple[int, int] = (0, 0),
 ) -> NDArray[np.uint16]:
     """
     Add annotation stripes in the gap regions between chroma and greyscale patches.
@@ -382,25 +743,40 @@ def _add_annotation_stripes(
         Reference white Y value used.
     simulation_light_source : LightSource | None
         Light source used for chromatic adaptation simulation.
+    origin : tuple[int, int]
+        Chart position (x, y) of the image's top-left pixel, when the image
+        is a window of the chart.
 
     Returns
     -------
     NDArray[np.uint16]
         Image with annotation stripes added.
     """
-    # Convert to 8-bit for Pillow
-    image_8bit = (image >> (bit_depth - 8)).astype(np.uint8)
+    texts = _annotation_texts(
+        layout,
+        width,
+        height,
+        bit_depth,
+        target_space,
+        transfer_function,
+        reference_white_Y,
+        simulation_light_source,
+    )
+    return _draw_texts(image, texts, bit_depth, origin)
 
-    # Create Pillow image
-    pil_image = Image.fromarray(image_8bit, mode="RGB")
-    draw = ImageDraw.Draw(pil_image)
 
-    # Load font - slightly smaller for annotation text
-    try:
-        font_size = max(14, min(width, height) // 60)
-        font = ImageFont.truetype("/System/Library/Fonts/Helvetica.ttc", font_size)
-    except OSError:
-        font = ImageFont.load_default()
+def _annotation_texts(
+    layout: ChartLayout,
+    width: int,
+    height: int,
+    bit_depth: int,
+    target_space: ColorSpace,
+    transfer_function: TransferFunction,
+    reference_white_Y: float,
+    simulation_light_source: LightSource | None,
+) -> list[ChartText]:
+    """Top and bottom annotation stripe text of a chart."""
+    font = annotation_font(width, height)
 
     # Get stripe positions from layout annotations (or use defaults)
     if layout.annotations and layout.annotations.top_stripe:
@@ -459,26 +835,8 @@ def _add_annotation_stripes(
 
     bottom_text = f"{chart_name}  │  {white_info}"
 
-    # Draw top annotation stripe text (centered horizontally)
-    draw.text(
-        (width // 2, top_center_y),
-        top_text,
-        fill=text_color,
-        font=font,
-        anchor="mm",
-    )
-
-    # Draw bottom annotation stripe text (centered horizontally)
-    draw.text(
-        (width // 2, bottom_center_y),
-        bottom_text,
-        fill=text_color,
-        font=font,
-        anchor="mm",
-    )
-
-    # Convert back to bit depth
-    result_8bit = np.array(pil_image)
-    result = (result_8bit.astype(np.uint16) << (bit_depth - 8)).astype(np.uint16)
-
-    return result
+    # Both centered horizontally
+    return [
+        ((width // 2, top_center_y), top_text, text_color, font),
+        ((width // 2, bottom_center_y), bottom_text, text_color, font),
+    ]
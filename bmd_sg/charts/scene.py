@@ -0,0 +1,466 @@
+"""
+Retained chart scenes for live patch updates.
+
+A ChartScene keeps the rendered frame of a chart layout, so changing one
+patch re-renders only the rectangles that patch and its label cover instead
+of the whole chart, labels and annotation stripes. The changed rectangles
+are returned and can be sent to a device with ``present``, which repacks
+only the output rows they touch. ChartFileWatcher reloads a YAML chart when
+the file changes and applies the difference to a scene.
+"""
+
+import copy
+import dataclasses
+import threading
+from collections.abc import Callable
+from contextlib import AbstractContextManager
+from pathlib import Path
+from typing import Any
+
+import numpy as np
+
+from bmd_sg.charts.color_types import (
+    Canvas,
+    ChartLayout,
+    ColorSpace,
+    ColorValue,
+    LightSource,
+    Patch,
+    PatternType,
+    TransferFunction,
+)
+from bmd_sg.charts.loaders import load_chart
+from bmd_sg.charts.renderer import (
+    _render_chart_content,
+    label_center,
+    label_font,
+    patch_bounds,
+    render_chart,
+    text_bounds,
+)
+
+# Frame rectangle as (x, y, width, height)
+Region = tuple[int, int, int, int]
+
+# Extra pixels around a label's bounding box for antialiasing
+_LABEL_MARGIN = 2
+
+
+class ChartScene:
+    """
+    Rendered chart layout that can be updated a patch at a time.
+
+    Parameters
+    ----------
+    layout : ChartLayout
+        Layout to render; the scene keeps its own copy.
+    output_width, output_height : int | None, optional
+        Output frame size; None uses the canvas size. The chart sits at the
+        top-left of a larger frame, as with ``render_chart``.
+    bit_depth : int, optional
+        Output bit depth. Default is 12.
+    target_space : ColorSpace, optional
+        Target RGB color space. Default is Rec.709.
+    transfer_function : TransferFunction, optional
+        Transfer function for encoding. Default is sRGB.
+    reference_white_Y : float, optional
+        Reference white Y value for XYZ normalization. Default is 100.0.
+    include_labels : bool, optional
+        Whether patch labels are drawn. Default is False.
+    simulation_light_source : LightSource | None, optional
+        Light source to simulate, as with ``render_chart``.
+
+    Attributes
+    ----------
+    image : np.ndarray
+        The current output frame, uint16 with shape (height, width, 3).
+
+    Examples
+    --------
+    >>> scene = ChartScene(load_chart("chart.yaml"), bit_depth=10)
+    >>> scene.present(device, scene.render())
+    >>> regions = scene.update_patch("Red", color=ColorValue.from_rgb(1, 0, 0))
+    >>> scene.present(device, regions)
+    """
+
+    def __init__(
+        self,
+        layout: ChartLayout,
+        output_width: int | None = None,
+        output_height: int | None = None,
+        bit_depth: int = 12,
+        target_space: ColorSpace = ColorSpace.REC709,
+        transfer_function: TransferFunction = TransferFunction.SRGB,
+        reference_white_Y: float = 100.0,
+        include_labels: bool = False,
+        simulation_light_source: LightSource | None = None,
+    ) -> None:
+        self._layout = copy.deepcopy(layout)
+        self._output_size = (output_width, output_height)
+        self.bit_depth = bit_depth
+        self.target_space = target_space
+        self.transfer_function = transfer_function
+        self.reference_white_Y = reference_white_Y
+        self.include_labels = include_labels
+        self.simulation_light_source = simulation_light_source
+        self.image: np.ndarray = np.zeros((0, 0, 3), dtype=np.uint16)
+        self.full_renders = 0
+        self.region_renders = 0
+        self.render()
+
+    @property
+    def layout(self) -> ChartLayout:
+        """The retained layout (do not modify; use the update methods)."""
+        return self._layout
+
+    @property
+    def canvas_size(self) -> tuple[int, int]:
+        """Chart canvas (width, height) in pixels."""
+        canvas = self._layout.canvas if self._layout.canvas else Canvas()
+        return canvas.width, canvas.height
+
+    def render(self) -> list[Region]:
+        """
+        Re-render the whole frame.
+
+        Returns
+        -------
+        list[Region]
+            A single region covering the frame
+        """
+        self.image = render_chart(
+            self._layout,
+            output_width=self._output_size[0],
+            output_height=self._output_size[1],
+            **self._render_args(),
+        )
+        self.full_renders += 1
+        height, width = self.image.shape[:2]
+        return [(0, 0, width, height)]
+
+    def find_patch(self, patch: int | str) -> int:
+        """
+        Index of a patch, given its index or name.
+
+        Raises
+        ------
+        ValueError
+            If there is no such patch
+        """
+        patches = self._layout.patches
+        if isinstance(patch, int):
+            if 0 <= patch < len(patches):
+                return patch
+        else:
+            for index, candidate in enumerate(patches):
+                if candidate.name == patch:
+                    return index
+        raise ValueError(f"Unknown patch {patch!r}")
+
+    def update_patch(
+        self,
+        patch: int | str,
+        color: ColorValue | None = None,
+        pattern: PatternType | None = None,
+    ) -> list[Region]:
+        """
+        Change one patch's color and/or pattern.
+
+        Parameters
+        ----------
+        patch : int | str
+            Patch index or name
+        color : ColorValue | None, optional
+            New color; None keeps the current one
+        pattern : PatternType | None, optional
+            New pattern; None keeps the current one
+
+        Returns
+        -------
+        list[Region]
+            Frame rectangles that changed
+
+        Raises
+        ------
+        ValueError
+            If there is no such patch
+        """
+        index = self.find_patch(patch)
+        old = self._layout.patches[index]
+        new = dataclasses.replace(
+            old,
+            color=color if color is not None else old.color,
+            pattern=pattern if pattern is not None else old.pattern,
+        )
+        if _patch_key(new) == _patch_key(old):
+            return []
+        self._layout.patches[index] = new
+        return self._redraw([self._footprint(old), self._footprint(new)])
+
+    def apply_layout(self, layout: ChartLayout) -> list[Region]:
+        """
+        Replace the layout, re-rendering only the patches that differ.
+
+        A change to anything but the patches themselves (name, colorimetry,
+        annotations, canvas or the number of patches) re-renders the whole
+        frame.
+
+        Parameters
+        ----------
+        layout : ChartLayout
+            New layout; the scene keeps its own copy
+
+        Returns
+        -------
+        list[Region]
+            Frame rectangles that changed
+        """
+        old_layout = self._layout
+        self._layout = copy.deepcopy(layout)
+        if _layout_key(old_layout) != _layout_key(self._layout) or len(
+            old_layout.patches
+        ) != len(self._layout.patches):
+            return self.render()
+
+        rects = []
+        for old, new in zip(old_layout.patches, self._layout.patches, strict=True):
+            if _patch_key(old) != _patch_key(new):
+                rects += [self._footprint(old), self._footprint(new)]
+        return self._redraw(rects)
+
+    def present(self, device: Any, regions: list[Region]) -> None:
+        """
+        Send changed regions of the frame to a device.
+
+        A region covering the whole frame displays it with
+        ``display_frame``; smaller ones go through
+        ``update_frame_regions`` so only the rows they touch are repacked.
+
+        Parameters
+        ----------
+        device : BMDDeckLink
+            Open device showing this scene (or about to)
+        regions : list[Region]
+            Regions returned by ``render``, ``update_patch`` or
+            ``apply_layout``
+        """
+        if not regions:
+            return
+        height, width = self.image.shape[:2]
+        if regions == [(0, 0, width, height)]:
+            device.display_frame(self.image)
+        else:
+            device.update_frame_regions(self.image, regions)
+
+    def _render_args(self) -> dict[str, Any]:
+        return {
+            "bit_depth": self.bit_depth,
+            "target_space": self.target_space,
+            "transfer_function": self.transfer_function,
+            "reference_white_Y": self.reference_white_Y,
+            "include_labels": self.include_labels,
+            "simulation_light_source": self.simulation_light_source,
+        }
+
+    def _footprint(self, patch: Patch) -> tuple[int, int, int, int]:
+        """Canvas rectangle (x0, y0, x1, y1) a patch and its label cover."""
+        width, height = self.canvas_size
+        x0, y0, x1, y1 = patch_bounds(patch, width, height)
+        if self.include_labels and patch.label_text:
+            label = (
+                label_center(patch, width, height),
+                patch.label_text,
+                (0, 0, 0),
+                label_font(width, height),
+            )
+            lx0, ly0, lx1, ly1 = text_bounds(label, margin=_LABEL_MARGIN)
+            x0, y0 = min(x0, lx0), min(y0, ly0)
+            x1, y1 = max(x1, lx1), max(y1, ly1)
+        return max(x0, 0), max(y0, 0), min(x1, width), min(y1, height)
+
+    def _redraw(self, rects: list[tuple[int, int, int, int]]) -> list[Region]:
+        """Re-render canvas rectangles into the frame."""
+        width, height = self.canvas_size
+        regions = []
+        for x0, y0, x1, y1 in _merge_rects(rects):
+            self.image[y0:y1, x0:x1] = _render_chart_content(
+                self._layout,
+                width=width,
+                height=height,
+                window=(x0, y0, x1, y1),
+                **self._render_args(),
+            )
+            self.region_renders += 1
+            regions.append((x0, y0, x1 - x0, y1 - y0))
+        return regions
+
+
+class ChartFileWatcher:
+    """
+    Reloads a YAML chart when its file changes and applies it to a scene.
+
+    The file is polled for a new modification time or size. Each change is
+    loaded with ``load_chart`` and applied with ``ChartScene.apply_layout``,
+    and the changed regions are passed to ``on_change``. A file that fails to
+    load (for example while an editor is still writing it) leaves the scene
+    as it was; the error is kept in ``last_error`` until a load succeeds.
+
+    Parameters
+    ----------
+    path : Path | str
+        YAML chart file
+    scene : ChartScene
+        Scene showing the chart
+    on_change : Callable[[list[Region]], None]
+        Called with the changed regions after each reload, typically to
+        ``present`` them
+    interval : float, optional
+        Polling interval in seconds. Default is 0.25.
+    lock : AbstractContextManager | None, optional
+        Held while the scene is updated and ``on_change`` runs, to serialise
+        with other users of the scene
+
+    Examples
+    --------
+    >>> watcher = ChartFileWatcher(
+    ...     "chart.yaml", scene, lambda regions: scene.present(device, regions)
+    ... )
+    >>> watcher.start()
+    """
+
+    def __init__(
+        self,
+        path: Path | str,
+        scene: ChartScene,
+        on_change: Callable[[list[Region]], None],
+        interval: float = 0.25,
+        lock: AbstractContextManager[Any] | None = None,
+    ) -> None:
+        self.path = Path(path)
+        self.scene = scene
+        self.on_change = on_change
+        self.interval = interval
+        self.reloads = 0
+        self.last_error: str | None = None
+        self._lock = lock or threading.Lock()
+        self._signature = self._stat()
+        self._stop = threading.Event()
+        self._thread: threading.Thread | None = None
+
+    @property
+    def running(self) -> bool:
+        """Whether the polling thread is running."""
+        return self._thread is not None and self._thread.is_alive()
+
+    def start(self) -> None:
+        """Start polling on a daemon thread."""
+        if self.running:
+            return
+        self._stop.clear()
+        self._thread = threading.Thread(target=self._run, daemon=True)
+        self._thread.start()
+
+    def stop(self, wait: bool = True) -> None:
+        """
+        Stop polling.
+
+        Parameters
+        ----------
+        wait : bool, optional
+            Wait for the thread to finish. Pass False while holding
+            ``lock``; a reload already waiting for it is then dropped.
+            Default is True.
+        """
+        self._stop.set()
+        if self._thread is not None:
+            if wait:
+                self._thread.join()
+            self._thread = None
+
+    def poll(self) -> list[Region] | None:
+        """
+        Check the file once, reloading it if it changed.
+
+        Returns
+        -------
+        list[Region] | None
+            Regions that changed, or None if the file did not change or
+            failed to load
+        """
+        signature = self._stat()
+        if signature == self._signature:
+            return None
+        self._signature = signature
+        try:
+            layout = load_chart(self.path, include_labels=self.scene.include_labels)
+        except Exception as e:
+            self.last_error = f"Failed to reload {self.path}: {e!s}"
+            return None
+        with self._lock:
+            if self._stop.is_set():
+                return None
+            regions = self.scene.apply_layout(layout)
+            self.reloads += 1
+            self.last_error = None
+            self.on_change(regions)
+        return regions
+
+    def _stat(self) -> tuple[int, int] | None:
+        try:
+            stat = self.path.stat()
+        except OSError:
+            return None
+        return stat.st_mtime_ns, stat.st_size
+
+    def _run(self) -> None:
+        while not self._stop.wait(self.interval):
+            try:
+                self.poll()
+            except Exception as e:
+                self.last_error = f"Failed to apply {self.path}: {e!s}"
+
+
+def _layout_key(layout: ChartLayout) -> tuple[Any, ...]:
+    """Everything outside the patches that affects the rendered frame."""
+    return layout.name, layout.colorimetry, layout.annotations, layout.canvas
+
+
+def _patch_key(patch: Patch) -> tuple[Any, ...]:
+    """Comparable value of a patch (ColorValue holds an array)."""
+    return (
+        patch.name,
+        patch.x_pct,
+        patch.y_pct,
+        patch.width_pct,
+        patch.height_pct,
+        patch.color.space,
+        tuple(np.asarray(patch.color.values, dtype=np.float64).tolist()),
+        patch.pattern,
+        patch.label_text,
+    )
+
+
+def _merge_rects(
+    rects: list[tuple[int, int, int, int]],
+) -> list[tuple[int, int, int, int]]:
+    """Union overlapping or touching rectangles; empty ones are dropped."""
+    merged = [r for r in rects if r[0] < r[2] and r[1] < r[3]]
+    changed = True
+    while changed:
+        changed = False
+        for i in range(len(merged)):
+            for j in range(i + 1, len(merged)):
+                a, b = merged[i], merged[j]
+                if a[0] <= b[2] and b[0] <= a[2] and a[1] <= b[3] and b[1] <= a[3]:
+                    merged[i] = (
+                        min(a[0], b[0]),
+                        min(a[1], b[1]),
+                        max(a[2], b[2]),
+                        max(a[3], b[3]),
+                    )
+                    del merged[j]
+                    changed = True
+                    break
+            if changed:
+                break
+    return merged
@@ -0,0 +1,340 @@
+"""
+Chart sweeps across simulated light sources.
+
+Rendering a chart once per light source with ``render_chart`` repeats
+everything that does not depend on the light: patch geometry,
+checkerboards, fonts and the whole-frame passes through Pillow. A sweep
+instead converts every XYZ patch under every light source in one batched
+call, rasterizes the layout once into a map of palette indices and builds
+each frame with a single palette lookup. Only text is redrawn per frame,
+because its antialiased edges blend with the colors under it, and only
+inside the rectangles it covers.
+
+The frames can be packed into the device's frame cache as they are
+rendered with ``cache_sweep_clip`` and played back from there.
+"""
+
+from collections.abc import Iterable, Iterator, Sequence
+from typing import Any
+
+import numpy as np
+from numpy.typing import NDArray
+from PIL import Image, ImageDraw
+
+from bmd_sg.charts.color_types import (
+    Canvas,
+    ChartLayout,
+    ColorSpace,
+    Illuminant,
+    LightSource,
+    TransferFunction,
+)
+from bmd_sg.charts.conversion import xyz_to_display_rgb_sweep
+from bmd_sg.charts.renderer import (
+    _TEXT_MARGIN,
+    ChartText,
+    _annotation_texts,
+    _label_texts,
+    _patch_rgb,
+    _surround_code_values,
+    checkerboard_mask,
+    patch_bounds,
+    text_bounds,
+)
+from bmd_sg.charts.scene import _merge_rects
+from bmd_sg.utilities.tracing import tracer
+
+
+def render_chart_sweep(
+    layout: ChartLayout,
+    light_sources: Sequence[LightSource],
+    output_width: int | None = None,
+    output_height: int | None = None,
+    bit_depth: int = 12,
+    target_space: ColorSpace = ColorSpace.REC709,
+    transfer_function: TransferFunction = TransferFunction.SRGB,
+    reference_white_Y: float = 100.0,
+    include_labels: bool = False,
+) -> Iterator[NDArray[np.uint16]]:
+    """
+    Render a chart as simulated under each of several light sources.
+
+    Yields, in order, the frames ``render_chart`` returns with each light
+    source as ``simulation_light_source``. All color conversion happens
+    before the first frame; each frame after that costs a palette lookup
+    and the text redraw.
+
+    Parameters
+    ----------
+    layout : ChartLayout
+        The chart layout to render.
+    light_sources : Sequence[LightSource]
+        Light sources to simulate, one frame each.
+    output_width, output_height : int | None
+        Output frame size; None uses the canvas size.
+    bit_depth : int
+        Output bit depth (8, 10, 12, or 16).
+    target_space : ColorSpace
+        Target RGB color space for conversion.
+    transfer_function : TransferFunction
+        Transfer function for encoding.
+    reference_white_Y : float
+        Reference white Y value for XYZ normalization.
+    include_labels : bool
+        Whether to render text labels on patches.
+
+    Yields
+    ------
+    NDArray[np.uint16]
+        A new array of shape (output_height, output_width, 3) per light
+        source.
+
+    Examples
+    --------
+    >>> lights = [LightSource(cct=cct) for cct in range(2800, 6800, 80)]
+    >>> for frame in render_chart_sweep(layout, lights, bit_depth=10):
+    ...     device.display_frame(frame)
+    """
+    light_sources = list(light_sources)
+    if not light_sources:
+        return
+
+    canvas = layout.canvas if layout.canvas else Canvas()
+    width, height = canvas.width, canvas.height
+    out_width = output_width if output_width is not None else width
+    out_height = output_height if output_height is not None else height
+
+    palettes = _sweep_palettes(
+        layout,
+        light_sources,
+        bit_depth,
+        target_space,
+        transfer_function,
+        reference_white_Y,
+    )
+    index = _palette_index(layout, width, height, palettes.shape[1] - 1)
+    if out_width != width or out_height != height:
+        # Embed at top-left of the output frame, as render_chart does
+        canvas_index = index
+        index = np.full((out_height, out_width), palettes.shape[1], dtype=np.intp)
+        index[0:height, 0:width] = canvas_index
+        surround = _surround_code_values(canvas, bit_depth)
+        palettes = np.concatenate(
+            [palettes, np.broadcast_to(surround, (len(light_sources), 1, 3))], axis=1
+        )
+    rows, row_of_line = _distinct_rows(index)
+
+    def annotation_texts(light_source: LightSource | None) -> list[ChartText]:
+        return _annotation_texts(
+            layout,
+            width,
+            height,
+            bit_depth,
+            target_space,
+            transfer_function,
+            reference_white_Y,
+            light_source,
+        )
+
+    # Text that does not change with the light (the labels, and annotations
+    # that read the same without a simulated light) is rasterized once
+    labels = _label_texts(layout, width, height) if include_labels else []
+    masks = {text: _text_mask(text) for text in labels + annotation_texts(None)}
+
+    for palette, light_source in zip(palettes, light_sources, strict=True):
+        with tracer.span("render_chart_sweep frame", "render"):
+            frame = np.take(np.take(palette, rows, axis=0), row_of_line, axis=0)
+            texts = labels + annotation_texts(light_source)
+            _draw_text_windows(frame, texts, masks, width, height, bit_depth)
+        yield frame
+
+
+def cache_sweep_clip(
+    device: Any,
+    frames: Iterable[NDArray[np.uint16]],
+    first_key: int = 0,
+) -> list[int]:
+    """
+    Pack frames into a device's frame cache under consecutive keys.
+
+    Each frame is packed and compressed as soon as it is produced, so a
+    sweep from ``render_chart_sweep`` never holds more than one unpacked
+    frame. The clip then plays with no per-frame rendering or packing.
+
+    Parameters
+    ----------
+    device : BMDDeckLink
+        Open device whose output format the frames are packed for.
+    frames : Iterable[NDArray[np.uint16]]
+        Frames in playback order.
+    first_key : int, optional
+        Cache key of the first frame. Default is 0.
+
+    Returns
+    -------
+    list[int]
+        Cache keys of the frames, in order.
+
+    Examples
+    --------
+    >>> keys = cache_sweep_clip(device, render_chart_sweep(layout, lights))
+    >>> device.start_scheduler()
+    >>> for key in keys:
+    ...     device.schedule_cached_frame(key, duration_frames=12)
+    """
+    keys = []
+    for key, frame in enumerate(frames, start=first_key):
+        device.cache_frame(key, frame)
+        keys.append(key)
+    return keys
+
+
+def _sweep_palettes(
+    layout: ChartLayout,
+    light_sources: list[LightSource],
+    bit_depth: int,
+    target_space: ColorSpace,
+    transfer_function: TransferFunction,
+    reference_white_Y: float,
+) -> NDArray[np.uint16]:
+    """
+    Code values of every palette entry under every light source.
+
+    Entries are the patches in layout order, then checkerboard white,
+    checkerboard black and the empty canvas. Shape (N, patches + 3, 3).
+    """
+    patches = layout.patches
+    illuminant = Illuminant.D65
+    if layout.colorimetry is not None:
+        illuminant = layout.colorimetry.illuminant
+
+    colors = np.zeros((len(light_sources), len(patches) + 3, 3), dtype=np.float64)
+    colors[:, len(patches)] = 1.0
+
+    xyz_patches = [i for i, p in enumerate(patches) if p.color.space == ColorSpace.XYZ]
+    if xyz_patches:
+        colors[:, xyz_patches] = xyz_to_display_rgb_sweep(
+            np.array([patches[i].color.values for i in xyz_patches]),
+            light_sources,
+            target_space=target_space,
+            transfer_function=transfer_function,
+            reference_white_Y=reference_white_Y,
+            illuminant=illuminant,
+        )
+    for i, patch in enumerate(patches):
+        # Only XYZ colors are adapted to the simulated light
+        if patch.color.space != ColorSpace.XYZ:
+            colors[:, i] = _patch_rgb(
+                patch,
+                target_space=target_space,
+                transfer_function=transfer_function,
+                reference_white_Y=reference_white_Y,
+                illuminant=illuminant,
+                simulation_light_source=None,
+            )
+
+    max_value = 2**bit_depth - 1
+    palettes = np.clip(colors * max_value, 0, max_value).astype(np.uint16)
+    # The annotation text pass truncates the whole chart to 8 bits
+    shift = bit_depth - 8
+    return (palettes >> shift) << shift
+
+
+def _palette_index(
+    layout: ChartLayout, width: int, height: int, empty: int
+) -> NDArray[np.intp]:
+    """Palette entry of every canvas pixel, in _sweep_palettes order."""
+    count = len(layout.patches)
+    index = np.full((height, width), empty, dtype=np.intp)
+    for i, patch in enumerate(layout.patches):
+        x0, y0, x1, y1 = patch_bounds(patch, width, height)
+        region = index[y0:y1, x0:x1]
+        if region.size == 0:
+            continue
+        is_white = checkerboard_mask(patch.pattern, *region.shape)
+        if is_white is None:
+            region[...] = i
+        else:
+            region[...] = np.where(is_white, count, count + 1)
+    return index
+
+
+def _distinct_rows(
+    index: NDArray[np.intp],
+) -> tuple[NDArray[np.intp], NDArray[np.intp]]:
+    """
+    Rows of an index map with repeats removed, and the row each line uses.
+
+    Charts are mostly rectangles, so a line usually repeats the one above
+    it, or the one two above inside a checkerboard; only those repeats are
+    looked for, which is enough to leave a handful of rows per patch band.
+    """
+    same_as_previous = np.zeros(len(index), dtype=bool)
+    same_as_previous[1:] = (index[1:] == index[:-1]).all(axis=1)
+    same_as_second = np.zeros(len(index), dtype=bool)
+    same_as_second[2:] = (index[2:] == index[:-2]).all(axis=1)
+
+    row_of_line = np.empty(len(index), dtype=np.intp)
+    distinct: list[int] = []
+    for line in range(len(index)):
+        if same_as_previous[line]:
+            row_of_line[line] = row_of_line[line - 1]
+        elif same_as_second[line]:
+            row_of_line[line] = row_of_line[line - 2]
+        else:
+            row_of_line[line] = len(distinct)
+            distinct.append(line)
+    return index[distinct], row_of_line
+
+
+def _text_mask(
+    text: ChartText,
+) -> tuple[tuple[int, int, int, int], Image.Image]:
+    """Bounds of a text item and its coverage there, as Pillow blends it."""
+    bounds = text_bounds(text, _TEXT_MARGIN)
+    x0, y0, x1, y1 = bounds
+    (x, y), string, _, font = text
+    mask = Image.new("L", (x1 - x0, y1 - y0))
+    # Ink 255 over 0 blends to exactly the glyph coverage
+    ImageDraw.Draw(mask).text(
+        (x - x0, y - y0), string, fill=255, font=font, anchor="mm"
+    )
+    return bounds, mask
+
+
+def _draw_text_windows(
+    frame: NDArray[np.uint16],
+    texts: list[ChartText],
+    masks: dict[ChartText, tuple[tuple[int, int, int, int], Image.Image]],
+    width: int,
+    height: int,
+    bit_depth: int,
+) -> None:
+    """
+    Draw text into the frame, with the same pixels ``_draw_texts`` gives.
+
+    Each merged text rectangle goes through 8 bits and back on its own.
+    Text with a mask is blended from it by the routine Pillow draws text
+    with, so it comes out as if it were drawn.
+    """
+    placed = [
+        masks[text] if text in masks else (text_bounds(text, _TEXT_MARGIN), None)
+        for text in texts
+    ]
+    clipped = [
+        (max(x0, 0), max(y0, 0), min(x1, width), min(y1, height))
+        for (x0, y0, x1, y1), _ in placed
+    ]
+    for wx0, wy0, wx1, wy1 in _merge_rects(clipped):
+        window = frame[wy0:wy1, wx0:wx1]
+        pil_image = Image.fromarray((window >> (bit_depth - 8)).astype(np.uint8))
+        draw = ImageDraw.Draw(pil_image)
+        for text, ((x0, y0, x1, y1), mask) in zip(texts, placed, strict=True):
+            if x0 >= wx1 or wx0 >= x1 or y0 >= wy1 or wy0 >= y1:
+                continue
+            (x, y), string, fill, font = text
+            if mask is not None:
+                draw.bitmap((x0 - wx0, y0 - wy0), mask, fill=fill)
+            else:
+                draw.text((x - wx0, y - wy0), string, fill=fill, font=font, anchor="mm")
+        window[...] = np.array(pil_image).astype(np.uint16) << (bit_depth - 8)
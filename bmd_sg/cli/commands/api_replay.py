@@ -0,0 +1,193 @@
+"""
+API replay command for BMD CLI.
+
+This module provides the command that re-issues a session recorded with
+``api-server --record`` and reports latency distributions and throughput,
+either against a running server or against a local server started from the
+global device options (typically ``--mock-device``).
+"""
+
+import json
+import socket
+import threading
+import time
+from pathlib import Path
+from typing import Annotated
+
+import typer
+import uvicorn
+from rich.console import Console
+from rich.table import Table
+
+from bmd_sg.api.device_manager import device_manager
+from bmd_sg.api.session import ReplayReport, load_session, replay_session
+from bmd_sg.cli.shared import setup_tools_from_context
+
+
+def _parse_speed(speed: str) -> float | None:
+    """Parse ``1``, ``4x`` or ``max`` into a replay speed (None for max)."""
+    value = speed.strip().lower()
+    if value == "max":
+        return None
+    value = value.removesuffix("x")
+    try:
+        parsed = float(value)
+    except ValueError:
+        raise typer.BadParameter(f"Invalid speed: {speed}") from None
+    if parsed <= 0:
+        raise typer.BadParameter("Speed must be positive")
+    return parsed
+
+
+def _start_local_server() -> tuple[uvicorn.Server, threading.Thread, str]:
+    """Serve the API app on a free loopback port in a background thread."""
+    with socket.socket() as probe:
+        probe.bind(("127.0.0.1", 0))
+        port = probe.getsockname()[1]
+
+    config = uvicorn.Config(
+        "bmd_sg.api.main:app", host="127.0.0.1", port=port, log_level="warning"
+    )
+    server = uvicorn.Server(config)
+    thread = threading.Thread(target=server.run, daemon=True)
+    thread.start()
+
+    deadline = time.monotonic() + 10.0
+    while not server.started:
+        if not thread.is_alive() or time.monotonic() > deadline:
+            raise RuntimeError("Local API server failed to start")
+        time.sleep(0.01)
+    return server, thread, f"http://127.0.0.1:{port}"
+
+
+def _print_report(report: ReplayReport) -> None:
+    """Print a replay report as a table."""
+    console = Console()
+    console.print(
+        f"{report.requests} requests in {report.wall_seconds:.2f} s "
+        f"({report.throughput:.1f} req/s), {report.errors} errors, "
+        f"{report.status_mismatches} status mismatches, "
+        f"max schedule lag {report.max_lag_ms:.1f} ms"
+    )
+
+    table = Table(title="Latency (ms)")
+    for column in ("Route", "Count", "Mean", "p50", "p90", "p99", "Max"):
+        table.add_column(column, justify="left" if column == "Route" else "right")
+    rows = [
+        ("all (recorded)", report.recorded),
+        ("all (replay)", report.latency),
+        *report.routes.items(),
+    ]
+    for name, stats in rows:
+        table.add_row(
+            name,
+            str(stats.count),
+            *(
+                f"{v:.2f}"
+                for v in (stats.mean, stats.p50, stats.p90, stats.p99, stats.max)
+            ),
+        )
+    console.print(table)
+
+
+def api_replay_command(
+    ctx: typer.Context,
+    session_path: Annotated[
+        Path,
+        typer.Argument(
+            help="Session file recorded with api-server --record",
+            exists=True,
+            dir_okay=False,
+        ),
+    ],
+    url: Annotated[
+        str | None,
+        typer.Option(
+            "--url",
+            help="Server to replay against (default: start a local server)",
+        ),
+    ] = None,
+    speed: Annotated[
+        str,
+        typer.Option(
+            "--speed",
+            "-s",
+            help="Playback speed: 1 (recorded pace), N for N times faster, or max",
+        ),
+    ] = "1",
+    json_path: Annotated[
+        Path | None,
+        typer.Option("--json", help="Also write the report as JSON"),
+    ] = None,
+) -> None:
+    """
+    Replay a recorded API session and report latency and throughput.
+
+    Requests are re-issued in recorded order, one at a time. At 1x they are
+    sent at their recorded offsets, so the schedule lag shows whether the
+    server keeps up with the real workload; ``max`` sends each request as soon
+    as the previous one completes.
+
+    Without ``--url`` a local API server is started on a free loopback port
+    using the global device options, so
+    ``bmd-signal-gen --mock-device api-replay session.jsonl`` benchmarks the
+    API and device manager with no hardware attached.
+
+    Parameters
+    ----------
+    ctx : typer.Context
+        Typer context containing global device settings
+    session_path : Path
+        Session file recorded with ``api-server --record``
+    url : str | None
+        Base URL of a running server (default: start a local server)
+    speed : str
+        ``1``, ``N`` / ``Nx`` or ``max`` (default: 1)
+    json_path : Path | None
+        Also write the report as JSON (default: None)
+
+    Examples
+    --------
+    >>> bmd-cli --mock-device api-replay session.jsonl --speed max
+    >>> bmd-cli api-replay session.jsonl --url http://127.0.0.1:4844 -s 4x
+    """
+    playback_speed = _parse_speed(speed)
+
+    try:
+        session = load_session(session_path)
+    except (OSError, ValueError, TypeError, RuntimeError) as e:
+        typer.echo(f"❌ Failed to read session: {e!s}", err=True)
+        raise typer.Exit(1) from e
+    if not session:
+        typer.echo("Session contains no requests")
+        return
+
+    server = None
+    thread = None
+    try:
+        if url is None:
+            decklink, generator = setup_tools_from_context(ctx, use_daemon=False)
+            device_manager.initialize(decklink, generator, ctx.obj["device_settings"])
+            server, thread, url = _start_local_server()
+
+        label = "max speed" if playback_speed is None else f"{playback_speed:g}x"
+        typer.echo(f"Replaying {len(session)} requests against {url} at {label}")
+        report = replay_session(session, url, speed=playback_speed)
+
+    except Exception as e:
+        typer.echo(f"❌ Replay failed: {e!s}", err=True)
+        raise typer.Exit(1) from e
+
+    finally:
+        if server is not None and thread is not None:
+            server.should_exit = True
+            thread.join(timeout=10.0)
+        device_manager.shutdown()
+
+    _print_report(report)
+    if json_path is not None:
+        json_path.write_text(json.dumps(report.to_dict(), indent=2))
+        typer.echo(f"Report written to {json_path}")
+
+
+__all__ = ["api_replay_command"]
@@ -8,6 +8,7 @@ real-time pattern updates via HTTP API.
 """
 
 import ipaddress
+from pathlib import Path
 from typing import Annotated
 
 import typer
@@ -16,7 +17,9 @@ from rich.console import Console
 from rich.panel import Panel
 
 from bmd_sg.api.device_manager import device_manager
+from bmd_sg.api.session import session_recorder
 from bmd_sg.cli.shared import setup_tools_from_context
+from bmd_sg.utilities.tracing import tracer
 
 
 def _show_network_exposure_warning(host: str) -> None:
@@ -150,6 +153,20 @@ def api_server_command(
             help="Enable auto-reload for development",
         ),
     ] = False,
+    record: Annotated[
+        Path | None,
+        typer.Option(
+            "--record",
+            help="Record every request to this session file for api-replay",
+        ),
+    ] = None,
+    trace: Annotated[
+        Path | None,
+        typer.Option(
+            "--trace",
+            help="Write a Chrome/Perfetto trace of every frame to this file on exit",
+        ),
+    ] = None,
 ) -> None:
     """
     Start FastAPI server with current device configuration.
@@ -178,6 +195,10 @@ def api_server_command(
         Port number for the API server (default: 4844)
     reload : bool
         Enable auto-reload for development (default: False)
+    record : Path | None
+        Session file to record requests to (default: no recording)
+    trace : Path | None
+        Trace file to write on exit (default: no tracing)
 
     Examples
     --------
@@ -196,6 +217,12 @@ def api_server_command(
     Development mode with auto-reload:
     >>> bmd-cli api-server --reload
 
+    Record a session to replay later as a benchmark:
+    >>> bmd-cli api-server --record session.jsonl
+
+    Trace every frame from request to completion, for Perfetto:
+    >>> bmd-cli api-server --trace trace.json
+
     Notes
     -----
     The server will initialize the DeckLink device using the same workflow
@@ -232,7 +259,7 @@ def api_server_command(
         typer.echo("🔧 Initializing DeckLink device from CLI settings...")
 
         # Initialize device using existing CLI workflow
-        decklink, generator = setup_tools_from_context(ctx)
+        decklink, generator = setup_tools_from_context(ctx, use_daemon=False)
 
         # Get device settings for the API
         settings = ctx.obj["device_settings"]
@@ -255,14 +282,31 @@ def api_server_command(
         typer.echo(f"📖 API docs: http://{host}:{port}/docs")
         typer.echo("💡 Press Ctrl+C to stop the server")
 
+        if record is not None:
+            if reload:
+                raise RuntimeError("--record cannot be combined with --reload")
+            session_recorder.start(record)
+            typer.echo(f"⏺️  Recording session to {record}")
+        if trace is not None:
+            if reload:
+                raise RuntimeError("--trace cannot be combined with --reload")
+            tracer.start()
+            typer.echo(f"🔍 Tracing frames to {trace}")
+
         # Start the FastAPI server
-        uvicorn.run(
-            "bmd_sg.api.main:app",
-            host=host,
-            port=port,
-            reload=reload,
-            log_level="info",
-        )
+        try:
+            uvicorn.run(
+                "bmd_sg.api.main:app",
+                host=host,
+                port=port,
+                reload=reload,
+                log_level="info",
+            )
+        finally:
+            session_recorder.stop()
+            if tracer.active:
+                summary = tracer.stop(trace)["otherData"]
+                typer.echo(f"🔍 Wrote trace of {summary['frames']} frames to {trace}")
 
     except KeyboardInterrupt:
         typer.echo("\n🛑 Server stopped by user")
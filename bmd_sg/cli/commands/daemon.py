@@ -0,0 +1,124 @@
+"""
+Device daemon commands for BMD CLI.
+
+``daemon start`` opens and configures the device from the global options and
+keeps the output running, serving pattern commands over a local socket.
+While it runs, ``solid``, ``pat2``-``pat4`` and ``display-tiff`` route through
+it instead of opening the device themselves.
+"""
+
+import json
+from pathlib import Path
+from typing import Annotated
+
+import typer
+
+from bmd_sg.cli.shared import (
+    describe_daemon_thread_policy,
+    get_device_settings,
+    is_mock_mode_enabled,
+)
+from bmd_sg.daemon import DeviceDaemon, connect_daemon, default_socket_path
+
+daemon_app = typer.Typer(
+    no_args_is_help=True,
+    help="Run a persistent device daemon that CLI commands reuse",
+)
+
+
+def _socket_path(ctx: typer.Context) -> Path:
+    return Path(ctx.obj.get("daemon_socket") or default_socket_path())
+
+
+@daemon_app.command(name="start")
+def daemon_start_command(ctx: typer.Context) -> None:
+    """
+    Open the device and serve it until stopped.
+
+    Runs in the foreground (use ``&`` or a service manager to background it).
+    The device is configured from the global options; pattern commands that
+    request a different pixel format or HDR metadata reconfigure it in place.
+
+    Examples:
+        bmd-signal-gen --pixel-format 12BIT_RGBLE daemon start &
+        bmd-signal-gen solid 4095 0 0 -t 0.1
+        bmd-signal-gen daemon stop
+    """
+    daemon = DeviceDaemon(
+        get_device_settings(ctx),
+        use_mock=is_mock_mode_enabled(ctx),
+        socket_path=_socket_path(ctx),
+    )
+    try:
+        daemon.open()
+    except RuntimeError as e:
+        typer.echo(f"Failed to start device daemon: {e!s}", err=True)
+        raise typer.Exit(1) from e
+
+    typer.echo(f"Device daemon listening on {daemon.socket_path} (Ctrl+C to stop)")
+    daemon.serve_forever()
+    typer.echo("Device daemon stopped")
+
+
+@daemon_app.command(name="stop")
+def daemon_stop_command(ctx: typer.Context) -> None:
+    """Stop a running device daemon, releasing the device."""
+    client = connect_daemon(_socket_path(ctx))
+    if client is None:
+        typer.echo("No device daemon running")
+        raise typer.Exit(1)
+    client.stop()
+    client.close()
+    typer.echo("Device daemon stopped")
+
+
+@daemon_app.command(name="status")
+def daemon_status_command(
+    ctx: typer.Context,
+    as_json: Annotated[
+        bool, typer.Option("--json", help="Print the raw status as JSON")
+    ] = False,
+) -> None:
+    """Show whether a daemon is running and what it is outputting."""
+    client = connect_daemon(_socket_path(ctx))
+    if client is None:
+        typer.echo("No device daemon running")
+        raise typer.Exit(1)
+    status = client.status()
+    client.close()
+
+    if as_json:
+        typer.echo(json.dumps(status, indent=2))
+        return
+    mock = " (mock)" if status["mock"] else ""
+    typer.echo(f"Device daemon running (pid {status['pid']}) at {client.socket_path}")
+    typer.echo(f"  Device: {status['device_name']}{mock}")
+    typer.echo(f"  Pixel format: {status['pixel_format']} ({status['bit_depth']}-bit)")
+    hdr = "off" if status["config"]["no_hdr"] else status["config"]["eotf"]
+    typer.echo(f"  HDR: {hdr}")
+    typer.echo(f"  Uptime: {status['uptime_seconds']:.1f} s")
+    typer.echo(
+        f"  Frames displayed: {status['frames_displayed']} "
+        f"({status['requests']} requests)"
+    )
+    stats = status.get("frame_stats")
+    if stats:
+        light = ""
+        if stats["max_cll"] is not None:
+            light = f", MaxCLL {stats['max_cll']} / MaxFALL {stats['max_fall']} nits"
+        typer.echo(
+            f"  Last frame: APL {stats['apl']:.1f}%, "
+            f"{stats['clipped_pixels']} clipped pixel(s){light}"
+        )
+    typer.echo("  Thread policy (in effect):")
+    for line in describe_daemon_thread_policy(status["thread_policy"]):
+        typer.echo(f"    {line}")
+    typer.echo("  Library memory (current / peak / live blocks):")
+    for name, mem in status["memory"].items():
+        typer.echo(
+            f"    {name:<14} {mem['current_bytes'] / 2**20:8.1f} MiB "
+            f"/ {mem['peak_bytes'] / 2**20:8.1f} MiB / {mem['live']}"
+        )
+
+
+__all__ = ["daemon_app"]
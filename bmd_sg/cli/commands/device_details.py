@@ -5,17 +5,26 @@ This module provides the device details command that shows information
 about all connected DeckLink devices including supported formats and HDR capabilities.
 """
 
+import os
+import platform
+import resource
+import sys
+from pathlib import Path
 from typing import Annotated
 
 import typer
 
 from bmd_sg.cli.shared import (
     create_decklink_device,
+    describe_daemon_thread_policy,
     is_mock_mode_enabled,
     list_available_devices,
     setup_mock_environment,
 )
+from bmd_sg.daemon import connect_daemon
 from bmd_sg.decklink.bmd_decklink import (
+    DecklinkSettings,
+    ThreadSchedPolicy,
     get_decklink_driver_version,
     get_decklink_sdk_version,
 )
@@ -46,7 +55,122 @@ def _print_system_info(use_mock: bool = False) -> None:
     typer.echo()
 
 
-def _print_device_details(idx: int, device_name: str, use_mock: bool = False) -> None:
+def _format_limit(limit: int) -> str:
+    if limit == resource.RLIM_INFINITY:
+        return "unlimited"
+    return f"{limit / 2**20:.1f} MiB"
+
+
+def _realtime_permitted(priority: int) -> bool | None:
+    """Whether real-time scheduling at a priority is allowed; None if unknown."""
+    if sys.platform != "linux":
+        return None
+    if os.geteuid() == 0:
+        return True
+    limit = resource.getrlimit(resource.RLIMIT_RTPRIO)[0]
+    return limit == resource.RLIM_INFINITY or limit >= priority
+
+
+def _describe_requested_thread_policy(settings: DecklinkSettings) -> list[str]:
+    """
+    Describe the requested thread policy and whether this host allows it.
+
+    Nothing is applied: pinning support comes from the platform, real-time
+    permission from the process's rtprio limit and privileges, and memory
+    locking from its memlock limit.
+
+    Parameters
+    ----------
+    settings : DecklinkSettings
+        Global settings holding the threading options
+
+    Returns
+    -------
+    list[str]
+        One line each for output thread, packing workers and memory locking
+    """
+    cores = os.cpu_count() or 1
+    if sys.platform == "linux":
+        pin_kind = "pinned"
+    elif sys.platform == "darwin":
+        pin_kind = (
+            "affinity hint, not honoured on Apple silicon"
+            if platform.machine() == "arm64"
+            else "affinity hint"
+        )
+    else:
+        pin_kind = "not supported"
+
+    output = "unpinned"
+    if settings.output_core >= 0:
+        output = f"core {settings.output_core} ({pin_kind})"
+        if settings.output_core >= cores:
+            output += f", but the host has {cores} core(s)"
+
+    policy = settings.rt_policy.name
+    if settings.rt_policy != ThreadSchedPolicy.OTHER:
+        policy += f" priority {settings.rt_priority}"
+        permitted = _realtime_permitted(settings.rt_priority)
+        if permitted is None:
+            policy += " (permission checked when applied)"
+        elif permitted:
+            policy += " (permitted)"
+        else:
+            policy += " (not permitted without CAP_SYS_NICE; falls back to OTHER)"
+
+    workers = f"{settings.pack_workers}"
+    if settings.pack_workers and settings.pack_core_first >= 0:
+        workers += f" from core {settings.pack_core_first} ({pin_kind})"
+
+    if settings.lock_memory:
+        limit = resource.getrlimit(resource.RLIMIT_MEMLOCK)[0]
+        memory = f"lock requested (memlock limit {_format_limit(limit)})"
+    else:
+        memory = "not locked"
+
+    return [
+        f"Output thread: {output}, {policy}",
+        f"Pack workers: {workers} + caller",
+        f"Frame memory: {memory}",
+    ]
+
+
+def _print_thread_policy(
+    settings: DecklinkSettings, socket_path: Path | str | None
+) -> None:
+    """
+    Print the thread policy in effect on a running daemon's device.
+
+    The policy only takes effect on the thread that starts output, so it is
+    read from a running daemon rather than applied here. Without a daemon the
+    requested policy is printed, marked as not in effect.
+    """
+    client = connect_daemon(socket_path)
+    if client is not None:
+        try:
+            status = client.status()
+        except RuntimeError:
+            status = {}
+        finally:
+            client.close()
+        if "thread_policy" in status:
+            typer.echo("Thread policy (in effect on the daemon's device):")
+            for line in describe_daemon_thread_policy(status["thread_policy"]):
+                typer.echo(f"  {line}")
+            typer.echo()
+            return
+
+    typer.echo("Thread policy (requested; effective policy not reported):")
+    for line in _describe_requested_thread_policy(settings):
+        typer.echo(f"  {line}")
+    typer.echo()
+
+
+def _print_device_details(
+    idx: int,
+    device_name: str,
+    use_mock: bool = False,
+) -> None:
     """Print detailed information for a specific device."""
     typer.echo(f"Device {idx}: {device_name}")
     try:
@@ -114,6 +238,9 @@ def device_details_command(
     - List of connected devices with indices
     - Supported pixel formats for each device (unless list_only)
     - HDR support status for each device (unless list_only)
+    - Thread policy in effect on a running daemon's device; without a
+      daemon, the requested policy for the global threading options and
+      whether this host permits it, never applied here (unless list_only)
 
     Examples
     --------
@@ -166,6 +293,11 @@ def device_details_command(
         # Print SDK and driver version information (unless list_only)
         if not list_only:
             _print_system_info(use_mock=use_mock)
+            options = ctx.obj or {}
+            _print_thread_policy(
+                options.get("device_settings") or DecklinkSettings(),
+                options.get("daemon_socket"),
+            )
 
         # Determine which devices to process
         if device_index is not None:
@@ -16,10 +16,11 @@ from bmd_sg.charts.tiff_reader import load_chart_tiff
 from bmd_sg.cli.shared import (
     display_image_for_duration,
     get_device_settings,
-    initialize_device,
-    is_mock_mode_enabled,
+    open_output,
 )
 from bmd_sg.decklink.bmd_decklink import (
+    PlacementFilter,
+    PlacementFit,
     colorspace_to_gamut_chromaticities,
     transfer_function_to_eotf,
 )
@@ -41,6 +42,18 @@ def display_tiff_command(
             help="Duration in seconds to display the image (0 = indefinitely)",
         ),
     ] = 5.0,
+    fit: Annotated[
+        PlacementFit | None,
+        typer.Option(
+            "--fit",
+            help="Place the image on the display mode's raster while packing "
+            "(default: send it at its own size)",
+        ),
+    ] = None,
+    resample: Annotated[
+        PlacementFilter,
+        typer.Option("--filter", help="Resampling filter used with --fit"),
+    ] = PlacementFilter.BOX,
 ) -> None:
     """
     Display a pre-generated TIFF file on the DeckLink device.
@@ -48,10 +61,13 @@ def display_tiff_command(
     The TIFF pixel values are passed through exactly as stored, without
     any scaling or color conversion. The HDMI/SDI signaling metadata
     (EOTF, color primaries) is configured based on the embedded TIFF metadata.
+    With --fit the library scales and centers the image on the output raster
+    as it packs it, e.g. a 1080p chart on a 4K mode.
 
     Examples:
         bmd-signal-gen display-tiff chart.tif --duration 10
         bmd-signal-gen --device 1 display-tiff pattern.tif
+        bmd-signal-gen display-tiff chart.tif --fit integer
     """
     # Check file exists
     if not tiff_path.exists():
@@ -75,7 +91,6 @@ def display_tiff_command(
 
     # Get device settings and override with TIFF metadata
     settings = get_device_settings(ctx)
-    use_mock = is_mock_mode_enabled(ctx)
 
     # Map TIFF metadata to DeckLink settings
     # This ensures HDMI/SDI signaling matches the TIFF content
@@ -89,7 +104,12 @@ def display_tiff_command(
     console.print(f"  Primaries: {metadata.colorspace}")
 
     console.print("\nInitializing DeckLink device...")
-    decklink = initialize_device(settings, use_mock=use_mock)
+    # Placement is applied by the library while packing, which the daemon
+    # protocol does not carry; --fit opens the device directly
+    decklink = open_output(ctx, settings, use_daemon=fit is None)
+    if fit is not None:
+        decklink.set_placement(fit, resample)
+        console.print(f"  Placement: {fit.value} ({resample.value})")
 
     # Display the image
     console.print(
@@ -0,0 +1,117 @@
+"""
+Temporal dithering (FRC) command for BMD CLI.
+
+This module provides the FRC command, which shows a patch at a fractional
+code value by alternating the two adjacent code values per channel with a
+controlled duty cycle, using the library's scheduled playback.
+"""
+
+import time
+from typing import Annotated
+
+import numpy as np
+import typer
+
+from bmd_sg.cli.shared import get_device_settings, setup_tools_from_context
+from bmd_sg.utilities import suppress_cpp_output
+
+
+def frc_command(
+    ctx: typer.Context,
+    color: Annotated[
+        tuple[float, float, float],
+        typer.Argument(help="Fractional RGB code values (r,g,b), e.g. 512.25"),
+    ] = (512.5, 512.5, 512.5),
+    cycle: Annotated[
+        int,
+        typer.Option(
+            "--cycle",
+            "-c",
+            help="Frames per dither cycle (1-64); sets the fraction resolution",
+        ),
+    ] = 8,
+    duration: Annotated[
+        float,
+        typer.Option(
+            "--duration",
+            "-t",
+            help="Duration in seconds (0 waits for Enter)",
+        ),
+    ] = 5.0,
+) -> None:
+    """
+    Display a temporally dithered patch at a fractional code value.
+
+    Each channel alternates between ``floor(value)`` and the next code value,
+    showing the upper one on ``round(fraction * cycle)`` frames of every
+    cycle, spread evenly. The patch covers the global ROI over a black
+    background. The constituent frames are packed once and played back by
+    the device on its own clock, so the cadence is exact.
+
+    Parameters
+    ----------
+    ctx : typer.Context
+        Typer context containing global device settings
+    color : tuple[float, float, float]
+        Fractional RGB code values at the output bit depth
+    cycle : int
+        Frames per dither cycle
+    duration : float
+        Display duration in seconds
+
+    Raises
+    ------
+    typer.BadParameter
+        If a value is outside the code range of the bit depth
+
+    Examples
+    --------
+    A quarter code value above 10-bit 512 on all channels:
+    >>> bmd-cli --pixel-format r210 frc 512.25 512.25 512.25
+
+    Finer steps with a 32-frame cycle:
+    >>> bmd-cli frc 2048.03125 2048 2048 --cycle 32 -t 30
+
+    See Also
+    --------
+    solid : Display a solid color at integer code values
+    """
+    settings = get_device_settings(ctx)
+    decklink, _ = setup_tools_from_context(ctx, use_daemon=False)
+
+    max_value = 2**decklink.pixel_format.bit_depth - 1
+    if not all(0 <= value <= max_value for value in color):
+        raise typer.BadParameter(
+            f"RGB values must be between 0 and {max_value} for "
+            f"{decklink.pixel_format.bit_depth}-bit"
+        )
+
+    background = np.zeros((settings.height, settings.width, 3), dtype=np.uint16)
+    roi = (settings.roi_x, settings.roi_y, settings.roi_width, settings.roi_height)
+    with suppress_cpp_output():
+        status = decklink.start_frc(
+            color, roi=roi, cycle_frames=cycle, background=background
+        )
+
+    achieved = ", ".join(f"{value:g}" for value in status.achieved)
+    duty = ", ".join(f"{n}/{status.cycleFrames}" for n in status.dutyFrames)
+    typer.echo(f"Dithering to ({achieved}), upper code value on {duty} frames")
+    try:
+        if duration > 0:
+            typer.echo(f"Displaying for {duration} seconds...")
+            time.sleep(duration)
+        else:
+            typer.echo("Displaying indefinitely. Press Enter to stop...")
+            input()
+    finally:
+        playback = decklink.frc_status().playback
+        with suppress_cpp_output():
+            decklink.stop_frc()
+
+    typer.echo(
+        f"Frames shown: {playback.completed}, late: {playback.displayedLate}, "
+        f"dropped: {playback.dropped}"
+    )
+
+
+__all__ = ["frc_command"]
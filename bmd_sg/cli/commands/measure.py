@@ -0,0 +1,128 @@
+"""
+Measurement run command for BMD CLI.
+
+This module provides the measure command, which shows a grey ramp and the
+primaries through the pipelined measurement orchestrator and reports where
+the run's time went. It reads a simulated meter, so the output side of a
+profiling run can be checked and timed without an instrument attached.
+"""
+
+from typing import Annotated
+
+import numpy as np
+import typer
+
+from bmd_sg.cli.shared import setup_tools_from_context
+from bmd_sg.measurement import Measurement, MeasurementOrchestrator, SimulatedMeter
+
+
+def measure_command(
+    ctx: typer.Context,
+    steps: Annotated[
+        int,
+        typer.Option("--steps", "-n", help="Grey ramp steps, black to white"),
+    ] = 11,
+    integration: Annotated[
+        float,
+        typer.Option("--integration", "-i", help="Simulated meter integration (s)"),
+    ] = 0.5,
+    settle: Annotated[
+        float,
+        typer.Option("--settle", "-s", help="Wait after each switch (s)"),
+    ] = 0.1,
+    lookahead: Annotated[
+        int,
+        typer.Option("--lookahead", help="Patches prepared ahead (1-16)"),
+    ] = 1,
+    peak: Annotated[
+        float,
+        typer.Option("--peak", help="Simulated white luminance (cd/m²)"),
+    ] = 100.0,
+) -> None:
+    """
+    Measure a grey ramp and the primaries against a simulated meter.
+
+    Each patch is drawn in the global ROI over black. While the meter reads
+    one patch, the next is rendered and packed into the device's frame
+    cache, and it is shown the moment the reading returns. The summary
+    compares the run time with the time the meter spent integrating.
+
+    Parameters
+    ----------
+    ctx : typer.Context
+        Typer context containing global device settings
+    steps : int
+        Number of grey ramp steps
+    integration : float
+        Seconds each simulated reading takes
+    settle : float
+        Seconds to wait between showing a patch and reading it
+    lookahead : int
+        Patches prepared ahead of the one being read
+    peak : float
+        White luminance of the simulated display
+
+    Raises
+    ------
+    typer.BadParameter
+        If steps is less than 2 or a time is negative
+
+    Examples
+    --------
+    A 21-step ramp with 0.2 s readings:
+    >>> bmd-cli measure --steps 21 --integration 0.2
+
+    See Also
+    --------
+    solid : Display a solid color at integer code values
+    """
+    if steps < 2:
+        raise typer.BadParameter("steps must be at least 2")
+    if integration < 0 or settle < 0:
+        raise typer.BadParameter("times must not be negative")
+    decklink, generator = setup_tools_from_context(ctx, use_daemon=False)
+
+    bit_depth = decklink.pixel_format.bit_depth
+    max_value = 2**bit_depth - 1
+    ramp = [round(max_value * i / (steps - 1)) for i in range(steps)]
+    patches = [(v, v, v) for v in ramp] + [
+        (max_value, 0, 0),
+        (0, max_value, 0),
+        (0, 0, max_value),
+    ]
+    meter = SimulatedMeter(
+        integration_s=integration, bit_depth=bit_depth, peak_luminance=peak
+    )
+
+    def render(patch: tuple[int, int, int]) -> np.ndarray:
+        return generator.generate([patch])
+
+    def report(measurement: Measurement) -> None:
+        luminance = measurement.reading.XYZ[1]
+        x, y = measurement.reading.xy
+        typer.echo(
+            f"{measurement.index + 1:3d}/{len(patches)} "
+            f"RGB {measurement.patch!s:<20} Y {luminance:9.3f} cd/m²  "
+            f"x {x:.4f} y {y:.4f}"
+        )
+
+    orchestrator = MeasurementOrchestrator(
+        decklink, meter, settle_s=settle, lookahead=lookahead
+    )
+    run = orchestrator.run(patches, render, on_measurement=report)
+
+    timings = [m.timing for m in run.measurements]
+    typer.echo(
+        f"{len(timings)} patches in {run.total_s:.2f} s: "
+        f"{run.measure_s:.2f} s reading, {run.settle_s:.2f} s settling, "
+        f"{run.overhead_s:.2f} s overhead "
+        f"({run.efficiency:.1%} of the run spent reading)"
+    )
+    typer.echo(
+        f"Per patch: prepare {np.mean([t.prepare for t in timings]) * 1e3:.1f} ms "
+        f"(overlapped), wait {np.mean([t.wait for t in timings]) * 1e3:.1f} ms, "
+        f"switch {np.mean([t.switch for t in timings]) * 1e3:.1f} ms"
+    )
+
+
+__all__ = ["measure_command"]
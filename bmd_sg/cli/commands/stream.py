@@ -0,0 +1,127 @@
+"""
+Raw frame stream command for BMD CLI.
+
+This module provides the stream command, which displays fixed-size raw
+frames read by the C++ library from stdin, a FIFO or a file, so external
+renderers can drive the output without Python in the data path.
+"""
+
+import os
+import sys
+import time
+from pathlib import Path
+from typing import Annotated
+
+import typer
+
+from bmd_sg.cli.shared import get_device_settings, setup_tools_from_context
+from bmd_sg.utilities import suppress_cpp_output
+
+
+def stream_command(
+    ctx: typer.Context,
+    source: Annotated[
+        str,
+        typer.Argument(help="File or FIFO to read frames from, '-' for stdin"),
+    ] = "-",
+    packed: Annotated[
+        bool,
+        typer.Option(
+            "--packed",
+            help="Frames are already packed in the output pixel format",
+        ),
+    ] = False,
+    readahead: Annotated[
+        int,
+        typer.Option("--readahead", help="Frames read ahead of the display (1-16)"),
+    ] = 4,
+    loop: Annotated[
+        bool,
+        typer.Option("--loop", help="Restart a regular file at its end"),
+    ] = False,
+    frames: Annotated[
+        int,
+        typer.Option("--frames", "-n", help="Stop after this many frames (0 = all)"),
+    ] = 0,
+) -> None:
+    """
+    Display raw frames streamed from stdin, a FIFO or a file.
+
+    Frames are ``--width`` x ``--height`` interleaved RGB with one native-
+    endian uint16 per channel (RGB48), or with ``--packed`` already in the
+    output pixel format at the device's row bytes. The library reads them
+    with readahead into pooled frame buffers and shows one per frame of the
+    display mode, so a faster producer is held back by the pipe. The command
+    returns at end of input or on Ctrl-C and prints the stream counters.
+
+    Parameters
+    ----------
+    ctx : typer.Context
+        Typer context containing global device settings
+    source : str
+        Path of a file or FIFO, or ``-`` for stdin
+    packed : bool
+        Frames are pre-packed
+    readahead : int
+        Frames read ahead of the display
+    loop : bool
+        Rewind a regular file at its end
+    frames : int
+        Frame limit, 0 for the whole input
+
+    Examples
+    --------
+    Stream a renderer's RGB48 output:
+    >>> my-renderer --raw | bmd-cli --width 1920 --height 1080 stream
+
+    Loop a raw clip from a file:
+    >>> bmd-cli stream clip.rgb48 --loop
+
+    See Also
+    --------
+    frame-timing : Measure output timing for generated frames
+    """
+    settings = get_device_settings(ctx)
+    decklink, _ = setup_tools_from_context(ctx, use_daemon=False)
+
+    fd = sys.stdin.fileno() if source == "-" else os.open(Path(source), os.O_RDONLY)
+    try:
+        with suppress_cpp_output():
+            stats = decklink.start_stream(
+                fd,
+                settings.width,
+                settings.height,
+                packed=packed,
+                readahead=readahead,
+                loop=loop,
+                max_frames=frames,
+            )
+        typer.echo(
+            f"Streaming {settings.width}x{settings.height} "
+            f"{'packed' if packed else 'RGB48'} frames of {stats.frameBytes} bytes "
+            f"from {'stdin' if source == '-' else source}"
+        )
+        try:
+            while decklink.stream_stats().running:
+                time.sleep(0.1)
+        except KeyboardInterrupt:
+            pass
+        stats = decklink.stream_stats()
+        with suppress_cpp_output():
+            decklink.stop_stream()
+    finally:
+        if source != "-":
+            os.close(fd)
+
+    typer.echo(
+        f"Frames displayed: {stats.framesDisplayed}, underruns: {stats.underruns}, "
+        f"mean read {stats.meanReadNs / 1e6:.2f} ms"
+    )
+    if stats.endOfInput == 2:
+        typer.echo("Warning: input ended inside a frame")
+    if stats.lastError:
+        typer.echo(f"Stream stopped on error {stats.lastError}", err=True)
+        raise typer.Exit(code=1)
+
+
+__all__ = ["stream_command"]
@@ -6,23 +6,31 @@ This module provides the main CLI application with a top-level callback
 for global device and HDR parameters, and pattern-specific subcommands.
 """
 
+from pathlib import Path
 from typing import Annotated
 
 import typer
 
+from bmd_sg.cli.commands.api_replay import api_replay_command
 from bmd_sg.cli.commands.api_server import api_server_command
 from bmd_sg.cli.commands.checkerboard_commands import (
     checkerboard2_command,
     checkerboard3_command,
     checkerboard4_command,
 )
+from bmd_sg.cli.commands.daemon import daemon_app
 from bmd_sg.cli.commands.device_details import device_details_command
+from bmd_sg.cli.commands.frame_timing import frame_timing_command
+from bmd_sg.cli.commands.frc import frc_command
+from bmd_sg.cli.commands.measure import measure_command
 from bmd_sg.cli.commands.solid import solid_command
+from bmd_sg.cli.commands.stream import stream_command
 from bmd_sg.decklink.bmd_decklink import (
     DecklinkSettings,
     EOTFType,
     GamutChromaticities,
     PixelFormatType,
+    ThreadSchedPolicy,
 )
 
 app = typer.Typer(
@@ -61,6 +69,23 @@ def main(
             rich_help_panel="Device / Pixel Format",
         ),
     ] = None,
+    auto_pixel_format: Annotated[
+        bool,
+        typer.Option(
+            "--auto-pixel-format",
+            help="Pick the cheapest-to-pack supported format (benchmarked once per host) "
+            "when --pixel-format is not given",
+            rich_help_panel="Device / Pixel Format",
+        ),
+    ] = False,
+    min_bit_depth: Annotated[
+        int,
+        typer.Option(
+            "--min-bit-depth",
+            help="Minimum bit depth --auto-pixel-format must preserve",
+            rich_help_panel="Device / Pixel Format",
+        ),
+    ] = 10,
     width: Annotated[
         int,
         typer.Option(
@@ -73,6 +98,74 @@ def main(
             "--height", help="Image height", rich_help_panel="Device / Pixel Format"
         ),
     ] = 1080,
+    # Threading / Real-time
+    output_core: Annotated[
+        int,
+        typer.Option(
+            "--output-core",
+            help="Pin the output thread to this CPU core (-1 = unpinned)",
+            rich_help_panel="Threading / Real-time",
+        ),
+    ] = -1,
+    rt_policy: Annotated[
+        ThreadSchedPolicy,
+        typer.Option(
+            "--rt-policy",
+            help="Output thread scheduling policy; falls back to OTHER if not "
+            "permitted",
+            rich_help_panel="Threading / Real-time",
+        ),
+    ] = ThreadSchedPolicy.OTHER,
+    rt_priority: Annotated[
+        int,
+        typer.Option(
+            "--rt-priority",
+            help="Real-time priority for FIFO/RR",
+            rich_help_panel="Threading / Real-time",
+        ),
+    ] = 50,
+    pack_workers: Annotated[
+        int,
+        typer.Option(
+            "--pack-workers",
+            help="Extra threads used to pack each frame",
+            rich_help_panel="Threading / Real-time",
+        ),
+    ] = 0,
+    pack_core_first: Annotated[
+        int,
+        typer.Option(
+            "--pack-core-first",
+            help="Pin pack worker i to core N+i (-1 = unpinned)",
+            rich_help_panel="Threading / Real-time",
+        ),
+    ] = -1,
+    mlock: Annotated[
+        bool,
+        typer.Option(
+            "--mlock",
+            help="Lock frame buffers in RAM to avoid page faults",
+            rich_help_panel="Threading / Real-time",
+        ),
+    ] = False,
+    # Daemon
+    no_daemon: Annotated[
+        bool,
+        typer.Option(
+            "--no-daemon",
+            help="Open the device directly even if a device daemon is running",
+            rich_help_panel="Daemon",
+        ),
+    ] = False,
+    daemon_socket: Annotated[
+        Path | None,
+        typer.Option(
+            "--daemon-socket",
+            help="Device daemon socket (default: $BMD_SG_SOCKET or a per-user "
+            "runtime path)",
+            rich_help_panel="Daemon",
+        ),
+    ] = None,
     # ROI
     roi_x: Annotated[
         int, typer.Option("--roi-x", help="ROI X offset", rich_help_panel="ROI")
@@ -125,6 +218,14 @@ def main(
             rich_help_panel="HDR Metadata",
         ),
     ] = 80.0,
+    auto_cll: Annotated[
+        bool,
+        typer.Option(
+            "--auto-cll",
+            help="Set MaxCLL/MaxFALL from each frame's content (PQ only)",
+            rich_help_panel="HDR Metadata",
+        ),
+    ] = False,
     red_primary: Annotated[
         tuple[float, float],
         typer.Option(
@@ -186,8 +287,17 @@ def main(
         # Device params
         device=device,
         pixel_format=pixel_format,
+        auto_pixel_format=auto_pixel_format,
+        min_bit_depth=min_bit_depth,
         width=width,
         height=height,
+        # Threading params
+        output_core=output_core,
+        rt_policy=rt_policy,
+        rt_priority=rt_priority,
+        pack_workers=pack_workers,
+        pack_core_first=pack_core_first,
+        lock_memory=mlock,
         # ROI params
         roi_x=roi_x,
         roi_y=roi_y,
@@ -197,6 +307,7 @@ def main(
         eotf=eotf,
         max_cll=max_cll,
         max_fall=max_fall,
+        auto_cll=auto_cll,
         max_display_mastering_luminance=max_display_mastering_luminance,
         min_display_mastering_luminance=min_display_mastering_luminance,
         gamut_chromaticities=gamut_chromaticities,
@@ -206,6 +317,10 @@ def main(
     # Store mock device flag for CLI commands
     ctx.obj["mock_device"] = mock_device
 
+    # Device daemon routing
+    ctx.obj["use_daemon"] = not no_daemon
+    ctx.obj["daemon_socket"] = daemon_socket
+
 
 from bmd_sg.cli.commands.display_tiff import display_tiff_command
 from bmd_sg.cli.commands.gen_chart import gen_chart_command
@@ -215,9 +330,15 @@ app.command(name="pat2")(checkerboard2_command)
 app.command(name="pat3")(checkerboard3_command)
 app.command(name="pat4")(checkerboard4_command)
 app.command(name="device-details")(device_details_command)
+app.command(name="frame-timing")(frame_timing_command)
+app.command(name="frc")(frc_command)
+app.command(name="stream")(stream_command)
+app.command(name="measure")(measure_command)
 app.command(name="api-server")(api_server_command)
+app.command(name="api-replay")(api_replay_command)
 app.command(name="gen-chart")(gen_chart_command)
 app.command(name="display-tiff")(display_tiff_command)
+app.add_typer(daemon_app, name="daemon")
 
 
 __all__ = ["app", "main"]
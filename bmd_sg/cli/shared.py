@@ -12,15 +12,19 @@ import numpy as np
 import typer
 from numpy.typing import ArrayLike
 
+from bmd_sg.daemon.client import connect_daemon
 from bmd_sg.decklink.bmd_decklink import (
     BMDDeckLink,
     DecklinkSettings,
     HDRMetadata,
     PixelFormatType,
+    ThreadPolicyStatus,
+    ThreadSchedPolicy,
     get_decklink_devices,
     get_decklink_driver_version,
     get_decklink_sdk_version,
 )
+from bmd_sg.decklink.format_selection import select_pixel_format
 from bmd_sg.image_generators.checkerboard import ROI, PatternGenerator
 
 # Optional mock imports for --mock-device support
@@ -222,6 +226,9 @@ def configure_pixel_format(  # noqa: C901
     decklink: BMDDeckLink,
     pixel_format: PixelFormatType | None = None,
     show_logs: bool = True,
+    auto_select: bool = False,
+    min_bit_depth: int = 10,
+    device_name: str = "",
 ) -> None:
     """
     Configure pixel format for the DeckLink device.
@@ -234,6 +241,14 @@ def configure_pixel_format(  # noqa: C901
         Specific pixel format to use. If None, auto-selects best format.
     show_logs : bool, optional
         Whether to print format selection information. Default is True.
+    auto_select : bool, optional
+        When no pixel_format is given, pick the cheapest-to-pack supported
+        format that keeps ``min_bit_depth`` bits instead of using the static
+        preference list. Default is False.
+    min_bit_depth : int, optional
+        Minimum bit depth for cost-model selection. Default is 10.
+    device_name : str, optional
+        Device name used to key the per-host pack cost cache.
 
     Raises
     ------
@@ -244,8 +259,20 @@ def configure_pixel_format(  # noqa: C901
     --------
     >>> configure_pixel_format(device)
     >>> configure_pixel_format(device, PixelFormatType.FORMAT_12BIT_RGBLE)
+    >>> configure_pixel_format(device, auto_select=True, min_bit_depth=12)
     """
     try:
+        if auto_select and pixel_format is None:
+            choice = select_pixel_format(decklink, device_name, min_bit_depth)
+            if show_logs:
+                print(
+                    f"\nCost-model selected pixel format: {choice.pixel_format.name} "
+                    f"({choice.ms_per_frame:.2f} ms/frame to pack, "
+                    f"{min_bit_depth}-bit minimum)"
+                )
+            decklink.pixel_format = choice.pixel_format
+            return
+
         all_formats = decklink.get_supported_pixel_formats()
 
         # Filter out 8-bit and RGBX formats
@@ -339,12 +366,120 @@ def configure_hdr_metadata(decklink: BMDDeckLink, settings: DecklinkSettings) ->
         print(
             f"Set complete HDR metadata: EOTF={settings.eotf}, MaxCLL={settings.max_cll}, MaxFALL={settings.max_fall}"
         )
+        if settings.auto_cll:
+            # MaxCLL/MaxFALL follow each frame's statistics from here on
+            decklink.set_frame_stats(auto_hdr_metadata=True)
+            print("MaxCLL/MaxFALL will be set from each frame's content")
     else:
         print(
             f"HDR metadata disabled. EOTF={settings.eotf}, MaxCLL={settings.max_cll}, MaxFALL={settings.max_fall}"
         )
 
 
+def configure_thread_policy(
+    decklink: BMDDeckLink, settings: DecklinkSettings, show_logs: bool = True
+) -> ThreadPolicyStatus:
+    """
+    Apply thread placement and real-time scheduling from global settings.
+
+    The calling thread becomes the output thread, so this must run on the
+    thread that will display frames.
+
+    Parameters
+    ----------
+    decklink : BMDDeckLink
+        DeckLink device instance
+    settings : DecklinkSettings
+        Global device settings containing the thread policy
+    show_logs : bool, optional
+        Whether to print the effective policy. Default is True.
+
+    Returns
+    -------
+    ThreadPolicyStatus
+        Policy actually in effect after any fallback
+    """
+    decklink.set_thread_policy(
+        output_core=settings.output_core,
+        sched_policy=settings.rt_policy,
+        sched_priority=settings.rt_priority,
+        pack_workers=settings.pack_workers,
+        pack_core_first=settings.pack_core_first,
+        lock_memory=settings.lock_memory,
+    )
+    decklink.apply_output_thread_policy()
+    status = decklink.thread_policy_status
+    if show_logs:
+        print("\nThread policy:")
+        for line in describe_thread_policy(status, settings.lock_memory):
+            print(f"  {line}")
+    return status
+
+
+def describe_thread_policy(
+    status: ThreadPolicyStatus, lock_requested: bool = False
+) -> list[str]:
+    """
+    Format an effective thread policy for display.
+
+    Parameters
+    ----------
+    status : ThreadPolicyStatus
+        Policy reported by the device
+    lock_requested : bool, optional
+        Whether ``mlock`` was requested, to distinguish "off" from "pending".
+
+    Returns
+    -------
+    list[str]
+        One line each for output thread, packing workers and memory locking
+    """
+    pin_states = {0: "unpinned", 1: "pinned", 2: "affinity hint", -1: "pin refused"}
+    output = pin_states.get(status.outputPinned, "unknown")
+    if status.outputPinned != 0:
+        output += f" (core {status.outputCore})"
+
+    policy = list(ThreadSchedPolicy)[status.schedPolicy].name
+    if status.schedPolicy != 0:
+        policy += f" priority {status.schedPriority}"
+    if status.schedFallback:
+        policy += " (real-time refused, fell back)"
+
+    if status.memoryLocked:
+        memory = f"locked ({status.lockedBytes / 2**20:.1f} MiB)"
+    elif lock_requested:
+        memory = "lock requested (applied when frames are allocated)"
+    else:
+        memory = "not locked"
+
+    return [
+        f"Output thread: {output}, {policy}",
+        f"Pack workers: {status.packWorkers} "
+        f"({status.packWorkersPinned} pinned) + caller",
+        f"Frame memory: {memory}",
+    ]
+
+
+def describe_daemon_thread_policy(policy: dict[str, Any]) -> list[str]:
+    """
+    Format the thread policy a daemon reports in its status.
+
+    Parameters
+    ----------
+    policy : dict[str, Any]
+        ``thread_policy`` of a daemon status: the ``ThreadPolicyStatus``
+        fields plus ``lockRequested``
+
+    Returns
+    -------
+    list[str]
+        One line each for output thread, packing workers and memory locking
+    """
+    fields = {name for name, _ in ThreadPolicyStatus._fields_}
+    status = ThreadPolicyStatus(**{k: v for k, v in policy.items() if k in fields})
+    return describe_thread_policy(status, bool(policy.get("lockRequested")))
+
+
 def initialize_device(settings: DecklinkSettings, use_mock: bool = False) -> Any:
     """
     Complete device initialization with configuration.
@@ -354,7 +489,8 @@ def initialize_device(settings: DecklinkSettings, use_mock: bool = False) -> Any
     2. Create device instance
     3. Configure pixel format
     4. Configure HDR metadata
-    5. Start playback
+    5. Apply thread policy
+    6. Start playback
 
     Parameters
     ----------
@@ -391,12 +527,22 @@ def initialize_device(settings: DecklinkSettings, use_mock: bool = False) -> Any
         decklink = create_decklink_device(settings.device, use_mock=use_mock)
 
         # 3. Configure pixel format
-        configure_pixel_format(decklink, settings.pixel_format, show_logs=True)
+        configure_pixel_format(
+            decklink,
+            settings.pixel_format,
+            show_logs=True,
+            auto_select=settings.auto_pixel_format,
+            min_bit_depth=settings.min_bit_depth,
+            device_name=devices[settings.device],
+        )
 
         # 4. Configure HDR metadata
         configure_hdr_metadata(decklink, settings)
 
-        # 5. Start playback
+        # 5. Apply thread policy (this thread drives output)
+        configure_thread_policy(decklink, settings)
+
+        # 6. Start playback
         decklink.start_playback()
 
         return decklink
@@ -580,19 +726,62 @@ def display_image_for_duration(
         input()  # Wait for user to press Enter
 
 
+def open_output(
+    ctx: typer.Context, settings: DecklinkSettings, use_daemon: bool = True
+) -> Any:
+    """
+    Get a configured output, via the device daemon when one is running.
+
+    If a daemon is listening (and ``--no-daemon`` was not given), its output
+    is brought to ``settings`` in place and a proxy is returned; otherwise
+    the device is opened and initialised in this process.
+
+    Parameters
+    ----------
+    ctx : typer.Context
+        Typer context containing the daemon options from the CLI callback
+    settings : DecklinkSettings
+        Device settings to apply
+    use_daemon : bool, optional
+        Allow routing through the daemon. Commands that need the full device
+        API pass False. Default is True.
+
+    Returns
+    -------
+    BMDDeckLink | MockBMDDeckLink | DaemonDevice
+        Output ready for ``display_frame``
+    """
+    obj = ctx.obj or {}
+    if use_daemon and obj.get("use_daemon", True):
+        client = connect_daemon(obj.get("daemon_socket"))
+        if client is not None:
+            device = client.configure(settings)
+            changed = ", ".join(device.changed) or "nothing"
+            print(
+                f"Using device daemon at {client.socket_path} "
+                f"({device.device_name}, {device.pixel_format.name}; "
+                f"reconfigured: {changed})"
+            )
+            return device
+    return initialize_device(settings, use_mock=is_mock_mode_enabled(ctx))
+
+
 def setup_tools_from_context(
-    ctx: typer.Context,
+    ctx: typer.Context, use_daemon: bool = True
 ) -> tuple[Any, PatternGenerator]:
     """
     Setup DeckLink device and pattern generator from typer context.
 
     This is the main entry point for all pattern commands. It handles
-    the complete device initialization and pattern generator setup.
+    the complete device initialization and pattern generator setup, or
+    reuses the device daemon's output when one is running.
 
     Parameters
     ----------
     ctx : typer.Context
         Typer context containing device settings from CLI callback
+    use_daemon : bool, optional
+        Route through a running device daemon. Default is True.
 
     Returns
     -------
@@ -619,8 +808,7 @@ def setup_tools_from_context(
     from the device's pixel format.
     """
     settings = get_device_settings(ctx)
-    use_mock = is_mock_mode_enabled(ctx)
-    decklink = initialize_device(settings, use_mock=use_mock)
+    decklink = open_output(ctx, settings, use_daemon=use_daemon)
     generator = create_pattern_generator(decklink, settings)
     return decklink, generator
 
@@ -635,6 +823,7 @@ __all__ = [
     "initialize_device",
     "is_mock_mode_enabled",
     "list_available_devices",
+    "open_output",
     "setup_mock_environment",
     "setup_tools_from_context",
     "validate_color",
@@ -0,0 +1,21 @@
+"""
+Persistent device daemon for BMD Signal Generator.
+
+The daemon owns one DeckLink output: it opens and configures the device once,
+keeps output enabled (holding the last frame) and accepts commands over a
+local Unix socket. Pattern commands route through a running daemon instead of
+opening the device themselves, so a scripted run pays the device setup cost
+once rather than on every CLI invocation.
+"""
+
+from bmd_sg.daemon.client import DaemonClient, DaemonDevice, connect_daemon
+from bmd_sg.daemon.protocol import default_socket_path
+from bmd_sg.daemon.server import DeviceDaemon
+
+__all__ = [
+    "DaemonClient",
+    "DaemonDevice",
+    "DeviceDaemon",
+    "connect_daemon",
+    "default_socket_path",
+]
@@ -0,0 +1,242 @@
+"""
+Device daemon client.
+
+``DaemonDevice`` stands in for ``BMDDeckLink`` in pattern commands: it
+exposes the pixel format and ``display_frame``, forwarding frames to the
+daemon, and leaves the output running when the command exits. The daemon
+serves one connection at a time, so the device disconnects once a frame is
+shown and reconnects for the next; a command holding a pattern on screen
+does not lock other clients out.
+"""
+
+import contextlib
+import socket
+from pathlib import Path
+from typing import Any
+
+import numpy as np
+
+from bmd_sg.daemon.protocol import (
+    default_socket_path,
+    recv_message,
+    send_message,
+    settings_to_wire,
+)
+from bmd_sg.decklink.bmd_decklink import DecklinkSettings, PixelFormatType
+
+#: Seconds to wait for the daemon to answer a request
+RESPONSE_TIMEOUT_S = 30.0
+
+
+class DaemonClient:
+    """
+    Connection to a running device daemon.
+
+    Parameters
+    ----------
+    sock : socket.socket
+        Connected Unix socket, with its response timeout set
+    socket_path : Path
+        Path the socket was connected to
+    """
+
+    def __init__(self, sock: socket.socket, socket_path: Path) -> None:
+        self._sock: socket.socket | None = sock
+        self.socket_path = socket_path
+        self._timeout = sock.gettimeout()
+
+    def _connection(self) -> socket.socket:
+        if self._sock is None:
+            sock = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+            sock.settimeout(self._timeout)
+            try:
+                sock.connect(str(self.socket_path))
+            except OSError as e:
+                sock.close()
+                raise RuntimeError(f"Cannot reconnect to device daemon: {e!s}") from e
+            self._sock = sock
+        return self._sock
+
+    def request(
+        self, op: str, payload: bytes | memoryview = b"", **fields: Any
+    ) -> dict[str, Any]:
+        """
+        Send one request and wait for its response.
+
+        Parameters
+        ----------
+        op : str
+            Operation: ``configure``, ``display``, ``status`` or ``stop``
+        payload : bytes | memoryview, optional
+            Binary payload (frame data). Default is empty.
+        **fields : Any
+            Additional JSON request fields
+
+        Returns
+        -------
+        dict[str, Any]
+            Response fields
+
+        Raises
+        ------
+        RuntimeError
+            If the daemon reports an error, does not answer within the
+            response timeout or the connection drops
+        """
+        sock = self._connection()
+        try:
+            send_message(sock, {"op": op, **fields}, payload)
+            message = recv_message(sock)
+        except OSError as e:
+            # The connection may be mid-message; never reuse it
+            self.close()
+            raise RuntimeError(f"Lost connection to device daemon: {e!s}") from e
+        if message is None:
+            self.close()
+            raise RuntimeError("Device daemon closed the connection")
+        response, _ = message
+        if not response.get("ok"):
+            raise RuntimeError(f"Device daemon: {response.get('error', 'failed')}")
+        return response
+
+    def status(self) -> dict[str, Any]:
+        """Daemon and device status."""
+        return self.request("status")
+
+    def stop(self) -> None:
+        """Ask the daemon to release the device and exit."""
+        self.request("stop")
+
+    def configure(self, settings: DecklinkSettings) -> "DaemonDevice":
+        """
+        Bring the daemon's output to the given settings.
+
+        Only pixel format and HDR differences are applied, in place; a
+        request for a different device index is rejected.
+
+        Parameters
+        ----------
+        settings : DecklinkSettings
+            Global CLI settings
+
+        Returns
+        -------
+        DaemonDevice
+            Device proxy for pattern commands
+        """
+        return DaemonDevice(
+            self, self.request("configure", config=settings_to_wire(settings))
+        )
+
+    def close(self) -> None:
+        """
+        Close the connection; the daemon keeps running.
+
+        The next request opens a new connection.
+        """
+        if self._sock is not None:
+            with contextlib.suppress(OSError):
+                self._sock.close()
+            self._sock = None
+
+
+def connect_daemon(
+    socket_path: Path | str | None = None,
+    timeout: float = 2.0,
+    response_timeout: float = RESPONSE_TIMEOUT_S,
+) -> DaemonClient | None:
+    """
+    Connect to a running device daemon, if there is one.
+
+    Parameters
+    ----------
+    socket_path : Path | str | None, optional
+        Daemon socket. Default is ``default_socket_path()``.
+    timeout : float, optional
+        Connection timeout in seconds. Default is 2.0.
+    response_timeout : float, optional
+        Seconds to wait for each response. Default is ``RESPONSE_TIMEOUT_S``.
+
+    Returns
+    -------
+    DaemonClient | None
+        Connected client, or None if no daemon is listening
+    """
+    path = Path(socket_path) if socket_path else default_socket_path()
+    if not path.exists():
+        return None
+    sock = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+    sock.settimeout(timeout)
+    try:
+        sock.connect(str(path))
+    except OSError:
+        sock.close()
+        return None
+    # Frames can take a while to pack on the daemon side
+    sock.settimeout(response_timeout)
+    return DaemonClient(sock, path)
+
+
+class DaemonDevice:
+    """
+    Pattern command view of the daemon's output.
+
+    Provides the subset of ``BMDDeckLink`` that pattern commands use.
+
+    Parameters
+    ----------
+    client : DaemonClient
+        Connected daemon client
+    info : dict[str, Any]
+        ``configure`` response describing the output
+    """
+
+    def __init__(self, client: DaemonClient, info: dict[str, Any]) -> None:
+        self._client: DaemonClient | None = client
+        self.device_name: str = info["device_name"]
+        self.changed: list[str] = info.get("changed", [])
+        self._pixel_format = PixelFormatType[info["pixel_format"]]
+
+    @property
+    def handle(self) -> bool:
+        """Truthy while connected, like ``BMDDeckLink.handle``."""
+        return self._client is not None
+
+    @property
+    def pixel_format(self) -> PixelFormatType:
+        """Pixel format of the daemon's output."""
+        return self._pixel_format
+
+    def display_frame(self, frame_data: np.ndarray) -> None:
+        """
+        Send a frame to the daemon, which displays and then holds it.
+
+        The connection is released once the daemon has shown the frame, so
+        other clients are served while this one keeps the pattern up.
+
+        Parameters
+        ----------
+        frame_data : numpy.ndarray
+            Frame data with shape (height, width, channels)
+
+        Raises
+        ------
+        RuntimeError
+            If the daemon fails to display the frame
+        """
+        if self._client is None:
+            raise RuntimeError("Device not open")
+        frame = np.ascontiguousarray(frame_data, dtype=np.uint16)
+        self._client.request(
+            "display", memoryview(frame).cast("B"), shape=list(frame.shape)
+        )
+        self._client.close()
+
+    def close(self) -> None:
+        """Disconnect; the daemon keeps the output running."""
+        if self._client is not None:
+            self._client.close()
+            self._client = None
+
+
+__all__ = ["RESPONSE_TIMEOUT_S", "DaemonClient", "DaemonDevice", "connect_daemon"]
@@ -0,0 +1,189 @@
+"""
+Wire protocol shared by the device daemon and its clients.
+
+Each message is an 8-byte header (JSON length, payload length; network byte
+order), a UTF-8 JSON object and an optional binary payload. Requests carry an
+``op`` field; responses carry ``ok`` and either results or ``error``. Frames
+travel as raw uint16 payloads so no encoding cost is paid per frame.
+"""
+
+import json
+import os
+import socket
+import struct
+import tempfile
+from pathlib import Path
+from typing import Any
+
+from bmd_sg.decklink.bmd_decklink import (
+    DecklinkSettings,
+    EOTFType,
+    GamutChromaticities,
+    HDRMetadata,
+)
+
+_HEADER = struct.Struct("!II")
+
+#: Environment variable overriding the default socket path
+SOCKET_ENV_VAR = "BMD_SG_SOCKET"
+
+
+def default_socket_path() -> Path:
+    """
+    Socket path used when none is given.
+
+    Returns
+    -------
+    Path
+        ``$BMD_SG_SOCKET`` if set, else ``bmd-signal-gen.sock`` in
+        ``$XDG_RUNTIME_DIR``, else a per-user file in the temp directory
+    """
+    if env := os.environ.get(SOCKET_ENV_VAR):
+        return Path(env)
+    if runtime_dir := os.environ.get("XDG_RUNTIME_DIR"):
+        return Path(runtime_dir) / "bmd-signal-gen.sock"
+    return Path(tempfile.gettempdir()) / f"bmd-signal-gen-{os.getuid()}.sock"
+
+
+def _recv_exact(sock: socket.socket, size: int) -> bytearray:
+    buffer = bytearray(size)
+    view = memoryview(buffer)
+    received = 0
+    while received < size:
+        count = sock.recv_into(view[received:])
+        if count == 0:
+            raise ConnectionError("Connection closed mid-message")
+        received += count
+    return buffer
+
+
+def send_message(
+    sock: socket.socket, header: dict[str, Any], payload: bytes | memoryview = b""
+) -> None:
+    """
+    Send one message.
+
+    Parameters
+    ----------
+    sock : socket.socket
+        Connected socket
+    header : dict[str, Any]
+        JSON-serialisable message fields
+    payload : bytes | memoryview, optional
+        Binary payload sent after the header. Default is empty.
+    """
+    encoded = json.dumps(header).encode()
+    sock.sendall(_HEADER.pack(len(encoded), len(payload)) + encoded)
+    if len(payload):
+        sock.sendall(payload)
+
+
+def recv_message(sock: socket.socket) -> tuple[dict[str, Any], bytearray] | None:
+    """
+    Receive one message.
+
+    Parameters
+    ----------
+    sock : socket.socket
+        Connected socket
+
+    Returns
+    -------
+    tuple[dict[str, Any], bytearray] | None
+        Message fields and payload, or None if the peer closed the connection
+        cleanly between messages
+
+    Raises
+    ------
+    ConnectionError
+        If the connection closes part-way through a message
+    """
+    first = sock.recv(_HEADER.size)
+    if not first:
+        return None
+    prefix = bytes(first)
+    if len(prefix) < _HEADER.size:
+        prefix += _recv_exact(sock, _HEADER.size - len(prefix))
+    header_size, payload_size = _HEADER.unpack(prefix)
+    header = json.loads(_recv_exact(sock, header_size))
+    payload = _recv_exact(sock, payload_size) if payload_size else bytearray()
+    return header, payload
+
+
+def settings_to_wire(settings: DecklinkSettings) -> dict[str, Any]:
+    """
+    Extract the output configuration part of the CLI settings.
+
+    Resolution and ROI only affect pattern generation, which stays in the
+    client, so they are not sent.
+
+    Parameters
+    ----------
+    settings : DecklinkSettings
+        Global CLI settings
+
+    Returns
+    -------
+    dict[str, Any]
+        JSON-serialisable device, pixel format and HDR configuration
+    """
+    gamut = settings.gamut_chromaticities
+    return {
+        "device": settings.device,
+        "pixel_format": settings.pixel_format.name if settings.pixel_format else None,
+        "no_hdr": settings.no_hdr,
+        "eotf": settings.eotf.name,
+        "max_cll": settings.max_cll,
+        "max_fall": settings.max_fall,
+        "auto_cll": settings.auto_cll,
+        "max_display_mastering_luminance": settings.max_display_mastering_luminance,
+        "min_display_mastering_luminance": settings.min_display_mastering_luminance,
+        "primaries": [
+            [gamut.RedX, gamut.RedY],
+            [gamut.GreenX, gamut.GreenY],
+            [gamut.BlueX, gamut.BlueY],
+            [gamut.WhiteX, gamut.WhiteY],
+        ],
+    }
+
+
+def hdr_metadata_from_wire(config: dict[str, Any]) -> HDRMetadata:
+    """
+    Build the HDR metadata a client configuration asks for.
+
+    With ``no_hdr`` the metadata signals SDR, matching a freshly opened
+    device on which no HDR metadata was ever set.
+
+    Parameters
+    ----------
+    config : dict[str, Any]
+        Output configuration from ``settings_to_wire``
+
+    Returns
+    -------
+    HDRMetadata
+        Metadata to apply
+    """
+    eotf = EOTFType.SDR if config["no_hdr"] else EOTFType[config["eotf"]]
+    metadata = HDRMetadata(
+        eotf=eotf,
+        max_display_luminance=config["max_display_mastering_luminance"],
+        min_display_luminance=config["min_display_mastering_luminance"],
+        max_cll=config["max_cll"],
+        max_fall=config["max_fall"],
+    )
+    red, green, blue, white = (tuple(xy) for xy in config["primaries"])
+    metadata.referencePrimaries = GamutChromaticities(
+        red_xy=red, green_xy=green, blue_xy=blue, white_xy=white
+    )
+    return metadata
+
+
+__all__ = [
+    "SOCKET_ENV_VAR",
+    "default_socket_path",
+    "hdr_metadata_from_wire",
+    "recv_message",
+    "send_message",
+    "settings_to_wire",
+]
@@ -0,0 +1,307 @@
+"""
+Device daemon server.
+
+``DeviceDaemon`` initialises the device exactly as a pattern command would,
+then serves requests on a Unix socket from the same thread, so that thread
+stays the output thread the thread policy was applied to. Clients are served
+one at a time; each request is handled to completion before the next, which
+serialises access to the device. A connection that sends nothing for
+``CONNECTION_TIMEOUT_S`` is dropped, so a stalled or idle client cannot hold
+the device from everyone else.
+"""
+
+import contextlib
+import os
+import signal
+import socket
+import threading
+import time
+from pathlib import Path
+from typing import Any
+
+import numpy as np
+
+from bmd_sg.daemon.protocol import (
+    default_socket_path,
+    hdr_metadata_from_wire,
+    recv_message,
+    send_message,
+    settings_to_wire,
+)
+from bmd_sg.decklink.bmd_decklink import DecklinkSettings, PixelFormatType
+
+#: Seconds a client connection may wait between or within requests
+CONNECTION_TIMEOUT_S = 10.0
+
+
+class DeviceDaemon:
+    """
+    Owns one configured DeckLink output and serves it over a Unix socket.
+
+    Parameters
+    ----------
+    settings : DecklinkSettings
+        Settings the device is initialised with
+    use_mock : bool, optional
+        Serve a mock device instead of real hardware. Default is False.
+    socket_path : Path | None, optional
+        Socket to listen on. Default is ``default_socket_path()``.
+    connection_timeout : float, optional
+        Seconds a connection may go without sending before it is dropped.
+        Default is ``CONNECTION_TIMEOUT_S``.
+
+    Examples
+    --------
+    >>> daemon = DeviceDaemon(settings)
+    >>> daemon.serve_forever()  # until SIGINT/SIGTERM or a "stop" request
+    """
+
+    def __init__(
+        self,
+        settings: DecklinkSettings,
+        use_mock: bool = False,
+        socket_path: Path | None = None,
+        connection_timeout: float = CONNECTION_TIMEOUT_S,
+    ) -> None:
+        self.settings = settings
+        self.use_mock = use_mock
+        self.socket_path = Path(socket_path or default_socket_path())
+        self.connection_timeout = connection_timeout
+        self.decklink: Any = None
+        self._config: dict[str, Any] = {}
+        self._listener: socket.socket | None = None
+        self._running = False
+        self._start_time = time.monotonic()
+        self._frames = 0
+        self._requests = 0
+        self._last_shape: list[int] = []
+
+    # ------------------------------------------------------------------
+    # Lifecycle
+    # ------------------------------------------------------------------
+
+    def open(self) -> None:
+        """
+        Initialise the device and bind the socket.
+
+        Raises
+        ------
+        RuntimeError
+            If another daemon is already serving the socket, or device
+            initialisation fails
+        """
+        # Deferred: shared imports the daemon client for routing
+        from bmd_sg.cli.shared import initialize_device
+
+        self._bind()
+        try:
+            self.decklink = initialize_device(self.settings, use_mock=self.use_mock)
+        except Exception:
+            self.close()
+            raise
+        self._config = settings_to_wire(self.settings)
+        self._start_time = time.monotonic()
+
+    def _bind(self) -> None:
+        if self.socket_path.exists():
+            probe = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+            try:
+                probe.connect(str(self.socket_path))
+            except OSError:
+                # Left behind by a daemon that did not shut down cleanly
+                self.socket_path.unlink()
+            else:
+                raise RuntimeError(
+                    f"A daemon is already listening on {self.socket_path}"
+                )
+            finally:
+                probe.close()
+
+        self.socket_path.parent.mkdir(parents=True, exist_ok=True)
+        listener = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+        listener.bind(str(self.socket_path))
+        os.chmod(self.socket_path, 0o600)
+        listener.listen(8)
+        # Wake up periodically so a stop request or signal is noticed
+        listener.settimeout(0.5)
+        self._listener = listener
+
+    def close(self) -> None:
+        """Stop listening, remove the socket and release the device."""
+        self._running = False
+        if self._listener is not None:
+            self._listener.close()
+            self._listener = None
+            with contextlib.suppress(FileNotFoundError):
+                self.socket_path.unlink()
+        if self.decklink is not None:
+            self.decklink.close()
+            self.decklink = None
+
+    def stop(self) -> None:
+        """Ask ``serve_forever`` to return after the current request."""
+        self._running = False
+
+    def serve_forever(self) -> None:
+        """
+        Serve clients until stopped.
+
+        Installs SIGINT/SIGTERM handlers that stop the loop when called from
+        the main thread. The device and socket are released on return.
+        """
+        if self._listener is None:
+            self.open()
+
+        if threading.current_thread() is threading.main_thread():
+            for signum in (signal.SIGINT, signal.SIGTERM):
+                signal.signal(signum, lambda *_: self.stop())
+
+        self._running = True
+        try:
+            while self._running and self._listener is not None:
+                try:
+                    conn, _ = self._listener.accept()
+                except TimeoutError:
+                    continue
+                except OSError:
+                    if not self._running:
+                        break
+                    raise
+                with conn:
+                    conn.settimeout(self.connection_timeout)
+                    self._serve_connection(conn)
+        finally:
+            self.close()
+
+    # ------------------------------------------------------------------
+    # Requests
+    # ------------------------------------------------------------------
+
+    def _serve_connection(self, conn: socket.socket) -> None:
+        while self._running:
+            try:
+                message = recv_message(conn)
+            except (ConnectionError, OSError):
+                return
+            if message is None:
+                return
+            header, payload = message
+            self._requests += 1
+            try:
+                response = self.handle(header, payload)
+            except Exception as e:
+                response = {"ok": False, "error": str(e)}
+            try:
+                send_message(conn, response)
+            except OSError:
+                return
+
+    def handle(self, request: dict[str, Any], payload: bytearray) -> dict[str, Any]:
+        """
+        Execute one request against the device.
+
+        Parameters
+        ----------
+        request : dict[str, Any]
+            Request fields; ``op`` selects the operation
+        payload : bytearray
+            Frame data for ``display``
+
+        Returns
+        -------
+        dict[str, Any]
+            Response fields, always including ``ok``
+
+        Raises
+        ------
+        RuntimeError
+            If the operation is unknown or fails
+        """
+        op = request.get("op")
+        if op == "configure":
+            return self._configure(request["config"])
+        if op == "display":
+            return self._display(request, payload)
+        if op == "status":
+            return self._status()
+        if op == "stop":
+            self.stop()
+            return {"ok": True}
+        raise RuntimeError(f"Unknown daemon request '{op}'")
+
+    def _configure(self, config: dict[str, Any]) -> dict[str, Any]:
+        """Bring the output to a client's configuration, changing only diffs."""
+        if config["device"] != self._config["device"]:
+            raise RuntimeError(
+                f"Daemon serves device {self._config['device']}, "
+                f"not device {config['device']}"
+            )
+
+        pixel_format = None
+        if config["pixel_format"] not in (None, self.decklink.pixel_format.name):
+            pixel_format = PixelFormatType[config["pixel_format"]]
+
+        hdr_keys = [k for k in config if k not in ("device", "pixel_format")]
+        hdr_changed = any(config[k] != self._config.get(k) for k in hdr_keys)
+        hdr_metadata = hdr_metadata_from_wire(config) if hdr_changed else None
+
+        changed = []
+        if pixel_format is not None or hdr_metadata is not None:
+            self.decklink.reconfigure(
+                pixel_format=pixel_format, hdr_metadata=hdr_metadata
+            )
+            if pixel_format is not None:
+                changed.append("pixel_format")
+                self._config["pixel_format"] = config["pixel_format"]
+            if hdr_metadata is not None:
+                auto_cll = config.get("auto_cll", False) and not config["no_hdr"]
+                self.decklink.set_frame_stats(auto_hdr_metadata=auto_cll)
+                changed.append("hdr")
+                self._config.update({k: config[k] for k in hdr_keys})
+
+        return {"ok": True, "changed": changed, **self._device_info()}
+
+    def _display(self, request: dict[str, Any], payload: bytearray) -> dict[str, Any]:
+        shape = tuple(request["shape"])
+        frame = np.frombuffer(payload, dtype=np.uint16).reshape(shape)
+        stats = self.decklink.display_frame(frame)
+        self._frames += 1
+        self._last_shape = list(shape)
+        return {"ok": True, "frame_stats": stats.to_dict() if stats else None}
+
+    def _device_info(self) -> dict[str, Any]:
+        pixel_format = self.decklink.pixel_format
+        return {
+            "device_name": getattr(self.decklink, "device_name", "Unknown"),
+            "pixel_format": pixel_format.name,
+            "bit_depth": pixel_format.bit_depth,
+        }
+
+    def _status(self) -> dict[str, Any]:
+        return {
+            "ok": True,
+            **self._device_info(),
+            "pid": os.getpid(),
+            "mock": self.use_mock,
+            "uptime_seconds": time.monotonic() - self._start_time,
+            "frames_displayed": self._frames,
+            "requests": self._requests,
+            "last_frame_shape": self._last_shape,
+            "config": self._config,
+            "memory": self.decklink.memory_stats(),
+            "frame_stats": self._frame_stats(),
+            "thread_policy": self._thread_policy(),
+        }
+
+    def _frame_stats(self) -> dict[str, Any] | None:
+        stats = self.decklink.frame_stats()
+        return stats.to_dict() if stats.valid else None
+
+    def _thread_policy(self) -> dict[str, Any]:
+        """Policy in effect on the output thread, as the device reports it."""
+        status = self.decklink.thread_policy_status
+        policy = {name: getattr(status, name) for name, _ in status._fields_}
+        return {**policy, "lockRequested": self.settings.lock_memory}
+
+
+__all__ = ["CONNECTION_TIMEOUT_S", "DeviceDaemon"]
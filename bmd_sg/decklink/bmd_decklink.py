@@ -48,14 +48,20 @@ bmd_sg.decklink_control : High-level device control interface
 """
 
 import ctypes
+import itertools
 import re
+import threading
+import zlib
+from collections.abc import Iterator, Sequence
 from dataclasses import dataclass
-from enum import Enum
+from enum import Enum, StrEnum
 from pathlib import Path
 from typing import Any, ClassVar, Self
 
 import numpy as np
 
+from bmd_sg.utilities.tracing import traced
+
 
 class PixelFormatType(str, Enum):
     """
@@ -632,783 +638,4780 @@ class HDRMetadata(ctypes.Structure):
         self.referencePrimaries = Gamut_Chromaticities_REC2020
 
 
-# Video resolution constants for standard formats
-DEFAULT_WIDTH = 1920  # Full HD/4K width
-DEFAULT_HEIGHT = 1080  # Full HD height
+class HDRMetadataTableStats(ctypes.Structure):
+    """
+    Interned HDR metadata table occupancy and counters.
 
-# HDR metadata constants following industry standards
-DEFAULT_MAX_CLL = 10000.0  # Maximum Content Light Level (cd/m²)
-DEFAULT_MAX_FALL = 400.0  # Maximum Frame Average Light Level (cd/m²)
-DEFAULT_MAX_DISPLAY_MASTERING_LUMINANCE = 1000.0  # Display mastering luminance (cd/m²)
-DEFAULT_MIN_DISPLAY_MASTERING_LUMINANCE = 0.0001  # Minimum display luminance (cd/m²)
+    Attributes
+    ----------
+    entries, capacity : int
+        Distinct metadata sets interned, and the most the table holds.
+    interned : int
+        Intern calls.
+    reused : int
+        Intern calls that matched an existing entry.
+    attached : int
+        HDR frames that were given a shared metadata provider.
+    fallbacks : int
+        HDR frames whose metadata had to be copied value by value.
+    """
 
+    _fields_: ClassVar = [
+        ("entries", ctypes.c_int32),
+        ("capacity", ctypes.c_int32),
+        ("interned", ctypes.c_int64),
+        ("reused", ctypes.c_int64),
+        ("attached", ctypes.c_int64),
+        ("fallbacks", ctypes.c_int64),
+    ]
 
-@dataclass
-class DecklinkSettings:
+
+class OutputConfig(ctypes.Structure):
     """
-    Comprehensive configuration settings for DeckLink device initialization and operation.
+    Requested output configuration for in-place reconfiguration.
 
-    This dataclass consolidates all settings required for configuring a DeckLink device
-    including device selection, video resolution, pixel format, region of interest,
-    HDR metadata parameters, and color space information. It provides a unified
-    interface for all DeckLink-related configuration.
+    Mirrors the C++ ``OutputConfig`` struct. Zero ``pixelFormat`` or
+    ``displayMode`` keeps the active value; ``applyHDR`` selects whether
+    ``hdrMetadata`` is part of the request.
+    """
 
-    Parameters
-    ----------
-    device : int, optional
-        Index of the DeckLink device to use. Default is 0.
-    pixel_format : PixelFormatType | None, optional
-        Pixel format enum, None for auto-selection. Default is None.
-    width : int, optional
-        Frame width in pixels. Default is 1920.
-    height : int, optional
-        Frame height in pixels. Default is 1080.
-    roi_x : int, optional
-        Region of interest X offset. Default is 0.
-    roi_y : int, optional
-        Region of interest Y offset. Default is 0.
-    roi_width : int, optional
-        Region of interest width. Default is 1920.
-    roi_height : int, optional
-        Region of interest height. Default is 1080.
-    no_hdr : bool, optional
-        Whether to disable HDR metadata output. Default is False.
-    eotf : EOTFType, optional
-        Electro-Optical Transfer Function type. Default is PQ (HDR10).
-    max_cll : float, optional
-        Maximum Content Light Level in cd/m². Default is 10000.0.
-    max_fall : float, optional
-        Maximum Frame Average Light Level in cd/m². Default is 400.0.
-    max_display_mastering_luminance : float, optional
-        Maximum display mastering luminance in cd/m². Default is 1000.0.
-    min_display_mastering_luminance : float, optional
-        Minimum display mastering luminance in cd/m². Default is 0.0001.
-    gamut_chromaticities : Gamut_Chromaticities, optional
-        Complete color gamut definition including red, green, blue primaries
-        and white point chromaticity coordinates. Default is Rec.2020.
+    _fields_: ClassVar = [
+        ("pixelFormat", ctypes.c_uint32),
+        ("displayMode", ctypes.c_uint32),
+        ("applyHDR", ctypes.c_int32),
+        ("hdrMetadata", HDRMetadata),
+    ]
 
-    Attributes
-    ----------
-    device : int
-        Index of the DeckLink device to use
-    pixel_format : PixelFormatType | None
-        Pixel format enum, None for auto-selection
-    width : int
-        Frame width in pixels
-    height : int
-        Frame height in pixels
-    roi_x : int
-        Region of interest X offset
-    roi_y : int
-        Region of interest Y offset
-    roi_width : int
-        Region of interest width
-    roi_height : int
-        Region of interest height
-    no_hdr : bool
-        Whether to disable HDR metadata output
-    eotf : EOTFType
-        Electro-Optical Transfer Function type
-    max_cll : float
-        Maximum Content Light Level in cd/m²
-    max_fall : float
-        Maximum Frame Average Light Level in cd/m²
-    max_display_mastering_luminance : float
-        Maximum display mastering luminance in cd/m²
-    min_display_mastering_luminance : float
-        Minimum display mastering luminance in cd/m²
-    gamut_chromaticities : Gamut_Chromaticities
-        Complete color gamut definition including red, green, blue primaries
-        and white point chromaticity coordinates
 
-    Examples
-    --------
-    Create settings with defaults:
+class ReconfigureStats(ctypes.Structure):
+    """
+    Outcome of the most recent in-place reconfiguration.
 
-    >>> settings = DecklinkSettings()
-    >>> print(f"Device: {settings.device}, Resolution: {settings.width}x{settings.height}")
-    Device: 0, Resolution: 1920x1080
+    Attributes
+    ----------
+    pixelFormatChanged, displayModeChanged, hdrChanged : int
+        Non-zero for each part of the configuration that differed.
+    sdiLinkChanged : int
+        Non-zero if the SDI 4:4:4 / 4:2:2 link layout had to change.
+    setFlagCalls : int
+        Number of ``IDeckLinkConfiguration::SetFlag`` calls issued.
+    enableCycles : int
+        Number of DisableVideoOutput/EnableVideoOutput cycles (0 or 1).
+    framesRepresented : int
+        Number of times the current frame was re-sent to apply the change.
+    reenableLatencyUs : int
+        Microseconds from DisableVideoOutput until the current frame was back
+        on the output. Zero when no enable cycle was needed.
+    totalLatencyUs : int
+        Microseconds spent in the whole reconfiguration call.
+    """
 
-    Create settings for specific device with custom HDR:
+    _fields_: ClassVar = [
+        ("pixelFormatChanged", ctypes.c_int32),
+        ("displayModeChanged", ctypes.c_int32),
+        ("hdrChanged", ctypes.c_int32),
+        ("sdiLinkChanged", ctypes.c_int32),
+        ("setFlagCalls", ctypes.c_int32),
+        ("enableCycles", ctypes.c_int32),
+        ("framesRepresented", ctypes.c_int32),
+        ("reenableLatencyUs", ctypes.c_int64),
+        ("totalLatencyUs", ctypes.c_int64),
+    ]
 
-    >>> settings = DecklinkSettings(
-    ...     device=1,
-    ...     width=3840,
-    ...     height=2160,
-    ...     eotf=EOTFType.HLG,
-    ...     max_cll=4000.0
-    ... )
-    >>> print(f"EOTF: {settings.eotf}, Max CLL: {settings.max_cll}")
-    EOTF: HLG, Max CLL: 4000.0
 
-    Create settings with custom ROI:
+class ThreadSchedPolicy(StrEnum):
+    """
+    Scheduling policy requested for the output thread.
 
-    >>> settings = DecklinkSettings(
-    ...     roi_x=100,
-    ...     roi_y=100,
-    ...     roi_width=1720,
-    ...     roi_height=880
-    ... )
-    >>> print(f"ROI: {settings.roi_x},{settings.roi_y} {settings.roi_width}x{settings.roi_height}")
-    ROI: 100,100 1720x880
+    Attributes
+    ----------
+    OTHER : str
+        Default time-sharing scheduling
+    FIFO : str
+        ``SCHED_FIFO`` real-time scheduling
+    RR : str
+        ``SCHED_RR`` real-time scheduling
 
     Notes
     -----
-    This class consolidates all DeckLink device configuration into a single
-    interface, eliminating the need for multiple settings classes and conversion
-    functions. It supports complete HDR metadata configuration following
-    industry standards (SMPTE ST 2086, CEA-861.3).
+    Real-time policies need ``CAP_SYS_NICE`` or an ``rtprio`` limit on Linux.
+    When refused, the library falls back to ``OTHER`` and reports it in
+    ``ThreadPolicyStatus.schedFallback``.
+    """
 
-    The default color primaries are set to Rec.2020 (ITU-R BT.2020) which is
-    the standard for Ultra HD and HDR content. The default EOTF is PQ
-    (Perceptual Quantizer) as specified in SMPTE ST 2084 for HDR10.
+    OTHER = "OTHER"
+    FIFO = "FIFO"
+    RR = "RR"
 
-    See Also
-    --------
-    HDRMetadata : HDR metadata structure for device configuration
-    PixelFormatType : Available pixel format options
-    EOTFType : Electro-Optical Transfer Function types
+    @property
+    def int_value(self) -> int:
+        """Value of the C++ ``ThreadSchedPolicy`` enum."""
+        return list(ThreadSchedPolicy).index(self)
+
+
+class ThreadPolicyConfig(ctypes.Structure):
     """
+    Requested thread placement and scheduling.
 
-    # Device parameters
-    device: int = 0
-    pixel_format: PixelFormatType | None = None
-    width: int = DEFAULT_WIDTH
-    height: int = DEFAULT_HEIGHT
+    Mirrors the C++ ``ThreadPolicyConfig`` struct. Negative cores disable
+    pinning; packing worker ``i`` is pinned to ``packCoreFirst + i``.
+    """
 
-    # ROI parameters
-    roi_x: int = 0
-    roi_y: int = 0
-    roi_width: int = DEFAULT_WIDTH
-    roi_height: int = DEFAULT_HEIGHT
+    _fields_: ClassVar = [
+        ("outputCore", ctypes.c_int32),
+        ("schedPolicy", ctypes.c_int32),
+        ("schedPriority", ctypes.c_int32),
+        ("packWorkers", ctypes.c_int32),
+        ("packCoreFirst", ctypes.c_int32),
+        ("lockMemory", ctypes.c_int32),
+    ]
 
-    # HDR metadata settings
-    no_hdr: bool = False
-    eotf: EOTFType = EOTFType.PQ
-    max_cll: float = DEFAULT_MAX_CLL
-    max_fall: float = DEFAULT_MAX_FALL
-    max_display_mastering_luminance: float = DEFAULT_MAX_DISPLAY_MASTERING_LUMINANCE
-    min_display_mastering_luminance: float = DEFAULT_MIN_DISPLAY_MASTERING_LUMINANCE
 
-    # Color space primaries and white point
-    gamut_chromaticities: GamutChromaticities = Gamut_Chromaticities_REC2020
+class ThreadPolicyStatus(ctypes.Structure):
+    """
+    Thread placement and scheduling actually in effect.
 
+    Attributes
+    ----------
+    outputCore : int
+        Core requested for the output thread (-1 if none).
+    outputPinned : int
+        0 not pinned, 1 pinned, 2 scheduler hint only (macOS), -1 refused.
+    schedPolicy : int
+        Effective policy of the output thread (0 other, 1 FIFO, 2 RR).
+    schedPriority : int
+        Effective real-time priority (0 for the default policy).
+    schedFallback : int
+        Non-zero if the requested real-time policy was refused.
+    packWorkers : int
+        Number of packing worker threads running.
+    packWorkersPinned : int
+        Number of packing workers pinned (or hinted) to their core.
+    memoryLocked : int
+        Non-zero if every frame pool buffer is ``mlock``-ed.
+    lockedBytes : int
+        Bytes of frame pool memory currently locked.
+    """
 
-def _configure_function_signatures(lib: ctypes.CDLL) -> None:  # noqa: C901
-    """Configure ctypes function signatures for all DeckLink SDK functions.
+    _fields_: ClassVar = [
+        ("outputCore", ctypes.c_int32),
+        ("outputPinned", ctypes.c_int32),
+        ("schedPolicy", ctypes.c_int32),
+        ("schedPriority", ctypes.c_int32),
+        ("schedFallback", ctypes.c_int32),
+        ("packWorkers", ctypes.c_int32),
+        ("packWorkersPinned", ctypes.c_int32),
+        ("memoryLocked", ctypes.c_int32),
+        ("lockedBytes", ctypes.c_int64),
+    ]
 
-    Sets up argument types and return types for all C functions in the DeckLink
-    SDK library to ensure proper type safety and memory management when calling
-    from Python.
 
-    Parameters
-    ----------
-    lib : ctypes.CDLL
-        The loaded DeckLink SDK library instance.
+# Must match kFrameTimingBins / kFrameTimingMaxOutliers in frame_timing.h
+FRAME_TIMING_BINS = 33
+FRAME_TIMING_MAX_OUTLIERS = 64
 
-    Notes
-    -----
-    This function configures signatures for:
-    - Device enumeration (count, names)
-    - Device management (open, close, start, stop)
-    - Pixel format management
-    - HDR metadata handling
-    - Frame data operations
-    - Version information
+
+class FrameTimingReport(ctypes.Structure):
     """
+    Inter-frame interval and latency statistics since the last reset.
 
-    # Device enumeration functions
-    if hasattr(lib, "decklink_get_device_count"):
-        lib.decklink_get_device_count.argtypes = []
-        lib.decklink_get_device_count.restype = ctypes.c_int
+    Histogram bin ``i`` covers ``[i, i + 1) * nominalIntervalNs / binsPerFrame``;
+    the last bin collects everything beyond. Gaps longer than 30 frames with
+    no frame waiting to be shown (a still image held on screen) count as
+    ``idleGaps`` rather than intervals. Clip, scheduled and stream playback
+    are never idle, so all their gaps are intervals.
 
-    if hasattr(lib, "decklink_get_device_name_by_index"):
-        lib.decklink_get_device_name_by_index.argtypes = [
-            ctypes.c_int,
-            ctypes.c_char_p,
-            ctypes.c_int,
-        ]
-        lib.decklink_get_device_name_by_index.restype = ctypes.c_int
+    Attributes
+    ----------
+    nominalIntervalNs : int
+        Frame duration of the active display mode.
+    frames, intervals, idleGaps : int
+        Completions recorded, intervals histogrammed and idle gaps skipped.
+    minIntervalNs, maxIntervalNs, meanIntervalNs, stddevIntervalNs : int
+        Completion-to-completion interval statistics.
+    minLatencyNs, maxLatencyNs, meanLatencyNs : int
+        Frame data submission to display completion.
+    outliers : int
+        Intervals longer than ``(1 + outlierThreshold) * nominalIntervalNs``.
+    missedFrames : int
+        Output frame slots skipped, estimated from the intervals.
+    outlierThreshold : float
+        Outlier threshold as a fraction of the nominal interval.
+    histogramBins, binsPerFrame : int
+        Histogram layout.
+    intervalHistogram, latencyHistogram : ctypes.Array
+        Counts per bin.
+    """
 
-    # Device management functions
-    if hasattr(lib, "decklink_open_output_by_index"):
-        lib.decklink_open_output_by_index.argtypes = [ctypes.c_int]
-        lib.decklink_open_output_by_index.restype = ctypes.c_void_p
+    _fields_: ClassVar = [
+        ("nominalIntervalNs", ctypes.c_int64),
+        ("frames", ctypes.c_int64),
+        ("intervals", ctypes.c_int64),
+        ("idleGaps", ctypes.c_int64),
+        ("minIntervalNs", ctypes.c_int64),
+        ("maxIntervalNs", ctypes.c_int64),
+        ("meanIntervalNs", ctypes.c_int64),
+        ("stddevIntervalNs", ctypes.c_int64),
+        ("minLatencyNs", ctypes.c_int64),
+        ("maxLatencyNs", ctypes.c_int64),
+        ("meanLatencyNs", ctypes.c_int64),
+        ("outliers", ctypes.c_int64),
+        ("missedFrames", ctypes.c_int64),
+        ("outlierThreshold", ctypes.c_double),
+        ("histogramBins", ctypes.c_int32),
+        ("binsPerFrame", ctypes.c_int32),
+        ("intervalHistogram", ctypes.c_int64 * FRAME_TIMING_BINS),
+        ("latencyHistogram", ctypes.c_int64 * FRAME_TIMING_BINS),
+    ]
 
-    if hasattr(lib, "decklink_close"):
-        lib.decklink_close.argtypes = [ctypes.c_void_p]
-        lib.decklink_close.restype = None
 
-    # Output control functions
-    if hasattr(lib, "decklink_start_output"):
-        lib.decklink_start_output.argtypes = [ctypes.c_void_p]
-        lib.decklink_start_output.restype = ctypes.c_int
+class FrameTimingOutlier(ctypes.Structure):
+    """
+    One inter-frame interval above the outlier threshold.
 
-    if hasattr(lib, "decklink_start_output_with_mode"):
-        lib.decklink_start_output_with_mode.argtypes = [
-            ctypes.c_void_p,
-            ctypes.c_uint32,
-        ]
-        lib.decklink_start_output_with_mode.restype = ctypes.c_int
+    Attributes
+    ----------
+    frameIndex : int
+        Index of the late frame since the last reset.
+    completionNs : int
+        Monotonic (steady clock) timestamp of the late completion.
+    intervalNs : int
+        Gap since the previous completion.
+    latencyNs : int
+        Submission-to-completion latency of the late frame, -1 if the frame
+        was re-presented without new data.
+    """
 
-    if hasattr(lib, "decklink_stop_output"):
-        lib.decklink_stop_output.argtypes = [ctypes.c_void_p]
-        lib.decklink_stop_output.restype = ctypes.c_int
+    _fields_: ClassVar = [
+        ("frameIndex", ctypes.c_int64),
+        ("completionNs", ctypes.c_int64),
+        ("intervalNs", ctypes.c_int64),
+        ("latencyNs", ctypes.c_int64),
+    ]
 
-    # Pixel format functions
-    if hasattr(lib, "decklink_get_supported_pixel_format_count"):
-        lib.decklink_get_supported_pixel_format_count.argtypes = [ctypes.c_void_p]
-        lib.decklink_get_supported_pixel_format_count.restype = ctypes.c_int
 
-    if hasattr(lib, "decklink_get_supported_pixel_format_name"):
-        lib.decklink_get_supported_pixel_format_name.argtypes = [
-            ctypes.c_void_p,
-            ctypes.c_int,
-            ctypes.c_char_p,
-            ctypes.c_int,
-        ]
-        lib.decklink_get_supported_pixel_format_name.restype = ctypes.c_int
+# Must match the MemorySubsystem enum in memory_stats.h
+MEMORY_SUBSYSTEMS = (
+    "pending_input",
+    "pack_scratch",
+    "frame_pool",
+    "overlays",
+    "caches",
+    "logger",
+    "frame_cache",
+    "trace",
+    "recorder",
+)
 
-    if hasattr(lib, "decklink_set_pixel_format"):
-        lib.decklink_set_pixel_format.argtypes = [
-            ctypes.c_void_p,
-            ctypes.c_uint32,
-        ]
-        lib.decklink_set_pixel_format.restype = ctypes.c_int
 
-    if hasattr(lib, "decklink_get_pixel_format"):
-        lib.decklink_get_pixel_format.argtypes = [ctypes.c_void_p]
-        lib.decklink_get_pixel_format.restype = ctypes.c_uint32
+class MemoryStats(ctypes.Structure):
+    """
+    Heap accounting for one library subsystem (see ``MEMORY_SUBSYSTEMS``).
 
-    # HDR metadata functions
-    if hasattr(lib, "decklink_set_hdr_metadata"):
-        lib.decklink_set_hdr_metadata.argtypes = [
-            ctypes.c_void_p,
-            ctypes.POINTER(HDRMetadata),
-        ]
-        lib.decklink_set_hdr_metadata.restype = ctypes.c_int
+    Attributes
+    ----------
+    currentBytes : int
+        Bytes currently allocated.
+    peakBytes : int
+        Highest ``currentBytes`` since start or the last peak reset.
+    allocations, frees : int
+        Blocks allocated and freed since the library was loaded; a difference
+        that keeps growing in a steady state indicates a leak.
+    """
 
-    # Frame data management functions
-    if hasattr(lib, "decklink_set_frame_data"):
-        lib.decklink_set_frame_data.argtypes = [
-            ctypes.c_void_p,
-            ctypes.POINTER(ctypes.c_uint16),
-            ctypes.c_int,
-            ctypes.c_int,
-        ]
-        lib.decklink_set_frame_data.restype = ctypes.c_int
+    _fields_: ClassVar = [
+        ("currentBytes", ctypes.c_int64),
+        ("peakBytes", ctypes.c_int64),
+        ("allocations", ctypes.c_int64),
+        ("frees", ctypes.c_int64),
+    ]
 
-    # Frame management functions
-    if hasattr(lib, "decklink_create_frame_from_data"):
-        lib.decklink_create_frame_from_data.argtypes = [ctypes.c_void_p]
-        lib.decklink_create_frame_from_data.restype = ctypes.c_int
 
-    # Synchronous display function
-    if hasattr(lib, "decklink_display_frame_sync"):
-        lib.decklink_display_frame_sync.argtypes = [ctypes.c_void_p]
-        lib.decklink_display_frame_sync.restype = ctypes.c_int
+# Must match the TraceStage enum in trace.h
+TRACE_STAGES = (
+    "copy",
+    "wait",
+    "pack",
+    "cache_load",
+    "overlay",
+    "metadata",
+    "display",
+    "queue",
+    "dispatch",
+    "on_device",
+)
 
-    # HDR capability detection functions
-    if hasattr(lib, "decklink_device_supports_hdr"):
-        lib.decklink_device_supports_hdr.argtypes = [ctypes.c_void_p]
-        lib.decklink_device_supports_hdr.restype = ctypes.c_bool
 
-    # Version info functions
-    if hasattr(lib, "decklink_get_driver_version"):
-        lib.decklink_get_driver_version.argtypes = []
-        lib.decklink_get_driver_version.restype = ctypes.c_char_p
+class TraceSpan(ctypes.Structure):
+    """
+    One traced stage of the library's frame path.
 
-    if hasattr(lib, "decklink_get_sdk_version"):
-        lib.decklink_get_sdk_version.argtypes = []
-        lib.decklink_get_sdk_version.restype = ctypes.c_char_p
+    Attributes
+    ----------
+    startNs, endNs : int
+        Steady clock timestamps, as ``decklink_trace_now_ns()`` returns them.
+    frameId : int
+        Frame id set on the recording thread when the frame entered the
+        library, 0 for work not tied to a frame.
+    threadId : int
+        OS thread id, as ``threading.get_native_id()`` reports it.
+    stage : int
+        Index into ``TRACE_STAGES``.
+    """
 
+    _fields_: ClassVar = [
+        ("startNs", ctypes.c_int64),
+        ("endNs", ctypes.c_int64),
+        ("frameId", ctypes.c_int64),
+        ("threadId", ctypes.c_int64),
+        ("stage", ctypes.c_int32),
+        ("reserved", ctypes.c_int32),
+    ]
 
-def _try_load_decklink_sdk() -> ctypes.CDLL:
-    """Load the DeckLink SDK library and configure function signatures.
 
-    Attempts to load the compiled libdecklink.dylib from the same directory
-    as this Python module, then configures all ctypes function signatures
-    for type safety.
+class TraceThread(ctypes.Structure):
+    """
+    A thread that has recorded trace spans.
 
-    Returns
-    -------
-    ctypes.CDLL
-        The loaded and configured DeckLink SDK library instance.
+    Attributes
+    ----------
+    threadId : int
+        OS thread id.
+    name : bytes
+        Name of a thread the library started, empty for the caller's.
+    """
 
-    Raises
-    ------
-    FileNotFoundError
-        If libdecklink.dylib cannot be found in the expected location.
-    OSError
-        If the library exists but cannot be loaded (e.g., architecture mismatch,
-        missing dependencies, or permission issues).
+    _fields_: ClassVar = [
+        ("threadId", ctypes.c_int64),
+        ("name", ctypes.c_char * 32),
+    ]
 
-    Notes
-    -----
-    The library file must be built from the C++ source in the cpp/ directory
-    and placed in the same directory as this module.
-    """
-    lib_path = Path(__file__).parent.joinpath("libdecklink.dylib")
-    try:
-        # Try to load from the lib directory relative to this script
-        if lib_path.exists() and lib_path.is_file():
-            decklink_lib = ctypes.CDLL(lib_path)
-        else:
-            raise FileNotFoundError(
-                f"Could not find libdecklink.dylib in Python project: {lib_path.absolute()}"
-            )
-    except OSError as error:
-        raise OSError(
-            f"Failed to load DeckLink library from {lib_path.absolute()}"
-        ) from error
 
-    # Configure all function signatures
-    _configure_function_signatures(decklink_lib)
+class TraceStats(ctypes.Structure):
+    """
+    Counters of span tracing.
 
-    return decklink_lib
+    Attributes
+    ----------
+    enabled : int
+        Non-zero while tracing is on.
+    threads : int
+        Threads that have recorded a span.
+    recorded : int
+        Spans recorded since the library was loaded.
+    collected, lost : int
+        Spans collected, and spans overwritten before they could be, since
+        tracing was last turned on.
+    """
 
+    _fields_: ClassVar = [
+        ("enabled", ctypes.c_int32),
+        ("threads", ctypes.c_int32),
+        ("recorded", ctypes.c_int64),
+        ("collected", ctypes.c_int64),
+        ("lost", ctypes.c_int64),
+    ]
 
-DecklinkSDKWrapper: ctypes.CDLL = _try_load_decklink_sdk()
 
+class PipelineStats(ctypes.Structure):
+    """
+    Counters of pipelined (pack-while-display) output.
 
-def get_decklink_driver_version() -> str:
+    Attributes
+    ----------
+    running : int
+        Non-zero while pipelined output is enabled.
+    lastError : int
+        Most recent pack or display error, 0 if none.
+    submitted, packed, displayed, errors : int
+        Frames through each stage and frames lost to errors.
+    submitBlockedNs : int
+        Total time ``display_frame`` waited for the pipeline.
+    meanPackNs, maxPackNs : int
+        Pack stage duration per frame.
     """
-    Get the DeckLink driver version string.
 
-    Returns
-    -------
-    str
-        The version string of the installed DeckLink driver.
+    _fields_: ClassVar = [
+        ("running", ctypes.c_int32),
+        ("lastError", ctypes.c_int32),
+        ("submitted", ctypes.c_int64),
+        ("packed", ctypes.c_int64),
+        ("displayed", ctypes.c_int64),
+        ("errors", ctypes.c_int64),
+        ("submitBlockedNs", ctypes.c_int64),
+        ("meanPackNs", ctypes.c_int64),
+        ("maxPackNs", ctypes.c_int64),
+    ]
 
-    Examples
-    --------
-    >>> version = get_decklink_driver_version()
-    >>> print(f"Driver version: {version}")
-    Driver version: 12.8.1
 
-    Notes
-    -----
-    Requires DeckLink Desktop Video drivers to be installed.
+class FrcConfig(ctypes.Structure):
     """
-    return DecklinkSDKWrapper.decklink_get_driver_version().decode("utf-8")
-
+    Temporal dithering (FRC) request.
 
-def get_decklink_sdk_version() -> str:
+    Mirrors the C++ ``FrcConfig`` struct. ``target`` holds fractional code
+    values at the output bit depth; a zero ``roiWidth`` or ``roiHeight``
+    dithers the whole frame. ``cycleFrames`` (1-64) sets the duty cycle
+    resolution: fractions are rounded to multiples of ``1 / cycleFrames``.
     """
-    Get the DeckLink SDK version string.
 
-    Returns
-    -------
-    str
-        The version string of the DeckLink SDK library.
+    _fields_: ClassVar = [
+        ("target", ctypes.c_double * 3),
+        ("roiX", ctypes.c_int32),
+        ("roiY", ctypes.c_int32),
+        ("roiWidth", ctypes.c_int32),
+        ("roiHeight", ctypes.c_int32),
+        ("cycleFrames", ctypes.c_int32),
+    ]
 
-    Examples
-    --------
-    >>> version = get_decklink_sdk_version()
-    >>> print(f"SDK version: {version}")
-    SDK version: 15.3.0
 
-    Notes
-    -----
-    This returns the version of the compiled libdecklink.dylib library.
+class FrameRegion(ctypes.Structure):
     """
-    return DecklinkSDKWrapper.decklink_get_sdk_version().decode("utf-8")
+    Rectangle of a frame, in pixels; mirrors the C++ ``FrameRegion`` struct.
+    """
+
+    _fields_: ClassVar = [
+        ("x", ctypes.c_int32),
+        ("y", ctypes.c_int32),
+        ("width", ctypes.c_int32),
+        ("height", ctypes.c_int32),
+    ]
 
 
-def ndarray_to_bmd_frame_buffer(
-    frame_data: np.ndarray,
-) -> tuple[Any, int, int]:
+class ClipPlaybackStats(ctypes.Structure):
     """
-    Convert numpy array to BMD-compatible frame buffer.
+    Scheduled playback counters of a looped clip.
 
-    Parameters
+    Attributes
     ----------
-    frame_data : numpy.ndarray
-        Frame data with shape (height, width, channels) or (height, width)
+    running : int
+        Non-zero while the clip is playing.
+    frames, sequenceLength : int
+        Distinct packed frames and entries per loop.
+    prerollFrames : int
+        Frames kept queued ahead of the output.
+    scheduled, completed : int
+        Frames handed to and shown by the device.
+    displayedLate, dropped, flushed : int
+        Completions the device reported late, dropped or flushed on stop.
+    """
 
-    Returns
-    -------
-    tuple[ctypes.POINTER(ctypes.c_uint16), int, int]
-        Tuple containing (data_ptr, width, height)
+    _fields_: ClassVar = [
+        ("running", ctypes.c_int32),
+        ("frames", ctypes.c_int32),
+        ("sequenceLength", ctypes.c_int32),
+        ("prerollFrames", ctypes.c_int32),
+        ("scheduled", ctypes.c_int64),
+        ("completed", ctypes.c_int64),
+        ("displayedLate", ctypes.c_int64),
+        ("dropped", ctypes.c_int64),
+        ("flushed", ctypes.c_int64),
+    ]
 
-    Raises
-    ------
-    ValueError
-        If frame_data is not a valid numpy array or has invalid dimensions
+
+class FrcStatus(ctypes.Structure):
     """
-    if not isinstance(frame_data, np.ndarray):
-        raise ValueError("frame_data must be a numpy array")
+    Levels produced by temporal dithering.
 
-    # Get dimensions
-    if frame_data.ndim == 2:
-        height, width = frame_data.shape
-    elif frame_data.ndim == 3:
-        height, width, _ = frame_data.shape
-    else:
-        raise ValueError("frame_data must be 2D or 3D array")
+    Attributes
+    ----------
+    playback : ClipPlaybackStats
+        Scheduled playback counters.
+    achieved : ctypes.Array
+        Mean code value per channel over one cycle.
+    low : ctypes.Array
+        Lower code value per channel; the upper is ``low + 1``.
+    dutyFrames : ctypes.Array
+        Frames per cycle showing the upper code value, per channel.
+    cycleFrames : int
+        Frames per dither cycle.
+    """
 
-    # Note: frame_data should already be uint16 and contiguous
-    # These conversions are handled in display_frame() before calling this function
+    _fields_: ClassVar = [
+        ("playback", ClipPlaybackStats),
+        ("achieved", ctypes.c_double * 3),
+        ("low", ctypes.c_int32 * 3),
+        ("dutyFrames", ctypes.c_int32 * 3),
+        ("cycleFrames", ctypes.c_int32),
+    ]
 
-    # Get pointer to data
-    data_ptr = frame_data.ctypes.data_as(ctypes.POINTER(ctypes.c_uint16))
-    return data_ptr, height, width
 
+class SchedulerPolicy(StrEnum):
+    """
+    What the deadline scheduler does with a frame that cannot meet its slot.
 
-def get_decklink_devices() -> list[str]:
+    Attributes
+    ----------
+    STRICT : str
+        Drop frames whose slot has passed or is already taken, and reject
+        frames when the queue is full
+    LATEST : str
+        Show the newest frame: it replaces queued frames for its slot and
+        later ones, and a late frame moves to the next free slot
     """
-    Get list of available DeckLink device names.
 
-    Returns
-    -------
-    list[str]
-        List of device names for all detected DeckLink devices.
-        Returns empty list if no devices are found.
+    STRICT = "strict"
+    LATEST = "latest"
 
-    Examples
-    --------
-    >>> devices = get_decklink_devices()
-    >>> print(f"Found {len(devices)} devices")
-    Found 2 devices
-    >>> for i, device in enumerate(devices):
-    ...     print(f"Device {i}: {device}")
-    Device 0: DeckLink Mini Monitor 4K
-    Device 1: DeckLink Studio 4K
+    @property
+    def int_value(self) -> int:
+        """Value of the C++ ``SchedulerPolicy`` enum."""
+        return list(SchedulerPolicy).index(self)
+
+
+# Names of the C++ ``SchedulerDecision`` values, by value
+SCHEDULER_DECISIONS = (
+    "queued",
+    "late",
+    "dropped_late",
+    "superseded",
+    "queue_full",
+    "dispatched",
+)
 
-    Notes
-    -----
-    Devices are returned in the order they are detected by the system.
-    The index corresponds to the device_index parameter used in BMDDeckLink.
-    """
-    count = DecklinkSDKWrapper.decklink_get_device_count()
-    devices = []
-    for i in range(count):
-        name = ctypes.create_string_buffer(256)
-        if DecklinkSDKWrapper.decklink_get_device_name_by_index(i, name, 256) == 0:
-            devices.append(name.value.decode("utf-8"))
-    return devices
 
+class SchedulerConfig(ctypes.Structure):
+    """
+    Deadline scheduler settings.
 
-class BMDDeckLink:
+    Mirrors the C++ ``SchedulerConfig`` struct. ``leadFrames`` (1-8) slots
+    ahead of the current one are handed to the device; up to ``maxPending``
+    (1-32) packed frames wait in the library until then. With ``adaptive``
+    set the lead starts at ``leadFrames`` and is tuned between
+    ``minLeadFrames`` and ``maxLeadFrames`` from the completion jitter.
     """
-    RAII wrapper for DeckLink device management.
 
-    This class provides Resource Acquisition Is Initialization (RAII) semantics
-    for DeckLink devices, ensuring proper cleanup when the object is destroyed.
-    The device is opened on initialization and automatically closed on destruction.
+    _fields_: ClassVar = [
+        ("policy", ctypes.c_int32),
+        ("leadFrames", ctypes.c_int32),
+        ("maxPending", ctypes.c_int32),
+        ("adaptive", ctypes.c_int32),
+        ("minLeadFrames", ctypes.c_int32),
+        ("maxLeadFrames", ctypes.c_int32),
+    ]
 
-    Parameters
-    ----------
-    device_index : int, optional
-        Index of the DeckLink device to open. Default is 0.
+
+class SchedulerDecisionRecord(ctypes.Structure):
+    """
+    What the deadline scheduler decided for one frame.
 
     Attributes
     ----------
-    handle : ctypes.c_void_p or None
-        Handle to the opened DeckLink device
-    device_index : int
-        Index of the device that was opened
-    _output_started : bool
-        Internal flag tracking output state
+    frameId : int
+        Sequence number of the frame, from 1.
+    targetNs : int
+        Requested presentation time on the stream clock, 0 for the next
+        free slot.
+    slot, slotNs : int
+        Frame slot assigned and its presentation time; -1 if dropped.
+    decidedNs : int
+        Stream time when the decision was taken.
+    decision : int
+        Index into ``SCHEDULER_DECISIONS``.
+    durationFrames : int
+        Slots the frame is shown for.
+    """
 
-    Examples
-    --------
-    Context manager usage (recommended):
+    _fields_: ClassVar = [
+        ("frameId", ctypes.c_int64),
+        ("targetNs", ctypes.c_int64),
+        ("slot", ctypes.c_int64),
+        ("slotNs", ctypes.c_int64),
+        ("decidedNs", ctypes.c_int64),
+        ("decision", ctypes.c_int32),
+        ("durationFrames", ctypes.c_int32),
+    ]
 
-    >>> with BMDDeckLink(device_index=0) as device:
-    ...     device.start_playback()
-    ...     # Device automatically closed when exiting the with block
+    @property
+    def decision_name(self) -> str:
+        """Name of the decision, e.g. ``"dropped_late"``."""
+        return SCHEDULER_DECISIONS[self.decision]
+
+
+# Names of the C++ ``SchedulerLeadReason`` values, by value
+SCHEDULER_LEAD_REASONS = (
+    "displayed_late",
+    "hardware_dropped",
+    "dispatch_late",
+    "jitter",
+    "stable",
+)
 
-    Basic usage with automatic cleanup:
 
-    >>> device = BMDDeckLink(device_index=0)
-    >>> device.start_playback()
-    >>> # Device automatically closed when object goes out of scope
+class SchedulerLeadChange(ctypes.Structure):
+    """
+    A change of the adaptive scheduler lead.
 
-    Manual cleanup if needed:
+    Attributes
+    ----------
+    decidedNs : int
+        Stream time of the change.
+    latenessNs, jitterNs : int
+        Peak completion lateness and interval jitter at the time.
+    fromLead, toLead : int
+        Lead in frames before and after.
+    reason : int
+        Index into ``SCHEDULER_LEAD_REASONS``.
+    """
 
-    >>> device = BMDDeckLink(device_index=0)
-    >>> device.start_playback()
-    >>> device.close()  # Explicit cleanup
+    _fields_: ClassVar = [
+        ("decidedNs", ctypes.c_int64),
+        ("latenessNs", ctypes.c_int64),
+        ("jitterNs", ctypes.c_int64),
+        ("fromLead", ctypes.c_int32),
+        ("toLead", ctypes.c_int32),
+        ("reason", ctypes.c_int32),
+        ("reserved", ctypes.c_int32),
+    ]
 
-    Raises
-    ------
+    @property
+    def reason_name(self) -> str:
+        """Name of the reason, e.g. ``"jitter"``."""
+        return SCHEDULER_LEAD_REASONS[self.reason]
+
+
+class SchedulerStats(ctypes.Structure):
+    """
+    Deadline scheduler counters.
+
+    Attributes
+    ----------
+    running, policy, leadFrames : int
+        State and settings of the scheduler.
+    pending : int
+        Packed frames waiting to be handed to the device.
+    frameDurationNs, streamTimeNs, currentSlot : int
+        Slot length and the stream clock now.
+    submitted : int
+        Frames passed to ``schedule_frame``.
+    queued, late, droppedLate, superseded, queueFull, dispatched : int
+        Decisions taken, see ``SCHEDULER_DECISIONS``.
+    displayed, displayedLate, hardwareDropped : int
+        Completions reported by the device.
+    adaptive, minLeadFrames, maxLeadFrames : int
+        Whether the lead is tuned, and its bounds.
+    neededLeadFrames : int
+        Lead the recent completion jitter calls for.
+    leadRaised, leadLowered : int
+        Adaptive lead changes, see ``scheduler_lead_changes``.
+    latenessNs, jitterNs : int
+        Peak completion lateness (beyond the steady completion delay) and
+        completion interval jitter over the last 120 completions.
+    """
+
+    _fields_: ClassVar = [
+        ("running", ctypes.c_int32),
+        ("policy", ctypes.c_int32),
+        ("leadFrames", ctypes.c_int32),
+        ("pending", ctypes.c_int32),
+        ("frameDurationNs", ctypes.c_int64),
+        ("streamTimeNs", ctypes.c_int64),
+        ("currentSlot", ctypes.c_int64),
+        ("submitted", ctypes.c_int64),
+        ("queued", ctypes.c_int64),
+        ("late", ctypes.c_int64),
+        ("droppedLate", ctypes.c_int64),
+        ("superseded", ctypes.c_int64),
+        ("queueFull", ctypes.c_int64),
+        ("dispatched", ctypes.c_int64),
+        ("displayed", ctypes.c_int64),
+        ("displayedLate", ctypes.c_int64),
+        ("hardwareDropped", ctypes.c_int64),
+        ("adaptive", ctypes.c_int32),
+        ("minLeadFrames", ctypes.c_int32),
+        ("maxLeadFrames", ctypes.c_int32),
+        ("neededLeadFrames", ctypes.c_int32),
+        ("leadRaised", ctypes.c_int64),
+        ("leadLowered", ctypes.c_int64),
+        ("latenessNs", ctypes.c_int64),
+        ("jitterNs", ctypes.c_int64),
+    ]
+
+
+class StreamConfig(ctypes.Structure):
+    """
+    Raw frame stream input settings.
+
+    Mirrors the C++ ``StreamConfig`` struct. ``format`` is 0 for interleaved
+    native-endian uint16 RGB frames and 1 for frames already packed in the
+    active pixel format at the SDK's row bytes. ``readahead`` (1-16) frames
+    are read ahead of the display.
+    """
+
+    _fields_: ClassVar = [
+        ("fd", ctypes.c_int32),
+        ("format", ctypes.c_int32),
+        ("width", ctypes.c_int32),
+        ("height", ctypes.c_int32),
+        ("readahead", ctypes.c_int32),
+        ("loop", ctypes.c_int32),
+        ("maxFrames", ctypes.c_int64),
+    ]
+
+
+class StreamStats(ctypes.Structure):
+    """
+    Raw frame stream counters.
+
+    Attributes
+    ----------
+    running : int
+        Non-zero while frames are being read and displayed.
+    format : int
+        0 for RGB48 input, 1 for pre-packed input.
+    endOfInput : int
+        1 once the input ended, 2 if it ended inside a frame.
+    lastError : int
+        Read, pack or display error that ended the stream, 0 if none.
+    frameBytes : int
+        Bytes per frame expected on the input.
+    framesRead, framesDisplayed, bytesRead : int
+        Progress of the stream.
+    underruns : int
+        Times the display had no frame ready (the producer fell behind).
+    readWaitNs : int
+        Total time the reader waited for the display (input ahead of rate).
+    meanReadNs, maxReadNs : int
+        Read and pack time per frame.
+    """
+
+    _fields_: ClassVar = [
+        ("running", ctypes.c_int32),
+        ("format", ctypes.c_int32),
+        ("endOfInput", ctypes.c_int32),
+        ("lastError", ctypes.c_int32),
+        ("frameBytes", ctypes.c_int64),
+        ("framesRead", ctypes.c_int64),
+        ("framesDisplayed", ctypes.c_int64),
+        ("bytesRead", ctypes.c_int64),
+        ("underruns", ctypes.c_int64),
+        ("readWaitNs", ctypes.c_int64),
+        ("meanReadNs", ctypes.c_int64),
+        ("maxReadNs", ctypes.c_int64),
+    ]
+
+
+# Must match the RecordedSource enum in frame_recorder.h
+RECORDED_SOURCES = (
+    "display",
+    "pipelined",
+    "scheduled",
+    "stream",
+    "external",
+    "clip",
+)
+
+RECORDING_MAGIC = b"BMDREC\0\0"
+RECORDING_VERSION = 1
+
+
+class RecorderConfig(ctypes.Structure):
+    """
+    Output recording settings.
+
+    Mirrors the C++ ``RecorderConfig`` struct. ``slots`` (1-64) frames can be
+    copied and waiting for the disk at once; a frame that finds none free is
+    dropped from the recording. ``direct`` bypasses the page cache.
+    """
+
+    _fields_: ClassVar = [
+        ("slots", ctypes.c_int32),
+        ("direct", ctypes.c_int32),
+    ]
+
+
+class RecorderStats(ctypes.Structure):
+    """
+    Output recording counters.
+
+    Attributes
+    ----------
+    running : int
+        Non-zero while frames are being recorded.
+    slots : int
+        Frames that can wait for the disk at once.
+    direct : int
+        Non-zero if the page cache is actually bypassed.
+    lastError : int
+        errno of the write that ended the recording, 0 if none.
+    slotBytes : int
+        Largest frame a slot holds.
+    offered, recorded : int
+        Frames that left the library while recording, and frames written.
+    dropped : int
+        Frames that found every slot waiting for the disk.
+    oversized : int
+        Frames larger than a slot.
+    bytesWritten : int
+        File size so far.
+    meanCopyNs, maxCopyNs : int
+        Time recording a frame costs the output thread.
+    meanWriteNs, maxWriteNs : int
+        CRC and write time per frame on the writer thread.
+    """
+
+    _fields_: ClassVar = [
+        ("running", ctypes.c_int32),
+        ("slots", ctypes.c_int32),
+        ("direct", ctypes.c_int32),
+        ("lastError", ctypes.c_int32),
+        ("slotBytes", ctypes.c_int64),
+        ("offered", ctypes.c_int64),
+        ("recorded", ctypes.c_int64),
+        ("dropped", ctypes.c_int64),
+        ("oversized", ctypes.c_int64),
+        ("bytesWritten", ctypes.c_int64),
+        ("meanCopyNs", ctypes.c_int64),
+        ("maxCopyNs", ctypes.c_int64),
+        ("meanWriteNs", ctypes.c_int64),
+        ("maxWriteNs", ctypes.c_int64),
+    ]
+
+
+class RecordingHeader(ctypes.Structure):
+    """
+    Header block of an output recording (see ``read_recording``).
+
+    Mirrors the C++ ``RecordingHeader`` struct. ``pixelFormat`` and
+    ``displayMode`` are the SDK codes when recording started;
+    ``frameIntervalNs`` is the display mode's nominal interval.
+    """
+
+    _fields_: ClassVar = [
+        ("magic", ctypes.c_char * 8),
+        ("version", ctypes.c_uint32),
+        ("align", ctypes.c_uint32),
+        ("recordSize", ctypes.c_uint32),
+        ("displayMode", ctypes.c_uint32),
+        ("pixelFormat", ctypes.c_uint32),
+        ("reserved", ctypes.c_int32),
+        ("frameIntervalNs", ctypes.c_int64),
+        ("startedNs", ctypes.c_int64),
+    ]
+
+
+class RecordedFrame(ctypes.Structure):
+    """
+    Telemetry record written ahead of each recorded frame.
+
+    Attributes
+    ----------
+    sequence : int
+        Frames offered before this one; gaps are frames dropped.
+    timestampNs : int
+        Monotonic time the frame left the library.
+    traceFrameId : int
+        Frame id of the trace span that produced it, 0 if none.
+    frameBytes : int
+        Size of the packed data (``rowBytes * height``).
+    pixelFormat, width, height, rowBytes : int
+        Layout of the packed data.
+    source : int
+        Output path, an index into ``RECORDED_SOURCES``.
+    crc32 : int
+        CRC-32 of the packed data, as ``zlib.crc32`` computes it.
+    metadata : HDRMetadata
+        Metadata sent with the frame.
+    """
+
+    _fields_: ClassVar = [
+        ("sequence", ctypes.c_int64),
+        ("timestampNs", ctypes.c_int64),
+        ("traceFrameId", ctypes.c_int64),
+        ("frameBytes", ctypes.c_int64),
+        ("pixelFormat", ctypes.c_uint32),
+        ("width", ctypes.c_int32),
+        ("height", ctypes.c_int32),
+        ("rowBytes", ctypes.c_int32),
+        ("source", ctypes.c_int32),
+        ("crc32", ctypes.c_uint32),
+        ("metadata", HDRMetadata),
+    ]
+
+
+class FrameStats(ctypes.Structure):
+    """
+    Statistics of the most recently packed frame, gathered while packing.
+
+    Attributes
+    ----------
+    valid : int
+        Non-zero once a frame has been analysed.
+    maxCode : int
+        Largest code value of the pixel format; statistics are code values.
+    width, height : int
+        Frame dimensions.
+    frames : int
+        Frames analysed since statistics were last enabled.
+    mean : ctypes.c_double * 3
+        Per-channel mean code value.
+    min, max : ctypes.c_int32 * 3
+        Per-channel extremes after clamping.
+    clipped : ctypes.c_int64 * 3
+        Per-channel samples above ``maxCode`` (clamped when packed).
+    clippedPixels : int
+        Pixels with at least one clipped sample.
+    apl : float
+        Average picture level: mean luma as a percentage of ``maxCode``
+        (BT.2020 weights for HDR, BT.709 otherwise).
+    maxCLL, maxFALL : float
+        Content and frame-average light level in nits; only set for PQ.
+    pq : int
+        Non-zero if the transfer function was PQ.
+    autoMetadata : int
+        Non-zero if maxCLL/maxFALL were written into the HDR metadata.
+    """
+
+    _fields_: ClassVar = [
+        ("valid", ctypes.c_int32),
+        ("maxCode", ctypes.c_int32),
+        ("width", ctypes.c_int32),
+        ("height", ctypes.c_int32),
+        ("frames", ctypes.c_int64),
+        ("mean", ctypes.c_double * 3),
+        ("min", ctypes.c_int32 * 3),
+        ("max", ctypes.c_int32 * 3),
+        ("clipped", ctypes.c_int64 * 3),
+        ("clippedPixels", ctypes.c_int64),
+        ("apl", ctypes.c_double),
+        ("maxCLL", ctypes.c_double),
+        ("maxFALL", ctypes.c_double),
+        ("pq", ctypes.c_int32),
+        ("autoMetadata", ctypes.c_int32),
+    ]
+
+    def to_dict(self) -> dict[str, Any]:
+        """
+        Convert to a JSON-serialisable dictionary.
+
+        Returns
+        -------
+        dict[str, Any]
+            Field values with arrays as lists; light levels are None unless
+            the transfer function was PQ
+        """
+        pq = bool(self.pq)
+        return {
+            "frames": self.frames,
+            "width": self.width,
+            "height": self.height,
+            "max_code": self.maxCode,
+            "mean": [round(value, 3) for value in self.mean],
+            "min": list(self.min),
+            "max": list(self.max),
+            "clipped": list(self.clipped),
+            "clipped_pixels": self.clippedPixels,
+            "apl": round(self.apl, 3),
+            "max_cll": round(self.maxCLL, 1) if pq else None,
+            "max_fall": round(self.maxFALL, 1) if pq else None,
+            "auto_metadata": bool(self.autoMetadata),
+        }
+
+
+class ThumbnailConfig(ctypes.Structure):
+    """
+    Monitoring thumbnail settings (see ``BMDDeckLink.set_thumbnail``).
+
+    Attributes
+    ----------
+    width : int
+        Thumbnail width in pixels; 0 disables thumbnails.
+    height : int
+        Thumbnail height in pixels; 0 keeps the source aspect ratio.
+    samples : int
+        Source samples per thumbnail pixel along each axis (1-8).
+    intervalMs : int
+        Minimum time between captures while frames are streamed.
+    referenceNits : float
+        PQ light level shown as sRGB white.
+    """
+
+    _fields_: ClassVar = [
+        ("width", ctypes.c_int32),
+        ("height", ctypes.c_int32),
+        ("samples", ctypes.c_int32),
+        ("intervalMs", ctypes.c_int32),
+        ("referenceNits", ctypes.c_float),
+    ]
+
+
+class ThumbnailInfo(ctypes.Structure):
+    """
+    Description of the latest monitoring thumbnail.
+
+    Attributes
+    ----------
+    valid : int
+        Non-zero once a thumbnail has been captured.
+    width, height : int
+        Thumbnail dimensions.
+    sourceWidth, sourceHeight : int
+        Dimensions of the frame it was taken from.
+    pq : int
+        Non-zero if the frame was PQ and was tone mapped for display.
+    sequence : int
+        Increments with every capture; equal numbers mean equal images.
+    capturedNs : int
+        Monotonic capture time in nanoseconds.
+    renderNs : int
+        Time the capture took in nanoseconds.
+    """
+
+    _fields_: ClassVar = [
+        ("valid", ctypes.c_int32),
+        ("width", ctypes.c_int32),
+        ("height", ctypes.c_int32),
+        ("sourceWidth", ctypes.c_int32),
+        ("sourceHeight", ctypes.c_int32),
+        ("pq", ctypes.c_int32),
+        ("sequence", ctypes.c_int64),
+        ("capturedNs", ctypes.c_int64),
+        ("renderNs", ctypes.c_int64),
+    ]
+
+
+class FrameCacheStats(ctypes.Structure):
+    """
+    Packed frame cache occupancy and recall counters.
+
+    Attributes
+    ----------
+    entries : int
+        Frames in the cache.
+    hotEntries, hotCapacity : int
+        Entries currently kept decoded, and the most that are.
+    rawBytes : int
+        Packed size of every entry.
+    compressedBytes : int
+        Memory the entries occupy.
+    hits : int
+        Recalls served by a decoded (hot) frame.
+    misses : int
+        Recalls that decoded an entry.
+    meanDecodeNs, maxDecodeNs : int
+        Time spent decoding an entry, in nanoseconds.
+    """
+
+    _fields_: ClassVar = [
+        ("entries", ctypes.c_int32),
+        ("hotEntries", ctypes.c_int32),
+        ("hotCapacity", ctypes.c_int32),
+        ("reserved", ctypes.c_int32),
+        ("rawBytes", ctypes.c_int64),
+        ("compressedBytes", ctypes.c_int64),
+        ("hits", ctypes.c_int64),
+        ("misses", ctypes.c_int64),
+        ("meanDecodeNs", ctypes.c_int64),
+        ("maxDecodeNs", ctypes.c_int64),
+    ]
+
+
+class PlacementFit(StrEnum):
+    """
+    How a frame is sized on the output raster.
+
+    Attributes
+    ----------
+    NONE : str
+        Pixel for pixel, centered; a larger source is cropped
+    CONTAIN : str
+        Largest size that fits, aspect ratio kept (letterbox or pillarbox)
+    COVER : str
+        Smallest size that fills the raster, aspect ratio kept, overflow
+        cropped
+    STRETCH : str
+        Exactly the raster size
+    INTEGER : str
+        Largest whole multiple of the source size that fits, or the smallest
+        whole divisor for a source larger than the raster
+    """
+
+    NONE = "none"
+    CONTAIN = "contain"
+    COVER = "cover"
+    STRETCH = "stretch"
+    INTEGER = "integer"
+
+    @property
+    def int_value(self) -> int:
+        """Value of the C++ ``PlacementFit`` enum."""
+        return list(PlacementFit).index(self)
+
+
+class PlacementFilter(StrEnum):
+    """
+    Resampling filter of a placed frame.
+
+    Attributes
+    ----------
+    NEAREST : str
+        Nearest source pixel
+    BOX : str
+        Average of the source pixels each output pixel covers; exact for
+        whole-number downscales and pixel-sharp when upscaling
+    BILINEAR : str
+        Linear blend of the four nearest source pixels
+    """
+
+    NEAREST = "nearest"
+    BOX = "box"
+    BILINEAR = "bilinear"
+
+    @property
+    def int_value(self) -> int:
+        """Value of the C++ ``PlacementFilter`` enum."""
+        return list(PlacementFilter).index(self)
+
+
+class PlacementConfig(ctypes.Structure):
+    """
+    Placement of RGB frames on the output raster (see
+    ``BMDDeckLink.set_placement``).
+
+    Attributes
+    ----------
+    enabled : int
+        0 sends frames at their own size.
+    width, height : int
+        Output raster; 0 uses the display mode's size.
+    fit, filter : int
+        ``PlacementFit`` and ``PlacementFilter`` values.
+    cropX, cropY, cropWidth, cropHeight : int
+        Source rectangle to place; a zero width or height places the whole
+        source.
+    surround : array of 3 int
+        Code values shown around the placed image.
+    """
+
+    _fields_: ClassVar = [
+        ("enabled", ctypes.c_int32),
+        ("width", ctypes.c_int32),
+        ("height", ctypes.c_int32),
+        ("fit", ctypes.c_int32),
+        ("filter", ctypes.c_int32),
+        ("cropX", ctypes.c_int32),
+        ("cropY", ctypes.c_int32),
+        ("cropWidth", ctypes.c_int32),
+        ("cropHeight", ctypes.c_int32),
+        ("surround", ctypes.c_uint16 * 3),
+        ("reserved", ctypes.c_uint16),
+    ]
+
+
+class ExternalFrameDesc(ctypes.Structure):
+    """
+    Caller-owned, already packed frame memory.
+
+    Attributes
+    ----------
+    bytes : int
+        Address of the first row.
+    width, height : int
+        Frame dimensions in pixels.
+    rowBytes : int
+        Distance between rows in bytes; at least one row of the format.
+    pixelFormat : int
+        SDK pixel format code of the payload, 0 for the active format.
+    """
+
+    _fields_: ClassVar = [
+        ("bytes", ctypes.c_void_p),
+        ("width", ctypes.c_int32),
+        ("height", ctypes.c_int32),
+        ("rowBytes", ctypes.c_int32),
+        ("pixelFormat", ctypes.c_uint32),
+    ]
+
+
+# Called with the context of an external frame once the library is done with it
+EXTERNAL_RELEASE_FN = ctypes.CFUNCTYPE(None, ctypes.c_void_p)
+
+
+# Video resolution constants for standard formats
+DEFAULT_WIDTH = 1920  # Full HD/4K width
+DEFAULT_HEIGHT = 1080  # Full HD height
+
+# HDR metadata constants following industry standards
+DEFAULT_MAX_CLL = 10000.0  # Maximum Content Light Level (cd/m²)
+DEFAULT_MAX_FALL = 400.0  # Maximum Frame Average Light Level (cd/m²)
+DEFAULT_MAX_DISPLAY_MASTERING_LUMINANCE = 1000.0  # Display mastering luminance (cd/m²)
+DEFAULT_MIN_DISPLAY_MASTERING_LUMINANCE = 0.0001  # Minimum display luminance (cd/m²)
+
+
+@dataclass
+class DecklinkSettings:
+    """
+    Comprehensive configuration settings for DeckLink device initialization and operation.
+
+    This dataclass consolidates all settings required for configuring a DeckLink device
+    including device selection, video resolution, pixel format, region of interest,
+    HDR metadata parameters, and color space information. It provides a unified
+    interface for all DeckLink-related configuration.
+
+    Parameters
+    ----------
+    device : int, optional
+        Index of the DeckLink device to use. Default is 0.
+    pixel_format : PixelFormatType | None, optional
+        Pixel format enum, None for auto-selection. Default is None.
+    auto_pixel_format : bool, optional
+        Select the cheapest-to-pack supported format that keeps at least
+        ``min_bit_depth`` bits, using cached per-host benchmarks. Default is False.
+    min_bit_depth : int, optional
+        Minimum bit depth auto selection must preserve. Default is 10.
+    output_core : int, optional
+        CPU core to pin the output thread to, -1 to leave unpinned. Default is -1.
+    rt_policy : ThreadSchedPolicy, optional
+        Scheduling policy for the output thread. Default is OTHER.
+    rt_priority : int, optional
+        Real-time priority for FIFO/RR (clamped to the OS range). Default is 0.
+    pack_workers : int, optional
+        Extra threads used to pack each frame. Default is 0.
+    pack_core_first : int, optional
+        First core for packing workers, -1 to leave unpinned. Default is -1.
+    lock_memory : bool, optional
+        ``mlock`` the frame pool buffers. Default is False.
+    width : int, optional
+        Frame width in pixels. Default is 1920.
+    height : int, optional
+        Frame height in pixels. Default is 1080.
+    roi_x : int, optional
+        Region of interest X offset. Default is 0.
+    roi_y : int, optional
+        Region of interest Y offset. Default is 0.
+    roi_width : int, optional
+        Region of interest width. Default is 1920.
+    roi_height : int, optional
+        Region of interest height. Default is 1080.
+    no_hdr : bool, optional
+        Whether to disable HDR metadata output. Default is False.
+    eotf : EOTFType, optional
+        Electro-Optical Transfer Function type. Default is PQ (HDR10).
+    max_cll : float, optional
+        Maximum Content Light Level in cd/m². Default is 10000.0.
+    max_fall : float, optional
+        Maximum Frame Average Light Level in cd/m². Default is 400.0.
+    auto_cll : bool, optional
+        Whether to set MaxCLL/MaxFALL from each frame's statistics (PQ only)
+        instead of max_cll/max_fall. Default is False.
+    max_display_mastering_luminance : float, optional
+        Maximum display mastering luminance in cd/m². Default is 1000.0.
+    min_display_mastering_luminance : float, optional
+        Minimum display mastering luminance in cd/m². Default is 0.0001.
+    gamut_chromaticities : Gamut_Chromaticities, optional
+        Complete color gamut definition including red, green, blue primaries
+        and white point chromaticity coordinates. Default is Rec.2020.
+
+    Attributes
+    ----------
+    device : int
+        Index of the DeckLink device to use
+    pixel_format : PixelFormatType | None
+        Pixel format enum, None for auto-selection
+    auto_pixel_format : bool
+        Whether to use cost-model pixel format selection
+    min_bit_depth : int
+        Minimum bit depth auto selection must preserve
+    output_core : int
+        CPU core for the output thread (-1 = unpinned)
+    rt_policy : ThreadSchedPolicy
+        Scheduling policy for the output thread
+    rt_priority : int
+        Real-time priority for FIFO/RR
+    pack_workers : int
+        Extra packing threads
+    pack_core_first : int
+        First core for packing workers (-1 = unpinned)
+    lock_memory : bool
+        Whether frame pool buffers are locked in RAM
+    width : int
+        Frame width in pixels
+    height : int
+        Frame height in pixels
+    roi_x : int
+        Region of interest X offset
+    roi_y : int
+        Region of interest Y offset
+    roi_width : int
+        Region of interest width
+    roi_height : int
+        Region of interest height
+    no_hdr : bool
+        Whether to disable HDR metadata output
+    eotf : EOTFType
+        Electro-Optical Transfer Function type
+    max_cll : float
+        Maximum Content Light Level in cd/m²
+    max_fall : float
+        Maximum Frame Average Light Level in cd/m²
+    auto_cll : bool
+        Whether MaxCLL/MaxFALL are set from each frame's statistics
+    max_display_mastering_luminance : float
+        Maximum display mastering luminance in cd/m²
+    min_display_mastering_luminance : float
+        Minimum display mastering luminance in cd/m²
+    gamut_chromaticities : Gamut_Chromaticities
+        Complete color gamut definition including red, green, blue primaries
+        and white point chromaticity coordinates
+
+    Examples
+    --------
+    Create settings with defaults:
+
+    >>> settings = DecklinkSettings()
+    >>> print(f"Device: {settings.device}, Resolution: {settings.width}x{settings.height}")
+    Device: 0, Resolution: 1920x1080
+
+    Create settings for specific device with custom HDR:
+
+    >>> settings = DecklinkSettings(
+    ...     device=1,
+    ...     width=3840,
+    ...     height=2160,
+    ...     eotf=EOTFType.HLG,
+    ...     max_cll=4000.0
+    ... )
+    >>> print(f"EOTF: {settings.eotf}, Max CLL: {settings.max_cll}")
+    EOTF: HLG, Max CLL: 4000.0
+
+    Create settings with custom ROI:
+
+    >>> settings = DecklinkSettings(
+    ...     roi_x=100,
+    ...     roi_y=100,
+    ...     roi_width=1720,
+    ...     roi_height=880
+    ... )
+    >>> print(f"ROI: {settings.roi_x},{settings.roi_y} {settings.roi_width}x{settings.roi_height}")
+    ROI: 100,100 1720x880
+
+    Notes
+    -----
+    This class consolidates all DeckLink device configuration into a single
+    interface, eliminating the need for multiple settings classes and conversion
+    functions. It supports complete HDR metadata configuration following
+    industry standards (SMPTE ST 2086, CEA-861.3).
+
+    The default color primaries are set to Rec.2020 (ITU-R BT.2020) which is
+    the standard for Ultra HD and HDR content. The default EOTF is PQ
+    (Perceptual Quantizer) as specified in SMPTE ST 2084 for HDR10.
+
+    See Also
+    --------
+    HDRMetadata : HDR metadata structure for device configuration
+    PixelFormatType : Available pixel format options
+    EOTFType : Electro-Optical Transfer Function types
+    """
+
+    # Device parameters
+    device: int = 0
+    pixel_format: PixelFormatType | None = None
+    width: int = DEFAULT_WIDTH
+    height: int = DEFAULT_HEIGHT
+
+    # ROI parameters
+    roi_x: int = 0
+    roi_y: int = 0
+    roi_width: int = DEFAULT_WIDTH
+    roi_height: int = DEFAULT_HEIGHT
+
+    # Cost-model pixel format selection
+    auto_pixel_format: bool = False
+    min_bit_depth: int = 10
+
+    # Thread placement and real-time scheduling
+    output_core: int = -1
+    rt_policy: ThreadSchedPolicy = ThreadSchedPolicy.OTHER
+    rt_priority: int = 0
+    pack_workers: int = 0
+    pack_core_first: int = -1
+    lock_memory: bool = False
+
+    # HDR metadata settings
+    no_hdr: bool = False
+    eotf: EOTFType = EOTFType.PQ
+    max_cll: float = DEFAULT_MAX_CLL
+    max_fall: float = DEFAULT_MAX_FALL
+    auto_cll: bool = False
+    max_display_mastering_luminance: float = DEFAULT_MAX_DISPLAY_MASTERING_LUMINANCE
+    min_display_mastering_luminance: float = DEFAULT_MIN_DISPLAY_MASTERING_LUMINANCE
+
+    # Color space primaries and white point
+    gamut_chromaticities: GamutChromaticities = Gamut_Chromaticities_REC2020
+
+
+def _configure_function_signatures(lib: ctypes.CDLL) -> None:  # noqa: C901
+    """Configure ctypes function signatures for all DeckLink SDK functions.
+
+    Sets up argument types and return types for all C functions in the DeckLink
+    SDK library to ensure proper type safety and memory management when calling
+    from Python.
+
+    Parameters
+    ----------
+    lib : ctypes.CDLL
+        The loaded DeckLink SDK library instance.
+
+    Notes
+    -----
+    This function configures signatures for:
+    - Device enumeration (count, names)
+    - Device management (open, close, start, stop)
+    - Pixel format management
+    - HDR metadata handling
+    - Frame data operations
+    - Version information
+    """
+
+    # Device enumeration functions
+    if hasattr(lib, "decklink_get_device_count"):
+        lib.decklink_get_device_count.argtypes = []
+        lib.decklink_get_device_count.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_get_device_name_by_index"):
+        lib.decklink_get_device_name_by_index.argtypes = [
+            ctypes.c_int,
+            ctypes.c_char_p,
+            ctypes.c_int,
+        ]
+        lib.decklink_get_device_name_by_index.restype = ctypes.c_int
+
+    # Device management functions
+    if hasattr(lib, "decklink_open_output_by_index"):
+        lib.decklink_open_output_by_index.argtypes = [ctypes.c_int]
+        lib.decklink_open_output_by_index.restype = ctypes.c_void_p
+
+    if hasattr(lib, "decklink_close"):
+        lib.decklink_close.argtypes = [ctypes.c_void_p]
+        lib.decklink_close.restype = None
+
+    # Output control functions
+    if hasattr(lib, "decklink_start_output"):
+        lib.decklink_start_output.argtypes = [ctypes.c_void_p]
+        lib.decklink_start_output.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_start_output_with_mode"):
+        lib.decklink_start_output_with_mode.argtypes = [
+            ctypes.c_void_p,
+            ctypes.c_uint32,
+        ]
+        lib.decklink_start_output_with_mode.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_stop_output"):
+        lib.decklink_stop_output.argtypes = [ctypes.c_void_p]
+        lib.decklink_stop_output.restype = ctypes.c_int
+
+    # Pixel format functions
+    if hasattr(lib, "decklink_get_supported_pixel_format_count"):
+        lib.decklink_get_supported_pixel_format_count.argtypes = [ctypes.c_void_p]
+        lib.decklink_get_supported_pixel_format_count.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_get_supported_pixel_format_name"):
+        lib.decklink_get_supported_pixel_format_name.argtypes = [
+            ctypes.c_void_p,
+            ctypes.c_int,
+            ctypes.c_char_p,
+            ctypes.c_int,
+        ]
+        lib.decklink_get_supported_pixel_format_name.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_set_pixel_format"):
+        lib.decklink_set_pixel_format.argtypes = [
+            ctypes.c_void_p,
+            ctypes.c_uint32,
+        ]
+        lib.decklink_set_pixel_format.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_get_pixel_format"):
+        lib.decklink_get_pixel_format.argtypes = [ctypes.c_void_p]
+        lib.decklink_get_pixel_format.restype = ctypes.c_uint32
+
+    # HDR metadata functions
+    if hasattr(lib, "decklink_set_hdr_metadata"):
+        lib.decklink_set_hdr_metadata.argtypes = [
+            ctypes.c_void_p,
+            ctypes.POINTER(HDRMetadata),
+        ]
+        lib.decklink_set_hdr_metadata.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_intern_hdr_metadata"):
+        lib.decklink_intern_hdr_metadata.argtypes = [
+            ctypes.c_void_p,
+            ctypes.POINTER(HDRMetadata),
+        ]
+        lib.decklink_intern_hdr_metadata.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_clear_hdr_metadata_table"):
+        lib.decklink_clear_hdr_metadata_table.argtypes = [ctypes.c_void_p]
+        lib.decklink_clear_hdr_metadata_table.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_get_hdr_metadata_table_stats"):
+        lib.decklink_get_hdr_metadata_table_stats.argtypes = [
+            ctypes.c_void_p,
+            ctypes.POINTER(HDRMetadataTableStats),
+        ]
+        lib.decklink_get_hdr_metadata_table_stats.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_benchmark_pixel_format"):
+        lib.decklink_benchmark_pixel_format.argtypes = [
+            ctypes.c_void_p,
+            ctypes.c_uint32,
+            ctypes.c_int,
+            ctypes.POINTER(ctypes.c_double),
+        ]
+        lib.decklink_benchmark_pixel_format.restype = ctypes.c_int
+
+    # Display mode functions
+    if hasattr(lib, "decklink_get_display_mode"):
+        lib.decklink_get_display_mode.argtypes = [ctypes.c_void_p]
+        lib.decklink_get_display_mode.restype = ctypes.c_uint32
+
+    # In-place reconfiguration functions
+    if hasattr(lib, "decklink_reconfigure"):
+        lib.decklink_reconfigure.argtypes = [
+            ctypes.c_void_p,
+            ctypes.POINTER(OutputConfig),
+        ]
+        lib.decklink_reconfigure.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_get_reconfigure_stats"):
+        lib.decklink_get_reconfigure_stats.argtypes = [
+            ctypes.c_void_p,
+            ctypes.POINTER(ReconfigureStats),
+        ]
+        lib.decklink_get_reconfigure_stats.restype = ctypes.c_int
+
+    # Thread placement and real-time scheduling functions
+    if hasattr(lib, "decklink_set_thread_policy"):
+        lib.decklink_set_thread_policy.argtypes = [
+            ctypes.c_void_p,
+            ctypes.POINTER(ThreadPolicyConfig),
+        ]
+        lib.decklink_set_thread_policy.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_apply_output_thread_policy"):
+        lib.decklink_apply_output_thread_policy.argtypes = [ctypes.c_void_p]
+        lib.decklink_apply_output_thread_policy.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_get_thread_policy_status"):
+        lib.decklink_get_thread_policy_status.argtypes = [
+            ctypes.c_void_p,
+            ctypes.POINTER(ThreadPolicyStatus),
+        ]
+        lib.decklink_get_thread_policy_status.restype = ctypes.c_int
+
+    # Frame timing analysis functions
+    if hasattr(lib, "decklink_get_frame_timing_report"):
+        lib.decklink_get_frame_timing_report.argtypes = [
+            ctypes.c_void_p,
+            ctypes.POINTER(FrameTimingReport),
+        ]
+        lib.decklink_get_frame_timing_report.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_get_frame_timing_outliers"):
+        lib.decklink_get_frame_timing_outliers.argtypes = [
+            ctypes.c_void_p,
+            ctypes.POINTER(FrameTimingOutlier),
+            ctypes.c_int,
+        ]
+        lib.decklink_get_frame_timing_outliers.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_reset_frame_timing"):
+        lib.decklink_reset_frame_timing.argtypes = [ctypes.c_void_p]
+        lib.decklink_reset_frame_timing.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_set_frame_timing_threshold"):
+        lib.decklink_set_frame_timing_threshold.argtypes = [
+            ctypes.c_void_p,
+            ctypes.c_double,
+        ]
+        lib.decklink_set_frame_timing_threshold.restype = ctypes.c_int
+
+    # Memory accounting functions
+    if hasattr(lib, "decklink_get_memory_stats"):
+        lib.decklink_get_memory_stats.argtypes = [
+            ctypes.POINTER(MemoryStats),
+            ctypes.c_int,
+        ]
+        lib.decklink_get_memory_stats.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_reset_memory_peaks"):
+        lib.decklink_reset_memory_peaks.argtypes = []
+        lib.decklink_reset_memory_peaks.restype = ctypes.c_int
+
+    # Span tracing functions
+    if hasattr(lib, "decklink_trace_set_enabled"):
+        lib.decklink_trace_set_enabled.argtypes = [ctypes.c_bool]
+        lib.decklink_trace_set_enabled.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_trace_now_ns"):
+        lib.decklink_trace_now_ns.argtypes = []
+        lib.decklink_trace_now_ns.restype = ctypes.c_int64
+
+    if hasattr(lib, "decklink_trace_set_frame"):
+        lib.decklink_trace_set_frame.argtypes = [ctypes.c_int64]
+        lib.decklink_trace_set_frame.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_trace_collect"):
+        lib.decklink_trace_collect.argtypes = [
+            ctypes.POINTER(TraceSpan),
+            ctypes.c_int,
+        ]
+        lib.decklink_trace_collect.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_trace_get_threads"):
+        lib.decklink_trace_get_threads.argtypes = [
+            ctypes.POINTER(TraceThread),
+            ctypes.c_int,
+        ]
+        lib.decklink_trace_get_threads.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_trace_get_stats"):
+        lib.decklink_trace_get_stats.argtypes = [ctypes.POINTER(TraceStats)]
+        lib.decklink_trace_get_stats.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_add_overlay"):
+        lib.decklink_add_overlay.argtypes = [
+            ctypes.c_void_p,
+            ctypes.c_int,
+            ctypes.c_int,
+            ctypes.c_int,
+            ctypes.c_int,
+            ctypes.POINTER(ctypes.c_uint16),
+            ctypes.c_bool,
+        ]
+        lib.decklink_add_overlay.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_remove_overlay"):
+        lib.decklink_remove_overlay.argtypes = [ctypes.c_void_p, ctypes.c_int]
+        lib.decklink_remove_overlay.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_set_overlay_enabled"):
+        lib.decklink_set_overlay_enabled.argtypes = [
+            ctypes.c_void_p,
+            ctypes.c_int,
+            ctypes.c_bool,
+        ]
+        lib.decklink_set_overlay_enabled.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_move_overlay"):
+        lib.decklink_move_overlay.argtypes = [
+            ctypes.c_void_p,
+            ctypes.c_int,
+            ctypes.c_int,
+            ctypes.c_int,
+        ]
+        lib.decklink_move_overlay.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_clear_overlays"):
+        lib.decklink_clear_overlays.argtypes = [ctypes.c_void_p]
+        lib.decklink_clear_overlays.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_update_overlays"):
+        lib.decklink_update_overlays.argtypes = [ctypes.c_void_p]
+        lib.decklink_update_overlays.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_set_pipelined_output"):
+        lib.decklink_set_pipelined_output.argtypes = [ctypes.c_void_p, ctypes.c_bool]
+        lib.decklink_set_pipelined_output.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_submit_frame"):
+        lib.decklink_submit_frame.argtypes = [
+            ctypes.c_void_p,
+            ctypes.POINTER(ctypes.c_uint16),
+            ctypes.c_int,
+            ctypes.c_int,
+        ]
+        lib.decklink_submit_frame.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_flush_output"):
+        lib.decklink_flush_output.argtypes = [ctypes.c_void_p]
+        lib.decklink_flush_output.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_get_pipeline_stats"):
+        lib.decklink_get_pipeline_stats.argtypes = [
+            ctypes.c_void_p,
+            ctypes.POINTER(PipelineStats),
+        ]
+        lib.decklink_get_pipeline_stats.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_start_frc"):
+        lib.decklink_start_frc.argtypes = [
+            ctypes.c_void_p,
+            ctypes.POINTER(FrcConfig),
+        ]
+        lib.decklink_start_frc.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_stop_frc"):
+        lib.decklink_stop_frc.argtypes = [ctypes.c_void_p]
+        lib.decklink_stop_frc.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_get_frc_status"):
+        lib.decklink_get_frc_status.argtypes = [
+            ctypes.c_void_p,
+            ctypes.POINTER(FrcStatus),
+        ]
+        lib.decklink_get_frc_status.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_plan_frc"):
+        lib.decklink_plan_frc.argtypes = [
+            ctypes.POINTER(FrcConfig),
+            ctypes.c_int,
+            ctypes.POINTER(FrcStatus),
+            ctypes.POINTER(ctypes.c_uint8),
+        ]
+        lib.decklink_plan_frc.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_start_scheduler"):
+        lib.decklink_start_scheduler.argtypes = [
+            ctypes.c_void_p,
+            ctypes.POINTER(SchedulerConfig),
+        ]
+        lib.decklink_start_scheduler.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_stop_scheduler"):
+        lib.decklink_stop_scheduler.argtypes = [ctypes.c_void_p]
+        lib.decklink_stop_scheduler.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_schedule_frame"):
+        lib.decklink_schedule_frame.argtypes = [
+            ctypes.c_void_p,
+            ctypes.POINTER(ctypes.c_uint16),
+            ctypes.c_int,
+            ctypes.c_int,
+            ctypes.c_int64,
+            ctypes.c_int32,
+            ctypes.POINTER(SchedulerDecisionRecord),
+        ]
+        lib.decklink_schedule_frame.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_schedule_frame_hdr"):
+        lib.decklink_schedule_frame_hdr.argtypes = [
+            ctypes.c_void_p,
+            ctypes.POINTER(ctypes.c_uint16),
+            ctypes.c_int,
+            ctypes.c_int,
+            ctypes.c_int64,
+            ctypes.c_int32,
+            ctypes.c_int32,
+            ctypes.POINTER(SchedulerDecisionRecord),
+        ]
+        lib.decklink_schedule_frame_hdr.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_get_scheduler_stats"):
+        lib.decklink_get_scheduler_stats.argtypes = [
+            ctypes.c_void_p,
+            ctypes.POINTER(SchedulerStats),
+        ]
+        lib.decklink_get_scheduler_stats.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_get_scheduler_decisions"):
+        lib.decklink_get_scheduler_decisions.argtypes = [
+            ctypes.c_void_p,
+            ctypes.POINTER(SchedulerDecisionRecord),
+            ctypes.c_int,
+        ]
+        lib.decklink_get_scheduler_decisions.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_get_scheduler_lead_changes"):
+        lib.decklink_get_scheduler_lead_changes.argtypes = [
+            ctypes.c_void_p,
+            ctypes.POINTER(SchedulerLeadChange),
+            ctypes.c_int,
+        ]
+        lib.decklink_get_scheduler_lead_changes.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_start_stream"):
+        lib.decklink_start_stream.argtypes = [
+            ctypes.c_void_p,
+            ctypes.POINTER(StreamConfig),
+        ]
+        lib.decklink_start_stream.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_stop_stream"):
+        lib.decklink_stop_stream.argtypes = [ctypes.c_void_p]
+        lib.decklink_stop_stream.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_get_stream_stats"):
+        lib.decklink_get_stream_stats.argtypes = [
+            ctypes.c_void_p,
+            ctypes.POINTER(StreamStats),
+        ]
+        lib.decklink_get_stream_stats.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_start_recording"):
+        lib.decklink_start_recording.argtypes = [
+            ctypes.c_void_p,
+            ctypes.c_char_p,
+            ctypes.POINTER(RecorderConfig),
+        ]
+        lib.decklink_start_recording.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_stop_recording"):
+        lib.decklink_stop_recording.argtypes = [ctypes.c_void_p]
+        lib.decklink_stop_recording.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_get_recorder_stats"):
+        lib.decklink_get_recorder_stats.argtypes = [
+            ctypes.c_void_p,
+            ctypes.POINTER(RecorderStats),
+        ]
+        lib.decklink_get_recorder_stats.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_play_recording"):
+        lib.decklink_play_recording.argtypes = [ctypes.c_void_p, ctypes.c_char_p]
+        lib.decklink_play_recording.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_stop_replay"):
+        lib.decklink_stop_replay.argtypes = [ctypes.c_void_p]
+        lib.decklink_stop_replay.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_get_replay_stats"):
+        lib.decklink_get_replay_stats.argtypes = [
+            ctypes.c_void_p,
+            ctypes.POINTER(ClipPlaybackStats),
+        ]
+        lib.decklink_get_replay_stats.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_recorder_create"):
+        lib.decklink_recorder_create.argtypes = []
+        lib.decklink_recorder_create.restype = ctypes.c_void_p
+
+    if hasattr(lib, "decklink_recorder_destroy"):
+        lib.decklink_recorder_destroy.argtypes = [ctypes.c_void_p]
+        lib.decklink_recorder_destroy.restype = None
+
+    if hasattr(lib, "decklink_recorder_start"):
+        lib.decklink_recorder_start.argtypes = [
+            ctypes.c_void_p,
+            ctypes.c_char_p,
+            ctypes.POINTER(RecorderConfig),
+            ctypes.c_int64,
+            ctypes.c_uint32,
+            ctypes.c_uint32,
+            ctypes.c_int64,
+        ]
+        lib.decklink_recorder_start.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_recorder_record"):
+        lib.decklink_recorder_record.argtypes = [
+            ctypes.c_void_p,
+            ctypes.c_void_p,
+            ctypes.POINTER(RecordedFrame),
+        ]
+        lib.decklink_recorder_record.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_recorder_stop"):
+        lib.decklink_recorder_stop.argtypes = [ctypes.c_void_p]
+        lib.decklink_recorder_stop.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_recorder_get_stats"):
+        lib.decklink_recorder_get_stats.argtypes = [
+            ctypes.c_void_p,
+            ctypes.POINTER(RecorderStats),
+        ]
+        lib.decklink_recorder_get_stats.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_plan_replay"):
+        lib.decklink_plan_replay.argtypes = [
+            ctypes.c_char_p,
+            ctypes.c_uint32,
+            ctypes.c_int64,
+            ctypes.POINTER(ctypes.c_int32),
+            ctypes.POINTER(ctypes.c_uint16),
+            ctypes.c_int,
+        ]
+        lib.decklink_plan_replay.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_set_frame_stats"):
+        lib.decklink_set_frame_stats.argtypes = [ctypes.c_void_p, ctypes.c_int]
+        lib.decklink_set_frame_stats.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_get_frame_stats"):
+        lib.decklink_get_frame_stats.argtypes = [
+            ctypes.c_void_p,
+            ctypes.POINTER(FrameStats),
+        ]
+        lib.decklink_get_frame_stats.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_display_external_frame"):
+        lib.decklink_display_external_frame.argtypes = [
+            ctypes.c_void_p,
+            ctypes.POINTER(ExternalFrameDesc),
+            EXTERNAL_RELEASE_FN,
+            ctypes.c_void_p,
+        ]
+        lib.decklink_display_external_frame.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_schedule_external_frame"):
+        lib.decklink_schedule_external_frame.argtypes = [
+            ctypes.c_void_p,
+            ctypes.POINTER(ExternalFrameDesc),
+            EXTERNAL_RELEASE_FN,
+            ctypes.c_void_p,
+            ctypes.c_int64,
+            ctypes.c_int32,
+            ctypes.POINTER(SchedulerDecisionRecord),
+        ]
+        lib.decklink_schedule_external_frame.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_schedule_external_frame_hdr"):
+        lib.decklink_schedule_external_frame_hdr.argtypes = [
+            ctypes.c_void_p,
+            ctypes.POINTER(ExternalFrameDesc),
+            EXTERNAL_RELEASE_FN,
+            ctypes.c_void_p,
+            ctypes.c_int64,
+            ctypes.c_int32,
+            ctypes.c_int32,
+            ctypes.POINTER(SchedulerDecisionRecord),
+        ]
+        lib.decklink_schedule_external_frame_hdr.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_set_placement"):
+        lib.decklink_set_placement.argtypes = [
+            ctypes.c_void_p,
+            ctypes.POINTER(PlacementConfig),
+        ]
+        lib.decklink_set_placement.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_get_placement"):
+        lib.decklink_get_placement.argtypes = [
+            ctypes.c_void_p,
+            ctypes.POINTER(PlacementConfig),
+        ]
+        lib.decklink_get_placement.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_set_thumbnail_config"):
+        lib.decklink_set_thumbnail_config.argtypes = [
+            ctypes.c_void_p,
+            ctypes.POINTER(ThumbnailConfig),
+        ]
+        lib.decklink_set_thumbnail_config.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_get_thumbnail_config"):
+        lib.decklink_get_thumbnail_config.argtypes = [
+            ctypes.c_void_p,
+            ctypes.POINTER(ThumbnailConfig),
+        ]
+        lib.decklink_get_thumbnail_config.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_get_thumbnail"):
+        lib.decklink_get_thumbnail.argtypes = [
+            ctypes.c_void_p,
+            ctypes.POINTER(ctypes.c_uint8),
+            ctypes.c_int,
+            ctypes.POINTER(ThumbnailInfo),
+        ]
+        lib.decklink_get_thumbnail.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_cache_frame"):
+        lib.decklink_cache_frame.argtypes = [
+            ctypes.c_void_p,
+            ctypes.c_int64,
+            ctypes.POINTER(ctypes.c_uint16),
+            ctypes.c_int,
+            ctypes.c_int,
+        ]
+        lib.decklink_cache_frame.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_cache_packed_frame"):
+        lib.decklink_cache_packed_frame.argtypes = [
+            ctypes.c_void_p,
+            ctypes.c_int64,
+            ctypes.POINTER(ExternalFrameDesc),
+        ]
+        lib.decklink_cache_packed_frame.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_display_cached_frame"):
+        lib.decklink_display_cached_frame.argtypes = [ctypes.c_void_p, ctypes.c_int64]
+        lib.decklink_display_cached_frame.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_schedule_cached_frame"):
+        lib.decklink_schedule_cached_frame.argtypes = [
+            ctypes.c_void_p,
+            ctypes.c_int64,
+            ctypes.c_int64,
+            ctypes.c_int32,
+            ctypes.POINTER(SchedulerDecisionRecord),
+        ]
+        lib.decklink_schedule_cached_frame.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_schedule_cached_frame_hdr"):
+        lib.decklink_schedule_cached_frame_hdr.argtypes = [
+            ctypes.c_void_p,
+            ctypes.c_int64,
+            ctypes.c_int64,
+            ctypes.c_int32,
+            ctypes.c_int32,
+            ctypes.POINTER(SchedulerDecisionRecord),
+        ]
+        lib.decklink_schedule_cached_frame_hdr.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_remove_cached_frame"):
+        lib.decklink_remove_cached_frame.argtypes = [ctypes.c_void_p, ctypes.c_int64]
+        lib.decklink_remove_cached_frame.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_clear_frame_cache"):
+        lib.decklink_clear_frame_cache.argtypes = [ctypes.c_void_p]
+        lib.decklink_clear_frame_cache.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_set_frame_cache_hot_frames"):
+        lib.decklink_set_frame_cache_hot_frames.argtypes = [
+            ctypes.c_void_p,
+            ctypes.c_int,
+        ]
+        lib.decklink_set_frame_cache_hot_frames.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_get_frame_cache_stats"):
+        lib.decklink_get_frame_cache_stats.argtypes = [
+            ctypes.c_void_p,
+            ctypes.POINTER(FrameCacheStats),
+        ]
+        lib.decklink_get_frame_cache_stats.restype = ctypes.c_int
+
+    # Frame data management functions
+    if hasattr(lib, "decklink_set_frame_data"):
+        lib.decklink_set_frame_data.argtypes = [
+            ctypes.c_void_p,
+            ctypes.POINTER(ctypes.c_uint16),
+            ctypes.c_int,
+            ctypes.c_int,
+        ]
+        lib.decklink_set_frame_data.restype = ctypes.c_int
+
+    # Frame management functions
+    if hasattr(lib, "decklink_create_frame_from_data"):
+        lib.decklink_create_frame_from_data.argtypes = [ctypes.c_void_p]
+        lib.decklink_create_frame_from_data.restype = ctypes.c_int
+
+    # Synchronous display function
+    if hasattr(lib, "decklink_display_frame_sync"):
+        lib.decklink_display_frame_sync.argtypes = [ctypes.c_void_p]
+        lib.decklink_display_frame_sync.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_update_frame_regions"):
+        lib.decklink_update_frame_regions.argtypes = [
+            ctypes.c_void_p,
+            ctypes.POINTER(ctypes.c_uint16),
+            ctypes.c_int,
+            ctypes.c_int,
+            ctypes.POINTER(FrameRegion),
+            ctypes.c_int,
+        ]
+        lib.decklink_update_frame_regions.restype = ctypes.c_int
+
+    # HDR capability detection functions
+    if hasattr(lib, "decklink_device_supports_hdr"):
+        lib.decklink_device_supports_hdr.argtypes = [ctypes.c_void_p]
+        lib.decklink_device_supports_hdr.restype = ctypes.c_bool
+
+    # Version info functions
+    if hasattr(lib, "decklink_get_driver_version"):
+        lib.decklink_get_driver_version.argtypes = []
+        lib.decklink_get_driver_version.restype = ctypes.c_char_p
+
+    if hasattr(lib, "decklink_get_sdk_version"):
+        lib.decklink_get_sdk_version.argtypes = []
+        lib.decklink_get_sdk_version.restype = ctypes.c_char_p
+
+
+def _try_load_decklink_sdk() -> ctypes.CDLL:
+    """Load the DeckLink SDK library and configure function signatures.
+
+    Attempts to load the compiled libdecklink.dylib from the same directory
+    as this Python module, then configures all ctypes function signatures
+    for type safety.
+
+    Returns
+    -------
+    ctypes.CDLL
+        The loaded and configured DeckLink SDK library instance.
+
+    Raises
+    ------
+    FileNotFoundError
+        If libdecklink.dylib cannot be found in the expected location.
+    OSError
+        If the library exists but cannot be loaded (e.g., architecture mismatch,
+        missing dependencies, or permission issues).
+
+    Notes
+    -----
+    The library file must be built from the C++ source in the cpp/ directory
+    and placed in the same directory as this module.
+    """
+    lib_path = Path(__file__).parent.joinpath("libdecklink.dylib")
+    try:
+        # Try to load from the lib directory relative to this script
+        if lib_path.exists() and lib_path.is_file():
+            decklink_lib = ctypes.CDLL(lib_path)
+        else:
+            raise FileNotFoundError(
+                f"Could not find libdecklink.dylib in Python project: {lib_path.absolute()}"
+            )
+    except OSError as error:
+        raise OSError(
+            f"Failed to load DeckLink library from {lib_path.absolute()}"
+        ) from error
+
+    # Configure all function signatures
+    _configure_function_signatures(decklink_lib)
+
+    return decklink_lib
+
+
+DecklinkSDKWrapper: ctypes.CDLL = _try_load_decklink_sdk()
+
+
+def get_decklink_driver_version() -> str:
+    """
+    Get the DeckLink driver version string.
+
+    Returns
+    -------
+    str
+        The version string of the installed DeckLink driver.
+
+    Examples
+    --------
+    >>> version = get_decklink_driver_version()
+    >>> print(f"Driver version: {version}")
+    Driver version: 12.8.1
+
+    Notes
+    -----
+    Requires DeckLink Desktop Video drivers to be installed.
+    """
+    return DecklinkSDKWrapper.decklink_get_driver_version().decode("utf-8")
+
+
+def get_decklink_sdk_version() -> str:
+    """
+    Get the DeckLink SDK version string.
+
+    Returns
+    -------
+    str
+        The version string of the DeckLink SDK library.
+
+    Examples
+    --------
+    >>> version = get_decklink_sdk_version()
+    >>> print(f"SDK version: {version}")
+    SDK version: 15.3.0
+
+    Notes
+    -----
+    This returns the version of the compiled libdecklink.dylib library.
+    """
+    return DecklinkSDKWrapper.decklink_get_sdk_version().decode("utf-8")
+
+
+def ndarray_to_bmd_frame_buffer(
+    frame_data: np.ndarray,
+) -> tuple[Any, int, int]:
+    """
+    Convert numpy array to BMD-compatible frame buffer.
+
+    Parameters
+    ----------
+    frame_data : numpy.ndarray
+        Frame data with shape (height, width, channels) or (height, width)
+
+    Returns
+    -------
+    tuple[ctypes.POINTER(ctypes.c_uint16), int, int]
+        Tuple containing (data_ptr, width, height)
+
+    Raises
+    ------
+    ValueError
+        If frame_data is not a valid numpy array or has invalid dimensions
+    """
+    if not isinstance(frame_data, np.ndarray):
+        raise ValueError("frame_data must be a numpy array")
+
+    # Get dimensions
+    if frame_data.ndim == 2:
+        height, width = frame_data.shape
+    elif frame_data.ndim == 3:
+        height, width, _ = frame_data.shape
+    else:
+        raise ValueError("frame_data must be 2D or 3D array")
+
+    # Note: frame_data should already be uint16 and contiguous
+    # These conversions are handled in display_frame() before calling this function
+
+    # Get pointer to data
+    data_ptr = frame_data.ctypes.data_as(ctypes.POINTER(ctypes.c_uint16))
+    return data_ptr, height, width
+
+
+def packed_frame_desc(
+    data: np.ndarray, width: int, pixel_format: PixelFormatType | None = None
+) -> ExternalFrameDesc:
+    """
+    Describe an already packed frame held in a numpy array.
+
+    Parameters
+    ----------
+    data : numpy.ndarray
+        uint8 array of shape (height, row_bytes) whose rows are contiguous;
+        rows may be further apart than their length (a slice of a wider
+        buffer)
+    width : int
+        Frame width in pixels
+    pixel_format : PixelFormatType | None, optional
+        Format of the payload; None for the device's active format
+
+    Returns
+    -------
+    ExternalFrameDesc
+        Description pointing at the array's memory
+
+    Raises
+    ------
+    ValueError
+        If data is not a 2D uint8 array with contiguous rows or width is not
+        positive
+    """
+    if not isinstance(data, np.ndarray) or data.dtype != np.uint8:
+        raise ValueError("packed frame must be a uint8 numpy array")
+    if data.ndim != 2 or data.strides[1] != 1 or data.strides[0] < data.shape[1]:
+        raise ValueError("packed frame must be 2D (height, row_bytes), rows contiguous")
+    if width <= 0 or data.shape[0] == 0:
+        raise ValueError("packed frame must not be empty")
+    return ExternalFrameDesc(
+        bytes=data.ctypes.data,
+        width=width,
+        height=data.shape[0],
+        rowBytes=data.strides[0],
+        pixelFormat=pixel_format.sdk_format_code if pixel_format else 0,
+    )
+
+
+def plan_frc(
+    target: Sequence[float], cycle_frames: int, max_code: int
+) -> tuple[FrcStatus, np.ndarray]:
+    """
+    Lay out a temporal dithering cycle the way ``BMDDeckLink.start_frc`` does.
+
+    Runs the library's own duty split and frame spread without a device.
+
+    Parameters
+    ----------
+    target : Sequence[float]
+        Fractional R, G, B code values
+    cycle_frames : int
+        Frames per dither cycle (1-64)
+    max_code : int
+        Largest code value of the output bit depth
+
+    Returns
+    -------
+    tuple[FrcStatus, numpy.ndarray]
+        The levels (playback counters zero) and a (cycle_frames, 3) array of
+        0 and 1, 1 where a channel shows its upper code value on that frame
+
+    Raises
+    ------
+    ValueError
+        If ``target`` does not have three non-negative values or
+        ``cycle_frames`` is outside 1-64
+    """
+    if len(target) != 3:
+        raise ValueError("target must be three non-negative code values")
+    config = FrcConfig(cycleFrames=cycle_frames)
+    config.target[:] = [float(value) for value in target]
+    status = FrcStatus()
+    upper = np.zeros(max(cycle_frames, 0), dtype=np.uint8)
+    res = DecklinkSDKWrapper.decklink_plan_frc(
+        ctypes.byref(config),
+        max_code,
+        ctypes.byref(status),
+        upper.ctypes.data_as(ctypes.POINTER(ctypes.c_uint8)),
+    )
+    if res != 0:
+        raise ValueError(
+            "target must be three non-negative code values and cycle_frames 1-64"
+        )
+    channels = (upper[:, None] >> np.arange(3)) & 1
+    return status, channels
+
+
+def read_recording(
+    path: str | Path, verify: bool = True
+) -> Iterator[tuple[RecordedFrame, bytes]]:
+    """
+    Read the frames of an output recording.
+
+    Parameters
+    ----------
+    path : str | Path
+        File written by ``BMDDeckLink.start_recording``
+    verify : bool, optional
+        Check each frame against its CRC. Default is True.
+
+    Yields
+    ------
+    tuple[RecordedFrame, bytes]
+        Each frame's record and its packed data, in recording order
+
+    Raises
+    ------
+    ValueError
+        If the file is not a recording, is truncated or a frame does not
+        match its CRC
+    """
+    with open(path, "rb") as f:
+        header = RecordingHeader.from_buffer_copy(
+            f.read(ctypes.sizeof(RecordingHeader)).ljust(
+                ctypes.sizeof(RecordingHeader), b"\0"
+            )
+        )
+        if (
+            header.magic != RECORDING_MAGIC.rstrip(b"\0")
+            or header.version != RECORDING_VERSION
+            or header.recordSize != ctypes.sizeof(RecordedFrame)
+            or header.align < ctypes.sizeof(RecordedFrame)
+        ):
+            raise ValueError(f"{path} is not a recording this version can read")
+        align = header.align
+        f.seek(align)
+        while block := f.read(align):
+            if len(block) < align:
+                raise ValueError(f"{path} ends inside a frame record")
+            frame = RecordedFrame.from_buffer_copy(block)
+            padded = -(-frame.frameBytes // align) * align
+            data = f.read(padded)
+            if len(data) < padded:
+                raise ValueError(f"{path} ends inside frame {frame.sequence}")
+            data = data[: frame.frameBytes]
+            if verify and zlib.crc32(data) != frame.crc32:
+                raise ValueError(f"Frame {frame.sequence} fails its CRC check")
+            yield frame, data
+
+
+class RecordingWriter:
+    """
+    Records frames the caller provides with the library's recorder.
+
+    Writes the same file ``BMDDeckLink.start_recording`` does, through the
+    same slots and writer thread, without a device. Frames are recorded as
+    the bytes given, whatever their layout.
+
+    Parameters
+    ----------
+    path : str | Path
+        File to create, replaced if it exists
+    display_mode, pixel_format : int
+        SDK codes written to the header
+    frame_interval_ns : int
+        Nominal frame interval written to the header
+    max_frame_bytes : int
+        Largest frame a slot holds; larger frames are counted as oversized
+    slots : int, optional
+        Frames that can wait for the disk at once (1-64). Default is 8.
+    direct : bool, optional
+        Bypass the page cache where the file system allows it. Default is
+        True.
+
+    Raises
+    ------
+    RuntimeError
+        If the settings are invalid or the file cannot be created
+    """
+
+    def __init__(
+        self,
+        path: str | Path,
+        display_mode: int,
+        pixel_format: int,
+        frame_interval_ns: int,
+        max_frame_bytes: int,
+        slots: int = 8,
+        direct: bool = True,
+    ) -> None:
+        self._recorder = DecklinkSDKWrapper.decklink_recorder_create()
+        config = RecorderConfig(slots, int(direct))
+        res = DecklinkSDKWrapper.decklink_recorder_start(
+            self._recorder,
+            str(path).encode("utf-8"),
+            ctypes.byref(config),
+            max_frame_bytes,
+            display_mode,
+            pixel_format,
+            frame_interval_ns,
+        )
+        if res != 0:
+            DecklinkSDKWrapper.decklink_recorder_destroy(self._recorder)
+            self._recorder = None
+            raise RuntimeError(f"Failed to start recording (error {res})")
+
+    def record(self, data: bytes, frame: RecordedFrame) -> None:
+        """
+        Copy a frame to be written, or count it as dropped.
+
+        Parameters
+        ----------
+        data : bytes
+            Frame data, ``frame.frameBytes`` long
+        frame : RecordedFrame
+            Record written ahead of the data; its ``sequence`` and ``crc32``
+            are filled in by the library
+
+        Raises
+        ------
+        RuntimeError
+            If the recording is closed
+        ValueError
+            If ``data`` is not ``frame.frameBytes`` long or is empty
+        """
+        if self._recorder is None:
+            raise RuntimeError("Recording is closed")
+        if len(data) != frame.frameBytes or not data:
+            raise ValueError("data must be frame.frameBytes long")
+        DecklinkSDKWrapper.decklink_recorder_record(
+            self._recorder, data, ctypes.byref(frame)
+        )
+
+    def stats(self) -> RecorderStats:
+        """
+        Get the counters of the recording.
+
+        Returns
+        -------
+        RecorderStats
+            Frames recorded and dropped, and copy and write times
+        """
+        stats = RecorderStats()
+        if self._recorder is not None:
+            DecklinkSDKWrapper.decklink_recorder_get_stats(
+                self._recorder, ctypes.byref(stats)
+            )
+        return stats
+
+    def close(self) -> RecorderStats:
+        """
+        Write the frames already copied and close the file.
+
+        Returns
+        -------
+        RecorderStats
+            Final counters of the recording
+        """
+        if self._recorder is None:
+            return RecorderStats()
+        DecklinkSDKWrapper.decklink_recorder_stop(self._recorder)
+        stats = self.stats()
+        DecklinkSDKWrapper.decklink_recorder_destroy(self._recorder)
+        self._recorder = None
+        return stats
+
+
+def plan_replay(
+    path: str | Path, pixel_format: int, frame_interval_ns: int
+) -> np.ndarray:
+    """
+    Lay out the replay of a recording the way ``play_recording`` does.
+
+    Runs the library's own reading, CRC check, dedupe and hold rules without
+    a device.
+
+    Parameters
+    ----------
+    path : str | Path
+        Recording to read
+    pixel_format : int
+        SDK code every frame must have been recorded in
+    frame_interval_ns : int
+        Frame interval of the replay
+
+    Returns
+    -------
+    numpy.ndarray
+        uint16 index of the distinct frame shown in each frame duration of one
+        loop; distinct frames are numbered in order of first appearance
+
+    Raises
+    ------
+    ValueError
+        If the recording cannot be replayed; the message holds the
+        ``play_recording`` error code
+    """
+    encoded = str(path).encode("utf-8")
+    frames = ctypes.c_int32()
+    count = DecklinkSDKWrapper.decklink_plan_replay(
+        encoded, pixel_format, frame_interval_ns, ctypes.byref(frames), None, 0
+    )
+    if count < 0:
+        raise ValueError(f"Cannot replay {path} (error {count})")
+    sequence = np.zeros(count, dtype=np.uint16)
+    DecklinkSDKWrapper.decklink_plan_replay(
+        encoded,
+        pixel_format,
+        frame_interval_ns,
+        ctypes.byref(frames),
+        sequence.ctypes.data_as(ctypes.POINTER(ctypes.c_uint16)),
+        count,
+    )
+    return sequence
+
+
+def get_decklink_devices() -> list[str]:
+    """
+    Get list of available DeckLink device names.
+
+    Returns
+    -------
+    list[str]
+        List of device names for all detected DeckLink devices.
+        Returns empty list if no devices are found.
+
+    Examples
+    --------
+    >>> devices = get_decklink_devices()
+    >>> print(f"Found {len(devices)} devices")
+    Found 2 devices
+    >>> for i, device in enumerate(devices):
+    ...     print(f"Device {i}: {device}")
+    Device 0: DeckLink Mini Monitor 4K
+    Device 1: DeckLink Studio 4K
+
+    Notes
+    -----
+    Devices are returned in the order they are detected by the system.
+    The index corresponds to the device_index parameter used in BMDDeckLink.
+    """
+    count = DecklinkSDKWrapper.decklink_get_device_count()
+    devices = []
+    for i in range(count):
+        name = ctypes.create_string_buffer(256)
+        if DecklinkSDKWrapper.decklink_get_device_name_by_index(i, name, 256) == 0:
+            devices.append(name.value.decode("utf-8"))
+    return devices
+
+
+class BMDDeckLink:
+    """
+    RAII wrapper for DeckLink device management.
+
+    This class provides Resource Acquisition Is Initialization (RAII) semantics
+    for DeckLink devices, ensuring proper cleanup when the object is destroyed.
+    The device is opened on initialization and automatically closed on destruction.
+
+    Parameters
+    ----------
+    device_index : int, optional
+        Index of the DeckLink device to open. Default is 0.
+
+    Attributes
+    ----------
+    handle : ctypes.c_void_p or None
+        Handle to the opened DeckLink device
+    device_index : int
+        Index of the device that was opened
+    _output_started : bool
+        Internal flag tracking output state
+
+    Examples
+    --------
+    Context manager usage (recommended):
+
+    >>> with BMDDeckLink(device_index=0) as device:
+    ...     device.start_playback()
+    ...     # Device automatically closed when exiting the with block
+
+    Basic usage with automatic cleanup:
+
+    >>> device = BMDDeckLink(device_index=0)
+    >>> device.start_playback()
+    >>> # Device automatically closed when object goes out of scope
+
+    Manual cleanup if needed:
+
+    >>> device = BMDDeckLink(device_index=0)
+    >>> device.start_playback()
+    >>> device.close()  # Explicit cleanup
+
+    Raises
+    ------
     RuntimeError
         If no DeckLink device is found at the specified index
 
-    Notes
-    -----
-    The device is automatically closed when the object is destroyed via __del__.
-    For guaranteed cleanup timing, use the close() method explicitly.
-    """
+    Notes
+    -----
+    The device is automatically closed when the object is destroyed via __del__.
+    For guaranteed cleanup timing, use the close() method explicitly.
+    """
+
+    def __init__(self, device_index: int = 0) -> None:
+        self.device_index = device_index
+        self.handle = DecklinkSDKWrapper.decklink_open_output_by_index(device_index)
+        if not self.handle:
+            raise RuntimeError(
+                f"No DeckLink output device found at index {device_index}"
+            )
+        self.started = False
+        self.pipelined = False
+        # Packed arrays the library still references, by release token
+        self._packed_frames: dict[int, np.ndarray] = {}
+        self._packed_lock = threading.Lock()
+        self._packed_tokens = itertools.count(1)
+        frames, lock = self._packed_frames, self._packed_lock
+
+        def release(token: int | None) -> None:
+            with lock:
+                frames.pop(token or 0, None)
+
+        self._release_packed = EXTERNAL_RELEASE_FN(release)
+
+    def __del__(self) -> None:
+        """Destructor - automatically close device on object destruction."""
+        self.close()
+
+    def __enter__(self) -> Self:
+        """
+        Enter the context manager.
+
+        Returns
+        -------
+        Self
+            The BMDDeckLink instance for use in the with statement
+
+        Examples
+        --------
+        >>> with BMDDeckLink(0) as device:
+        ...     device.start_playback()
+        ...     # Device automatically closed when exiting the with block
+        """
+        return self
+
+    def __exit__(
+        self,
+        exc_type: type[BaseException] | None,
+        exc_val: BaseException | None,
+        exc_tb: Any | None,
+    ) -> None:
+        """
+        Exit the context manager and close the device.
+
+        Parameters
+        ----------
+        exc_type : type[BaseException] | None
+            Exception type if an exception occurred, None otherwise
+        exc_val : BaseException | None
+            Exception value if an exception occurred, None otherwise
+        exc_tb : Any | None
+            Exception traceback if an exception occurred, None otherwise
+
+        Notes
+        -----
+        The device is automatically closed regardless of whether an exception
+        occurred within the with block.
+        """
+        self.close()
+
+    def close(self) -> None:
+        """
+        Close the device and free resources.
+
+        This method is idempotent - it can be called multiple times safely.
+        After calling close(), the device cannot be used for further operations.
+
+        Notes
+        -----
+        This method is automatically called when the object is destroyed.
+        """
+        if self.handle:
+            if self.started:
+                self.stop_playback()
+            DecklinkSDKWrapper.decklink_close(self.handle)
+            self.handle = None
+
+    @property
+    def is_open(self) -> bool:
+        """
+        Check if the device is currently open.
+
+        Returns
+        -------
+        bool
+            True if the device is open, False otherwise
+        """
+        return self.handle is not None
+
+    def start_playback(self) -> None:
+        """
+        Start playback output to the DeckLink device.
+
+        Raises
+        ------
+        RuntimeError
+            If the device is not open or if starting playback fails
+        """
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        if self.started:
+            return
+        res = DecklinkSDKWrapper.decklink_start_output(self.handle)
+        if res != 0:
+            raise RuntimeError(f"Failed to start playback output (error {res})")
+        self.started = True
+
+    def stop_playback(self) -> None:
+        """
+        Stop playback output from the DeckLink device.
+
+        This method is idempotent - it can be called multiple times safely.
+        """
+        if not self.handle or not self.started:
+            return
+        DecklinkSDKWrapper.decklink_stop_output(self.handle)
+        self.started = False
+
+    def get_supported_pixel_formats(self) -> list[PixelFormatType]:
+        """
+        Get list of supported pixel format enum values.
+
+        Returns
+        -------
+        list[PixelFormatType]
+            List of supported pixel format enum values
+
+        Raises
+        ------
+        RuntimeError
+            If the device is not open
+
+        Notes
+        -----
+        If a pixel format string cannot be parsed to a known enum value, a warning
+        is printed asking the user to report the unknown format as a GitHub issue.
+        """
+        if not self.handle:
+            raise RuntimeError("Device not open")
+
+        count = DecklinkSDKWrapper.decklink_get_supported_pixel_format_count(
+            self.handle
+        )
+        formats = []
+        for i in range(count):
+            name = ctypes.create_string_buffer(256)
+            if (
+                DecklinkSDKWrapper.decklink_get_supported_pixel_format_name(
+                    self.handle, i, name, 256
+                )
+                == 0
+            ):
+                format_string = name.value.decode("utf-8")
+                try:
+                    # Try to parse the format string to a PixelFormatType enum
+                    # First try direct parsing, then try extracting format codes from parentheses
+                    try:
+                        pixel_format = PixelFormatType.parse(format_string)
+                    except ValueError as e:
+                        # Try to extract format code from strings like "8Bit ARGB (32)" or "12Bit RGB LE ('R12L')"
+                        # Look for format codes in parentheses, both with and without quotes
+                        match = re.search(r"\((?:'([^']+)'|([^)]+))\)", format_string)
+                        if match:
+                            format_code = match.group(1) or match.group(2)
+                            pixel_format = PixelFormatType.parse(format_code)
+                        else:
+                            raise ValueError(
+                                f"Could not extract format code from: {format_string}"
+                            ) from e
+
+                    formats.append(pixel_format)
+                except ValueError:
+                    # Print warning and ask user to report unknown format
+                    print(
+                        f"⚠️  WARNING: Unknown pixel format detected: '{format_string}'"
+                    )
+                    print(
+                        "📝 Please help improve this project by reporting this unknown format:"
+                    )
+                    print(f"   1. Copy this exact string: '{format_string}'")
+                    print(
+                        "   2. Create a new issue at: https://github.com/OpenLEDEval/bmd-signal-gen/issues"
+                    )
+                    print(
+                        "   3. Include your device model and the unknown format string"
+                    )
+                    print("   This format will be skipped for now.")
+                    print()
+        return formats
+
+    @property
+    def supports_hdr(self) -> bool:
+        return DecklinkSDKWrapper.decklink_device_supports_hdr(self.handle)
+
+    @property
+    def pixel_format(self) -> PixelFormatType:
+        """
+        Get the current pixel format as a PixelFormatType enum.
+
+        Returns
+        -------
+        PixelFormatType
+            Current pixel format enum value
+
+        Raises
+        ------
+        RuntimeError
+            If the device is not open
+        ValueError
+            If the SDK format code cannot be matched to a known PixelFormatType
+        """
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        sdk_format_code = DecklinkSDKWrapper.decklink_get_pixel_format(self.handle)
+        return PixelFormatType.parse(sdk_format_code)
+
+    @pixel_format.setter
+    def pixel_format(self, pixel_format_type: PixelFormatType) -> None:
+        """
+        Set the pixel format using a PixelFormatType enum.
+
+        Parameters
+        ----------
+        pixel_format_type : PixelFormatType
+            The pixel format enum to set
+
+        Raises
+        ------
+        RuntimeError
+            If the device is not open or setting the format fails
+        """
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        res = DecklinkSDKWrapper.decklink_set_pixel_format(
+            self.handle, pixel_format_type.sdk_format_code
+        )
+        if res != 0:
+            raise RuntimeError(
+                f"Failed to set pixel format {pixel_format_type.name} (error {res})"
+            )
+
+    @property
+    def display_mode(self) -> int:
+        """
+        Get the active display mode as a BMDDisplayMode four-character code.
+
+        Returns
+        -------
+        int
+            Display mode code (e.g. 0x48703330 for 'Hp30')
+
+        Raises
+        ------
+        RuntimeError
+            If the device is not open
+        """
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        return DecklinkSDKWrapper.decklink_get_display_mode(self.handle)
+
+    def benchmark_pixel_format(
+        self, pixel_format: PixelFormatType, iterations: int = 5
+    ) -> float:
+        """
+        Measure the cost of packing one frame into a pixel format.
+
+        A synthetic frame at the active display mode's dimensions is packed
+        ``iterations`` times after a warm-up pass; the best time is returned.
+
+        Parameters
+        ----------
+        pixel_format : PixelFormatType
+            Pixel format to benchmark
+        iterations : int, optional
+            Number of timed passes. Default is 5.
+
+        Returns
+        -------
+        float
+            Best observed pack time in nanoseconds per frame
+
+        Raises
+        ------
+        RuntimeError
+            If the device is not open or the format cannot be packed
+            (error -8 means the library has no packer for it)
+        """
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        ns_per_frame = ctypes.c_double(0.0)
+        res = DecklinkSDKWrapper.decklink_benchmark_pixel_format(
+            self.handle,
+            pixel_format.sdk_format_code,
+            iterations,
+            ctypes.byref(ns_per_frame),
+        )
+        if res != 0:
+            raise RuntimeError(
+                f"Failed to benchmark pixel format {pixel_format.name} (error {res})"
+            )
+        return ns_per_frame.value
+
+    def set_hdr_metadata(self, metadata: HDRMetadata) -> None:
+        """
+        Set complete HDR metadata for all future frames.
+
+        Parameters
+        ----------
+        metadata : HDRMetadata
+            HDR metadata structure with complete HDR parameters
+
+        Raises
+        ------
+        RuntimeError
+            If the device is not open or setting metadata fails
+        """
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        res = DecklinkSDKWrapper.decklink_set_hdr_metadata(
+            self.handle, ctypes.byref(metadata)
+        )
+        if res != 0:
+            raise RuntimeError(f"Failed to set HDR metadata (error {res})")
+
+    def intern_hdr_metadata(self, metadata: HDRMetadata) -> int:
+        """
+        Register HDR metadata for per-frame use in scheduled sequences.
+
+        Equal metadata always gets the same id, so interning every frame's
+        metadata of a sequence up front is cheap. Frames scheduled with an
+        id share one immutable copy of the values.
+
+        Parameters
+        ----------
+        metadata : HDRMetadata
+            Metadata to register
+
+        Returns
+        -------
+        int
+            Id (from 1) to pass as ``hdr_metadata`` when scheduling
+
+        Raises
+        ------
+        RuntimeError
+            If the device is not open, the EOTF is invalid or the table is
+            full
+        """
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        res = DecklinkSDKWrapper.decklink_intern_hdr_metadata(
+            self.handle, ctypes.byref(metadata)
+        )
+        if res < 0:
+            raise RuntimeError(f"Failed to intern HDR metadata (error {res})")
+        return res
+
+    def clear_hdr_metadata_table(self) -> None:
+        """
+        Drop every interned HDR metadata entry, invalidating their ids.
+
+        Frames already scheduled keep their metadata.
+
+        Raises
+        ------
+        RuntimeError
+            If the device is not open
+        """
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        res = DecklinkSDKWrapper.decklink_clear_hdr_metadata_table(self.handle)
+        if res != 0:
+            raise RuntimeError(f"Failed to clear HDR metadata table (error {res})")
+
+    def hdr_metadata_table_stats(self) -> HDRMetadataTableStats:
+        """
+        Get the interned HDR metadata table occupancy and counters.
+
+        Returns
+        -------
+        HDRMetadataTableStats
+            Current counters
+
+        Raises
+        ------
+        RuntimeError
+            If the device is not open or the query fails
+        """
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        stats = HDRMetadataTableStats()
+        res = DecklinkSDKWrapper.decklink_get_hdr_metadata_table_stats(
+            self.handle, ctypes.byref(stats)
+        )
+        if res != 0:
+            raise RuntimeError(f"Failed to get HDR metadata table stats (error {res})")
+        return stats
+
+    def _hdr_metadata_id(self, hdr_metadata: HDRMetadata | int | None) -> int:
+        """Table id for a schedule call; 0 keeps the device's metadata."""
+        if hdr_metadata is None:
+            return 0
+        if isinstance(hdr_metadata, HDRMetadata):
+            return self.intern_hdr_metadata(hdr_metadata)
+        if hdr_metadata < 1:
+            raise RuntimeError(f"Invalid HDR metadata id {hdr_metadata}")
+        return hdr_metadata
+
+    def reconfigure(
+        self,
+        pixel_format: PixelFormatType | None = None,
+        display_mode: int | None = None,
+        hdr_metadata: HDRMetadata | None = None,
+    ) -> ReconfigureStats:
+        """
+        Change pixel format, display mode and/or HDR metadata in place.
+
+        The requested configuration is diffed against the active one and only
+        the differences are applied. Pixel format changes within the same SDI
+        link layout and HDR metadata changes re-present the current frame
+        without touching the output; only display mode or SDI 4:4:4/4:2:2
+        changes cycle the output, and at most once per call.
+
+        Parameters
+        ----------
+        pixel_format : PixelFormatType | None, optional
+            New pixel format, or None to keep the current one.
+        display_mode : int | None, optional
+            New BMDDisplayMode four-character code, or None to keep the
+            current one.
+        hdr_metadata : HDRMetadata | None, optional
+            New HDR metadata, or None to keep the current metadata.
+
+        Returns
+        -------
+        ReconfigureStats
+            What had to change and how long the output was interrupted.
+
+        Raises
+        ------
+        RuntimeError
+            If the device is not open or the reconfiguration fails; a
+            configuration the output rejects leaves the previous one active
+
+        Examples
+        --------
+        Alternate between 10- and 12-bit without restarting output:
+
+        >>> stats = device.reconfigure(pixel_format=PixelFormatType.FORMAT_10BIT_RGB)
+        >>> stats.enableCycles
+        0
+        """
+        if not self.handle:
+            raise RuntimeError("Device not open")
+
+        config = OutputConfig()
+        if pixel_format is not None:
+            config.pixelFormat = pixel_format.sdk_format_code
+        if display_mode is not None:
+            config.displayMode = display_mode
+        if hdr_metadata is not None:
+            config.applyHDR = 1
+            config.hdrMetadata = hdr_metadata
+
+        res = DecklinkSDKWrapper.decklink_reconfigure(self.handle, ctypes.byref(config))
+        if res != 0:
+            raise RuntimeError(f"Failed to reconfigure output (error {res})")
+
+        stats = ReconfigureStats()
+        DecklinkSDKWrapper.decklink_get_reconfigure_stats(
+            self.handle, ctypes.byref(stats)
+        )
+        return stats
+
+    def set_thread_policy(
+        self,
+        output_core: int = -1,
+        sched_policy: ThreadSchedPolicy = ThreadSchedPolicy.OTHER,
+        sched_priority: int = 0,
+        pack_workers: int = 0,
+        pack_core_first: int = -1,
+        lock_memory: bool = False,
+    ) -> None:
+        """
+        Configure thread placement, real-time scheduling and memory locking.
+
+        Packing workers are (re)started immediately. The output thread request
+        is stored and takes effect when ``apply_output_thread_policy`` is
+        called from the thread that displays frames.
+
+        Parameters
+        ----------
+        output_core : int, optional
+            Core for the output thread, -1 to leave unpinned. Default is -1.
+        sched_policy : ThreadSchedPolicy, optional
+            Output thread scheduling policy. Default is OTHER.
+        sched_priority : int, optional
+            Real-time priority for FIFO/RR. Default is 0.
+        pack_workers : int, optional
+            Extra threads that pack each frame alongside the caller. Default is 0.
+        pack_core_first : int, optional
+            Worker ``i`` is pinned to ``pack_core_first + i``; -1 leaves them
+            unpinned. Default is -1.
+        lock_memory : bool, optional
+            ``mlock`` the frame pool buffers. Default is False.
+
+        Raises
+        ------
+        RuntimeError
+            If the device is not open or the policy is invalid
+        """
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        config = ThreadPolicyConfig(
+            outputCore=output_core,
+            schedPolicy=sched_policy.int_value,
+            schedPriority=sched_priority,
+            packWorkers=pack_workers,
+            packCoreFirst=pack_core_first,
+            lockMemory=int(lock_memory),
+        )
+        res = DecklinkSDKWrapper.decklink_set_thread_policy(
+            self.handle, ctypes.byref(config)
+        )
+        if res != 0:
+            raise RuntimeError(f"Failed to set thread policy (error {res})")
+
+    def apply_output_thread_policy(self) -> bool:
+        """
+        Pin and schedule the calling thread as the output thread.
+
+        Call this from the thread that will call ``display_frame``.
+
+        Returns
+        -------
+        bool
+            True if the full policy was applied, False if pinning was refused
+            or the real-time policy fell back to default scheduling.
+
+        Raises
+        ------
+        RuntimeError
+            If the device is not open
+        """
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        res = DecklinkSDKWrapper.decklink_apply_output_thread_policy(self.handle)
+        if res < 0:
+            raise RuntimeError(f"Failed to apply output thread policy (error {res})")
+        return res == 0
+
+    @property
+    def thread_policy_status(self) -> ThreadPolicyStatus:
+        """
+        Thread placement and scheduling currently in effect.
+
+        Returns
+        -------
+        ThreadPolicyStatus
+            Effective output thread policy, packing workers and memory locking
+
+        Raises
+        ------
+        RuntimeError
+            If the device is not open
+        """
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        status = ThreadPolicyStatus()
+        DecklinkSDKWrapper.decklink_get_thread_policy_status(
+            self.handle, ctypes.byref(status)
+        )
+        return status
+
+    def frame_timing_report(self) -> FrameTimingReport:
+        """
+        Get inter-frame interval and latency statistics.
+
+        Timing is recorded for every displayed frame at negligible cost and
+        reset automatically when the display mode changes.
+
+        Returns
+        -------
+        FrameTimingReport
+            Statistics and histograms since the last reset
+
+        Raises
+        ------
+        RuntimeError
+            If the device is not open
+        """
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        report = FrameTimingReport()
+        res = DecklinkSDKWrapper.decklink_get_frame_timing_report(
+            self.handle, ctypes.byref(report)
+        )
+        if res != 0:
+            raise RuntimeError(f"Failed to get frame timing report (error {res})")
+        return report
+
+    def frame_timing_outliers(
+        self, max_count: int = FRAME_TIMING_MAX_OUTLIERS
+    ) -> list[FrameTimingOutlier]:
+        """
+        Get the most recent late frames, oldest first.
+
+        Parameters
+        ----------
+        max_count : int, optional
+            Maximum number of outliers to return. The library keeps the last 64.
+
+        Returns
+        -------
+        list[FrameTimingOutlier]
+            Recent intervals above the outlier threshold
+
+        Raises
+        ------
+        RuntimeError
+            If the device is not open
+        """
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        buffer = (FrameTimingOutlier * max_count)()
+        count = DecklinkSDKWrapper.decklink_get_frame_timing_outliers(
+            self.handle, buffer, max_count
+        )
+        if count < 0:
+            raise RuntimeError(f"Failed to get frame timing outliers (error {count})")
+        return list(buffer[:count])
+
+    def reset_frame_timing(self) -> None:
+        """
+        Clear all frame timing statistics.
+
+        Raises
+        ------
+        RuntimeError
+            If the device is not open
+        """
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        DecklinkSDKWrapper.decklink_reset_frame_timing(self.handle)
+
+    def set_frame_timing_threshold(self, threshold: float) -> None:
+        """
+        Set how late a frame must be to count as an outlier.
+
+        Parameters
+        ----------
+        threshold : float
+            Fraction of the nominal frame duration; 0.5 flags intervals longer
+            than 1.5 frames.
+
+        Raises
+        ------
+        RuntimeError
+            If the device is not open or the threshold is negative
+        """
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        res = DecklinkSDKWrapper.decklink_set_frame_timing_threshold(
+            self.handle, threshold
+        )
+        if res != 0:
+            raise RuntimeError(f"Failed to set frame timing threshold (error {res})")
+
+    def memory_stats(self) -> dict[str, dict[str, int]]:
+        """
+        Get heap usage of the library per subsystem.
+
+        Counters are process-wide, so with several devices open they cover all
+        of them. ``live`` is the number of blocks allocated and not yet freed.
+
+        Returns
+        -------
+        dict[str, dict[str, int]]
+            ``current_bytes``, ``peak_bytes``, ``allocations``, ``frees`` and
+            ``live`` for each name in ``MEMORY_SUBSYSTEMS``
+
+        Raises
+        ------
+        RuntimeError
+            If the device is not open or the query fails
+        """
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        buffer = (MemoryStats * len(MEMORY_SUBSYSTEMS))()
+        count = DecklinkSDKWrapper.decklink_get_memory_stats(
+            buffer, len(MEMORY_SUBSYSTEMS)
+        )
+        if count < 0:
+            raise RuntimeError(f"Failed to get memory stats (error {count})")
+        return {
+            name: {
+                "current_bytes": stats.currentBytes,
+                "peak_bytes": stats.peakBytes,
+                "allocations": stats.allocations,
+                "frees": stats.frees,
+                "live": stats.allocations - stats.frees,
+            }
+            for name, stats in zip(MEMORY_SUBSYSTEMS, buffer[:count], strict=False)
+        }
+
+    def reset_memory_peaks(self) -> None:
+        """
+        Reset every subsystem's peak to its current usage.
+
+        Raises
+        ------
+        RuntimeError
+            If the device is not open
+        """
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        DecklinkSDKWrapper.decklink_reset_memory_peaks()
+
+    def add_overlay(
+        self, sprite: np.ndarray, x: int, y: int, enabled: bool = True
+    ) -> int:
+        """
+        Add an RGBA sprite composited into the packed output frame.
+
+        Overlays are blended into the already packed frame, touching only the
+        pixel groups they cover. Changes take effect on the next
+        ``display_frame`` or ``update_overlays`` call.
+
+        Parameters
+        ----------
+        sprite : numpy.ndarray
+            Array of shape (height, width, 4). RGB are code values at the
+            output bit depth (as passed to ``display_frame``); alpha is 0-255.
+        x, y : int
+            Position of the sprite's top-left corner; may be partly off-frame
+        enabled : bool, optional
+            Whether the overlay is drawn initially. Default is True.
+
+        Returns
+        -------
+        int
+            Overlay id for the other overlay methods
+
+        Raises
+        ------
+        RuntimeError
+            If the device is not open or the overlay is rejected
+        ValueError
+            If the sprite does not have shape (height, width, 4)
+        """
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        if sprite.ndim != 3 or sprite.shape[2] != 4:
+            raise ValueError("sprite must have shape (height, width, 4)")
+        sprite = np.ascontiguousarray(sprite, dtype=np.uint16)
+        height, width = sprite.shape[:2]
+        overlay_id = DecklinkSDKWrapper.decklink_add_overlay(
+            self.handle,
+            x,
+            y,
+            width,
+            height,
+            sprite.ctypes.data_as(ctypes.POINTER(ctypes.c_uint16)),
+            enabled,
+        )
+        if overlay_id <= 0:
+            raise RuntimeError(f"Failed to add overlay (error {overlay_id})")
+        return overlay_id
+
+    def _check_overlay_result(self, res: int, overlay_id: int) -> None:
+        if res == -2:
+            raise RuntimeError(f"Unknown overlay id {overlay_id}")
+        if res != 0:
+            raise RuntimeError(f"Overlay operation failed (error {res})")
+
+    def remove_overlay(self, overlay_id: int) -> None:
+        """
+        Remove an overlay.
+
+        Parameters
+        ----------
+        overlay_id : int
+            Id returned by ``add_overlay``
+
+        Raises
+        ------
+        RuntimeError
+            If the device is not open or the id is unknown
+        """
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        res = DecklinkSDKWrapper.decklink_remove_overlay(self.handle, overlay_id)
+        self._check_overlay_result(res, overlay_id)
+
+    def set_overlay_enabled(self, overlay_id: int, enabled: bool) -> None:
+        """
+        Show or hide an overlay without removing it.
+
+        Parameters
+        ----------
+        overlay_id : int
+            Id returned by ``add_overlay``
+        enabled : bool
+            Whether the overlay is drawn
+
+        Raises
+        ------
+        RuntimeError
+            If the device is not open or the id is unknown
+        """
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        res = DecklinkSDKWrapper.decklink_set_overlay_enabled(
+            self.handle, overlay_id, enabled
+        )
+        self._check_overlay_result(res, overlay_id)
+
+    def move_overlay(self, overlay_id: int, x: int, y: int) -> None:
+        """
+        Move an overlay.
+
+        Parameters
+        ----------
+        overlay_id : int
+            Id returned by ``add_overlay``
+        x, y : int
+            New position of the sprite's top-left corner
+
+        Raises
+        ------
+        RuntimeError
+            If the device is not open or the id is unknown
+        """
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        res = DecklinkSDKWrapper.decklink_move_overlay(self.handle, overlay_id, x, y)
+        self._check_overlay_result(res, overlay_id)
+
+    def clear_overlays(self) -> None:
+        """
+        Remove all overlays.
+
+        Raises
+        ------
+        RuntimeError
+            If the device is not open
+        """
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        DecklinkSDKWrapper.decklink_clear_overlays(self.handle)
+
+    def update_overlays(self) -> None:
+        """
+        Re-display the current frame with the current overlays.
+
+        The last displayed image is not repacked: its packed form is copied
+        and only the overlay regions are recomposited.
+
+        Raises
+        ------
+        RuntimeError
+            If the device is not open, no frame has been displayed at the
+            current format, or displaying fails
+        """
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        res = DecklinkSDKWrapper.decklink_update_overlays(self.handle)
+        if res != 0:
+            raise RuntimeError(f"Failed to update overlays (error {res})")
+
+    def set_pipelined_output(self, enabled: bool) -> None:
+        """
+        Switch pipelined (pack-while-display) output on or off.
+
+        While enabled, ``display_frame`` copies the frame into the library
+        and returns; a pack thread packs it while a display thread is still
+        blocked showing the previous frame, so a sequence runs at the display
+        rate as long as packing alone fits in a frame time. Any other frame
+        operation first waits for the submitted frames to be displayed.
+        Disabling displays every frame already submitted.
+
+        Parameters
+        ----------
+        enabled : bool
+            Whether to pipeline ``display_frame``
+
+        Raises
+        ------
+        RuntimeError
+            If the device is not open
+        """
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        DecklinkSDKWrapper.decklink_set_pipelined_output(self.handle, enabled)
+        self.pipelined = enabled
+
+    def flush_output(self) -> None:
+        """
+        Wait until every frame submitted in pipelined mode has been displayed.
+
+        Raises
+        ------
+        RuntimeError
+            If the device is not open or the last frame failed to pack or
+            display
+        """
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        res = DecklinkSDKWrapper.decklink_flush_output(self.handle)
+        if res != 0:
+            raise RuntimeError(f"Pipelined output failed (error {res})")
+
+    def pipeline_stats(self) -> PipelineStats:
+        """
+        Get the counters of pipelined output.
+
+        Returns
+        -------
+        PipelineStats
+            Counters since pipelined output was last enabled
+
+        Raises
+        ------
+        RuntimeError
+            If the device is not open or the query fails
+        """
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        stats = PipelineStats()
+        res = DecklinkSDKWrapper.decklink_get_pipeline_stats(
+            self.handle, ctypes.byref(stats)
+        )
+        if res != 0:
+            raise RuntimeError(f"Failed to get pipeline stats (error {res})")
+        return stats
+
+    def start_frc(
+        self,
+        target: Sequence[float],
+        roi: tuple[int, int, int, int] | None = None,
+        cycle_frames: int = 8,
+        background: np.ndarray | None = None,
+    ) -> FrcStatus:
+        """
+        Start temporal dithering of a patch between adjacent code values.
+
+        Each channel alternates between ``floor(target)`` and the next code
+        value, the upper one shown on ``round(fraction * cycle_frames)``
+        frames of every cycle, spread evenly. The few distinct frames are
+        packed once and looped with scheduled playback on the device clock,
+        so dithering costs no CPU per frame. It runs until ``stop_frc``,
+        ``display_frame`` or a reconfiguration.
+
+        Parameters
+        ----------
+        target : Sequence[float]
+            Fractional R, G, B code values at the output bit depth
+        roi : tuple[int, int, int, int], optional
+            Patch ``(x, y, width, height)``; the whole frame if None
+        cycle_frames : int, optional
+            Frames per dither cycle (1-64). Default is 8.
+        background : numpy.ndarray, optional
+            Image outside the patch; defaults to the last displayed frame, or
+            black if its size does not match
+
+        Returns
+        -------
+        FrcStatus
+            Levels actually produced (fractions are quantized to
+            ``1 / cycle_frames``)
+
+        Raises
+        ------
+        RuntimeError
+            If the device is not open, output is not started, the patch does
+            not fit the frame, or scheduled playback cannot start
+        ValueError
+            If ``target`` does not have three non-negative values
+        """
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        if len(target) != 3 or min(target) < 0:
+            raise ValueError("target must be three non-negative code values")
+        if background is not None:
+            frame_data = np.ascontiguousarray(background, dtype=np.uint16)
+            data_ptr, height, width = ndarray_to_bmd_frame_buffer(frame_data)
+            res = DecklinkSDKWrapper.decklink_set_frame_data(
+                self.handle, data_ptr, width, height
+            )
+            if res != 0:
+                raise RuntimeError(f"Failed to set frame data (error {res})")
+
+        config = FrcConfig()
+        config.target[:] = [float(value) for value in target]
+        if roi is not None:
+            config.roiX, config.roiY, config.roiWidth, config.roiHeight = roi
+        config.cycleFrames = cycle_frames
+        res = DecklinkSDKWrapper.decklink_start_frc(self.handle, ctypes.byref(config))
+        if res != 0:
+            raise RuntimeError(f"Failed to start FRC (error {res})")
+        return self.frc_status()
+
+    def stop_frc(self) -> None:
+        """
+        Stop temporal dithering.
+
+        Raises
+        ------
+        RuntimeError
+            If the device is not open
+        """
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        DecklinkSDKWrapper.decklink_stop_frc(self.handle)
+
+    def frc_status(self) -> FrcStatus:
+        """
+        Get the levels and playback counters of temporal dithering.
+
+        Returns
+        -------
+        FrcStatus
+            Status of the running (or last) FRC patch
+
+        Raises
+        ------
+        RuntimeError
+            If the device is not open or the query fails
+        """
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        status = FrcStatus()
+        res = DecklinkSDKWrapper.decklink_get_frc_status(
+            self.handle, ctypes.byref(status)
+        )
+        if res != 0:
+            raise RuntimeError(f"Failed to get FRC status (error {res})")
+        return status
+
+    def start_scheduler(
+        self,
+        policy: SchedulerPolicy = SchedulerPolicy.STRICT,
+        lead_frames: int = 2,
+        max_pending: int = 8,
+        adaptive_lead: tuple[int, int] | None = None,
+    ) -> None:
+        """
+        Start deadline-aware scheduled output.
+
+        Scheduled playback starts with its stream clock at zero. Frames are
+        then added with ``schedule_frame`` for a presentation time on that
+        clock, which the device derives from its hardware reference. It runs
+        until ``stop_scheduler``, ``display_frame``, ``start_frc`` or a
+        reconfiguration.
+
+        Parameters
+        ----------
+        policy : SchedulerPolicy, optional
+            Handling of frames that miss their slot. Default is STRICT.
+        lead_frames : int, optional
+            Slots ahead of the current one handed to the device (1-8); the
+            output latency of a frame scheduled "now". Default is 2.
+        max_pending : int, optional
+            Packed frames waiting in the library (1-32). Default is 8.
+        adaptive_lead : tuple[int, int], optional
+            Bounds (min, max) within which the library tunes the lead,
+            starting at ``lead_frames``: it is raised when the device shows a
+            frame late or the completion jitter grows, and lowered while the
+            host keeps up. The current lead is ``scheduler_stats().leadFrames``.
+            Default is a fixed lead.
+
+        Raises
+        ------
+        RuntimeError
+            If the device is not open, output is not started, the settings
+            are out of range, or scheduled playback cannot start
+        """
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        min_lead, max_lead = adaptive_lead or (lead_frames, lead_frames)
+        config = SchedulerConfig(
+            SchedulerPolicy(policy).int_value,
+            lead_frames,
+            max_pending,
+            adaptive_lead is not None,
+            min_lead,
+            max_lead,
+        )
+        res = DecklinkSDKWrapper.decklink_start_scheduler(
+            self.handle, ctypes.byref(config)
+        )
+        if res != 0:
+            raise RuntimeError(f"Failed to start scheduler (error {res})")
+
+    @traced("schedule_frame", "device", frame=True)
+    def schedule_frame(
+        self,
+        frame_data: np.ndarray,
+        at_ns: int = 0,
+        duration_frames: int = 1,
+        hdr_metadata: HDRMetadata | int | None = None,
+    ) -> SchedulerDecisionRecord:
+        """
+        Queue a frame for a presentation time.
+
+        The frame is shown from the first slot at or after ``at_ns`` for
+        ``duration_frames`` slots, or until the next queued frame. Under the
+        strict policy a frame that cannot make its slot is dropped before
+        it is packed. Dropping is reported in the result, not raised.
+
+        Parameters
+        ----------
+        frame_data : numpy.ndarray
+            Frame data with shape (height, width, channels) or (height, width)
+        at_ns : int, optional
+            Presentation time in nanoseconds on the stream clock (see
+            ``scheduler_stats().streamTimeNs``); 0 for the next free slot
+        duration_frames : int, optional
+            Slots to show the frame for. Default is 1.
+        hdr_metadata : HDRMetadata | int | None, optional
+            Metadata this frame carries, as values or an id from
+            ``intern_hdr_metadata()``; None for the current metadata.
+
+        Returns
+        -------
+        SchedulerDecisionRecord
+            Decision taken for the frame
+
+        Raises
+        ------
+        RuntimeError
+            If the device is not open, the scheduler is not running, no frame
+            buffer is free, the metadata id is unknown, or packing fails
+        """
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        metadata_id = self._hdr_metadata_id(hdr_metadata)
+        frame_data = np.astype(frame_data, np.uint16, copy=False)
+        frame_data = np.ascontiguousarray(frame_data)
+        data_ptr, height, width = ndarray_to_bmd_frame_buffer(frame_data)
+        record = SchedulerDecisionRecord()
+        res = DecklinkSDKWrapper.decklink_schedule_frame_hdr(
+            self.handle,
+            data_ptr,
+            width,
+            height,
+            at_ns,
+            duration_frames,
+            metadata_id,
+            ctypes.byref(record),
+        )
+        if res != 0:
+            raise RuntimeError(f"Failed to schedule frame (error {res})")
+        return record
+
+    def stop_scheduler(self) -> None:
+        """
+        Stop deadline-aware scheduled output, discarding queued frames.
+
+        Raises
+        ------
+        RuntimeError
+            If the device is not open
+        """
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        DecklinkSDKWrapper.decklink_stop_scheduler(self.handle)
+
+    def scheduler_stats(self) -> SchedulerStats:
+        """
+        Get the deadline scheduler counters and the stream clock.
+
+        Returns
+        -------
+        SchedulerStats
+            Counters since the scheduler was last started
+
+        Raises
+        ------
+        RuntimeError
+            If the device is not open or the query fails
+        """
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        stats = SchedulerStats()
+        res = DecklinkSDKWrapper.decklink_get_scheduler_stats(
+            self.handle, ctypes.byref(stats)
+        )
+        if res != 0:
+            raise RuntimeError(f"Failed to get scheduler stats (error {res})")
+        return stats
+
+    def scheduler_decisions(self, max_count: int = 64) -> list[SchedulerDecisionRecord]:
+        """
+        Get the most recent scheduler decisions, oldest first.
+
+        Parameters
+        ----------
+        max_count : int, optional
+            Maximum number of records (the library keeps 64). Default is 64.
+
+        Returns
+        -------
+        list[SchedulerDecisionRecord]
+            Recent decisions, including dispatches to the device
+
+        Raises
+        ------
+        RuntimeError
+            If the device is not open or the query fails
+        """
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        records = (SchedulerDecisionRecord * max_count)()
+        count = DecklinkSDKWrapper.decklink_get_scheduler_decisions(
+            self.handle, records, max_count
+        )
+        if count < 0:
+            raise RuntimeError(f"Failed to get scheduler decisions (error {count})")
+        return list(records[:count])
+
+    def scheduler_lead_changes(self, max_count: int = 32) -> list[SchedulerLeadChange]:
+        """
+        Get the most recent adaptive lead changes, oldest first.
+
+        Parameters
+        ----------
+        max_count : int, optional
+            Maximum number of records (the library keeps 32). Default is 32.
+
+        Returns
+        -------
+        list[SchedulerLeadChange]
+            Recent lead changes with their reason and the jitter seen
+
+        Raises
+        ------
+        RuntimeError
+            If the device is not open or the query fails
+        """
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        changes = (SchedulerLeadChange * max_count)()
+        count = DecklinkSDKWrapper.decklink_get_scheduler_lead_changes(
+            self.handle, changes, max_count
+        )
+        if count < 0:
+            raise RuntimeError(f"Failed to get lead changes (error {count})")
+        return list(changes[:count])
+
+    def start_stream(
+        self,
+        fd: int,
+        width: int,
+        height: int,
+        packed: bool = False,
+        readahead: int = 4,
+        loop: bool = False,
+        max_frames: int = 0,
+    ) -> StreamStats:
+        """
+        Display raw frames read by the library from a file descriptor.
+
+        Frames of a fixed size are read on a library thread, straight into
+        pooled frame buffers when pre-packed, and shown at the display rate;
+        no frame data passes through Python. Overlays are not drawn on
+        streamed frames. The stream runs until the input ends, ``max_frames``
+        have been read, ``stop_stream`` or any other frame operation. The
+        file descriptor stays owned by the caller and must stay open while
+        the stream runs.
 
-    def __init__(self, device_index: int = 0) -> None:
-        self.device_index = device_index
-        self.handle = DecklinkSDKWrapper.decklink_open_output_by_index(device_index)
+        Parameters
+        ----------
+        fd : int
+            Readable file descriptor (stdin, a FIFO, a pipe or a file)
+        width, height : int
+            Frame size in pixels
+        packed : bool, optional
+            Frames are already packed in the active pixel format with the
+            SDK's row bytes (see ``StreamStats.frameBytes``); otherwise they
+            are interleaved native-endian uint16 RGB. Default is False.
+        readahead : int, optional
+            Frames read ahead of the display (1-16). Default is 4.
+        loop : bool, optional
+            Rewind a seekable input at end of file. Default is False.
+        max_frames : int, optional
+            Stop after this many frames, 0 for no limit. Default is 0.
+
+        Returns
+        -------
+        StreamStats
+            Counters of the started stream, including the frame size expected
+
+        Raises
+        ------
+        RuntimeError
+            If the device is not open, output is not started or the settings
+            are invalid
+        """
         if not self.handle:
-            raise RuntimeError(
-                f"No DeckLink output device found at index {device_index}"
-            )
-        self.started = False
+            raise RuntimeError("Device not open")
+        config = StreamConfig(
+            fd, int(packed), width, height, readahead, int(loop), max_frames
+        )
+        res = DecklinkSDKWrapper.decklink_start_stream(
+            self.handle, ctypes.byref(config)
+        )
+        if res != 0:
+            raise RuntimeError(f"Failed to start stream (error {res})")
+        return self.stream_stats()
 
-    def __del__(self) -> None:
-        """Destructor - automatically close device on object destruction."""
-        self.close()
+    def stop_stream(self) -> None:
+        """
+        Stop a raw frame stream, discarding frames read ahead.
 
-    def __enter__(self) -> Self:
+        Raises
+        ------
+        RuntimeError
+            If the device is not open
         """
-        Enter the context manager.
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        DecklinkSDKWrapper.decklink_stop_stream(self.handle)
+
+    def stream_stats(self) -> StreamStats:
+        """
+        Get the counters of the running or last raw frame stream.
 
         Returns
         -------
-        Self
-            The BMDDeckLink instance for use in the with statement
+        StreamStats
+            Stream progress and timing
 
-        Examples
-        --------
-        >>> with BMDDeckLink(0) as device:
-        ...     device.start_playback()
-        ...     # Device automatically closed when exiting the with block
+        Raises
+        ------
+        RuntimeError
+            If the device is not open or the query fails
         """
-        return self
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        stats = StreamStats()
+        res = DecklinkSDKWrapper.decklink_get_stream_stats(
+            self.handle, ctypes.byref(stats)
+        )
+        if res != 0:
+            raise RuntimeError(f"Failed to get stream stats (error {res})")
+        return stats
 
-    def __exit__(
+    def start_recording(
+        self, path: str | Path, slots: int = 8, direct: bool = True
+    ) -> RecorderStats:
+        """
+        Record every packed frame sent to the device to a file.
+
+        Each frame is recorded as it leaves the library, after overlays, on
+        every output path, behind a record of its timestamp, CRC and HDR
+        metadata (see ``read_recording``). The output thread only copies the
+        frame; a library thread writes it. A frame that finds every slot
+        still waiting for the disk is left out of the recording and counted,
+        never waited for. Recording runs until ``stop_recording``.
+
+        Parameters
+        ----------
+        path : str | Path
+            File to create, replaced if it exists
+        slots : int, optional
+            Frames that can wait for the disk at once (1-64). Default is 8.
+        direct : bool, optional
+            Bypass the page cache where the file system allows it. Default
+            is True.
+
+        Returns
+        -------
+        RecorderStats
+            Counters of the started recording, including the slot size
+
+        Raises
+        ------
+        RuntimeError
+            If the device is not open, the settings are invalid or the file
+            cannot be created
+        """
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        config = RecorderConfig(slots, int(direct))
+        res = DecklinkSDKWrapper.decklink_start_recording(
+            self.handle, str(path).encode("utf-8"), ctypes.byref(config)
+        )
+        if res != 0:
+            raise RuntimeError(f"Failed to start recording (error {res})")
+        return self.recorder_stats()
+
+    def stop_recording(self) -> RecorderStats:
+        """
+        Stop recording after writing the frames already copied.
+
+        Returns
+        -------
+        RecorderStats
+            Final counters of the recording
+
+        Raises
+        ------
+        RuntimeError
+            If the device is not open
+        """
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        DecklinkSDKWrapper.decklink_stop_recording(self.handle)
+        return self.recorder_stats()
+
+    def recorder_stats(self) -> RecorderStats:
+        """
+        Get the counters of the running or last recording.
+
+        Returns
+        -------
+        RecorderStats
+            Frames recorded and dropped, and copy and write times
+
+        Raises
+        ------
+        RuntimeError
+            If the device is not open or the query fails
+        """
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        stats = RecorderStats()
+        res = DecklinkSDKWrapper.decklink_get_recorder_stats(
+            self.handle, ctypes.byref(stats)
+        )
+        if res != 0:
+            raise RuntimeError(f"Failed to get recorder stats (error {res})")
+        return stats
+
+    def play_recording(self, path: str | Path) -> ClipPlaybackStats:
+        """
+        Replay a recording in a loop at the display rate.
+
+        The recording is read and checked against its CRCs before playback
+        starts. Frames with the same data and metadata share one buffer, and
+        each frame is shown for as many frame durations as passed before the
+        next one was recorded. Frames carry the HDR metadata they were
+        recorded with. Replay runs until ``stop_replay`` or any other frame
+        operation.
+
+        Parameters
+        ----------
+        path : str | Path
+            Recording in the active pixel format, all frames of one size
+
+        Returns
+        -------
+        ClipPlaybackStats
+            Counters of the started replay
+
+        Raises
+        ------
+        RuntimeError
+            If the device is not open, output is not started or the
+            recording cannot be replayed
+        """
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        res = DecklinkSDKWrapper.decklink_play_recording(
+            self.handle, str(path).encode("utf-8")
+        )
+        if res != 0:
+            raise RuntimeError(f"Failed to replay recording (error {res})")
+        return self.replay_stats()
+
+    def stop_replay(self) -> None:
+        """
+        Stop replaying a recording.
+
+        Raises
+        ------
+        RuntimeError
+            If the device is not open
+        """
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        DecklinkSDKWrapper.decklink_stop_replay(self.handle)
+
+    def replay_stats(self) -> ClipPlaybackStats:
+        """
+        Get the counters of the running or last replay.
+
+        Returns
+        -------
+        ClipPlaybackStats
+            Frames scheduled, late and dropped
+
+        Raises
+        ------
+        RuntimeError
+            If the device is not open or the query fails
+        """
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        stats = ClipPlaybackStats()
+        res = DecklinkSDKWrapper.decklink_get_replay_stats(
+            self.handle, ctypes.byref(stats)
+        )
+        if res != 0:
+            raise RuntimeError(f"Failed to get replay stats (error {res})")
+        return stats
+
+    def set_frame_stats(
+        self, enabled: bool = True, auto_hdr_metadata: bool = False
+    ) -> None:
+        """
+        Enable or disable per-frame statistics (enabled by default).
+
+        Statistics are computed in the same pass that packs each frame, for
+        every output path.
+
+        Parameters
+        ----------
+        enabled : bool
+            Compute statistics for every packed frame
+        auto_hdr_metadata : bool
+            With PQ, set the HDR metadata MaxCLL/MaxFALL of each frame from
+            its own statistics instead of the configured constants
+
+        Raises
+        ------
+        RuntimeError
+            If the device is not open or the library rejects the mode
+        """
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        mode = (2 if auto_hdr_metadata else 1) if enabled else 0
+        res = DecklinkSDKWrapper.decklink_set_frame_stats(self.handle, mode)
+        if res != 0:
+            raise RuntimeError(f"Failed to set frame statistics (error {res})")
+
+    def frame_stats(self) -> FrameStats:
+        """
+        Get the statistics of the most recently packed frame.
+
+        Returns
+        -------
+        FrameStats
+            Statistics; ``valid`` is 0 if none have been gathered
+
+        Raises
+        ------
+        RuntimeError
+            If the device is not open or the query fails
+        """
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        stats = FrameStats()
+        res = DecklinkSDKWrapper.decklink_get_frame_stats(
+            self.handle, ctypes.byref(stats)
+        )
+        if res != 0:
+            raise RuntimeError(f"Failed to get frame stats (error {res})")
+        return stats
+
+    def set_thumbnail(
         self,
-        exc_type: type[BaseException] | None,
-        exc_val: BaseException | None,
-        exc_tb: Any | None,
+        width: int = 320,
+        height: int = 0,
+        samples: int = 2,
+        interval_ms: int = 250,
+        reference_nits: float = 203.0,
+    ) -> None:
+        """
+        Configure the monitoring thumbnail (enabled at 320 wide by default).
+
+        The library decimates every synchronously displayed frame, and
+        streamed or scheduled frames at most every ``interval_ms``, into an
+        8-bit sRGB thumbnail as it leaves the library, overlays included.
+
+        Parameters
+        ----------
+        width : int
+            Thumbnail width in pixels (at most 1920); 0 disables thumbnails
+        height : int
+            Thumbnail height (at most 1080); 0 keeps the aspect ratio
+        samples : int
+            Source samples per thumbnail pixel along each axis (1-8); the
+            cost grows with its square
+        interval_ms : int
+            Minimum time between captures of streamed output
+        reference_nits : float
+            PQ light level shown as sRGB white
+
+        Raises
+        ------
+        RuntimeError
+            If the device is not open or the settings are out of range
+        """
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        config = ThumbnailConfig(
+            width=width,
+            height=height,
+            samples=samples,
+            intervalMs=interval_ms,
+            referenceNits=reference_nits,
+        )
+        res = DecklinkSDKWrapper.decklink_set_thumbnail_config(
+            self.handle, ctypes.byref(config)
+        )
+        if res != 0:
+            raise RuntimeError(f"Failed to configure thumbnails (error {res})")
+
+    def thumbnail_config(self) -> ThumbnailConfig:
+        """
+        Get the monitoring thumbnail settings.
+
+        Returns
+        -------
+        ThumbnailConfig
+            Current settings
+
+        Raises
+        ------
+        RuntimeError
+            If the device is not open or the query fails
+        """
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        config = ThumbnailConfig()
+        res = DecklinkSDKWrapper.decklink_get_thumbnail_config(
+            self.handle, ctypes.byref(config)
+        )
+        if res != 0:
+            raise RuntimeError(f"Failed to get thumbnail config (error {res})")
+        return config
+
+    def thumbnail(self) -> tuple[np.ndarray, ThumbnailInfo] | None:
+        """
+        Get the latest monitoring thumbnail of the output.
+
+        Returns
+        -------
+        tuple[numpy.ndarray, ThumbnailInfo] | None
+            sRGB uint8 image of shape (height, width, 3) and its description,
+            or None if no frame has been captured yet
+
+        Raises
+        ------
+        RuntimeError
+            If the device is not open or the copy fails
+        """
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        info = ThumbnailInfo()
+        size = DecklinkSDKWrapper.decklink_get_thumbnail(
+            self.handle, None, 0, ctypes.byref(info)
+        )
+        while size > 0:
+            image = np.empty(size, dtype=np.uint8)
+            size = DecklinkSDKWrapper.decklink_get_thumbnail(
+                self.handle,
+                image.ctypes.data_as(ctypes.POINTER(ctypes.c_uint8)),
+                image.size,
+                ctypes.byref(info),
+            )
+            if size == image.size:
+                return image.reshape(info.height, info.width, 3), info
+            if size == -1:
+                # Reconfigured to a larger size in between: ask again
+                size = DecklinkSDKWrapper.decklink_get_thumbnail(
+                    self.handle, None, 0, ctypes.byref(info)
+                )
+        if size < 0:
+            raise RuntimeError(f"Failed to get thumbnail (error {size})")
+        return None
+
+    @traced("cache_frame", "device", frame=True)
+    def cache_frame(self, key: int, frame_data: np.ndarray) -> None:
+        """
+        Pack a frame in the active pixel format into the frame cache.
+
+        The frame is not shown. Cached frames are kept compressed (flat
+        fields, bars, ramps and windows take a few KB even at 4K) and the
+        most recently used ones also stay decoded, so recalling them with
+        ``display_cached_frame`` costs no packing and, for those, no copy.
+        Overlays and HDR metadata are applied when an entry is shown.
+
+        Parameters
+        ----------
+        key : int
+            Caller-chosen identifier; an existing entry is replaced
+        frame_data : numpy.ndarray
+            Frame data with shape (height, width, channels) or (height, width)
+
+        Raises
+        ------
+        RuntimeError
+            If the device is not open or packing fails
+        """
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        frame_data = np.astype(frame_data, np.uint16, copy=False)
+        frame_data = np.ascontiguousarray(frame_data)
+        data_ptr, height, width = ndarray_to_bmd_frame_buffer(frame_data)
+        res = DecklinkSDKWrapper.decklink_cache_frame(
+            self.handle, key, data_ptr, width, height
+        )
+        if res != 0:
+            raise RuntimeError(f"Failed to cache frame (error {res})")
+
+    def cache_packed_frame(
+        self,
+        key: int,
+        data: np.ndarray,
+        width: int,
+        pixel_format: PixelFormatType | None = None,
     ) -> None:
         """
-        Exit the context manager and close the device.
+        Store an already packed frame in the frame cache.
+
+        The cache keeps its own compressed copy, so ``data`` may be reused as
+        soon as the call returns.
+
+        Parameters
+        ----------
+        key : int
+            Caller-chosen identifier; an existing entry is replaced
+        data : numpy.ndarray
+            uint8 array of shape (height, row_bytes) in the given pixel format
+        width : int
+            Frame width in pixels
+        pixel_format : PixelFormatType | None, optional
+            Format of the payload; None assumes the active format
+
+        Raises
+        ------
+        RuntimeError
+            If the device is not open or rows are too short
+        ValueError
+            If data is not a 2D uint8 array with contiguous rows
+        """
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        desc = packed_frame_desc(data, width, pixel_format)
+        res = DecklinkSDKWrapper.decklink_cache_packed_frame(
+            self.handle, key, ctypes.byref(desc)
+        )
+        if res != 0:
+            raise RuntimeError(f"Failed to cache packed frame (error {res})")
+
+    @traced("display_cached_frame", "device", frame=True)
+    def display_cached_frame(self, key: int) -> None:
+        """
+        Display a cached frame synchronously.
 
         Parameters
         ----------
-        exc_type : type[BaseException] | None
-            Exception type if an exception occurred, None otherwise
-        exc_val : BaseException | None
-            Exception value if an exception occurred, None otherwise
-        exc_tb : Any | None
-            Exception traceback if an exception occurred, None otherwise
+        key : int
+            Identifier passed to ``cache_frame`` or ``cache_packed_frame``
 
-        Notes
-        -----
-        The device is automatically closed regardless of whether an exception
-        occurred within the with block.
+        Raises
+        ------
+        RuntimeError
+            If the device is not open, the key is unknown, the entry is not
+            in the active pixel format, or the display fails
         """
-        self.close()
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        res = DecklinkSDKWrapper.decklink_display_cached_frame(self.handle, key)
+        if res != 0:
+            raise RuntimeError(f"Failed to display cached frame {key} (error {res})")
 
-    def close(self) -> None:
+    @traced("schedule_cached_frame", "device", frame=True)
+    def schedule_cached_frame(
+        self,
+        key: int,
+        at_ns: int = 0,
+        duration_frames: int = 1,
+        hdr_metadata: HDRMetadata | int | None = None,
+    ) -> SchedulerDecisionRecord:
         """
-        Close the device and free resources.
+        Queue a cached frame for a presentation time.
 
-        This method is idempotent - it can be called multiple times safely.
-        After calling close(), the device cannot be used for further operations.
+        Same decisions as ``schedule_frame``; a frame dropped under the
+        strict policy is not decoded.
 
-        Notes
-        -----
-        This method is automatically called when the object is destroyed.
+        Parameters
+        ----------
+        key : int
+            Identifier passed to ``cache_frame`` or ``cache_packed_frame``
+        at_ns : int, optional
+            Presentation time in nanoseconds on the stream clock; 0 for the
+            next free slot
+        duration_frames : int, optional
+            Slots to show the frame for. Default is 1.
+        hdr_metadata : HDRMetadata | int | None, optional
+            Metadata this frame carries, as values or an id from
+            ``intern_hdr_metadata()``; None for the current metadata.
+
+        Returns
+        -------
+        SchedulerDecisionRecord
+            Decision taken for the frame
+
+        Raises
+        ------
+        RuntimeError
+            If the device is not open, the scheduler is not running, the key
+            or metadata id is unknown or no frame buffer is free
         """
-        if self.handle:
-            if self.started:
-                self.stop_playback()
-            DecklinkSDKWrapper.decklink_close(self.handle)
-            self.handle = None
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        metadata_id = self._hdr_metadata_id(hdr_metadata)
+        record = SchedulerDecisionRecord()
+        res = DecklinkSDKWrapper.decklink_schedule_cached_frame_hdr(
+            self.handle,
+            key,
+            at_ns,
+            duration_frames,
+            metadata_id,
+            ctypes.byref(record),
+        )
+        if res != 0:
+            raise RuntimeError(f"Failed to schedule cached frame {key} (error {res})")
+        return record
 
-    @property
-    def is_open(self) -> bool:
+    def remove_cached_frame(self, key: int) -> bool:
         """
-        Check if the device is currently open.
+        Drop one entry from the frame cache.
+
+        Parameters
+        ----------
+        key : int
+            Identifier of the entry
 
         Returns
         -------
         bool
-            True if the device is open, False otherwise
+            False if there was no such entry
+
+        Raises
+        ------
+        RuntimeError
+            If the device is not open
         """
-        return self.handle is not None
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        return DecklinkSDKWrapper.decklink_remove_cached_frame(self.handle, key) == 0
 
-    def start_playback(self) -> None:
+    def clear_frame_cache(self) -> None:
         """
-        Start playback output to the DeckLink device.
+        Drop every frame cache entry and the cache's buffers.
 
         Raises
         ------
         RuntimeError
-            If the device is not open or if starting playback fails
+            If the device is not open
         """
         if not self.handle:
             raise RuntimeError("Device not open")
-        if self.started:
-            return
-        res = DecklinkSDKWrapper.decklink_start_output(self.handle)
-        if res != 0:
-            raise RuntimeError(f"Failed to start playback output (error {res})")
-        self.started = True
+        DecklinkSDKWrapper.decklink_clear_frame_cache(self.handle)
 
-    def stop_playback(self) -> None:
+    def set_frame_cache_hot_frames(self, count: int) -> None:
         """
-        Stop playback output from the DeckLink device.
+        Set how many recently used cache entries stay decoded (4 by default).
 
-        This method is idempotent - it can be called multiple times safely.
+        Each one holds a full frame buffer; recalling a decoded entry is
+        immediate, any other entry is decoded first.
+
+        Parameters
+        ----------
+        count : int
+            Number of decoded entries (1-64)
+
+        Raises
+        ------
+        RuntimeError
+            If the device is not open or count is out of range
         """
-        if not self.handle or not self.started:
-            return
-        DecklinkSDKWrapper.decklink_stop_output(self.handle)
-        self.started = False
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        res = DecklinkSDKWrapper.decklink_set_frame_cache_hot_frames(self.handle, count)
+        if res != 0:
+            raise RuntimeError(f"Invalid frame cache hot frame count {count}")
 
-    def get_supported_pixel_formats(self) -> list[PixelFormatType]:
+    def frame_cache_stats(self) -> FrameCacheStats:
         """
-        Get list of supported pixel format enum values.
+        Get the frame cache occupancy and recall counters.
 
         Returns
         -------
-        list[PixelFormatType]
-            List of supported pixel format enum values
+        FrameCacheStats
+            Current counters
 
         Raises
         ------
         RuntimeError
-            If the device is not open
-
-        Notes
-        -----
-        If a pixel format string cannot be parsed to a known enum value, a warning
-        is printed asking the user to report the unknown format as a GitHub issue.
+            If the device is not open or the query fails
         """
         if not self.handle:
             raise RuntimeError("Device not open")
+        stats = FrameCacheStats()
+        res = DecklinkSDKWrapper.decklink_get_frame_cache_stats(
+            self.handle, ctypes.byref(stats)
+        )
+        if res != 0:
+            raise RuntimeError(f"Failed to get frame cache stats (error {res})")
+        return stats
 
-        count = DecklinkSDKWrapper.decklink_get_supported_pixel_format_count(
-            self.handle
+    def set_placement(
+        self,
+        fit: PlacementFit | str = PlacementFit.CONTAIN,
+        filter_mode: PlacementFilter | str = PlacementFilter.BOX,
+        width: int = 0,
+        height: int = 0,
+        crop: tuple[int, int, int, int] | None = None,
+        surround: tuple[int, int, int] = (0, 0, 0),
+    ) -> None:
+        """
+        Place frames of any size on the output raster while packing.
+
+        From the next frame on, RGB frames (``display_frame``, pipelined,
+        scheduled, RGB48 streams, ``cache_frame``) are cropped, scaled and
+        centered on the raster with ``surround`` around them, in the same
+        pass that packs them. A 1080p chart can go out on a 4K or 8K raster
+        without building a full-size copy. Already packed frames are sent
+        as they are.
+
+        Parameters
+        ----------
+        fit : PlacementFit | str
+            How the frame is sized on the raster
+        filter_mode : PlacementFilter | str
+            Resampling filter
+        width, height : int
+            Output raster; 0 follows the display mode
+        crop : tuple[int, int, int, int] | None
+            Source rectangle (x, y, width, height) to place; None places
+            the whole frame
+        surround : tuple[int, int, int]
+            Code values around the placed image, in the output bit depth
+
+        Raises
+        ------
+        RuntimeError
+            If the device is not open or the settings are invalid
+        """
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        crop_x, crop_y, crop_width, crop_height = crop or (0, 0, 0, 0)
+        config = PlacementConfig(
+            enabled=1,
+            width=width,
+            height=height,
+            fit=PlacementFit(fit).int_value,
+            filter=PlacementFilter(filter_mode).int_value,
+            cropX=crop_x,
+            cropY=crop_y,
+            cropWidth=crop_width,
+            cropHeight=crop_height,
+            surround=(ctypes.c_uint16 * 3)(*surround),
         )
-        formats = []
-        for i in range(count):
-            name = ctypes.create_string_buffer(256)
-            if (
-                DecklinkSDKWrapper.decklink_get_supported_pixel_format_name(
-                    self.handle, i, name, 256
-                )
-                == 0
-            ):
-                format_string = name.value.decode("utf-8")
-                try:
-                    # Try to parse the format string to a PixelFormatType enum
-                    # First try direct parsing, then try extracting format codes from parentheses
-                    try:
-                        pixel_format = PixelFormatType.parse(format_string)
-                    except ValueError as e:
-                        # Try to extract format code from strings like "8Bit ARGB (32)" or "12Bit RGB LE ('R12L')"
-                        # Look for format codes in parentheses, both with and without quotes
-                        match = re.search(r"\((?:'([^']+)'|([^)]+))\)", format_string)
-                        if match:
-                            format_code = match.group(1) or match.group(2)
-                            pixel_format = PixelFormatType.parse(format_code)
-                        else:
-                            raise ValueError(
-                                f"Could not extract format code from: {format_string}"
-                            ) from e
+        res = DecklinkSDKWrapper.decklink_set_placement(
+            self.handle, ctypes.byref(config)
+        )
+        if res != 0:
+            raise RuntimeError(f"Invalid placement (error {res})")
 
-                    formats.append(pixel_format)
-                except ValueError:
-                    # Print warning and ask user to report unknown format
-                    print(
-                        f"⚠️  WARNING: Unknown pixel format detected: '{format_string}'"
-                    )
-                    print(
-                        "📝 Please help improve this project by reporting this unknown format:"
-                    )
-                    print(f"   1. Copy this exact string: '{format_string}'")
-                    print(
-                        "   2. Create a new issue at: https://github.com/OpenLEDEval/bmd-signal-gen/issues"
-                    )
-                    print(
-                        "   3. Include your device model and the unknown format string"
-                    )
-                    print("   This format will be skipped for now.")
-                    print()
-        return formats
+    def clear_placement(self) -> None:
+        """
+        Send frames at their own size again (the default).
 
-    @property
-    def supports_hdr(self) -> bool:
-        return DecklinkSDKWrapper.decklink_device_supports_hdr(self.handle)
+        Raises
+        ------
+        RuntimeError
+            If the device is not open
+        """
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        config = PlacementConfig()
+        DecklinkSDKWrapper.decklink_set_placement(self.handle, ctypes.byref(config))
 
-    @property
-    def pixel_format(self) -> PixelFormatType:
+    def placement(self) -> PlacementConfig:
         """
-        Get the current pixel format as a PixelFormatType enum.
+        Get the placement settings.
 
         Returns
         -------
-        PixelFormatType
-            Current pixel format enum value
+        PlacementConfig
+            Current settings; ``enabled`` is 0 when frames are not placed
 
         Raises
         ------
         RuntimeError
-            If the device is not open
-        ValueError
-            If the SDK format code cannot be matched to a known PixelFormatType
+            If the device is not open or the query fails
         """
         if not self.handle:
             raise RuntimeError("Device not open")
-        sdk_format_code = DecklinkSDKWrapper.decklink_get_pixel_format(self.handle)
-        return PixelFormatType.parse(sdk_format_code)
+        config = PlacementConfig()
+        res = DecklinkSDKWrapper.decklink_get_placement(
+            self.handle, ctypes.byref(config)
+        )
+        if res != 0:
+            raise RuntimeError(f"Failed to get placement (error {res})")
+        return config
 
-    @pixel_format.setter
-    def pixel_format(self, pixel_format_type: PixelFormatType) -> None:
+    def _hold_packed_frame(self, data: np.ndarray) -> int:
+        """Keep data alive until the library releases its token."""
+        with self._packed_lock:
+            token = next(self._packed_tokens)
+            self._packed_frames[token] = data
+        return token
+
+    def _drop_packed_frame(self, token: int) -> None:
+        with self._packed_lock:
+            self._packed_frames.pop(token, None)
+
+    @property
+    def packed_frames_in_flight(self) -> int:
         """
-        Set the pixel format using a PixelFormatType enum.
+        Number of packed frames the library still references.
+
+        Returns
+        -------
+        int
+            Arrays passed to ``display_packed_frame`` or
+            ``schedule_packed_frame`` that must not be modified yet
+        """
+        with self._packed_lock:
+            return len(self._packed_frames)
+
+    def display_packed_frame(
+        self,
+        data: np.ndarray,
+        width: int,
+        pixel_format: PixelFormatType | None = None,
+    ) -> None:
+        """
+        Display an already packed frame synchronously, without copying it.
+
+        The device reads ``data`` in place, so the array is referenced (and
+        must not be written to) until the next frame replaces it. No
+        statistics are computed and overlays are not composited.
 
         Parameters
         ----------
-        pixel_format_type : PixelFormatType
-            The pixel format enum to set
+        data : numpy.ndarray
+            uint8 array of shape (height, row_bytes) in the device's pixel
+            format, e.g. a frame recorded from an earlier run
+        width : int
+            Frame width in pixels
+        pixel_format : PixelFormatType | None, optional
+            Format of the payload; must match the active format. None
+            assumes the active format.
 
         Raises
         ------
         RuntimeError
-            If the device is not open or setting the format fails
+            If the device is not open, the format does not match the active
+            one, rows are too short, or the display fails
+        ValueError
+            If data is not a 2D uint8 array with contiguous rows
         """
         if not self.handle:
             raise RuntimeError("Device not open")
-        res = DecklinkSDKWrapper.decklink_set_pixel_format(
-            self.handle, pixel_format_type.sdk_format_code
+        desc = packed_frame_desc(data, width, pixel_format)
+        token = self._hold_packed_frame(data)
+        res = DecklinkSDKWrapper.decklink_display_external_frame(
+            self.handle, ctypes.byref(desc), self._release_packed, token
         )
         if res != 0:
-            raise RuntimeError(
-                f"Failed to set pixel format {pixel_format_type.name} (error {res})"
-            )
+            self._drop_packed_frame(token)
+            raise RuntimeError(f"Failed to display packed frame (error {res})")
 
-    def set_hdr_metadata(self, metadata: HDRMetadata) -> None:
+    def schedule_packed_frame(
+        self,
+        data: np.ndarray,
+        width: int,
+        at_ns: int = 0,
+        duration_frames: int = 1,
+        pixel_format: PixelFormatType | None = None,
+        hdr_metadata: HDRMetadata | int | None = None,
+    ) -> SchedulerDecisionRecord:
         """
-        Set complete HDR metadata for all future frames.
+        Queue an already packed frame for a presentation time, without copying.
+
+        Same decisions as ``schedule_frame``. The array is referenced until
+        the device has shown it or the frame is dropped; see
+        ``packed_frames_in_flight``.
 
         Parameters
         ----------
-        metadata : HDRMetadata
-            HDR metadata structure with complete HDR parameters
+        data : numpy.ndarray
+            uint8 array of shape (height, row_bytes) in the device's pixel
+            format
+        width : int
+            Frame width in pixels
+        at_ns : int, optional
+            Presentation time in nanoseconds on the stream clock; 0 for the
+            next free slot
+        duration_frames : int, optional
+            Slots to show the frame for. Default is 1.
+        pixel_format : PixelFormatType | None, optional
+            Format of the payload; None assumes the active format
+        hdr_metadata : HDRMetadata | int | None, optional
+            Metadata this frame carries, as values or an id from
+            ``intern_hdr_metadata()``; None for the current metadata.
+
+        Returns
+        -------
+        SchedulerDecisionRecord
+            Decision taken for the frame
 
         Raises
         ------
         RuntimeError
-            If the device is not open or setting metadata fails
+            If the device is not open, the scheduler is not running, the
+            metadata id is unknown, or the frame does not match the active
+            format
+        ValueError
+            If data is not a 2D uint8 array with contiguous rows
         """
         if not self.handle:
             raise RuntimeError("Device not open")
-        res = DecklinkSDKWrapper.decklink_set_hdr_metadata(
-            self.handle, ctypes.byref(metadata)
+        desc = packed_frame_desc(data, width, pixel_format)
+        metadata_id = self._hdr_metadata_id(hdr_metadata)
+        token = self._hold_packed_frame(data)
+        record = SchedulerDecisionRecord()
+        res = DecklinkSDKWrapper.decklink_schedule_external_frame_hdr(
+            self.handle,
+            ctypes.byref(desc),
+            self._release_packed,
+            token,
+            at_ns,
+            duration_frames,
+            metadata_id,
+            ctypes.byref(record),
         )
         if res != 0:
-            raise RuntimeError(f"Failed to set HDR metadata (error {res})")
+            self._drop_packed_frame(token)
+            raise RuntimeError(f"Failed to schedule packed frame (error {res})")
+        return record
 
-    def display_frame(self, frame_data: np.ndarray) -> None:
+    @traced("display_frame", "device", frame=True)
+    def display_frame(self, frame_data: np.ndarray) -> FrameStats | None:
         """
         Display a single frame synchronously.
 
+        With pipelined output enabled (``set_pipelined_output``) the frame is
+        queued instead and the call returns once the library has copied it.
+
         Parameters
         ----------
         frame_data : numpy.ndarray
             Frame data with shape (height, width, channels) or (height, width)
 
+        Returns
+        -------
+        FrameStats | None
+            Statistics of the displayed frame, or None when pipelined or
+            statistics are disabled
+
         Raises
         ------
         RuntimeError
@@ -1419,11 +5422,21 @@ class BMDDeckLink:
         if not self.handle:
             raise RuntimeError("Device not open")
 
-        frame_data = np.astype(frame_data, np.uint16, copy=True)
+        # The library copies the data, so only convert when needed
+        frame_data = np.astype(frame_data, np.uint16, copy=False)
         frame_data = np.ascontiguousarray(frame_data)
+        data_ptr, height, width = ndarray_to_bmd_frame_buffer(frame_data)
+
+        if self.pipelined:
+            # Queued; errors of earlier frames surface on a later call
+            res = DecklinkSDKWrapper.decklink_submit_frame(
+                self.handle, data_ptr, width, height
+            )
+            if res != 0:
+                raise RuntimeError(f"Pipelined output failed (error {res})")
+            return None
 
         # Set frame data
-        data_ptr, height, width = ndarray_to_bmd_frame_buffer(frame_data)
         res = DecklinkSDKWrapper.decklink_set_frame_data(
             self.handle, data_ptr, width, height
         )
@@ -1439,3 +5452,48 @@ class BMDDeckLink:
         res = DecklinkSDKWrapper.decklink_display_frame_sync(self.handle)
         if res != 0:
             raise RuntimeError(f"Failed to display frame synchronously (error {res})")
+
+        stats = self.frame_stats()
+        return stats if stats.valid else None
+
+    @traced("update_frame_regions", "device", frame=True)
+    def update_frame_regions(
+        self,
+        frame_data: np.ndarray,
+        regions: Sequence[tuple[int, int, int, int]],
+    ) -> None:
+        """
+        Re-display the current frame with some rectangles replaced.
+
+        Only the given rectangles are read from ``frame_data``, and only the
+        output rows they affect are repacked; the rest of the frame on
+        screen is reused as it was packed. Overlays are composited as usual.
+
+        Parameters
+        ----------
+        frame_data : numpy.ndarray
+            The whole new frame, the same size as the one displayed
+        regions : Sequence[tuple[int, int, int, int]]
+            Changed rectangles as (x, y, width, height)
+
+        Raises
+        ------
+        RuntimeError
+            If the device is not open, no frame of this size is displayed,
+            a region lies outside the frame, or the update fails
+        ValueError
+            If frame_data is not a valid numpy array
+        """
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        frame_data = np.astype(frame_data, np.uint16, copy=False)
+        frame_data = np.ascontiguousarray(frame_data)
+        data_ptr, height, width = ndarray_to_bmd_frame_buffer(frame_data)
+        array = (FrameRegion * max(len(regions), 1))(
+            *(FrameRegion(*region) for region in regions)
+        )
+        res = DecklinkSDKWrapper.decklink_update_frame_regions(
+            self.handle, data_ptr, width, height, array, len(regions)
+        )
+        if res != 0:
+            raise RuntimeError(f"Failed to update frame regions (error {res})")
@@ -82,15 +82,467 @@ class DecklinkSDKProtocol(Protocol):
         """Get current pixel format index."""
         ...
 
+    def decklink_benchmark_pixel_format(
+        self,
+        handle: ctypes.c_void_p,
+        pixel_format_code: int,
+        iterations: int,
+        ns_per_frame: Any,
+    ) -> int:
+        """Measure pack cost of a pixel format at the active display mode."""
+        ...
+
+    # Display mode functions
+    def decklink_get_display_mode(self, handle: ctypes.c_void_p) -> int:
+        """Get the active display mode code."""
+        ...
+
     # HDR metadata functions
     def decklink_set_hdr_metadata(self, handle: ctypes.c_void_p, metadata: Any) -> int:
         """Set complete HDR metadata."""
         ...
 
+    def decklink_intern_hdr_metadata(
+        self, handle: ctypes.c_void_p, metadata: Any
+    ) -> int:
+        """Intern HDR metadata for per-frame use; returns its id (from 1)."""
+        ...
+
+    def decklink_clear_hdr_metadata_table(self, handle: ctypes.c_void_p) -> int:
+        """Drop every interned HDR metadata entry."""
+        ...
+
+    def decklink_get_hdr_metadata_table_stats(
+        self, handle: ctypes.c_void_p, stats: Any
+    ) -> int:
+        """Copy the HDRMetadataTableStats of the interned metadata."""
+        ...
+
     def decklink_device_supports_hdr(self, handle: ctypes.c_void_p) -> bool:
         """Check if device supports HDR metadata."""
         ...
 
+    # In-place reconfiguration functions
+    def decklink_reconfigure(self, handle: ctypes.c_void_p, config: Any) -> int:
+        """Apply only the differences between config and the active output."""
+        ...
+
+    def decklink_get_reconfigure_stats(
+        self, handle: ctypes.c_void_p, stats: Any
+    ) -> int:
+        """Get statistics for the most recent reconfiguration."""
+        ...
+
+    # Thread placement and real-time scheduling functions
+    def decklink_set_thread_policy(self, handle: ctypes.c_void_p, config: Any) -> int:
+        """Set output thread, packing worker and memory locking policy."""
+        ...
+
+    def decklink_apply_output_thread_policy(self, handle: ctypes.c_void_p) -> int:
+        """Pin and schedule the calling thread as the output thread."""
+        ...
+
+    def decklink_get_thread_policy_status(
+        self, handle: ctypes.c_void_p, status: Any
+    ) -> int:
+        """Get the thread policy currently in effect."""
+        ...
+
+    # Frame timing analysis functions
+    def decklink_get_frame_timing_report(
+        self, handle: ctypes.c_void_p, report: Any
+    ) -> int:
+        """Get inter-frame interval and latency statistics."""
+        ...
+
+    def decklink_get_frame_timing_outliers(
+        self, handle: ctypes.c_void_p, outliers: Any, max_count: int
+    ) -> int:
+        """Copy the most recent outliers; returns the number copied."""
+        ...
+
+    def decklink_reset_frame_timing(self, handle: ctypes.c_void_p) -> int:
+        """Clear frame timing statistics."""
+        ...
+
+    def decklink_set_frame_timing_threshold(
+        self, handle: ctypes.c_void_p, threshold: float
+    ) -> int:
+        """Set the outlier threshold as a fraction of the frame duration."""
+        ...
+
+    # Memory accounting functions
+    def decklink_get_memory_stats(self, stats: Any, max_count: int) -> int:
+        """Copy per-subsystem memory stats; returns the number copied."""
+        ...
+
+    def decklink_reset_memory_peaks(self) -> int:
+        """Reset every subsystem's peak to its current usage."""
+        ...
+
+    # Span tracing functions
+    def decklink_trace_set_enabled(self, enabled: bool) -> int:
+        """Turn span tracing on (dropping leftover spans) or off."""
+        ...
+
+    def decklink_trace_now_ns(self) -> int:
+        """Current time on the clock spans are recorded with."""
+        ...
+
+    def decklink_trace_set_frame(self, frame_id: int) -> int:
+        """Set the frame id of the calling thread's spans (0 for none)."""
+        ...
+
+    def decklink_trace_collect(self, spans: Any, max_count: int) -> int:
+        """Move recorded TraceSpans out of the library; returns the number."""
+        ...
+
+    def decklink_trace_get_threads(self, threads: Any, max_count: int) -> int:
+        """Copy the TraceThreads that have recorded; returns the number."""
+        ...
+
+    def decklink_trace_get_stats(self, stats: Any) -> int:
+        """Copy the TraceStats."""
+        ...
+
+    # Packed-domain overlay functions
+    def decklink_add_overlay(
+        self,
+        handle: ctypes.c_void_p,
+        x: int,
+        y: int,
+        width: int,
+        height: int,
+        rgba: Any,
+        enabled: bool,
+    ) -> int:
+        """Add an RGBA sprite overlay; returns its id (> 0)."""
+        ...
+
+    def decklink_remove_overlay(self, handle: ctypes.c_void_p, overlay_id: int) -> int:
+        """Remove an overlay (-2 if the id is unknown)."""
+        ...
+
+    def decklink_set_overlay_enabled(
+        self, handle: ctypes.c_void_p, overlay_id: int, enabled: bool
+    ) -> int:
+        """Show or hide an overlay."""
+        ...
+
+    def decklink_move_overlay(
+        self, handle: ctypes.c_void_p, overlay_id: int, x: int, y: int
+    ) -> int:
+        """Move an overlay."""
+        ...
+
+    def decklink_clear_overlays(self, handle: ctypes.c_void_p) -> int:
+        """Remove all overlays."""
+        ...
+
+    def decklink_update_overlays(self, handle: ctypes.c_void_p) -> int:
+        """Re-display the current frame with the current overlays."""
+        ...
+
+    def decklink_set_pipelined_output(
+        self, handle: ctypes.c_void_p, enabled: bool
+    ) -> int:
+        """Switch pipelined (pack-while-display) output on or off."""
+        ...
+
+    def decklink_submit_frame(
+        self, handle: ctypes.c_void_p, data: Any, width: int, height: int
+    ) -> int:
+        """Queue a frame for pipelined packing and display."""
+        ...
+
+    def decklink_flush_output(self, handle: ctypes.c_void_p) -> int:
+        """Wait for pipelined frames to be displayed; returns the last error."""
+        ...
+
+    def decklink_get_pipeline_stats(self, handle: ctypes.c_void_p, stats: Any) -> int:
+        """Copy the PipelineStats of pipelined output."""
+        ...
+
+    def decklink_start_frc(self, handle: ctypes.c_void_p, config: Any) -> int:
+        """Start temporal dithering from an FrcConfig."""
+        ...
+
+    def decklink_stop_frc(self, handle: ctypes.c_void_p) -> int:
+        """Stop temporal dithering."""
+        ...
+
+    def decklink_get_frc_status(self, handle: ctypes.c_void_p, status: Any) -> int:
+        """Copy the FrcStatus of the running or last FRC patch."""
+        ...
+
+    def decklink_plan_frc(
+        self, config: Any, max_code: int, status: Any, upper: Any
+    ) -> int:
+        """Compute the FRC levels and cycle layout without a device."""
+        ...
+
+    def decklink_start_scheduler(self, handle: ctypes.c_void_p, config: Any) -> int:
+        """Start deadline-aware scheduled output from a SchedulerConfig."""
+        ...
+
+    def decklink_stop_scheduler(self, handle: ctypes.c_void_p) -> int:
+        """Stop deadline-aware scheduled output."""
+        ...
+
+    def decklink_schedule_frame(
+        self,
+        handle: ctypes.c_void_p,
+        data: Any,
+        width: int,
+        height: int,
+        target_ns: int,
+        duration_frames: int,
+        record: Any,
+    ) -> int:
+        """Pack a frame for a presentation time; the decision goes to record."""
+        ...
+
+    def decklink_schedule_frame_hdr(
+        self,
+        handle: ctypes.c_void_p,
+        data: Any,
+        width: int,
+        height: int,
+        target_ns: int,
+        duration_frames: int,
+        hdr_metadata_id: int,
+        record: Any,
+    ) -> int:
+        """decklink_schedule_frame with interned HDR metadata (0 for current)."""
+        ...
+
+    def decklink_get_scheduler_stats(self, handle: ctypes.c_void_p, stats: Any) -> int:
+        """Copy the SchedulerStats of deadline-aware output."""
+        ...
+
+    def decklink_get_scheduler_decisions(
+        self, handle: ctypes.c_void_p, records: Any, max_count: int
+    ) -> int:
+        """Copy recent SchedulerDecisionRecords; returns how many."""
+        ...
+
+    def decklink_get_scheduler_lead_changes(
+        self, handle: ctypes.c_void_p, changes: Any, max_count: int
+    ) -> int:
+        """Copy recent SchedulerLeadChanges; returns how many."""
+        ...
+
+    def decklink_start_stream(self, handle: ctypes.c_void_p, config: Any) -> int:
+        """Start displaying raw frames read from StreamConfig.fd."""
+        ...
+
+    def decklink_stop_stream(self, handle: ctypes.c_void_p) -> int:
+        """Stop the raw frame stream."""
+        ...
+
+    def decklink_get_stream_stats(self, handle: ctypes.c_void_p, stats: Any) -> int:
+        """Copy the StreamStats of the running or last stream."""
+        ...
+
+    def decklink_start_recording(
+        self, handle: ctypes.c_void_p, path: bytes, config: Any
+    ) -> int:
+        """Start recording every packed output frame to path."""
+        ...
+
+    def decklink_stop_recording(self, handle: ctypes.c_void_p) -> int:
+        """Write the frames already copied and close the recording."""
+        ...
+
+    def decklink_get_recorder_stats(self, handle: ctypes.c_void_p, stats: Any) -> int:
+        """Copy the RecorderStats of the running or last recording."""
+        ...
+
+    def decklink_play_recording(self, handle: ctypes.c_void_p, path: bytes) -> int:
+        """Replay a recording in a loop through the clip player."""
+        ...
+
+    def decklink_stop_replay(self, handle: ctypes.c_void_p) -> int:
+        """Stop replaying a recording."""
+        ...
+
+    def decklink_get_replay_stats(self, handle: ctypes.c_void_p, stats: Any) -> int:
+        """Copy the ClipPlaybackStats of the running or last replay."""
+        ...
+
+    def decklink_recorder_create(self) -> ctypes.c_void_p:
+        """Create a recorder for frames the caller provides."""
+        ...
+
+    def decklink_recorder_destroy(self, recorder: ctypes.c_void_p) -> None:
+        """Stop and free a recorder."""
+        ...
+
+    def decklink_recorder_start(
+        self,
+        recorder: ctypes.c_void_p,
+        path: bytes,
+        config: Any,
+        max_frame_bytes: int,
+        display_mode: int,
+        pixel_format: int,
+        frame_interval_ns: int,
+    ) -> int:
+        """Create a recording at path and start its writer."""
+        ...
+
+    def decklink_recorder_record(
+        self, recorder: ctypes.c_void_p, data: Any, frame: Any
+    ) -> int:
+        """Copy a frame and its RecordedFrame to be written."""
+        ...
+
+    def decklink_recorder_stop(self, recorder: ctypes.c_void_p) -> int:
+        """Write the frames already copied and close the recording."""
+        ...
+
+    def decklink_recorder_get_stats(self, recorder: ctypes.c_void_p, stats: Any) -> int:
+        """Copy the RecorderStats of a recorder."""
+        ...
+
+    def decklink_plan_replay(
+        self,
+        path: bytes,
+        pixel_format: int,
+        frame_interval_ns: int,
+        frames: Any,
+        sequence: Any,
+        max_count: int,
+    ) -> int:
+        """Lay out a recording's replay; returns the sequence length."""
+        ...
+
+    def decklink_set_frame_stats(self, handle: ctypes.c_void_p, mode: int) -> int:
+        """Set per-frame statistics off (0), on (1) or on with HDR auto-fill (2)."""
+        ...
+
+    def decklink_get_frame_stats(self, handle: ctypes.c_void_p, stats: Any) -> int:
+        """Copy the FrameStats of the most recently packed frame."""
+        ...
+
+    def decklink_set_thumbnail_config(
+        self, handle: ctypes.c_void_p, config: Any
+    ) -> int:
+        """Apply a ThumbnailConfig; width 0 disables thumbnails."""
+        ...
+
+    def decklink_get_thumbnail_config(
+        self, handle: ctypes.c_void_p, config: Any
+    ) -> int:
+        """Copy the current ThumbnailConfig."""
+        ...
+
+    def decklink_get_thumbnail(
+        self, handle: ctypes.c_void_p, rgb: Any, capacity: int, info: Any
+    ) -> int:
+        """Copy the latest RGB8 thumbnail; returns its size, 0 if none yet."""
+        ...
+
+    def decklink_display_external_frame(
+        self, handle: ctypes.c_void_p, desc: Any, release: Any, context: Any
+    ) -> int:
+        """Display an ExternalFrameDesc in place; release(context) runs later."""
+        ...
+
+    def decklink_schedule_external_frame(
+        self,
+        handle: ctypes.c_void_p,
+        desc: Any,
+        release: Any,
+        context: Any,
+        target_ns: int,
+        duration_frames: int,
+        record: Any,
+    ) -> int:
+        """Queue an ExternalFrameDesc in place; the decision goes to record."""
+        ...
+
+    def decklink_schedule_external_frame_hdr(
+        self,
+        handle: ctypes.c_void_p,
+        desc: Any,
+        release: Any,
+        context: Any,
+        target_ns: int,
+        duration_frames: int,
+        hdr_metadata_id: int,
+        record: Any,
+    ) -> int:
+        """decklink_schedule_external_frame with interned HDR metadata."""
+        ...
+
+    def decklink_cache_frame(
+        self, handle: ctypes.c_void_p, key: int, data: Any, width: int, height: int
+    ) -> int:
+        """Pack RGB frame data into the frame cache under key."""
+        ...
+
+    def decklink_cache_packed_frame(
+        self, handle: ctypes.c_void_p, key: int, desc: Any
+    ) -> int:
+        """Copy an ExternalFrameDesc into the frame cache under key."""
+        ...
+
+    def decklink_display_cached_frame(self, handle: ctypes.c_void_p, key: int) -> int:
+        """Display a cached frame synchronously."""
+        ...
+
+    def decklink_schedule_cached_frame(
+        self,
+        handle: ctypes.c_void_p,
+        key: int,
+        target_ns: int,
+        duration_frames: int,
+        record: Any,
+    ) -> int:
+        """Queue a cached frame; the decision goes to record."""
+        ...
+
+    def decklink_schedule_cached_frame_hdr(
+        self,
+        handle: ctypes.c_void_p,
+        key: int,
+        target_ns: int,
+        duration_frames: int,
+        hdr_metadata_id: int,
+        record: Any,
+    ) -> int:
+        """decklink_schedule_cached_frame with interned HDR metadata."""
+        ...
+
+    def decklink_remove_cached_frame(self, handle: ctypes.c_void_p, key: int) -> int:
+        """Drop one frame cache entry; -1 if there is none."""
+        ...
+
+    def decklink_clear_frame_cache(self, handle: ctypes.c_void_p) -> int:
+        """Drop every frame cache entry."""
+        ...
+
+    def decklink_set_frame_cache_hot_frames(
+        self, handle: ctypes.c_void_p, capacity: int
+    ) -> int:
+        """Set how many recently used cache entries stay decoded."""
+        ...
+
+    def decklink_get_frame_cache_stats(
+        self, handle: ctypes.c_void_p, stats: Any
+    ) -> int:
+        """Copy the FrameCacheStats."""
+        ...
+
+    def decklink_set_placement(self, handle: ctypes.c_void_p, config: Any) -> int:
+        """Apply a PlacementConfig; enabled 0 sends frames at their own size."""
+        ...
+
+    def decklink_get_placement(self, handle: ctypes.c_void_p, config: Any) -> int:
+        """Copy the current PlacementConfig."""
+        ...
+
     # Frame data management functions
     def decklink_set_frame_data(
         self,
@@ -102,6 +554,18 @@ class DecklinkSDKProtocol(Protocol):
         """Set frame data."""
         ...
 
+    def decklink_update_frame_regions(
+        self,
+        handle: ctypes.c_void_p,
+        data: Any,
+        width: int,
+        height: int,
+        regions: Any,
+        count: int,
+    ) -> int:
+        """Replace FrameRegions of the current frame and re-display it."""
+        ...
+
     # Frame management functions
     def decklink_create_frame_from_data(self, handle: ctypes.c_void_p) -> int:
         """Create frame from pending data."""
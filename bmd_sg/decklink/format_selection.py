@@ -0,0 +1,288 @@
+"""
+Cost-model pixel format selection.
+
+Picks the pixel format that is cheapest to pack at the active display mode
+while preserving a required bit depth. Pack costs are measured once per host,
+device and display mode by packing a synthetic frame in the C++ library, and
+cached as JSON so later runs select instantly.
+
+Only formats the device reports as supported without output conversion are
+considered, so the chosen format never triggers a driver-side conversion.
+Formats the library has no packer for (the YUV formats) fail the benchmark
+and are excluded.
+"""
+
+import json
+import socket
+from dataclasses import dataclass
+from pathlib import Path
+from typing import Any
+
+from bmd_sg.decklink.bmd_decklink import PixelFormatType
+from bmd_sg.utilities import suppress_cpp_output
+
+DEFAULT_CACHE_PATH = Path.home() / ".cache" / "bmd-signal-gen" / "format_costs.json"
+DEFAULT_BENCHMARK_ITERATIONS = 5
+
+
+@dataclass(frozen=True)
+class FormatCost:
+    """
+    Measured pack cost for one pixel format.
+
+    Parameters
+    ----------
+    pixel_format : PixelFormatType
+        The benchmarked pixel format.
+    ns_per_frame : float
+        Best observed time to pack one frame, in nanoseconds.
+    """
+
+    pixel_format: PixelFormatType
+    ns_per_frame: float
+
+    @property
+    def ms_per_frame(self) -> float:
+        """Pack cost in milliseconds per frame."""
+        return self.ns_per_frame / 1e6
+
+
+def format_cost_cache_key(device_name: str, display_mode: int) -> str:
+    """
+    Build the cache key for a host, device and display mode.
+
+    The hostname is part of the key so a cache file on a shared home
+    directory never hands one machine's measurements to another.
+
+    Parameters
+    ----------
+    device_name : str
+        DeckLink device display name.
+    display_mode : int
+        BMDDisplayMode four-character code.
+
+    Returns
+    -------
+    str
+        Cache key.
+    """
+    return f"{socket.gethostname()}|{device_name}|{display_mode:08X}"
+
+
+def _read_cache(cache_path: Path) -> dict[str, Any]:
+    try:
+        return json.loads(cache_path.read_text())
+    except (OSError, ValueError):
+        return {}
+
+
+def load_format_costs(
+    key: str, cache_path: Path = DEFAULT_CACHE_PATH
+) -> list[FormatCost]:
+    """
+    Load cached pack costs for a cache key.
+
+    Parameters
+    ----------
+    key : str
+        Cache key from ``format_cost_cache_key``.
+    cache_path : Path, optional
+        JSON cache file. Default is ``~/.cache/bmd-signal-gen/format_costs.json``.
+
+    Returns
+    -------
+    list[FormatCost]
+        Cached costs, empty if nothing usable is cached.
+    """
+    entry = _read_cache(cache_path).get(key, {})
+    costs = []
+    for code, ns in entry.get("costs_ns", {}).items():
+        try:
+            costs.append(FormatCost(PixelFormatType.parse(code), float(ns)))
+        except ValueError:
+            continue
+    return costs
+
+
+def store_format_costs(
+    key: str,
+    costs: list[FormatCost],
+    selected: dict[int, PixelFormatType] | None = None,
+    cache_path: Path = DEFAULT_CACHE_PATH,
+) -> None:
+    """
+    Store measured pack costs (and selections made from them) for a cache key.
+
+    Parameters
+    ----------
+    key : str
+        Cache key from ``format_cost_cache_key``.
+    costs : list[FormatCost]
+        Measured costs to cache.
+    selected : dict[int, PixelFormatType] | None, optional
+        Selected format per required bit depth, recorded for reporting.
+    cache_path : Path, optional
+        JSON cache file.
+    """
+    cache = _read_cache(cache_path)
+    entry = cache.setdefault(key, {})
+    entry["costs_ns"] = {c.pixel_format.value: c.ns_per_frame for c in costs}
+    if selected:
+        entry.setdefault("selected", {}).update(
+            {str(depth): fmt.value for depth, fmt in selected.items()}
+        )
+    try:
+        cache_path.parent.mkdir(parents=True, exist_ok=True)
+        cache_path.write_text(json.dumps(cache, indent=2, sort_keys=True))
+    except OSError as e:
+        print(f"Warning: could not write pixel format cost cache {cache_path}: {e}")
+
+
+def measure_format_costs(
+    decklink: Any,
+    formats: list[PixelFormatType],
+    iterations: int = DEFAULT_BENCHMARK_ITERATIONS,
+) -> list[FormatCost]:
+    """
+    Benchmark pack cost for each format at the device's active display mode.
+
+    Parameters
+    ----------
+    decklink : BMDDeckLink | MockBMDDeckLink
+        Open DeckLink device.
+    formats : list[PixelFormatType]
+        Formats to benchmark.
+    iterations : int, optional
+        Timed passes per format. Default is 5.
+
+    Returns
+    -------
+    list[FormatCost]
+        Costs for every format that could be packed; formats without a
+        packer are omitted.
+    """
+    costs = []
+    for pixel_format in formats:
+        try:
+            with suppress_cpp_output():
+                ns = decklink.benchmark_pixel_format(pixel_format, iterations)
+        except RuntimeError:
+            continue
+        costs.append(FormatCost(pixel_format, ns))
+    return costs
+
+
+def choose_cheapest_format(
+    costs: list[FormatCost],
+    supported: list[PixelFormatType],
+    min_bit_depth: int,
+) -> FormatCost | None:
+    """
+    Pick the cheapest supported format that preserves ``min_bit_depth``.
+
+    Ties are broken in favour of the higher bit depth.
+
+    Parameters
+    ----------
+    costs : list[FormatCost]
+        Measured pack costs.
+    supported : list[PixelFormatType]
+        Formats the device supports at the active display mode.
+    min_bit_depth : int
+        Minimum bit depth the chosen format must carry.
+
+    Returns
+    -------
+    FormatCost | None
+        The chosen format and its cost, or None if no format qualifies.
+    """
+    candidates = [
+        c
+        for c in costs
+        if c.pixel_format in supported and c.pixel_format.bit_depth >= min_bit_depth
+    ]
+    if not candidates:
+        return None
+    return min(candidates, key=lambda c: (c.ns_per_frame, -c.pixel_format.bit_depth))
+
+
+def select_pixel_format(
+    decklink: Any,
+    device_name: str,
+    min_bit_depth: int = 10,
+    cache_path: Path = DEFAULT_CACHE_PATH,
+    refresh: bool = False,
+) -> FormatCost:
+    """
+    Select the cheapest-to-pack pixel format that preserves a bit depth.
+
+    Costs are taken from the per-host cache when every supported format has
+    been measured for this device and display mode; otherwise the missing
+    formats are benchmarked and the cache is updated.
+
+    Parameters
+    ----------
+    decklink : BMDDeckLink | MockBMDDeckLink
+        Open DeckLink device.
+    device_name : str
+        DeckLink device display name, used in the cache key.
+    min_bit_depth : int, optional
+        Minimum bit depth to preserve. Default is 10.
+    cache_path : Path, optional
+        JSON cache file.
+    refresh : bool, optional
+        Ignore cached costs and re-measure. Default is False.
+
+    Returns
+    -------
+    FormatCost
+        The selected format and its measured pack cost.
+
+    Raises
+    ------
+    RuntimeError
+        If no supported, packable format carries ``min_bit_depth`` bits.
+
+    Examples
+    --------
+    >>> choice = select_pixel_format(device, "DeckLink 8K Pro", min_bit_depth=10)
+    >>> device.pixel_format = choice.pixel_format
+    """
+    supported = decklink.get_supported_pixel_formats()
+    key = format_cost_cache_key(device_name, decklink.display_mode)
+
+    costs = [] if refresh else load_format_costs(key, cache_path)
+    measured = {c.pixel_format for c in costs}
+    missing = [f for f in supported if f not in measured]
+    if missing:
+        # Formats that fail to pack are recorded too, as infinitely expensive,
+        # so they are not re-benchmarked on every run
+        new_costs = measure_format_costs(decklink, missing)
+        packed = {c.pixel_format for c in new_costs}
+        costs += new_costs
+        costs += [FormatCost(f, float("inf")) for f in missing if f not in packed]
+
+    choice = choose_cheapest_format(
+        [c for c in costs if c.ns_per_frame != float("inf")], supported, min_bit_depth
+    )
+    if choice is None:
+        raise RuntimeError(
+            f"No supported pixel format can be packed at {min_bit_depth}-bit or better"
+        )
+
+    if missing or refresh:
+        store_format_costs(key, costs, {min_bit_depth: choice.pixel_format}, cache_path)
+
+    return choice
+
+
+__all__ = [
+    "DEFAULT_CACHE_PATH",
+    "FormatCost",
+    "choose_cheapest_format",
+    "format_cost_cache_key",
+    "load_format_costs",
+    "measure_format_costs",
+    "select_pixel_format",
+    "store_format_costs",
+]
@@ -0,0 +1,132 @@
+"""
+Frame timing report formatting and export.
+
+The C++ library records the interval between consecutive frame completions and
+the latency from frame submission to completion for every displayed frame,
+histogrammed against the nominal frame duration of the display mode. This
+module turns a ``FrameTimingReport`` and its outliers into a JSON-serialisable
+dictionary and a human-readable text report.
+"""
+
+from typing import Any
+
+from bmd_sg.decklink.bmd_decklink import FrameTimingOutlier, FrameTimingReport
+
+
+def _bin_edges_ms(report: FrameTimingReport) -> list[float]:
+    """Lower edge of each histogram bin in milliseconds."""
+    width_ns = report.nominalIntervalNs / max(report.binsPerFrame, 1)
+    return [i * width_ns / 1e6 for i in range(report.histogramBins)]
+
+
+def frame_timing_to_dict(
+    report: FrameTimingReport, outliers: list[FrameTimingOutlier]
+) -> dict[str, Any]:
+    """
+    Convert a frame timing report to plain Python types.
+
+    Parameters
+    ----------
+    report : FrameTimingReport
+        Report from ``BMDDeckLink.frame_timing_report``
+    outliers : list[FrameTimingOutlier]
+        Outliers from ``BMDDeckLink.frame_timing_outliers``
+
+    Returns
+    -------
+    dict[str, Any]
+        Report with times in nanoseconds and histograms as lists of
+        ``{"from_ms", "count"}`` entries (empty bins omitted)
+    """
+    scalars = [
+        name
+        for name, _ in FrameTimingReport._fields_
+        if name not in ("intervalHistogram", "latencyHistogram")
+    ]
+    edges = _bin_edges_ms(report)
+    result: dict[str, Any] = {name: getattr(report, name) for name in scalars}
+    for name in ("intervalHistogram", "latencyHistogram"):
+        counts = getattr(report, name)[: report.histogramBins]
+        result[name] = [
+            {"from_ms": round(edge, 3), "count": count}
+            for edge, count in zip(edges, counts, strict=True)
+            if count
+        ]
+    result["outlierFrames"] = [
+        {name: getattr(o, name) for name, _ in FrameTimingOutlier._fields_}
+        for o in outliers
+    ]
+    return result
+
+
+def format_frame_timing(
+    report: FrameTimingReport,
+    outliers: list[FrameTimingOutlier],
+    bar_width: int = 40,
+) -> list[str]:
+    """
+    Format a frame timing report as text lines.
+
+    Parameters
+    ----------
+    report : FrameTimingReport
+        Report from ``BMDDeckLink.frame_timing_report``
+    outliers : list[FrameTimingOutlier]
+        Outliers from ``BMDDeckLink.frame_timing_outliers``
+    bar_width : int, optional
+        Width of the longest histogram bar. Default is 40.
+
+    Returns
+    -------
+    list[str]
+        Summary, interval histogram and outlier list
+    """
+    nominal_ms = report.nominalIntervalNs / 1e6
+    lines = [
+        f"Nominal frame interval: {nominal_ms:.3f} ms",
+        f"Frames: {report.frames}  intervals: {report.intervals}  "
+        f"idle gaps: {report.idleGaps}",
+    ]
+    if report.intervals:
+        lines.append(
+            f"Interval: min {report.minIntervalNs / 1e6:.3f}  "
+            f"mean {report.meanIntervalNs / 1e6:.3f}  "
+            f"max {report.maxIntervalNs / 1e6:.3f}  "
+            f"stddev {report.stddevIntervalNs / 1e6:.3f} ms"
+        )
+    if report.meanLatencyNs:
+        lines.append(
+            f"Submit-to-display latency: min {report.minLatencyNs / 1e6:.3f}  "
+            f"mean {report.meanLatencyNs / 1e6:.3f}  "
+            f"max {report.maxLatencyNs / 1e6:.3f} ms"
+        )
+    lines.append(
+        f"Outliers (> {1 + report.outlierThreshold:.2f} frames): "
+        f"{report.outliers}  estimated missed frames: {report.missedFrames}"
+    )
+
+    counts = list(report.intervalHistogram[: report.histogramBins])
+    peak = max(counts, default=0)
+    if peak:
+        lines.append("Interval histogram (frames):")
+        last = report.histogramBins - 1
+        for i, count in enumerate(counts):
+            if not count:
+                continue
+            low = i / report.binsPerFrame
+            label = (
+                f">= {low:5.3f}"
+                if i == last
+                else f"{low:5.3f}-{low + 1 / report.binsPerFrame:5.3f}"
+            )
+            bar = "#" * max(1, round(count * bar_width / peak))
+            lines.append(f"  {label:>13} {count:>8} {bar}")
+
+    if outliers:
+        lines.append("Recent outliers:")
+        lines.extend(
+            f"  frame {o.frameIndex}: {o.intervalNs / 1e6:.3f} ms gap "
+            f"at t={o.completionNs / 1e9:.6f} s"
+            for o in outliers
+        )
+    return lines
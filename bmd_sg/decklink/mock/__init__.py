@@ -31,6 +31,7 @@ from bmd_sg.decklink.mock.mock_decklink import (
     reset_mock_state,
     set_available_devices,
     set_hdr_support,
+    set_rejected_display_modes,
     set_supported_formats,
 )
 
@@ -43,5 +44,6 @@ __all__ = [
     "reset_mock_state",
     "set_available_devices",
     "set_hdr_support",
+    "set_rejected_display_modes",
     "set_supported_formats",
 ]
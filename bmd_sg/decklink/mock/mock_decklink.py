@@ -6,16 +6,65 @@ and related module functions to enable development and testing without physical
 """
 
 import contextlib
+import ctypes
+import os
+import threading
+import time
+from collections import OrderedDict
+from collections.abc import Sequence
+from pathlib import Path
 from typing import Any, ClassVar
 from unittest.mock import MagicMock, patch
 
 import numpy as np
 
 from bmd_sg.decklink.bmd_decklink import (
+    FRAME_TIMING_BINS,
+    FRAME_TIMING_MAX_OUTLIERS,
+    MEMORY_SUBSYSTEMS,
+    ClipPlaybackStats,
+    FrameCacheStats,
+    FrameStats,
+    FrameTimingOutlier,
+    FrameTimingReport,
+    FrcStatus,
     HDRMetadata,
+    HDRMetadataTableStats,
+    PipelineStats,
     PixelFormatType,
+    PlacementConfig,
+    PlacementFilter,
+    PlacementFit,
+    ReconfigureStats,
+    RecordedFrame,
+    RecorderStats,
+    RecordingWriter,
+    SchedulerDecisionRecord,
+    SchedulerLeadChange,
+    SchedulerPolicy,
+    SchedulerStats,
+    StreamStats,
+    ThreadPolicyConfig,
+    ThreadPolicyStatus,
+    ThreadSchedPolicy,
+    ThumbnailConfig,
+    ThumbnailInfo,
+    packed_frame_desc,
+    plan_frc,
+    plan_replay,
 )
 
+# Synthetic per-frame pack costs reported by benchmark_pixel_format (1080p-ish)
+_DEFAULT_PACK_COST_NS = {
+    PixelFormatType.FORMAT_8BIT_BGRA: 1_800_000.0,
+    PixelFormatType.FORMAT_8BIT_ARGB: 1_800_000.0,
+    PixelFormatType.FORMAT_10BIT_RGB: 2_400_000.0,
+    PixelFormatType.FORMAT_12BIT_RGBLE: 3_100_000.0,
+}
+
+# Slot size of mock recordings: a 1080p frame of uint16 RGB
+_RECORDING_SLOT_BYTES = 1920 * 1080 * 6
+
 # Global mock configuration state
 _mock_config = {
     "available_devices": ["Mock DeckLink Device"],
@@ -27,11 +76,343 @@ _mock_config = {
         PixelFormatType.FORMAT_12BIT_RGBLE,
     ],
     "hdr_support": True,
+    # Display modes EnableVideoOutput refuses, for reconfigure failure tests
+    "rejected_display_modes": [],
+    "pack_cost_ns": _DEFAULT_PACK_COST_NS.copy(),
     "driver_version": "12.8.1",
     "sdk_version": "15.3.0",
 }
 
 
+# Frame rates for the trailing digits of common display mode codes ('Hp30' etc.)
+_MOCK_FRAME_RATES = {
+    "23": 24000 / 1001,
+    "24": 24.0,
+    "25": 25.0,
+    "29": 30000 / 1001,
+    "30": 30.0,
+    "50": 50.0,
+    "59": 60000 / 1001,
+    "60": 60.0,
+}
+
+
+def _mock_nominal_interval_ns(display_mode: int) -> int:
+    """Nominal frame duration for a display mode code, 30 fps if unknown."""
+    suffix = bytes([(display_mode >> 8) & 0xFF, display_mode & 0xFF])
+    rate = _MOCK_FRAME_RATES.get(suffix.decode("ascii", "replace"), 30.0)
+    return round(1e9 / rate)
+
+
+def _mock_display_size(display_mode: int) -> tuple[int, int]:
+    """Raster of a display mode code: 4K and 8K modes by prefix, else 1080."""
+    prefix = bytes([(display_mode >> 24) & 0xFF, (display_mode >> 16) & 0xFF])
+    return {b"4k": (3840, 2160), b"8k": (7680, 4320)}.get(prefix, (1920, 1080))
+
+
+def _mock_place(
+    frame: np.ndarray, config: PlacementConfig, raster: tuple[int, int]
+) -> np.ndarray:
+    """
+    Place an RGB frame on the raster with the library's geometry.
+
+    Every filter samples the nearest source pixel.
+    """
+    height, width = frame.shape[:2]
+    crop_x, crop_y, crop_w, crop_h = (0, 0, width, height)
+    if config.cropWidth and config.cropHeight:
+        crop_x, crop_y = config.cropX, config.cropY
+        crop_w, crop_h = config.cropWidth, config.cropHeight
+        if crop_x + crop_w > width or crop_y + crop_h > height:
+            raise RuntimeError("Placement does not fit the frame (error -1)")
+    sized = config.width and config.height
+    out_w, out_h = (config.width, config.height) if sized else raster
+    fit = list(PlacementFit)[config.fit]
+    dest_w, dest_h = crop_w, crop_h
+    if fit in (PlacementFit.CONTAIN, PlacementFit.COVER):
+        if (crop_w * out_h <= out_w * crop_h) == (fit == PlacementFit.CONTAIN):
+            dest_w, dest_h = (2 * crop_w * out_h + crop_h) // (2 * crop_h), out_h
+        else:
+            dest_w, dest_h = out_w, (2 * crop_h * out_w + crop_w) // (2 * crop_w)
+    elif fit == PlacementFit.STRETCH:
+        dest_w, dest_h = out_w, out_h
+    elif fit == PlacementFit.INTEGER:
+        multiple = min(out_w // crop_w, out_h // crop_h)
+        if multiple:
+            dest_w, dest_h = crop_w * multiple, crop_h * multiple
+        else:
+            divisor = max(-(-crop_w // out_w), -(-crop_h // out_h))
+            dest_w, dest_h = crop_w // divisor, crop_h // divisor
+    dest_w, dest_h = max(dest_w, 1), max(dest_h, 1)
+    dest_x, dest_y = int((out_w - dest_w) / 2), int((out_h - dest_h) / 2)
+
+    placed = np.empty((out_h, out_w, 3), dtype=np.uint16)
+    placed[:] = list(config.surround)
+    x0, x1 = max(dest_x, 0), min(dest_x + dest_w, out_w)
+    y0, y1 = max(dest_y, 0), min(dest_y + dest_h, out_h)
+    xs = crop_x + (2 * (np.arange(x0, x1) - dest_x) + 1) * crop_w // (2 * dest_w)
+    ys = crop_y + (2 * (np.arange(y0, y1) - dest_y) + 1) * crop_h // (2 * dest_h)
+    source = frame if frame.ndim == 3 else frame[..., np.newaxis]
+    placed[y0:y1, x0:x1] = source[np.ix_(ys, xs)][..., :3]
+    return placed
+
+
+def _cached_size(frame: np.ndarray) -> int:
+    """Compressed size estimate: rows equal to the one above cost nothing."""
+    rows = frame.reshape(frame.shape[0], -1)
+    distinct = 1 + int(np.count_nonzero(np.any(rows[1:] != rows[:-1], axis=1)))
+    return distinct * rows[0].nbytes
+
+
+def _mock_frame_stats(
+    frame: np.ndarray, max_code: int, eotf: int, previous: int
+) -> FrameStats:
+    """Compute what the library's packing pass reports for a frame."""
+    rgb = frame.reshape(frame.shape[0], frame.shape[1], -1)
+    rgb = np.broadcast_to(rgb, (*rgb.shape[:2], 3)) if rgb.shape[2] == 1 else rgb
+    rgb = rgb[..., :3].reshape(-1, 3)
+    clipped = rgb > max_code
+    values = np.minimum(rgb, max_code)
+    stats = FrameStats(
+        valid=1,
+        maxCode=max_code,
+        width=frame.shape[1],
+        height=frame.shape[0],
+        frames=previous + 1,
+        clippedPixels=int(clipped.any(axis=1).sum()),
+        pq=int(eotf == 2),
+    )
+    mean = values.mean(axis=0)
+    luma = (0.2627, 0.6780, 0.0593) if eotf in (2, 3) else (0.2126, 0.7152, 0.0722)
+    for c in range(3):
+        stats.mean[c] = mean[c]
+        stats.min[c] = int(values[:, c].min())
+        stats.max[c] = int(values[:, c].max())
+        stats.clipped[c] = int(clipped[:, c].sum())
+    stats.apl = 100.0 * float(np.dot(luma, mean)) / max_code
+    if stats.pq:
+        # SMPTE ST 2084 EOTF of the largest component, full-range code values
+        m1, m2 = 2610 / 16384, 2523 / 4096 * 128
+        c1, c2, c3 = 3424 / 4096, 2413 / 4096 * 32, 2392 / 4096 * 32
+        e = (values.max(axis=1) / max_code) ** (1 / m2)
+        nits = 10000.0 * (np.maximum(e - c1, 0) / (c2 - c3 * e)) ** (1 / m1)
+        stats.maxCLL = float(nits.max())
+        stats.maxFALL = float(nits.mean())
+    return stats
+
+
+class _MockScheduler:
+    """Python equivalent of the C++ FrameScheduler on a simulated clock."""
+
+    def __init__(
+        self,
+        policy: SchedulerPolicy,
+        lead: int,
+        max_pending: int,
+        frame_ns: int,
+        lead_bounds: tuple[int, int] | None = None,
+    ) -> None:
+        min_lead, max_lead = lead_bounds or (lead, lead)
+        self.stats = SchedulerStats(
+            running=1,
+            policy=policy.int_value,
+            leadFrames=lead,
+            frameDurationNs=frame_ns,
+            adaptive=lead_bounds is not None,
+            minLeadFrames=min_lead,
+            maxLeadFrames=max_lead,
+            neededLeadFrames=1,
+        )
+        # The simulated clock has no jitter: only dispatch lag raises the
+        # lead, and each window of dispatches lowers it by one
+        self.since_change = 0
+        self.lead_changes: list[SchedulerLeadChange] = []
+        self.strict = policy == SchedulerPolicy.STRICT
+        self.max_pending = max_pending
+        self.started_ns = time.monotonic_ns()
+        self.pending: list[list[Any]] = []  # [frame_id, target, slot, frame]
+        self.committed_end = 0
+        self.next_id = 1
+        self.decisions: list[SchedulerDecisionRecord] = []
+
+    def now_ns(self) -> int:
+        return time.monotonic_ns() - self.started_ns
+
+    def current_slot(self) -> int:
+        return self.now_ns() // self.stats.frameDurationNs
+
+    def earliest_slot(self) -> int:
+        return max(self.current_slot() + 1, self.committed_end)
+
+    def record(
+        self, frame_id: int, target: int, slot: int, decision: int
+    ) -> SchedulerDecisionRecord:
+        counter = ("queued", "late", "droppedLate", "superseded", "queueFull")
+        if decision < len(counter):
+            name = counter[decision]
+            setattr(self.stats, name, getattr(self.stats, name) + 1)
+        else:
+            self.stats.dispatched += 1
+        record = SchedulerDecisionRecord(
+            frameId=frame_id,
+            targetNs=target,
+            slot=slot,
+            slotNs=slot * self.stats.frameDurationNs if slot >= 0 else -1,
+            decidedNs=self.now_ns(),
+            decision=decision,
+            durationFrames=1,
+        )
+        self.decisions = [*self.decisions[-63:], record]
+        return record
+
+    def submit(self, frame: np.ndarray, target: int) -> SchedulerDecisionRecord:
+        self.stats.submitted += 1
+        frame_id, self.next_id = self.next_id, self.next_id + 1
+        earliest = self.earliest_slot()
+        slot = -(-target // self.stats.frameDurationNs) if target else earliest
+        if self.strict:
+            tail = self.pending[-1][2] if self.pending else earliest - 1
+            slot = slot if target else max(earliest, tail + 1)
+            if slot < earliest or slot <= tail:
+                return self.record(frame_id, target, -1, 2)
+            if len(self.pending) >= self.max_pending:
+                return self.record(frame_id, target, -1, 4)
+            decision = 0
+        else:
+            decision = 1 if slot < earliest else 0
+            slot = max(slot, earliest)
+            while self.pending and (
+                self.pending[-1][2] >= slot or len(self.pending) >= self.max_pending
+            ):
+                old = self.pending.pop(-1 if self.pending[-1][2] >= slot else 0)
+                self.record(old[0], old[1], -1, 3)
+        self.pending.append([frame_id, target, slot, frame])
+        return self.record(frame_id, target, slot, decision)
+
+    def set_lead(self, lead: int, reason: int) -> None:
+        stats = self.stats
+        lead = min(max(lead, stats.minLeadFrames), stats.maxLeadFrames)
+        if not stats.adaptive or lead == stats.leadFrames:
+            return
+        change = SchedulerLeadChange(
+            decidedNs=self.now_ns(),
+            fromLead=stats.leadFrames,
+            toLead=lead,
+            reason=reason,
+        )
+        self.lead_changes = [*self.lead_changes[-31:], change]
+        if lead > stats.leadFrames:
+            stats.leadRaised += 1
+        else:
+            stats.leadLowered += 1
+        stats.leadFrames = lead
+        self.since_change = 0
+
+    def dispatch(self) -> list[np.ndarray]:
+        """Hand due frames to the simulated device and return them in order."""
+        current = self.current_slot()
+        shown = []
+        while self.pending and self.pending[0][2] <= current + self.stats.leadFrames:
+            frame_id, target, slot, frame = self.pending.pop(0)
+            if slot < self.earliest_slot():
+                self.set_lead(self.stats.leadFrames + 1, 2)
+            slot = max(slot, self.earliest_slot())
+            self.committed_end = slot + 1
+            self.record(frame_id, target, slot, 5)
+            self.stats.displayed += 1
+            self.since_change += 1
+            if self.since_change >= 120:
+                self.set_lead(self.stats.leadFrames - 1, 4)
+            shown.append(frame)
+        return shown
+
+
+class _MockFrameTiming:
+    """Python equivalent of the C++ FrameTimingAnalyzer for mock devices."""
+
+    def __init__(self) -> None:
+        self.nominal_ns = 0
+        self.threshold = 0.5
+        self.reset()
+
+    def reset(self, nominal_ns: int = 0) -> None:
+        if nominal_ns > 0:
+            self.nominal_ns = nominal_ns
+        self.pending_submit_ns = 0
+        self.last_completion_ns = 0
+        self.intervals: list[int] = []
+        self.latencies: list[int] = []
+        self.frames = 0
+        self.idle_gaps = 0
+        self.missed_frames = 0
+        self.outlier_count = 0
+        self.outliers: list[FrameTimingOutlier] = []
+
+    def _bin(self, ns: int) -> int:
+        if self.nominal_ns <= 0:
+            return FRAME_TIMING_BINS - 1
+        return min(ns * 8 // self.nominal_ns, FRAME_TIMING_BINS - 1)
+
+    def record_completion(self, now_ns: int, continuous: bool = False) -> None:
+        self.frames += 1
+        submit_ns = self.pending_submit_ns
+        latency = -1
+        if self.pending_submit_ns:
+            latency = now_ns - self.pending_submit_ns
+            self.pending_submit_ns = 0
+            self.latencies.append(latency)
+
+        last, self.last_completion_ns = self.last_completion_ns, now_ns
+        if not last:
+            return
+        interval = now_ns - last
+        idle_ns = 30 * self.nominal_ns
+        # Idle only if no frame was waiting through the gap
+        waiting = submit_ns and submit_ns - last <= idle_ns
+        if not continuous and self.nominal_ns and interval > idle_ns and not waiting:
+            self.idle_gaps += 1
+            return
+        self.intervals.append(interval)
+        if not self.nominal_ns:
+            return
+        slots = (interval + self.nominal_ns // 2) // self.nominal_ns
+        self.missed_frames += max(slots - 1, 0)
+        if interval > self.nominal_ns * (1.0 + self.threshold):
+            self.outlier_count += 1
+            self.outliers.append(
+                FrameTimingOutlier(self.frames - 1, now_ns, interval, latency)
+            )
+            self.outliers = self.outliers[-FRAME_TIMING_MAX_OUTLIERS:]
+
+    def report(self) -> FrameTimingReport:
+        report = FrameTimingReport(
+            nominalIntervalNs=self.nominal_ns,
+            frames=self.frames,
+            intervals=len(self.intervals),
+            idleGaps=self.idle_gaps,
+            outliers=self.outlier_count,
+            missedFrames=self.missed_frames,
+            outlierThreshold=self.threshold,
+            histogramBins=FRAME_TIMING_BINS,
+            binsPerFrame=8,
+        )
+        if self.intervals:
+            values = np.array(self.intervals, dtype=np.float64)
+            report.minIntervalNs = int(values.min())
+            report.maxIntervalNs = int(values.max())
+            report.meanIntervalNs = int(values.mean())
+            report.stddevIntervalNs = int(values.std())
+        if self.latencies:
+            report.minLatencyNs = min(self.latencies)
+            report.maxLatencyNs = max(self.latencies)
+            report.meanLatencyNs = sum(self.latencies) // len(self.latencies)
+        for ns in self.intervals:
+            report.intervalHistogram[self._bin(ns)] += 1
+        for ns in self.latencies:
+            report.latencyHistogram[self._bin(ns)] += 1
+        return report
+
+
 class MockBMDDeckLink:
     """
     Mock implementation of BMDDeckLink for development and testing without hardware.
@@ -94,12 +475,50 @@ class MockBMDDeckLink:
         self.device_name = _mock_config["available_devices"][device_index]
         self.handle = MagicMock()  # Always non-None when device is "open"
         self.started = False
+        self.pipelined = False
 
         # Internal state
         self._pixel_format = _mock_config["supported_formats"][0]
         self._hdr_metadata: HDRMetadata | None = None
+        self._hdr_table: list[HDRMetadata] = []  # By id - 1
+        self._hdr_table_stats = HDRMetadataTableStats(capacity=1024)
+        self._display_mode = 0x48703330  # 'Hp30'
         self._frame_history: list[np.ndarray] = []
         self._max_frame_history = 10
+        self._thread_policy = ThreadPolicyConfig(-1, 0, 0, 0, -1, 0)
+        self._thread_policy_status = ThreadPolicyStatus(outputCore=-1)
+        self._frame_timing = _MockFrameTiming()
+        self._timing_display_mode = 0
+        self._overlays: dict[int, dict[str, Any]] = {}
+        self._next_overlay_id = 1
+        self._source_frame: np.ndarray | None = None
+        # Last frame given to display_frame, before placement
+        self._display_source: np.ndarray | None = None
+        self._memory_peaks = dict.fromkeys(MEMORY_SUBSYSTEMS, 0)
+        self._frc_status = FrcStatus()
+        self._frc_started_ns = 0
+        self._frc_sequence: list[np.ndarray] = []
+        self._pipeline_stats = PipelineStats()
+        self._scheduler: _MockScheduler | None = None
+        self._scheduler_stats = SchedulerStats()
+        self._stream_stats = StreamStats()
+        self._stream_stop = threading.Event()
+        self._stream_thread: threading.Thread | None = None
+        self._recording: RecordingWriter | None = None
+        self._recorder_stats = RecorderStats()
+        self._replay_stats = ClipPlaybackStats()
+        self._replay_started_ns = 0
+        self._frame_stats_mode = 1
+        self._frame_stats = FrameStats()
+        self._thumbnail_config = ThumbnailConfig(320, 0, 2, 250, 203.0)
+        self._frames_output = 0
+        # key -> (frame, pixel format, packed); order is least recently used
+        self._frame_cache: OrderedDict[int, tuple[np.ndarray, Any, bool]] = (
+            OrderedDict()
+        )
+        self._frame_cache_hot: OrderedDict[int, None] = OrderedDict()
+        self._frame_cache_stats = FrameCacheStats(hotCapacity=4)
+        self._placement = PlacementConfig()
 
         # Method call tracking
         self._method_calls: dict[str, list[dict[str, Any]]] = {
@@ -107,7 +526,37 @@ class MockBMDDeckLink:
             "stop_playback": [],
             "set_pixel_format": [],
             "set_hdr_metadata": [],
+            "intern_hdr_metadata": [],
+            "reconfigure": [],
+            "benchmark_pixel_format": [],
+            "set_thread_policy": [],
+            "apply_output_thread_policy": [],
             "display_frame": [],
+            "update_frame_regions": [],
+            "add_overlay": [],
+            "remove_overlay": [],
+            "set_overlay_enabled": [],
+            "move_overlay": [],
+            "clear_overlays": [],
+            "update_overlays": [],
+            "set_pipelined_output": [],
+            "start_frc": [],
+            "stop_frc": [],
+            "start_scheduler": [],
+            "schedule_frame": [],
+            "stop_scheduler": [],
+            "start_stream": [],
+            "stop_stream": [],
+            "start_recording": [],
+            "play_recording": [],
+            "set_frame_stats": [],
+            "display_packed_frame": [],
+            "schedule_packed_frame": [],
+            "set_thumbnail": [],
+            "cache_frame": [],
+            "display_cached_frame": [],
+            "schedule_cached_frame": [],
+            "set_placement": [],
             "close": [],
         }
 
@@ -136,6 +585,8 @@ class MockBMDDeckLink:
         """Close the device and free resources."""
         if self.handle:
             self._method_calls["close"].append({})
+            self.stop_stream()
+            self.stop_recording()
             if self.started:
                 self.stop_playback()
             self.handle = None
@@ -199,6 +650,29 @@ class MockBMDDeckLink:
         self._method_calls["set_pixel_format"].append({"format": pixel_format_type})
         self._pixel_format = pixel_format_type
 
+    @property
+    def display_mode(self) -> int:
+        """Get the active display mode code."""
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        return self._display_mode
+
+    def benchmark_pixel_format(
+        self, pixel_format: PixelFormatType, iterations: int = 5
+    ) -> float:
+        """Return a deterministic synthetic pack cost for a pixel format."""
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        self._method_calls["benchmark_pixel_format"].append(
+            {"format": pixel_format, "iterations": iterations}
+        )
+        # Only RGB formats have packers in the real library
+        if "YUV" in pixel_format.name:
+            raise RuntimeError(
+                f"Failed to benchmark pixel format {pixel_format.name} (error -8)"
+            )
+        return _mock_config["pack_cost_ns"].get(pixel_format, 5_000_000.0)
+
     def set_hdr_metadata(self, metadata: HDRMetadata) -> None:
         """Set complete HDR metadata for all future frames."""
         if not self.handle:
@@ -210,8 +684,190 @@ class MockBMDDeckLink:
         self._method_calls["set_hdr_metadata"].append({"metadata": metadata})
         self._hdr_metadata = metadata
 
-    def display_frame(self, frame_data: np.ndarray) -> None:
-        """Display a single frame synchronously."""
+    def intern_hdr_metadata(self, metadata: HDRMetadata) -> int:
+        """Register HDR metadata for per-frame use; equal values share an id."""
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        if not 0 <= metadata.EOTF <= 3:
+            raise RuntimeError("Failed to intern HDR metadata (error -1)")
+        stats = self._hdr_table_stats
+        stats.interned += 1
+        value = bytes(metadata)
+        for index, entry in enumerate(self._hdr_table):
+            if bytes(entry) == value:
+                stats.reused += 1
+                return index + 1
+        if len(self._hdr_table) >= stats.capacity:
+            raise RuntimeError("Failed to intern HDR metadata (error -5)")
+        self._hdr_table.append(HDRMetadata.from_buffer_copy(metadata))
+        stats.entries = len(self._hdr_table)
+        self._method_calls["intern_hdr_metadata"].append({"metadata": metadata})
+        return len(self._hdr_table)
+
+    def clear_hdr_metadata_table(self) -> None:
+        """Drop every interned HDR metadata entry."""
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        self._hdr_table.clear()
+        self._hdr_table_stats.entries = 0
+
+    def hdr_metadata_table_stats(self) -> HDRMetadataTableStats:
+        """Get the simulated HDR metadata table counters."""
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        return HDRMetadataTableStats.from_buffer_copy(self._hdr_table_stats)
+
+    def _hdr_metadata_id(self, hdr_metadata: HDRMetadata | int | None) -> int:
+        """Table id for a schedule call; 0 keeps the device's metadata."""
+        if hdr_metadata is None:
+            return 0
+        if isinstance(hdr_metadata, HDRMetadata):
+            hdr_metadata = self.intern_hdr_metadata(hdr_metadata)
+        if not 1 <= hdr_metadata <= len(self._hdr_table):
+            raise RuntimeError(f"Invalid HDR metadata id {hdr_metadata}")
+        entry = self._hdr_table[hdr_metadata - 1]
+        if entry.EOTF in (2, 3):
+            self._hdr_table_stats.attached += 1
+        return hdr_metadata
+
+    def _check_output_enable(
+        self, display_mode: int | None, stats: ReconfigureStats
+    ) -> None:
+        """Fail as EnableVideoOutput would for a rejected display mode."""
+        if (
+            self.started
+            and stats.displayModeChanged
+            and display_mode in _mock_config["rejected_display_modes"]
+        ):
+            raise RuntimeError("Failed to reconfigure output (error -3)")
+
+    def reconfigure(
+        self,
+        pixel_format: PixelFormatType | None = None,
+        display_mode: int | None = None,
+        hdr_metadata: HDRMetadata | None = None,
+    ) -> ReconfigureStats:
+        """Change pixel format, display mode and/or HDR metadata in place."""
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        if (
+            pixel_format is not None
+            and pixel_format not in _mock_config["supported_formats"]
+        ):
+            raise RuntimeError("Failed to reconfigure output (error -1)")
+
+        stats = ReconfigureStats()
+        if pixel_format is not None and pixel_format != self._pixel_format:
+            stats.pixelFormatChanged = 1
+            stats.sdiLinkChanged = int(
+                ("YUV" in pixel_format.name) != ("YUV" in self._pixel_format.name)
+            )
+        if display_mode is not None and display_mode != self._display_mode:
+            stats.displayModeChanged = 1
+        if hdr_metadata is not None:
+            stats.hdrChanged = int(
+                self._hdr_metadata is None
+                or bytes(hdr_metadata) != bytes(self._hdr_metadata)
+            )
+        # The library commits nothing until the output accepts the change
+        self._check_output_enable(display_mode, stats)
+        if stats.pixelFormatChanged:
+            self._pixel_format = pixel_format
+        if stats.displayModeChanged:
+            self._display_mode = display_mode
+        if hdr_metadata is not None:
+            self._hdr_metadata = hdr_metadata
+
+        if self.started:
+            stats.setFlagCalls = stats.sdiLinkChanged
+            stats.enableCycles = int(
+                bool(stats.displayModeChanged or stats.sdiLinkChanged)
+            )
+            stats.framesRepresented = int(
+                bool(self._frame_history)
+                and bool(
+                    stats.pixelFormatChanged
+                    or stats.displayModeChanged
+                    or stats.hdrChanged
+                )
+            )
+
+        self._method_calls["reconfigure"].append(
+            {
+                "format": pixel_format,
+                "display_mode": display_mode,
+                "metadata": hdr_metadata,
+                "stats": stats,
+            }
+        )
+        return stats
+
+    def set_thread_policy(
+        self,
+        output_core: int = -1,
+        sched_policy: ThreadSchedPolicy = ThreadSchedPolicy.OTHER,
+        sched_priority: int = 0,
+        pack_workers: int = 0,
+        pack_core_first: int = -1,
+        lock_memory: bool = False,
+    ) -> None:
+        """Configure thread placement, scheduling and memory locking."""
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        if pack_workers < 0:
+            raise RuntimeError("Failed to set thread policy (error -1)")
+
+        self._thread_policy = ThreadPolicyConfig(
+            output_core,
+            sched_policy.int_value,
+            sched_priority,
+            pack_workers,
+            pack_core_first,
+            int(lock_memory),
+        )
+        self._thread_policy_status.packWorkers = pack_workers
+        self._thread_policy_status.packWorkersPinned = (
+            pack_workers if pack_core_first >= 0 else 0
+        )
+        self._method_calls["set_thread_policy"].append(
+            {
+                "output_core": output_core,
+                "sched_policy": sched_policy,
+                "sched_priority": sched_priority,
+                "pack_workers": pack_workers,
+                "pack_core_first": pack_core_first,
+                "lock_memory": lock_memory,
+            }
+        )
+
+    def apply_output_thread_policy(self) -> bool:
+        """Record the output thread policy as applied in full."""
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        config = self._thread_policy
+        status = self._thread_policy_status
+        status.outputCore = config.outputCore
+        status.outputPinned = 1 if config.outputCore >= 0 else 0
+        status.schedPolicy = config.schedPolicy
+        status.schedPriority = config.schedPriority if config.schedPolicy else 0
+        status.schedFallback = 0
+        self._method_calls["apply_output_thread_policy"].append({})
+        return True
+
+    @property
+    def thread_policy_status(self) -> ThreadPolicyStatus:
+        """Thread placement and scheduling currently in effect."""
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        status = ThreadPolicyStatus.from_buffer_copy(self._thread_policy_status)
+        # Like the real pool, buffers only exist once a frame has been output
+        if self._thread_policy.lockMemory and self._frame_history:
+            status.memoryLocked = 1
+            status.lockedBytes = 3 * self._frame_history[-1].nbytes
+        return status
+
+    def display_frame(self, frame_data: np.ndarray) -> FrameStats | None:
+        """Display a single frame synchronously, returning its statistics."""
         if not self.handle:
             raise RuntimeError("Device not open")
 
@@ -219,19 +875,973 @@ class MockBMDDeckLink:
         if not isinstance(frame_data, np.ndarray):
             raise ValueError("frame_data must be a numpy array")
 
+        self._frc_status.playback.running = 0
+        self.stop_scheduler()
+        self.stop_stream()
+        self._frame_timing.pending_submit_ns = time.monotonic_ns()
+        if self._timing_display_mode != self._display_mode:
+            self._frame_timing.reset(_mock_nominal_interval_ns(self._display_mode))
+            self._timing_display_mode = self._display_mode
+
         # Convert and validate as the real implementation does
         frame_data = np.astype(frame_data, np.uint16, copy=True)
-        frame_data = np.ascontiguousarray(frame_data)
+        self._display_source = np.ascontiguousarray(frame_data)
+        frame_data = self._place(self._display_source.copy())
 
-        # Store frame in history
-        self._frame_history.append(frame_data.copy())
-        if len(self._frame_history) > self._max_frame_history:
-            self._frame_history.pop(0)
+        if self._frame_stats_mode:
+            self._analyse_frame(frame_data)
+
+        # Store frame (with overlays, as it would appear on output) in history
+        self._source_frame = frame_data.copy()
+        self._push_frame(self._composite_overlays(frame_data))
 
         # Track method call
         self._method_calls["display_frame"].append(
             {"shape": frame_data.shape, "dtype": frame_data.dtype}
         )
+        self._frame_timing.record_completion(time.monotonic_ns())
+        if self.pipelined:
+            # The mock displays immediately, so every stage sees the frame
+            stats = self._pipeline_stats
+            stats.submitted += 1
+            stats.packed += 1
+            stats.displayed += 1
+            return None
+        return self.frame_stats() if self._frame_stats.valid else None
+
+    def _analyse_frame(self, frame: np.ndarray) -> None:
+        """Update the frame statistics, and the HDR metadata in auto mode."""
+        eotf = self._hdr_metadata.EOTF if self._hdr_metadata is not None else 1
+        stats = _mock_frame_stats(
+            frame,
+            2**self._pixel_format.bit_depth - 1,
+            eotf,
+            self._frame_stats.frames,
+        )
+        if stats.pq and self._frame_stats_mode == 2:
+            # The library keeps its own copy of the metadata
+            metadata = HDRMetadata.from_buffer_copy(self._hdr_metadata)
+            metadata.maxCLL = stats.maxCLL
+            metadata.maxFALL = stats.maxFALL
+            self._hdr_metadata = metadata
+            stats.autoMetadata = 1
+        self._frame_stats = stats
+
+    def frame_timing_report(self) -> FrameTimingReport:
+        """Get inter-frame interval and latency statistics."""
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        return self._frame_timing.report()
+
+    def frame_timing_outliers(
+        self, max_count: int = FRAME_TIMING_MAX_OUTLIERS
+    ) -> list[FrameTimingOutlier]:
+        """Get the most recent late frames, oldest first."""
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        return self._frame_timing.outliers[-max_count:] if max_count else []
+
+    def reset_frame_timing(self) -> None:
+        """Clear all frame timing statistics."""
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        self._frame_timing.reset()
+
+    def set_frame_timing_threshold(self, threshold: float) -> None:
+        """Set how late a frame must be to count as an outlier."""
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        if threshold < 0:
+            raise RuntimeError("Failed to set frame timing threshold (error -1)")
+        self._frame_timing.threshold = threshold
+
+    def memory_stats(self) -> dict[str, dict[str, int]]:
+        """Estimate library heap usage per subsystem from the mock's state."""
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        # (bytes, live blocks) as the library would account them
+        frame_bytes = self._source_frame.nbytes if self._source_frame is not None else 0
+        sprites = [o["sprite"].nbytes for o in self._overlays.values()]
+        usage = {
+            "pending_input": (frame_bytes, int(frame_bytes > 0)),
+            "pack_scratch": (0, 0),
+            "frame_pool": (3 * frame_bytes, 3 if frame_bytes else 0),
+            "overlays": (sum(sprites), len(sprites)),
+            "caches": (frame_bytes if sprites else 0, int(bool(sprites))),
+            "logger": (2048, 1),
+            "frame_cache": (
+                self._frame_cache_stats.compressedBytes,
+                len(self._frame_cache),
+            ),
+            "trace": (0, 0),
+            "recorder": (
+                self._recorder_stats.slots * self._recorder_stats.slotBytes,
+                self._recorder_stats.slots,
+            )
+            if self._recorder_stats.running
+            else (0, 0),
+        }
+        stats = {}
+        for name, (current, live) in usage.items():
+            self._memory_peaks[name] = max(self._memory_peaks[name], current)
+            stats[name] = {
+                "current_bytes": current,
+                "peak_bytes": self._memory_peaks[name],
+                "allocations": live,
+                "frees": 0,
+                "live": live,
+            }
+        return stats
+
+    def reset_memory_peaks(self) -> None:
+        """Reset every subsystem's peak to its current usage."""
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        self._memory_peaks = dict.fromkeys(MEMORY_SUBSYSTEMS, 0)
+
+    def update_frame_regions(
+        self,
+        frame_data: np.ndarray,
+        regions: Sequence[tuple[int, int, int, int]],
+    ) -> None:
+        """Re-display the last frame with the given rectangles replaced."""
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        if not isinstance(frame_data, np.ndarray):
+            raise ValueError("frame_data must be a numpy array")
+        source = self._display_source
+        if source is None or frame_data.shape != source.shape:
+            raise RuntimeError("Failed to update frame regions (error -1)")
+        height, width = source.shape[:2]
+        for x, y, w, h in regions:
+            if min(x, y, w, h) < 0 or x + w > width or y + h > height:
+                raise RuntimeError("Failed to update frame regions (error -1)")
+        for x, y, w, h in regions:
+            source[y : y + h, x : x + w] = frame_data[y : y + h, x : x + w]
+        frame = self._place(source.copy())
+        self._source_frame = frame.copy()
+        self._push_frame(self._composite_overlays(frame))
+        self._method_calls["update_frame_regions"].append(
+            {"regions": [tuple(region) for region in regions]}
+        )
+        self._frame_timing.record_completion(time.monotonic_ns())
+
+    def _push_frame(self, frame: np.ndarray) -> None:
+        self._frames_output += 1
+        if self._recording is not None:
+            self._record_frame(frame)
+        self._frame_history.append(frame)
+        if len(self._frame_history) > self._max_frame_history:
+            self._frame_history.pop(0)
+
+    def _composite_overlays(self, frame: np.ndarray) -> np.ndarray:
+        """Blend enabled overlays as the library does in the packed domain."""
+        frame = frame.copy()
+        if frame.ndim != 3:
+            return frame
+        height, width = frame.shape[:2]
+        for overlay in self._overlays.values():
+            if not overlay["enabled"]:
+                continue
+            sprite = overlay["sprite"]
+            x, y = overlay["x"], overlay["y"]
+            x0, y0 = max(x, 0), max(y, 0)
+            x1 = min(x + sprite.shape[1], width)
+            y1 = min(y + sprite.shape[0], height)
+            if x0 >= x1 or y0 >= y1:
+                continue
+            src = sprite[y0 - y : y1 - y, x0 - x : x1 - x].astype(np.uint32)
+            dst = frame[y0:y1, x0:x1, :3].astype(np.uint32)
+            alpha = np.minimum(src[..., 3:4], 255)
+            frame[y0:y1, x0:x1, :3] = (
+                src[..., :3] * alpha + dst * (255 - alpha) + 127
+            ) // 255
+        return frame
+
+    def _get_overlay(self, overlay_id: int) -> dict[str, Any]:
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        if overlay_id not in self._overlays:
+            raise RuntimeError(f"Unknown overlay id {overlay_id}")
+        return self._overlays[overlay_id]
+
+    def add_overlay(
+        self, sprite: np.ndarray, x: int, y: int, enabled: bool = True
+    ) -> int:
+        """Add an RGBA sprite composited into the output frame."""
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        if sprite.ndim != 3 or sprite.shape[2] != 4:
+            raise ValueError("sprite must have shape (height, width, 4)")
+        overlay_id = self._next_overlay_id
+        self._next_overlay_id += 1
+        self._overlays[overlay_id] = {
+            "sprite": np.ascontiguousarray(sprite, dtype=np.uint16),
+            "x": x,
+            "y": y,
+            "enabled": enabled,
+        }
+        self._method_calls["add_overlay"].append(
+            {"id": overlay_id, "shape": sprite.shape, "x": x, "y": y}
+        )
+        return overlay_id
+
+    def remove_overlay(self, overlay_id: int) -> None:
+        """Remove an overlay."""
+        self._get_overlay(overlay_id)
+        del self._overlays[overlay_id]
+        self._method_calls["remove_overlay"].append({"id": overlay_id})
+
+    def set_overlay_enabled(self, overlay_id: int, enabled: bool) -> None:
+        """Show or hide an overlay without removing it."""
+        self._get_overlay(overlay_id)["enabled"] = enabled
+        self._method_calls["set_overlay_enabled"].append(
+            {"id": overlay_id, "enabled": enabled}
+        )
+
+    def move_overlay(self, overlay_id: int, x: int, y: int) -> None:
+        """Move an overlay."""
+        overlay = self._get_overlay(overlay_id)
+        overlay["x"], overlay["y"] = x, y
+        self._method_calls["move_overlay"].append({"id": overlay_id, "x": x, "y": y})
+
+    def clear_overlays(self) -> None:
+        """Remove all overlays."""
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        self._overlays.clear()
+        self._method_calls["clear_overlays"].append({})
+
+    def update_overlays(self) -> None:
+        """Re-display the current frame with the current overlays."""
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        if self._source_frame is None:
+            raise RuntimeError("Failed to update overlays (error -1)")
+        self._push_frame(self._composite_overlays(self._source_frame))
+        self._method_calls["update_overlays"].append({})
+
+    def set_pipelined_output(self, enabled: bool) -> None:
+        """Switch pipelined output on or off (frames still display at once)."""
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        if enabled and not self.pipelined:
+            self._pipeline_stats = PipelineStats(running=1)
+        self._pipeline_stats.running = int(enabled)
+        self.pipelined = enabled
+        self._method_calls["set_pipelined_output"].append({"enabled": enabled})
+
+    def flush_output(self) -> None:
+        """Wait for pipelined frames to be displayed (a no-op for the mock)."""
+        if not self.handle:
+            raise RuntimeError("Device not open")
+
+    def pipeline_stats(self) -> PipelineStats:
+        """Get the counters of pipelined output."""
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        return PipelineStats.from_buffer_copy(self._pipeline_stats)
+
+    def start_frc(
+        self,
+        target: Sequence[float],
+        roi: tuple[int, int, int, int] | None = None,
+        cycle_frames: int = 8,
+        background: np.ndarray | None = None,
+    ) -> FrcStatus:
+        """Start temporal dithering, laid out by the library's FRC planner."""
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        if len(target) != 3 or min(target) < 0:
+            raise ValueError("target must be three non-negative code values")
+        if background is not None:
+            self._source_frame = np.ascontiguousarray(background, dtype=np.uint16)
+        base = self._source_frame
+        if base is None or base.ndim != 3:
+            base = np.zeros((1080, 1920, 3), dtype=np.uint16)
+        height, width = base.shape[:2]
+        x, y, w, h = roi if roi and roi[2] and roi[3] else (0, 0, width, height)
+        if (
+            not self.started
+            or not 1 <= cycle_frames <= 64
+            or min(x, y, w, h) < 0
+            or x + w > width
+            or y + h > height
+        ):
+            raise RuntimeError("Failed to start FRC (error -1)")
+
+        max_code = (1 << self._pixel_format.bit_depth) - 1
+        # The library's own duty split and spread lay out the cycle
+        status, upper = plan_frc(target, cycle_frames, max_code)
+        frames: dict[bytes, np.ndarray] = {}
+        self._frc_sequence = []
+        for channels in upper:
+            combination = channels.tobytes()
+            if combination not in frames:
+                frame = base.copy()
+                frame[y : y + h, x : x + w] = np.array(status.low) + channels
+                frames[combination] = self._composite_overlays(frame)
+            self._frc_sequence.append(frames[combination])
+
+        playback = status.playback
+        playback.running = 1
+        playback.frames = len(frames)
+        playback.sequenceLength = cycle_frames
+        playback.prerollFrames = 3
+        self.stop_scheduler()
+        self.stop_stream()
+        self._frc_status = status
+        self._frc_started_ns = time.monotonic_ns()
+        self._method_calls["start_frc"].append(
+            {"target": tuple(target), "roi": (x, y, w, h), "cycle": cycle_frames}
+        )
+        return self.frc_status()
+
+    def stop_frc(self) -> None:
+        """Stop temporal dithering."""
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        if self._frc_status.playback.running:
+            self.frc_status()
+            self._frc_status.playback.running = 0
+            self._method_calls["stop_frc"].append({})
+
+    def frc_status(self) -> FrcStatus:
+        """Get dithering levels and simulated playback counters."""
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        playback = self._frc_status.playback
+        if playback.running:
+            interval = _mock_nominal_interval_ns(self._display_mode)
+            shown = (time.monotonic_ns() - self._frc_started_ns) // interval
+            playback.completed = shown
+            playback.scheduled = shown + playback.prerollFrames
+        return FrcStatus.from_buffer_copy(self._frc_status)
+
+    def start_scheduler(
+        self,
+        policy: SchedulerPolicy = SchedulerPolicy.STRICT,
+        lead_frames: int = 2,
+        max_pending: int = 8,
+        adaptive_lead: tuple[int, int] | None = None,
+    ) -> None:
+        """Start deadline-aware output on a simulated stream clock."""
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        min_lead, max_lead = adaptive_lead or (lead_frames, lead_frames)
+        if (
+            not self.started
+            or not 1 <= min_lead <= lead_frames <= max_lead <= 8
+            or not 1 <= max_pending <= 32
+        ):
+            raise RuntimeError("Failed to start scheduler (error -1)")
+        self._frc_status.playback.running = 0
+        self.stop_scheduler()
+        self.stop_stream()
+        self._scheduler = _MockScheduler(
+            SchedulerPolicy(policy),
+            lead_frames,
+            max_pending,
+            _mock_nominal_interval_ns(self._display_mode),
+            adaptive_lead,
+        )
+        self._method_calls["start_scheduler"].append(
+            {
+                "policy": SchedulerPolicy(policy),
+                "lead": lead_frames,
+                "adaptive_lead": adaptive_lead,
+            }
+        )
+
+    def schedule_frame(
+        self,
+        frame_data: np.ndarray,
+        at_ns: int = 0,
+        duration_frames: int = 1,
+        hdr_metadata: HDRMetadata | int | None = None,
+    ) -> SchedulerDecisionRecord:
+        """Queue a frame; due frames enter the history when scheduled."""
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        if self._scheduler is None or at_ns < 0 or duration_frames < 1:
+            raise RuntimeError("Failed to schedule frame (error -1)")
+        metadata_id = self._hdr_metadata_id(hdr_metadata)
+        frame = np.ascontiguousarray(np.astype(frame_data, np.uint16, copy=True))
+        frame = self._place(frame)
+        record = self._scheduler.submit(self._composite_overlays(frame), at_ns)
+        record.durationFrames = duration_frames
+        for shown in self._scheduler.dispatch():
+            self._push_frame(shown)
+        self._method_calls["schedule_frame"].append(
+            {
+                "at_ns": at_ns,
+                "hdr_metadata_id": metadata_id,
+                "decision": record.decision_name,
+            }
+        )
+        return record
+
+    def stop_scheduler(self) -> None:
+        """Stop deadline-aware output, discarding queued frames."""
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        if self._scheduler is not None:
+            self._scheduler_stats = self.scheduler_stats()
+            self._scheduler_stats.running = 0
+            self._scheduler = None
+            self._method_calls["stop_scheduler"].append({})
+
+    def scheduler_stats(self) -> SchedulerStats:
+        """Get the simulated scheduler counters."""
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        if self._scheduler is None:
+            return SchedulerStats.from_buffer_copy(self._scheduler_stats)
+        for shown in self._scheduler.dispatch():
+            self._push_frame(shown)
+        stats = SchedulerStats.from_buffer_copy(self._scheduler.stats)
+        stats.pending = len(self._scheduler.pending)
+        stats.streamTimeNs = self._scheduler.now_ns()
+        stats.currentSlot = self._scheduler.current_slot()
+        return stats
+
+    def scheduler_decisions(self, max_count: int = 64) -> list[SchedulerDecisionRecord]:
+        """Get the most recent simulated scheduler decisions, oldest first."""
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        if self._scheduler is None or max_count <= 0:
+            return []
+        return list(self._scheduler.decisions[-max_count:])
+
+    def scheduler_lead_changes(self, max_count: int = 32) -> list[SchedulerLeadChange]:
+        """Get the most recent simulated lead changes, oldest first."""
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        if self._scheduler is None or max_count <= 0:
+            return []
+        return list(self._scheduler.lead_changes[-max_count:])
+
+    def start_stream(
+        self,
+        fd: int,
+        width: int,
+        height: int,
+        packed: bool = False,
+        readahead: int = 4,
+        loop: bool = False,
+        max_frames: int = 0,
+    ) -> StreamStats:
+        """Read raw frames from a file descriptor on a thread at display rate."""
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        if not self.started or min(width, height) <= 0 or not 1 <= readahead <= 16:
+            raise RuntimeError("Failed to start stream (error -1)")
+        self.stop_stream()
+        self.stop_scheduler()
+        self._frc_status.playback.running = 0
+        # Packed frames are sized as if the format had 4 bytes per pixel
+        frame_bytes = width * height * (4 if packed else 6)
+        self._stream_stats = StreamStats(
+            running=1, format=int(packed), frameBytes=frame_bytes
+        )
+        self._stream_stop.clear()
+        self._stream_thread = threading.Thread(
+            target=self._stream_loop,
+            args=(fd, (height, width, 3), packed, loop, max_frames),
+            daemon=True,
+        )
+        self._stream_thread.start()
+        self._method_calls["start_stream"].append(
+            {"fd": fd, "size": (width, height), "packed": packed}
+        )
+        return self.stream_stats()
+
+    def _read_stream_frame(self, fd: int, size: int, rewind: bool) -> bytes | None:
+        data = b""
+        while len(data) < size:
+            chunk = os.read(fd, size - len(data))
+            if chunk:
+                data += chunk
+                self._stream_stats.bytesRead += len(chunk)
+            elif not data and rewind:
+                rewind = False
+                with contextlib.suppress(OSError):
+                    os.lseek(fd, 0, os.SEEK_SET)
+            else:
+                self._stream_stats.endOfInput = 2 if data else 1
+                return None
+        return data
+
+    def _stream_loop(
+        self,
+        fd: int,
+        shape: tuple[int, int, int],
+        packed: bool,
+        loop: bool,
+        max_frames: int,
+    ) -> None:
+        stats = self._stream_stats
+        interval = _mock_nominal_interval_ns(self._display_mode) / 1e9
+        while not self._stream_stop.is_set() and (
+            not max_frames or stats.framesRead < max_frames
+        ):
+            rewind = loop and stats.framesRead > 0
+            data = self._read_stream_frame(fd, stats.frameBytes, rewind)
+            if data is None:
+                break
+            stats.framesRead += 1
+            if not packed:
+                frame = np.frombuffer(data, np.uint16).reshape(shape)
+                self._push_frame(self._place(frame))
+            stats.framesDisplayed += 1
+            self._stream_stop.wait(interval)
+        stats.running = 0
+
+    def stop_stream(self) -> None:
+        """Stop the raw frame stream."""
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        if self._stream_thread is not None:
+            self._stream_stop.set()
+            # A read blocked on an idle pipe is abandoned (daemon thread)
+            self._stream_thread.join(timeout=1.0)
+            self._stream_thread = None
+            self._stream_stats.running = 0
+            self._method_calls["stop_stream"].append({})
+
+    def stream_stats(self) -> StreamStats:
+        """Get the counters of the running or last raw frame stream."""
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        return StreamStats.from_buffer_copy(self._stream_stats)
+
+    def start_recording(
+        self, path: str | Path, slots: int = 8, direct: bool = True
+    ) -> RecorderStats:
+        """Record every frame pushed to the mock output with the library's recorder.
+
+        Frames are recorded as their uint16 RGB bytes rather than packed.
+        """
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        self.stop_recording()
+        self._recording = RecordingWriter(
+            path,
+            self._display_mode,
+            self._pixel_format.sdk_format_code,
+            _mock_nominal_interval_ns(self._display_mode),
+            _RECORDING_SLOT_BYTES,
+            slots,
+            direct,
+        )
+        self._method_calls["start_recording"].append(
+            {"path": str(path), "slots": slots, "direct": direct}
+        )
+        return self.recorder_stats()
+
+    def _record_frame(self, frame: np.ndarray) -> None:
+        data = np.ascontiguousarray(frame).tobytes()
+        height = frame.shape[0] if frame.ndim >= 2 else 1
+        record = RecordedFrame(
+            timestampNs=time.monotonic_ns(),
+            frameBytes=len(data),
+            pixelFormat=self._pixel_format.sdk_format_code,
+            width=frame.shape[1] if frame.ndim >= 2 else len(data),
+            height=height,
+            rowBytes=len(data) // height,
+            metadata=self._hdr_metadata or HDRMetadata(),
+        )
+        if data:
+            self._recording.record(data, record)
+
+    def stop_recording(self) -> RecorderStats:
+        """Stop recording and close the file."""
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        if self._recording is not None:
+            self._recorder_stats = self._recording.close()
+            self._recording = None
+        return self.recorder_stats()
+
+    def recorder_stats(self) -> RecorderStats:
+        """Get the counters of the running or last recording."""
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        if self._recording is not None:
+            return self._recording.stats()
+        return RecorderStats.from_buffer_copy(self._recorder_stats)
+
+    def play_recording(self, path: str | Path) -> ClipPlaybackStats:
+        """Lay out a replay with the library and run it on the simulated player."""
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        if not self.started:
+            raise RuntimeError("Failed to replay recording (error -1)")
+        try:
+            sequence = plan_replay(
+                path,
+                self._pixel_format.sdk_format_code,
+                _mock_nominal_interval_ns(self._display_mode),
+            )
+        except ValueError as e:
+            raise RuntimeError(f"Failed to replay recording: {e}") from e
+        self.stop_stream()
+        self.stop_scheduler()
+        self._frc_status.playback.running = 0
+        self._replay_stats = ClipPlaybackStats(
+            running=1,
+            frames=int(sequence.max()) + 1,
+            sequenceLength=len(sequence),
+            prerollFrames=3,
+        )
+        self._replay_started_ns = time.monotonic_ns()
+        self._method_calls["play_recording"].append(
+            {"path": str(path), "sequence": len(sequence)}
+        )
+        return self.replay_stats()
+
+    def stop_replay(self) -> None:
+        """Stop replaying a recording."""
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        if self._replay_stats.running:
+            self.replay_stats()
+            self._replay_stats.running = 0
+
+    def replay_stats(self) -> ClipPlaybackStats:
+        """Get simulated counters of the running or last replay."""
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        stats = self._replay_stats
+        if stats.running:
+            interval = _mock_nominal_interval_ns(self._display_mode)
+            shown = (time.monotonic_ns() - self._replay_started_ns) // interval
+            stats.completed = shown
+            stats.scheduled = shown + stats.prerollFrames
+        return ClipPlaybackStats.from_buffer_copy(stats)
+
+    def set_frame_stats(
+        self, enabled: bool = True, auto_hdr_metadata: bool = False
+    ) -> None:
+        """Enable or disable per-frame statistics."""
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        self._frame_stats_mode = (2 if auto_hdr_metadata else 1) if enabled else 0
+        self._frame_stats = FrameStats()
+        self._method_calls["set_frame_stats"].append(
+            {"enabled": enabled, "auto_hdr_metadata": auto_hdr_metadata}
+        )
+
+    def frame_stats(self) -> FrameStats:
+        """Get the statistics of the most recently displayed frame."""
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        return FrameStats.from_buffer_copy(self._frame_stats)
+
+    def set_thumbnail(
+        self,
+        width: int = 320,
+        height: int = 0,
+        samples: int = 2,
+        interval_ms: int = 250,
+        reference_nits: float = 203.0,
+    ) -> None:
+        """Configure the simulated thumbnail with the library's limits."""
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        if not (
+            0 <= width <= 1920
+            and 0 <= height <= 1080
+            and 1 <= samples <= 8
+            and interval_ms >= 0
+            and reference_nits > 0
+        ):
+            raise RuntimeError("Failed to configure thumbnails (error -1)")
+        self._thumbnail_config = ThumbnailConfig(
+            width, height, samples, interval_ms, reference_nits
+        )
+        self._method_calls["set_thumbnail"].append({"width": width, "height": height})
+
+    def thumbnail_config(self) -> ThumbnailConfig:
+        """Get the simulated thumbnail settings."""
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        return ThumbnailConfig.from_buffer_copy(self._thumbnail_config)
+
+    def thumbnail(self) -> tuple[np.ndarray, ThumbnailInfo] | None:
+        """Point-sample the last RGB frame in the history (not tone mapped)."""
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        config = self._thumbnail_config
+        frame = self._frame_history[-1] if self._frame_history else None
+        if not config.width or frame is None or frame.ndim != 3:
+            return None
+        source_height, source_width = frame.shape[:2]
+        width = min(config.width, source_width)
+        height = config.height or max(1, round(width * source_height / source_width))
+        height = min(height, source_height)
+        ys = ((np.arange(height) + 0.5) * source_height / height).astype(int)
+        xs = ((np.arange(width) + 0.5) * source_width / width).astype(int)
+        max_code = 2**self._pixel_format.bit_depth - 1
+        sampled = frame[np.ix_(ys, xs)][..., :3].astype(np.float64)
+        image = np.rint(np.clip(sampled, 0, max_code) * 255 / max_code)
+        info = ThumbnailInfo(
+            valid=1,
+            width=width,
+            height=height,
+            sourceWidth=source_width,
+            sourceHeight=source_height,
+            sequence=self._frames_output,
+            capturedNs=time.monotonic_ns(),
+        )
+        return image.astype(np.uint8), info
+
+    def _store_cached(
+        self, key: int, frame: np.ndarray, pixel_format: Any, packed: bool
+    ) -> None:
+        self.remove_cached_frame(key)
+        stats = self._frame_cache_stats
+        stats.rawBytes += frame.nbytes
+        stats.compressedBytes += _cached_size(frame)
+        self._frame_cache[key] = (frame, pixel_format, packed)
+        self._frame_cache_stats.entries = len(self._frame_cache)
+        self._method_calls["cache_frame"].append(
+            {"key": key, "shape": frame.shape, "packed": packed}
+        )
+
+    def cache_frame(self, key: int, frame_data: np.ndarray) -> None:
+        """Keep a copy of an RGB frame under key (the mock does not pack)."""
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        if not isinstance(frame_data, np.ndarray) or frame_data.ndim not in (2, 3):
+            raise ValueError("frame_data must be a 2D or 3D numpy array")
+        frame = np.ascontiguousarray(np.astype(frame_data, np.uint16, copy=True))
+        self._store_cached(key, self._place(frame), self._pixel_format, False)
+
+    def cache_packed_frame(
+        self,
+        key: int,
+        data: np.ndarray,
+        width: int,
+        pixel_format: PixelFormatType | None = None,
+    ) -> None:
+        """Keep a copy of packed bytes under key."""
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        packed_frame_desc(data, width, pixel_format)
+        self._store_cached(key, data.copy(), pixel_format or self._pixel_format, True)
+
+    def _recall_cached(self, key: int) -> np.ndarray:
+        """Return the frame as it would leave the library, updating the LRU."""
+        if key not in self._frame_cache:
+            raise RuntimeError(f"Failed to recall cached frame {key} (error -1)")
+        frame, pixel_format, packed = self._frame_cache[key]
+        if pixel_format != self._pixel_format:
+            raise RuntimeError(f"Cached frame {key} is not in the active pixel format")
+        stats = self._frame_cache_stats
+        self._frame_cache.move_to_end(key)
+        if key in self._frame_cache_hot:
+            stats.hits += 1
+            self._frame_cache_hot.move_to_end(key)
+        else:
+            stats.misses += 1
+            self._frame_cache_hot[key] = None
+            while len(self._frame_cache_hot) > stats.hotCapacity:
+                self._frame_cache_hot.popitem(last=False)
+        stats.hotEntries = len(self._frame_cache_hot)
+        return frame.copy() if packed else self._composite_overlays(frame)
+
+    def display_cached_frame(self, key: int) -> None:
+        """Display a cached frame; overlays are drawn over RGB entries."""
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        frame = self._recall_cached(key)
+        self._frc_status.playback.running = 0
+        self.stop_scheduler()
+        self.stop_stream()
+        self._push_frame(frame)
+        self._method_calls["display_cached_frame"].append({"key": key})
+        self._frame_timing.record_completion(time.monotonic_ns())
+
+    def schedule_cached_frame(
+        self,
+        key: int,
+        at_ns: int = 0,
+        duration_frames: int = 1,
+        hdr_metadata: HDRMetadata | int | None = None,
+    ) -> SchedulerDecisionRecord:
+        """Queue a cached frame; due frames enter the history when scheduled."""
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        if self._scheduler is None or at_ns < 0 or duration_frames < 1:
+            raise RuntimeError(f"Failed to schedule cached frame {key} (error -1)")
+        metadata_id = self._hdr_metadata_id(hdr_metadata)
+        record = self._scheduler.submit(self._recall_cached(key), at_ns)
+        record.durationFrames = duration_frames
+        for shown in self._scheduler.dispatch():
+            self._push_frame(shown)
+        self._method_calls["schedule_cached_frame"].append(
+            {
+                "key": key,
+                "at_ns": at_ns,
+                "hdr_metadata_id": metadata_id,
+                "decision": record.decision_name,
+            }
+        )
+        return record
+
+    def remove_cached_frame(self, key: int) -> bool:
+        """Drop one cache entry; False if there was none."""
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        entry = self._frame_cache.pop(key, None)
+        if entry is None:
+            return False
+        stats = self._frame_cache_stats
+        stats.rawBytes -= entry[0].nbytes
+        stats.compressedBytes -= _cached_size(entry[0])
+        stats.entries = len(self._frame_cache)
+        self._frame_cache_hot.pop(key, None)
+        stats.hotEntries = len(self._frame_cache_hot)
+        return True
+
+    def clear_frame_cache(self) -> None:
+        """Drop every cache entry."""
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        for key in list(self._frame_cache):
+            self.remove_cached_frame(key)
+
+    def set_frame_cache_hot_frames(self, count: int) -> None:
+        """Set how many recently used entries count as decoded."""
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        if not 1 <= count <= 64:
+            raise RuntimeError(f"Invalid frame cache hot frame count {count}")
+        if count != self._frame_cache_stats.hotCapacity:
+            self._frame_cache_hot.clear()
+        self._frame_cache_stats.hotCapacity = count
+        self._frame_cache_stats.hotEntries = 0
+
+    def frame_cache_stats(self) -> FrameCacheStats:
+        """Get the simulated frame cache counters."""
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        return FrameCacheStats.from_buffer_copy(self._frame_cache_stats)
+
+    def set_placement(
+        self,
+        fit: PlacementFit | str = PlacementFit.CONTAIN,
+        filter_mode: PlacementFilter | str = PlacementFilter.BOX,
+        width: int = 0,
+        height: int = 0,
+        crop: tuple[int, int, int, int] | None = None,
+        surround: tuple[int, int, int] = (0, 0, 0),
+    ) -> None:
+        """Place RGB frames on the raster (sampling the nearest pixel)."""
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        crop = crop or (0, 0, 0, 0)
+        if min(width, height, *crop) < 0:
+            raise RuntimeError("Invalid placement (error -1)")
+        self._placement = PlacementConfig(
+            enabled=1,
+            width=width,
+            height=height,
+            fit=PlacementFit(fit).int_value,
+            filter=PlacementFilter(filter_mode).int_value,
+            cropX=crop[0],
+            cropY=crop[1],
+            cropWidth=crop[2],
+            cropHeight=crop[3],
+            surround=(ctypes.c_uint16 * 3)(*surround),
+        )
+        self._method_calls["set_placement"].append(
+            {"fit": PlacementFit(fit), "size": (width, height), "crop": crop}
+        )
+
+    def clear_placement(self) -> None:
+        """Send frames at their own size again."""
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        self._placement = PlacementConfig()
+        self._method_calls["set_placement"].append({"fit": None})
+
+    def placement(self) -> PlacementConfig:
+        """Get the simulated placement settings."""
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        return PlacementConfig.from_buffer_copy(self._placement)
+
+    def _place(self, frame: np.ndarray) -> np.ndarray:
+        if not self._placement.enabled:
+            return frame
+        raster = _mock_display_size(self._display_mode)
+        return _mock_place(frame, self._placement, raster)
+
+    def _check_packed_format(self, pixel_format: PixelFormatType | None) -> None:
+        if pixel_format is not None and pixel_format != self._pixel_format:
+            raise RuntimeError("Packed frame is not in the active pixel format")
+
+    @property
+    def packed_frames_in_flight(self) -> int:
+        """The mock copies packed frames, so none are ever referenced."""
+        return 0
+
+    def display_packed_frame(
+        self,
+        data: np.ndarray,
+        width: int,
+        pixel_format: PixelFormatType | None = None,
+    ) -> None:
+        """Display packed bytes; the history holds them as given (mock)."""
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        desc = packed_frame_desc(data, width, pixel_format)
+        self._check_packed_format(pixel_format)
+        self._frc_status.playback.running = 0
+        self.stop_scheduler()
+        self.stop_stream()
+        self._push_frame(data.copy())
+        self._method_calls["display_packed_frame"].append(
+            {"width": width, "height": desc.height, "row_bytes": desc.rowBytes}
+        )
+        self._frame_timing.record_completion(time.monotonic_ns())
+
+    def schedule_packed_frame(
+        self,
+        data: np.ndarray,
+        width: int,
+        at_ns: int = 0,
+        duration_frames: int = 1,
+        pixel_format: PixelFormatType | None = None,
+        hdr_metadata: HDRMetadata | int | None = None,
+    ) -> SchedulerDecisionRecord:
+        """Queue packed bytes; due frames enter the history as given (mock)."""
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        desc = packed_frame_desc(data, width, pixel_format)
+        if self._scheduler is None or at_ns < 0 or duration_frames < 1:
+            raise RuntimeError("Failed to schedule packed frame (error -1)")
+        self._check_packed_format(pixel_format)
+        metadata_id = self._hdr_metadata_id(hdr_metadata)
+        record = self._scheduler.submit(data.copy(), at_ns)
+        record.durationFrames = duration_frames
+        for shown in self._scheduler.dispatch():
+            self._push_frame(shown)
+        self._method_calls["schedule_packed_frame"].append(
+            {
+                "at_ns": at_ns,
+                "row_bytes": desc.rowBytes,
+                "hdr_metadata_id": metadata_id,
+                "decision": record.decision_name,
+            }
+        )
+        return record
+
+    def get_frc_sequence(self) -> list[np.ndarray]:
+        """Get the frames of one FRC cycle in playback order (mock only)."""
+        return list(self._frc_sequence)
 
     # Additional mock-specific methods for testing and verification
 
@@ -327,6 +1937,22 @@ def set_hdr_support(enabled: bool) -> None:
     _mock_config["hdr_support"] = enabled
 
 
+def set_rejected_display_modes(display_modes: list[int]) -> None:
+    """
+    Make mock devices fail to enable output in some display modes.
+
+    A ``reconfigure`` into one of these modes while output is running
+    fails as EnableVideoOutput would, leaving the previous configuration
+    active.
+
+    Parameters
+    ----------
+    display_modes : list[int]
+        BMDDisplayMode codes to refuse
+    """
+    _mock_config["rejected_display_modes"] = list(display_modes)
+
+
 def reset_mock_state() -> None:
     """Reset all mock configuration to defaults and close any open devices."""
     # Close all open mock devices
@@ -345,6 +1971,8 @@ def reset_mock_state() -> None:
                 PixelFormatType.FORMAT_12BIT_RGBLE,
             ],
             "hdr_support": True,
+            "rejected_display_modes": [],
+            "pack_cost_ns": _DEFAULT_PACK_COST_NS.copy(),
             "driver_version": "12.8.1",
             "sdk_version": "15.3.0",
         }
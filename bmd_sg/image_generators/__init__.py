@@ -11,9 +11,17 @@ from bmd_sg.image_generators.checkerboard import (
     ROI,
     PatternGenerator,
 )
+from bmd_sg.image_generators.overlays import (
+    crosshair_sprite,
+    label_sprite,
+    marker_sprite,
+)
 
 __all__ = [
     "DEFAULT_PATTERN_GENERATOR",
     "ROI",
     "PatternGenerator",
+    "crosshair_sprite",
+    "label_sprite",
+    "marker_sprite",
 ]
@@ -0,0 +1,119 @@
+"""Sprite builders for packed-domain overlays.
+
+Overlays are small RGBA arrays that the DeckLink library composites directly
+into the packed output frame (see ``BMDDeckLink.add_overlay``). RGB samples are
+code values at the output bit depth and alpha is 0-255, so a sprite built for
+one bit depth should be rebuilt if the pixel format changes.
+"""
+
+from collections.abc import Sequence
+
+import numpy as np
+from numpy.typing import NDArray
+from PIL import Image, ImageDraw, ImageFont
+
+
+def _solid_sprite(mask: NDArray[np.uint8], color: Sequence[int]) -> NDArray[np.uint16]:
+    """Fill a sprite with one color, using ``mask`` as alpha."""
+    if len(color) != 3:
+        raise ValueError("color must have three components")
+    sprite = np.zeros((*mask.shape, 4), dtype=np.uint16)
+    sprite[..., :3] = np.asarray(color, dtype=np.uint16)
+    sprite[..., 3] = mask
+    return sprite
+
+
+def crosshair_sprite(
+    size: int, color: Sequence[int], thickness: int = 1, gap: int = 0
+) -> NDArray[np.uint16]:
+    """
+    Build a crosshair sprite.
+
+    Parameters
+    ----------
+    size : int
+        Width and height of the sprite in pixels
+    color : Sequence[int]
+        RGB code values at the output bit depth
+    thickness : int, optional
+        Line thickness in pixels. Default is 1.
+    gap : int, optional
+        Radius of the empty area at the centre. Default is 0.
+
+    Returns
+    -------
+    NDArray[np.uint16]
+        Sprite of shape (size, size, 4); place it at (cx - size // 2,
+        cy - size // 2) to centre it on (cx, cy)
+    """
+    if size <= 0 or thickness <= 0:
+        raise ValueError("size and thickness must be positive")
+    mask = np.zeros((size, size), dtype=np.uint8)
+    lo = (size - thickness) // 2
+    mask[lo : lo + thickness, :] = 255
+    mask[:, lo : lo + thickness] = 255
+    if gap > 0:
+        lo, hi = max(size // 2 - gap, 0), size // 2 + gap + 1
+        mask[lo:hi, lo:hi] = 0
+    return _solid_sprite(mask, color)
+
+
+def marker_sprite(
+    size: int, color: Sequence[int], filled: bool = False
+) -> NDArray[np.uint16]:
+    """
+    Build a square marker, e.g. to outline a measurement patch.
+
+    Parameters
+    ----------
+    size : int
+        Width and height of the marker in pixels
+    color : Sequence[int]
+        RGB code values at the output bit depth
+    filled : bool, optional
+        Fill the square instead of drawing its 1-pixel outline. Default is
+        False.
+
+    Returns
+    -------
+    NDArray[np.uint16]
+        Sprite of shape (size, size, 4)
+    """
+    if size <= 0:
+        raise ValueError("size must be positive")
+    mask = np.full((size, size), 255, dtype=np.uint8)
+    if not filled and size > 2:
+        mask[1:-1, 1:-1] = 0
+    return _solid_sprite(mask, color)
+
+
+def label_sprite(
+    text: str, color: Sequence[int], font_size: int = 24
+) -> NDArray[np.uint16]:
+    """
+    Render a text label as an anti-aliased sprite.
+
+    Parameters
+    ----------
+    text : str
+        Label text
+    color : Sequence[int]
+        RGB code values at the output bit depth
+    font_size : int, optional
+        Font size in pixels. Default is 24.
+
+    Returns
+    -------
+    NDArray[np.uint16]
+        Sprite sized to the text's bounding box
+    """
+    try:
+        font = ImageFont.truetype("/System/Library/Fonts/Helvetica.ttc", font_size)
+    except OSError:
+        font = ImageFont.load_default()
+
+    left, top, right, bottom = font.getbbox(text)
+    width, height = max(right - left, 1), max(bottom - top, 1)
+    canvas = Image.new("L", (width, height), 0)
+    ImageDraw.Draw(canvas).text((-left, -top), text, fill=255, font=font)
+    return _solid_sprite(np.asarray(canvas, dtype=np.uint8), color)
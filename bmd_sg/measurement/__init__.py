@@ -0,0 +1,25 @@
+"""
+Measurement runs for BMD signal generator.
+
+This module drives a meter through a sequence of patches on a DeckLink
+output, preparing each patch's frame while the previous one is read so a
+run is paced by the meter rather than by frame generation.
+"""
+
+from bmd_sg.measurement.meters import MeterDriver, MeterReading, SimulatedMeter
+from bmd_sg.measurement.orchestrator import (
+    Measurement,
+    MeasurementOrchestrator,
+    MeasurementRun,
+    PatchTiming,
+)
+
+__all__ = [
+    "Measurement",
+    "MeasurementOrchestrator",
+    "MeasurementRun",
+    "MeterDriver",
+    "MeterReading",
+    "PatchTiming",
+    "SimulatedMeter",
+]
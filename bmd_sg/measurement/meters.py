@@ -0,0 +1,145 @@
+"""
+Meter drivers for measurement runs.
+
+A meter driver is any object with a ``name`` and a blocking ``measure``
+method that integrates over whatever the display currently shows and
+returns a ``MeterReading``. Drivers for real instruments wrap their vendor
+SDK or serial protocol behind this interface; ``SimulatedMeter`` stands in
+for one in tests and when tuning a run without hardware.
+"""
+
+import random
+import time
+from collections.abc import Callable
+from dataclasses import dataclass
+from typing import Any, Protocol, runtime_checkable
+
+# Rec. 709 / sRGB primaries with a D65 white, linear RGB to XYZ
+_REC709_TO_XYZ = (
+    (0.4123908, 0.3575843, 0.1804808),
+    (0.2126390, 0.7151687, 0.0721923),
+    (0.0193308, 0.1191948, 0.9505322),
+)
+
+
+@dataclass(frozen=True)
+class MeterReading:
+    """
+    One reading from a meter.
+
+    Attributes
+    ----------
+    XYZ : tuple[float, float, float]
+        Tristimulus values, Y in cd/m²
+    integration_s : float
+        Time the meter integrated for
+    """
+
+    XYZ: tuple[float, float, float]
+    integration_s: float
+
+    @property
+    def xy(self) -> tuple[float, float]:
+        """CIE 1931 chromaticity, (0, 0) for a black reading."""
+        total = sum(self.XYZ)
+        if total <= 0:
+            return (0.0, 0.0)
+        return (self.XYZ[0] / total, self.XYZ[1] / total)
+
+
+@runtime_checkable
+class MeterDriver(Protocol):
+    """Interface the measurement orchestrator drives a meter through."""
+
+    name: str
+
+    def measure(self, patch: Any) -> MeterReading:
+        """
+        Read the patch on screen, blocking for the integration time.
+
+        Parameters
+        ----------
+        patch : Any
+            The patch the orchestrator is showing, for drivers that adapt
+            their integration to it or log it; most drivers ignore it
+
+        Returns
+        -------
+        MeterReading
+            The reading
+        """
+        ...
+
+
+class SimulatedMeter:
+    """
+    Meter that models a display instead of reading one.
+
+    Each ``measure`` call sleeps for the integration time, so a run against
+    it takes as long as one against a real meter with the same integration
+    time, then returns the XYZ the model gives for the patch.
+
+    Parameters
+    ----------
+    integration_s : float, optional
+        Seconds each reading takes. Default is 0.5.
+    model : Callable[[Any], tuple[float, float, float]] | None, optional
+        Maps a patch to the XYZ it displays as. None models a Rec. 709
+        display with a 2.4 gamma and a ``peak_luminance`` white, for patches
+        that are RGB code value triples at ``bit_depth``.
+    bit_depth : int, optional
+        Code value depth of the default model. Default is 10.
+    peak_luminance : float, optional
+        White luminance in cd/m² of the default model. Default is 100.0.
+    noise : float, optional
+        Standard deviation of multiplicative noise on each reading, e.g.
+        0.002 for 0.2 %. Default is 0.0.
+    seed : int | None, optional
+        Seed of the noise, for repeatable runs.
+    """
+
+    name = "simulated"
+
+    def __init__(
+        self,
+        integration_s: float = 0.5,
+        model: Callable[[Any], tuple[float, float, float]] | None = None,
+        bit_depth: int = 10,
+        peak_luminance: float = 100.0,
+        noise: float = 0.0,
+        seed: int | None = None,
+    ) -> None:
+        if integration_s < 0 or noise < 0:
+            raise ValueError("integration time and noise must not be negative")
+        self.integration_s = integration_s
+        self.bit_depth = bit_depth
+        self.peak_luminance = peak_luminance
+        self.noise = noise
+        self._model = model or self._display_model
+        self._random = random.Random(seed)
+        self.readings = 0
+
+    def _display_model(self, patch: Any) -> tuple[float, float, float]:
+        max_code = (1 << self.bit_depth) - 1
+        linear = [
+            self.peak_luminance
+            * (min(max(float(code), 0.0), max_code) / max_code) ** 2.4
+            for code in patch
+        ]
+        X, Y, Z = (
+            sum(m * c for m, c in zip(row, linear, strict=True))
+            for row in _REC709_TO_XYZ
+        )
+        return (X, Y, Z)
+
+    def measure(self, patch: Any) -> MeterReading:
+        """Sleep for the integration time and return the modelled XYZ."""
+        time.sleep(self.integration_s)
+        XYZ = self._model(patch)
+        if self.noise:
+            XYZ = tuple(v * self._random.gauss(1.0, self.noise) for v in XYZ)
+        self.readings += 1
+        return MeterReading(XYZ=tuple(XYZ), integration_s=self.integration_s)
+
+
+__all__ = ["MeterDriver", "MeterReading", "SimulatedMeter"]
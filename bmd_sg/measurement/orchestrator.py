@@ -0,0 +1,274 @@
+"""
+Pipelined measurement runs.
+
+A measurement run shows each patch, waits for the display to settle and
+reads the meter. Done serially, every patch also pays for generating and
+packing its frame between readings. The orchestrator instead renders and
+packs upcoming patches into the device's frame cache on a worker thread
+while the meter integrates, so the switch to the next patch is a cache
+recall issued the moment a reading returns. A run then takes little more
+than the meter's integration and settle times.
+"""
+
+import time
+from collections import deque
+from collections.abc import Callable, Iterable
+from concurrent.futures import Future, ThreadPoolExecutor
+from dataclasses import dataclass, field
+from typing import Any
+
+import numpy as np
+from numpy.typing import NDArray
+
+from bmd_sg.measurement.meters import MeterDriver, MeterReading
+from bmd_sg.utilities.tracing import tracer
+
+# Frame cache keys used for patches, clear of keys callers typically choose
+DEFAULT_FIRST_KEY = 1 << 48
+
+
+@dataclass(frozen=True)
+class PatchTiming:
+    """
+    Where the time of one patch went, in seconds.
+
+    Attributes
+    ----------
+    prepare : float
+        Rendering and packing the frame on the worker thread
+    wait : float
+        Time the run waited for the frame to be ready after the previous
+        reading; non-zero when preparing a patch takes longer than reading
+        one
+    switch : float
+        Recalling the frame from the cache onto the output
+    settle : float
+        Wait for the display to settle before reading
+    measure : float
+        The meter reading
+    """
+
+    prepare: float
+    wait: float
+    switch: float
+    settle: float
+    measure: float
+
+
+@dataclass(frozen=True)
+class Measurement:
+    """
+    One patch of a run with its reading.
+
+    Attributes
+    ----------
+    index : int
+        Position of the patch in the run
+    patch : Any
+        The patch as given to the run
+    reading : MeterReading
+        What the meter read
+    timing : PatchTiming
+        Time spent on the patch
+    """
+
+    index: int
+    patch: Any
+    reading: MeterReading
+    timing: PatchTiming
+
+
+@dataclass
+class MeasurementRun:
+    """
+    Results of a run.
+
+    Attributes
+    ----------
+    measurements : list[Measurement]
+        Readings in patch order
+    total_s : float
+        Wall time from the start of the run to its last reading
+    """
+
+    measurements: list[Measurement] = field(default_factory=list)
+    total_s: float = 0.0
+
+    @property
+    def measure_s(self) -> float:
+        """Time the meter spent reading, summed over the patches."""
+        return sum(m.timing.measure for m in self.measurements)
+
+    @property
+    def settle_s(self) -> float:
+        """Time spent waiting for the display to settle."""
+        return sum(m.timing.settle for m in self.measurements)
+
+    @property
+    def overhead_s(self) -> float:
+        """Run time spent neither settling nor reading the meter."""
+        return max(self.total_s - self.measure_s - self.settle_s, 0.0)
+
+    @property
+    def efficiency(self) -> float:
+        """Share of the run spent reading the meter, 1.0 being ideal."""
+        return self.measure_s / self.total_s if self.total_s > 0 else 0.0
+
+
+class MeasurementOrchestrator:
+    """
+    Shows patches and reads a meter with frame preparation pipelined.
+
+    Up to ``lookahead`` patches after the one being read are rendered and
+    packed into the device's frame cache ahead of time, by one worker thread
+    so that packing stays off the thread driving the meter. Each patch's
+    cache entry is removed once it has been read.
+
+    Parameters
+    ----------
+    device : BMDDeckLink
+        Open device with output started
+    meter : MeterDriver
+        Meter to read each patch with
+    settle_s : float, optional
+        Wait between showing a patch and reading it. Default is 0.0.
+    lookahead : int, optional
+        Patches prepared ahead of the one being read (1-16). Default is 1.
+    first_key : int, optional
+        First of the consecutive frame cache keys the run uses. Default is
+        ``DEFAULT_FIRST_KEY``.
+
+    Examples
+    --------
+    >>> meter = SimulatedMeter(integration_s=0.2)
+    >>> run = MeasurementOrchestrator(device, meter, settle_s=0.05).run(
+    ...     patches, lambda rgb: np.full((1080, 1920, 3), rgb, np.uint16)
+    ... )
+    >>> run.efficiency
+    0.79...
+    """
+
+    def __init__(
+        self,
+        device: Any,
+        meter: MeterDriver,
+        settle_s: float = 0.0,
+        lookahead: int = 1,
+        first_key: int = DEFAULT_FIRST_KEY,
+    ) -> None:
+        if settle_s < 0:
+            raise ValueError("settle time must not be negative")
+        if not 1 <= lookahead <= 16:
+            raise ValueError("lookahead must be between 1 and 16")
+        self.device = device
+        self.meter = meter
+        self.settle_s = settle_s
+        self.lookahead = lookahead
+        self.first_key = first_key
+
+    def _prepare(
+        self,
+        index: int,
+        patch: Any,
+        render: Callable[[Any], NDArray[np.uint16]],
+    ) -> float:
+        start = time.perf_counter()
+        with tracer.frame("prepare patch", "measurement", index=index):
+            self.device.cache_frame(self.first_key + index, render(patch))
+        return time.perf_counter() - start
+
+    def run(
+        self,
+        patches: Iterable[Any],
+        render: Callable[[Any], NDArray[np.uint16]],
+        on_measurement: Callable[[Measurement], None] | None = None,
+    ) -> MeasurementRun:
+        """
+        Measure every patch in order.
+
+        Parameters
+        ----------
+        patches : Iterable[Any]
+            Patches to show, passed to ``render`` and to the meter; consumed
+            no further ahead than the lookahead
+        render : Callable[[Any], NDArray[np.uint16]]
+            Returns the frame showing a patch, as for ``cache_frame``; called
+            on the worker thread
+        on_measurement : Callable[[Measurement], None] | None, optional
+            Called on the run's thread after each reading, e.g. for progress
+
+        Returns
+        -------
+        MeasurementRun
+            Readings and timings
+
+        Raises
+        ------
+        RuntimeError
+            If a frame cannot be cached or shown, or the meter fails; the
+            run stops and its cache entries are removed
+        """
+        result = MeasurementRun()
+        source = enumerate(patches)
+        pending: deque[tuple[int, Any, Future[float]]] = deque()
+        cached_keys: set[int] = set()
+        start = time.perf_counter()
+
+        with ThreadPoolExecutor(1, thread_name_prefix="patch prepare") as worker:
+
+            def submit_next() -> None:
+                for index, patch in source:
+                    cached_keys.add(self.first_key + index)
+                    future = worker.submit(self._prepare, index, patch, render)
+                    pending.append((index, patch, future))
+                    return
+
+            try:
+                for _ in range(self.lookahead):
+                    submit_next()
+                while pending:
+                    index, patch, future = pending.popleft()
+                    ready = time.perf_counter()
+                    prepare = future.result()
+                    waited = time.perf_counter() - ready
+                    # Keep the lookahead full while this patch is read
+                    submit_next()
+                    with tracer.frame("measure patch", "measurement", index=index):
+                        switched = time.perf_counter()
+                        self.device.display_cached_frame(self.first_key + index)
+                        switch = time.perf_counter() - switched
+                        if self.settle_s:
+                            time.sleep(self.settle_s)
+                        read = time.perf_counter()
+                        reading = self.meter.measure(patch)
+                        measure = time.perf_counter() - read
+                    # Its frame is on screen until the next switch; the
+                    # cache entry is no longer needed
+                    self.device.remove_cached_frame(self.first_key + index)
+                    cached_keys.discard(self.first_key + index)
+                    measurement = Measurement(
+                        index,
+                        patch,
+                        reading,
+                        PatchTiming(prepare, waited, switch, self.settle_s, measure),
+                    )
+                    result.measurements.append(measurement)
+                    if on_measurement:
+                        on_measurement(measurement)
+            finally:
+                result.total_s = time.perf_counter() - start
+                for _, _, future in pending:
+                    future.cancel()
+                worker.shutdown(wait=True)
+                for key in cached_keys:
+                    self.device.remove_cached_frame(key)
+        return result
+
+
+__all__ = [
+    "DEFAULT_FIRST_KEY",
+    "Measurement",
+    "MeasurementOrchestrator",
+    "MeasurementRun",
+    "PatchTiming",
+]
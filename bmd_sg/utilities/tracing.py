@@ -0,0 +1,515 @@
+"""
+Frame tracing across Python and the DeckLink library.
+
+While :data:`tracer` is active, Python records spans of its own (API
+requests, pattern generation, chart rendering and the device calls) and the
+library records the stages of its frame path (copy, pack, cache decode,
+overlay compositing, metadata, display, scheduler queue, dispatch and time on
+the device) into rings of its own per thread. :meth:`Tracer.stop` brings both
+onto one clock and writes a Chrome trace event file, which Perfetto
+(https://ui.perfetto.dev) and ``chrome://tracing`` open.
+
+Spans belong to frames. :meth:`Tracer.frame` starts a frame, or joins the one
+already current in the calling context, and hands its id to the library
+before calling into it; the library carries the id on to the threads that
+finish the frame. The trace links the spans of each frame from the request to
+the completion callback with flow arrows and shows the frame's whole life as
+one async slice.
+
+Python and library spans of one thread share a track, since both identify
+threads by their OS thread id.
+"""
+
+import contextvars
+import ctypes
+import functools
+import itertools
+import json
+import os
+import threading
+import time
+from collections.abc import Callable
+from contextlib import nullcontext
+from pathlib import Path
+from typing import Any, NamedTuple, ParamSpec, TypeVar
+
+# Python spans kept per trace; later ones are counted as dropped
+MAX_PYTHON_SPANS = 1_000_000
+
+# How often the library's rings are drained while tracing. A thread records
+# kTraceRingSpans (8192) spans before it overwrites ones not yet collected.
+_COLLECT_INTERVAL = 0.25
+_COLLECT_BATCH = 4096
+_CLOCK_SAMPLES = 16
+
+_current_frame: contextvars.ContextVar[int] = contextvars.ContextVar(
+    "trace_frame", default=0
+)
+_INACTIVE = nullcontext(0)
+
+P = ParamSpec("P")
+R = TypeVar("R")
+
+
+class _PythonSpan(NamedTuple):
+    name: str
+    category: str
+    start_ns: int
+    end_ns: int
+    thread_id: int
+    frame_id: int
+    args: dict[str, Any]
+
+
+class _SpanScope:
+    """Records its own lifetime as a span of the current frame."""
+
+    __slots__ = ("_args", "_category", "_frame_id", "_name", "_start", "_tracer")
+
+    def __init__(
+        self, tracer: "Tracer", name: str, category: str, args: dict[str, Any]
+    ) -> None:
+        self._tracer = tracer
+        self._name = name
+        self._category = category
+        self._args = args
+        self._frame_id = 0
+        self._start = 0
+
+    def __enter__(self) -> int:
+        self._frame_id = _current_frame.get()
+        self._start = time.monotonic_ns()
+        return self._frame_id
+
+    def __exit__(self, *_exc: object) -> None:
+        self._tracer._record(
+            self._name, self._category, self._start, self._frame_id, self._args
+        )
+
+
+class _FrameScope(_SpanScope):
+    """A span that makes its frame current, for Python and the library."""
+
+    __slots__ = ("_outer", "_token")
+
+    def __enter__(self) -> int:
+        self._outer = _current_frame.get()
+        frame_id = self._outer or self._tracer._next_frame_id()
+        self._token = _current_frame.set(frame_id)
+        self._tracer._set_library_frame(frame_id)
+        return super().__enter__()
+
+    def __exit__(self, *exc: object) -> None:
+        super().__exit__(*exc)
+        _current_frame.reset(self._token)
+        self._tracer._set_library_frame(self._outer)
+
+
+class Tracer:
+    """
+    Collects spans from Python and the library into one Chrome trace.
+
+    The tracer is inactive until :meth:`start` is called; while inactive,
+    :meth:`span` and :meth:`frame` return a shared no-op context manager and
+    the library records nothing.
+    """
+
+    def __init__(self) -> None:
+        self._lock = threading.Lock()
+        self._active = False
+        self._spans: list[_PythonSpan] = []
+        self._dropped = 0
+        self._thread_names: dict[int, str] = {}
+        self._frame_ids = itertools.count(1)
+        self._lib: Any = None
+        self._stages: tuple[str, ...] = ()
+        self._origin_ns = 0
+        self._offset_ns = 0
+        # Library spans as (start, end, frame, thread, stage)
+        self._native: list[tuple[int, int, int, int, int]] = []
+        self._collector: threading.Thread | None = None
+        self._stop_collecting = threading.Event()
+
+    @property
+    def active(self) -> bool:
+        """Whether spans are currently being recorded."""
+        return self._active
+
+    def start(self) -> None:
+        """
+        Start a trace, in the library too if it is loaded.
+
+        Raises
+        ------
+        RuntimeError
+            If a trace is already in progress
+        """
+        with self._lock:
+            if self._active:
+                raise RuntimeError("A trace is already in progress")
+            self._spans = []
+            self._dropped = 0
+            self._thread_names = {}
+            self._native = []
+            self._lib, self._stages = _load_library()
+            self._origin_ns = time.monotonic_ns()
+            if self._lib is not None:
+                self._offset_ns = self._clock_offset()
+                self._lib.decklink_trace_set_enabled(True)
+                self._stop_collecting.clear()
+                self._collector = threading.Thread(
+                    target=self._collect_loop, name="trace collector", daemon=True
+                )
+                self._collector.start()
+            self._active = True
+
+    def span(
+        self, name: str, category: str = "python", **args: Any
+    ) -> _SpanScope | nullcontext:
+        """
+        Context manager recording a span of the current frame, if any.
+
+        Parameters
+        ----------
+        name : str
+            Span name shown in the trace
+        category : str
+            Trace event category
+        **args
+            Extra values shown with the span
+
+        Returns
+        -------
+        context manager
+            Yields the current frame id (0 for none)
+        """
+        if not self._active:
+            return _INACTIVE
+        return _SpanScope(self, name, category, args)
+
+    def frame(
+        self, name: str, category: str = "python", **args: Any
+    ) -> _SpanScope | nullcontext:
+        """
+        Context manager recording a span that starts a frame.
+
+        Inside the context the frame is current, so nested spans, library
+        calls made from this thread and work the library hands to its own
+        threads all carry its id. Nested inside another frame it joins that
+        frame instead of starting one.
+
+        Parameters
+        ----------
+        name : str
+            Span name shown in the trace
+        category : str
+            Trace event category
+        **args
+            Extra values shown with the span
+
+        Returns
+        -------
+        context manager
+            Yields the frame id
+        """
+        if not self._active:
+            return _INACTIVE
+        return _FrameScope(self, name, category, args)
+
+    def stop(self, path: Path | None = None) -> dict[str, Any]:
+        """
+        Stop the trace and build its Chrome trace event file.
+
+        Parameters
+        ----------
+        path : Path | None
+            File to write the trace to as JSON; None to only return it
+
+        Returns
+        -------
+        dict[str, Any]
+            The trace, with ``traceEvents`` and the span counts in
+            ``otherData``
+
+        Raises
+        ------
+        RuntimeError
+            If no trace is in progress
+        """
+        with self._lock:
+            if not self._active:
+                raise RuntimeError("No trace is in progress")
+            self._active = False
+        threads: dict[int, str] = {}
+        lost = 0
+        if self._lib is not None:
+            self._lib.decklink_trace_set_enabled(False)
+            self._stop_collecting.set()
+            if self._collector is not None:
+                self._collector.join()
+                self._collector = None
+            self._collect()
+            threads, lost = self._library_threads()
+
+        trace = self._chrome_trace(threads, lost)
+        if path is not None:
+            with path.open("w", encoding="utf-8") as f:
+                json.dump(trace, f)
+        self._spans = []
+        self._native = []
+        return trace
+
+    def _next_frame_id(self) -> int:
+        return next(self._frame_ids)
+
+    def _set_library_frame(self, frame_id: int) -> None:
+        if self._lib is not None:
+            self._lib.decklink_trace_set_frame(frame_id)
+
+    def _record(
+        self,
+        name: str,
+        category: str,
+        start_ns: int,
+        frame_id: int,
+        args: dict[str, Any],
+    ) -> None:
+        end_ns = time.monotonic_ns()
+        thread_id = threading.get_native_id()
+        with self._lock:
+            if not self._active:
+                return
+            if len(self._spans) >= MAX_PYTHON_SPANS:
+                self._dropped += 1
+                return
+            if thread_id not in self._thread_names:
+                self._thread_names[thread_id] = threading.current_thread().name
+            self._spans.append(
+                _PythonSpan(name, category, start_ns, end_ns, thread_id, frame_id, args)
+            )
+
+    def _clock_offset(self) -> int:
+        """Library clock to Python clock offset, from the tightest sample."""
+        samples = []
+        for _ in range(_CLOCK_SAMPLES):
+            before = time.monotonic_ns()
+            library = self._lib.decklink_trace_now_ns()
+            after = time.monotonic_ns()
+            samples.append((after - before, (before + after) // 2 - library))
+        return min(samples)[1]
+
+    def _collect_loop(self) -> None:
+        while not self._stop_collecting.wait(_COLLECT_INTERVAL):
+            self._collect()
+
+    def _collect(self) -> None:
+        """Move the spans the library has recorded so far into the trace."""
+        from bmd_sg.decklink.bmd_decklink import TraceSpan
+
+        buffer = (TraceSpan * _COLLECT_BATCH)()
+        while True:
+            count = self._lib.decklink_trace_collect(buffer, _COLLECT_BATCH)
+            if count <= 0:
+                return
+            self._native.extend(
+                (s.startNs, s.endNs, s.frameId, s.threadId, s.stage)
+                for s in buffer[:count]
+            )
+            if count < _COLLECT_BATCH:
+                return
+
+    def _library_threads(self) -> tuple[dict[int, str], int]:
+        """Names of the library's threads, and the spans it lost."""
+        from bmd_sg.decklink.bmd_decklink import TraceStats, TraceThread
+
+        stats = TraceStats()
+        self._lib.decklink_trace_get_stats(ctypes.byref(stats))
+        buffer = (TraceThread * max(stats.threads, 1))()
+        count = self._lib.decklink_trace_get_threads(buffer, len(buffer))
+        names = {
+            thread.threadId: thread.name.decode("utf-8", errors="replace")
+            for thread in buffer[: max(count, 0)]
+            if thread.name
+        }
+        return names, stats.lost
+
+    def _chrome_trace(self, threads: dict[int, str], lost: int) -> dict[str, Any]:
+        """Build the trace from the recorded spans and thread names."""
+        pid = os.getpid()
+        origin = self._origin_ns
+
+        def us(ns: int) -> float:
+            return round((ns - origin) / 1000.0, 3)
+
+        events: list[dict[str, Any]] = []
+        # Per frame: (start, end, thread) of every span
+        frames: dict[int, list[tuple[int, int, int]]] = {}
+
+        for span in self._spans:
+            args = dict(span.args)
+            if span.frame_id:
+                args["frame"] = span.frame_id
+                frames.setdefault(span.frame_id, []).append(
+                    (span.start_ns, span.end_ns, span.thread_id)
+                )
+            events.append(
+                {
+                    "name": span.name,
+                    "cat": span.category,
+                    "ph": "X",
+                    "ts": us(span.start_ns),
+                    "dur": round((span.end_ns - span.start_ns) / 1000.0, 3),
+                    "pid": pid,
+                    "tid": span.thread_id,
+                    "args": args,
+                }
+            )
+
+        for start, end, frame_id, thread_id, stage in self._native:
+            start += self._offset_ns
+            end += self._offset_ns
+            if frame_id:
+                frames.setdefault(frame_id, []).append((start, end, thread_id))
+            events.append(
+                {
+                    "name": (
+                        self._stages[stage]
+                        if 0 <= stage < len(self._stages)
+                        else f"stage {stage}"
+                    ),
+                    "cat": "decklink",
+                    "ph": "X",
+                    "ts": us(start),
+                    "dur": round((end - start) / 1000.0, 3),
+                    "pid": pid,
+                    "tid": thread_id,
+                    "args": {"frame": frame_id} if frame_id else {},
+                }
+            )
+
+        for frame_id, spans in frames.items():
+            events.extend(_frame_events(frame_id, sorted(spans), pid, us))
+
+        names = {**self._thread_names, **threads}
+        events.append(
+            {
+                "name": "process_name",
+                "ph": "M",
+                "pid": pid,
+                "args": {"name": "bmd-signal-gen"},
+            }
+        )
+        events.extend(
+            {
+                "name": "thread_name",
+                "ph": "M",
+                "pid": pid,
+                "tid": thread_id,
+                "args": {"name": name},
+            }
+            for thread_id, name in names.items()
+        )
+
+        return {
+            "traceEvents": events,
+            "displayTimeUnit": "ms",
+            "otherData": {
+                "frames": len(frames),
+                "python_spans": len(self._spans),
+                "python_spans_dropped": self._dropped,
+                "library_spans": len(self._native),
+                "library_spans_lost": lost,
+                "clock_offset_ns": self._offset_ns,
+            },
+        }
+
+
+def _frame_events(
+    frame_id: int,
+    spans: list[tuple[int, int, int]],
+    pid: int,
+    us: Callable[[int], float],
+) -> list[dict[str, Any]]:
+    """
+    Lifetime slice of a frame and the flow linking its threads.
+
+    ``spans`` are (start, end, thread) sorted by start. The flow steps onto
+    the first span of each run of spans on one thread.
+    """
+    first_thread = spans[0][2]
+    common = {"cat": "frame", "name": f"frame {frame_id}", "id": frame_id, "pid": pid}
+    events = [
+        {**common, "ph": "b", "ts": us(spans[0][0]), "tid": first_thread},
+        {
+            **common,
+            "ph": "e",
+            "ts": us(max(end for _, end, _ in spans)),
+            "tid": first_thread,
+        },
+    ]
+
+    steps = [spans[0]]
+    for span in spans[1:]:
+        if span[2] != steps[-1][2]:
+            steps.append(span)
+    if len(steps) > 1:
+        for i, (start, _, thread_id) in enumerate(steps):
+            phase = "s" if i == 0 else "f" if i == len(steps) - 1 else "t"
+            events.append(
+                {**common, "ph": phase, "bp": "e", "ts": us(start), "tid": thread_id}
+            )
+    return events
+
+
+def _load_library() -> tuple[Any, tuple[str, ...]]:
+    """The loaded library if it can trace, and its stage names."""
+    try:
+        from bmd_sg.decklink.bmd_decklink import TRACE_STAGES, DecklinkSDKWrapper
+    except (ImportError, OSError):
+        return None, ()
+    if not isinstance(DecklinkSDKWrapper, ctypes.CDLL) or not hasattr(
+        DecklinkSDKWrapper, "decklink_trace_set_enabled"
+    ):
+        return None, ()
+    return DecklinkSDKWrapper, TRACE_STAGES
+
+
+def traced(
+    name: str, category: str = "python", *, frame: bool = False
+) -> Callable[[Callable[P, R]], Callable[P, R]]:
+    """
+    Decorator recording each call of a function as a span.
+
+    Parameters
+    ----------
+    name : str
+        Span name shown in the trace
+    category : str
+        Trace event category
+    frame : bool
+        Record the call with :meth:`Tracer.frame` rather than
+        :meth:`Tracer.span`
+
+    Returns
+    -------
+    Callable
+        The decorator
+    """
+
+    def decorate(function: Callable[P, R]) -> Callable[P, R]:
+        @functools.wraps(function)
+        def wrapper(*args: P.args, **kwargs: P.kwargs) -> R:
+            if not tracer.active:
+                return function(*args, **kwargs)
+            scope = tracer.frame if frame else tracer.span
+            with scope(name, category):
+                return function(*args, **kwargs)
+
+        return wrapper
+
+    return decorate
+
+
+tracer = Tracer()
+
+__all__ = ["MAX_PYTHON_SPANS", "Tracer", "traced", "tracer"]
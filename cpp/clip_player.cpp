@@ -0,0 +1,191 @@
+#include "clip_player.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+
+ClipPlayer::ClipPlayer()
+    : m_output(nullptr),
+      m_timing(nullptr),
+      m_frameDuration(0),
+      m_timeScale(0),
+      m_nextIndex(0),
+      m_running(false),
+      m_stopPending(false),
+      m_stats{} {}
+
+ClipPlayer::~ClipPlayer() {
+  stop();
+}
+
+HRESULT ClipPlayer::QueryInterface(REFIID iid, LPVOID* ppv) {
+  if (!ppv)
+    return E_INVALIDARG;
+
+  CFUUIDBytes iunknown = CFUUIDGetUUIDBytes(IUnknownUUID);
+  if (memcmp(&iid, &iunknown, sizeof(REFIID)) == 0 ||
+      memcmp(&iid, &IID_IDeckLinkVideoOutputCallback, sizeof(REFIID)) == 0) {
+    *ppv = static_cast<IDeckLinkVideoOutputCallback*>(this);
+    return S_OK;
+  }
+
+  *ppv = nullptr;
+  return E_NOINTERFACE;
+}
+
+/**
+ * @brief Starts looped scheduled playback of a clip
+ *
+ * Schedules @p prerollFrames entries of the sequence before starting the
+ * stream clock at zero; every completion then schedules one more entry, so
+ * the queue depth stays at the preroll.
+ *
+ * @return int 0 on success, -1 on invalid arguments, -3 if the SDK rejects
+ *         the callback, a frame or the playback start
+ */
+int ClipPlayer::start(IDeckLinkOutput* output,
+                      const std::vector<IDeckLinkMutableVideoFrame*>& frames,
+                      const std::vector<uint16_t>& sequence,
+                      BMDTimeValue frameDuration,
+                      BMDTimeScale timeScale,
+                      int prerollFrames,
+                      FrameTimingAnalyzer* timing) {
+  if (!output || frames.empty() || sequence.empty() || frameDuration <= 0 ||
+      timeScale <= 0)
+    return -1;
+  for (uint16_t index : sequence) {
+    if (index >= frames.size())
+      return -1;
+  }
+  stop();
+
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_output = output;
+  m_timing = timing;
+  m_frames.assign(frames.begin(), frames.end());
+  for (IDeckLinkMutableVideoFrame* frame : m_frames)
+    frame->AddRef();
+  m_sequence.assign(sequence.begin(), sequence.end());
+  m_frameDuration = frameDuration;
+  m_timeScale = timeScale;
+  m_nextIndex = 0;
+  m_stats = {};
+  m_stats.frames = static_cast<int32_t>(m_frames.size());
+  m_stats.sequenceLength = static_cast<int32_t>(m_sequence.size());
+  m_stats.prerollFrames = std::max(prerollFrames, 2);
+
+  HRESULT result = m_output->SetScheduledFrameCompletionCallback(this);
+  for (int i = 0; result == S_OK && i < m_stats.prerollFrames; i++)
+    result = scheduleNext();
+  if (result == S_OK)
+    result = m_output->StartScheduledPlayback(0, m_timeScale, 1.0);
+  if (result != S_OK) {
+    // Playback never started, so there is no stop callback to wait for
+    std::cerr << "[ClipPlayer] Could not start scheduled playback. HRESULT: 0x"
+              << std::hex << result << std::dec << std::endl;
+    lock.unlock();
+    stop();
+    return -3;
+  }
+
+  m_running = true;
+  m_stats.running = 1;
+  std::cerr << "[ClipPlayer] Playing " << m_stats.frames << " frame(s) in a "
+            << m_stats.sequenceLength << "-frame loop with "
+            << m_stats.prerollFrames << " frames of preroll" << std::endl;
+  return 0;
+}
+
+HRESULT ClipPlayer::scheduleNext() {
+  const size_t position = static_cast<size_t>(m_nextIndex % m_sequence.size());
+  HRESULT result = m_output->ScheduleVideoFrame(
+      m_frames[m_sequence[position]], m_nextIndex * m_frameDuration,
+      m_frameDuration, m_timeScale);
+  if (result != S_OK)
+    return result;
+  m_nextIndex++;
+  m_stats.scheduled++;
+  return S_OK;
+}
+
+int ClipPlayer::stop() {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  if (!m_output)
+    return 0;
+
+  const bool wasRunning = m_running;
+  m_running = false;
+  m_stats.running = 0;
+  if (wasRunning) {
+    m_stopPending = true;
+    lock.unlock();
+    // Queued frames come back as flushed completions, then the stop callback
+    m_output->StopScheduledPlayback(0, nullptr, 0);
+    lock.lock();
+    if (!m_stopped.wait_for(lock, std::chrono::seconds(2),
+                            [this] { return !m_stopPending; })) {
+      std::cerr << "[ClipPlayer] Timed out waiting for playback to stop"
+                << std::endl;
+      m_stopPending = false;
+    }
+  }
+
+  m_output->SetScheduledFrameCompletionCallback(nullptr);
+  releaseFrames();
+  m_output = nullptr;
+  m_timing = nullptr;
+  return 0;
+}
+
+void ClipPlayer::releaseFrames() {
+  for (IDeckLinkMutableVideoFrame* frame : m_frames)
+    frame->Release();
+  m_frames.clear();
+  m_sequence.clear();
+}
+
+bool ClipPlayer::running() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_running;
+}
+
+ClipPlaybackStats ClipPlayer::stats() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_stats;
+}
+
+HRESULT ClipPlayer::ScheduledFrameCompleted(
+    IDeckLinkVideoFrame* completedFrame,
+    BMDOutputFrameCompletionResult result) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  switch (result) {
+    case bmdOutputFrameDisplayedLate:
+      m_stats.displayedLate++;
+      break;
+    case bmdOutputFrameDropped:
+      m_stats.dropped++;
+      break;
+    case bmdOutputFrameFlushed:
+      m_stats.flushed++;
+      return S_OK;
+    default:
+      break;
+  }
+  m_stats.completed++;
+  if (m_timing)
+    m_timing->recordCompletion(FrameTimingAnalyzer::nowNs(), true);
+
+  if (m_running && scheduleNext() != S_OK) {
+    std::cerr << "[ClipPlayer] Failed to schedule frame " << m_nextIndex
+              << std::endl;
+  }
+  return S_OK;
+}
+
+HRESULT ClipPlayer::ScheduledPlaybackHasStopped() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_stopPending = false;
+  m_stopped.notify_all();
+  return S_OK;
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "DeckLinkAPI.h"
+#include "frame_timing.h"
+#include "memory_stats.h"
+
+/*
+ * Looped scheduled playback of pre-packed frames
+ *
+ * A clip is a small set of packed frames plus a sequence of indices into it.
+ * The player schedules the sequence on the hardware clock, one entry per
+ * frame duration, and tops the queue up from the SDK's completion callback, so
+ * the cadence is exact and steady-state playback costs no packing and no
+ * allocation. Used for temporal dithering (FRC), where a few constituent
+ * frames alternate with a controlled duty cycle.
+ */
+
+struct ClipPlaybackStats {
+  int32_t running;
+  int32_t frames;          // Distinct frames in the clip
+  int32_t sequenceLength;  // Entries in one loop of the sequence
+  int32_t prerollFrames;
+  int64_t scheduled;
+  int64_t completed;
+  int64_t displayedLate;
+  int64_t dropped;
+  int64_t flushed;
+};
+
+class ClipPlayer final : public IDeckLinkVideoOutputCallback {
+ public:
+  ClipPlayer();
+  ~ClipPlayer();
+
+  // Takes a reference on each frame and starts scheduled playback of
+  // @p sequence (indices into @p frames), looping. Output must be enabled.
+  int start(IDeckLinkOutput* output,
+            const std::vector<IDeckLinkMutableVideoFrame*>& frames,
+            const std::vector<uint16_t>& sequence,
+            BMDTimeValue frameDuration,
+            BMDTimeScale timeScale,
+            int prerollFrames,
+            FrameTimingAnalyzer* timing);
+  // Stops playback, waits for the SDK to flush and releases the frames
+  int stop();
+  bool running() const;
+  ClipPlaybackStats stats() const;
+
+  // IUnknown; lifetime is owned by DeckLinkSignalGen, not reference counted
+  HRESULT QueryInterface(REFIID iid, LPVOID* ppv) override;
+  ULONG AddRef() override { return 1; }
+  ULONG Release() override { return 1; }
+
+  // IDeckLinkVideoOutputCallback
+  HRESULT ScheduledFrameCompleted(IDeckLinkVideoFrame* completedFrame,
+                                  BMDOutputFrameCompletionResult result)
+      override;
+  HRESULT ScheduledPlaybackHasStopped() override;
+
+ private:
+  // Schedules the next sequence entry; m_mutex must be held
+  HRESULT scheduleNext();
+  void releaseFrames();
+
+  mutable std::mutex m_mutex;
+  std::condition_variable m_stopped;
+  IDeckLinkOutput* m_output;
+  FrameTimingAnalyzer* m_timing;
+  TrackedVector<IDeckLinkMutableVideoFrame*, kMemoryCaches> m_frames;
+  TrackedVector<uint16_t, kMemoryCaches> m_sequence;
+  BMDTimeValue m_frameDuration;
+  BMDTimeScale m_timeScale;
+  int64_t m_nextIndex;  // Sequence position of the next frame to schedule
+  bool m_running;
+  bool m_stopPending;
+  ClipPlaybackStats m_stats;
+};
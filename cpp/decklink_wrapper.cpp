@@ -3,9 +3,13 @@
 #include <CoreFoundation/CoreFoundation.h>
 
 #include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
 #include <cstring>
 #include <format>
 #include <iostream>
+#include <unordered_map>
 
 #include "DeckLinkAPIVersion.h"
 #include "pixel_packing.h"
@@ -31,9 +35,26 @@ DeckLinkSignalGen::DeckLinkSignalGen()
       m_displayMode(bmdModeHD1080p30),
       m_width(1920),
       m_height(1080),
+      m_sourceWidth(1920),
+      m_sourceHeight(1080),
       m_outputEnabled(false),
       m_pixelFormat(bmdFormat12BitRGBLE),
-      m_formatsCached(false) {
+      m_hdrProvider(nullptr),
+      m_formatsCached(false),
+      m_applied444(-1),
+      m_reconfigureStats{},
+      m_threadPolicy{-1, kThreadSchedOther, 0, 0, -1, 0},
+      m_threadPolicyStatus{-1, kThreadPinNone, kThreadSchedOther, 0, 0, 0,
+                           0, 0, 0},
+      m_timingDisplayMode(bmdModeUnknown),
+      m_packedBaseValid(false),
+      m_frameBytes(nullptr),
+      m_frcStatus{},
+      m_schedulerPoolFrames(0),
+      m_frameStatsMode(kFrameStatsOn),
+      m_frameStats{},
+      m_nitsTableFormat(0),
+      m_placement{} {
   // Initialize with SDR/Rec709 defaults to minimize HDR signaling until
   // explicitly set. This matches BMD SDK SignalGenerator sample behavior.
   m_hdrMetadata.EOTF = 1;                         // SDR
@@ -55,10 +76,23 @@ DeckLinkSignalGen::~DeckLinkSignalGen() {
   if (m_outputEnabled) {
     stopOutput();
   }
+  m_pipeline.stop();
+  stopBackgroundOutput();
+  m_recorder.stop();
+  m_packWorkers.stop();
   if (m_frame) {
     m_frame->Release();
     m_frame = nullptr;
   }
+  m_frameCache.clear();
+  m_framePool.clear();
+  m_clipPool.clear();
+  m_schedulerPool.clear();
+  m_streamPool.clear();
+  if (m_hdrProvider) {
+    m_hdrProvider->Release();
+    m_hdrProvider = nullptr;
+  }
   if (m_output) {
     m_output->Release();
     m_output = nullptr;
@@ -95,6 +129,132 @@ void DeckLinkSignalGen::logFrameInfo(const char* context) {
   }
 }
 
+// Determine if this is an RGB format requiring 4:4:4 output
+static bool requiresSDI444(BMDPixelFormat pixelFormat) {
+  switch (pixelFormat) {
+    case bmdFormat10BitRGB:
+    case bmdFormat12BitRGB:
+    case bmdFormat12BitRGBLE:
+    case bmdFormat10BitRGBXLE:
+    case bmdFormat10BitRGBX:
+    case bmdFormat8BitARGB:
+    case bmdFormat8BitBGRA:
+      return true;
+    default:
+      // YUV formats and others use 4:2:2
+      return false;
+  }
+}
+
+static int64_t elapsedMicroseconds(
+    std::chrono::steady_clock::time_point since) {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+             std::chrono::steady_clock::now() - since)
+      .count();
+}
+
+/**
+ * @brief Lays out one temporal dithering (FRC) cycle
+ *
+ * Each channel's fractional target is split into a low code value and a
+ * duty: the channel shows low + 1 on round(fraction * cycleFrames) frames of
+ * the cycle. A fraction rounding to a whole cycle carries to the next code,
+ * and targets at or above @p maxCode hold maxCode. Frame k is "high" for a
+ * channel when its running duty count steps (a Bresenham spread), which
+ * distributes the high frames as evenly as possible.
+ *
+ * @param config Targets and cycle length; the ROI is not used
+ * @param maxCode Largest code value of the pixel format
+ * @param status Receives low, dutyFrames, achieved and cycleFrames
+ * @param upper Receives cycleFrames masks, bit c set when channel c shows
+ *        low + 1 on that frame
+ * @return int 0 on success, -1 for a negative target or a cycle outside 1-64
+ */
+static int planFrc(const FrcConfig& config,
+                   int maxCode,
+                   FrcStatus* status,
+                   uint8_t* upper) {
+  const int cycle = config.cycleFrames;
+  if (cycle < 1 || cycle > 64 || maxCode < 1)
+    return -1;
+  *status = {};
+  status->cycleFrames = cycle;
+  for (int c = 0; c < 3; c++) {
+    const double target = config.target[c];
+    if (!(target >= 0.0))
+      return -1;
+    int low = target < maxCode ? static_cast<int>(target) : maxCode;
+    int duty = static_cast<int>(std::lround((target - low) * cycle));
+    if (duty == cycle) {
+      low++;
+      duty = 0;
+    }
+    if (low >= maxCode) {
+      low = maxCode;
+      duty = 0;
+    }
+    status->low[c] = low;
+    status->dutyFrames[c] = duty;
+    status->achieved[c] = low + static_cast<double>(duty) / cycle;
+  }
+
+  for (int k = 0; k < cycle; k++) {
+    upper[k] = 0;
+    for (int c = 0; c < 3; c++) {
+      const int duty = status->dutyFrames[c];
+      if ((k + 1) * duty / cycle - k * duty / cycle)
+        upper[k] |= 1 << c;
+    }
+  }
+  return 0;
+}
+
+/**
+ * @brief Writes the SDI 4:4:4 link flag required by a pixel format
+ *
+ * The flag last written is remembered so repeated output starts and
+ * reconfigurations only touch IDeckLinkConfiguration when the link layout
+ * actually changes.
+ *
+ * @param pixelFormat Pixel format the output will carry
+ * @param setFlagCalls Optional counter incremented for each SetFlag issued
+ * @return int 0 on success, -2 if the device rejected the flag
+ */
+int DeckLinkSignalGen::configureSDILink(BMDPixelFormat pixelFormat,
+                                        int32_t* setFlagCalls) {
+  if (!m_configuration) {
+    std::cerr << "[DeckLink] Warning: No configuration interface available for "
+                 "pre-EnableOutput SDI setup"
+              << std::endl;
+    return 0;
+  }
+
+  const bool output444 = requiresSDI444(pixelFormat);
+  if (m_applied444 == static_cast<int>(output444))
+    return 0;
+
+  std::cerr << "[DeckLink] Pre-EnableOutput: Setting SDI to "
+            << (output444 ? "4:4:4" : "4:2:2") << " for pixel format "
+            << fourCharCode(static_cast<int>(pixelFormat)) << std::endl;
+
+  HRESULT configResult =
+      m_configuration->SetFlag(bmdDeckLinkConfig444SDIVideoOutput, output444);
+  if (setFlagCalls)
+    (*setFlagCalls)++;
+  // Note: SetFlag may return E_NOTIMPL for devices without SDI output (like
+  // Intensity Pro 4K)
+  if (configResult != S_OK && configResult != E_NOTIMPL) {
+    std::cerr << "[DeckLink] CRITICAL: Failed to set SDI output mode before "
+                 "EnableVideoOutput. HRESULT: 0x"
+              << std::hex << configResult << std::dec << std::endl;
+    m_applied444 = -1;
+    return -2;
+  }
+  m_applied444 = static_cast<int>(output444);
+
+  return 0;
+}
+
 /**
  * @brief Enables video output on the DeckLink device
  *
@@ -119,45 +279,8 @@ int DeckLinkSignalGen::startOutput(BMDDisplayMode displayMode) {
 
   // CRITICAL: Configure SDI output mode BEFORE enabling video output (following
   // SignalGenHDR)
-  if (m_configuration) {
-    bool output444;
-
-    // Determine if this is an RGB format requiring 4:4:4 output
-    switch (m_pixelFormat) {
-      case bmdFormat10BitRGB:
-      case bmdFormat12BitRGB:
-      case bmdFormat12BitRGBLE:
-      case bmdFormat10BitRGBXLE:
-      case bmdFormat10BitRGBX:
-      case bmdFormat8BitARGB:
-      case bmdFormat8BitBGRA:
-        output444 = true;
-        break;
-      default:
-        // YUV formats and others use 4:2:2
-        output444 = false;
-        break;
-    }
-
-    std::cerr << "[DeckLink] Pre-EnableOutput: Setting SDI to "
-              << (output444 ? "4:4:4" : "4:2:2") << " for pixel format "
-              << fourCharCode(static_cast<int>(m_pixelFormat)) << std::endl;
-
-    HRESULT configResult =
-        m_configuration->SetFlag(bmdDeckLinkConfig444SDIVideoOutput, output444);
-    // Note: SetFlag may return E_NOTIMPL for devices without SDI output (like
-    // Intensity Pro 4K)
-    if (configResult != S_OK && configResult != E_NOTIMPL) {
-      std::cerr << "[DeckLink] CRITICAL: Failed to set SDI output mode before "
-                   "EnableVideoOutput. HRESULT: 0x"
-                << std::hex << configResult << std::dec << std::endl;
-      return -2;
-    }
-  } else {
-    std::cerr << "[DeckLink] Warning: No configuration interface available for "
-                 "pre-EnableOutput SDI setup"
-              << std::endl;
-  }
+  if (configureSDILink(m_pixelFormat, nullptr) != 0)
+    return -2;
 
   // Enable video output with current display mode
   HRESULT enableResult =
@@ -181,6 +304,8 @@ int DeckLinkSignalGen::stopOutput() {
   if (!m_outputEnabled)
     return 0;
 
+  m_pipeline.flush();
+  stopBackgroundOutput();
   m_output->DisableVideoOutput();
   m_outputEnabled = false;
 
@@ -190,88 +315,397 @@ int DeckLinkSignalGen::stopOutput() {
 int DeckLinkSignalGen::createFrame() {
   if (!m_output || !m_outputEnabled)
     return -1;
+  m_pipeline.flush();
+  // A stream's display thread writes m_frame and its reader packs through
+  // m_packWorkers; both must stop before this frame replaces theirs
+  stopBackgroundOutput();
   if (m_pendingFrameData.empty()) {
     std::cerr << "[DeckLink] No pending frame data available" << std::endl;
     return -2;
   }
 
-  int32_t rowBytes = 0;
-  HRESULT result =
-      m_output->RowBytesForPixelFormat(m_pixelFormat, m_width, &rowBytes);
-  if (result != S_OK) {
-    std::cerr << "[DeckLink] RowBytesForPixelFormat failed. HRESULT: 0x"
-              << std::hex << result << std::dec << std::endl;
-    return -3;
+  PlacementMap map;
+  int err = resolvePlacement(m_sourceWidth, m_sourceHeight, &map);
+  if (err)
+    return err;
+  m_width = map.outputWidth;
+  m_height = map.outputHeight;
+
+  // Three buffers: one on screen, one being packed, one spare for the SDK
+  err = m_framePool.configure(m_output, m_width, m_height, m_pixelFormat, 3,
+                              m_threadPolicy.lockMemory != 0);
+  if (err)
+    return err;
+
+  // DisplayVideoFrameSync has returned for the previous frame, so it can go
+  if (m_frame) {
+    m_frame->Release();
+    m_frame = nullptr;
   }
 
-  result =
-      m_output->CreateVideoFrame(m_width, m_height, rowBytes, m_pixelFormat,
-                                 bmdFrameFlagDefault, &m_frame);
-  if (!m_frame || FAILED(result)) {
-    std::cerr << "[DeckLink] CreateVideoFrame failed" << std::endl;
+  // Pool buffers are plain host memory, so no StartAccess/EndAccess needed
+  void* frameData = nullptr;
+  m_frame = m_framePool.acquire(&frameData);
+  if (!m_frame) {
+    std::cerr << "[DeckLink] No free frame buffer in pool" << std::endl;
     return -4;
   }
 
-  // Get frame buffer for writing
-  IDeckLinkVideoBuffer* videoBuffer = nullptr;
-  if (m_frame->QueryInterface(IID_IDeckLinkVideoBuffer, (void**)&videoBuffer) !=
-      S_OK) {
-    std::cerr << "[DeckLink] QueryInterface for IDeckLinkVideoBuffer failed"
-              << std::endl;
-    return -5;
-  }
+  // Pack the data according to the pixel format
+  err = packFrame(frameData, m_pendingFrameData.data(), map,
+                  m_framePool.rowBytes());
+  if (err)
+    return err;
 
-  if (videoBuffer->StartAccess(bmdBufferAccessWrite) != S_OK) {
-    std::cerr << "[DeckLink] StartAccess failed" << std::endl;
-    videoBuffer->Release();
-    return -6;
-  }
+  m_packedBaseValid = false;
+  return finishFrame(frameData);
+}
 
-  void* frameData = nullptr;
-  if (videoBuffer->GetBytes(&frameData) != S_OK) {
-    std::cerr << "[DeckLink] GetBytes failed" << std::endl;
-    videoBuffer->EndAccess(bmdBufferAccessWrite);
-    videoBuffer->Release();
-    return -7;
+/**
+ * @brief Composites overlays into a packed frame and sets its flags
+ *
+ * When overlays are visible and m_packedBase does not already hold this
+ * frame, the clean packed frame is copied there first so updateOverlays()
+ * can redraw the overlays without repacking.
+ */
+int DeckLinkSignalGen::finishFrame(void* frameData) {
+  m_frameBytes = frameData;
+  if (m_overlays.hasVisible()) {
+    if (!m_packedBaseValid) {
+      const uint8_t* bytes = static_cast<const uint8_t*>(frameData);
+      const size_t frameSize =
+          static_cast<size_t>(m_framePool.rowBytes()) * m_height;
+      m_packedBase.assign(bytes, bytes + frameSize);
+      m_packedBaseValid = true;
+    }
+    int err = m_overlays.composite(frameData, m_pixelFormat, m_width, m_height,
+                                   m_framePool.rowBytes());
+    if (err)
+      return err;
   }
 
-  // Use pixel packing system to convert raw RGB data to the target format
-  const uint16_t* srcData = m_pendingFrameData.data();
+  captureThumbnail(frameData, m_width, m_height, m_framePool.rowBytes(), true);
+  applyFrameMetadata(m_frame);
+  recordFrame(frameData, m_width, m_height, m_framePool.rowBytes(),
+              kRecordedDisplay);
 
-  // Pack the data according to the pixel format
-  int err = pack_pixel_format(frameData, m_pixelFormat, srcData, m_width,
-                              m_height, rowBytes);
+  // Frame created successfully
+  return 0;
+}
+
+/**
+ * @brief Signals HDR metadata on a frame
+ *
+ * HDR metadata is sent only for HDR transfer functions (PQ=2, HLG=3). SDR
+ * frames get no metadata at all, as in the BMD SDK SignalGenerator sample,
+ * so no DRM InfoFrame goes out and the device signals SDR. The provider for
+ * the current metadata is rebuilt only when the metadata changes (with
+ * kFrameStatsAutoMetadata, every frame whose light levels differ).
+ */
+void DeckLinkSignalGen::applyFrameMetadata(IDeckLinkMutableVideoFrame* frame,
+                                           HDRMetadataProvider* metadata) {
+  TraceScope span(kTraceMetadata);
+  if (metadata) {
+    m_hdrTable.attach(frame, metadata);
+    return;
+  }
+  std::lock_guard<std::mutex> lock(m_hdrMutex);
+  if (!m_hdrProvider ||
+      !hdr_metadata_equal(m_hdrProvider->metadata(), m_hdrMetadata)) {
+    if (m_hdrProvider)
+      m_hdrProvider->Release();
+    m_hdrProvider = new HDRMetadataProvider(m_hdrMetadata);
+  }
+  m_hdrTable.attach(frame, m_hdrProvider);
+}
+
+/**
+ * @brief Packs source data into a frame buffer, gathering frame statistics
+ *
+ * Statistics come from the same pass over the source as the packing. With
+ * kFrameStatsAutoMetadata the PQ MaxCLL/MaxFALL are written into the HDR
+ * metadata, so the caller's applyFrameMetadata() signals this frame's values.
+ */
+int DeckLinkSignalGen::packFrame(void* frameData,
+                                 const uint16_t* data,
+                                 const PlacementMap& map,
+                                 int32_t rowBytes) {
+  TraceScope span(kTracePack);
+  const int64_t eotf = hdrEOTF();
+  const bool pq = eotf == 2;
+  const float* nitsTable = nullptr;
+  int mode;
+  {
+    std::lock_guard<std::mutex> lock(m_frameStatsMutex);
+    mode = m_frameStatsMode;
+    if (mode != kFrameStatsOff && pq) {
+      if (m_nitsTableFormat != m_pixelFormat) {
+        m_nitsTable.resize(pixel_max_code(m_pixelFormat) + 1);
+        pq_nits_table(m_pixelFormat, m_nitsTable.data());
+        m_nitsTableFormat = m_pixelFormat;
+      }
+      nitsTable = m_nitsTable.data();
+    }
+  }
+  if (mode == kFrameStatsOff)
+    return m_packWorkers.packPlaced(frameData, m_pixelFormat, data, map,
+                                    rowBytes);
 
-  videoBuffer->EndAccess(bmdBufferAccessWrite);
-  videoBuffer->Release();
+  PixelStats stats;
+  int err = m_packWorkers.packPlaced(frameData, m_pixelFormat, data, map,
+                                     rowBytes, &stats, nitsTable);
   if (err)
     return err;
+  recordFrameStats(stats, map.outputWidth, map.outputHeight, eotf);
+  return 0;
+}
+
+int64_t DeckLinkSignalGen::hdrEOTF() const {
+  std::lock_guard<std::mutex> lock(m_hdrMutex);
+  return m_hdrMetadata.EOTF;
+}
+
+void DeckLinkSignalGen::recordFrameStats(const PixelStats& stats,
+                                         int width,
+                                         int height,
+                                         int64_t eotf) {
+  // Luma weights of the signalled colorimetry: BT.2020 for HDR, else BT.709
+  static constexpr double kLumaBt709[3] = {0.2126, 0.7152, 0.0722};
+  static constexpr double kLumaBt2020[3] = {0.2627, 0.6780, 0.0593};
+  const bool pq = eotf == 2;
+  const bool hdr = eotf == 2 || eotf == 3;
+  const double* luma = hdr ? kLumaBt2020 : kLumaBt709;
+  const double pixels = static_cast<double>(width) * height;
+
+  FrameStats result = {};
+  result.valid = 1;
+  result.maxCode = pixel_max_code(m_pixelFormat);
+  result.width = width;
+  result.height = height;
+  uint16_t peak = 0;
+  for (int c = 0; c < 3; c++) {
+    result.mean[c] = stats.sum[c] / pixels;
+    result.min[c] = stats.min[c];
+    result.max[c] = stats.max[c];
+    result.clipped[c] = static_cast<int64_t>(stats.clipped[c]);
+    result.apl += luma[c] * result.mean[c];
+    peak = std::max(peak, stats.max[c]);
+  }
+  result.clippedPixels = static_cast<int64_t>(stats.clippedPixels);
+  result.apl = 100.0 * result.apl / result.maxCode;
+  result.pq = pq;
+
+  std::unique_lock<std::mutex> lock(m_frameStatsMutex);
+  if (pq) {
+    result.maxCLL = m_nitsTable[peak];
+    result.maxFALL = stats.lightSum / pixels;
+    result.autoMetadata = m_frameStatsMode == kFrameStatsAutoMetadata;
+  }
+  result.frames = m_frameStats.frames + 1;
+  // Clipping is reported per frame through FrameStats; only its onset is
+  // logged, so a clipping pattern held on screen does not log every frame
+  const bool clipStarted = result.clippedPixels && !m_frameStats.clippedPixels;
+  m_frameStats = result;
+  lock.unlock();
+
+  if (result.autoMetadata) {
+    std::lock_guard<std::mutex> hdrLock(m_hdrMutex);
+    m_hdrMetadata.maxCLL = result.maxCLL;
+    m_hdrMetadata.maxFALL = result.maxFALL;
+  }
+  if (clipStarted) {
+    std::cerr << "[DeckLink] " << result.clippedPixels
+              << " pixel(s) above code value " << result.maxCode
+              << " were clipped" << std::endl;
+  }
+}
+
+int DeckLinkSignalGen::setFrameStatsMode(int mode) {
+  if (mode < kFrameStatsOff || mode > kFrameStatsAutoMetadata)
+    return -1;
+  std::lock_guard<std::mutex> lock(m_frameStatsMutex);
+  m_frameStatsMode = mode;
+  m_frameStats = {};
+  return 0;
+}
+
+FrameStats DeckLinkSignalGen::getFrameStats() const {
+  std::lock_guard<std::mutex> lock(m_frameStatsMutex);
+  return m_frameStats;
+}
+
+int DeckLinkSignalGen::setThumbnailConfig(const ThumbnailConfig& config) {
+  return m_thumbnail.configure(config);
+}
+
+ThumbnailConfig DeckLinkSignalGen::getThumbnailConfig() const {
+  return m_thumbnail.config();
+}
+
+int DeckLinkSignalGen::getThumbnail(uint8_t* rgb,
+                                    int capacity,
+                                    ThumbnailInfo* info) const {
+  return m_thumbnail.copy(rgb, capacity, info);
+}
 
-  // Apply HDR metadata only for HDR transfer functions (PQ=2, HLG=3)
-  // For SDR (EOTF=1), skip HDR metadata entirely to avoid sending DRM InfoFrame
-  if (m_hdrMetadata.EOTF == 2 || m_hdrMetadata.EOTF == 3) {
-    applyHDRMetadata();
+void DeckLinkSignalGen::captureThumbnail(const void* frameData,
+                                         int width,
+                                         int height,
+                                         int32_t rowBytes,
+                                         bool force) {
+  m_thumbnail.capture(frameData, m_pixelFormat, width, height, rowBytes,
+                      hdrEOTF() == 2, force);
+}
+
+void DeckLinkSignalGen::recordFrame(const void* frameData,
+                                    int width,
+                                    int height,
+                                    int32_t rowBytes,
+                                    RecordedSource source,
+                                    HDRMetadataProvider* metadata) {
+  if (!m_recorder.active())
+    return;
+  RecordedFrame frame = {};
+  frame.timestampNs = FrameTimingAnalyzer::nowNs();
+  frame.traceFrameId = trace_current_frame();
+  frame.frameBytes = static_cast<int64_t>(rowBytes) * height;
+  frame.pixelFormat = m_pixelFormat;
+  frame.width = width;
+  frame.height = height;
+  frame.rowBytes = rowBytes;
+  frame.source = source;
+  if (metadata) {
+    frame.metadata = metadata->metadata();
   } else {
-    // SDR: Clear HDR flag but do NOT set EOTF/colorspace metadata
-    // This matches BMD SDK SignalGenerator sample behavior - SDR frames
-    // have no metadata set, which tells the device to use SDR signaling
-    if (m_frame) {
-      BMDFrameFlags currentFlags = m_frame->GetFlags();
-      m_frame->SetFlags(currentFlags & ~bmdFrameContainsHDRMetadata);
-    }
-    std::cerr << "[DeckLink] SDR mode: Cleared HDR flag, no metadata set"
-              << std::endl;
+    // The provider applyFrameMetadata() just attached
+    std::lock_guard<std::mutex> lock(m_hdrMutex);
+    frame.metadata = m_hdrProvider ? m_hdrProvider->metadata() : m_hdrMetadata;
   }
+  m_recorder.record(frameData, frame);
+}
 
-  // Frame created successfully
+/**
+ * @brief Sets how RGB frames are placed on the output raster
+ *
+ * The crop rectangle is checked against each source as it is packed, since
+ * the source size is only known then.
+ *
+ * @return int 0 on success, -1 for an invalid fit, filter, size or crop
+ */
+int DeckLinkSignalGen::setPlacement(const PlacementConfig& config) {
+  if (config.enabled &&
+      (config.fit < kFitNone || config.fit > kFitInteger ||
+       config.filter < kFilterNearest || config.filter > kFilterBilinear ||
+       config.width < 0 || config.width > 0xFFFF || config.height < 0 ||
+       config.height > 0xFFFF || config.cropX < 0 || config.cropY < 0 ||
+       config.cropWidth < 0 || config.cropHeight < 0))
+    return -1;
+  std::lock_guard<std::mutex> lock(m_placementMutex);
+  m_placement = config;
   return 0;
 }
 
+PlacementConfig DeckLinkSignalGen::getPlacement() const {
+  std::lock_guard<std::mutex> lock(m_placementMutex);
+  return m_placement;
+}
+
+/**
+ * @brief Resolves the placement for a source size
+ *
+ * The raster is the placement's own size when set, else the display mode's,
+ * so a placed frame follows display mode changes.
+ *
+ * @return int 0 on success, -1 if the crop rectangle lies outside the
+ *         source, -2 if the display mode size could not be queried
+ */
+int DeckLinkSignalGen::resolvePlacement(int sourceWidth,
+                                        int sourceHeight,
+                                        PlacementMap* map) {
+  const PlacementConfig config = getPlacement();
+  int outputWidth = 0;
+  int outputHeight = 0;
+  if (config.enabled && !(config.width && config.height)) {
+    IDeckLinkDisplayMode* mode = nullptr;
+    if (!m_output || m_output->GetDisplayMode(m_displayMode, &mode) != S_OK ||
+        !mode)
+      return -2;
+    outputWidth = static_cast<int>(mode->GetWidth());
+    outputHeight = static_cast<int>(mode->GetHeight());
+    mode->Release();
+  }
+  int err = placement_resolve(config, sourceWidth, sourceHeight, outputWidth,
+                              outputHeight, map);
+  if (err)
+    std::cerr << "[DeckLink] Placement does not fit a " << sourceWidth << "x"
+              << sourceHeight << " source" << std::endl;
+  return err;
+}
+
+/**
+ * @brief Re-displays the current frame with the current overlay set
+ *
+ * Copies the last packed frame (without overlays) into a free pool buffer,
+ * composites the enabled overlays over it and displays the result. The
+ * source image is not repacked, so toggling an overlay costs one frame copy
+ * plus the pixel groups the overlays cover.
+ *
+ * @return int 0 on success, -1 if there is no frame or output, -4 if no pool
+ *         buffer is free, or the compositing / display error
+ */
+int DeckLinkSignalGen::updateOverlays() {
+  m_pipeline.flush();
+  stopBackgroundOutput();
+  if (!m_output || !m_outputEnabled || !m_frame || !m_frameBytes)
+    return -1;
+  // Format or geometry changed since the frame was packed: needs createFrame()
+  if (m_frame->GetPixelFormat() != m_pixelFormat ||
+      m_frame->GetWidth() != m_width || m_frame->GetHeight() != m_height)
+    return -1;
+
+  const size_t frameSize =
+      static_cast<size_t>(m_framePool.rowBytes()) * m_height;
+  if (!m_packedBaseValid) {
+    // The frame on screen was packed while no overlay was visible
+    const uint8_t* bytes = static_cast<const uint8_t*>(m_frameBytes);
+    m_packedBase.assign(bytes, bytes + frameSize);
+    m_packedBaseValid = true;
+  }
+
+  void* frameData = nullptr;
+  IDeckLinkMutableVideoFrame* frame = m_framePool.acquire(&frameData);
+  if (!frame) {
+    std::cerr << "[DeckLink] No free frame buffer in pool" << std::endl;
+    return -4;
+  }
+  m_frame->Release();
+  m_frame = frame;
+  std::memcpy(frameData, m_packedBase.data(), frameSize);
+
+  int err = finishFrame(frameData);
+  if (err)
+    return err;
+  return displayFrameSync();
+}
+
 int DeckLinkSignalGen::displayFrameSync() {
+  m_pipeline.flush();
   if (!m_output || !m_frame)
     return -1;
 
-  HRESULT result = m_output->DisplayVideoFrameSync(m_frame);
+  // Scheduled playback and streams own the output until stopped
+  stopBackgroundOutput();
+
+  if (m_timingDisplayMode != m_displayMode) {
+    m_frameTiming.reset(nominalFrameIntervalNs());
+    m_timingDisplayMode = m_displayMode;
+  }
+
+  HRESULT result;
+  {
+    TraceScope span(kTraceDisplay);
+    result = m_output->DisplayVideoFrameSync(m_frame);
+  }
   if (result != S_OK) {
     std::cerr << "[DeckLink] DisplayVideoFrameSync failed. HRESULT: 0x"
               << std::hex << result << std::dec << std::endl;
@@ -279,12 +713,16 @@ int DeckLinkSignalGen::displayFrameSync() {
   }
 
   // Frame displayed successfully
+  m_frameTiming.recordCompletion(FrameTimingAnalyzer::nowNs());
   return 0;
 }
 
 int DeckLinkSignalGen::setPixelFormat(BMDPixelFormat pixelFormat) {
   if (!m_output)
     return -1;
+  m_pipeline.flush();
+  // A stream packs in the format it started with
+  m_stream.stop();
 
   if (!m_formatsCached) {
     cacheSupportedFormats();
@@ -323,17 +761,11 @@ BMDPixelFormat DeckLinkSignalGen::getPixelFormat() const {
 int DeckLinkSignalGen::setDisplayMode(BMDDisplayMode displayMode) {
   if (!m_output)
     return -1;
+  m_pipeline.flush();
+  m_stream.stop();
 
   // Validate that the display mode is supported
-  BMDDisplayMode actualMode;
-  bool supported;
-
-  HRESULT result = m_output->DoesSupportVideoMode(
-      bmdVideoConnectionUnspecified, displayMode, m_pixelFormat,
-      bmdNoVideoOutputConversion, bmdSupportedVideoModeDefault, &actualMode,
-      &supported);
-
-  if (result != S_OK || !supported) {
+  if (!isModeSupported(displayMode, m_pixelFormat)) {
     std::cerr << "[DeckLink] Display mode "
               << fourCharCode(static_cast<int>(displayMode))
               << " is not supported with current pixel format "
@@ -341,6 +773,8 @@ int DeckLinkSignalGen::setDisplayMode(BMDDisplayMode displayMode) {
     return -1;
   }
 
+  if (displayMode != m_displayMode)
+    m_formatsCached = false;  // Format support is probed per display mode
   m_displayMode = displayMode;
   std::cerr << "[DeckLink] Set display mode to "
             << fourCharCode(static_cast<int>(m_displayMode)) << std::endl;
@@ -353,474 +787,2610 @@ BMDDisplayMode DeckLinkSignalGen::getDisplayMode() const {
 }
 
 int DeckLinkSignalGen::setHDRMetadata(const HDRMetadata& metadata) {
-  m_hdrMetadata = metadata;
+  m_pipeline.flush();
+  {
+    // A running stream packs and attaches metadata on its reader thread;
+    // each frame takes the whole struct as it was before or after this
+    std::lock_guard<std::mutex> lock(m_hdrMutex);
+    m_hdrMetadata = metadata;
+  }
 
   // Debug: Log the received metadata values
   std::cerr << "[DeckLink] setHDRMetadata received:" << std::endl;
-  std::cerr << "  EOTF: " << m_hdrMetadata.EOTF << std::endl;
-  std::cerr << "  Red primary: (" << m_hdrMetadata.referencePrimaries.RedX
-            << ", " << m_hdrMetadata.referencePrimaries.RedY << ")"
-            << std::endl;
-  std::cerr << "  MaxCLL: " << m_hdrMetadata.maxCLL << std::endl;
+  std::cerr << "  EOTF: " << metadata.EOTF << std::endl;
+  std::cerr << "  Red primary: (" << metadata.referencePrimaries.RedX
+            << ", " << metadata.referencePrimaries.RedY << ")" << std::endl;
+  std::cerr << "  MaxCLL: " << metadata.maxCLL << std::endl;
 
   return 0;
 }
 
-int DeckLinkSignalGen::setFrameData(const uint16_t* data,
-                                    int width,
-                                    int height) {
-  if (!data || width <= 0 || height <= 0)
+/**
+ * @brief Measures the cost of packing one frame into a pixel format
+ *
+ * Packs a synthetic full-range ramp at the active display mode's dimensions
+ * into a scratch buffer. The first pass is a warm-up (and rejects formats
+ * without a packer); the best of the following passes is reported so that
+ * scheduler noise does not inflate the result.
+ *
+ * @param pixelFormat Pixel format to benchmark
+ * @param iterations Number of timed passes
+ * @param nsPerFrame Receives the best observed pack time in nanoseconds
+ * @return int Returns 0 on success, negative values on failure:
+ *         - -1: Output interface not available or invalid arguments
+ *         - -2: Active display mode could not be queried
+ *         - -3: RowBytesForPixelFormat failed
+ *         - -8: No packer for this pixel format (from pack_pixel_format)
+ */
+int DeckLinkSignalGen::benchmarkPack(BMDPixelFormat pixelFormat,
+                                     int iterations,
+                                     double* nsPerFrame) {
+  if (!m_output || !nsPerFrame || iterations <= 0)
     return -1;
-  // Update dimensions if they changed
-  if (width != m_width || height != m_height) {
-    m_width = width;
-    m_height = height;
-  }
-  // Store the frame data
-  size_t dataSize = width * height * 3;  // 3 channels (R, G, B) per pixel
-  m_pendingFrameData.assign(data, data + dataSize);
-  return 0;
-}
-
-int DeckLinkSignalGen::getDeviceCount() {
-  IDeckLinkIterator* iterator = CreateDeckLinkIteratorInstance();
-  if (!iterator)
-    return 0;
-
-  int count = 0;
-  IDeckLink* device = nullptr;
-  while (iterator->Next(&device) == S_OK) {
-    count++;
-    device->Release();
-  }
-  iterator->Release();
-
-  return count;
-}
 
-std::string DeckLinkSignalGen::getDeviceName(int deviceIndex) {
-  IDeckLinkIterator* iterator = CreateDeckLinkIteratorInstance();
-  if (!iterator)
-    return "";
+  IDeckLinkDisplayMode* mode = nullptr;
+  if (m_output->GetDisplayMode(m_displayMode, &mode) != S_OK || !mode)
+    return -2;
+  const int width = static_cast<int>(mode->GetWidth());
+  const int height = static_cast<int>(mode->GetHeight());
+  mode->Release();
 
-  IDeckLink* device = nullptr;
-  int current = 0;
-  std::string deviceName;
+  int32_t rowBytes = 0;
+  if (m_output->RowBytesForPixelFormat(pixelFormat, width, &rowBytes) != S_OK)
+    return -3;
 
-  while (iterator->Next(&device) == S_OK) {
-    if (current == deviceIndex) {
-      CFStringRef nameRef = nullptr;
-      if (device->GetDisplayName(&nameRef) == S_OK && nameRef) {
-        char nameBuffer[256];
-        CFStringGetCString(nameRef, nameBuffer, sizeof(nameBuffer),
-                           kCFStringEncodingUTF8);
-        deviceName = nameBuffer;
-        CFRelease(nameRef);
-      }
-      device->Release();
-      break;
+  // Horizontal 12-bit ramp; packers clamp to their own bit depth
+  const size_t srcSize = static_cast<size_t>(width) * height * 3;
+  TrackedVector<uint16_t, kMemoryPackScratch> src(srcSize);
+  for (int y = 0; y < height; y++) {
+    for (int x = 0; x < width; x++) {
+      const size_t i = (static_cast<size_t>(y) * width + x) * 3;
+      const auto level = static_cast<uint16_t>(x * 4095 / width);
+      src[i + 0] = level;
+      src[i + 1] = static_cast<uint16_t>(4095 - level);
+      src[i + 2] = static_cast<uint16_t>(y * 4095 / height);
     }
-    device->Release();
-    current++;
   }
-  iterator->Release();
+  TrackedVector<uint8_t, kMemoryPackScratch> dest(
+      static_cast<size_t>(rowBytes) * height);
 
-  return deviceName;
-}
+  int err = pack_pixel_format(dest.data(), pixelFormat, src.data(), width,
+                              height, rowBytes);
+  if (err)
+    return err;
 
-void DeckLinkSignalGen::cacheSupportedFormats() {
-  if (!m_output || m_formatsCached)
-    return;
+  auto best = std::chrono::nanoseconds::max();
+  for (int i = 0; i < iterations; i++) {
+    const auto start = std::chrono::steady_clock::now();
+    pack_pixel_format(dest.data(), pixelFormat, src.data(), width, height,
+                      rowBytes);
+    best = std::min(best, std::chrono::duration_cast<std::chrono::nanoseconds>(
+                              std::chrono::steady_clock::now() - start));
+  }
+  *nsPerFrame = static_cast<double>(best.count());
 
-  std::set<BMDPixelFormat> uniqueFormats;
+  std::cerr << "[DeckLink] Pack benchmark "
+            << fourCharCode(static_cast<int>(pixelFormat)) << " at " << width
+            << "x" << height << ": " << best.count() / 1000 << " us/frame"
+            << std::endl;
 
-  // Test common pixel formats
-  BMDPixelFormat supportedFormats[] = {
-      bmdFormat8BitYUV,    // '2vuy' 4:2:2 Representation
-      bmdFormat10BitYUV,   // 'v210' 4:2:2 Representation
-      bmdFormat10BitYUVA,  // 'Ay10' 4:2:2 raw
+  return 0;
+}
 
-      bmdFormat8BitARGB,  // 32     4:4:4:4 raw
-      bmdFormat8BitBGRA,  // 'BGRA' 4:4:4:x raw
+bool DeckLinkSignalGen::isModeSupported(BMDDisplayMode displayMode,
+                                        BMDPixelFormat pixelFormat) const {
+  BMDDisplayMode actualMode;
+  bool supported = false;
 
-      bmdFormat10BitRGB,  // 'r210' 4:4:4 raw
-      bmdFormat12BitRGB,  // 'R12B' Big-endian RGB 12-bit per component with
-                          // full range (0-4095). Packed as 12-bit per component
-      bmdFormat12BitRGBLE,  // 'R12L' Little-endian RGB 12-bit per component
-                            // with full range (0-4095). Packed as 12-bit per
-                            // component.
+  HRESULT result = m_output->DoesSupportVideoMode(
+      bmdVideoConnectionUnspecified, displayMode, pixelFormat,
+      bmdNoVideoOutputConversion, bmdSupportedVideoModeDefault, &actualMode,
+      &supported);
+  return result == S_OK && supported;
+}
 
-      bmdFormat10BitRGBXLE,  // 'R10l' 4:4:4 raw Three 10-bit unsigned
-                             // components are packed into one 32-bit
-                             // little-endian word.
-      bmdFormat10BitRGBX,  // 'R10b' 4:4:4 raw Three 10-bit unsigned components
-                           // are packed into one 32-bit big-endian word.
+/**
+ * @brief Switches pixel format, display mode and HDR metadata in place
+ *
+ * The requested configuration is diffed against the active one and only the
+ * differences are applied. A pixel format change that keeps the SDI link
+ * layout (4:4:4 vs 4:2:2) and an HDR metadata change are both per-frame
+ * properties, so they take effect by re-presenting the current frame without
+ * touching the output. Only a display mode change or an SDI link layout
+ * change requires a DisableVideoOutput/EnableVideoOutput cycle, and at most
+ * one cycle is performed per call.
+ *
+ * The time from DisableVideoOutput until the current frame is back on the
+ * output is recorded in ReconfigureStats::reenableLatencyUs.
+ *
+ * The active configuration changes only once the output accepts the new
+ * one. If the SDI link or EnableVideoOutput rejects it, the previous link
+ * layout and display mode are enabled again and the current frame is
+ * re-presented, so the output is left as it was.
+ *
+ * @param config Requested configuration (zero fields keep active values)
+ * @return int Returns 0 on success, negative values on failure:
+ *         - -1: Output interface not available or unsupported mode/format
+ *         - -2: SDI configuration failed
+ *         - -3: EnableVideoOutput failed
+ *         - Other negative values are passed through from createFrame()
+ */
+int DeckLinkSignalGen::reconfigure(const OutputConfig& config) {
+  if (!m_output)
+    return -1;
+  m_pipeline.flush();
+
+  const auto start = std::chrono::steady_clock::now();
+  m_reconfigureStats = {};
+  ReconfigureStats& stats = m_reconfigureStats;
+
+  const BMDPixelFormat pixelFormat =
+      config.pixelFormat ? static_cast<BMDPixelFormat>(config.pixelFormat)
+                         : m_pixelFormat;
+  const BMDDisplayMode displayMode =
+      config.displayMode ? static_cast<BMDDisplayMode>(config.displayMode)
+                         : m_displayMode;
+
+  stats.pixelFormatChanged = pixelFormat != m_pixelFormat;
+  stats.displayModeChanged = displayMode != m_displayMode;
+  if (config.applyHDR) {
+    std::lock_guard<std::mutex> lock(m_hdrMutex);
+    stats.hdrChanged = !hdr_metadata_equal(config.hdrMetadata, m_hdrMetadata);
+  }
+
+  if ((stats.pixelFormatChanged || stats.displayModeChanged) &&
+      !isModeSupported(displayMode, pixelFormat)) {
+    std::cerr << "[DeckLink] Reconfigure rejected: display mode "
+              << fourCharCode(static_cast<int>(displayMode))
+              << " is not supported with pixel format "
+              << fourCharCode(static_cast<int>(pixelFormat)) << std::endl;
+    stats = {};
+    return -1;
+  }
+
+  // FRC, scheduled and streamed frames use the old configuration
+  stopBackgroundOutput();
+  auto commit = [&] {
+    if (stats.displayModeChanged)
+      m_formatsCached = false;  // Format support is probed per display mode
+    m_pixelFormat = pixelFormat;
+    m_displayMode = displayMode;
+    if (stats.hdrChanged) {
+      std::lock_guard<std::mutex> lock(m_hdrMutex);
+      m_hdrMetadata = config.hdrMetadata;
+    }
   };
 
-  for (const BMDPixelFormat format : supportedFormats) {
-    BMDDisplayMode actualMode;
-    bool supported;
+  if (!m_outputEnabled) {
+    // Nothing is on the wire yet; startOutput() will pick everything up
+    commit();
+    stats.totalLatencyUs = elapsedMicroseconds(start);
+    return 0;
+  }
 
-    if (m_output->DoesSupportVideoMode(
-            bmdVideoConnectionUnspecified, m_displayMode, format,
-            bmdNoVideoOutputConversion, bmdSupportedVideoModeDefault,
-            &actualMode, &supported) == S_OK &&
-        supported) {
-      uniqueFormats.insert(format);
+  stats.sdiLinkChanged =
+      m_configuration &&
+      m_applied444 != static_cast<int>(requiresSDI444(pixelFormat));
+  const bool needsEnableCycle =
+      stats.displayModeChanged || stats.sdiLinkChanged;
+
+  if (needsEnableCycle) {
+    const auto disableStart = std::chrono::steady_clock::now();
+    m_output->DisableVideoOutput();
+    m_outputEnabled = false;
+
+    int err = configureSDILink(pixelFormat, &stats.setFlagCalls);
+    if (!err) {
+      HRESULT result =
+          m_output->EnableVideoOutput(displayMode, bmdVideoOutputFlagDefault);
+      stats.enableCycles++;
+      if (result != S_OK) {
+        std::cerr << "[DeckLink] Reconfigure: EnableVideoOutput failed for "
+                  << "mode " << fourCharCode(static_cast<int>(displayMode))
+                  << ". HRESULT: 0x" << std::hex << result << std::dec
+                  << std::endl;
+        err = -3;
+      }
+    }
+    if (err) {
+      restoreOutput(&stats);
+      return err;
+    }
+    commit();
+    m_outputEnabled = true;
+
+    if (!m_pendingFrameData.empty()) {
+      err = createFrame();
+      if (err)
+        return err;
+      err = displayFrameSync();
+      if (err)
+        return err;
+      stats.framesRepresented++;
+    }
+    stats.reenableLatencyUs = elapsedMicroseconds(disableStart);
+  } else {
+    commit();
+    if ((stats.pixelFormatChanged || stats.hdrChanged) &&
+        !m_pendingFrameData.empty()) {
+      // Per-frame properties only: re-present the current frame
+      int err = createFrame();
+      if (err)
+        return err;
+      err = displayFrameSync();
+      if (err)
+        return err;
+      stats.framesRepresented++;
     }
   }
 
-  m_supportedFormats.assign(uniqueFormats.begin(), uniqueFormats.end());
-  m_formatsCached = true;
+  stats.totalLatencyUs = elapsedMicroseconds(start);
+  std::cerr << "[DeckLink] Reconfigured to "
+            << fourCharCode(static_cast<int>(m_pixelFormat)) << " / "
+            << fourCharCode(static_cast<int>(m_displayMode)) << " with "
+            << stats.setFlagCalls << " SetFlag call(s), " << stats.enableCycles
+            << " enable cycle(s), re-enable latency "
+            << stats.reenableLatencyUs << " us" << std::endl;
+
+  return 0;
+}
+
+/**
+ * @brief Re-enables the active configuration after a failed reconfigure()
+ *
+ * The output is disabled and m_pixelFormat / m_displayMode still hold the
+ * configuration that was on the wire before the attempt.
+ */
+void DeckLinkSignalGen::restoreOutput(ReconfigureStats* stats) {
+  if (configureSDILink(m_pixelFormat, &stats->setFlagCalls) != 0 ||
+      m_output->EnableVideoOutput(m_displayMode, bmdVideoOutputFlagDefault) !=
+          S_OK) {
+    std::cerr << "[DeckLink] Reconfigure: could not restore "
+              << fourCharCode(static_cast<int>(m_pixelFormat)) << " / "
+              << fourCharCode(static_cast<int>(m_displayMode))
+              << "; output is disabled" << std::endl;
+    return;
+  }
+  stats->enableCycles++;
+  m_outputEnabled = true;
+  if (!m_pendingFrameData.empty() && createFrame() == 0 &&
+      displayFrameSync() == 0)
+    stats->framesRepresented++;
+  std::cerr << "[DeckLink] Reconfigure failed; restored "
+            << fourCharCode(static_cast<int>(m_pixelFormat)) << " / "
+            << fourCharCode(static_cast<int>(m_displayMode)) << std::endl;
+}
+
+/**
+ * @brief Configures packing workers and frame pool locking
+ *
+ * Restarts the packing workers with the requested count and core placement
+ * and records the output thread request for applyOutputThreadPolicy(). A
+ * change to lockMemory takes effect on the next createFrame().
+ *
+ * @param config Requested policy; negative cores disable pinning
+ * @return int 0 on success, -1 on invalid arguments
+ */
+int DeckLinkSignalGen::setThreadPolicy(const ThreadPolicyConfig& config) {
+  if (config.packWorkers < 0 || config.schedPolicy < kThreadSchedOther ||
+      config.schedPolicy > kThreadSchedRR)
+    return -1;
+
+  // The workers are replaced; nothing may be packing through them
+  m_pipeline.flush();
+  m_stream.stop();
+  m_threadPolicy = config;
+  m_threadPolicyStatus.packWorkersPinned =
+      m_packWorkers.start(config.packWorkers, config.packCoreFirst);
+  m_threadPolicyStatus.packWorkers = m_packWorkers.workerCount();
+
+  std::cerr << "[DeckLink] Packing on " << m_packWorkers.workerCount() + 1
+            << " threads (" << m_threadPolicyStatus.packWorkersPinned
+            << " workers pinned)" << std::endl;
+  return 0;
+}
+
+/**
+ * @brief Pins and schedules the calling thread as the output thread
+ *
+ * Must be called from the thread that calls createFrame() and
+ * displayFrameSync(). A refused real-time policy falls back to default
+ * scheduling and is reported in ThreadPolicyStatus::schedFallback.
+ *
+ * @return int 0 if the full policy was applied, 1 if anything fell back
+ */
+int DeckLinkSignalGen::applyOutputThreadPolicy() {
+  ThreadPolicyStatus& status = m_threadPolicyStatus;
+
+  status.outputCore = m_threadPolicy.outputCore;
+  status.outputPinned = pin_current_thread(m_threadPolicy.outputCore);
+
+  int sched = apply_current_thread_sched(
+      m_threadPolicy.schedPolicy, m_threadPolicy.schedPriority,
+      &status.schedPolicy, &status.schedPriority);
+  status.schedFallback = sched != 0;
+
+  return (status.schedFallback || status.outputPinned == kThreadPinFailed)
+             ? 1
+             : 0;
+}
+
+ThreadPolicyStatus DeckLinkSignalGen::getThreadPolicyStatus() const {
+  ThreadPolicyStatus status = m_threadPolicyStatus;
+  status.memoryLocked = m_framePool.memoryLocked();
+  status.lockedBytes = m_framePool.lockedBytes();
+  return status;
+}
+
+int DeckLinkSignalGen::setFrameData(const uint16_t* data,
+                                    int width,
+                                    int height) {
+  if (!data || width <= 0 || height <= 0)
+    return -1;
+  m_pipeline.flush();
+  // The output size follows when the frame is packed, through the placement
+  m_sourceWidth = width;
+  m_sourceHeight = height;
+  // Store the frame data
+  size_t dataSize = width * height * 3;  // 3 channels (R, G, B) per pixel
+  {
+    TraceScope span(kTraceCopy);
+    m_pendingFrameData.assign(data, data + dataSize);
+  }
+  m_frameTiming.recordSubmit(FrameTimingAnalyzer::nowNs());
+  return 0;
+}
+
+/**
+ * @brief Replaces rectangles of the current frame and re-displays it
+ *
+ * The regions are copied from @p data into the pending frame. The frame on
+ * screen (without overlays) is copied into a free pool buffer and only the
+ * output rows that read the changed source rows are repacked, through the
+ * placement, before overlays are composited and the frame is displayed. A
+ * frame whose format or geometry no longer matches what is on screen, or
+ * any frame while frame statistics are on (they cover the whole frame), is
+ * packed in full instead.
+ *
+ * @param data Complete new source frame, the size of the current one
+ * @return int 0 on success (and when no region has any pixels), -1 if there
+ *         is no current frame of this size or a region lies outside it, -4
+ *         if no pool buffer is free, or the packing / display error
+ */
+int DeckLinkSignalGen::updateFrameRegions(const uint16_t* data,
+                                          int width,
+                                          int height,
+                                          const FrameRegion* regions,
+                                          int count) {
+  m_pipeline.flush();
+  stopBackgroundOutput();
+  const size_t stride = static_cast<size_t>(width) * 3;
+  if (!data || (!regions && count) || count < 0 ||
+      width != m_sourceWidth || height != m_sourceHeight ||
+      m_pendingFrameData.size() != stride * height)
+    return -1;
+
+  int sourceFirstRow = height;
+  int sourceLastRow = 0;
+  for (int i = 0; i < count; i++) {
+    const FrameRegion& region = regions[i];
+    if (region.x < 0 || region.y < 0 || region.width < 0 ||
+        region.height < 0 || region.x + region.width > width ||
+        region.y + region.height > height)
+      return -1;
+  }
+  {
+    TraceScope span(kTraceCopy);
+    for (int i = 0; i < count; i++) {
+      const FrameRegion& region = regions[i];
+      if (!region.width || !region.height)
+        continue;
+      for (int y = region.y; y < region.y + region.height; y++) {
+        const size_t offset = y * stride + static_cast<size_t>(region.x) * 3;
+        std::memcpy(m_pendingFrameData.data() + offset, data + offset,
+                    static_cast<size_t>(region.width) * 3 * sizeof(uint16_t));
+      }
+      sourceFirstRow = std::min(sourceFirstRow, region.y);
+      sourceLastRow = std::max(sourceLastRow, region.y + region.height);
+    }
+  }
+  if (sourceFirstRow >= sourceLastRow)
+    return 0;
+  m_frameTiming.recordSubmit(FrameTimingAnalyzer::nowNs());
+
+  int statsMode;
+  {
+    std::lock_guard<std::mutex> lock(m_frameStatsMutex);
+    statsMode = m_frameStatsMode;
+  }
+  PlacementMap map;
+  int err = resolvePlacement(width, height, &map);
+  if (err)
+    return err;
+  if (statsMode != kFrameStatsOff || !m_output || !m_outputEnabled ||
+      !m_frame || !m_frameBytes || m_frame->GetPixelFormat() != m_pixelFormat ||
+      map.outputWidth != m_width || map.outputHeight != m_height ||
+      m_frame->GetWidth() != m_width || m_frame->GetHeight() != m_height) {
+    err = createFrame();
+    if (err)
+      return err;
+    return displayFrameSync();
+  }
+
+  int firstRow = 0;
+  int lastRow = 0;
+  placement_output_rows(map, sourceFirstRow, sourceLastRow, &firstRow,
+                        &lastRow);
+
+  const size_t frameSize =
+      static_cast<size_t>(m_framePool.rowBytes()) * m_height;
+  void* frameData = nullptr;
+  IDeckLinkMutableVideoFrame* frame = m_framePool.acquire(&frameData);
+  if (!frame) {
+    std::cerr << "[DeckLink] No free frame buffer in pool" << std::endl;
+    return -4;
+  }
+  // m_packedBase holds the frame without overlays whenever it is valid
+  std::memcpy(frameData,
+              m_packedBaseValid ? m_packedBase.data() : m_frameBytes,
+              frameSize);
+  m_frame->Release();
+  m_frame = frame;
+
+  {
+    TraceScope span(kTracePack);
+    err = pack_placed_rows(frameData, m_pixelFormat,
+                           m_pendingFrameData.data(), map,
+                           m_framePool.rowBytes(), firstRow, lastRow,
+                           &m_regionScratch);
+  }
+  if (err)
+    return err;
+
+  m_packedBaseValid = false;
+  err = finishFrame(frameData);
+  if (err)
+    return err;
+  return displayFrameSync();
+}
+
+/**
+ * @brief Starts temporal dithering (FRC) of a patch
+ *
+ * Each channel's fractional target is split into a low code value and a
+ * duty: the channel shows low + 1 on round(fraction * cycleFrames) frames of
+ * every cycle, spread evenly across the cycle. At most eight distinct frames
+ * result (one per on/off combination of the three channels); they are packed
+ * once from the pending frame (or black), with the patch filled into the ROI
+ * and overlays composited, and looped with scheduled playback so the cadence
+ * follows the hardware clock rather than the caller.
+ *
+ * @param config Targets, ROI and cycle length
+ * @return int Returns 0 on success, negative values on failure:
+ *         - -1: Output not enabled or invalid config
+ *         - -2: Display mode frame rate could not be queried
+ *         - -3: Scheduled playback could not be started
+ *         - -4: No frame buffer available
+ *         - -8: No packer for the active pixel format
+ */
+int DeckLinkSignalGen::startFrc(const FrcConfig& config) {
+  if (!m_output || !m_outputEnabled)
+    return -1;
+  m_pipeline.flush();
+  const int maxCode = pixel_max_code(m_pixelFormat);
+  if (maxCode == 0)
+    return -8;
+
+  // The pending frame (if any) is the background, placed on the raster
+  PlacementMap map = {};
+  const bool hasFrame = !m_pendingFrameData.empty();
+  if (hasFrame) {
+    int err = resolvePlacement(m_sourceWidth, m_sourceHeight, &map);
+    if (err)
+      return err;
+    m_width = map.outputWidth;
+    m_height = map.outputHeight;
+  }
+
+  const int cycle = config.cycleFrames;
+  const bool fullFrame = config.roiWidth == 0 || config.roiHeight == 0;
+  const int roiX = fullFrame ? 0 : config.roiX;
+  const int roiY = fullFrame ? 0 : config.roiY;
+  const int roiWidth = fullFrame ? m_width : config.roiWidth;
+  const int roiHeight = fullFrame ? m_height : config.roiHeight;
+  if (cycle < 1 || cycle > 64 || roiX < 0 || roiY < 0 || roiWidth < 0 ||
+      roiHeight < 0 || roiX + roiWidth > m_width ||
+      roiY + roiHeight > m_height)
+    return -1;
+
+  FrcStatus status;
+  uint8_t upper[64];
+  if (planFrc(config, maxCode, &status, upper))
+    return -1;
+
+  BMDTimeValue frameDuration = 0;
+  BMDTimeScale timeScale = 0;
+  if (!getFrameRate(&frameDuration, &timeScale))
+    return -2;
+
+  stopBackgroundOutput();
+
+  // One packed frame per distinct combination of high channels
+  std::vector<uint16_t> sequence(cycle);
+  int frameForCombination[8];
+  std::fill(std::begin(frameForCombination), std::end(frameForCombination),
+            -1);
+  std::vector<int> combinations;
+  for (int k = 0; k < cycle; k++) {
+    const int combination = upper[k];
+    if (frameForCombination[combination] < 0) {
+      frameForCombination[combination] = static_cast<int>(combinations.size());
+      combinations.push_back(combination);
+    }
+    sequence[k] = static_cast<uint16_t>(frameForCombination[combination]);
+  }
+
+  int err = m_clipPool.configure(m_output, m_width, m_height, m_pixelFormat, 8,
+                                 m_threadPolicy.lockMemory != 0);
+  if (err)
+    return err;
+  const int32_t rowBytes = m_clipPool.rowBytes();
+  const size_t frameSize = static_cast<size_t>(rowBytes) * m_height;
+
+  // Pack the background once; each constituent frame is a copy plus the ROI
+  TrackedVector<uint8_t, kMemoryPackScratch> base(frameSize);
+  if (hasFrame) {
+    err = m_packWorkers.packPlaced(base.data(), m_pixelFormat,
+                                   m_pendingFrameData.data(), map, rowBytes);
+  } else {
+    TrackedVector<uint16_t, kMemoryPackScratch> black(
+        static_cast<size_t>(m_width) * m_height * 3);
+    err = m_packWorkers.pack(base.data(), m_pixelFormat, black.data(), m_width,
+                             m_height, rowBytes);
+  }
+  if (err)
+    return err;
+
+  std::vector<IDeckLinkMutableVideoFrame*> frames;
+  for (int combination : combinations) {
+    void* frameData = nullptr;
+    IDeckLinkMutableVideoFrame* frame = m_clipPool.acquire(&frameData);
+    if (!frame) {
+      err = -4;
+      break;
+    }
+    frames.push_back(frame);
+    std::memcpy(frameData, base.data(), frameSize);
+
+    uint16_t rgb[3];
+    for (int c = 0; c < 3; c++)
+      rgb[c] = static_cast<uint16_t>(status.low[c] + ((combination >> c) & 1));
+    err = fill_pixel_rect(frameData, m_pixelFormat, rowBytes, roiX, roiY,
+                          roiWidth, roiHeight, rgb);
+    if (!err && m_overlays.hasVisible())
+      err = m_overlays.composite(frameData, m_pixelFormat, m_width, m_height,
+                                 rowBytes);
+    if (err)
+      break;
+    if (frames.size() == 1)
+      captureThumbnail(frameData, m_width, m_height, rowBytes, true);
+    applyFrameMetadata(frame);
+    recordFrame(frameData, m_width, m_height, rowBytes, kRecordedClip);
+  }
+
+  if (!err) {
+    if (m_timingDisplayMode != m_displayMode) {
+      m_frameTiming.reset(nominalFrameIntervalNs());
+      m_timingDisplayMode = m_displayMode;
+    }
+    // Three frames queued ahead absorb callback jitter without adding much
+    // latency to stopFrc()
+    err = m_clipPlayer.start(m_output, frames, sequence, frameDuration,
+                             timeScale, 3, &m_frameTiming);
+  }
+  // The player holds its own references
+  for (IDeckLinkMutableVideoFrame* frame : frames)
+    frame->Release();
+  if (err)
+    return err;
+
+  m_frcStatus = status;
+  std::cerr << "[DeckLink] FRC " << status.achieved[0] << " / "
+            << status.achieved[1] << " / " << status.achieved[2] << " over "
+            << cycle << " frames from " << combinations.size()
+            << " packed frame(s)" << std::endl;
+  return 0;
+}
+
+/**
+ * @brief Switches pipelined (pack-while-display) output on or off
+ *
+ * While enabled, submitFrame() replaces the setFrameData() / createFrame() /
+ * displayFrameSync() sequence. The display thread takes the output thread
+ * policy if one was requested. Disabling displays every frame already
+ * submitted before the threads exit.
+ *
+ * @return int Always 0
+ */
+int DeckLinkSignalGen::setPipelinedOutput(bool enabled) {
+  if (!enabled) {
+    m_pipeline.stop();
+    return 0;
+  }
+  if (m_pipeline.running())
+    return 0;
+
+  const bool applyPolicy = m_threadPolicy.outputCore >= 0 ||
+                           m_threadPolicy.schedPolicy != kThreadSchedOther;
+  m_pipeline.start(
+      [this](PipelineInput& data, int width, int height, PipelineFrame* out) {
+        return packPipelined(data, width, height, out);
+      },
+      [this](const PipelineFrame& frame) { return displayPipelined(frame); },
+      [this, applyPolicy] {
+        if (applyPolicy)
+          applyOutputThreadPolicy();
+      });
+  std::cerr << "[DeckLink] Pipelined output enabled" << std::endl;
+  return 0;
+}
+
+/**
+ * @brief Queues a frame for pipelined packing and display
+ *
+ * Returns as soon as the frame is in the pipeline's input slot, which is
+ * immediately unless both the pack and display stages are still busy with
+ * earlier frames.
+ *
+ * @return int 0 on success, -1 if pipelined output is off or the arguments
+ *         are invalid, or the last pack / display error of an earlier frame
+ */
+int DeckLinkSignalGen::submitFrame(const uint16_t* data,
+                                   int width,
+                                   int height) {
+  if (!m_pipeline.running())
+    return -1;
+  // Scheduled playback and streams own the output until stopped
+  stopBackgroundOutput();
+  return m_pipeline.submit(data, width, height);
+}
+
+int DeckLinkSignalGen::flushOutput() {
+  m_pipeline.flush();
+  return m_pipeline.stats().lastError;
+}
+
+/**
+ * @brief Packs frame data, with overlays and metadata, into a pooled frame
+ *
+ * The pool holds frames of the placed output size. With @p keepBase the
+ * packed frame without overlays is kept for updateOverlays().
+ */
+int DeckLinkSignalGen::packIntoPool(FramePool& pool,
+                                    int capacity,
+                                    const uint16_t* data,
+                                    const PlacementMap& map,
+                                    bool keepBase,
+                                    PipelineFrame* out,
+                                    HDRMetadataProvider* metadata) {
+  const int width = map.outputWidth;
+  const int height = map.outputHeight;
+  int err = pool.configure(m_output, width, height, m_pixelFormat, capacity,
+                           m_threadPolicy.lockMemory != 0);
+  if (err)
+    return err;
+
+  void* frameData = nullptr;
+  IDeckLinkMutableVideoFrame* frame = pool.acquire(&frameData);
+  if (!frame) {
+    std::cerr << "[DeckLink] No free frame buffer in pool" << std::endl;
+    return -4;
+  }
+
+  const int32_t rowBytes = pool.rowBytes();
+  err = packFrame(frameData, data, map, rowBytes);
+  if (!err && m_overlays.hasVisible()) {
+    if (keepBase) {
+      const uint8_t* bytes = static_cast<const uint8_t*>(frameData);
+      m_packedBase.assign(bytes,
+                          bytes + static_cast<size_t>(rowBytes) * height);
+    }
+    err = m_overlays.composite(frameData, m_pixelFormat, width, height,
+                               rowBytes);
+  }
+  if (err) {
+    frame->Release();
+    return err;
+  }
+  captureThumbnail(frameData, width, height, rowBytes, false);
+  applyFrameMetadata(frame, metadata);
+  recordFrame(frameData, width, height, rowBytes,
+              &pool == &m_schedulerPool ? kRecordedScheduled
+                                        : kRecordedPipelined,
+              metadata);
+
+  out->frame = frame;
+  out->bytes = frameData;
+  return 0;
+}
+
+/**
+ * @brief Pack stage of pipelined output (runs on the pack thread)
+ *
+ * Same work as createFrame() / finishFrame() but into a frame owned by the
+ * pipeline until it is displayed. The packed input becomes the pending
+ * frame data so reconfigure() re-presents the latest frame.
+ */
+int DeckLinkSignalGen::packPipelined(PipelineInput& data,
+                                     int width,
+                                     int height,
+                                     PipelineFrame* out) {
+  if (!m_output || !m_outputEnabled)
+    return -1;
+
+  PlacementMap map;
+  int err = resolvePlacement(width, height, &map);
+  if (err)
+    return err;
+  // One frame on screen, one the SDK may still hold, one ready, one packing
+  err = packIntoPool(m_framePool, 4, data.data(), map, true, out);
+  if (err)
+    return err;
+  m_packedBaseValid = m_overlays.hasVisible();
+
+  // Every reader of these waits for the pipeline to drain first
+  m_width = map.outputWidth;
+  m_height = map.outputHeight;
+  m_sourceWidth = width;
+  m_sourceHeight = height;
+  m_pendingFrameData.swap(data);
+  return 0;
+}
+
+// Display stage of pipelined output and streams (runs on the display thread)
+int DeckLinkSignalGen::displayPipelined(const PipelineFrame& frame,
+                                        bool continuous) {
+  if (m_timingDisplayMode != m_displayMode) {
+    m_frameTiming.reset(nominalFrameIntervalNs());
+    m_timingDisplayMode = m_displayMode;
+  }
+  m_frameTiming.recordSubmit(frame.submitNs);
+
+  HRESULT result;
+  {
+    TraceScope span(kTraceDisplay);
+    result = m_output->DisplayVideoFrameSync(frame.frame);
+  }
+  if (result != S_OK) {
+    std::cerr << "[DeckLink] DisplayVideoFrameSync failed. HRESULT: 0x"
+              << std::hex << result << std::dec << std::endl;
+    frame.frame->Release();
+    return -1;
+  }
+  m_frameTiming.recordCompletion(FrameTimingAnalyzer::nowNs(), continuous);
+
+  // Keep the frame on screen as the current one for updateOverlays()
+  if (m_frame)
+    m_frame->Release();
+  m_frame = frame.frame;
+  m_frameBytes = frame.bytes;
+  return 0;
+}
+
+void DeckLinkSignalGen::stopBackgroundOutput() {
+  m_clipPlayer.stop();
+  m_scheduler.stop();
+  m_stream.stop();
+}
+
+/**
+ * @brief Starts deadline-aware scheduled output
+ *
+ * Scheduled playback starts with an empty queue; frames are then added with
+ * scheduleFrame(). Synchronous display, pipelined submission, FRC and any
+ * reconfiguration stop it.
+ *
+ * @return int 0 on success, otherwise:
+ *         - -1: Output not enabled or invalid config
+ *         - -2: Display mode frame rate could not be queried
+ *         - -3: Scheduled playback could not be started
+ */
+int DeckLinkSignalGen::startScheduler(const SchedulerConfig& config) {
+  if (!m_output || !m_outputEnabled)
+    return -1;
+  m_pipeline.flush();
+
+  BMDTimeValue frameDuration = 0;
+  BMDTimeScale timeScale = 0;
+  if (!getFrameRate(&frameDuration, &timeScale))
+    return -2;
+
+  stopBackgroundOutput();
+  if (m_timingDisplayMode != m_displayMode) {
+    m_frameTiming.reset(nominalFrameIntervalNs());
+    m_timingDisplayMode = m_displayMode;
+  }
+  // Frames the SDK holds (lead, on screen, completing) plus the queue
+  const int maxLead =
+      config.adaptive ? config.maxLeadFrames : config.leadFrames;
+  m_schedulerPoolFrames = maxLead + config.maxPending + 2;
+  return m_scheduler.start(m_output, config, frameDuration, timeScale,
+                           &m_frameTiming);
+}
+
+/**
+ * @brief Packs a frame and queues it for a presentation time
+ *
+ * Under the strict policy a frame that would be dropped is rejected before
+ * it is packed. A dropped or superseded frame is not an error: the outcome
+ * is in @p record. A nonzero @p hdrMetadataId gives the frame that interned
+ * HDR metadata instead of the current one.
+ *
+ * @return int 0 on success, -1 if the scheduler is not running, the
+ *         arguments are invalid or the metadata id is unknown, -4 if every
+ *         pooled frame is in use, or a packing error
+ */
+int DeckLinkSignalGen::scheduleFrame(const uint16_t* data,
+                                     int width,
+                                     int height,
+                                     int64_t targetNs,
+                                     int32_t durationFrames,
+                                     int32_t hdrMetadataId,
+                                     SchedulerDecisionRecord* record) {
+  if (!m_scheduler.running() || !data || width <= 0 || height <= 0 ||
+      targetNs < 0 || durationFrames < 1)
+    return -1;
+  HDRMetadataProvider* metadata = nullptr;
+  if (hdrMetadataId && !(metadata = m_hdrTable.acquire(hdrMetadataId)))
+    return -1;
+
+  SchedulerDecisionRecord decision = {};
+  int err = 0;
+  if (!m_scheduler.rejectBeforePack(targetNs, durationFrames, &decision)) {
+    PlacementMap map;
+    PipelineFrame packed = {};
+    err = resolvePlacement(width, height, &map);
+    if (!err)
+      err = packIntoPool(m_schedulerPool, m_schedulerPoolFrames, data, map,
+                         false, &packed, metadata);
+    if (!err)
+      err = m_scheduler.submit(packed.frame, targetNs, durationFrames,
+                               &decision);
+  }
+  if (metadata)
+    metadata->Release();
+  if (record)
+    *record = decision;
+  return err;
+}
+
+// Wraps caller memory in the active pixel format (pixelFormat 0 selects it)
+int DeckLinkSignalGen::wrapExternalFrame(const ExternalFrameDesc& desc,
+                                         ExternalReleaseFn release,
+                                         void* context,
+                                         IDeckLinkMutableVideoFrame** frame) {
+  ExternalFrameDesc wrapped = desc;
+  if (!wrapped.pixelFormat)
+    wrapped.pixelFormat = m_pixelFormat;
+  if (wrapped.pixelFormat != m_pixelFormat) {
+    // The SDI link and the HDR signalling follow the active format
+    std::cerr << "[DeckLink] External frame is "
+              << fourCharCode(static_cast<int>(wrapped.pixelFormat))
+              << " but the output is "
+              << fourCharCode(static_cast<int>(m_pixelFormat)) << std::endl;
+    return -1;
+  }
+  return wrap_external_frame(m_output, wrapped, release, context, frame);
+}
+
+void DeckLinkSignalGen::prepareExternalFrame(
+    const ExternalFrameDesc& desc,
+    bool force,
+    HDRMetadataProvider* metadata,
+    IDeckLinkMutableVideoFrame* frame) {
+  captureThumbnail(desc.bytes, desc.width, desc.height, desc.rowBytes, force);
+  applyFrameMetadata(frame, metadata);
+  recordFrame(desc.bytes, desc.width, desc.height, desc.rowBytes,
+              kRecordedExternal, metadata);
+}
+
+/**
+ * @brief Displays a caller-owned, already packed frame without copying it
+ *
+ * The frame stays on screen, and its memory referenced, until the next
+ * frame replaces it. It is not analysed (the source values are not known)
+ * and overlays are not composited into caller memory, so updateOverlays()
+ * needs a new createFrame().
+ *
+ * @return int 0 on success, otherwise:
+ *         - -1: Output not enabled, invalid description or a pixel format
+ *               other than the active one
+ *         - wrap_external_frame() or display errors
+ */
+int DeckLinkSignalGen::displayExternalFrame(const ExternalFrameDesc& desc,
+                                            ExternalReleaseFn release,
+                                            void* context) {
+  if (!m_output || !m_outputEnabled)
+    return -1;
+  m_pipeline.flush();
+  stopBackgroundOutput();
+
+  IDeckLinkMutableVideoFrame* frame = nullptr;
+  int err = wrapExternalFrame(desc, release, context, &frame);
+  if (err)
+    return err;
+  prepareExternalFrame(desc, true, nullptr, frame);
+
+  if (m_frame)
+    m_frame->Release();
+  m_frame = frame;
+  m_frameBytes = nullptr;
+  m_packedBaseValid = false;
+  return displayFrameSync();
+}
+
+/**
+ * @brief Queues a caller-owned, already packed frame for a presentation time
+ *
+ * Same decisions and HDR metadata as scheduleFrame(). A frame dropped
+ * before it is queued is released at once.
+ *
+ * @return int 0 on success, -1 if the scheduler is not running, the
+ *         arguments are invalid or the metadata id is unknown, or a
+ *         wrap_external_frame() error
+ */
+int DeckLinkSignalGen::scheduleExternalFrame(const ExternalFrameDesc& desc,
+                                             ExternalReleaseFn release,
+                                             void* context,
+                                             int64_t targetNs,
+                                             int32_t durationFrames,
+                                             int32_t hdrMetadataId,
+                                             SchedulerDecisionRecord* record) {
+  if (!m_scheduler.running() || targetNs < 0 || durationFrames < 1)
+    return -1;
+  HDRMetadataProvider* metadata = nullptr;
+  if (hdrMetadataId && !(metadata = m_hdrTable.acquire(hdrMetadataId)))
+    return -1;
+
+  IDeckLinkMutableVideoFrame* frame = nullptr;
+  int err = wrapExternalFrame(desc, release, context, &frame);
+  if (err) {
+    if (metadata)
+      metadata->Release();
+    return err;
+  }
+
+  // Decided before the frame is recorded, so dropped frames never appear
+  // in a recording or the thumbnail
+  SchedulerDecisionRecord decision = {};
+  if (m_scheduler.rejectBeforePack(targetNs, durationFrames, &decision)) {
+    frame->Release();
+  } else {
+    prepareExternalFrame(desc, false, metadata, frame);
+    err = m_scheduler.submit(frame, targetNs, durationFrames, &decision);
+  }
+  if (metadata)
+    metadata->Release();
+  if (record)
+    *record = decision;
+  return err;
+}
+
+/**
+ * @brief Packs a frame in the active pixel format into the frame cache
+ *
+ * The frame is not shown, so this can run while other output is live.
+ * Frame statistics are not updated, since nothing leaves the library until
+ * the entry is displayed. The entry is stored at the placed output size.
+ *
+ * @return int 0 on success, -1 without a device or for invalid arguments,
+ *         -2 if the display mode size could not be queried for the
+ *         placement, -3 if RowBytesForPixelFormat fails, or a packing error
+ */
+int DeckLinkSignalGen::cacheFrame(int64_t key,
+                                  const uint16_t* data,
+                                  int width,
+                                  int height) {
+  if (!m_output || !data || width <= 0 || height <= 0)
+    return -1;
+
+  PlacementMap map;
+  int err = resolvePlacement(width, height, &map);
+  if (err)
+    return err;
+  int32_t rowBytes = 0;
+  if (m_output->RowBytesForPixelFormat(m_pixelFormat, map.outputWidth,
+                                       &rowBytes) != S_OK)
+    return -3;
+  // Packed on the calling thread: the pack workers may be busy with a
+  // stream or the pipeline
+  m_cacheInput.resize(
+      (static_cast<size_t>(rowBytes) * map.outputHeight + 3) / 4);
+  err = pack_placed_rows(m_cacheInput.data(), m_pixelFormat, data, map,
+                         rowBytes, 0, map.outputHeight, &m_cacheScratch);
+  if (err)
+    return err;
+  return m_frameCache.store(key, m_cacheInput.data(), rowBytes,
+                            map.outputWidth, map.outputHeight, m_pixelFormat);
+}
+
+/**
+ * @brief Stores an already packed frame in the frame cache
+ *
+ * pixelFormat 0 selects the active format. Rows are stored at the device
+ * stride, so a payload with a longer stride is copied row by row first.
+ *
+ * @return int 0 on success, -1 without a device or for an invalid
+ *         description, -3 if RowBytesForPixelFormat fails, -4 if rowBytes is
+ *         shorter than a row, or a FrameCache::store() error
+ */
+int DeckLinkSignalGen::cachePackedFrame(int64_t key,
+                                        const ExternalFrameDesc& desc) {
+  if (!m_output || !desc.bytes || desc.width <= 0 || desc.height <= 0)
+    return -1;
+
+  const BMDPixelFormat pixelFormat =
+      desc.pixelFormat ? static_cast<BMDPixelFormat>(desc.pixelFormat)
+                       : m_pixelFormat;
+  int32_t rowBytes = 0;
+  if (m_output->RowBytesForPixelFormat(pixelFormat, desc.width, &rowBytes) !=
+      S_OK)
+    return -3;
+  if (desc.rowBytes < rowBytes)
+    return -4;
+  if (desc.rowBytes == rowBytes)
+    return m_frameCache.store(key, desc.bytes, rowBytes, desc.width,
+                              desc.height, pixelFormat);
+
+  m_cacheInput.resize((static_cast<size_t>(rowBytes) * desc.height + 3) / 4);
+  const uint8_t* src = static_cast<const uint8_t*>(desc.bytes);
+  uint8_t* dest = reinterpret_cast<uint8_t*>(m_cacheInput.data());
+  for (int32_t y = 0; y < desc.height; y++)
+    std::memcpy(dest + static_cast<size_t>(y) * rowBytes,
+                src + static_cast<size_t>(y) * desc.rowBytes, rowBytes);
+  return m_frameCache.store(key, dest, rowBytes, desc.width, desc.height,
+                            pixelFormat);
+}
+
+void DeckLinkSignalGen::clearFrameCache() {
+  m_frameCache.clear();
+  TrackedVector<uint32_t, kMemoryPackScratch>().swap(m_cacheInput);
+}
+
+/**
+ * @brief Displays a cached frame
+ *
+ * A frame still decoded in the cache's hot set is shown as it is; any other
+ * entry is decoded into a frame buffer first. With overlays visible the
+ * frame is copied and the overlays drawn over the copy, so the cached frame
+ * stays clean and updateOverlays() works as after createFrame().
+ *
+ * @return int 0 on success, otherwise:
+ *         - -1: Output not enabled, unknown key, or an entry in another
+ *               pixel format than the active one
+ *         - -4: No frame buffer is free
+ *         - -5: The entry is corrupt
+ *         - Frame pool, compositing or display errors
+ */
+int DeckLinkSignalGen::displayCachedFrame(int64_t key) {
+  if (!m_output || !m_outputEnabled)
+    return -1;
+  m_pipeline.flush();
+  stopBackgroundOutput();
+
+  int32_t width = 0;
+  int32_t height = 0;
+  BMDPixelFormat pixelFormat = bmdFormatUnspecified;
+  if (!m_frameCache.describe(key, &width, &height, &pixelFormat))
+    return -1;
+  if (pixelFormat != m_pixelFormat) {
+    std::cerr << "[DeckLink] Cached frame is "
+              << fourCharCode(static_cast<int>(pixelFormat))
+              << " but the output is "
+              << fourCharCode(static_cast<int>(m_pixelFormat)) << std::endl;
+    return -1;
+  }
+
+  const bool lockMemory = m_threadPolicy.lockMemory != 0;
+  int err = m_framePool.configure(m_output, width, height, m_pixelFormat, 3,
+                                  lockMemory);
+  if (err)
+    return err;
+
+  // DisplayVideoFrameSync has returned for the previous frame, so it can go
+  if (m_frame) {
+    m_frame->Release();
+    m_frame = nullptr;
+  }
+
+  IDeckLinkMutableVideoFrame* cached = nullptr;
+  void* cachedBytes = nullptr;
+  err = m_frameCache.recall(m_output, key, lockMemory, &m_framePool, &cached,
+                            &cachedBytes);
+  if (err)
+    return err;
+
+  m_width = width;
+  m_height = height;
+  m_packedBaseValid = false;
+  if (m_overlays.hasVisible()) {
+    void* frameData = nullptr;
+    m_frame = m_framePool.acquire(&frameData);
+    if (!m_frame) {
+      cached->Release();
+      std::cerr << "[DeckLink] No free frame buffer in pool" << std::endl;
+      return -4;
+    }
+    std::memcpy(frameData, cachedBytes,
+                static_cast<size_t>(m_framePool.rowBytes()) * height);
+    cached->Release();
+    err = finishFrame(frameData);
+    if (err)
+      return err;
+  } else {
+    m_frame = cached;
+    m_frameBytes = cachedBytes;
+    captureThumbnail(cachedBytes, width, height, m_framePool.rowBytes(),
+                     true);
+    applyFrameMetadata(m_frame);
+    recordFrame(cachedBytes, width, height, m_framePool.rowBytes(),
+                kRecordedDisplay);
+  }
+  return displayFrameSync();
+}
+
+/**
+ * @brief Queues a cached frame for a presentation time
+ *
+ * Same decisions and HDR metadata as scheduleFrame(); a frame rejected
+ * under the strict policy is not decoded. Overlays are drawn over a copy,
+ * as for display.
+ *
+ * @return int 0 on success, -1 if the scheduler is not running, the key or
+ *         metadata id is unknown or the entry is in another pixel format,
+ *         -4 if no frame buffer is free, -5 if the entry is corrupt, or a
+ *         frame pool or compositing error
+ */
+int DeckLinkSignalGen::scheduleCachedFrame(int64_t key,
+                                           int64_t targetNs,
+                                           int32_t durationFrames,
+                                           int32_t hdrMetadataId,
+                                           SchedulerDecisionRecord* record) {
+  if (!m_scheduler.running() || targetNs < 0 || durationFrames < 1)
+    return -1;
+
+  int32_t width = 0;
+  int32_t height = 0;
+  BMDPixelFormat pixelFormat = bmdFormatUnspecified;
+  if (!m_frameCache.describe(key, &width, &height, &pixelFormat) ||
+      pixelFormat != m_pixelFormat)
+    return -1;
+
+  SchedulerDecisionRecord decision = {};
+  int err = 0;
+  if (!m_scheduler.rejectBeforePack(targetNs, durationFrames, &decision)) {
+    HDRMetadataProvider* metadata = nullptr;
+    if (hdrMetadataId && !(metadata = m_hdrTable.acquire(hdrMetadataId)))
+      return -1;
+    const bool lockMemory = m_threadPolicy.lockMemory != 0;
+    err = m_schedulerPool.configure(m_output, width, height, m_pixelFormat,
+                                    m_schedulerPoolFrames, lockMemory);
+    IDeckLinkMutableVideoFrame* frame = nullptr;
+    void* frameData = nullptr;
+    if (!err)
+      err = m_frameCache.recall(m_output, key, lockMemory, &m_schedulerPool,
+                                &frame, &frameData);
+    if (!err && !m_overlays.hasVisible()) {
+      // The hot frame may already be queued with other metadata, interned or
+      // current; this use gets its own frame over the same buffer
+      IDeckLinkMutableVideoFrame* own = rewrap_video_frame(m_output, frame);
+      frame->Release();
+      frame = own;
+      if (!frame)
+        err = -4;
+    }
+    if (err) {
+      if (metadata)
+        metadata->Release();
+      return err;
+    }
+
+    const int32_t rowBytes = m_schedulerPool.rowBytes();
+    if (m_overlays.hasVisible()) {
+      void* copyData = nullptr;
+      IDeckLinkMutableVideoFrame* copy = m_schedulerPool.acquire(&copyData);
+      if (copy) {
+        std::memcpy(copyData, frameData,
+                    static_cast<size_t>(rowBytes) * height);
+        err = m_overlays.composite(copyData, m_pixelFormat, width, height,
+                                   rowBytes);
+      }
+      frame->Release();
+      frame = copy;
+      frameData = copyData;
+      if (!copy) {
+        std::cerr << "[DeckLink] No free frame buffer in pool" << std::endl;
+        err = -4;
+      } else if (err) {
+        frame->Release();
+      }
+    }
+    if (!err) {
+      captureThumbnail(frameData, width, height, rowBytes, false);
+      applyFrameMetadata(frame, metadata);
+      recordFrame(frameData, width, height, rowBytes, kRecordedScheduled,
+                  metadata);
+      err = m_scheduler.submit(frame, targetNs, durationFrames, &decision);
+    }
+    if (metadata)
+      metadata->Release();
+  }
+  if (record)
+    *record = decision;
+  return err;
+}
+
+/**
+ * @brief Starts displaying raw frames read from a file descriptor
+ *
+ * Frames are read and packed on a reader thread and shown at the display
+ * rate on a display thread, which takes the output thread policy if one was
+ * requested. Overlays are not composited into streamed frames. The stream
+ * ends at end of input, after config.maxFrames, or when any other frame
+ * operation stops it.
+ *
+ * @return int 0 on success, otherwise:
+ *         - -1: Output not enabled or invalid config
+ *         - Frame pool errors
+ */
+int DeckLinkSignalGen::startStream(const StreamConfig& config) {
+  if (!m_output || !m_outputEnabled)
+    return -1;
+  if (config.width <= 0 || config.height <= 0 ||
+      (config.format != kStreamRgb48 && config.format != kStreamPacked))
+    return -1;
+  m_pipeline.flush();
+  stopBackgroundOutput();
+
+  // RGB48 frames are placed on the raster; packed frames are sent as read
+  const bool packed = config.format == kStreamPacked;
+  PlacementMap map;
+  int err = packed ? placement_resolve(PlacementConfig{}, config.width,
+                                       config.height, 0, 0, &map)
+                   : resolvePlacement(config.width, config.height, &map);
+  if (err)
+    return err;
+  const int width = map.outputWidth;
+  const int height = map.outputHeight;
+
+  // Read ahead, one being read, one on screen and one the SDK may hold
+  err = m_streamPool.configure(m_output, width, height, m_pixelFormat,
+                               config.readahead + 3,
+                               m_threadPolicy.lockMemory != 0);
+  if (err)
+    return err;
+  const int32_t rowBytes = m_streamPool.rowBytes();
+  const size_t pixelCount =
+      static_cast<size_t>(config.width) * config.height * 3;
+  m_streamInput.resize(packed ? 0 : pixelCount);
+  m_width = width;
+  m_height = height;
+
+  const bool applyPolicy = m_threadPolicy.outputCore >= 0 ||
+                           m_threadPolicy.schedPolicy != kThreadSchedOther;
+  return m_stream.start(
+      config,
+      packed ? static_cast<int64_t>(rowBytes) * height
+             : static_cast<int64_t>(pixelCount * sizeof(uint16_t)),
+      [this, packed](void** buffer, PipelineFrame* frame) {
+        frame->frame = m_streamPool.acquire(&frame->bytes);
+        if (!frame->frame)
+          return -4;
+        *buffer = packed ? frame->bytes : m_streamInput.data();
+        return 0;
+      },
+      [this, packed, map, rowBytes](PipelineFrame* frame) {
+        if (!packed) {
+          int err =
+              packFrame(frame->bytes, m_streamInput.data(), map, rowBytes);
+          if (err)
+            return err;
+        }
+        captureThumbnail(frame->bytes, map.outputWidth, map.outputHeight,
+                         rowBytes, false);
+        applyFrameMetadata(frame->frame);
+        recordFrame(frame->bytes, map.outputWidth, map.outputHeight,
+                    rowBytes, kRecordedStream);
+        return 0;
+      },
+      [this](const PipelineFrame& frame) {
+        return displayPipelined(frame, true);
+      },
+      [this, applyPolicy] {
+        if (applyPolicy)
+          applyOutputThreadPolicy();
+      });
+}
+
+int DeckLinkSignalGen::stopFrc() {
+  return m_clipPlayer.stop();
+}
+
+FrcStatus DeckLinkSignalGen::getFrcStatus() const {
+  FrcStatus status = m_frcStatus;
+  status.playback = m_clipPlayer.stats();
+  return status;
+}
+
+/**
+ * @brief Starts recording every packed frame that leaves the library
+ *
+ * Slots are sized for the larger of the display mode and the raster last
+ * sent; a larger frame (from a placement raster above the display mode) is
+ * counted as oversized rather than recorded.
+ *
+ * @return int 0 on success, -1 for an invalid config or if the display mode
+ *         cannot be queried, -2 if the file cannot be created, -3 if the
+ *         slots cannot be allocated
+ */
+int DeckLinkSignalGen::startRecording(const char* path,
+                                      const RecorderConfig& config) {
+  if (!m_output)
+    return -1;
+  IDeckLinkDisplayMode* mode = nullptr;
+  if (m_output->GetDisplayMode(m_displayMode, &mode) != S_OK || !mode)
+    return -1;
+  const int width = std::max(static_cast<int>(mode->GetWidth()), m_width);
+  const int height = std::max(static_cast<int>(mode->GetHeight()), m_height);
+  mode->Release();
+  int32_t rowBytes = 0;
+  if (m_output->RowBytesForPixelFormat(m_pixelFormat, width, &rowBytes) !=
+      S_OK)
+    return -1;
+
+  return m_recorder.start(
+      path, config, static_cast<int64_t>(rowBytes) * height,
+      recording_header(m_displayMode, m_pixelFormat,
+                       nominalFrameIntervalNs()));
+}
+
+namespace {
+
+// A distinct frame of a replayed recording, owned by the frame wrapping it
+struct ReplayBuffer {
+  RecordedFrame frame;
+  void* bytes;
+  size_t size;
+};
+
+void releaseReplayBuffer(void* context) {
+  auto* buffer = static_cast<ReplayBuffer*>(context);
+  std::free(buffer->bytes);
+  memory_track_free(kMemoryRecorder, buffer->size);
+  delete buffer;
+}
+
+// Sequence entries a replay may take, about 19 hours at 60 Hz
+constexpr size_t kReplayMaxSequence = size_t{1} << 22;
+
+/**
+ * @brief Reads a recording and lays out its replay
+ *
+ * Every frame is read and checked against its CRC. Frames with the same
+ * bytes and metadata share one buffer, and each frame is held for as many
+ * frame durations as passed before the next one was recorded.
+ *
+ * @param buffers Receives the distinct frames, in order of first appearance;
+ *        left empty on error
+ * @param sequence Receives one index into @p buffers per frame duration
+ * @param recorded Receives the number of frames in the recording
+ * @return int 0 on success, or the playRecording() error codes -1, -2, -4
+ *         and -5
+ */
+int planReplay(const char* path,
+               uint32_t pixelFormat,
+               int64_t intervalNs,
+               std::vector<ReplayBuffer*>* buffers,
+               std::vector<uint16_t>* sequence,
+               size_t* recorded) {
+  buffers->clear();
+  sequence->clear();
+  *recorded = 0;
+  RecordingReader reader;
+  if (reader.open(path) != 0) {
+    std::cerr << "[DeckLink] " << (path ? path : "(null)")
+              << " is not a readable recording" << std::endl;
+    return -2;
+  }
+
+  std::unordered_multimap<uint32_t, size_t> buffersByCrc;
+  std::vector<uint16_t> order;
+  std::vector<int64_t> times;
+  RecordedFrame frame = {};
+  int err = 0;
+  int result = 0;
+  while ((result = reader.next(&frame)) == 1) {
+    if (frame.pixelFormat != pixelFormat ||
+        (!buffers->empty() && (frame.width != (*buffers)[0]->frame.width ||
+                               frame.height != (*buffers)[0]->frame.height))) {
+      std::cerr << "[DeckLink] Recorded frame " << frame.sequence
+                << " does not match the output or the first frame"
+                << std::endl;
+      err = -1;
+      break;
+    }
+    auto* buffer = new ReplayBuffer{
+        frame, nullptr,
+        static_cast<size_t>(recording_padded_bytes(frame.frameBytes))};
+    if (posix_memalign(&buffer->bytes, kRecordingAlign, buffer->size) != 0) {
+      delete buffer;
+      err = -4;
+      break;
+    }
+    memory_track_alloc(kMemoryRecorder, buffer->size);
+    err = reader.readData(frame, buffer->bytes);
+    if (err) {
+      std::cerr << "[DeckLink] Recorded frame " << frame.sequence
+                << (err == -5 ? " fails its CRC check" : " is truncated")
+                << std::endl;
+      releaseReplayBuffer(buffer);
+      break;
+    }
+
+    size_t index = buffers->size();
+    auto [first, last] = buffersByCrc.equal_range(frame.crc32);
+    for (auto it = first; it != last; ++it) {
+      const ReplayBuffer* other = (*buffers)[it->second];
+      if (other->frame.frameBytes == frame.frameBytes &&
+          hdr_metadata_equal(other->frame.metadata, frame.metadata) &&
+          std::memcmp(other->bytes, buffer->bytes,
+                      static_cast<size_t>(frame.frameBytes)) == 0) {
+        index = it->second;
+        break;
+      }
+    }
+    if (index < buffers->size()) {
+      releaseReplayBuffer(buffer);
+    } else if (index > UINT16_MAX) {
+      releaseReplayBuffer(buffer);
+      err = -1;
+      break;
+    } else {
+      buffers->push_back(buffer);
+      buffersByCrc.emplace(frame.crc32, index);
+    }
+    order.push_back(static_cast<uint16_t>(index));
+    times.push_back(frame.timestampNs);
+  }
+  if (!err && result < 0)
+    err = result;
+  if (!err && order.empty())
+    err = -2;
+
+  for (size_t i = 0; !err && i < order.size(); i++) {
+    int64_t slots = 1;
+    if (i + 1 < order.size() && intervalNs > 0)
+      slots = std::max<int64_t>(
+          1, std::llround(static_cast<double>(times[i + 1] - times[i]) /
+                          static_cast<double>(intervalNs)));
+    if (sequence->size() + static_cast<size_t>(slots) > kReplayMaxSequence) {
+      err = -1;
+      break;
+    }
+    sequence->insert(sequence->end(), static_cast<size_t>(slots), order[i]);
+  }
+
+  if (err) {
+    for (ReplayBuffer* buffer : *buffers)
+      releaseReplayBuffer(buffer);
+    buffers->clear();
+    sequence->clear();
+    return err;
+  }
+  *recorded = order.size();
+  return 0;
+}
+
+}  // namespace
+
+/**
+ * @brief Plays a recording in a loop through the clip player
+ *
+ * The whole recording is read, checked and laid out by planReplay() before
+ * playback starts, so the replay keeps the recorded pacing. Frames carry the
+ * HDR metadata they were recorded with.
+ *
+ * @return int 0 on success, otherwise:
+ *         - -1: Output not enabled, or the recording is not in the active
+ *               pixel format, mixes frame sizes or is too long
+ *         - -2: The file cannot be read, is not a recording or is empty
+ *         - -4: Out of memory
+ *         - -5: A frame does not match its CRC
+ *         or an error from starting playback
+ */
+int DeckLinkSignalGen::playRecording(const char* path) {
+  if (!m_outputEnabled || !m_output)
+    return -1;
+  m_pipeline.flush();
+  BMDTimeValue frameDuration = 0;
+  BMDTimeScale timeScale = 0;
+  if (!getFrameRate(&frameDuration, &timeScale))
+    return -2;
+  const int64_t intervalNs = frameDuration * 1000000000LL / timeScale;
+
+  std::vector<ReplayBuffer*> buffers;
+  std::vector<uint16_t> sequence;
+  size_t recorded = 0;
+  int err = planReplay(path, m_pixelFormat, intervalNs, &buffers, &sequence,
+                       &recorded);
+
+  // Each wrapped frame owns its buffer from here on
+  std::vector<IDeckLinkMutableVideoFrame*> frames;
+  size_t wrapped = 0;
+  for (; !err && wrapped < buffers.size(); wrapped++) {
+    ReplayBuffer* buffer = buffers[wrapped];
+    const ExternalFrameDesc desc = {buffer->bytes, buffer->frame.width,
+                                    buffer->frame.height,
+                                    buffer->frame.rowBytes,
+                                    buffer->frame.pixelFormat};
+    IDeckLinkMutableVideoFrame* wrappedFrame = nullptr;
+    err = wrap_external_frame(m_output, desc, releaseReplayBuffer, buffer,
+                              &wrappedFrame);
+    if (err)
+      break;
+    frames.push_back(wrappedFrame);
+    auto* metadata = new HDRMetadataProvider(buffer->frame.metadata);
+    applyFrameMetadata(wrappedFrame, metadata);
+    metadata->Release();
+  }
+  for (size_t i = wrapped; i < buffers.size(); i++)
+    releaseReplayBuffer(buffers[i]);
+
+  if (!err) {
+    stopBackgroundOutput();
+    if (m_timingDisplayMode != m_displayMode) {
+      m_frameTiming.reset(nominalFrameIntervalNs());
+      m_timingDisplayMode = m_displayMode;
+    }
+    err = m_clipPlayer.start(m_output, frames, sequence, frameDuration,
+                             timeScale, 3, &m_frameTiming);
+  }
+  // The player holds its own references
+  for (IDeckLinkMutableVideoFrame* wrappedFrame : frames)
+    wrappedFrame->Release();
+  if (err)
+    return err;
+
+  m_frcStatus = {};
+  std::cerr << "[DeckLink] Replaying " << recorded
+            << " recorded frame(s) from " << frames.size()
+            << " distinct frame(s) over " << sequence.size()
+            << " frame durations" << std::endl;
+  return 0;
+}
+
+bool DeckLinkSignalGen::getFrameRate(BMDTimeValue* frameDuration,
+                                     BMDTimeScale* timeScale) const {
+  if (!m_output)
+    return false;
+  IDeckLinkDisplayMode* mode = nullptr;
+  if (m_output->GetDisplayMode(m_displayMode, &mode) != S_OK || !mode)
+    return false;
+  HRESULT result = mode->GetFrameRate(frameDuration, timeScale);
+  mode->Release();
+  return result == S_OK && *frameDuration > 0 && *timeScale > 0;
+}
+
+int64_t DeckLinkSignalGen::nominalFrameIntervalNs() const {
+  BMDTimeValue frameDuration = 0;
+  BMDTimeScale timeScale = 0;
+  if (!getFrameRate(&frameDuration, &timeScale))
+    return 0;
+  return frameDuration * 1000000000LL / timeScale;
+}
+
+int DeckLinkSignalGen::getDeviceCount() {
+  IDeckLinkIterator* iterator = CreateDeckLinkIteratorInstance();
+  if (!iterator)
+    return 0;
+
+  int count = 0;
+  IDeckLink* device = nullptr;
+  while (iterator->Next(&device) == S_OK) {
+    count++;
+    device->Release();
+  }
+  iterator->Release();
+
+  return count;
+}
+
+std::string DeckLinkSignalGen::getDeviceName(int deviceIndex) {
+  IDeckLinkIterator* iterator = CreateDeckLinkIteratorInstance();
+  if (!iterator)
+    return "";
+
+  IDeckLink* device = nullptr;
+  int current = 0;
+  std::string deviceName;
+
+  while (iterator->Next(&device) == S_OK) {
+    if (current == deviceIndex) {
+      CFStringRef nameRef = nullptr;
+      if (device->GetDisplayName(&nameRef) == S_OK && nameRef) {
+        char nameBuffer[256];
+        CFStringGetCString(nameRef, nameBuffer, sizeof(nameBuffer),
+                           kCFStringEncodingUTF8);
+        deviceName = nameBuffer;
+        CFRelease(nameRef);
+      }
+      device->Release();
+      break;
+    }
+    device->Release();
+    current++;
+  }
+  iterator->Release();
+
+  return deviceName;
+}
+
+void DeckLinkSignalGen::cacheSupportedFormats() {
+  if (!m_output || m_formatsCached)
+    return;
+
+  std::set<BMDPixelFormat> uniqueFormats;
+
+  // Test common pixel formats
+  BMDPixelFormat supportedFormats[] = {
+      bmdFormat8BitYUV,    // '2vuy' 4:2:2 Representation
+      bmdFormat10BitYUV,   // 'v210' 4:2:2 Representation
+      bmdFormat10BitYUVA,  // 'Ay10' 4:2:2 raw
+
+      bmdFormat8BitARGB,  // 32     4:4:4:4 raw
+      bmdFormat8BitBGRA,  // 'BGRA' 4:4:4:x raw
+
+      bmdFormat10BitRGB,  // 'r210' 4:4:4 raw
+      bmdFormat12BitRGB,  // 'R12B' Big-endian RGB 12-bit per component with
+                          // full range (0-4095). Packed as 12-bit per component
+      bmdFormat12BitRGBLE,  // 'R12L' Little-endian RGB 12-bit per component
+                            // with full range (0-4095). Packed as 12-bit per
+                            // component.
+
+      bmdFormat10BitRGBXLE,  // 'R10l' 4:4:4 raw Three 10-bit unsigned
+                             // components are packed into one 32-bit
+                             // little-endian word.
+      bmdFormat10BitRGBX,  // 'R10b' 4:4:4 raw Three 10-bit unsigned components
+                           // are packed into one 32-bit big-endian word.
+  };
+
+  for (const BMDPixelFormat format : supportedFormats) {
+    BMDDisplayMode actualMode;
+    bool supported;
+
+    if (m_output->DoesSupportVideoMode(
+            bmdVideoConnectionUnspecified, m_displayMode, format,
+            bmdNoVideoOutputConversion, bmdSupportedVideoModeDefault,
+            &actualMode, &supported) == S_OK &&
+        supported) {
+      uniqueFormats.insert(format);
+    }
+  }
+
+  m_supportedFormats.assign(uniqueFormats.begin(), uniqueFormats.end());
+  m_formatsCached = true;
+}
+
+// Thin C wrapper implementation
+extern "C" {
+
+int decklink_set_frame_data(DeckLinkHandle handle,
+                            const uint16_t* data,
+                            int width,
+                            int height) {
+  if (!handle || !data)
+    return -1;
+  auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
+  return signalGen->setFrameData(data, width, height);
+}
+
+int decklink_get_device_count() {
+  return DeckLinkSignalGen::getDeviceCount();
+}
+
+int decklink_get_device_name_by_index(int index, char* name, int name_size) {
+  if (!name || name_size <= 0)
+    return -1;
+
+  std::string deviceName = DeckLinkSignalGen::getDeviceName(index);
+  if (deviceName.empty())
+    return -1;
+
+  strncpy(name, deviceName.c_str(), name_size - 1);
+  name[name_size - 1] = '\0';
+  return 0;
+}
+
+DeckLinkHandle decklink_open_output_by_index(int index) {
+  DeckLinkSignalGen* signalGen = new DeckLinkSignalGen();
+
+  // Open the device
+  IDeckLinkIterator* iterator = CreateDeckLinkIteratorInstance();
+  if (!iterator) {
+    delete signalGen;
+    return nullptr;
+  }
+
+  IDeckLink* device = nullptr;
+  int current = 0;
+  while (iterator->Next(&device) == S_OK) {
+    if (current == index) {
+      IDeckLinkOutput* output = nullptr;
+      IDeckLinkConfiguration* configuration = nullptr;
+
+      if (device->QueryInterface(IID_IDeckLinkOutput, (void**)&output) ==
+          S_OK) {
+        // Also get the configuration interface for SDI output control
+        if (device->QueryInterface(IID_IDeckLinkConfiguration,
+                                   (void**)&configuration) == S_OK) {
+          signalGen->m_device = device;
+          signalGen->m_output = output;
+          signalGen->m_configuration = configuration;
+          iterator->Release();
+          return signalGen;
+        } else {
+          std::cerr << "[DeckLink] Warning: Could not get configuration "
+                       "interface for device "
+                    << index << std::endl;
+          // Still proceed without configuration interface
+          signalGen->m_device = device;
+          signalGen->m_output = output;
+          signalGen->m_configuration = nullptr;
+          iterator->Release();
+          return signalGen;
+        }
+      }
+      device->Release();
+      break;
+    }
+    device->Release();
+    current++;
+  }
+  iterator->Release();
+  delete signalGen;
+  return nullptr;
+}
+
+void decklink_close(DeckLinkHandle handle) {
+  if (handle) {
+    auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
+    delete signalGen;
+  }
+}
+
+int decklink_start_output(DeckLinkHandle handle) {
+  if (!handle)
+    return -1;
+  auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
+  return signalGen->startOutput();
+}
+
+int decklink_start_output_with_mode(DeckLinkHandle handle,
+                                    uint32_t display_mode) {
+  if (!handle)
+    return -1;
+  auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
+  return signalGen->startOutput(static_cast<BMDDisplayMode>(display_mode));
+}
+
+int decklink_stop_output(DeckLinkHandle handle) {
+  if (!handle)
+    return -1;
+  auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
+  return signalGen->stopOutput();
+}
+
+int decklink_create_frame_from_data(DeckLinkHandle handle) {
+  if (!handle)
+    return -1;
+  auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
+  return signalGen->createFrame();
+}
+
+uint32_t decklink_get_pixel_format(DeckLinkHandle handle) {
+  if (!handle)
+    return 0;
+  auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
+  return static_cast<uint32_t>(signalGen->getPixelFormat());
+}
+
+int decklink_set_pixel_format(DeckLinkHandle handle,
+                              uint32_t pixel_format_code) {
+  if (!handle)
+    return -1;
+  auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
+  return signalGen->setPixelFormat(
+      static_cast<BMDPixelFormat>(pixel_format_code));
+}
+
+int decklink_get_supported_pixel_format_count(DeckLinkHandle handle) {
+  if (!handle)
+    return 0;
+  auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
+  signalGen->cacheSupportedFormats();
+  return static_cast<int>(signalGen->getSupportedFormats().size());
+}
+
+int decklink_get_supported_pixel_format_name(DeckLinkHandle handle,
+                                             int index,
+                                             char* name,
+                                             int name_size) {
+  if (!handle || !name || name_size <= 0)
+    return -1;
+  auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
+
+  signalGen->cacheSupportedFormats();
+  if (index < 0 ||
+      index >= static_cast<int>(signalGen->getSupportedFormats().size()))
+    return -1;
+
+  BMDPixelFormat format = signalGen->getSupportedFormats()[index];
+  std::string fmtChars = fourCharCode(static_cast<int>(format));
+  std::string formatName;
+
+  switch (format) {
+    case bmdFormat8BitYUV:
+      formatName = std::string("8Bit YUV (") + fmtChars + ")";
+      break;
+    case bmdFormat10BitYUV:
+      formatName = std::string("10Bit YUV (") + fmtChars + ")";
+      break;
+    case bmdFormat10BitYUVA:
+      formatName = std::string("10Bit YUVA (") + fmtChars + ")";
+      break;
+
+    case bmdFormat8BitARGB:
+      formatName = std::string("8Bit ARGB (") + std::to_string(format) + ")";
+      break;
+    case bmdFormat8BitBGRA:
+      formatName = std::string("8Bit BGRA (") + fmtChars + ")";
+      break;
+
+    case bmdFormat10BitRGB:
+      formatName = std::string("10Bit RGB (") + fmtChars + ")";
+      break;
+    case bmdFormat12BitRGB:
+      formatName = std::string("12Bit RGB (") + fmtChars + ")";
+      break;
+    case bmdFormat12BitRGBLE:
+      formatName = std::string("12Bit RGB LE (") + fmtChars + ")";
+      break;
+
+    case bmdFormat10BitRGBXLE:
+      formatName = std::string("10Bit RGBX LE (") + fmtChars + ")";
+      break;
+    case bmdFormat10BitRGBX:
+      formatName = std::string("10Bit RGBX (") + fmtChars + ")";
+      break;
+
+    default:
+      formatName = std::string("Unknown (") + fmtChars + ")";
+      break;
+  }
+
+  strncpy(name, formatName.c_str(), name_size - 1);
+  name[name_size - 1] = '\0';
+  return 0;
+}
+
+// Version info
+const char* decklink_get_driver_version() {
+  static std::string version;
+  if (!version.empty())
+    return version.c_str();
+  IDeckLinkAPIInformation* apiInfo = CreateDeckLinkAPIInformationInstance();
+  if (apiInfo) {
+    int64_t versionInt = 0;
+    if (apiInfo->GetInt(BMDDeckLinkAPIVersion, &versionInt) == S_OK) {
+      int major = (versionInt >> 24) & 0xFF;
+      int minor = (versionInt >> 16) & 0xFF;
+      int patch = (versionInt >> 8) & 0xFF;
+      version = std::format("{}.{}.{}", major, minor, patch);
+    } else {
+      version = "unknown";
+    }
+    apiInfo->Release();
+  } else {
+    version = "unavailable";
+  }
+  return version.c_str();
+}
+
+const char* decklink_get_sdk_version() {
+  static std::string sdk_version = BLACKMAGIC_DECKLINK_API_VERSION_STRING;
+  return sdk_version.c_str();
+}
+
+// Add new C wrapper function for complete HDR metadata
+int decklink_set_hdr_metadata(DeckLinkHandle handle,
+                              const HDRMetadata* metadata) {
+  if (!handle || !metadata)
+    return -1;
+  auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
+  return signalGen->setHDRMetadata(*metadata);
+}
+
+int decklink_intern_hdr_metadata(DeckLinkHandle handle,
+                                 const HDRMetadata* metadata) {
+  if (!handle || !metadata)
+    return -1;
+  auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
+  return signalGen->internHDRMetadata(*metadata);
+}
+
+int decklink_clear_hdr_metadata_table(DeckLinkHandle handle) {
+  if (!handle)
+    return -1;
+  auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
+  signalGen->clearHDRMetadataTable();
+  return 0;
+}
+
+int decklink_get_hdr_metadata_table_stats(DeckLinkHandle handle,
+                                          HDRMetadataTableStats* stats) {
+  if (!handle || !stats)
+    return -1;
+  auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
+  *stats = signalGen->getHDRMetadataTableStats();
+  return 0;
+}
+
+// Pixel format pack cost benchmark
+int decklink_benchmark_pixel_format(DeckLinkHandle handle,
+                                    uint32_t pixel_format_code,
+                                    int iterations,
+                                    double* ns_per_frame) {
+  if (!handle || !ns_per_frame)
+    return -1;
+  auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
+  return signalGen->benchmarkPack(
+      static_cast<BMDPixelFormat>(pixel_format_code), iterations,
+      ns_per_frame);
+}
+
+// In-place reconfiguration
+int decklink_reconfigure(DeckLinkHandle handle, const OutputConfig* config) {
+  if (!handle || !config)
+    return -1;
+  auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
+  return signalGen->reconfigure(*config);
+}
+
+int decklink_get_reconfigure_stats(DeckLinkHandle handle,
+                                   ReconfigureStats* stats) {
+  if (!handle || !stats)
+    return -1;
+  auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
+  *stats = signalGen->getReconfigureStats();
+  return 0;
+}
+
+// Thread placement and real-time scheduling
+int decklink_set_thread_policy(DeckLinkHandle handle,
+                               const ThreadPolicyConfig* config) {
+  if (!handle || !config)
+    return -1;
+  auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
+  return signalGen->setThreadPolicy(*config);
+}
+
+int decklink_apply_output_thread_policy(DeckLinkHandle handle) {
+  if (!handle)
+    return -1;
+  auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
+  return signalGen->applyOutputThreadPolicy();
+}
+
+int decklink_get_thread_policy_status(DeckLinkHandle handle,
+                                      ThreadPolicyStatus* status) {
+  if (!handle || !status)
+    return -1;
+  auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
+  *status = signalGen->getThreadPolicyStatus();
+  return 0;
+}
+
+// Frame timing analysis
+int decklink_get_frame_timing_report(DeckLinkHandle handle,
+                                     FrameTimingReport* report) {
+  if (!handle || !report)
+    return -1;
+  auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
+  signalGen->getFrameTiming().report(report);
+  return 0;
+}
+
+int decklink_get_frame_timing_outliers(DeckLinkHandle handle,
+                                       FrameTimingOutlier* outliers,
+                                       int max_count) {
+  if (!handle || !outliers || max_count < 0)
+    return -1;
+  auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
+  return signalGen->getFrameTiming().outliers(outliers, max_count);
+}
+
+int decklink_reset_frame_timing(DeckLinkHandle handle) {
+  if (!handle)
+    return -1;
+  auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
+  signalGen->getFrameTiming().reset(0);
+  return 0;
+}
+
+int decklink_set_frame_timing_threshold(DeckLinkHandle handle,
+                                        double threshold) {
+  if (!handle || threshold < 0.0)
+    return -1;
+  auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
+  signalGen->getFrameTiming().setOutlierThreshold(threshold);
+  return 0;
+}
+
+// Memory accounting (process-wide, all handles)
+int decklink_get_memory_stats(MemoryStats* stats, int max_count) {
+  if (!stats || max_count <= 0)
+    return -1;
+  return memory_get_stats(stats, max_count);
+}
+
+int decklink_reset_memory_peaks() {
+  memory_reset_peaks();
+  return 0;
+}
+
+// Span tracing
+int decklink_trace_set_enabled(bool enabled) {
+  trace_set_enabled(enabled);
+  return 0;
+}
+
+int64_t decklink_trace_now_ns() {
+  return trace_now_ns();
+}
+
+int decklink_trace_set_frame(int64_t frame_id) {
+  if (frame_id < 0)
+    return -1;
+  trace_set_frame(frame_id);
+  return 0;
+}
+
+int decklink_trace_collect(TraceSpan* spans, int max_count) {
+  if (!spans || max_count <= 0)
+    return -1;
+  return trace_collect(spans, max_count);
+}
+
+int decklink_trace_get_threads(TraceThread* threads, int max_count) {
+  if (!threads || max_count <= 0)
+    return -1;
+  return trace_threads(threads, max_count);
+}
+
+int decklink_trace_get_stats(TraceStats* stats) {
+  if (!stats)
+    return -1;
+  *stats = trace_stats();
+  return 0;
+}
+
+// Packed-domain overlays
+int decklink_add_overlay(DeckLinkHandle handle,
+                         int x,
+                         int y,
+                         int width,
+                         int height,
+                         const uint16_t* rgba,
+                         bool enabled) {
+  if (!handle || !rgba || width <= 0 || height <= 0 || width > 0xFFFF ||
+      height > 0xFFFF)
+    return -1;
+  auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
+  return signalGen->getOverlays().add(x, y, width, height, rgba, enabled);
+}
+
+int decklink_remove_overlay(DeckLinkHandle handle, int overlay_id) {
+  if (!handle)
+    return -1;
+  auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
+  return signalGen->getOverlays().remove(overlay_id) ? 0 : -2;
+}
+
+int decklink_set_overlay_enabled(DeckLinkHandle handle,
+                                 int overlay_id,
+                                 bool enabled) {
+  if (!handle)
+    return -1;
+  auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
+  return signalGen->getOverlays().setEnabled(overlay_id, enabled) ? 0 : -2;
+}
+
+int decklink_move_overlay(DeckLinkHandle handle, int overlay_id, int x, int y) {
+  if (!handle)
+    return -1;
+  auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
+  return signalGen->getOverlays().move(overlay_id, x, y) ? 0 : -2;
+}
+
+int decklink_clear_overlays(DeckLinkHandle handle) {
+  if (!handle)
+    return -1;
+  auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
+  signalGen->getOverlays().clear();
+  return 0;
+}
+
+int decklink_update_overlays(DeckLinkHandle handle) {
+  if (!handle)
+    return -1;
+  auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
+  return signalGen->updateOverlays();
+}
+
+int decklink_start_frc(DeckLinkHandle handle, const FrcConfig* config) {
+  if (!handle || !config)
+    return -1;
+  auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
+  return signalGen->startFrc(*config);
+}
+
+int decklink_plan_frc(const FrcConfig* config,
+                      int max_code,
+                      FrcStatus* status,
+                      uint8_t* upper) {
+  if (!config || !status || !upper)
+    return -1;
+  return planFrc(*config, max_code, status, upper);
+}
+
+int decklink_stop_frc(DeckLinkHandle handle) {
+  if (!handle)
+    return -1;
+  auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
+  return signalGen->stopFrc();
+}
+
+int decklink_get_frc_status(DeckLinkHandle handle, FrcStatus* status) {
+  if (!handle || !status)
+    return -1;
+  auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
+  *status = signalGen->getFrcStatus();
+  return 0;
+}
+
+int decklink_set_pipelined_output(DeckLinkHandle handle, bool enabled) {
+  if (!handle)
+    return -1;
+  auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
+  return signalGen->setPipelinedOutput(enabled);
+}
+
+int decklink_submit_frame(DeckLinkHandle handle,
+                          const uint16_t* data,
+                          int width,
+                          int height) {
+  if (!handle)
+    return -1;
+  auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
+  return signalGen->submitFrame(data, width, height);
+}
+
+int decklink_flush_output(DeckLinkHandle handle) {
+  if (!handle)
+    return -1;
+  auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
+  return signalGen->flushOutput();
+}
+
+int decklink_get_pipeline_stats(DeckLinkHandle handle, PipelineStats* stats) {
+  if (!handle || !stats)
+    return -1;
+  auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
+  *stats = signalGen->getPipelineStats();
+  return 0;
+}
+
+int decklink_start_scheduler(DeckLinkHandle handle,
+                             const SchedulerConfig* config) {
+  if (!handle || !config)
+    return -1;
+  auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
+  return signalGen->startScheduler(*config);
+}
+
+int decklink_stop_scheduler(DeckLinkHandle handle) {
+  if (!handle)
+    return -1;
+  auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
+  return signalGen->stopScheduler();
+}
+
+int decklink_schedule_frame(DeckLinkHandle handle,
+                            const uint16_t* data,
+                            int width,
+                            int height,
+                            int64_t target_ns,
+                            int32_t duration_frames,
+                            SchedulerDecisionRecord* record) {
+  if (!handle)
+    return -1;
+  auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
+  return signalGen->scheduleFrame(data, width, height, target_ns,
+                                  duration_frames, 0, record);
+}
+
+int decklink_schedule_frame_hdr(DeckLinkHandle handle,
+                                const uint16_t* data,
+                                int width,
+                                int height,
+                                int64_t target_ns,
+                                int32_t duration_frames,
+                                int32_t hdr_metadata_id,
+                                SchedulerDecisionRecord* record) {
+  if (!handle)
+    return -1;
+  auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
+  return signalGen->scheduleFrame(data, width, height, target_ns,
+                                  duration_frames, hdr_metadata_id, record);
+}
+
+int decklink_get_scheduler_stats(DeckLinkHandle handle,
+                                 SchedulerStats* stats) {
+  if (!handle || !stats)
+    return -1;
+  auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
+  *stats = signalGen->getSchedulerStats();
+  return 0;
+}
+
+int decklink_get_scheduler_decisions(DeckLinkHandle handle,
+                                     SchedulerDecisionRecord* records,
+                                     int max_count) {
+  if (!handle || !records)
+    return -1;
+  auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
+  return signalGen->getSchedulerDecisions(records, max_count);
+}
+
+int decklink_get_scheduler_lead_changes(DeckLinkHandle handle,
+                                        SchedulerLeadChange* changes,
+                                        int max_count) {
+  if (!handle || !changes)
+    return -1;
+  auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
+  return signalGen->getSchedulerLeadChanges(changes, max_count);
+}
+
+int decklink_start_stream(DeckLinkHandle handle, const StreamConfig* config) {
+  if (!handle || !config)
+    return -1;
+  auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
+  return signalGen->startStream(*config);
 }
 
-int DeckLinkSignalGen::applyHDRMetadata() {
-  if (!m_frame)
-    return 0;
-
-  // Get the metadata extensions interface
-  IDeckLinkVideoFrameMutableMetadataExtensions* metadataExt = nullptr;
-  HRESULT result = m_frame->QueryInterface(
-      IID_IDeckLinkVideoFrameMutableMetadataExtensions, (void**)&metadataExt);
-  if (result != S_OK || !metadataExt) {
-    std::cerr << "[DeckLink] Warning: Could not get metadata extensions "
-                 "interface (HRESULT: 0x"
-              << std::hex << result << std::dec
-              << "). HDR metadata will not be applied." << std::endl;
-    return 0;  // Don't fail the frame creation, just skip metadata
-  }
-
-  // Determine colorspace from primaries by checking red primary coordinates
-  // Rec.709:  Red (0.640, 0.330)
-  // DCI-P3:   Red (0.680, 0.320)
-  // Rec.2020: Red (0.708, 0.292)
-  BMDColorspace colorspace = bmdColorspaceRec709;  // Default to Rec.709
-  double redX = m_hdrMetadata.referencePrimaries.RedX;
-
-  if (redX > 0.70) {
-    colorspace = bmdColorspaceRec2020;
-  } else if (redX > 0.66) {
-    // DCI-P3 has Red at 0.680 - but BMD SDK doesn't have a specific P3 constant
-    // Use Rec.2020 as closest HDR-compatible colorspace for P3
-    colorspace = bmdColorspaceRec2020;
-  } else {
-    colorspace = bmdColorspaceRec709;
-  }
+int decklink_stop_stream(DeckLinkHandle handle) {
+  if (!handle)
+    return -1;
+  auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
+  return signalGen->stopStream();
+}
 
-  // Debug: Log what we're about to set
-  std::cerr << "[DeckLink] applyHDRMetadata:" << std::endl;
-  std::cerr << "  Red X from metadata: " << redX << std::endl;
-  std::cerr << "  Colorspace to set: "
-            << (colorspace == bmdColorspaceRec709 ? "Rec709" : "Rec2020")
-            << std::endl;
-  std::cerr << "  EOTF to set: " << m_hdrMetadata.EOTF
-            << " (1=SDR, 2=PQ, 3=HLG)" << std::endl;
+int decklink_get_stream_stats(DeckLinkHandle handle, StreamStats* stats) {
+  if (!handle || !stats)
+    return -1;
+  auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
+  *stats = signalGen->getStreamStats();
+  return 0;
+}
 
-  // Set colorspace metadata based on determined primaries
-  result = metadataExt->SetInt(bmdDeckLinkFrameMetadataColorspace, colorspace);
-  std::cerr << "  SetInt colorspace result: "
-            << (result == S_OK ? "OK" : "FAILED") << std::endl;
-  if (result != S_OK) {
-    std::cerr
-        << "[DeckLink] Warning: Failed to set colorspace metadata (HRESULT: 0x"
-        << std::hex << result << std::dec << ")" << std::endl;
-  }
+int decklink_start_recording(DeckLinkHandle handle,
+                             const char* path,
+                             const RecorderConfig* config) {
+  if (!handle || !path || !config)
+    return -1;
+  auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
+  return signalGen->startRecording(path, *config);
+}
 
-  // Set EOTF metadata
-  result =
-      metadataExt->SetInt(bmdDeckLinkFrameMetadataHDRElectroOpticalTransferFunc,
-                          m_hdrMetadata.EOTF);
-  std::cerr << "  SetInt EOTF result: " << (result == S_OK ? "OK" : "FAILED")
-            << std::endl;
-  if (result != S_OK) {
-    std::cerr << "[DeckLink] Warning: Failed to set EOTF metadata (HRESULT: 0x"
-              << std::hex << result << std::dec << ")" << std::endl;
-  }
-
-  // Only apply full HDR primaries/luminance metadata for PQ (EOTF = 2) or HLG
-  // (EOTF = 3)
-  if (m_hdrMetadata.EOTF == 2 || m_hdrMetadata.EOTF == 3) {
-    // Set the HDR metadata flag
-    BMDFrameFlags currentFlags = m_frame->GetFlags();
-    m_frame->SetFlags(currentFlags | bmdFrameContainsHDRMetadata);
-
-    // Set display primaries
-    metadataExt->SetFloat(bmdDeckLinkFrameMetadataHDRDisplayPrimariesRedX,
-                          m_hdrMetadata.referencePrimaries.RedX);
-    metadataExt->SetFloat(bmdDeckLinkFrameMetadataHDRDisplayPrimariesRedY,
-                          m_hdrMetadata.referencePrimaries.RedY);
-    metadataExt->SetFloat(bmdDeckLinkFrameMetadataHDRDisplayPrimariesGreenX,
-                          m_hdrMetadata.referencePrimaries.GreenX);
-    metadataExt->SetFloat(bmdDeckLinkFrameMetadataHDRDisplayPrimariesGreenY,
-                          m_hdrMetadata.referencePrimaries.GreenY);
-    metadataExt->SetFloat(bmdDeckLinkFrameMetadataHDRDisplayPrimariesBlueX,
-                          m_hdrMetadata.referencePrimaries.BlueX);
-    metadataExt->SetFloat(bmdDeckLinkFrameMetadataHDRDisplayPrimariesBlueY,
-                          m_hdrMetadata.referencePrimaries.BlueY);
-
-    // Set white point and luminance values
-    metadataExt->SetFloat(bmdDeckLinkFrameMetadataHDRWhitePointX,
-                          m_hdrMetadata.referencePrimaries.WhiteX);
-    metadataExt->SetFloat(bmdDeckLinkFrameMetadataHDRWhitePointY,
-                          m_hdrMetadata.referencePrimaries.WhiteY);
-    metadataExt->SetFloat(
-        bmdDeckLinkFrameMetadataHDRMaxDisplayMasteringLuminance,
-        m_hdrMetadata.maxDisplayMasteringLuminance);
-    metadataExt->SetFloat(
-        bmdDeckLinkFrameMetadataHDRMinDisplayMasteringLuminance,
-        m_hdrMetadata.minDisplayMasteringLuminance);
-    metadataExt->SetFloat(bmdDeckLinkFrameMetadataHDRMaximumContentLightLevel,
-                          m_hdrMetadata.maxCLL);
-    metadataExt->SetFloat(
-        bmdDeckLinkFrameMetadataHDRMaximumFrameAverageLightLevel,
-        m_hdrMetadata.maxFALL);
-  } else {
-    // Remove HDR metadata flag for SDR EOTF
-    BMDFrameFlags currentFlags = m_frame->GetFlags();
-    m_frame->SetFlags(currentFlags & ~bmdFrameContainsHDRMetadata);
-  }
+int decklink_stop_recording(DeckLinkHandle handle) {
+  if (!handle)
+    return -1;
+  auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
+  return signalGen->stopRecording();
+}
 
-  metadataExt->Release();
+int decklink_get_recorder_stats(DeckLinkHandle handle, RecorderStats* stats) {
+  if (!handle || !stats)
+    return -1;
+  auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
+  *stats = signalGen->getRecorderStats();
   return 0;
 }
 
-// Thin C wrapper implementation
-extern "C" {
+int decklink_play_recording(DeckLinkHandle handle, const char* path) {
+  if (!handle || !path)
+    return -1;
+  auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
+  return signalGen->playRecording(path);
+}
 
-int decklink_set_frame_data(DeckLinkHandle handle,
-                            const uint16_t* data,
-                            int width,
-                            int height) {
-  if (!handle || !data)
+int decklink_stop_replay(DeckLinkHandle handle) {
+  if (!handle)
     return -1;
   auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
-  return signalGen->setFrameData(data, width, height);
+  return signalGen->stopReplay();
 }
 
-int decklink_get_device_count() {
-  return DeckLinkSignalGen::getDeviceCount();
+int decklink_get_replay_stats(DeckLinkHandle handle,
+                              ClipPlaybackStats* stats) {
+  if (!handle || !stats)
+    return -1;
+  auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
+  *stats = signalGen->getReplayStats();
+  return 0;
 }
 
-int decklink_get_device_name_by_index(int index, char* name, int name_size) {
-  if (!name || name_size <= 0)
+RecorderHandle decklink_recorder_create() {
+  return new FrameRecorder();
+}
+
+void decklink_recorder_destroy(RecorderHandle recorder) {
+  delete static_cast<FrameRecorder*>(recorder);
+}
+
+int decklink_recorder_start(RecorderHandle recorder,
+                            const char* path,
+                            const RecorderConfig* config,
+                            int64_t max_frame_bytes,
+                            uint32_t display_mode,
+                            uint32_t pixel_format,
+                            int64_t frame_interval_ns) {
+  if (!recorder || !config)
     return -1;
+  auto* frameRecorder = static_cast<FrameRecorder*>(recorder);
+  return frameRecorder->start(
+      path, *config, max_frame_bytes,
+      recording_header(display_mode, pixel_format, frame_interval_ns));
+}
 
-  std::string deviceName = DeckLinkSignalGen::getDeviceName(index);
-  if (deviceName.empty())
+int decklink_recorder_record(RecorderHandle recorder,
+                             const void* data,
+                             const RecordedFrame* frame) {
+  if (!recorder || !data || !frame || frame->frameBytes <= 0)
     return -1;
+  auto* frameRecorder = static_cast<FrameRecorder*>(recorder);
+  frameRecorder->record(data, *frame);
+  return 0;
+}
 
-  strncpy(name, deviceName.c_str(), name_size - 1);
-  name[name_size - 1] = '\0';
+int decklink_recorder_stop(RecorderHandle recorder) {
+  if (!recorder)
+    return -1;
+  static_cast<FrameRecorder*>(recorder)->stop();
   return 0;
 }
 
-DeckLinkHandle decklink_open_output_by_index(int index) {
-  DeckLinkSignalGen* signalGen = new DeckLinkSignalGen();
+int decklink_recorder_get_stats(RecorderHandle recorder,
+                                RecorderStats* stats) {
+  if (!recorder || !stats)
+    return -1;
+  *stats = static_cast<FrameRecorder*>(recorder)->stats();
+  return 0;
+}
 
-  // Open the device
-  IDeckLinkIterator* iterator = CreateDeckLinkIteratorInstance();
-  if (!iterator) {
-    delete signalGen;
-    return nullptr;
-  }
+int decklink_plan_replay(const char* path,
+                         uint32_t pixel_format,
+                         int64_t frame_interval_ns,
+                         int32_t* frames,
+                         uint16_t* sequence,
+                         int max_count) {
+  if (!frames || max_count < 0 || (max_count > 0 && !sequence))
+    return -1;
+  std::vector<ReplayBuffer*> buffers;
+  std::vector<uint16_t> planned;
+  size_t recorded = 0;
+  const int err = planReplay(path, pixel_format, frame_interval_ns, &buffers,
+                             &planned, &recorded);
+  if (err)
+    return err;
+  *frames = static_cast<int32_t>(buffers.size());
+  for (ReplayBuffer* buffer : buffers)
+    releaseReplayBuffer(buffer);
+  const size_t count =
+      std::min(planned.size(), static_cast<size_t>(max_count));
+  std::copy(planned.begin(), planned.begin() + count, sequence);
+  return static_cast<int>(planned.size());
+}
 
-  IDeckLink* device = nullptr;
-  int current = 0;
-  while (iterator->Next(&device) == S_OK) {
-    if (current == index) {
-      IDeckLinkOutput* output = nullptr;
-      IDeckLinkConfiguration* configuration = nullptr;
+int decklink_display_external_frame(DeckLinkHandle handle,
+                                    const ExternalFrameDesc* desc,
+                                    ExternalReleaseFn release,
+                                    void* context) {
+  if (!handle || !desc)
+    return -1;
+  auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
+  return signalGen->displayExternalFrame(*desc, release, context);
+}
 
-      if (device->QueryInterface(IID_IDeckLinkOutput, (void**)&output) ==
-          S_OK) {
-        // Also get the configuration interface for SDI output control
-        if (device->QueryInterface(IID_IDeckLinkConfiguration,
-                                   (void**)&configuration) == S_OK) {
-          signalGen->m_device = device;
-          signalGen->m_output = output;
-          signalGen->m_configuration = configuration;
-          iterator->Release();
-          return signalGen;
-        } else {
-          std::cerr << "[DeckLink] Warning: Could not get configuration "
-                       "interface for device "
-                    << index << std::endl;
-          // Still proceed without configuration interface
-          signalGen->m_device = device;
-          signalGen->m_output = output;
-          signalGen->m_configuration = nullptr;
-          iterator->Release();
-          return signalGen;
-        }
-      }
-      device->Release();
-      break;
-    }
-    device->Release();
-    current++;
-  }
-  iterator->Release();
-  delete signalGen;
-  return nullptr;
+int decklink_schedule_external_frame(DeckLinkHandle handle,
+                                     const ExternalFrameDesc* desc,
+                                     ExternalReleaseFn release,
+                                     void* context,
+                                     int64_t target_ns,
+                                     int32_t duration_frames,
+                                     SchedulerDecisionRecord* record) {
+  if (!handle || !desc)
+    return -1;
+  auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
+  return signalGen->scheduleExternalFrame(*desc, release, context, target_ns,
+                                          duration_frames, 0, record);
 }
 
-void decklink_close(DeckLinkHandle handle) {
-  if (handle) {
-    auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
-    delete signalGen;
-  }
+int decklink_schedule_external_frame_hdr(DeckLinkHandle handle,
+                                         const ExternalFrameDesc* desc,
+                                         ExternalReleaseFn release,
+                                         void* context,
+                                         int64_t target_ns,
+                                         int32_t duration_frames,
+                                         int32_t hdr_metadata_id,
+                                         SchedulerDecisionRecord* record) {
+  if (!handle || !desc)
+    return -1;
+  auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
+  return signalGen->scheduleExternalFrame(*desc, release, context, target_ns,
+                                          duration_frames, hdr_metadata_id,
+                                          record);
 }
 
-int decklink_start_output(DeckLinkHandle handle) {
+int decklink_cache_frame(DeckLinkHandle handle,
+                         int64_t key,
+                         const uint16_t* data,
+                         int width,
+                         int height) {
   if (!handle)
     return -1;
   auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
-  return signalGen->startOutput();
+  return signalGen->cacheFrame(key, data, width, height);
 }
 
-int decklink_start_output_with_mode(DeckLinkHandle handle,
-                                    uint32_t display_mode) {
-  if (!handle)
+int decklink_cache_packed_frame(DeckLinkHandle handle,
+                                int64_t key,
+                                const ExternalFrameDesc* desc) {
+  if (!handle || !desc)
     return -1;
   auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
-  return signalGen->startOutput(static_cast<BMDDisplayMode>(display_mode));
+  return signalGen->cachePackedFrame(key, *desc);
 }
 
-int decklink_stop_output(DeckLinkHandle handle) {
+int decklink_display_cached_frame(DeckLinkHandle handle, int64_t key) {
   if (!handle)
     return -1;
   auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
-  return signalGen->stopOutput();
+  return signalGen->displayCachedFrame(key);
 }
 
-int decklink_create_frame_from_data(DeckLinkHandle handle) {
+int decklink_schedule_cached_frame(DeckLinkHandle handle,
+                                   int64_t key,
+                                   int64_t target_ns,
+                                   int32_t duration_frames,
+                                   SchedulerDecisionRecord* record) {
   if (!handle)
     return -1;
   auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
-  return signalGen->createFrame();
+  return signalGen->scheduleCachedFrame(key, target_ns, duration_frames, 0,
+                                        record);
 }
 
-uint32_t decklink_get_pixel_format(DeckLinkHandle handle) {
+int decklink_schedule_cached_frame_hdr(DeckLinkHandle handle,
+                                       int64_t key,
+                                       int64_t target_ns,
+                                       int32_t duration_frames,
+                                       int32_t hdr_metadata_id,
+                                       SchedulerDecisionRecord* record) {
   if (!handle)
-    return 0;
+    return -1;
   auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
-  return static_cast<uint32_t>(signalGen->getPixelFormat());
+  return signalGen->scheduleCachedFrame(key, target_ns, duration_frames,
+                                        hdr_metadata_id, record);
 }
 
-int decklink_set_pixel_format(DeckLinkHandle handle,
-                              uint32_t pixel_format_code) {
+int decklink_remove_cached_frame(DeckLinkHandle handle, int64_t key) {
   if (!handle)
     return -1;
   auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
-  return signalGen->setPixelFormat(
-      static_cast<BMDPixelFormat>(pixel_format_code));
+  return signalGen->removeCachedFrame(key);
 }
 
-int decklink_get_supported_pixel_format_count(DeckLinkHandle handle) {
+int decklink_clear_frame_cache(DeckLinkHandle handle) {
   if (!handle)
-    return 0;
+    return -1;
   auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
-  signalGen->cacheSupportedFormats();
-  return static_cast<int>(signalGen->getSupportedFormats().size());
+  signalGen->clearFrameCache();
+  return 0;
 }
 
-int decklink_get_supported_pixel_format_name(DeckLinkHandle handle,
-                                             int index,
-                                             char* name,
-                                             int name_size) {
-  if (!handle || !name || name_size <= 0)
+int decklink_set_frame_cache_hot_frames(DeckLinkHandle handle, int capacity) {
+  if (!handle)
     return -1;
   auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
+  return signalGen->setFrameCacheHotFrames(capacity);
+}
 
-  signalGen->cacheSupportedFormats();
-  if (index < 0 ||
-      index >= static_cast<int>(signalGen->getSupportedFormats().size()))
+int decklink_get_frame_cache_stats(DeckLinkHandle handle,
+                                   FrameCacheStats* stats) {
+  if (!handle || !stats)
     return -1;
+  auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
+  *stats = signalGen->getFrameCacheStats();
+  return 0;
+}
 
-  BMDPixelFormat format = signalGen->getSupportedFormats()[index];
-  std::string fmtChars = fourCharCode(static_cast<int>(format));
-  std::string formatName;
-
-  switch (format) {
-    case bmdFormat8BitYUV:
-      formatName = std::string("8Bit YUV (") + fmtChars + ")";
-      break;
-    case bmdFormat10BitYUV:
-      formatName = std::string("10Bit YUV (") + fmtChars + ")";
-      break;
-    case bmdFormat10BitYUVA:
-      formatName = std::string("10Bit YUVA (") + fmtChars + ")";
-      break;
-
-    case bmdFormat8BitARGB:
-      formatName = std::string("8Bit ARGB (") + std::to_string(format) + ")";
-      break;
-    case bmdFormat8BitBGRA:
-      formatName = std::string("8Bit BGRA (") + fmtChars + ")";
-      break;
-
-    case bmdFormat10BitRGB:
-      formatName = std::string("10Bit RGB (") + fmtChars + ")";
-      break;
-    case bmdFormat12BitRGB:
-      formatName = std::string("12Bit RGB (") + fmtChars + ")";
-      break;
-    case bmdFormat12BitRGBLE:
-      formatName = std::string("12Bit RGB LE (") + fmtChars + ")";
-      break;
+int decklink_set_placement(DeckLinkHandle handle,
+                           const PlacementConfig* config) {
+  if (!handle || !config)
+    return -1;
+  auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
+  return signalGen->setPlacement(*config);
+}
 
-    case bmdFormat10BitRGBXLE:
-      formatName = std::string("10Bit RGBX LE (") + fmtChars + ")";
-      break;
-    case bmdFormat10BitRGBX:
-      formatName = std::string("10Bit RGBX (") + fmtChars + ")";
-      break;
+int decklink_get_placement(DeckLinkHandle handle, PlacementConfig* config) {
+  if (!handle || !config)
+    return -1;
+  auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
+  *config = signalGen->getPlacement();
+  return 0;
+}
 
-    default:
-      formatName = std::string("Unknown (") + fmtChars + ")";
-      break;
-  }
+int decklink_set_frame_stats(DeckLinkHandle handle, int mode) {
+  if (!handle)
+    return -1;
+  auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
+  return signalGen->setFrameStatsMode(mode);
+}
 
-  strncpy(name, formatName.c_str(), name_size - 1);
-  name[name_size - 1] = '\0';
+int decklink_get_frame_stats(DeckLinkHandle handle, FrameStats* stats) {
+  if (!handle || !stats)
+    return -1;
+  auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
+  *stats = signalGen->getFrameStats();
   return 0;
 }
 
-// Version info
-const char* decklink_get_driver_version() {
-  static std::string version;
-  if (!version.empty())
-    return version.c_str();
-  IDeckLinkAPIInformation* apiInfo = CreateDeckLinkAPIInformationInstance();
-  if (apiInfo) {
-    int64_t versionInt = 0;
-    if (apiInfo->GetInt(BMDDeckLinkAPIVersion, &versionInt) == S_OK) {
-      int major = (versionInt >> 24) & 0xFF;
-      int minor = (versionInt >> 16) & 0xFF;
-      int patch = (versionInt >> 8) & 0xFF;
-      version = std::format("{}.{}.{}", major, minor, patch);
-    } else {
-      version = "unknown";
-    }
-    apiInfo->Release();
-  } else {
-    version = "unavailable";
-  }
-  return version.c_str();
+int decklink_set_thumbnail_config(DeckLinkHandle handle,
+                                  const ThumbnailConfig* config) {
+  if (!handle || !config)
+    return -1;
+  auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
+  return signalGen->setThumbnailConfig(*config);
 }
 
-const char* decklink_get_sdk_version() {
-  static std::string sdk_version = BLACKMAGIC_DECKLINK_API_VERSION_STRING;
-  return sdk_version.c_str();
+int decklink_get_thumbnail_config(DeckLinkHandle handle,
+                                  ThumbnailConfig* config) {
+  if (!handle || !config)
+    return -1;
+  auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
+  *config = signalGen->getThumbnailConfig();
+  return 0;
 }
 
-// Add new C wrapper function for complete HDR metadata
-int decklink_set_hdr_metadata(DeckLinkHandle handle,
-                              const HDRMetadata* metadata) {
-  if (!handle || !metadata)
+int decklink_get_thumbnail(DeckLinkHandle handle,
+                           uint8_t* rgb,
+                           int capacity,
+                           ThumbnailInfo* info) {
+  if (!handle)
     return -1;
   auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
-  return signalGen->setHDRMetadata(*metadata);
+  return signalGen->getThumbnail(rgb, capacity, info);
 }
 
 // HDR capability detection
@@ -860,6 +3430,18 @@ int decklink_display_frame_sync(DeckLinkHandle handle) {
   return signalGen->displayFrameSync();
 }
 
+int decklink_update_frame_regions(DeckLinkHandle handle,
+                                  const uint16_t* data,
+                                  int width,
+                                  int height,
+                                  const FrameRegion* regions,
+                                  int count) {
+  if (!handle)
+    return -1;
+  auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
+  return signalGen->updateFrameRegions(data, width, height, regions, count);
+}
+
 // Display mode management
 uint32_t decklink_get_display_mode(DeckLinkHandle handle) {
   if (!handle)
@@ -1,12 +1,31 @@
 #pragma once
 
+#include <mutex>
 #include <set>
 #include <string>
 #include <vector>
 #include "DeckLinkAPI.h"
-
-// Handle type for C API
+#include "clip_player.h"
+#include "external_frame.h"
+#include "frame_cache.h"
+#include "frame_placement.h"
+#include "frame_pool.h"
+#include "frame_recorder.h"
+#include "frame_scheduler.h"
+#include "frame_stream.h"
+#include "frame_timing.h"
+#include "hdr_metadata.h"
+#include "memory_stats.h"
+#include "output_pipeline.h"
+#include "overlay.h"
+#include "pack_workers.h"
+#include "thread_policy.h"
+#include "thumbnail.h"
+#include "trace.h"
+
+// Handle types for C API
 typedef void* DeckLinkHandle;
+typedef void* RecorderHandle;
 
 // Wrapper definitions for versioned symbols
 extern "C" {
@@ -27,25 +46,86 @@ IDeckLinkAPIInformation* CreateDeckLinkAPIInformationInstance_0001(void);
 #define DECKLINK_ERROR_OUTPUT_FAILED -3
 #define DECKLINK_ERROR_FRAME_FAILED -4
 
-// Complete HDR metadata structure (matching SignalGenHDR sample)
-struct Gamut_Chromaticities {
-  double RedX;
-  double RedY;
-  double GreenX;
-  double GreenY;
-  double BlueX;
-  double BlueY;
-  double WhiteX;
-  double WhiteY;
+// Requested output configuration for reconfigure(). Zero pixelFormat or
+// displayMode keeps the active value; applyHDR selects whether hdrMetadata is
+// part of the request.
+struct OutputConfig {
+  uint32_t pixelFormat;
+  uint32_t displayMode;
+  int32_t applyHDR;
+  HDRMetadata hdrMetadata;
+};
+
+// What the most recent reconfigure() call actually had to do
+struct ReconfigureStats {
+  int32_t pixelFormatChanged;
+  int32_t displayModeChanged;
+  int32_t hdrChanged;
+  int32_t sdiLinkChanged;
+  int32_t setFlagCalls;
+  int32_t enableCycles;
+  int32_t framesRepresented;
+  int64_t reenableLatencyUs;  // DisableVideoOutput until output shows a frame
+  int64_t totalLatencyUs;
+};
+
+// Temporal dithering (FRC) request. target holds fractional code values in
+// the active pixel format's bit depth; a zero roiWidth or roiHeight dithers
+// the whole frame.
+struct FrcConfig {
+  double target[3];
+  int32_t roiX;
+  int32_t roiY;
+  int32_t roiWidth;
+  int32_t roiHeight;
+  int32_t cycleFrames;  // Frames per dither cycle, 1-64
+};
+
+// Levels actually produced: each channel shows low + 1 for dutyFrames of
+// every cycleFrames frames
+struct FrcStatus {
+  ClipPlaybackStats playback;
+  double achieved[3];
+  int32_t low[3];
+  int32_t dutyFrames[3];
+  int32_t cycleFrames;
 };
 
-struct HDRMetadata {
-  int64_t EOTF;
-  Gamut_Chromaticities referencePrimaries;
-  double maxDisplayMasteringLuminance;
-  double minDisplayMasteringLuminance;
+// Statistics of the most recently packed frame, gathered in the packing pass.
+// Means, extremes and clip counts are code values of the active pixel format
+// and apl is luma as a percentage of maxCode. maxCLL and maxFALL (nits) are
+// only computed when the transfer function is PQ and assume full-range code
+// values.
+struct FrameStats {
+  int32_t valid;
+  int32_t maxCode;
+  int32_t width;
+  int32_t height;
+  int64_t frames;  // Frames analysed since statistics were last enabled
+  double mean[3];
+  int32_t min[3];
+  int32_t max[3];
+  int64_t clipped[3];     // Samples above maxCode, clamped when packed
+  int64_t clippedPixels;  // Pixels with at least one clipped sample
+  double apl;
   double maxCLL;
   double maxFALL;
+  int32_t pq;
+  int32_t autoMetadata;  // maxCLL/maxFALL were copied into the HDR metadata
+};
+
+enum FrameStatsMode : int32_t {
+  kFrameStatsOff = 0,
+  kFrameStatsOn = 1,
+  kFrameStatsAutoMetadata = 2,  // Also sets MaxCLL/MaxFALL from each frame
+};
+
+// Rectangle of the source frame changed by updateFrameRegions()
+struct FrameRegion {
+  int32_t x;
+  int32_t y;
+  int32_t width;
+  int32_t height;
 };
 
 // C++ Implementation Class
@@ -74,8 +154,156 @@ class DeckLinkSignalGen {
   // Complete HDR metadata management
   int setHDRMetadata(const HDRMetadata& metadata);
 
+  // Pack cost of a pixel format at the active display mode's dimensions
+  int benchmarkPack(BMDPixelFormat pixelFormat,
+                    int iterations,
+                    double* nsPerFrame);
+
+  // In-place reconfiguration: applies only what differs from the active state
+  int reconfigure(const OutputConfig& config);
+  const ReconfigureStats& getReconfigureStats() const {
+    return m_reconfigureStats;
+  }
+
+  // Thread placement / real-time scheduling. setThreadPolicy() starts the
+  // packing workers; applyOutputThreadPolicy() must run on the thread that
+  // drives output.
+  int setThreadPolicy(const ThreadPolicyConfig& config);
+  int applyOutputThreadPolicy();
+  ThreadPolicyStatus getThreadPolicyStatus() const;
+
   // Frame data management
   int setFrameData(const uint16_t* data, int width, int height);
+  // Copies @p regions of @p data into the current frame and re-displays it,
+  // repacking only the output rows they affect
+  int updateFrameRegions(const uint16_t* data,
+                         int width,
+                         int height,
+                         const FrameRegion* regions,
+                         int count);
+
+  // Interned HDR metadata for individual scheduled frames: the schedule*()
+  // calls take an id from internHDRMetadata(), 0 for the current metadata
+  int internHDRMetadata(const HDRMetadata& metadata) {
+    return m_hdrTable.intern(metadata);
+  }
+  void clearHDRMetadataTable() { m_hdrTable.clear(); }
+  HDRMetadataTableStats getHDRMetadataTableStats() const {
+    return m_hdrTable.stats();
+  }
+
+  // Inter-frame interval / latency analysis (always on)
+  FrameTimingAnalyzer& getFrameTiming() { return m_frameTiming; }
+
+  // Overlays composited into the packed frame. updateOverlays() re-displays
+  // the last frame with the current overlays without repacking it.
+  OverlayCompositor& getOverlays() {
+    m_pipeline.flush();
+    return m_overlays;
+  }
+  int updateOverlays();
+
+  // Temporal dithering: the constituent frames are packed once and looped
+  // with scheduled playback until stopFrc() or the next displayFrameSync()
+  int startFrc(const FrcConfig& config);
+  int stopFrc();
+  FrcStatus getFrcStatus() const;
+
+  // Pipelined output: submitFrame() queues a frame and returns while a pack
+  // thread and a display thread overlap packing with DisplayVideoFrameSync.
+  // Every other frame operation first waits for the pipeline to drain.
+  int setPipelinedOutput(bool enabled);
+  int submitFrame(const uint16_t* data, int width, int height);
+  int flushOutput();
+  PipelineStats getPipelineStats() const { return m_pipeline.stats(); }
+
+  // Deadline-aware scheduled output: scheduleFrame() packs a frame for the
+  // slot at or after targetNs on the scheduled stream clock, or drops it
+  // (reported in record) if that slot cannot be met
+  int startScheduler(const SchedulerConfig& config);
+  int stopScheduler() { return m_scheduler.stop(); }
+  int scheduleFrame(const uint16_t* data,
+                    int width,
+                    int height,
+                    int64_t targetNs,
+                    int32_t durationFrames,
+                    int32_t hdrMetadataId,
+                    SchedulerDecisionRecord* record);
+  SchedulerStats getSchedulerStats() const { return m_scheduler.stats(); }
+  int getSchedulerDecisions(SchedulerDecisionRecord* out, int maxCount) const {
+    return m_scheduler.decisions(out, maxCount);
+  }
+  int getSchedulerLeadChanges(SchedulerLeadChange* out, int maxCount) const {
+    return m_scheduler.leadChanges(out, maxCount);
+  }
+
+  // Raw frame stream input: frames are read from config.fd and displayed at
+  // the display rate without passing through the caller
+  int startStream(const StreamConfig& config);
+  int stopStream() {
+    m_stream.stop();
+    return 0;
+  }
+  StreamStats getStreamStats() const { return m_stream.stats(); }
+
+  // Recording of every packed frame leaving the library, with its
+  // telemetry, and looped replay of a recording through the clip player
+  int startRecording(const char* path, const RecorderConfig& config);
+  int stopRecording() {
+    m_recorder.stop();
+    return 0;
+  }
+  RecorderStats getRecorderStats() const { return m_recorder.stats(); }
+  int playRecording(const char* path);
+  int stopReplay() { return m_clipPlayer.stop(); }
+  ClipPlaybackStats getReplayStats() const { return m_clipPlayer.stats(); }
+
+  // Caller-owned, already packed frames shown without a copy; release runs
+  // once the memory is no longer referenced (for a displayed frame, after
+  // the next frame replaces it)
+  int displayExternalFrame(const ExternalFrameDesc& desc,
+                           ExternalReleaseFn release,
+                           void* context);
+  int scheduleExternalFrame(const ExternalFrameDesc& desc,
+                            ExternalReleaseFn release,
+                            void* context,
+                            int64_t targetNs,
+                            int32_t durationFrames,
+                            int32_t hdrMetadataId,
+                            SchedulerDecisionRecord* record);
+
+  // Packed frame cache: patterns are packed once, kept compressed and
+  // recalled by key without repacking. Overlays and HDR metadata are applied
+  // when a cached frame is shown, not when it is stored.
+  int cacheFrame(int64_t key, const uint16_t* data, int width, int height);
+  int cachePackedFrame(int64_t key, const ExternalFrameDesc& desc);
+  int displayCachedFrame(int64_t key);
+  int scheduleCachedFrame(int64_t key,
+                          int64_t targetNs,
+                          int32_t durationFrames,
+                          int32_t hdrMetadataId,
+                          SchedulerDecisionRecord* record);
+  int removeCachedFrame(int64_t key) { return m_frameCache.remove(key); }
+  void clearFrameCache();
+  int setFrameCacheHotFrames(int capacity) {
+    return m_frameCache.setHotCapacity(capacity);
+  }
+  FrameCacheStats getFrameCacheStats() const { return m_frameCache.stats(); }
+
+  // Placement of RGB frames on the output raster (scale, crop, letterbox),
+  // applied while packing from the next frame on. Off by default: frames go
+  // out at the size they are given.
+  int setPlacement(const PlacementConfig& config);
+  PlacementConfig getPlacement() const;
+
+  // Per-frame statistics computed while packing (on by default)
+  int setFrameStatsMode(int mode);
+  FrameStats getFrameStats() const;
+
+  // Monitoring thumbnail of the output (on by default)
+  int setThumbnailConfig(const ThumbnailConfig& config);
+  ThumbnailConfig getThumbnailConfig() const;
+  int getThumbnail(uint8_t* rgb, int capacity, ThumbnailInfo* info) const;
 
   // Device enumeration (static)
   static int getDeviceCount();
@@ -83,7 +311,7 @@ class DeckLinkSignalGen {
 
   // Public access for C wrapper
   void cacheSupportedFormats();
-  std::vector<BMDPixelFormat>& getSupportedFormats() {
+  TrackedVector<BMDPixelFormat, kMemoryCaches>& getSupportedFormats() {
     return m_supportedFormats;
   }
 
@@ -95,24 +323,153 @@ class DeckLinkSignalGen {
   BMDDisplayMode m_displayMode;
 
  private:
-  // Configuration
+  // Configuration: m_width x m_height is the raster last sent, the pending
+  // frame data is m_sourceWidth x m_sourceHeight before placement
   int m_width;
   int m_height;
+  int m_sourceWidth;
+  int m_sourceHeight;
   bool m_outputEnabled;
   BMDPixelFormat m_pixelFormat;
 
-  // Complete HDR metadata
+  // Complete HDR metadata and the provider frames carry for it (rebuilt
+  // when it changes), both guarded by m_hdrMutex since pack and display
+  // threads read them while callers set them; and interned per-frame
+  // metadata
+  mutable std::mutex m_hdrMutex;
   HDRMetadata m_hdrMetadata;
+  HDRMetadataProvider* m_hdrProvider;
+  HDRMetadataTable m_hdrTable;
 
   // Cached supported formats
-  std::vector<BMDPixelFormat> m_supportedFormats;
+  TrackedVector<BMDPixelFormat, kMemoryCaches> m_supportedFormats;
   bool m_formatsCached;
 
   // Pending frame data
-  std::vector<uint16_t> m_pendingFrameData;
+  TrackedVector<uint16_t, kMemoryPendingInput> m_pendingFrameData;
+
+  // SDI 4:4:4 link state last written to the device (-1 = unknown)
+  int m_applied444;
+
+  // Outcome of the last reconfigure() call
+  ReconfigureStats m_reconfigureStats;
+
+  // Preallocated frame buffers and packing threads
+  FramePool m_framePool;
+  PackWorkerPool m_packWorkers;
+  ThreadPolicyConfig m_threadPolicy;
+  ThreadPolicyStatus m_threadPolicyStatus;
+
+  // Frame timing, reset whenever the display mode (nominal interval) changes
+  FrameTimingAnalyzer m_frameTiming;
+  BMDDisplayMode m_timingDisplayMode;
+
+  // Overlays and the last packed frame without them (valid while
+  // m_packedBaseValid); m_frameBytes points into m_frame's buffer
+  OverlayCompositor m_overlays;
+  TrackedVector<uint8_t, kMemoryCaches> m_packedBase;
+  bool m_packedBaseValid;
+  void* m_frameBytes;
+  PlacementScratch m_regionScratch;
+
+  // Temporal dithering frames and their playback
+  FramePool m_clipPool;
+  ClipPlayer m_clipPlayer;
+  FrcStatus m_frcStatus;
+
+  // Pack and display threads of pipelined output
+  OutputPipeline m_pipeline;
+
+  // Deadline-scheduled frames and the queue handing them to the SDK
+  FramePool m_schedulerPool;
+  int m_schedulerPoolFrames;
+  FrameScheduler m_scheduler;
+
+  // Frames read from a file descriptor and their RGB48 read buffer
+  FramePool m_streamPool;
+  TrackedVector<uint16_t, kMemoryPendingInput> m_streamInput;
+  FrameStreamReader m_stream;
+
+  // Statistics of the last packed frame, which the pipeline and stream
+  // threads also write, and the PQ light level of each code value
+  int m_frameStatsMode;
+  mutable std::mutex m_frameStatsMutex;
+  FrameStats m_frameStats;
+  TrackedVector<float, kMemoryCaches> m_nitsTable;
+  BMDPixelFormat m_nitsTableFormat;
+
+  // Preview of the last frame to leave the library, with overlays, and the
+  // recording of every such frame
+  FrameThumbnail m_thumbnail;
+  FrameRecorder m_recorder;
+
+  // Cached packed patterns and the buffer new entries are packed into
+  FrameCache m_frameCache;
+  TrackedVector<uint32_t, kMemoryPackScratch> m_cacheInput;
+  PlacementScratch m_cacheScratch;
+
+  // Placement of RGB frames, read by the pack and stream threads
+  mutable std::mutex m_placementMutex;
+  PlacementConfig m_placement;
 
   // Private helper methods
-  int applyHDRMetadata();
+  int finishFrame(void* frameData);
+  int wrapExternalFrame(const ExternalFrameDesc& desc,
+                        ExternalReleaseFn release,
+                        void* context,
+                        IDeckLinkMutableVideoFrame** frame);
+  // Thumbnail, HDR metadata and recording of a wrapped external frame that
+  // is about to be output
+  void prepareExternalFrame(const ExternalFrameDesc& desc,
+                            bool force,
+                            HDRMetadataProvider* metadata,
+                            IDeckLinkMutableVideoFrame* frame);
+  // @p force bypasses the capture interval (one-off synchronous frames)
+  void captureThumbnail(const void* frameData,
+                        int width,
+                        int height,
+                        int32_t rowBytes,
+                        bool force);
+  // Hands a frame leaving the library to the recorder, once its metadata
+  // is applied; @p metadata as given to applyFrameMetadata()
+  void recordFrame(const void* frameData,
+                   int width,
+                   int height,
+                   int32_t rowBytes,
+                   RecordedSource source,
+                   HDRMetadataProvider* metadata = nullptr);
+  int resolvePlacement(int sourceWidth, int sourceHeight, PlacementMap* map);
+  int packFrame(void* frameData,
+                const uint16_t* data,
+                const PlacementMap& map,
+                int32_t rowBytes);
+  void recordFrameStats(const PixelStats& stats,
+                        int width,
+                        int height,
+                        int64_t eotf);
+  int64_t hdrEOTF() const;
+  void stopBackgroundOutput();
+  int packIntoPool(FramePool& pool,
+                   int capacity,
+                   const uint16_t* data,
+                   const PlacementMap& map,
+                   bool keepBase,
+                   PipelineFrame* out,
+                   HDRMetadataProvider* metadata = nullptr);
+  int packPipelined(PipelineInput& data,
+                    int width,
+                    int height,
+                    PipelineFrame* out);
+  int displayPipelined(const PipelineFrame& frame, bool continuous = false);
+  int64_t nominalFrameIntervalNs() const;
+  bool getFrameRate(BMDTimeValue* frameDuration, BMDTimeScale* timeScale) const;
+  bool isModeSupported(BMDDisplayMode displayMode,
+                       BMDPixelFormat pixelFormat) const;
+  int configureSDILink(BMDPixelFormat pixelFormat, int32_t* setFlagCalls);
+  void restoreOutput(ReconfigureStats* stats);
+  // @p metadata overrides the current HDR metadata
+  void applyFrameMetadata(IDeckLinkMutableVideoFrame* frame,
+                          HDRMetadataProvider* metadata = nullptr);
   void logFrameInfo(const char* context);
 };
 
@@ -151,6 +508,228 @@ uint32_t decklink_get_pixel_format(DeckLinkHandle handle);
 // Complete HDR metadata control
 int decklink_set_hdr_metadata(DeckLinkHandle handle,
                               const HDRMetadata* metadata);
+int decklink_intern_hdr_metadata(DeckLinkHandle handle,
+                                 const HDRMetadata* metadata);
+int decklink_clear_hdr_metadata_table(DeckLinkHandle handle);
+int decklink_get_hdr_metadata_table_stats(DeckLinkHandle handle,
+                                          HDRMetadataTableStats* stats);
+
+// Pixel format pack cost benchmark
+int decklink_benchmark_pixel_format(DeckLinkHandle handle,
+                                    uint32_t pixel_format_code,
+                                    int iterations,
+                                    double* ns_per_frame);
+
+// In-place reconfiguration
+int decklink_reconfigure(DeckLinkHandle handle, const OutputConfig* config);
+int decklink_get_reconfigure_stats(DeckLinkHandle handle,
+                                   ReconfigureStats* stats);
+
+// Thread placement and real-time scheduling
+int decklink_set_thread_policy(DeckLinkHandle handle,
+                               const ThreadPolicyConfig* config);
+int decklink_apply_output_thread_policy(DeckLinkHandle handle);
+int decklink_get_thread_policy_status(DeckLinkHandle handle,
+                                      ThreadPolicyStatus* status);
+
+// Frame timing analysis
+int decklink_get_frame_timing_report(DeckLinkHandle handle,
+                                     FrameTimingReport* report);
+int decklink_get_frame_timing_outliers(DeckLinkHandle handle,
+                                       FrameTimingOutlier* outliers,
+                                       int max_count);
+
+int decklink_reset_frame_timing(DeckLinkHandle handle);
+int decklink_set_frame_timing_threshold(DeckLinkHandle handle,
+                                        double threshold);
+
+// Per-subsystem memory accounting (process-wide); get returns the number of
+// MemorySubsystem entries copied
+int decklink_get_memory_stats(MemoryStats* stats, int max_count);
+int decklink_reset_memory_peaks();
+
+// Span tracing of the frame path (process-wide). Spans recorded on a thread
+// belong to the frame id last set there; collect and threads return the
+// number of entries copied.
+int decklink_trace_set_enabled(bool enabled);
+int64_t decklink_trace_now_ns();
+int decklink_trace_set_frame(int64_t frame_id);
+int decklink_trace_collect(TraceSpan* spans, int max_count);
+int decklink_trace_get_threads(TraceThread* threads, int max_count);
+int decklink_trace_get_stats(TraceStats* stats);
+
+// Packed-domain overlays
+int decklink_add_overlay(DeckLinkHandle handle,
+                         int x,
+                         int y,
+                         int width,
+                         int height,
+                         const uint16_t* rgba,
+                         bool enabled);
+int decklink_remove_overlay(DeckLinkHandle handle, int overlay_id);
+int decklink_set_overlay_enabled(DeckLinkHandle handle,
+                                 int overlay_id,
+                                 bool enabled);
+int decklink_move_overlay(DeckLinkHandle handle, int overlay_id, int x, int y);
+int decklink_clear_overlays(DeckLinkHandle handle);
+int decklink_update_overlays(DeckLinkHandle handle);
+
+// Temporal dithering (FRC)
+int decklink_start_frc(DeckLinkHandle handle, const FrcConfig* config);
+int decklink_stop_frc(DeckLinkHandle handle);
+int decklink_get_frc_status(DeckLinkHandle handle, FrcStatus* status);
+// The levels and cycle layout decklink_start_frc would use, without a device;
+// upper receives config->cycleFrames masks of the channels showing low + 1
+int decklink_plan_frc(const FrcConfig* config,
+                      int max_code,
+                      FrcStatus* status,
+                      uint8_t* upper);
+
+// Pipelined (pack-while-display) output
+int decklink_set_pipelined_output(DeckLinkHandle handle, bool enabled);
+int decklink_submit_frame(DeckLinkHandle handle,
+                          const uint16_t* data,
+                          int width,
+                          int height);
+int decklink_flush_output(DeckLinkHandle handle);
+int decklink_get_pipeline_stats(DeckLinkHandle handle, PipelineStats* stats);
+
+// Deadline-aware scheduled output
+int decklink_start_scheduler(DeckLinkHandle handle,
+                             const SchedulerConfig* config);
+int decklink_stop_scheduler(DeckLinkHandle handle);
+int decklink_schedule_frame(DeckLinkHandle handle,
+                            const uint16_t* data,
+                            int width,
+                            int height,
+                            int64_t target_ns,
+                            int32_t duration_frames,
+                            SchedulerDecisionRecord* record);
+int decklink_schedule_frame_hdr(DeckLinkHandle handle,
+                                const uint16_t* data,
+                                int width,
+                                int height,
+                                int64_t target_ns,
+                                int32_t duration_frames,
+                                int32_t hdr_metadata_id,
+                                SchedulerDecisionRecord* record);
+int decklink_get_scheduler_stats(DeckLinkHandle handle,
+                                 SchedulerStats* stats);
+int decklink_get_scheduler_decisions(DeckLinkHandle handle,
+                                     SchedulerDecisionRecord* records,
+                                     int max_count);
+int decklink_get_scheduler_lead_changes(DeckLinkHandle handle,
+                                        SchedulerLeadChange* changes,
+                                        int max_count);
+
+// Raw frame stream input
+int decklink_start_stream(DeckLinkHandle handle, const StreamConfig* config);
+int decklink_stop_stream(DeckLinkHandle handle);
+int decklink_get_stream_stats(DeckLinkHandle handle, StreamStats* stats);
+
+// Recording of the packed output and its replay
+int decklink_start_recording(DeckLinkHandle handle,
+                             const char* path,
+                             const RecorderConfig* config);
+int decklink_stop_recording(DeckLinkHandle handle);
+int decklink_get_recorder_stats(DeckLinkHandle handle, RecorderStats* stats);
+int decklink_play_recording(DeckLinkHandle handle, const char* path);
+int decklink_stop_replay(DeckLinkHandle handle);
+int decklink_get_replay_stats(DeckLinkHandle handle, ClipPlaybackStats* stats);
+
+// The recorder and replay layout without a device, for frames the caller
+// packs. decklink_plan_replay returns the number of sequence entries (up to
+// max_count are copied) or a decklink_play_recording error.
+RecorderHandle decklink_recorder_create();
+void decklink_recorder_destroy(RecorderHandle recorder);
+int decklink_recorder_start(RecorderHandle recorder,
+                            const char* path,
+                            const RecorderConfig* config,
+                            int64_t max_frame_bytes,
+                            uint32_t display_mode,
+                            uint32_t pixel_format,
+                            int64_t frame_interval_ns);
+int decklink_recorder_record(RecorderHandle recorder,
+                             const void* data,
+                             const RecordedFrame* frame);
+int decklink_recorder_stop(RecorderHandle recorder);
+int decklink_recorder_get_stats(RecorderHandle recorder,
+                                RecorderStats* stats);
+int decklink_plan_replay(const char* path,
+                         uint32_t pixel_format,
+                         int64_t frame_interval_ns,
+                         int32_t* frames,
+                         uint16_t* sequence,
+                         int max_count);
+
+// Caller-owned packed frames; release(context) runs exactly once when the
+// call returns 0, and never otherwise
+int decklink_display_external_frame(DeckLinkHandle handle,
+                                    const ExternalFrameDesc* desc,
+                                    ExternalReleaseFn release,
+                                    void* context);
+int decklink_schedule_external_frame(DeckLinkHandle handle,
+                                     const ExternalFrameDesc* desc,
+                                     ExternalReleaseFn release,
+                                     void* context,
+                                     int64_t target_ns,
+                                     int32_t duration_frames,
+                                     SchedulerDecisionRecord* record);
+int decklink_schedule_external_frame_hdr(DeckLinkHandle handle,
+                                         const ExternalFrameDesc* desc,
+                                         ExternalReleaseFn release,
+                                         void* context,
+                                         int64_t target_ns,
+                                         int32_t duration_frames,
+                                         int32_t hdr_metadata_id,
+                                         SchedulerDecisionRecord* record);
+
+// Packed frame cache, by caller-chosen key
+int decklink_cache_frame(DeckLinkHandle handle,
+                         int64_t key,
+                         const uint16_t* data,
+                         int width,
+                         int height);
+int decklink_cache_packed_frame(DeckLinkHandle handle,
+                                int64_t key,
+                                const ExternalFrameDesc* desc);
+int decklink_display_cached_frame(DeckLinkHandle handle, int64_t key);
+int decklink_schedule_cached_frame(DeckLinkHandle handle,
+                                   int64_t key,
+                                   int64_t target_ns,
+                                   int32_t duration_frames,
+                                   SchedulerDecisionRecord* record);
+int decklink_schedule_cached_frame_hdr(DeckLinkHandle handle,
+                                       int64_t key,
+                                       int64_t target_ns,
+                                       int32_t duration_frames,
+                                       int32_t hdr_metadata_id,
+                                       SchedulerDecisionRecord* record);
+int decklink_remove_cached_frame(DeckLinkHandle handle, int64_t key);
+int decklink_clear_frame_cache(DeckLinkHandle handle);
+int decklink_set_frame_cache_hot_frames(DeckLinkHandle handle, int capacity);
+int decklink_get_frame_cache_stats(DeckLinkHandle handle,
+                                   FrameCacheStats* stats);
+
+// Placement of RGB frames on the output raster
+int decklink_set_placement(DeckLinkHandle handle,
+                           const PlacementConfig* config);
+int decklink_get_placement(DeckLinkHandle handle, PlacementConfig* config);
+
+// Per-frame statistics (mode is a FrameStatsMode)
+int decklink_set_frame_stats(DeckLinkHandle handle, int mode);
+int decklink_get_frame_stats(DeckLinkHandle handle, FrameStats* stats);
+
+// Monitoring thumbnail; get returns the RGB8 bytes copied (the size needed
+// when rgb is NULL), 0 if none has been captured, -1 on error
+int decklink_set_thumbnail_config(DeckLinkHandle handle,
+                                  const ThumbnailConfig* config);
+int decklink_get_thumbnail_config(DeckLinkHandle handle,
+                                  ThumbnailConfig* config);
+int decklink_get_thumbnail(DeckLinkHandle handle,
+                           uint8_t* rgb,
+                           int capacity,
+                           ThumbnailInfo* info);
 
 // Frame data management
 int decklink_set_frame_data(DeckLinkHandle handle,
@@ -158,6 +737,15 @@ int decklink_set_frame_data(DeckLinkHandle handle,
                             int width,
                             int height);
 
+// Replaces regions of the current frame (data is the whole new frame, the
+// same size) and re-displays it
+int decklink_update_frame_regions(DeckLinkHandle handle,
+                                  const uint16_t* data,
+                                  int width,
+                                  int height,
+                                  const FrameRegion* regions,
+                                  int count);
+
 // Synchronous display
 int decklink_display_frame_sync(DeckLinkHandle handle);
 
@@ -0,0 +1,104 @@
+#include "external_frame.h"
+
+#include <cstring>
+#include <iostream>
+
+ExternalVideoBuffer::ExternalVideoBuffer(void* bytes,
+                                         ExternalReleaseFn release,
+                                         void* context)
+    : m_bytes(bytes), m_release(release), m_context(context), m_refCount(1) {}
+
+ExternalVideoBuffer::~ExternalVideoBuffer() {
+  if (m_release)
+    m_release(m_context);
+}
+
+HRESULT ExternalVideoBuffer::QueryInterface(REFIID iid, LPVOID* ppv) {
+  if (!ppv)
+    return E_INVALIDARG;
+
+  CFUUIDBytes iunknown = CFUUIDGetUUIDBytes(IUnknownUUID);
+  if (memcmp(&iid, &iunknown, sizeof(REFIID)) == 0 ||
+      memcmp(&iid, &IID_IDeckLinkVideoBuffer, sizeof(REFIID)) == 0) {
+    *ppv = static_cast<IDeckLinkVideoBuffer*>(this);
+    AddRef();
+    return S_OK;
+  }
+
+  *ppv = nullptr;
+  return E_NOINTERFACE;
+}
+
+ULONG ExternalVideoBuffer::AddRef() {
+  return ++m_refCount;
+}
+
+ULONG ExternalVideoBuffer::Release() {
+  ULONG newRefValue = --m_refCount;
+  if (newRefValue == 0)
+    delete this;
+  return newRefValue;
+}
+
+HRESULT ExternalVideoBuffer::GetBytes(void** buffer) {
+  if (!buffer)
+    return E_POINTER;
+  *buffer = m_bytes;
+  return S_OK;
+}
+
+// The memory is plain host memory the caller keeps valid until release
+HRESULT ExternalVideoBuffer::StartAccess(BMDBufferAccessFlags flags) {
+  return S_OK;
+}
+
+HRESULT ExternalVideoBuffer::EndAccess(BMDBufferAccessFlags flags) {
+  return S_OK;
+}
+
+/**
+ * @brief Creates a frame over caller-owned, already packed memory
+ *
+ * @return int 0 on success, otherwise:
+ *         - -1: Invalid description
+ *         - -3: RowBytesForPixelFormat fails for the pixel format
+ *         - -4: rowBytes is smaller than one row of the pixel format, or
+ *               the SDK cannot create the frame
+ */
+int wrap_external_frame(IDeckLinkOutput* output,
+                        const ExternalFrameDesc& desc,
+                        ExternalReleaseFn release,
+                        void* context,
+                        IDeckLinkMutableVideoFrame** frame) {
+  if (!output || !frame || !desc.bytes || desc.width <= 0 ||
+      desc.height <= 0 || desc.rowBytes <= 0)
+    return -1;
+
+  const BMDPixelFormat pixelFormat =
+      static_cast<BMDPixelFormat>(desc.pixelFormat);
+  int32_t minRowBytes = 0;
+  if (output->RowBytesForPixelFormat(pixelFormat, desc.width, &minRowBytes) !=
+      S_OK)
+    return -3;
+  if (desc.rowBytes < minRowBytes) {
+    std::cerr << "[DeckLink] External frame rows of " << desc.rowBytes
+              << " bytes are shorter than the " << minRowBytes
+              << " bytes a row needs" << std::endl;
+    return -4;
+  }
+
+  auto* buffer = new ExternalVideoBuffer(desc.bytes, release, context);
+  HRESULT result = output->CreateVideoFrameWithBuffer(
+      desc.width, desc.height, desc.rowBytes, pixelFormat, bmdFrameFlagDefault,
+      buffer, frame);
+  if (result != S_OK || !*frame) {
+    std::cerr << "[DeckLink] Could not wrap external frame. HRESULT: 0x"
+              << std::hex << result << std::dec << std::endl;
+    buffer->disarm();
+    buffer->Release();
+    return -4;
+  }
+  // The frame took its own reference
+  buffer->Release();
+  return 0;
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+#include "DeckLinkAPI.h"
+
+/*
+ * Caller-owned frame memory
+ *
+ * Payloads that are already in a device pixel format (packed by an earlier
+ * run or an external packer) are wrapped in place: the buffer below exposes
+ * the caller's bytes to IDeckLinkOutput::CreateVideoFrameWithBuffer, so the
+ * data reaches the device without unpacking, repacking or copying. The
+ * caller's release callback runs exactly once, when the SDK and the library
+ * have dropped their last reference and the memory may be reused.
+ */
+
+// Called from whichever thread drops the last reference (possibly an SDK
+// completion thread)
+typedef void (*ExternalReleaseFn)(void* context);
+
+struct ExternalFrameDesc {
+  void* bytes;
+  int32_t width;
+  int32_t height;
+  int32_t rowBytes;      // Stride of bytes; at least the format's row size
+  uint32_t pixelFormat;  // BMDPixelFormat of the payload
+};
+
+class ExternalVideoBuffer final : public IDeckLinkVideoBuffer {
+ public:
+  ExternalVideoBuffer(void* bytes, ExternalReleaseFn release, void* context);
+
+  // Forgets the release callback, for when the buffer is dropped before the
+  // caller handed over ownership
+  void disarm() { m_release = nullptr; }
+
+  // IUnknown
+  HRESULT QueryInterface(REFIID iid, LPVOID* ppv) override;
+  ULONG AddRef() override;
+  ULONG Release() override;
+
+  // IDeckLinkVideoBuffer
+  HRESULT GetBytes(void** buffer) override;
+  HRESULT StartAccess(BMDBufferAccessFlags flags) override;
+  HRESULT EndAccess(BMDBufferAccessFlags flags) override;
+
+ private:
+  ~ExternalVideoBuffer() override;
+
+  void* m_bytes;
+  ExternalReleaseFn m_release;
+  void* m_context;
+  std::atomic<ULONG> m_refCount;
+};
+
+// Wraps @p desc in a new frame owned by the caller of this function. On
+// success the frame holds the only buffer reference, so @p release runs when
+// the frame is released; on failure @p release is not called.
+int wrap_external_frame(IDeckLinkOutput* output,
+                        const ExternalFrameDesc& desc,
+                        ExternalReleaseFn release,
+                        void* context,
+                        IDeckLinkMutableVideoFrame** frame);
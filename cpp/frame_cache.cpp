@@ -0,0 +1,463 @@
+#include "frame_cache.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+
+#include "trace.h"
+
+namespace {
+
+// Token word: type in the top two bits, word or row count below
+constexpr uint32_t kTokenLiteral = 0u << 30;  // count words follow
+constexpr uint32_t kTokenMatch = 1u << 30;    // next word is the distance
+constexpr uint32_t kTokenRows = 2u << 30;     // count copies of the row above
+constexpr uint32_t kTokenCountMask = (1u << 30) - 1;
+// A match costs two words, so shorter ones are left as literals
+constexpr int32_t kMinMatch = 3;
+
+int64_t steadyNowNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+uint32_t hashWords(const uint32_t* p) {
+  return (p[0] * 0x9E3779B1u ^ p[1] * 0x85EBCA77u ^ p[2] * 0xC2B2AE3Du) >> 16;
+}
+
+// Copies count words from dist words back, which may overlap the output:
+// the copied span doubles each step, so a short period costs log2 memcpys
+void copyRepeat(uint32_t* out, size_t dist, size_t count) {
+  const uint32_t* from = out - dist;
+  size_t done = 0;
+  while (done < count) {
+    const size_t chunk = std::min(count - done, dist + done);
+    std::memcpy(out + done, from, chunk * sizeof(uint32_t));
+    done += chunk;
+  }
+}
+
+}  // namespace
+
+size_t frame_codec_bound(int32_t rowWords, int rows) {
+  // Matches never expand, so the worst case is a literal header per row
+  return (static_cast<size_t>(rowWords) + 1) * rows;
+}
+
+int frame_codec_period(BMDPixelFormat pixelFormat) {
+  switch (pixelFormat) {
+    case bmdFormat12BitRGBLE:
+      return 9;  // 8 pixels in 36 bytes
+    default:
+      return 1;  // One pixel per word
+  }
+}
+
+size_t frame_codec_encode(const uint32_t* src,
+                          int32_t rowWords,
+                          int rows,
+                          int period,
+                          int32_t* hashTable,
+                          uint32_t* out) {
+  std::fill(hashTable, hashTable + kFrameCodecHashSize, -1);
+  size_t o = 0;
+  size_t rowsToken = SIZE_MAX;  // Open row repeat token, if any
+
+  auto flushLiteral = [&](const uint32_t* from, int32_t count) {
+    if (count <= 0)
+      return;
+    out[o++] = kTokenLiteral | static_cast<uint32_t>(count);
+    std::memcpy(out + o, from, count * sizeof(uint32_t));
+    o += count;
+  };
+
+  for (int r = 0; r < rows; r++) {
+    const size_t base = static_cast<size_t>(r) * rowWords;
+    const uint32_t* row = src + base;
+    if (r > 0 &&
+        std::memcmp(row, row - rowWords, rowWords * sizeof(uint32_t)) == 0) {
+      if (rowsToken != SIZE_MAX &&
+          (out[rowsToken] & kTokenCountMask) < kTokenCountMask) {
+        out[rowsToken]++;
+      } else {
+        rowsToken = o;
+        out[o++] = kTokenRows | 1;
+      }
+      continue;
+    }
+    rowsToken = SIZE_MAX;
+
+    // Greedy: the longest run at the group period, the row stride or the
+    // last position with the same three words, else one more literal
+    int32_t literal = 0;
+    int32_t i = 0;
+    while (i < rowWords) {
+      const size_t pos = base + i;
+      const int32_t limit = rowWords - i;
+      int32_t bestLength = 0;
+      size_t bestDistance = 0;
+      auto tryDistance = [&](size_t distance) {
+        if (!distance || distance > pos || bestLength == limit)
+          return;
+        const uint32_t* a = src + pos;
+        const uint32_t* b = a - distance;
+        int32_t n = 0;
+        while (n < limit && a[n] == b[n])
+          n++;
+        if (n > bestLength) {
+          bestLength = n;
+          bestDistance = distance;
+        }
+      };
+      tryDistance(period);
+      tryDistance(rowWords);
+      if (limit >= kMinMatch) {
+        int32_t& slot = hashTable[hashWords(src + pos)];
+        if (slot >= 0)
+          tryDistance(pos - slot);
+        slot = static_cast<int32_t>(pos);
+      }
+
+      if (bestLength >= kMinMatch) {
+        flushLiteral(row + literal, i - literal);
+        out[o++] = kTokenMatch | static_cast<uint32_t>(bestLength);
+        out[o++] = static_cast<uint32_t>(bestDistance);
+        i += bestLength;
+        literal = i;
+      } else {
+        i++;
+      }
+    }
+    flushLiteral(row + literal, rowWords - literal);
+  }
+  return o;
+}
+
+int frame_codec_decode(const uint32_t* src,
+                       size_t count,
+                       uint32_t* dest,
+                       int32_t rowWords,
+                       int rows) {
+  if (!src || !dest || rowWords <= 0 || rows <= 0)
+    return -1;
+
+  const size_t total = static_cast<size_t>(rowWords) * rows;
+  size_t o = 0;
+  size_t i = 0;
+  while (i < count) {
+    const uint32_t token = src[i++];
+    const size_t n = token & kTokenCountMask;
+    switch (token & ~kTokenCountMask) {
+      case kTokenLiteral:
+        if (n > count - i || n > total - o)
+          return -1;
+        std::memcpy(dest + o, src + i, n * sizeof(uint32_t));
+        i += n;
+        o += n;
+        break;
+      case kTokenMatch: {
+        if (i >= count)
+          return -1;
+        const size_t distance = src[i++];
+        if (!distance || distance > o || n > total - o)
+          return -1;
+        copyRepeat(dest + o, distance, n);
+        o += n;
+        break;
+      }
+      case kTokenRows:
+        if (o < static_cast<size_t>(rowWords) || o % rowWords ||
+            n > (total - o) / rowWords)
+          return -1;
+        for (size_t k = 0; k < n; k++, o += rowWords)
+          std::memcpy(dest + o, dest + o - rowWords,
+                      rowWords * sizeof(uint32_t));
+        break;
+      default:
+        return -1;
+    }
+  }
+  return o == total ? 0 : -1;
+}
+
+FrameCache::FrameCache()
+    : m_hotCapacity(kFrameCacheDefaultHot),
+      m_hotEntries(0),
+      m_hotWidth(0),
+      m_hotHeight(0),
+      m_hotFormat(bmdFormatUnspecified),
+      m_useClock(0),
+      m_rawBytes(0),
+      m_compressedBytes(0),
+      m_hits(0),
+      m_misses(0),
+      m_decodes(0),
+      m_decodeNsTotal(0),
+      m_maxDecodeNs(0) {}
+
+FrameCache::~FrameCache() {
+  clear();
+}
+
+int FrameCache::setHotCapacity(int capacity) {
+  if (capacity < 1 || capacity > kFrameCacheMaxHot)
+    return -1;
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (capacity == m_hotCapacity)
+    return 0;
+  for (auto& item : m_entries)
+    dropHotLocked(item.second);
+  // The pool is resized on the next miss
+  m_hotPool.clear();
+  m_hotFormat = bmdFormatUnspecified;
+  m_hotCapacity = capacity;
+  return 0;
+}
+
+/**
+ * @brief Compresses a packed frame into the cache
+ *
+ * The encode scratch buffer is kept for the next store, so filling the cache
+ * with many patterns of one geometry allocates only the compressed entries.
+ *
+ * @return int 0 on success, -1 for invalid arguments or memory that is not
+ *         word aligned, -8 if @p rowBytes is not a whole number of words
+ */
+int FrameCache::store(int64_t key,
+                      const void* bytes,
+                      int32_t rowBytes,
+                      int32_t width,
+                      int32_t height,
+                      BMDPixelFormat pixelFormat) {
+  if (!bytes || width <= 0 || height <= 0 || rowBytes <= 0 ||
+      reinterpret_cast<uintptr_t>(bytes) % sizeof(uint32_t))
+    return -1;
+  if (rowBytes % sizeof(uint32_t))
+    return -8;
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  const int32_t rowWords = rowBytes / static_cast<int32_t>(sizeof(uint32_t));
+  m_hashTable.resize(kFrameCodecHashSize);
+  m_encodeScratch.resize(frame_codec_bound(rowWords, height));
+  const size_t count = frame_codec_encode(
+      static_cast<const uint32_t*>(bytes), rowWords, height,
+      frame_codec_period(pixelFormat), m_hashTable.data(),
+      m_encodeScratch.data());
+
+  Entry& entry = m_entries[key];
+  if (!entry.words.empty()) {
+    dropHotLocked(entry);
+    m_rawBytes -= static_cast<int64_t>(entry.rowBytes) * entry.height;
+    m_compressedBytes -=
+        static_cast<int64_t>(entry.words.size() * sizeof(uint32_t));
+  }
+  // Exact size: the entry keeps only what it needs
+  TrackedVector<uint32_t, kMemoryFrameCache>(
+      m_encodeScratch.begin(), m_encodeScratch.begin() + count)
+      .swap(entry.words);
+  entry.width = width;
+  entry.height = height;
+  entry.rowBytes = rowBytes;
+  entry.pixelFormat = pixelFormat;
+  entry.lastUse = ++m_useClock;
+  m_rawBytes += static_cast<int64_t>(rowBytes) * height;
+  m_compressedBytes += static_cast<int64_t>(count * sizeof(uint32_t));
+  return 0;
+}
+
+// Points the hot pool at the entry's geometry, dropping hot frames of another
+int FrameCache::prepareHotLocked(IDeckLinkOutput* output,
+                                 const Entry& entry,
+                                 bool lockMemory) {
+  if (entry.width != m_hotWidth || entry.height != m_hotHeight ||
+      entry.pixelFormat != m_hotFormat) {
+    for (auto& item : m_entries)
+      dropHotLocked(item.second);
+    m_hotWidth = entry.width;
+    m_hotHeight = entry.height;
+    m_hotFormat = entry.pixelFormat;
+  }
+  // Two spares so an evicted frame still on screen does not block a decode
+  int err = m_hotPool.configure(output, entry.width, entry.height,
+                                entry.pixelFormat, m_hotCapacity + 2,
+                                lockMemory);
+  if (err) {
+    m_hotFormat = bmdFormatUnspecified;
+    return err;
+  }
+  return m_hotPool.rowBytes() == entry.rowBytes ? 0 : -1;
+}
+
+void FrameCache::dropHotLocked(Entry& entry) {
+  if (!entry.hot)
+    return;
+  entry.hot->Release();
+  entry.hot = nullptr;
+  entry.hotBytes = nullptr;
+  m_hotEntries--;
+}
+
+// Drops the least recently used hot frame other than @p keep's
+void FrameCache::evictLocked(int64_t keep) {
+  Entry* oldest = nullptr;
+  for (auto& item : m_entries) {
+    Entry& entry = item.second;
+    if (entry.hot && item.first != keep &&
+        (!oldest || entry.lastUse < oldest->lastUse))
+      oldest = &entry;
+  }
+  if (oldest)
+    dropHotLocked(*oldest);
+}
+
+IDeckLinkMutableVideoFrame* FrameCache::acquireHotLocked(int64_t keep,
+                                                         void** bytes) {
+  while (m_hotEntries >= m_hotCapacity)
+    evictLocked(keep);
+  for (;;) {
+    IDeckLinkMutableVideoFrame* frame = m_hotPool.acquire(bytes);
+    if (frame || !m_hotEntries)
+      return frame;
+    // Every free buffer is an evicted frame the SDK still holds
+    evictLocked(keep);
+  }
+}
+
+/**
+ * @brief Returns a device frame holding a cached entry
+ *
+ * @return int 0 on success, otherwise:
+ *         - -1: Unknown key, or @p fallback has another geometry
+ *         - -4: No hot or fallback frame is free
+ *         - -5: The entry does not decode
+ */
+int FrameCache::recall(IDeckLinkOutput* output,
+                       int64_t key,
+                       bool lockMemory,
+                       FramePool* fallback,
+                       IDeckLinkMutableVideoFrame** frame,
+                       void** bytes) {
+  if (!output || !frame || !bytes)
+    return -1;
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto it = m_entries.find(key);
+  if (it == m_entries.end())
+    return -1;
+  Entry& entry = it->second;
+  entry.lastUse = ++m_useClock;
+  if (entry.hot) {
+    m_hits++;
+    entry.hot->AddRef();
+    *frame = entry.hot;
+    *bytes = entry.hotBytes;
+    return 0;
+  }
+  m_misses++;
+
+  void* dest = nullptr;
+  IDeckLinkMutableVideoFrame* target = nullptr;
+  if (!prepareHotLocked(output, entry, lockMemory))
+    target = acquireHotLocked(key, &dest);
+  const bool hot = target != nullptr;
+  if (!hot) {
+    target = fallback ? fallback->acquire(&dest) : nullptr;
+    if (!target)
+      return -4;
+    if (target->GetWidth() != entry.width ||
+        target->GetHeight() != entry.height ||
+        target->GetPixelFormat() != entry.pixelFormat ||
+        target->GetRowBytes() != entry.rowBytes) {
+      target->Release();
+      return -1;
+    }
+  }
+
+  const int32_t rowWords =
+      entry.rowBytes / static_cast<int32_t>(sizeof(uint32_t));
+  const int64_t startNs = steadyNowNs();
+  if (frame_codec_decode(entry.words.data(), entry.words.size(),
+                         static_cast<uint32_t*>(dest), rowWords,
+                         entry.height)) {
+    std::cerr << "[FrameCache] Entry " << key << " is corrupt" << std::endl;
+    target->Release();
+    return -5;
+  }
+  const int64_t decodeNs = steadyNowNs() - startNs;
+  trace_record(kTraceCacheLoad, startNs, startNs + decodeNs,
+               trace_current_frame());
+  m_decodes++;
+  m_decodeNsTotal += decodeNs;
+  m_maxDecodeNs = std::max(m_maxDecodeNs, decodeNs);
+
+  if (hot) {
+    target->AddRef();
+    entry.hot = target;
+    entry.hotBytes = dest;
+    m_hotEntries++;
+  }
+  *frame = target;
+  *bytes = dest;
+  return 0;
+}
+
+bool FrameCache::describe(int64_t key,
+                          int32_t* width,
+                          int32_t* height,
+                          BMDPixelFormat* pixelFormat) const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto it = m_entries.find(key);
+  if (it == m_entries.end())
+    return false;
+  if (width)
+    *width = it->second.width;
+  if (height)
+    *height = it->second.height;
+  if (pixelFormat)
+    *pixelFormat = it->second.pixelFormat;
+  return true;
+}
+
+int FrameCache::remove(int64_t key) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto it = m_entries.find(key);
+  if (it == m_entries.end())
+    return -1;
+  Entry& entry = it->second;
+  dropHotLocked(entry);
+  m_rawBytes -= static_cast<int64_t>(entry.rowBytes) * entry.height;
+  m_compressedBytes -=
+      static_cast<int64_t>(entry.words.size() * sizeof(uint32_t));
+  m_entries.erase(it);
+  return 0;
+}
+
+void FrameCache::clear() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  for (auto& item : m_entries)
+    dropHotLocked(item.second);
+  m_entries.clear();
+  m_hotPool.clear();
+  m_hotFormat = bmdFormatUnspecified;
+  TrackedVector<int32_t, kMemoryFrameCache>().swap(m_hashTable);
+  TrackedVector<uint32_t, kMemoryFrameCache>().swap(m_encodeScratch);
+  m_rawBytes = 0;
+  m_compressedBytes = 0;
+}
+
+FrameCacheStats FrameCache::stats() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  FrameCacheStats stats = {};
+  stats.entries = static_cast<int32_t>(m_entries.size());
+  stats.hotEntries = m_hotEntries;
+  stats.hotCapacity = m_hotCapacity;
+  stats.rawBytes = m_rawBytes;
+  stats.compressedBytes = m_compressedBytes;
+  stats.hits = m_hits;
+  stats.misses = m_misses;
+  stats.meanDecodeNs = m_decodes ? m_decodeNsTotal / m_decodes : 0;
+  stats.maxDecodeNs = m_maxDecodeNs;
+  return stats;
+}
@@ -0,0 +1,149 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "DeckLinkAPI.h"
+#include "frame_pool.h"
+#include "memory_stats.h"
+
+/*
+ * Packed frame cache
+ *
+ * Test patterns are stored once, already packed, and recalled by key without
+ * touching the packers again. Every entry is kept compressed with a codec
+ * built for packed test patterns: the stream is 32-bit words, a row equal to
+ * the one above costs nothing, and runs repeat at the pixel group period of
+ * the format (one word for 8-bit RGB and r210, nine for R12L) or at the row
+ * stride, so flat fields, bars, ramps and windows shrink to a few hundred
+ * bytes while noise is stored almost as-is. Decoding writes straight into
+ * the bytes of a pooled device frame.
+ *
+ * The most recently used entries also stay decoded in a small set of hot
+ * frames, so recalling them is an AddRef of a frame that is ready for the
+ * SDK. Hot frames follow the geometry of the last entry stored or recalled.
+ */
+
+constexpr int kFrameCacheDefaultHot = 4;
+constexpr int kFrameCacheMaxHot = 64;
+constexpr int kFrameCodecHashSize = 1 << 16;
+
+struct FrameCacheStats {
+  int32_t entries;
+  int32_t hotEntries;
+  int32_t hotCapacity;
+  int32_t reserved;
+  int64_t rawBytes;         // Packed size of every entry
+  int64_t compressedBytes;  // Bytes the entries occupy
+  int64_t hits;             // Recalls served by a hot frame
+  int64_t misses;           // Recalls that decoded an entry
+  int64_t meanDecodeNs;
+  int64_t maxDecodeNs;
+};
+
+// Largest encoded size, in words, of a frame of @p rows rows of @p rowWords
+size_t frame_codec_bound(int32_t rowWords, int rows);
+
+// Encodes @p rows rows of @p rowWords words; @p period is the pixel group
+// size in words and @p hashTable kFrameCodecHashSize scratch entries.
+// Returns the words written to @p out (frame_codec_bound() capacity).
+size_t frame_codec_encode(const uint32_t* src,
+                          int32_t rowWords,
+                          int rows,
+                          int period,
+                          int32_t* hashTable,
+                          uint32_t* out);
+
+// Decodes into @p dest; returns 0, or -1 if the stream does not describe
+// exactly @p rows rows of @p rowWords words
+int frame_codec_decode(const uint32_t* src,
+                       size_t count,
+                       uint32_t* dest,
+                       int32_t rowWords,
+                       int rows);
+
+// Pixel group size of a packed format in 32-bit words
+int frame_codec_period(BMDPixelFormat pixelFormat);
+
+class FrameCache {
+ public:
+  FrameCache();
+  ~FrameCache();
+
+  // Number of entries kept decoded (1-kFrameCacheMaxHot); -1 if invalid
+  int setHotCapacity(int capacity);
+
+  // Compresses a packed frame under @p key, replacing any earlier entry.
+  // Returns -1 for invalid arguments, -8 if rowBytes is not word aligned.
+  int store(int64_t key,
+            const void* bytes,
+            int32_t rowBytes,
+            int32_t width,
+            int32_t height,
+            BMDPixelFormat pixelFormat);
+
+  // Hands out a new reference to a frame holding entry @p key. A miss
+  // decodes into a hot frame (evicting the least recently used), or into
+  // @p fallback if every hot frame is still held by the SDK. Returns -1 for
+  // an unknown key or a geometry @p fallback does not match, -4 if no frame
+  // is free, -5 if the entry is corrupt.
+  int recall(IDeckLinkOutput* output,
+             int64_t key,
+             bool lockMemory,
+             FramePool* fallback,
+             IDeckLinkMutableVideoFrame** frame,
+             void** bytes);
+
+  // Geometry of entry @p key; false if there is none
+  bool describe(int64_t key,
+                int32_t* width,
+                int32_t* height,
+                BMDPixelFormat* pixelFormat) const;
+
+  int remove(int64_t key);
+  void clear();
+  FrameCacheStats stats() const;
+
+ private:
+  struct Entry {
+    int32_t width;
+    int32_t height;
+    int32_t rowBytes;
+    BMDPixelFormat pixelFormat;
+    TrackedVector<uint32_t, kMemoryFrameCache> words;
+    IDeckLinkMutableVideoFrame* hot = nullptr;  // Decoded copy, if any
+    void* hotBytes = nullptr;
+    uint64_t lastUse = 0;
+  };
+
+  // All *Locked helpers require m_mutex
+  int prepareHotLocked(IDeckLinkOutput* output,
+                       const Entry& entry,
+                       bool lockMemory);
+  void dropHotLocked(Entry& entry);
+  void evictLocked(int64_t keep);
+  IDeckLinkMutableVideoFrame* acquireHotLocked(int64_t keep, void** bytes);
+
+  mutable std::mutex m_mutex;
+  std::unordered_map<int64_t, Entry> m_entries;
+  FramePool m_hotPool;
+  int m_hotCapacity;
+  int m_hotEntries;
+  int32_t m_hotWidth;
+  int32_t m_hotHeight;
+  BMDPixelFormat m_hotFormat;
+  uint64_t m_useClock;
+  TrackedVector<int32_t, kMemoryFrameCache> m_hashTable;
+  TrackedVector<uint32_t, kMemoryFrameCache> m_encodeScratch;
+
+  int64_t m_rawBytes;
+  int64_t m_compressedBytes;
+  int64_t m_hits;
+  int64_t m_misses;
+  int64_t m_decodes;
+  int64_t m_decodeNsTotal;
+  int64_t m_maxDecodeNs;
+};
@@ -0,0 +1,396 @@
+#include "frame_placement.h"
+
+#include <algorithm>
+#include <cstring>
+
+// Source position of an output row or column, in 1/4096 pixel, for the
+// bilinear filter: output pixel t of @p destSize samples the source at
+// (t + 0.5) * srcSize / destSize - 0.5
+static int64_t bilinear_position(int t, int srcSize, int destSize) {
+  const int64_t numerator =
+      (static_cast<int64_t>(2 * t + 1) * srcSize - destSize) * 4096;
+  return numerator <= 0 ? 0 : numerator / (2 * static_cast<int64_t>(destSize));
+}
+
+int placement_resolve(const PlacementConfig& config,
+                      int sourceWidth,
+                      int sourceHeight,
+                      int outputWidth,
+                      int outputHeight,
+                      PlacementMap* map) {
+  if (!map || sourceWidth <= 0 || sourceHeight <= 0)
+    return -1;
+  *map = {};
+  map->identity = true;
+  map->sourceWidth = sourceWidth;
+  map->sourceHeight = sourceHeight;
+  map->outputWidth = sourceWidth;
+  map->outputHeight = sourceHeight;
+  map->cropWidth = sourceWidth;
+  map->cropHeight = sourceHeight;
+  map->destWidth = sourceWidth;
+  map->destHeight = sourceHeight;
+  if (!config.enabled)
+    return 0;
+
+  if (config.fit < kFitNone || config.fit > kFitInteger ||
+      config.filter < kFilterNearest || config.filter > kFilterBilinear ||
+      config.width < 0 || config.height < 0)
+    return -1;
+  const int ow = config.width && config.height ? config.width : outputWidth;
+  const int oh = config.width && config.height ? config.height : outputHeight;
+  if (ow <= 0 || oh <= 0 || ow > 0xFFFF || oh > 0xFFFF)
+    return -1;
+
+  const bool fullSource = config.cropWidth == 0 || config.cropHeight == 0;
+  const int cx = fullSource ? 0 : config.cropX;
+  const int cy = fullSource ? 0 : config.cropY;
+  const int cw = fullSource ? sourceWidth : config.cropWidth;
+  const int ch = fullSource ? sourceHeight : config.cropHeight;
+  if (cx < 0 || cy < 0 || cw <= 0 || ch <= 0 || cx + cw > sourceWidth ||
+      cy + ch > sourceHeight)
+    return -1;
+
+  // Products of sizes below 65536 fit comfortably in int64_t
+  const int64_t wide = static_cast<int64_t>(cw) * oh;
+  const int64_t tall = static_cast<int64_t>(ow) * ch;
+  int dw = cw;
+  int dh = ch;
+  switch (config.fit) {
+    case kFitContain:
+    case kFitCover:
+      // Contain matches the output on the constraining axis, cover on the
+      // other one
+      if ((wide <= tall) == (config.fit == kFitContain)) {
+        dh = oh;
+        dw = static_cast<int>((2 * wide + ch) / (2 * ch));
+      } else {
+        dw = ow;
+        dh = static_cast<int>((2 * tall + cw) / (2 * cw));
+      }
+      break;
+    case kFitStretch:
+      dw = ow;
+      dh = oh;
+      break;
+    case kFitInteger: {
+      const int multiple = std::min(ow / cw, oh / ch);
+      if (multiple >= 1) {
+        dw = cw * multiple;
+        dh = ch * multiple;
+      } else {
+        const int divisor =
+            std::max((cw + ow - 1) / ow, (ch + oh - 1) / oh);
+        dw = cw / divisor;
+        dh = ch / divisor;
+      }
+      break;
+    }
+    default:
+      break;
+  }
+
+  map->outputWidth = ow;
+  map->outputHeight = oh;
+  map->cropX = cx;
+  map->cropY = cy;
+  map->cropWidth = cw;
+  map->cropHeight = ch;
+  map->destWidth = std::max(dw, 1);
+  map->destHeight = std::max(dh, 1);
+  map->destX = (ow - map->destWidth) / 2;
+  map->destY = (oh - map->destHeight) / 2;
+  map->filter = config.filter;
+  std::copy(std::begin(config.surround), std::end(config.surround),
+            map->surround);
+  map->identity = cw == sourceWidth && ch == sourceHeight &&
+                  map->destWidth == cw && map->destHeight == ch &&
+                  ow == cw && oh == ch;
+  return 0;
+}
+
+namespace {
+
+// Where output row y reads from: rows [y0, y1) for nearest and box, rows y0
+// and y0 + 1 blended by weight for bilinear. Equal keys give equal rows.
+struct RowSource {
+  int y0;
+  int y1;
+  int weight;
+
+  bool operator==(const RowSource& other) const {
+    return y0 == other.y0 && y1 == other.y1 && weight == other.weight;
+  }
+};
+
+RowSource row_source(const PlacementMap& map, int y) {
+  const int t = y - map.destY;
+  const int ch = map.cropHeight;
+  const int dh = map.destHeight;
+  RowSource source = {};
+  if (map.filter == kFilterBox) {
+    source.y0 = static_cast<int>(static_cast<int64_t>(t) * ch / dh);
+    source.y1 = std::max(
+        static_cast<int>(static_cast<int64_t>(t + 1) * ch / dh),
+        source.y0 + 1);
+  } else if (map.filter == kFilterBilinear) {
+    const int64_t position = bilinear_position(t, ch, dh);
+    source.y0 = static_cast<int>(position >> 12);
+    source.weight = static_cast<int>(position & 0xFFF);
+    if (source.y0 >= ch - 1) {
+      source.y0 = ch - 1;
+      source.weight = 0;
+    }
+    source.y1 = std::min(source.y0 + 1, ch - 1);
+  } else {
+    source.y0 =
+        static_cast<int>(static_cast<int64_t>(2 * t + 1) * ch / (2 * dh));
+    source.y1 = source.y0 + 1;
+  }
+  source.y0 += map.cropY;
+  source.y1 += map.cropY;
+  return source;
+}
+
+}  // namespace
+
+void placement_output_rows(const PlacementMap& map,
+                           int sourceFirstRow,
+                           int sourceLastRow,
+                           int* firstRow,
+                           int* lastRow) {
+  *firstRow = 0;
+  *lastRow = 0;
+  if (map.identity) {
+    *firstRow = std::max(sourceFirstRow, 0);
+    *lastRow = std::max(std::min(sourceLastRow, map.outputHeight), *firstRow);
+    return;
+  }
+  // Only rows inside the destination rectangle read the source; the row
+  // sources grow with y, so the matching rows are contiguous
+  const int vy0 = std::max(map.destY, 0);
+  const int vy1 = std::min(map.destY + map.destHeight, map.outputHeight);
+  bool found = false;
+  for (int y = vy0; y < vy1; y++) {
+    const RowSource source = row_source(map, y);
+    // Bilinear also reads row y1; the others read [y0, y1)
+    const int last =
+        map.filter == kFilterBilinear ? source.y1 + 1 : source.y1;
+    if (source.y0 >= sourceLastRow)
+      break;
+    if (last <= sourceFirstRow)
+      continue;
+    if (!found)
+      *firstRow = y;
+    found = true;
+    *lastRow = y + 1;
+  }
+}
+
+/**
+ * @brief Resamples and packs a band of output rows
+ *
+ * Column positions are computed once per band. Box filtering first sums the
+ * source rows an output row covers into a 32-bit row and then averages the
+ * columns of each output pixel; bilinear filtering blends the two source
+ * rows into a row with four fractional bits and then blends horizontally,
+ * both with 12-bit weights.
+ */
+int pack_placed_rows(void* destData,
+                     BMDPixelFormat pixelFormat,
+                     const uint16_t* srcData,
+                     const PlacementMap& map,
+                     int32_t rowBytes,
+                     int firstRow,
+                     int lastRow,
+                     PlacementScratch* scratch,
+                     PixelStats* stats,
+                     const float* nitsLut) {
+  if (!pixel_max_code(pixelFormat))
+    return -8;
+  if (!destData || !srcData || !scratch || rowBytes <= 0 ||
+      rowBytes > 0xFFFF)
+    return -1;
+  const int ow = map.outputWidth;
+  const int oh = map.outputHeight;
+  lastRow = std::min(lastRow, oh);
+  if (firstRow < 0 || firstRow >= lastRow)
+    return 0;
+  if (map.identity)
+    return pack_pixel_format_rows(
+        destData, pixelFormat, srcData, static_cast<uint16_t>(ow),
+        static_cast<uint16_t>(oh), static_cast<uint16_t>(rowBytes),
+        static_cast<uint16_t>(firstRow), static_cast<uint16_t>(lastRow),
+        stats, nitsLut);
+
+  uint8_t* dest = static_cast<uint8_t*>(destData);
+  const size_t srcStride = static_cast<size_t>(map.sourceWidth) * 3;
+  const int vx0 = std::max(map.destX, 0);
+  const int vx1 = std::min(map.destX + map.destWidth, ow);
+  const int vy0 = std::max(map.destY, 0);
+  const int vy1 = std::min(map.destY + map.destHeight, oh);
+  const int visible = std::max(vx1 - vx0, 0);
+  const int cw = map.cropWidth;
+  const int dw = map.destWidth;
+
+  // The row buffer keeps the surround columns; visible columns are
+  // overwritten for every row
+  scratch->row.resize(static_cast<size_t>(ow) * 3);
+  uint16_t* row = scratch->row.data();
+  for (int x = 0; x < ow; x++)
+    std::memcpy(row + x * 3, map.surround, sizeof(map.surround));
+
+  // Source columns of each visible output column: the pixel for nearest,
+  // the first pixel and count for box, the left pixel and weight for
+  // bilinear. spanX0/spanX1 bound every source pixel read.
+  scratch->columns.resize(static_cast<size_t>(visible) * 2 + 1);
+  scratch->weights.resize(static_cast<size_t>(visible) + 1);
+  int32_t* columns = scratch->columns.data();
+  uint16_t* weights = scratch->weights.data();
+  int spanX0 = map.cropX + cw;
+  int spanX1 = map.cropX;
+  for (int i = 0; i < visible; i++) {
+    const int t = vx0 + i - map.destX;
+    int x0;
+    int x1;
+    if (map.filter == kFilterBox) {
+      x0 = static_cast<int>(static_cast<int64_t>(t) * cw / dw);
+      x1 = std::max(static_cast<int>(static_cast<int64_t>(t + 1) * cw / dw),
+                    x0 + 1);
+      columns[2 * i] = x0;
+      columns[2 * i + 1] = x1 - x0;
+    } else if (map.filter == kFilterBilinear) {
+      const int64_t position = bilinear_position(t, cw, dw);
+      x0 = static_cast<int>(position >> 12);
+      int weight = static_cast<int>(position & 0xFFF);
+      if (x0 >= cw - 1) {
+        x0 = cw - 1;
+        weight = 0;
+      }
+      x1 = std::min(x0 + 2, cw);
+      columns[i] = x0;
+      weights[i] = static_cast<uint16_t>(weight);
+    } else {
+      x0 = static_cast<int>(static_cast<int64_t>(2 * t + 1) * cw / (2 * dw));
+      x1 = x0 + 1;
+      columns[i] = x0;
+    }
+    spanX0 = std::min(spanX0, map.cropX + x0);
+    spanX1 = std::max(spanX1, map.cropX + x1);
+  }
+  const int span = std::max(spanX1 - spanX0, 0);
+  // Column positions relative to the span
+  const int relative = spanX0 - map.cropX;
+  for (int i = 0; i < visible; i++)
+    columns[map.filter == kFilterBox ? 2 * i : i] -= relative;
+  scratch->sums.resize(static_cast<size_t>(span) * 3 + 3);
+  uint32_t* sums = scratch->sums.data();
+
+  PixelStats rowStats;
+  PixelStats surroundStats;
+  uint8_t* surroundRow = nullptr;
+  uint8_t* previousRow = nullptr;
+  RowSource previous = {-1, -1, -1};
+  for (int y = firstRow; y < lastRow; y++) {
+    uint8_t* out = dest + static_cast<size_t>(y) * rowBytes;
+    const bool inside = y >= vy0 && y < vy1 && visible > 0;
+
+    // Rows identical to one already packed in this band are copied
+    if (!inside && surroundRow) {
+      std::memcpy(out, surroundRow, rowBytes);
+      if (stats)
+        pixel_stats_merge(stats, surroundStats);
+      continue;
+    }
+    RowSource source = {};
+    if (inside) {
+      source = row_source(map, y);
+      if (previousRow && source == previous) {
+        std::memcpy(out, previousRow, rowBytes);
+        if (stats)
+          pixel_stats_merge(stats, rowStats);
+        continue;
+      }
+
+      uint16_t* pixels = row + static_cast<size_t>(vx0) * 3;
+      const uint16_t* src0 =
+          srcData + source.y0 * srcStride + static_cast<size_t>(spanX0) * 3;
+      if (map.filter == kFilterBox) {
+        std::fill(sums, sums + span * 3, 0u);
+        for (int sy = source.y0; sy < source.y1; sy++) {
+          const uint16_t* src =
+              srcData + sy * srcStride + static_cast<size_t>(spanX0) * 3;
+          for (int j = 0; j < span * 3; j++)
+            sums[j] += src[j];
+        }
+        const int rows = source.y1 - source.y0;
+        for (int i = 0; i < visible; i++) {
+          const int count = columns[2 * i + 1];
+          const uint32_t* sum = sums + columns[2 * i] * 3;
+          if (count == 1 && rows == 1) {
+            // Upscaling: a single source pixel
+            for (int c = 0; c < 3; c++)
+              pixels[i * 3 + c] = static_cast<uint16_t>(sum[c]);
+            continue;
+          }
+          uint64_t r = 0, g = 0, b = 0;
+          for (int k = 0; k < count; k++) {
+            r += sum[k * 3 + 0];
+            g += sum[k * 3 + 1];
+            b += sum[k * 3 + 2];
+          }
+          const uint64_t n = static_cast<uint64_t>(count) * rows;
+          pixels[i * 3 + 0] = static_cast<uint16_t>((r + n / 2) / n);
+          pixels[i * 3 + 1] = static_cast<uint16_t>((g + n / 2) / n);
+          pixels[i * 3 + 2] = static_cast<uint16_t>((b + n / 2) / n);
+        }
+      } else if (map.filter == kFilterBilinear) {
+        const uint16_t* src1 =
+            srcData + source.y1 * srcStride + static_cast<size_t>(spanX0) * 3;
+        const uint32_t wy = static_cast<uint32_t>(source.weight);
+        for (int j = 0; j < span * 3; j++)
+          sums[j] = (src0[j] * (4096 - wy) + src1[j] * wy + 128) >> 8;
+        // The last column may read one position past the span with a zero
+        // weight
+        sums[span * 3 + 0] = sums[span * 3 + 1] = sums[span * 3 + 2] = 0;
+        for (int i = 0; i < visible; i++) {
+          const uint32_t* left = sums + columns[i] * 3;
+          const uint32_t wx = weights[i];
+          for (int c = 0; c < 3; c++)
+            pixels[i * 3 + c] = static_cast<uint16_t>(
+                (left[c] * (4096 - wx) + left[c + 3] * wx + 32768) >> 16);
+        }
+      } else {
+        for (int i = 0; i < visible; i++)
+          std::memcpy(pixels + i * 3, src0 + columns[i] * 3,
+                      3 * sizeof(uint16_t));
+      }
+    }
+
+    PixelStats* target = nullptr;
+    if (stats) {
+      target = inside ? &rowStats : &surroundStats;
+      pixel_stats_reset(target);
+    }
+    // Surround rows keep the visible columns of the last image row, so they
+    // are refilled before packing the one surround row of the band
+    if (!inside) {
+      for (int x = vx0; x < vx1; x++)
+        std::memcpy(row + x * 3, map.surround, sizeof(map.surround));
+    }
+    int err = pack_pixel_format_rows(
+        out, pixelFormat, row, static_cast<uint16_t>(ow), 1,
+        static_cast<uint16_t>(rowBytes), 0, 1, target, nitsLut);
+    if (err)
+      return err;
+    if (stats)
+      pixel_stats_merge(stats, *target);
+    if (inside) {
+      previousRow = out;
+      previous = source;
+    } else {
+      surroundRow = out;
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <cstdint>
+
+#include "DeckLinkAPI.h"
+#include "memory_stats.h"
+#include "pixel_packing.h"
+
+/*
+ * Placement of a source image on the output raster
+ *
+ * A source whose size differs from the output is cropped, scaled and
+ * centered while it is packed, with a surround color around it, so a 1080p
+ * chart can go out on a 4K or 8K raster without anyone building a
+ * full-resolution copy. Each output row is resampled into a single RGB row
+ * that goes straight to the packer: rows that only show the surround are
+ * packed once per band and copied, and rows that map to the same source rows
+ * as the row above (every other row of a 2x upscale) copy that packed row.
+ * The per-row inner loops run over contiguous arrays with precomputed column
+ * positions and weights so the compiler can vectorise them.
+ */
+
+enum PlacementFit {
+  kFitNone = 0,  // 1:1, centered; a larger source is cropped to the output
+  kFitContain,   // Largest size that fits, aspect kept (letter/pillarbox)
+  kFitCover,     // Smallest size that fills, aspect kept, overflow cropped
+  kFitStretch,   // Exactly the output size
+  kFitInteger,   // Largest whole multiple (or divisor) of the source size
+};
+
+enum PlacementFilter {
+  kFilterNearest = 0,
+  kFilterBox,       // Average of the source pixels each output pixel covers
+  kFilterBilinear,  // Linear blend of the four nearest source pixels
+};
+
+struct PlacementConfig {
+  int32_t enabled;    // 0 sends the source as-is, at its own size
+  int32_t width;      // Output raster; 0 uses the display mode's size
+  int32_t height;
+  int32_t fit;        // PlacementFit
+  int32_t filter;     // PlacementFilter
+  int32_t cropX;      // Source rectangle to place; width or height 0 places
+  int32_t cropY;      // the whole source
+  int32_t cropWidth;
+  int32_t cropHeight;
+  uint16_t surround[3];  // Code values outside the placed image
+  uint16_t reserved;
+};
+
+// Resolved geometry for one source size. The destination rectangle can
+// extend past the output (kFitNone, kFitCover); only the part inside is
+// drawn.
+struct PlacementMap {
+  bool identity;  // Source packed as-is: output size equals the source
+  int32_t sourceWidth;
+  int32_t sourceHeight;
+  int32_t outputWidth;
+  int32_t outputHeight;
+  int32_t cropX;
+  int32_t cropY;
+  int32_t cropWidth;
+  int32_t cropHeight;
+  int32_t destX;
+  int32_t destY;
+  int32_t destWidth;
+  int32_t destHeight;
+  int32_t filter;
+  uint16_t surround[3];
+};
+
+// Per-thread buffers of pack_placed_rows(), grown on demand
+struct PlacementScratch {
+  TrackedVector<uint16_t, kMemoryPackScratch> row;    // One output row, RGB
+  TrackedVector<uint32_t, kMemoryPackScratch> sums;   // One source row, RGB
+  TrackedVector<int32_t, kMemoryPackScratch> columns;  // Source x per column
+  TrackedVector<uint16_t, kMemoryPackScratch> weights;  // Bilinear x weights
+};
+
+// Resolves @p config for a @p sourceWidth x @p sourceHeight source onto a
+// @p outputWidth x @p outputHeight raster (the config's own size, when set,
+// takes precedence). A disabled config gives the identity map. Returns -1
+// for an invalid config or a crop rectangle outside the source.
+int placement_resolve(const PlacementConfig& config,
+                      int sourceWidth,
+                      int sourceHeight,
+                      int outputWidth,
+                      int outputHeight,
+                      PlacementMap* map);
+
+// Output rows [*firstRow, *lastRow) of @p map that read any of the source
+// rows [sourceFirstRow, sourceLastRow); an empty range if none does
+void placement_output_rows(const PlacementMap& map,
+                           int sourceFirstRow,
+                           int sourceLastRow,
+                           int* firstRow,
+                           int* lastRow);
+
+// Packs output rows [firstRow, lastRow) of @p map from the interleaved RGB
+// source @p srcData. Same statistics contract as pack_pixel_format_rows();
+// returns -8 if the format has no packer.
+int pack_placed_rows(void* destData,
+                     BMDPixelFormat pixelFormat,
+                     const uint16_t* srcData,
+                     const PlacementMap& map,
+                     int32_t rowBytes,
+                     int firstRow,
+                     int lastRow,
+                     PlacementScratch* scratch,
+                     PixelStats* stats = nullptr,
+                     const float* nitsLut = nullptr);
@@ -0,0 +1,227 @@
+#include "frame_pool.h"
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+#include "memory_stats.h"
+
+PooledVideoBuffer::PooledVideoBuffer(size_t size, bool lockMemory)
+    : m_data(nullptr), m_size(size), m_locked(false), m_refCount(1) {
+  const size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  if (posix_memalign(&m_data, pageSize, size) != 0) {
+    m_data = nullptr;
+    return;
+  }
+  memory_track_alloc(kMemoryFramePool, size);
+  // Touch every page now so the first frame does not take page faults
+  std::memset(m_data, 0, size);
+  if (lockMemory)
+    m_locked = mlock(m_data, size) == 0;
+}
+
+PooledVideoBuffer::~PooledVideoBuffer() {
+  if (m_locked)
+    munlock(m_data, m_size);
+  if (m_data)
+    memory_track_free(kMemoryFramePool, m_size);
+  std::free(m_data);
+}
+
+HRESULT PooledVideoBuffer::QueryInterface(REFIID iid, LPVOID* ppv) {
+  if (!ppv)
+    return E_INVALIDARG;
+
+  CFUUIDBytes iunknown = CFUUIDGetUUIDBytes(IUnknownUUID);
+  if (memcmp(&iid, &iunknown, sizeof(REFIID)) == 0 ||
+      memcmp(&iid, &IID_IDeckLinkVideoBuffer, sizeof(REFIID)) == 0) {
+    *ppv = static_cast<IDeckLinkVideoBuffer*>(this);
+    AddRef();
+    return S_OK;
+  }
+
+  *ppv = nullptr;
+  return E_NOINTERFACE;
+}
+
+ULONG PooledVideoBuffer::AddRef() {
+  return ++m_refCount;
+}
+
+ULONG PooledVideoBuffer::Release() {
+  ULONG newRefValue = --m_refCount;
+  if (newRefValue == 0)
+    delete this;
+  return newRefValue;
+}
+
+HRESULT PooledVideoBuffer::GetBytes(void** buffer) {
+  if (!buffer)
+    return E_POINTER;
+  *buffer = m_data;
+  return S_OK;
+}
+
+HRESULT PooledVideoBuffer::StartAccess(BMDBufferAccessFlags flags) {
+  return S_OK;
+}
+
+HRESULT PooledVideoBuffer::EndAccess(BMDBufferAccessFlags flags) {
+  return S_OK;
+}
+
+FramePool::FramePool()
+    : m_output(nullptr),
+      m_width(0),
+      m_height(0),
+      m_rowBytes(0),
+      m_pixelFormat(bmdFormatUnspecified),
+      m_lockMemory(false) {}
+
+FramePool::~FramePool() {
+  clear();
+}
+
+void FramePool::clear() {
+  // Buffers still wrapped by in-flight frames are freed by their last Release
+  for (PooledVideoBuffer* buffer : m_buffers)
+    buffer->Release();
+  m_buffers.clear();
+}
+
+/**
+ * @brief Prepares the pool for a frame geometry and pixel format
+ *
+ * Does nothing if the pool already matches. Otherwise the old buffers are
+ * dropped and @p capacity new ones are allocated (and optionally locked).
+ *
+ * @return int 0 on success, -3 if RowBytesForPixelFormat fails, -4 if a
+ *         buffer cannot be allocated
+ */
+int FramePool::configure(IDeckLinkOutput* output,
+                         int32_t width,
+                         int32_t height,
+                         BMDPixelFormat pixelFormat,
+                         int capacity,
+                         bool lockMemory) {
+  if (output == m_output && width == m_width && height == m_height &&
+      pixelFormat == m_pixelFormat && lockMemory == m_lockMemory &&
+      capacity == this->capacity())
+    return 0;
+
+  clear();
+  m_output = output;
+  m_width = width;
+  m_height = height;
+  m_pixelFormat = pixelFormat;
+  m_lockMemory = lockMemory;
+
+  int32_t rowBytes = 0;
+  if (output->RowBytesForPixelFormat(pixelFormat, width, &rowBytes) != S_OK) {
+    std::cerr << "[FramePool] RowBytesForPixelFormat failed" << std::endl;
+    m_rowBytes = 0;
+    return -3;
+  }
+  m_rowBytes = rowBytes;
+
+  const size_t size = static_cast<size_t>(rowBytes) * height;
+  for (int i = 0; i < capacity; i++) {
+    auto* buffer = new PooledVideoBuffer(size, lockMemory);
+    if (!buffer->valid()) {
+      buffer->Release();
+      clear();
+      std::cerr << "[FramePool] Could not allocate " << size << " byte buffer"
+                << std::endl;
+      return -4;
+    }
+    m_buffers.push_back(buffer);
+  }
+
+  if (lockMemory && !memoryLocked()) {
+    std::cerr << "[FramePool] Warning: mlock failed for some frame buffers "
+                 "(check RLIMIT_MEMLOCK)"
+              << std::endl;
+  }
+
+  return 0;
+}
+
+IDeckLinkMutableVideoFrame* FramePool::acquire(void** bytes) {
+  if (!m_output)
+    return nullptr;
+
+  for (PooledVideoBuffer* buffer : m_buffers) {
+    if (buffer->inUse())
+      continue;
+
+    IDeckLinkMutableVideoFrame* frame = nullptr;
+    HRESULT result = m_output->CreateVideoFrameWithBuffer(
+        m_width, m_height, m_rowBytes, m_pixelFormat, bmdFrameFlagDefault,
+        buffer, &frame);
+    if (result != S_OK || !frame) {
+      std::cerr << "[FramePool] CreateVideoFrameWithBuffer failed. HRESULT: 0x"
+                << std::hex << result << std::dec << std::endl;
+      return nullptr;
+    }
+    if (bytes)
+      *bytes = buffer->data();
+    return frame;
+  }
+
+  return nullptr;
+}
+
+int FramePool::available() const {
+  int count = 0;
+  for (const PooledVideoBuffer* buffer : m_buffers) {
+    if (!buffer->inUse())
+      count++;
+  }
+  return count;
+}
+
+bool FramePool::memoryLocked() const {
+  if (m_buffers.empty())
+    return false;
+  for (const PooledVideoBuffer* buffer : m_buffers) {
+    if (!buffer->locked())
+      return false;
+  }
+  return true;
+}
+
+int64_t FramePool::lockedBytes() const {
+  int64_t total = 0;
+  for (const PooledVideoBuffer* buffer : m_buffers) {
+    if (buffer->locked())
+      total += static_cast<int64_t>(buffer->size());
+  }
+  return total;
+}
+
+IDeckLinkMutableVideoFrame* rewrap_video_frame(
+    IDeckLinkOutput* output,
+    IDeckLinkMutableVideoFrame* frame) {
+  IDeckLinkVideoBuffer* buffer = nullptr;
+  if (frame->QueryInterface(IID_IDeckLinkVideoBuffer, (void**)&buffer) !=
+          S_OK ||
+      !buffer)
+    return nullptr;
+
+  IDeckLinkMutableVideoFrame* rewrapped = nullptr;
+  HRESULT result = output->CreateVideoFrameWithBuffer(
+      static_cast<int32_t>(frame->GetWidth()),
+      static_cast<int32_t>(frame->GetHeight()),
+      static_cast<int32_t>(frame->GetRowBytes()), frame->GetPixelFormat(),
+      bmdFrameFlagDefault, buffer, &rewrapped);
+  buffer->Release();
+  if (result != S_OK) {
+    std::cerr << "[FramePool] CreateVideoFrameWithBuffer failed. HRESULT: 0x"
+              << std::hex << result << std::dec << std::endl;
+    return nullptr;
+  }
+  return rewrapped;
+}
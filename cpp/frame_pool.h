@@ -0,0 +1,87 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "DeckLinkAPI.h"
+
+/*
+ * Preallocated video frame storage
+ *
+ * Frames are created with IDeckLinkOutput::CreateVideoFrameWithBuffer over
+ * page-aligned buffers owned by the pool, so steady-state output never
+ * allocates and the buffers can be mlock()ed. The pool holds one reference
+ * on each buffer; a buffer is free again once every frame wrapping it has
+ * been released by the SDK.
+ */
+
+class PooledVideoBuffer final : public IDeckLinkVideoBuffer {
+ public:
+  PooledVideoBuffer(size_t size, bool lockMemory);
+
+  // IUnknown
+  HRESULT QueryInterface(REFIID iid, LPVOID* ppv) override;
+  ULONG AddRef() override;
+  ULONG Release() override;
+
+  // IDeckLinkVideoBuffer
+  HRESULT GetBytes(void** buffer) override;
+  HRESULT StartAccess(BMDBufferAccessFlags flags) override;
+  HRESULT EndAccess(BMDBufferAccessFlags flags) override;
+
+  bool valid() const { return m_data != nullptr; }
+  bool locked() const { return m_locked; }
+  bool inUse() const { return m_refCount.load() > 1; }
+  size_t size() const { return m_size; }
+  void* data() const { return m_data; }
+
+ private:
+  ~PooledVideoBuffer() override;
+
+  void* m_data;
+  size_t m_size;
+  bool m_locked;
+  std::atomic<ULONG> m_refCount;
+};
+
+class FramePool {
+ public:
+  FramePool();
+  ~FramePool();
+
+  // (Re)allocates buffers if the geometry, format or locking changed
+  int configure(IDeckLinkOutput* output,
+                int32_t width,
+                int32_t height,
+                BMDPixelFormat pixelFormat,
+                int capacity,
+                bool lockMemory);
+  void clear();
+
+  // Wraps a free buffer in a new frame; returns nullptr if all are in use
+  IDeckLinkMutableVideoFrame* acquire(void** bytes);
+
+  int32_t rowBytes() const { return m_rowBytes; }
+  int capacity() const { return static_cast<int>(m_buffers.size()); }
+  int available() const;
+  bool memoryLocked() const;
+  int64_t lockedBytes() const;
+
+ private:
+  IDeckLinkOutput* m_output;
+  std::vector<PooledVideoBuffer*> m_buffers;
+  int32_t m_width;
+  int32_t m_height;
+  int32_t m_rowBytes;
+  BMDPixelFormat m_pixelFormat;
+  bool m_lockMemory;
+};
+
+// A second frame over the buffer of @p frame, so one buffer can be queued
+// more than once with different frame metadata. Returns nullptr if the
+// frame exposes no IDeckLinkVideoBuffer or the SDK refuses the frame.
+IDeckLinkMutableVideoFrame* rewrap_video_frame(
+    IDeckLinkOutput* output,
+    IDeckLinkMutableVideoFrame* frame);
@@ -0,0 +1,436 @@
+#include "frame_recorder.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+#if defined(__ARM_FEATURE_CRC32)
+#include <arm_acle.h>
+#endif
+
+#include "frame_timing.h"
+
+namespace {
+
+#if !defined(__ARM_FEATURE_CRC32)
+// Slice-by-8 tables: table[k][b] is the CRC of byte b followed by k zeros
+struct CrcTables {
+  uint32_t table[8][256];
+
+  CrcTables() {
+    for (uint32_t b = 0; b < 256; b++) {
+      uint32_t crc = b;
+      for (int bit = 0; bit < 8; bit++)
+        crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1)));
+      table[0][b] = crc;
+    }
+    for (uint32_t b = 0; b < 256; b++)
+      for (int k = 1; k < 8; k++)
+        table[k][b] =
+            (table[k - 1][b] >> 8) ^ table[0][table[k - 1][b] & 0xFF];
+  }
+};
+#endif
+
+uint8_t* allocateBlock(size_t size) {
+  void* data = nullptr;
+  if (posix_memalign(&data, kRecordingAlign, size) != 0)
+    return nullptr;
+  std::memset(data, 0, size);
+  memory_track_alloc(kMemoryRecorder, size);
+  return static_cast<uint8_t*>(data);
+}
+
+void freeBlock(uint8_t* data, size_t size) {
+  std::free(data);
+  memory_track_free(kMemoryRecorder, size);
+}
+
+}  // namespace
+
+uint32_t recording_crc32(uint32_t crc, const void* data, size_t size) {
+  const uint8_t* bytes = static_cast<const uint8_t*>(data);
+  crc = ~crc;
+#if defined(__ARM_FEATURE_CRC32)
+  for (; size >= 8; size -= 8, bytes += 8) {
+    uint64_t word;
+    std::memcpy(&word, bytes, sizeof(word));
+    crc = __crc32d(crc, word);
+  }
+  for (; size; size--)
+    crc = __crc32b(crc, *bytes++);
+#else
+  static const CrcTables tables;
+  const auto& t = tables.table;
+  for (; size >= 8; size -= 8, bytes += 8) {
+    uint32_t low;
+    uint32_t high;
+    std::memcpy(&low, bytes, sizeof(low));
+    std::memcpy(&high, bytes + 4, sizeof(high));
+    low ^= crc;
+    crc = t[7][low & 0xFF] ^ t[6][(low >> 8) & 0xFF] ^
+          t[5][(low >> 16) & 0xFF] ^ t[4][low >> 24] ^ t[3][high & 0xFF] ^
+          t[2][(high >> 8) & 0xFF] ^ t[1][(high >> 16) & 0xFF] ^
+          t[0][high >> 24];
+  }
+  for (; size; size--)
+    crc = (crc >> 8) ^ t[0][(crc ^ *bytes++) & 0xFF];
+#endif
+  return ~crc;
+}
+
+int64_t recording_padded_bytes(int64_t frameBytes) {
+  return (frameBytes + kRecordingAlign - 1) / kRecordingAlign *
+         kRecordingAlign;
+}
+
+RecordingHeader recording_header(uint32_t displayMode,
+                                 uint32_t pixelFormat,
+                                 int64_t frameIntervalNs) {
+  RecordingHeader header = {};
+  std::memcpy(header.magic, kRecordingMagic, sizeof(header.magic));
+  header.version = kRecordingVersion;
+  header.align = kRecordingAlign;
+  header.recordSize = sizeof(RecordedFrame);
+  header.displayMode = displayMode;
+  header.pixelFormat = pixelFormat;
+  header.frameIntervalNs = frameIntervalNs;
+  header.startedNs = FrameTimingAnalyzer::nowNs();
+  return header;
+}
+
+FrameRecorder::FrameRecorder()
+    : m_active(false),
+      m_stopping(false),
+      m_fd(-1),
+      m_slotBytes(0),
+      m_copying(0),
+      m_stats{},
+      m_copied(0),
+      m_totalCopyNs(0),
+      m_totalWriteNs(0) {}
+
+FrameRecorder::~FrameRecorder() {
+  stop();
+}
+
+/**
+ * @brief Creates the recording file and starts the writer thread
+ *
+ * The slots are allocated here, so recording allocates nothing per frame.
+ * If the file system refuses unbuffered I/O the file is written through
+ * the page cache instead, which stats() reports.
+ */
+int FrameRecorder::start(const char* path,
+                         const RecorderConfig& config,
+                         int64_t maxFrameBytes,
+                         const RecordingHeader& header) {
+  if (!path || config.slots < 1 || config.slots > kRecorderMaxSlots ||
+      maxFrameBytes <= 0)
+    return -1;
+  stop();
+
+  const int flags = O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC;
+  bool direct = false;
+  int fd = -1;
+#if defined(O_DIRECT)
+  if (config.direct) {
+    fd = ::open(path, flags | O_DIRECT, 0644);
+    direct = fd >= 0;
+  }
+#endif
+  if (fd < 0)
+    fd = ::open(path, flags, 0644);
+  if (fd < 0) {
+    std::cerr << "[FrameRecorder] Cannot create " << path << ": "
+              << std::strerror(errno) << std::endl;
+    return -2;
+  }
+#if defined(__APPLE__)
+  if (config.direct)
+    direct = fcntl(fd, F_NOCACHE, 1) == 0;
+#endif
+
+  const size_t slotBytes =
+      kRecordingAlign + static_cast<size_t>(recording_padded_bytes(
+                            maxFrameBytes));
+  uint8_t* headerBlock = allocateBlock(kRecordingAlign);
+  bool ok = headerBlock != nullptr;
+  std::vector<uint8_t*> slots;
+  for (int i = 0; ok && i < config.slots; i++) {
+    slots.push_back(allocateBlock(slotBytes));
+    ok = slots.back() != nullptr;
+  }
+  if (ok) {
+    std::memcpy(headerBlock, &header, sizeof(header));
+    m_fd = fd;
+    ok = writeAll(headerBlock, kRecordingAlign);
+  }
+  if (headerBlock)
+    freeBlock(headerBlock, kRecordingAlign);
+  if (!ok) {
+    const int error = errno;
+    for (uint8_t* slot : slots)
+      if (slot)
+        freeBlock(slot, slotBytes);
+    ::close(fd);
+    m_fd = -1;
+    std::cerr << "[FrameRecorder] Cannot start recording to " << path << ": "
+              << std::strerror(error) << std::endl;
+    return -3;
+  }
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_slotBytes = slotBytes;
+  m_slots = std::move(slots);
+  m_free.clear();
+  for (int i = config.slots - 1; i >= 0; i--)
+    m_free.push_back(i);
+  m_filled.clear();
+  m_copying = 0;
+  m_stopping = false;
+  m_copied = 0;
+  m_totalCopyNs = 0;
+  m_totalWriteNs = 0;
+  m_stats = {};
+  m_stats.running = 1;
+  m_stats.slots = config.slots;
+  m_stats.direct = direct ? 1 : 0;
+  m_stats.slotBytes = maxFrameBytes;
+  m_stats.bytesWritten = kRecordingAlign;
+  m_writer = std::thread(&FrameRecorder::writeLoop, this);
+  m_active = true;
+  std::cerr << "[FrameRecorder] Recording to " << path << " with "
+            << config.slots << " slot(s) of " << maxFrameBytes << " bytes"
+            << (direct ? ", bypassing the page cache" : "") << std::endl;
+  return 0;
+}
+
+void FrameRecorder::stop() {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_writer.joinable())
+      return;
+    m_active = false;
+    m_stopping = true;
+  }
+  m_changed.notify_all();
+  m_writer.join();
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  ::close(m_fd);
+  m_fd = -1;
+  releaseSlots();
+  m_stats.running = 0;
+  std::cerr << "[FrameRecorder] Recorded " << m_stats.recorded << " of "
+            << m_stats.offered << " frame(s), " << m_stats.bytesWritten
+            << " bytes" << std::endl;
+}
+
+RecorderStats FrameRecorder::stats() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  RecorderStats stats = m_stats;
+  stats.meanCopyNs = m_copied ? m_totalCopyNs / m_copied : 0;
+  stats.meanWriteNs = stats.recorded ? m_totalWriteNs / stats.recorded : 0;
+  return stats;
+}
+
+/**
+ * @brief Copies a packed frame into a free slot for the writer
+ *
+ * The only work on the calling (output) thread is the copy; the slot is
+ * taken and handed over under the lock, the copy runs without it.
+ */
+void FrameRecorder::record(const void* frameData, const RecordedFrame& frame) {
+  if (!active())
+    return;
+  const int64_t startNs = FrameTimingAnalyzer::nowNs();
+  RecordedFrame info = frame;
+  int index = -1;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_active)
+      return;
+    info.sequence = m_stats.offered++;
+    if (info.frameBytes > m_stats.slotBytes) {
+      m_stats.oversized++;
+      return;
+    }
+    if (m_free.empty()) {
+      m_stats.dropped++;
+      return;
+    }
+    index = m_free.back();
+    m_free.pop_back();
+    m_copying++;
+  }
+
+  uint8_t* slot = m_slots[index];
+  info.crc32 = 0;  // Computed by the writer
+  std::memcpy(slot, &info, sizeof(info));
+  std::memcpy(slot + kRecordingAlign, frameData,
+              static_cast<size_t>(info.frameBytes));
+
+  const int64_t elapsedNs = FrameTimingAnalyzer::nowNs() - startNs;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_filled.push_back(index);
+    m_copying--;
+    m_copied++;
+    m_totalCopyNs += elapsedNs;
+    m_stats.maxCopyNs = std::max(m_stats.maxCopyNs, elapsedNs);
+  }
+  m_changed.notify_all();
+}
+
+void FrameRecorder::writeLoop() {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  while (true) {
+    // Once stopping, frames still being copied are waited for and written
+    m_changed.wait(lock, [this] {
+      return !m_filled.empty() || (m_stopping && m_copying == 0);
+    });
+    if (m_filled.empty())
+      return;
+    const int index = m_filled.front();
+    m_filled.pop_front();
+    const bool failed = m_stats.lastError != 0;
+    lock.unlock();
+
+    uint8_t* slot = m_slots[index];
+    auto* frame = reinterpret_cast<RecordedFrame*>(slot);
+    const size_t frameBytes = static_cast<size_t>(frame->frameBytes);
+    const size_t paddedBytes =
+        static_cast<size_t>(recording_padded_bytes(frame->frameBytes));
+    const int64_t startNs = FrameTimingAnalyzer::nowNs();
+    bool ok = false;
+    int error = 0;
+    if (!failed) {
+      frame->crc32 =
+          recording_crc32(0, slot + kRecordingAlign, frameBytes);
+      std::memset(slot + kRecordingAlign + frameBytes, 0,
+                  paddedBytes - frameBytes);
+      ok = writeAll(slot, kRecordingAlign + paddedBytes);
+      error = ok ? 0 : errno;
+    }
+    const int64_t elapsedNs = FrameTimingAnalyzer::nowNs() - startNs;
+
+    lock.lock();
+    m_free.push_back(index);
+    if (ok) {
+      m_stats.recorded++;
+      m_stats.bytesWritten += static_cast<int64_t>(kRecordingAlign +
+                                                   paddedBytes);
+      m_totalWriteNs += elapsedNs;
+      m_stats.maxWriteNs = std::max(m_stats.maxWriteNs, elapsedNs);
+    } else if (!failed) {
+      // A full or failing disk ends the recording, not the output
+      m_stats.lastError = error ? error : EIO;
+      m_active = false;
+      std::cerr << "[FrameRecorder] Write failed, recording stopped: "
+                << std::strerror(m_stats.lastError) << std::endl;
+    }
+  }
+}
+
+bool FrameRecorder::writeAll(const uint8_t* data, size_t size) {
+  while (size) {
+    const ssize_t count = ::write(m_fd, data, size);
+    if (count < 0) {
+      if (errno == EINTR)
+        continue;
+      return false;
+    }
+    if (count == 0) {
+      errno = EIO;
+      return false;
+    }
+    data += count;
+    size -= static_cast<size_t>(count);
+  }
+  return true;
+}
+
+void FrameRecorder::releaseSlots() {
+  for (uint8_t* slot : m_slots)
+    freeBlock(slot, m_slotBytes);
+  m_slots.clear();
+  m_free.clear();
+  m_filled.clear();
+}
+
+RecordingReader::RecordingReader() : m_fd(-1), m_header{} {}
+
+RecordingReader::~RecordingReader() {
+  if (m_fd >= 0)
+    ::close(m_fd);
+}
+
+int RecordingReader::open(const char* path) {
+  if (m_fd >= 0)
+    ::close(m_fd);
+  m_fd = path ? ::open(path, O_RDONLY | O_CLOEXEC) : -1;
+  if (m_fd < 0)
+    return -1;
+
+  std::vector<uint8_t> block(kRecordingAlign);
+  if (!readAll(block.data(), block.size()))
+    return -2;
+  std::memcpy(&m_header, block.data(), sizeof(m_header));
+  if (std::memcmp(m_header.magic, kRecordingMagic, sizeof(kRecordingMagic)) ||
+      m_header.version != kRecordingVersion ||
+      m_header.align != kRecordingAlign ||
+      m_header.recordSize != sizeof(RecordedFrame))
+    return -2;
+  return 0;
+}
+
+int RecordingReader::next(RecordedFrame* frame) {
+  uint8_t block[kRecordingAlign];
+  size_t got = 0;
+  while (got < sizeof(block)) {
+    const ssize_t count = ::read(m_fd, block + got, sizeof(block) - got);
+    if (count < 0 && errno == EINTR)
+      continue;
+    if (count < 0)
+      return -2;
+    if (count == 0)
+      return got == 0 ? 0 : -2;
+    got += static_cast<size_t>(count);
+  }
+  std::memcpy(frame, block, sizeof(*frame));
+  if (frame->width <= 0 || frame->height <= 0 || frame->rowBytes <= 0 ||
+      frame->frameBytes !=
+          static_cast<int64_t>(frame->rowBytes) * frame->height)
+    return -2;
+  return 1;
+}
+
+int RecordingReader::readData(const RecordedFrame& frame, void* data) {
+  if (!readAll(data,
+               static_cast<size_t>(recording_padded_bytes(frame.frameBytes))))
+    return -2;
+  if (recording_crc32(0, data, static_cast<size_t>(frame.frameBytes)) !=
+      frame.crc32)
+    return -5;
+  return 0;
+}
+
+bool RecordingReader::readAll(void* data, size_t size) {
+  uint8_t* bytes = static_cast<uint8_t*>(data);
+  while (size) {
+    const ssize_t count = ::read(m_fd, bytes, size);
+    if (count < 0 && errno == EINTR)
+      continue;
+    if (count <= 0)
+      return false;
+    bytes += count;
+    size -= static_cast<size_t>(count);
+  }
+  return true;
+}
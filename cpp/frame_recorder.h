@@ -0,0 +1,175 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "hdr_metadata.h"
+#include "memory_stats.h"
+
+/*
+ * Recording of the packed output stream
+ *
+ * Every packed frame that leaves the library, after overlays and as it goes
+ * to the device, can be copied into one of a fixed set of preallocated slots
+ * and written to a file by a writer thread behind a telemetry record. The
+ * output thread only copies: a frame that finds every slot still waiting for
+ * the disk is left out of the recording and counted, never waited for. The
+ * CRC of each frame is computed on the writer thread. Slots are page aligned
+ * and written as whole pages with the page cache bypassed (O_DIRECT on
+ * Linux, F_NOCACHE on macOS), so a long recording neither evicts the
+ * process's working set nor piles up dirty pages to flush.
+ *
+ * File layout: a kRecordingAlign-byte block holding the RecordingHeader, then
+ * per frame a kRecordingAlign-byte block holding its RecordedFrame followed
+ * by its packed rows, zero padded to a multiple of kRecordingAlign. Fields
+ * are in the recording host's byte order.
+ */
+
+constexpr int kRecordingAlign = 4096;
+constexpr int kRecorderMaxSlots = 64;
+constexpr uint32_t kRecordingVersion = 1;
+constexpr char kRecordingMagic[8] = {'B', 'M', 'D', 'R', 'E', 'C', 0, 0};
+
+// Where a recorded frame left the library
+enum RecordedSource : int32_t {
+  kRecordedDisplay = 0,  // Synchronous display, including cached frames
+  kRecordedPipelined,    // Pipelined output
+  kRecordedScheduled,    // Deadline-scheduled output
+  kRecordedStream,       // Raw frame stream input
+  kRecordedExternal,     // Caller-owned packed frames
+  kRecordedClip,         // FRC clip frames, once each when packed
+};
+
+struct RecordingHeader {
+  char magic[8];  // kRecordingMagic
+  uint32_t version;
+  uint32_t align;       // kRecordingAlign
+  uint32_t recordSize;  // sizeof(RecordedFrame)
+  uint32_t displayMode;
+  uint32_t pixelFormat;  // When recording started
+  int32_t reserved;
+  int64_t frameIntervalNs;  // Nominal, of the display mode
+  int64_t startedNs;        // steady_clock time recording started
+};
+
+struct RecordedFrame {
+  int64_t sequence;     // Frames offered before this one; gaps are drops
+  int64_t timestampNs;  // steady_clock time the frame left the library
+  int64_t traceFrameId;
+  int64_t frameBytes;  // rowBytes * height of packed data after the record
+  uint32_t pixelFormat;
+  int32_t width;
+  int32_t height;
+  int32_t rowBytes;
+  int32_t source;  // RecordedSource
+  uint32_t crc32;  // CRC-32 of the packed data, as zlib computes it
+  HDRMetadata metadata;  // Sent with the frame when EOTF is PQ or HLG
+};
+
+struct RecorderConfig {
+  int32_t slots;   // Frames copied but not yet written (1-64)
+  int32_t direct;  // Bypass the page cache
+};
+
+struct RecorderStats {
+  int32_t running;
+  int32_t slots;
+  int32_t direct;     // The page cache is actually bypassed
+  int32_t lastError;  // errno of the write that ended the recording
+  int64_t slotBytes;  // Largest frame a slot holds
+  int64_t offered;    // Frames that left the library while recording
+  int64_t recorded;   // Frames written
+  int64_t dropped;    // Frames that found no free slot
+  int64_t oversized;  // Frames larger than a slot
+  int64_t bytesWritten;
+  int64_t meanCopyNs;  // Time a frame costs the output thread
+  int64_t maxCopyNs;
+  int64_t meanWriteNs;  // CRC and write, on the writer thread
+  int64_t maxWriteNs;
+};
+
+// CRC-32 (IEEE, reflected), continuing from @p crc (0 to start)
+uint32_t recording_crc32(uint32_t crc, const void* data, size_t size);
+
+// Bytes a frame occupies in a recording after its record block
+int64_t recording_padded_bytes(int64_t frameBytes);
+
+// Header of a recording started now
+RecordingHeader recording_header(uint32_t displayMode,
+                                 uint32_t pixelFormat,
+                                 int64_t frameIntervalNs);
+
+class FrameRecorder {
+ public:
+  FrameRecorder();
+  ~FrameRecorder();
+
+  // Creates @p path, replacing it, and starts the writer. Each slot holds a
+  // frame of up to @p maxFrameBytes. Returns -1 for invalid arguments, -2 if
+  // the file cannot be created and -3 if the slots cannot be allocated.
+  int start(const char* path,
+            const RecorderConfig& config,
+            int64_t maxFrameBytes,
+            const RecordingHeader& header);
+  // Writes the frames already copied, then closes the file
+  void stop();
+  bool active() const { return m_active.load(std::memory_order_relaxed); }
+  RecorderStats stats() const;
+
+  // Copies a packed frame to be written, or counts it as dropped. @p frame
+  // describes it; its sequence and crc32 are filled in here. Safe from any
+  // output thread.
+  void record(const void* frameData, const RecordedFrame& frame);
+
+ private:
+  void writeLoop();
+  bool writeAll(const uint8_t* data, size_t size);
+  void releaseSlots();
+
+  mutable std::mutex m_mutex;
+  std::condition_variable m_changed;
+  std::thread m_writer;
+  std::atomic<bool> m_active;
+  bool m_stopping;
+  int m_fd;
+  size_t m_slotBytes;  // Record block plus the padded frame
+  std::vector<uint8_t*> m_slots;
+  std::vector<int> m_free;
+  std::deque<int> m_filled;  // In the order they were filled
+  int m_copying;             // Slots taken and still being filled
+  RecorderStats m_stats;
+  int64_t m_copied;
+  int64_t m_totalCopyNs;
+  int64_t m_totalWriteNs;
+};
+
+// Reads a recording frame by frame
+class RecordingReader {
+ public:
+  RecordingReader();
+  ~RecordingReader();
+
+  // Returns -1 if the file cannot be opened and -2 if it is not a recording
+  // of this version
+  int open(const char* path);
+  const RecordingHeader& header() const { return m_header; }
+
+  // Reads the next frame's record; returns 1 for a frame, 0 at the end of
+  // the file and -2 if the record is truncated or invalid
+  int next(RecordedFrame* frame);
+  // Reads the data of the frame next() returned into @p data, which holds
+  // recording_padded_bytes(frame.frameBytes) bytes; returns 0, -2 if the data
+  // is truncated or -5 if its CRC does not match
+  int readData(const RecordedFrame& frame, void* data);
+
+ private:
+  bool readAll(void* data, size_t size);
+
+  int m_fd;
+  RecordingHeader m_header;
+};
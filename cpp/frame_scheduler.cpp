@@ -0,0 +1,586 @@
+#include "frame_scheduler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+
+#include "trace.h"
+
+FrameScheduler::FrameScheduler()
+    : m_output(nullptr),
+      m_timing(nullptr),
+      m_config{},
+      m_lead(0),
+      m_frameDuration(0),
+      m_timeScale(0),
+      m_committedEnd(0),
+      m_nextFrameId(1),
+      m_running(false),
+      m_stopping(false),
+      m_stopPending(false),
+      m_delayNs{},
+      m_jitterNs{},
+      m_samples(0),
+      m_lastEndSlot(-1),
+      m_lastHostNs(0),
+      m_raisedBefore(-1),
+      m_samplesSinceChange(0),
+      m_stats{},
+      m_decisions{},
+      m_decisionCount(0),
+      m_leadChanges{},
+      m_leadChangeCount(0) {}
+
+FrameScheduler::~FrameScheduler() {
+  stop();
+}
+
+HRESULT FrameScheduler::QueryInterface(REFIID iid, LPVOID* ppv) {
+  if (!ppv)
+    return E_INVALIDARG;
+
+  CFUUIDBytes iunknown = CFUUIDGetUUIDBytes(IUnknownUUID);
+  if (memcmp(&iid, &iunknown, sizeof(REFIID)) == 0 ||
+      memcmp(&iid, &IID_IDeckLinkVideoOutputCallback, sizeof(REFIID)) == 0) {
+    *ppv = static_cast<IDeckLinkVideoOutputCallback*>(this);
+    return S_OK;
+  }
+
+  *ppv = nullptr;
+  return E_NOINTERFACE;
+}
+
+/**
+ * @brief Starts scheduled playback for deadline-scheduled frames
+ *
+ * The stream clock starts at zero with nothing queued; frames submitted
+ * afterwards are placed relative to it. An adaptive lead starts at
+ * leadFrames, which must lie within its bounds.
+ *
+ * @return int 0 on success, -1 on invalid arguments, -3 if the SDK rejects
+ *         the callback or the playback start
+ */
+int FrameScheduler::start(IDeckLinkOutput* output,
+                          const SchedulerConfig& config,
+                          BMDTimeValue frameDuration,
+                          BMDTimeScale timeScale,
+                          FrameTimingAnalyzer* timing) {
+  if (!output || frameDuration <= 0 || timeScale <= 0 ||
+      config.leadFrames < 1 || config.leadFrames > 8 ||
+      config.maxPending < 1 || config.maxPending > 32 ||
+      (config.adaptive &&
+       (config.minLeadFrames < 1 || config.minLeadFrames > config.leadFrames ||
+        config.maxLeadFrames < config.leadFrames ||
+        config.maxLeadFrames > 8)) ||
+      (config.policy != kSchedulerStrict &&
+       config.policy != kSchedulerLatestWins))
+    return -1;
+  stop();
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_output = output;
+  m_timing = timing;
+  m_config = config;
+  m_lead = config.leadFrames;
+  m_frameDuration = frameDuration;
+  m_timeScale = timeScale;
+  m_committedEnd = 0;
+  m_nextFrameId = 1;
+  m_decisionCount = 0;
+  m_inFlight.clear();
+  m_samples = 0;
+  m_lastEndSlot = -1;
+  m_raisedBefore = -1;
+  m_samplesSinceChange = 0;
+  m_leadChangeCount = 0;
+  m_stats = {};
+
+  HRESULT result = m_output->SetScheduledFrameCompletionCallback(this);
+  if (result == S_OK)
+    result = m_output->StartScheduledPlayback(0, m_timeScale, 1.0);
+  if (result != S_OK) {
+    std::cerr << "[FrameScheduler] Could not start scheduled playback. "
+                 "HRESULT: 0x"
+              << std::hex << result << std::dec << std::endl;
+    m_output->SetScheduledFrameCompletionCallback(nullptr);
+    m_output = nullptr;
+    return -3;
+  }
+
+  m_running = true;
+  m_stopping = false;
+  m_stats.running = 1;
+  m_stats.policy = config.policy;
+  m_stats.leadFrames = config.leadFrames;
+  m_stats.frameDurationNs = slotNs(1);
+  m_stats.adaptive = config.adaptive ? 1 : 0;
+  m_stats.minLeadFrames =
+      config.adaptive ? config.minLeadFrames : config.leadFrames;
+  m_stats.maxLeadFrames =
+      config.adaptive ? config.maxLeadFrames : config.leadFrames;
+  m_stats.neededLeadFrames = config.leadFrames;
+  m_thread = std::thread(&FrameScheduler::dispatchLoop, this);
+  std::cerr << "[FrameScheduler] Started ("
+            << (config.policy == kSchedulerStrict ? "strict" : "latest-wins")
+            << ", " << config.leadFrames << " frame lead";
+  if (config.adaptive)
+    std::cerr << ", adaptive " << config.minLeadFrames << "-"
+              << config.maxLeadFrames;
+  std::cerr << ")" << std::endl;
+  return 0;
+}
+
+int FrameScheduler::stop() {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_running)
+      return 0;
+    m_stopping = true;
+  }
+  m_wake.notify_all();
+  m_thread.join();
+
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_running = false;
+  m_stats.running = 0;
+  m_stopPending = true;
+  lock.unlock();
+  // Queued frames come back as flushed completions, then the stop callback
+  m_output->StopScheduledPlayback(0, nullptr, 0);
+  lock.lock();
+  if (!m_stopped.wait_for(lock, std::chrono::seconds(2),
+                          [this] { return !m_stopPending; })) {
+    std::cerr << "[FrameScheduler] Timed out waiting for playback to stop"
+              << std::endl;
+    m_stopPending = false;
+  }
+
+  m_output->SetScheduledFrameCompletionCallback(nullptr);
+  for (PendingFrame& pending : m_pending)
+    pending.frame->Release();
+  m_pending.clear();
+  m_inFlight.clear();
+  m_output = nullptr;
+  m_timing = nullptr;
+  return 0;
+}
+
+bool FrameScheduler::running() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_running;
+}
+
+bool FrameScheduler::rejectBeforePack(int64_t targetNs,
+                                      int32_t durationFrames,
+                                      SchedulerDecisionRecord* record) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (!m_running || m_config.policy != kSchedulerStrict)
+    return false;
+
+  const int64_t earliest = earliestSlotLocked(currentSlotLocked());
+  const int64_t tail = m_pending.empty() ? earliest - 1 : m_pending.back().slot;
+  const int64_t slot =
+      targetNs > 0 ? slotForNs(targetNs) : std::max(earliest, tail + 1);
+  SchedulerDecision decision;
+  if (slot < earliest || slot <= tail)
+    decision = kDecisionDroppedLate;
+  else if (static_cast<int>(m_pending.size()) >= m_config.maxPending)
+    decision = kDecisionQueueFull;
+  else
+    return false;
+
+  m_stats.submitted++;
+  recordLocked(m_nextFrameId++, targetNs, -1, durationFrames, decision,
+               record);
+  return true;
+}
+
+/**
+ * @brief Places a packed frame on the slot timeline
+ *
+ * Under kSchedulerStrict a frame is accepted only for a slot after every
+ * queued or dispatched one that has not started yet. Under
+ * kSchedulerLatestWins it replaces queued frames from its slot on and is
+ * moved to the next free slot if its own has passed.
+ *
+ * @return int 0 with the decision in @p record, -1 if not running
+ */
+int FrameScheduler::submit(IDeckLinkMutableVideoFrame* frame,
+                           int64_t targetNs,
+                           int32_t durationFrames,
+                           SchedulerDecisionRecord* record) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (!m_running || !frame || durationFrames < 1) {
+    if (frame)
+      frame->Release();
+    return -1;
+  }
+
+  m_stats.submitted++;
+  const int64_t frameId = m_nextFrameId++;
+  const int64_t earliest = earliestSlotLocked(currentSlotLocked());
+  int64_t slot;
+  SchedulerDecision decision = kDecisionQueued;
+
+  if (m_config.policy == kSchedulerStrict) {
+    const int64_t tail =
+        m_pending.empty() ? earliest - 1 : m_pending.back().slot;
+    slot = targetNs > 0 ? slotForNs(targetNs) : std::max(earliest, tail + 1);
+    if (slot < earliest || slot <= tail)
+      decision = kDecisionDroppedLate;
+    else if (static_cast<int>(m_pending.size()) >= m_config.maxPending)
+      decision = kDecisionQueueFull;
+    if (decision != kDecisionQueued) {
+      frame->Release();
+      recordLocked(frameId, targetNs, -1, durationFrames, decision, record);
+      return 0;
+    }
+  } else {
+    slot = targetNs > 0 ? slotForNs(targetNs) : earliest;
+    if (slot < earliest) {
+      slot = earliest;
+      decision = kDecisionLate;
+    }
+    supersedeFromLocked(slot);
+    while (static_cast<int>(m_pending.size()) >= m_config.maxPending)
+      supersedeFromLocked(m_pending.front().slot);
+  }
+
+  m_pending.push_back({frame, frameId, targetNs, slot, durationFrames,
+                       trace_current_frame(), trace_now_ns()});
+  recordLocked(frameId, targetNs, slot, durationFrames, decision, record);
+  dispatchLocked();
+  return 0;
+}
+
+SchedulerStats FrameScheduler::stats() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  SchedulerStats stats = m_stats;
+  stats.pending = static_cast<int32_t>(m_pending.size());
+  if (m_running) {
+    stats.streamTimeNs = streamTimeNsLocked();
+    stats.currentSlot = currentSlotLocked();
+  }
+  return stats;
+}
+
+int FrameScheduler::decisions(SchedulerDecisionRecord* out,
+                              int maxCount) const {
+  if (!out || maxCount <= 0)
+    return 0;
+  std::lock_guard<std::mutex> lock(m_mutex);
+  const int64_t count = std::min<int64_t>(
+      {m_decisionCount, kSchedulerMaxDecisions, maxCount});
+  const int64_t first = m_decisionCount - count;
+  for (int64_t i = 0; i < count; i++)
+    out[i] = m_decisions[(first + i) % kSchedulerMaxDecisions];
+  return static_cast<int>(count);
+}
+
+int FrameScheduler::leadChanges(SchedulerLeadChange* out, int maxCount) const {
+  if (!out || maxCount <= 0)
+    return 0;
+  std::lock_guard<std::mutex> lock(m_mutex);
+  const int64_t count = std::min<int64_t>(
+      {m_leadChangeCount, kSchedulerMaxLeadChanges, maxCount});
+  const int64_t first = m_leadChangeCount - count;
+  for (int64_t i = 0; i < count; i++)
+    out[i] = m_leadChanges[(first + i) % kSchedulerMaxLeadChanges];
+  return static_cast<int>(count);
+}
+
+int64_t FrameScheduler::streamTimeNsLocked() const {
+  BMDTimeValue streamTime = 0;
+  double speed = 0.0;
+  if (m_output->GetScheduledStreamTime(m_timeScale, &streamTime, &speed) !=
+      S_OK)
+    return 0;
+  return static_cast<int64_t>(static_cast<long double>(streamTime) * 1e9L /
+                              m_timeScale);
+}
+
+int64_t FrameScheduler::currentSlotLocked() const {
+  BMDTimeValue streamTime = 0;
+  double speed = 0.0;
+  if (m_output->GetScheduledStreamTime(m_timeScale, &streamTime, &speed) !=
+      S_OK)
+    return 0;
+  return streamTime / m_frameDuration;
+}
+
+// First slot starting at or after @p ns on the stream clock
+int64_t FrameScheduler::slotForNs(int64_t ns) const {
+  const long double slots = static_cast<long double>(ns) * m_timeScale /
+                            (1e9L * m_frameDuration);
+  return static_cast<int64_t>(std::ceil(slots - 1e-9L));
+}
+
+int64_t FrameScheduler::slotNs(int64_t slot) const {
+  return static_cast<int64_t>(static_cast<long double>(slot) *
+                              m_frameDuration * 1e9L / m_timeScale);
+}
+
+// The slot being displayed cannot change, nor can dispatched ones
+int64_t FrameScheduler::earliestSlotLocked(int64_t currentSlot) const {
+  return std::max(currentSlot + 1, m_committedEnd);
+}
+
+void FrameScheduler::recordLocked(int64_t frameId,
+                                  int64_t targetNs,
+                                  int64_t slot,
+                                  int32_t durationFrames,
+                                  SchedulerDecision decision,
+                                  SchedulerDecisionRecord* out) {
+  switch (decision) {
+    case kDecisionQueued:
+      m_stats.queued++;
+      break;
+    case kDecisionLate:
+      m_stats.late++;
+      break;
+    case kDecisionDroppedLate:
+      m_stats.droppedLate++;
+      break;
+    case kDecisionSuperseded:
+      m_stats.superseded++;
+      break;
+    case kDecisionQueueFull:
+      m_stats.queueFull++;
+      break;
+    case kDecisionDispatched:
+      m_stats.dispatched++;
+      break;
+  }
+
+  SchedulerDecisionRecord& record =
+      m_decisions[m_decisionCount++ % kSchedulerMaxDecisions];
+  record.frameId = frameId;
+  record.targetNs = targetNs;
+  record.slot = slot;
+  record.slotNs = slot >= 0 ? slotNs(slot) : -1;
+  record.decidedNs = streamTimeNsLocked();
+  record.decision = decision;
+  record.durationFrames = durationFrames;
+  if (out)
+    *out = record;
+}
+
+// Drops every queued frame targeting @p slot or later
+void FrameScheduler::supersedeFromLocked(int64_t slot) {
+  while (!m_pending.empty() && m_pending.back().slot >= slot) {
+    PendingFrame& pending = m_pending.back();
+    pending.frame->Release();
+    recordLocked(pending.frameId, pending.targetNs, -1, pending.durationFrames,
+                 kDecisionSuperseded, nullptr);
+    m_pending.pop_back();
+  }
+}
+
+/**
+ * @brief Hands queued frames whose slot is within the lead to the SDK
+ *
+ * A frame is shown until the next queued frame's slot or for its own
+ * duration, whichever ends first, so schedules never overlap.
+ */
+void FrameScheduler::dispatchLocked() {
+  const int64_t current = currentSlotLocked();
+  while (!m_pending.empty() && m_pending.front().slot <= current + m_lead) {
+    PendingFrame pending = m_pending.front();
+    m_pending.pop_front();
+
+    const int64_t earliest = earliestSlotLocked(current);
+    if (pending.slot < earliest) {
+      // The queue fell behind the output clock
+      if (pending.slot >= m_raisedBefore)
+        raiseLeadLocked(-1, kLeadDispatchLate);
+      if (m_config.policy == kSchedulerStrict) {
+        pending.frame->Release();
+        recordLocked(pending.frameId, pending.targetNs, -1,
+                     pending.durationFrames, kDecisionDroppedLate, nullptr);
+        continue;
+      }
+      pending.slot = earliest;
+      recordLocked(pending.frameId, pending.targetNs, pending.slot,
+                   pending.durationFrames, kDecisionLate, nullptr);
+    }
+
+    int64_t duration = pending.durationFrames;
+    if (!m_pending.empty())
+      duration = std::clamp<int64_t>(m_pending.front().slot - pending.slot, 1,
+                                     duration);
+
+    const int64_t dispatchNs = trace_now_ns();
+    trace_record(kTraceQueue, pending.queuedNs, dispatchNs,
+                 pending.traceFrameId);
+    HRESULT result = m_output->ScheduleVideoFrame(
+        pending.frame, pending.slot * m_frameDuration,
+        duration * m_frameDuration, m_timeScale);
+    const int64_t dispatchedNs = trace_now_ns();
+    trace_record(kTraceDispatch, dispatchNs, dispatchedNs,
+                 pending.traceFrameId);
+    pending.frame->Release();
+    if (result != S_OK) {
+      std::cerr << "[FrameScheduler] ScheduleVideoFrame failed for slot "
+                << pending.slot << ". HRESULT: 0x" << std::hex << result
+                << std::dec << std::endl;
+      recordLocked(pending.frameId, pending.targetNs, -1,
+                   pending.durationFrames, kDecisionDroppedLate, nullptr);
+      continue;
+    }
+    m_committedEnd = pending.slot + duration;
+    m_inFlight.push_back({static_cast<IDeckLinkVideoFrame*>(pending.frame),
+                          m_committedEnd, pending.traceFrameId,
+                          dispatchedNs});
+    recordLocked(pending.frameId, pending.targetNs, pending.slot,
+                 static_cast<int32_t>(duration), kDecisionDispatched, nullptr);
+  }
+}
+
+// Wakes twice per frame so queued frames are dispatched without new input
+void FrameScheduler::dispatchLoop() {
+  trace_name_thread("scheduler dispatch");
+  std::unique_lock<std::mutex> lock(m_mutex);
+  const auto period = std::chrono::nanoseconds(
+      std::max<int64_t>(slotNs(1) / 2, 1000000));
+  while (!m_stopping) {
+    dispatchLocked();
+    m_wake.wait_for(lock, period);
+  }
+}
+
+/**
+ * @brief Samples a displayed frame's completion and retunes the lead
+ *
+ * The completion delay past the end of the frame's slot has a steady part
+ * (the driver's own completion latency), so only its excess over the window
+ * minimum counts as lateness.
+ */
+void FrameScheduler::observeCompletionLocked(int64_t endSlot, int64_t hostNs) {
+  const int64_t endNs = slotNs(endSlot);
+  int64_t jitter = 0;
+  if (m_lastEndSlot >= 0 && endSlot > m_lastEndSlot)
+    jitter = std::abs((hostNs - m_lastHostNs) -
+                      (endNs - slotNs(m_lastEndSlot)));
+  m_lastEndSlot = endSlot;
+  m_lastHostNs = hostNs;
+
+  const int64_t index = m_samples++ % kSchedulerAdaptiveWindow;
+  m_delayNs[index] = std::max<int64_t>(streamTimeNsLocked() - endNs, 0);
+  m_jitterNs[index] = jitter;
+
+  const int64_t count = std::min<int64_t>(m_samples, kSchedulerAdaptiveWindow);
+  int64_t minDelay = m_delayNs[0];
+  int64_t maxDelay = m_delayNs[0];
+  int64_t maxJitter = 0;
+  for (int64_t i = 0; i < count; i++) {
+    minDelay = std::min(minDelay, m_delayNs[i]);
+    maxDelay = std::max(maxDelay, m_delayNs[i]);
+    maxJitter = std::max(maxJitter, m_jitterNs[i]);
+  }
+  m_stats.latenessNs = maxDelay - minDelay;
+  m_stats.jitterNs = maxJitter;
+
+  // Half a frame for the dispatch wake-up, twice the peak jitter on top
+  const int64_t frameNs = slotNs(1);
+  const int64_t headroomNs =
+      frameNs / 2 + 2 * std::max(m_stats.latenessNs, m_stats.jitterNs);
+  const int needed = static_cast<int>(
+      std::clamp<int64_t>((headroomNs + frameNs - 1) / frameNs, 1, 8));
+  m_stats.neededLeadFrames = needed;
+
+  m_samplesSinceChange++;
+  if (!m_config.adaptive)
+    return;
+  if (needed > m_lead)
+    setLeadLocked(needed, kLeadJitter);
+  else if (needed < m_lead && m_samplesSinceChange >= kSchedulerAdaptiveWindow)
+    setLeadLocked(m_lead - 1, kLeadStable);
+}
+
+// Frames dispatched before the last raise could not benefit from it, so
+// their misses (an @p endSlot up to m_raisedBefore) do not raise again
+void FrameScheduler::raiseLeadLocked(int64_t endSlot,
+                                     SchedulerLeadReason reason) {
+  if (m_config.adaptive && (endSlot < 0 || endSlot > m_raisedBefore))
+    setLeadLocked(m_lead + 1, reason);
+}
+
+void FrameScheduler::setLeadLocked(int lead, SchedulerLeadReason reason) {
+  lead = std::clamp(lead, static_cast<int>(m_config.minLeadFrames),
+                    static_cast<int>(m_config.maxLeadFrames));
+  if (lead == m_lead)
+    return;
+
+  SchedulerLeadChange& change =
+      m_leadChanges[m_leadChangeCount++ % kSchedulerMaxLeadChanges];
+  change.decidedNs = streamTimeNsLocked();
+  change.latenessNs = m_stats.latenessNs;
+  change.jitterNs = m_stats.jitterNs;
+  change.fromLead = m_lead;
+  change.toLead = lead;
+  change.reason = reason;
+  change.reserved = 0;
+
+  if (lead > m_lead) {
+    m_stats.leadRaised++;
+    m_raisedBefore = earliestSlotLocked(currentSlotLocked());
+    m_wake.notify_all();
+  } else {
+    m_stats.leadLowered++;
+  }
+  m_lead = lead;
+  m_stats.leadFrames = lead;
+  m_samplesSinceChange = 0;
+}
+
+HRESULT FrameScheduler::ScheduledFrameCompleted(
+    IDeckLinkVideoFrame* completedFrame,
+    BMDOutputFrameCompletionResult result) {
+  const int64_t hostNs = FrameTimingAnalyzer::nowNs();
+  trace_name_thread("DeckLink callback");
+  std::lock_guard<std::mutex> lock(m_mutex);
+  // Completions arrive in dispatch order; skipped entries were never reported
+  int64_t endSlot = -1;
+  auto match = std::find_if(
+      m_inFlight.begin(), m_inFlight.end(),
+      [completedFrame](const InFlightFrame& f) {
+        return f.frame == completedFrame;
+      });
+  if (match != m_inFlight.end()) {
+    endSlot = match->endSlot;
+    trace_record(kTraceOnDevice, match->dispatchedNs, hostNs,
+                 match->traceFrameId);
+    m_inFlight.erase(m_inFlight.begin(), match + 1);
+  }
+
+  switch (result) {
+    case bmdOutputFrameDisplayedLate:
+      m_stats.displayedLate++;
+      raiseLeadLocked(endSlot, kLeadDisplayedLate);
+      break;
+    case bmdOutputFrameDropped:
+      m_stats.hardwareDropped++;
+      raiseLeadLocked(endSlot, kLeadHardwareDropped);
+      m_lastEndSlot = -1;
+      return S_OK;
+    case bmdOutputFrameFlushed:
+      return S_OK;
+    default:
+      break;
+  }
+  m_stats.displayed++;
+  if (endSlot >= 0)
+    observeCompletionLocked(endSlot, hostNs);
+  if (m_timing)
+    m_timing->recordCompletion(hostNs, true);
+  return S_OK;
+}
+
+HRESULT FrameScheduler::ScheduledPlaybackHasStopped() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_stopPending = false;
+  m_stopped.notify_all();
+  return S_OK;
+}
@@ -0,0 +1,242 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#include "DeckLinkAPI.h"
+#include "frame_timing.h"
+#include "memory_stats.h"
+
+/*
+ * Deadline-aware scheduled output
+ *
+ * Frames are submitted with a target presentation time on the output's
+ * scheduled stream clock (which the SDK derives from the hardware reference
+ * clock) and mapped to the first frame slot at or after it. Packed frames
+ * wait in a software queue and are handed to the SDK only when their slot is
+ * within leadFrames of the current one, so a queued frame can still be
+ * superseded and output latency stays bounded by the lead.
+ *
+ * A frame whose slot has passed (or is already covered by an earlier frame)
+ * is dropped under kSchedulerStrict, or shown at the next free slot under
+ * kSchedulerLatestWins, where a newer frame also replaces every queued frame
+ * targeting the same or a later slot. Every decision is counted and the most
+ * recent ones are kept for telemetry.
+ *
+ * With an adaptive lead the lead moves between configured bounds to the
+ * smallest one the host keeps up with. Each completion is timed against the
+ * end of its frame's slot on the stream clock; the lateness above the
+ * steady completion delay and the deviation of the completion interval from
+ * the frames' durations are the host's jitter. The lead needs half a frame
+ * for the dispatch wake-up plus twice the peak jitter of the last
+ * kSchedulerAdaptiveWindow completions. A frame displayed late or dropped by
+ * the device, or one the dispatch thread handed over after its slot, raises
+ * the lead at once; a lead above the need is lowered one frame per window
+ * without a raise.
+ */
+
+constexpr int kSchedulerMaxDecisions = 64;
+constexpr int kSchedulerMaxLeadChanges = 32;
+constexpr int kSchedulerAdaptiveWindow = 120;  // Completions
+
+enum SchedulerPolicy : int32_t {
+  kSchedulerStrict = 0,      // Never show a frame after its deadline
+  kSchedulerLatestWins = 1,  // Newest frame replaces queued and late ones
+};
+
+enum SchedulerDecision : int32_t {
+  kDecisionQueued = 0,    // Accepted for its target slot
+  kDecisionLate,          // Moved to the next free slot (latest-wins)
+  kDecisionDroppedLate,   // Deadline could not be met (strict)
+  kDecisionSuperseded,    // Replaced by a newer frame before dispatch
+  kDecisionQueueFull,     // Rejected, pending queue full (strict)
+  kDecisionDispatched,    // Handed to the SDK for its slot
+};
+
+enum SchedulerLeadReason : int32_t {
+  kLeadDisplayedLate = 0,  // The device showed a frame late
+  kLeadHardwareDropped,    // The device dropped a frame
+  kLeadDispatchLate,       // A frame reached the dispatch after its slot
+  kLeadJitter,             // Peak jitter outgrew the lead
+  kLeadStable,             // A window with headroom to spare
+};
+
+struct SchedulerConfig {
+  int32_t policy;
+  int32_t leadFrames;  // Slots ahead of the current one handed to the SDK
+  int32_t maxPending;  // Packed frames waiting for dispatch
+  int32_t adaptive;    // Nonzero tunes the lead, starting at leadFrames
+  int32_t minLeadFrames;
+  int32_t maxLeadFrames;
+};
+
+struct SchedulerDecisionRecord {
+  int64_t frameId;
+  int64_t targetNs;   // Requested presentation time (0 = next free slot)
+  int64_t slot;       // Slot assigned, -1 if dropped
+  int64_t slotNs;     // Presentation time of that slot
+  int64_t decidedNs;  // Stream time when the decision was taken
+  int32_t decision;
+  int32_t durationFrames;
+};
+
+struct SchedulerLeadChange {
+  int64_t decidedNs;   // Stream time of the change
+  int64_t latenessNs;  // Peak completion lateness in the window
+  int64_t jitterNs;    // Peak completion interval jitter in the window
+  int32_t fromLead;
+  int32_t toLead;
+  int32_t reason;  // SchedulerLeadReason
+  int32_t reserved;
+};
+
+struct SchedulerStats {
+  int32_t running;
+  int32_t policy;
+  int32_t leadFrames;
+  int32_t pending;
+  int64_t frameDurationNs;
+  int64_t streamTimeNs;  // Scheduled stream clock now
+  int64_t currentSlot;
+  int64_t submitted;
+  int64_t queued;
+  int64_t late;
+  int64_t droppedLate;
+  int64_t superseded;
+  int64_t queueFull;
+  int64_t dispatched;
+  int64_t displayed;
+  int64_t displayedLate;    // Reported late by the SDK
+  int64_t hardwareDropped;  // Reported dropped by the SDK
+  int32_t adaptive;
+  int32_t minLeadFrames;
+  int32_t maxLeadFrames;
+  int32_t neededLeadFrames;  // Lead the recent jitter calls for
+  int64_t leadRaised;
+  int64_t leadLowered;
+  int64_t latenessNs;  // Peak completion lateness in the window
+  int64_t jitterNs;    // Peak completion interval jitter in the window
+};
+
+class FrameScheduler final : public IDeckLinkVideoOutputCallback {
+ public:
+  FrameScheduler();
+  ~FrameScheduler();
+
+  // Starts scheduled playback at stream time 0 and the dispatch thread
+  int start(IDeckLinkOutput* output,
+            const SchedulerConfig& config,
+            BMDTimeValue frameDuration,
+            BMDTimeScale timeScale,
+            FrameTimingAnalyzer* timing);
+  // Stops playback and releases every queued frame
+  int stop();
+  bool running() const;
+
+  // Decides a frame's fate before it is packed: returns true (and records
+  // the drop) if it cannot be shown under the strict policy
+  bool rejectBeforePack(int64_t targetNs,
+                        int32_t durationFrames,
+                        SchedulerDecisionRecord* record);
+  // Queues a packed frame, taking over its reference
+  int submit(IDeckLinkMutableVideoFrame* frame,
+             int64_t targetNs,
+             int32_t durationFrames,
+             SchedulerDecisionRecord* record);
+
+  SchedulerStats stats() const;
+  // Copies up to maxCount recent decisions, oldest first
+  int decisions(SchedulerDecisionRecord* out, int maxCount) const;
+  // Copies up to maxCount recent adaptive lead changes, oldest first
+  int leadChanges(SchedulerLeadChange* out, int maxCount) const;
+
+  // IUnknown; lifetime is owned by DeckLinkSignalGen, not reference counted
+  HRESULT QueryInterface(REFIID iid, LPVOID* ppv) override;
+  ULONG AddRef() override { return 1; }
+  ULONG Release() override { return 1; }
+
+  // IDeckLinkVideoOutputCallback
+  HRESULT ScheduledFrameCompleted(IDeckLinkVideoFrame* completedFrame,
+                                  BMDOutputFrameCompletionResult result)
+      override;
+  HRESULT ScheduledPlaybackHasStopped() override;
+
+ private:
+  struct PendingFrame {
+    IDeckLinkMutableVideoFrame* frame;
+    int64_t frameId;
+    int64_t targetNs;
+    int64_t slot;
+    int32_t durationFrames;
+    int64_t traceFrameId;
+    int64_t queuedNs;  // Host time it was queued, for tracing
+  };
+
+  // A frame handed to the SDK, until its completion
+  struct InFlightFrame {
+    IDeckLinkVideoFrame* frame;
+    int64_t endSlot;
+    int64_t traceFrameId;
+    int64_t dispatchedNs;  // Host time it was handed over, for tracing
+  };
+
+  // All *Locked helpers require m_mutex
+  int64_t streamTimeNsLocked() const;
+  int64_t currentSlotLocked() const;
+  int64_t slotForNs(int64_t ns) const;
+  int64_t slotNs(int64_t slot) const;
+  int64_t earliestSlotLocked(int64_t currentSlot) const;
+  void recordLocked(int64_t frameId,
+                    int64_t targetNs,
+                    int64_t slot,
+                    int32_t durationFrames,
+                    SchedulerDecision decision,
+                    SchedulerDecisionRecord* out);
+  void supersedeFromLocked(int64_t slot);
+  void dispatchLocked();
+  void observeCompletionLocked(int64_t endSlot, int64_t hostNs);
+  void raiseLeadLocked(int64_t endSlot, SchedulerLeadReason reason);
+  void setLeadLocked(int lead, SchedulerLeadReason reason);
+  void dispatchLoop();
+
+  mutable std::mutex m_mutex;
+  std::condition_variable m_wake;
+  std::condition_variable m_stopped;
+  std::thread m_thread;
+
+  IDeckLinkOutput* m_output;
+  FrameTimingAnalyzer* m_timing;
+  SchedulerConfig m_config;
+  int m_lead;  // Current lead; m_config.leadFrames unless adaptive
+  BMDTimeValue m_frameDuration;
+  BMDTimeScale m_timeScale;
+
+  // Ascending, distinct slots
+  std::deque<PendingFrame, TrackedAllocator<PendingFrame, kMemoryCaches>>
+      m_pending;
+  int64_t m_committedEnd;  // First slot after the last dispatched frame
+  int64_t m_nextFrameId;
+  bool m_running;
+  bool m_stopping;
+  bool m_stopPending;
+
+  // Adaptive lead; completions are sampled in dispatch order
+  std::deque<InFlightFrame, TrackedAllocator<InFlightFrame, kMemoryCaches>>
+      m_inFlight;
+  int64_t m_delayNs[kSchedulerAdaptiveWindow];   // Completion - slot end
+  int64_t m_jitterNs[kSchedulerAdaptiveWindow];  // Interval - durations
+  int64_t m_samples;
+  int64_t m_lastEndSlot;  // Of the previous sampled completion
+  int64_t m_lastHostNs;
+  int64_t m_raisedBefore;  // Frames ending by this slot cannot raise again
+  int64_t m_samplesSinceChange;
+
+  SchedulerStats m_stats;
+  SchedulerDecisionRecord m_decisions[kSchedulerMaxDecisions];
+  int64_t m_decisionCount;
+  SchedulerLeadChange m_leadChanges[kSchedulerMaxLeadChanges];
+  int64_t m_leadChangeCount;
+};
@@ -0,0 +1,233 @@
+#include "frame_stream.h"
+
+#include <poll.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <iostream>
+
+#include "frame_timing.h"
+
+FrameStreamReader::FrameStreamReader()
+    : m_config{},
+      m_stopping(false),
+      m_readerDone(false),
+      m_stats{},
+      m_totalReadNs(0) {}
+
+FrameStreamReader::~FrameStreamReader() {
+  stop();
+}
+
+/**
+ * @brief Starts reading and displaying frames from a file descriptor
+ *
+ * @return int 0 on success, -1 on invalid arguments
+ */
+int FrameStreamReader::start(const StreamConfig& config,
+                             int64_t frameBytes,
+                             PrepareFn prepare,
+                             FinishFn finish,
+                             OutputPipeline::DisplayFn display,
+                             OutputPipeline::ThreadInitFn displayInit) {
+  if (config.fd < 0 || frameBytes <= 0 || config.readahead < 1 ||
+      config.readahead > 16 || config.maxFrames < 0)
+    return -1;
+  stop();
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_prepare = std::move(prepare);
+  m_finish = std::move(finish);
+  m_display = std::move(display);
+  m_config = config;
+  m_stopping = false;
+  m_readerDone = false;
+  m_totalReadNs = 0;
+  m_stats = {};
+  m_stats.running = 1;
+  m_stats.format = config.format;
+  m_stats.frameBytes = frameBytes;
+  m_readThread = std::thread(&FrameStreamReader::readLoop, this);
+  m_displayThread = std::thread(&FrameStreamReader::displayLoop, this,
+                                std::move(displayInit));
+  std::cerr << "[FrameStream] Reading " << frameBytes
+            << "-byte frames from fd " << config.fd << " with "
+            << config.readahead << " frame(s) of readahead" << std::endl;
+  return 0;
+}
+
+void FrameStreamReader::stop() {
+  if (!m_readThread.joinable())
+    return;
+  {
+    // Under the lock, so a loop between its predicate check and its wait
+    // cannot miss the notify
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stopping = true;
+  }
+  m_changed.notify_all();
+  m_readThread.join();
+  m_displayThread.join();
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  for (PipelineFrame& frame : m_ready)
+    frame.frame->Release();
+  m_ready.clear();
+  m_stats.running = 0;
+  m_prepare = nullptr;
+  m_finish = nullptr;
+  m_display = nullptr;
+}
+
+bool FrameStreamReader::running() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_stats.running != 0;
+}
+
+StreamStats FrameStreamReader::stats() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_stats;
+}
+
+/**
+ * @brief Reads exactly one frame into @p buffer
+ *
+ * Waits with poll() so stop() is noticed within 100 ms even when a pipe
+ * stays empty. A seekable input is rewound at end of file if looping.
+ */
+FrameStreamReader::ReadResult FrameStreamReader::readFrame(uint8_t* buffer) {
+  const size_t frameBytes = static_cast<size_t>(m_stats.frameBytes);
+  size_t got = 0;
+  while (got < frameBytes) {
+    if (m_stopping)
+      return kReadStopped;
+    pollfd input = {m_config.fd, POLLIN, 0};
+    const int ready = poll(&input, 1, 100);
+    if (ready == 0 || (ready < 0 && errno == EINTR))
+      continue;
+    if (ready < 0)
+      return kReadError;
+
+    const ssize_t count = read(m_config.fd, buffer + got, frameBytes - got);
+    if (count < 0) {
+      if (errno == EINTR || errno == EAGAIN)
+        continue;
+      return kReadError;
+    }
+    if (count == 0) {
+      // A frame must have been read since the last rewind, or an empty
+      // file would spin here
+      if (got == 0 && m_config.loop && m_stats.framesRead > 0 &&
+          lseek(m_config.fd, 0, SEEK_SET) == 0)
+        continue;
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_stats.endOfInput = got == 0 ? 1 : 2;
+      return kReadEnd;
+    }
+    got += static_cast<size_t>(count);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stats.bytesRead += count;
+  }
+  return kReadFrame;
+}
+
+void FrameStreamReader::readLoop() {
+  int error = 0;
+  while (!m_stopping) {
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      const int64_t waitStart = FrameTimingAnalyzer::nowNs();
+      m_changed.wait(lock, [this] {
+        return m_stopping || static_cast<int>(m_ready.size()) <
+                                 m_config.readahead;
+      });
+      m_stats.readWaitNs += FrameTimingAnalyzer::nowNs() - waitStart;
+    }
+    if (m_stopping)
+      break;
+
+    PipelineFrame frame = {};
+    void* buffer = nullptr;
+    error = m_prepare(&buffer, &frame);
+    if (error == -4) {
+      // Every pooled frame is still held by the display or the SDK
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      error = 0;
+      continue;
+    }
+    if (error)
+      break;
+
+    const int64_t readStart = FrameTimingAnalyzer::nowNs();
+    const ReadResult result = readFrame(static_cast<uint8_t*>(buffer));
+    if (result == kReadFrame)
+      error = m_finish(&frame);
+    if (result != kReadFrame || error) {
+      if (frame.frame)
+        frame.frame->Release();
+      if (result == kReadError) {
+        std::cerr << "[FrameStream] Read failed (errno " << errno << ")"
+                  << std::endl;
+        error = -7;
+      }
+      break;
+    }
+
+    const int64_t readNs = FrameTimingAnalyzer::nowNs() - readStart;
+    frame.submitNs = FrameTimingAnalyzer::nowNs();
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_ready.push_back(frame);
+    m_stats.framesRead++;
+    m_totalReadNs += readNs;
+    m_stats.meanReadNs = m_totalReadNs / m_stats.framesRead;
+    m_stats.maxReadNs = std::max(m_stats.maxReadNs, readNs);
+    m_changed.notify_all();
+    if (m_config.maxFrames > 0 && m_stats.framesRead >= m_config.maxFrames)
+      break;
+  }
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_readerDone = true;
+  if (error)
+    m_stats.lastError = error;
+  m_changed.notify_all();
+}
+
+void FrameStreamReader::displayLoop(OutputPipeline::ThreadInitFn init) {
+  if (init)
+    init();
+
+  std::unique_lock<std::mutex> lock(m_mutex);
+  while (!m_stopping) {
+    if (m_ready.empty()) {
+      if (m_readerDone)
+        break;
+      if (m_stats.framesDisplayed > 0)
+        m_stats.underruns++;
+      m_changed.wait(lock, [this] {
+        return m_stopping || m_readerDone || !m_ready.empty();
+      });
+      continue;
+    }
+
+    PipelineFrame frame = m_ready.front();
+    m_ready.pop_front();
+    m_changed.notify_all();
+    lock.unlock();
+    const int error = m_display(frame);
+    lock.lock();
+    if (error) {
+      // Nothing more can be shown; let the reader exit too
+      m_stats.lastError = error;
+      m_stopping = true;
+      m_changed.notify_all();
+      break;
+    }
+    m_stats.framesDisplayed++;
+  }
+  m_stats.running = 0;
+  std::cerr << "[FrameStream] Stopped after " << m_stats.framesDisplayed
+            << " frame(s)" << std::endl;
+}
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include "DeckLinkAPI.h"
+#include "memory_stats.h"
+#include "output_pipeline.h"
+
+/*
+ * Raw frame stream input
+ *
+ * Reads fixed-size frames from a file descriptor (stdin, a FIFO, a file) on
+ * a reader thread and displays them on a display thread, with up to
+ * `readahead` frames read and packed ahead. Pre-packed frames are read
+ * straight into pooled DeckLink frame buffers; RGB48 frames go through one
+ * reusable input buffer and are packed on the reader thread. Display uses
+ * DisplayVideoFrameSync, so the stream is paced by the display mode and a
+ * fast producer is held back by the pipe.
+ */
+
+enum StreamFormat : int32_t {
+  kStreamRgb48 = 0,   // Interleaved native-endian uint16 RGB, row-major
+  kStreamPacked = 1,  // Active pixel format at the SDK's row bytes
+};
+
+struct StreamConfig {
+  int32_t fd;
+  int32_t format;
+  int32_t width;
+  int32_t height;
+  int32_t readahead;  // Frames read ahead of the display (1-16)
+  int32_t loop;       // Rewind a seekable input at end of file
+  int64_t maxFrames;  // Stop after this many frames, 0 = until end of input
+};
+
+struct StreamStats {
+  int32_t running;
+  int32_t format;
+  int32_t endOfInput;  // 1 at end of input, 2 if the last frame was partial
+  int32_t lastError;   // Read, pack or display error that ended the stream
+  int64_t frameBytes;  // Bytes per frame expected on the input
+  int64_t framesRead;
+  int64_t framesDisplayed;
+  int64_t bytesRead;
+  int64_t underruns;   // Times the display found no frame ready
+  int64_t readWaitNs;  // Total time the reader waited for a free slot
+  int64_t meanReadNs;  // Read (and pack) time per frame
+  int64_t maxReadNs;
+};
+
+class FrameStreamReader {
+ public:
+  // Provides the buffer the next frame is read into and, if it already
+  // exists, the pooled frame to display
+  using PrepareFn = std::function<int(void** buffer, PipelineFrame* frame)>;
+  // Completes a frame once its buffer has been filled
+  using FinishFn = std::function<int(PipelineFrame* frame)>;
+
+  FrameStreamReader();
+  ~FrameStreamReader();
+
+  int start(const StreamConfig& config,
+            int64_t frameBytes,
+            PrepareFn prepare,
+            FinishFn finish,
+            OutputPipeline::DisplayFn display,
+            OutputPipeline::ThreadInitFn displayInit);
+  // Stops reading, drops frames read ahead and joins the threads; the file
+  // descriptor stays open
+  void stop();
+  bool running() const;
+  StreamStats stats() const;
+
+ private:
+  enum ReadResult { kReadFrame, kReadEnd, kReadStopped, kReadError };
+
+  ReadResult readFrame(uint8_t* buffer);
+  void readLoop();
+  void displayLoop(OutputPipeline::ThreadInitFn init);
+
+  PrepareFn m_prepare;
+  FinishFn m_finish;
+  OutputPipeline::DisplayFn m_display;
+  StreamConfig m_config;
+
+  mutable std::mutex m_mutex;
+  std::condition_variable m_changed;
+  std::thread m_readThread;
+  std::thread m_displayThread;
+  std::atomic<bool> m_stopping;
+
+  std::deque<PipelineFrame, TrackedAllocator<PipelineFrame, kMemoryCaches>>
+      m_ready;
+  bool m_readerDone;
+  StreamStats m_stats;
+  int64_t m_totalReadNs;
+};
@@ -0,0 +1,166 @@
+#include "frame_timing.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+
+#include "memory_stats.h"
+
+FrameTimingAnalyzer::FrameTimingAnalyzer()
+    : m_nominalNs(0), m_threshold(0.5) {
+  memory_track_alloc(kMemoryLogger, sizeof(*this));
+  reset(0);
+}
+
+FrameTimingAnalyzer::~FrameTimingAnalyzer() {
+  memory_track_free(kMemoryLogger, sizeof(*this));
+}
+
+int64_t FrameTimingAnalyzer::nowNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+void FrameTimingAnalyzer::reset(int64_t nominalIntervalNs) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (nominalIntervalNs > 0)
+    m_nominalNs = nominalIntervalNs;
+  m_pendingSubmitNs = 0;
+  m_lastCompletionNs = 0;
+  m_frames = 0;
+  m_intervals = 0;
+  m_idleGaps = 0;
+  m_minInterval = 0;
+  m_maxInterval = 0;
+  m_sumInterval = 0.0;
+  m_sumSqInterval = 0.0;
+  m_latencies = 0;
+  m_minLatency = 0;
+  m_maxLatency = 0;
+  m_sumLatency = 0.0;
+  m_outlierCount = 0;
+  m_missedFrames = 0;
+  std::memset(m_intervalHistogram, 0, sizeof(m_intervalHistogram));
+  std::memset(m_latencyHistogram, 0, sizeof(m_latencyHistogram));
+  std::memset(m_outliers, 0, sizeof(m_outliers));
+  m_outlierHead = 0;
+}
+
+void FrameTimingAnalyzer::setOutlierThreshold(double threshold) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_threshold = std::max(threshold, 0.0);
+}
+
+int FrameTimingAnalyzer::binFor(int64_t ns) const {
+  if (m_nominalNs <= 0)
+    return kFrameTimingBins - 1;
+  const int64_t bin = ns * kFrameTimingBinsPerFrame / m_nominalNs;
+  return static_cast<int>(std::min<int64_t>(bin, kFrameTimingBins - 1));
+}
+
+void FrameTimingAnalyzer::recordSubmit(int64_t nowNs) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_pendingSubmitNs = nowNs;
+}
+
+void FrameTimingAnalyzer::recordCompletion(int64_t nowNs, bool continuous) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_frames++;
+
+  const int64_t submitNs = m_pendingSubmitNs;
+  int64_t latency = -1;
+  if (m_pendingSubmitNs > 0) {
+    latency = nowNs - m_pendingSubmitNs;
+    m_pendingSubmitNs = 0;
+    m_minLatency = m_latencies ? std::min(m_minLatency, latency) : latency;
+    m_maxLatency = std::max(m_maxLatency, latency);
+    m_sumLatency += static_cast<double>(latency);
+    m_latencies++;
+    m_latencyHistogram[binFor(latency)]++;
+  }
+
+  const int64_t last = m_lastCompletionNs;
+  m_lastCompletionNs = nowNs;
+  if (last == 0)
+    return;
+
+  const int64_t interval = nowNs - last;
+  const int64_t idleNs = kFrameTimingIdleFrames * m_nominalNs;
+  // Idle only if no frame was waiting through the gap: none was submitted,
+  // or it arrived long after the previous completion. A submitted frame
+  // that took this long to show is a stall.
+  if (!continuous && m_nominalNs > 0 && interval > idleNs &&
+      (submitNs == 0 || submitNs - last > idleNs)) {
+    m_idleGaps++;
+    return;
+  }
+
+  m_minInterval = m_intervals ? std::min(m_minInterval, interval) : interval;
+  m_maxInterval = std::max(m_maxInterval, interval);
+  m_sumInterval += static_cast<double>(interval);
+  m_sumSqInterval += static_cast<double>(interval) * interval;
+  m_intervals++;
+  m_intervalHistogram[binFor(interval)]++;
+
+  if (m_nominalNs <= 0)
+    return;
+
+  // Each whole extra frame duration in the gap is one output slot repeated
+  const int64_t slots = (interval + m_nominalNs / 2) / m_nominalNs;
+  if (slots > 1)
+    m_missedFrames += slots - 1;
+
+  if (interval > static_cast<int64_t>(m_nominalNs * (1.0 + m_threshold))) {
+    m_outliers[m_outlierHead] = {m_frames - 1, nowNs, interval, latency};
+    m_outlierHead = (m_outlierHead + 1) % kFrameTimingMaxOutliers;
+    m_outlierCount++;
+  }
+}
+
+void FrameTimingAnalyzer::report(FrameTimingReport* out) const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  *out = {};
+  out->nominalIntervalNs = m_nominalNs;
+  out->frames = m_frames;
+  out->intervals = m_intervals;
+  out->idleGaps = m_idleGaps;
+  out->minIntervalNs = m_minInterval;
+  out->maxIntervalNs = m_maxInterval;
+  if (m_intervals > 0) {
+    const double mean = m_sumInterval / m_intervals;
+    const double variance = m_sumSqInterval / m_intervals - mean * mean;
+    out->meanIntervalNs = static_cast<int64_t>(mean);
+    out->stddevIntervalNs =
+        static_cast<int64_t>(std::sqrt(std::max(variance, 0.0)));
+  }
+  out->minLatencyNs = m_minLatency;
+  out->maxLatencyNs = m_maxLatency;
+  if (m_latencies > 0)
+    out->meanLatencyNs = static_cast<int64_t>(m_sumLatency / m_latencies);
+  out->outliers = m_outlierCount;
+  out->missedFrames = m_missedFrames;
+  out->outlierThreshold = m_threshold;
+  out->histogramBins = kFrameTimingBins;
+  out->binsPerFrame = kFrameTimingBinsPerFrame;
+  std::memcpy(out->intervalHistogram, m_intervalHistogram,
+              sizeof(m_intervalHistogram));
+  std::memcpy(out->latencyHistogram, m_latencyHistogram,
+              sizeof(m_latencyHistogram));
+}
+
+int FrameTimingAnalyzer::outliers(FrameTimingOutlier* out,
+                                  int maxCount) const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  const int stored = static_cast<int>(
+      std::min<int64_t>(m_outlierCount, kFrameTimingMaxOutliers));
+  const int count = std::min(stored, maxCount);
+  // Oldest retained outlier sits at the head once the ring has wrapped
+  const int first = (m_outlierHead - stored + kFrameTimingMaxOutliers) %
+                    kFrameTimingMaxOutliers;
+  const int skip = stored - count;  // Keep the most recent ones
+  for (int i = 0; i < count; i++)
+    out[i] = m_outliers[(first + skip + i) % kFrameTimingMaxOutliers];
+  return count;
+}
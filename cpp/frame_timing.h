@@ -0,0 +1,105 @@
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+
+/*
+ * Inter-frame interval and submit-to-completion latency analyzer
+ *
+ * Records one completion per displayed frame into fixed-size histograms whose
+ * bins are fractions of the nominal frame duration, so recording is O(1), never
+ * allocates and can stay enabled in production. Intervals above
+ * (1 + outlierThreshold) x nominal are flagged and the most recent ones kept
+ * with their timestamps for correlation with other logs.
+ */
+
+// Histogram layout: kFrameTimingBinsPerFrame bins per nominal frame duration,
+// the last bin collects everything at or beyond kFrameTimingBins - 1 bins
+constexpr int kFrameTimingBins = 33;
+constexpr int kFrameTimingBinsPerFrame = 8;
+constexpr int kFrameTimingMaxOutliers = 64;
+
+// Gaps longer than this many frames with no frame waiting to be shown are
+// treated as output going idle (e.g. a still image held on screen), not as
+// stalls
+constexpr int kFrameTimingIdleFrames = 30;
+
+struct FrameTimingReport {
+  int64_t nominalIntervalNs;
+  int64_t frames;     // Completions recorded
+  int64_t intervals;  // Completion-to-completion intervals in the histogram
+  int64_t idleGaps;   // Gaps skipped as idle periods
+  int64_t minIntervalNs;
+  int64_t maxIntervalNs;
+  int64_t meanIntervalNs;
+  int64_t stddevIntervalNs;
+  int64_t minLatencyNs;  // Submit (frame data handed over) to completion
+  int64_t maxLatencyNs;
+  int64_t meanLatencyNs;
+  int64_t outliers;       // Intervals above the outlier threshold
+  int64_t missedFrames;   // Frame slots skipped, estimated from intervals
+  double outlierThreshold;
+  int32_t histogramBins;
+  int32_t binsPerFrame;
+  int64_t intervalHistogram[kFrameTimingBins];
+  int64_t latencyHistogram[kFrameTimingBins];
+};
+
+struct FrameTimingOutlier {
+  int64_t frameIndex;
+  int64_t completionNs;  // steady_clock timestamp
+  int64_t intervalNs;
+  int64_t latencyNs;
+};
+
+class FrameTimingAnalyzer {
+ public:
+  FrameTimingAnalyzer();
+  ~FrameTimingAnalyzer();
+
+  // Clears all data; a non-zero nominal interval also replaces the nominal
+  void reset(int64_t nominalIntervalNs);
+  int64_t nominalIntervalNs() const { return m_nominalNs; }
+  void setOutlierThreshold(double threshold);
+
+  void recordSubmit(int64_t nowNs);
+  // Continuous playback (clips, the scheduler, streams) is never idle, so
+  // every gap it leaves is recorded however long it is
+  void recordCompletion(int64_t nowNs, bool continuous = false);
+
+  void report(FrameTimingReport* out) const;
+  // Copies up to maxCount outliers, oldest first; returns the number copied
+  int outliers(FrameTimingOutlier* out, int maxCount) const;
+
+  static int64_t nowNs();
+
+ private:
+  int binFor(int64_t ns) const;
+
+  mutable std::mutex m_mutex;
+  int64_t m_nominalNs;
+  double m_threshold;
+
+  int64_t m_pendingSubmitNs;  // 0 = none
+  int64_t m_lastCompletionNs;
+
+  int64_t m_frames;
+  int64_t m_intervals;
+  int64_t m_idleGaps;
+  int64_t m_minInterval;
+  int64_t m_maxInterval;
+  double m_sumInterval;
+  double m_sumSqInterval;
+  int64_t m_latencies;
+  int64_t m_minLatency;
+  int64_t m_maxLatency;
+  double m_sumLatency;
+  int64_t m_outlierCount;
+  int64_t m_missedFrames;
+  int64_t m_intervalHistogram[kFrameTimingBins];
+  int64_t m_latencyHistogram[kFrameTimingBins];
+
+  // Ring buffer of the most recent outliers
+  FrameTimingOutlier m_outliers[kFrameTimingMaxOutliers];
+  int m_outlierHead;
+};
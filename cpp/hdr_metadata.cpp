@@ -0,0 +1,290 @@
+#include "hdr_metadata.h"
+
+#include <cstring>
+#include <iostream>
+
+namespace {
+
+constexpr BMDDeckLinkFrameMetadataID kIntIds[] = {
+    bmdDeckLinkFrameMetadataColorspace,
+    bmdDeckLinkFrameMetadataHDRElectroOpticalTransferFunc,
+};
+
+constexpr BMDDeckLinkFrameMetadataID kFloatIds[] = {
+    bmdDeckLinkFrameMetadataHDRDisplayPrimariesRedX,
+    bmdDeckLinkFrameMetadataHDRDisplayPrimariesRedY,
+    bmdDeckLinkFrameMetadataHDRDisplayPrimariesGreenX,
+    bmdDeckLinkFrameMetadataHDRDisplayPrimariesGreenY,
+    bmdDeckLinkFrameMetadataHDRDisplayPrimariesBlueX,
+    bmdDeckLinkFrameMetadataHDRDisplayPrimariesBlueY,
+    bmdDeckLinkFrameMetadataHDRWhitePointX,
+    bmdDeckLinkFrameMetadataHDRWhitePointY,
+    bmdDeckLinkFrameMetadataHDRMaxDisplayMasteringLuminance,
+    bmdDeckLinkFrameMetadataHDRMinDisplayMasteringLuminance,
+    bmdDeckLinkFrameMetadataHDRMaximumContentLightLevel,
+    bmdDeckLinkFrameMetadataHDRMaximumFrameAverageLightLevel,
+};
+
+// Colorspace from the red primary: Rec.709 (0.640, 0.330), DCI-P3
+// (0.680, 0.320) or Rec.2020 (0.708, 0.292). The SDK has no P3 constant, so
+// P3 is signalled as the closest HDR-compatible one, Rec.2020.
+BMDColorspace colorspaceFor(const HDRMetadata& metadata) {
+  return metadata.referencePrimaries.RedX > 0.66 ? bmdColorspaceRec2020
+                                                 : bmdColorspaceRec709;
+}
+
+// FNV-1a over the value bytes; equal values always hash alike because
+// intern() compares with hdr_metadata_equal() after a hash match
+uint64_t hashMetadata(const HDRMetadata& metadata) {
+  const auto* bytes = reinterpret_cast<const uint8_t*>(&metadata);
+  uint64_t hash = 1469598103934665603ull;
+  for (size_t i = 0; i < sizeof(metadata); i++)
+    hash = (hash ^ bytes[i]) * 1099511628211ull;
+  return hash;
+}
+
+// Copies the provider's values into the frame's own metadata store, for a
+// frame that does not take an interface provider
+bool copyMetadata(IDeckLinkMutableVideoFrame* frame,
+                  HDRMetadataProvider* provider) {
+  IDeckLinkVideoFrameMutableMetadataExtensions* metadataExt = nullptr;
+  if (frame->QueryInterface(IID_IDeckLinkVideoFrameMutableMetadataExtensions,
+                            (void**)&metadataExt) != S_OK ||
+      !metadataExt)
+    return false;
+  for (BMDDeckLinkFrameMetadataID id : kIntIds) {
+    int64_t value = 0;
+    provider->GetInt(id, &value);
+    metadataExt->SetInt(id, value);
+  }
+  for (BMDDeckLinkFrameMetadataID id : kFloatIds) {
+    double value = 0.0;
+    provider->GetFloat(id, &value);
+    metadataExt->SetFloat(id, value);
+  }
+  metadataExt->Release();
+  return true;
+}
+
+}  // namespace
+
+bool hdr_metadata_equal(const HDRMetadata& a, const HDRMetadata& b) {
+  const Gamut_Chromaticities& pa = a.referencePrimaries;
+  const Gamut_Chromaticities& pb = b.referencePrimaries;
+  return a.EOTF == b.EOTF && pa.RedX == pb.RedX && pa.RedY == pb.RedY &&
+         pa.GreenX == pb.GreenX && pa.GreenY == pb.GreenY &&
+         pa.BlueX == pb.BlueX && pa.BlueY == pb.BlueY &&
+         pa.WhiteX == pb.WhiteX && pa.WhiteY == pb.WhiteY &&
+         a.maxDisplayMasteringLuminance == b.maxDisplayMasteringLuminance &&
+         a.minDisplayMasteringLuminance == b.minDisplayMasteringLuminance &&
+         a.maxCLL == b.maxCLL && a.maxFALL == b.maxFALL;
+}
+
+HDRMetadataProvider::HDRMetadataProvider(const HDRMetadata& metadata)
+    : m_metadata(metadata),
+      m_colorspace(colorspaceFor(metadata)),
+      m_refCount(1) {}
+
+HDRMetadataProvider::~HDRMetadataProvider() = default;
+
+HRESULT HDRMetadataProvider::QueryInterface(REFIID iid, LPVOID* ppv) {
+  if (!ppv)
+    return E_INVALIDARG;
+
+  CFUUIDBytes iunknown = CFUUIDGetUUIDBytes(IUnknownUUID);
+  if (memcmp(&iid, &iunknown, sizeof(REFIID)) == 0 ||
+      memcmp(&iid, &IID_IDeckLinkVideoFrameMetadataExtensions,
+             sizeof(REFIID)) == 0) {
+    *ppv = static_cast<IDeckLinkVideoFrameMetadataExtensions*>(this);
+    AddRef();
+    return S_OK;
+  }
+
+  *ppv = nullptr;
+  return E_NOINTERFACE;
+}
+
+ULONG HDRMetadataProvider::AddRef() {
+  return ++m_refCount;
+}
+
+ULONG HDRMetadataProvider::Release() {
+  ULONG newRefValue = --m_refCount;
+  if (newRefValue == 0)
+    delete this;
+  return newRefValue;
+}
+
+HRESULT HDRMetadataProvider::GetInt(BMDDeckLinkFrameMetadataID metadataID,
+                                    int64_t* value) {
+  if (!value)
+    return E_POINTER;
+  switch (metadataID) {
+    case bmdDeckLinkFrameMetadataColorspace:
+      *value = m_colorspace;
+      return S_OK;
+    case bmdDeckLinkFrameMetadataHDRElectroOpticalTransferFunc:
+      *value = m_metadata.EOTF;
+      return S_OK;
+    default:
+      return E_INVALIDARG;
+  }
+}
+
+HRESULT HDRMetadataProvider::GetFloat(BMDDeckLinkFrameMetadataID metadataID,
+                                      double* value) {
+  if (!value)
+    return E_POINTER;
+  const Gamut_Chromaticities& primaries = m_metadata.referencePrimaries;
+  switch (metadataID) {
+    case bmdDeckLinkFrameMetadataHDRDisplayPrimariesRedX:
+      *value = primaries.RedX;
+      return S_OK;
+    case bmdDeckLinkFrameMetadataHDRDisplayPrimariesRedY:
+      *value = primaries.RedY;
+      return S_OK;
+    case bmdDeckLinkFrameMetadataHDRDisplayPrimariesGreenX:
+      *value = primaries.GreenX;
+      return S_OK;
+    case bmdDeckLinkFrameMetadataHDRDisplayPrimariesGreenY:
+      *value = primaries.GreenY;
+      return S_OK;
+    case bmdDeckLinkFrameMetadataHDRDisplayPrimariesBlueX:
+      *value = primaries.BlueX;
+      return S_OK;
+    case bmdDeckLinkFrameMetadataHDRDisplayPrimariesBlueY:
+      *value = primaries.BlueY;
+      return S_OK;
+    case bmdDeckLinkFrameMetadataHDRWhitePointX:
+      *value = primaries.WhiteX;
+      return S_OK;
+    case bmdDeckLinkFrameMetadataHDRWhitePointY:
+      *value = primaries.WhiteY;
+      return S_OK;
+    case bmdDeckLinkFrameMetadataHDRMaxDisplayMasteringLuminance:
+      *value = m_metadata.maxDisplayMasteringLuminance;
+      return S_OK;
+    case bmdDeckLinkFrameMetadataHDRMinDisplayMasteringLuminance:
+      *value = m_metadata.minDisplayMasteringLuminance;
+      return S_OK;
+    case bmdDeckLinkFrameMetadataHDRMaximumContentLightLevel:
+      *value = m_metadata.maxCLL;
+      return S_OK;
+    case bmdDeckLinkFrameMetadataHDRMaximumFrameAverageLightLevel:
+      *value = m_metadata.maxFALL;
+      return S_OK;
+    default:
+      return E_INVALIDARG;
+  }
+}
+
+HRESULT HDRMetadataProvider::GetFlag(BMDDeckLinkFrameMetadataID metadataID,
+                                     bool* value) {
+  return E_INVALIDARG;
+}
+
+HRESULT HDRMetadataProvider::GetString(BMDDeckLinkFrameMetadataID metadataID,
+                                       CFStringRef* value) {
+  return E_INVALIDARG;
+}
+
+HRESULT HDRMetadataProvider::GetBytes(BMDDeckLinkFrameMetadataID metadataID,
+                                      void* buffer,
+                                      uint32_t* bufferSize) {
+  return E_INVALIDARG;
+}
+
+HDRMetadataTable::HDRMetadataTable()
+    : m_interned(0), m_reused(0), m_attached(0), m_fallbacks(0) {}
+
+HDRMetadataTable::~HDRMetadataTable() {
+  clear();
+}
+
+int HDRMetadataTable::intern(const HDRMetadata& metadata) {
+  if (metadata.EOTF < 0 || metadata.EOTF > 3)
+    return -1;
+
+  const uint64_t hash = hashMetadata(metadata);
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_interned++;
+  auto range = m_index.equal_range(hash);
+  for (auto it = range.first; it != range.second; ++it) {
+    if (hdr_metadata_equal(m_entries[it->second - 1]->metadata(), metadata)) {
+      m_reused++;
+      return it->second;
+    }
+  }
+  if (static_cast<int>(m_entries.size()) >= kHDRMetadataMaxEntries) {
+    std::cerr << "[DeckLink] HDR metadata table is full ("
+              << kHDRMetadataMaxEntries << " entries)" << std::endl;
+    return -5;
+  }
+  m_entries.push_back(new HDRMetadataProvider(metadata));
+  const int id = static_cast<int>(m_entries.size());
+  m_index.emplace(hash, id);
+  return id;
+}
+
+HDRMetadataProvider* HDRMetadataTable::acquire(int id) const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (id < 1 || id > static_cast<int>(m_entries.size()))
+    return nullptr;
+  HDRMetadataProvider* provider = m_entries[id - 1];
+  provider->AddRef();
+  return provider;
+}
+
+void HDRMetadataTable::clear() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  for (HDRMetadataProvider* provider : m_entries)
+    provider->Release();
+  m_entries.clear();
+  m_index.clear();
+}
+
+void HDRMetadataTable::attach(IDeckLinkMutableVideoFrame* frame,
+                              HDRMetadataProvider* provider) {
+  if (!frame)
+    return;
+
+  const BMDFrameFlags flags = frame->GetFlags();
+  if (!provider || !provider->hdr()) {
+    // Pooled and cached frames may be reused after carrying HDR metadata
+    if (flags & bmdFrameContainsHDRMetadata) {
+      frame->SetFlags(flags & ~bmdFrameContainsHDRMetadata);
+      frame->SetInterfaceProvider(IID_IDeckLinkVideoFrameMetadataExtensions,
+                                  nullptr);
+    }
+    return;
+  }
+
+  frame->SetFlags(flags | bmdFrameContainsHDRMetadata);
+  if (frame->SetInterfaceProvider(IID_IDeckLinkVideoFrameMetadataExtensions,
+                                  provider) == S_OK) {
+    m_attached++;
+    return;
+  }
+  if (m_fallbacks++ == 0) {
+    std::cerr << "[DeckLink] Frames do not take a metadata provider; "
+                 "copying HDR metadata into each frame"
+              << std::endl;
+  }
+  if (!copyMetadata(frame, provider)) {
+    std::cerr << "[DeckLink] Warning: Could not get metadata extensions "
+                 "interface. HDR metadata will not be applied."
+              << std::endl;
+  }
+}
+
+HDRMetadataTableStats HDRMetadataTable::stats() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  HDRMetadataTableStats stats = {};
+  stats.entries = static_cast<int32_t>(m_entries.size());
+  stats.capacity = kHDRMetadataMaxEntries;
+  stats.interned = m_interned;
+  stats.reused = m_reused;
+  stats.attached = m_attached;
+  stats.fallbacks = m_fallbacks;
+  return stats;
+}
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+
+#include "DeckLinkAPI.h"
+#include "memory_stats.h"
+
+/*
+ * HDR metadata of output frames
+ *
+ * Each distinct set of HDR values is one immutable HDRMetadataProvider that
+ * answers the SDK's IDeckLinkVideoFrameMetadataExtensions queries. A frame
+ * takes it with IDeckLinkMutableVideoFrame::SetInterfaceProvider, so
+ * attaching metadata is a single call that adds a reference, rather than a
+ * QueryInterface and a dozen SetInt/SetFloat calls, and every frame with
+ * the same values shares one provider. The table interns descriptors under
+ * small ids, so each frame of a scheduled sequence can carry its own
+ * metadata without any extra work at frame rate.
+ */
+
+constexpr int kHDRMetadataMaxEntries = 1024;
+
+// Complete HDR metadata structure (matching SignalGenHDR sample)
+struct Gamut_Chromaticities {
+  double RedX;
+  double RedY;
+  double GreenX;
+  double GreenY;
+  double BlueX;
+  double BlueY;
+  double WhiteX;
+  double WhiteY;
+};
+
+struct HDRMetadata {
+  int64_t EOTF;
+  Gamut_Chromaticities referencePrimaries;
+  double maxDisplayMasteringLuminance;
+  double minDisplayMasteringLuminance;
+  double maxCLL;
+  double maxFALL;
+};
+
+struct HDRMetadataTableStats {
+  int32_t entries;
+  int32_t capacity;
+  int64_t interned;   // intern() calls
+  int64_t reused;     // intern() calls that found an existing entry
+  int64_t attached;   // HDR frames given a provider
+  int64_t fallbacks;  // HDR frames that needed SetInt/SetFloat copies
+};
+
+bool hdr_metadata_equal(const HDRMetadata& a, const HDRMetadata& b);
+
+class HDRMetadataProvider final
+    : public IDeckLinkVideoFrameMetadataExtensions {
+ public:
+  explicit HDRMetadataProvider(const HDRMetadata& metadata);
+
+  // IUnknown
+  HRESULT QueryInterface(REFIID iid, LPVOID* ppv) override;
+  ULONG AddRef() override;
+  ULONG Release() override;
+
+  // IDeckLinkVideoFrameMetadataExtensions
+  HRESULT GetInt(BMDDeckLinkFrameMetadataID metadataID,
+                 int64_t* value) override;
+  HRESULT GetFloat(BMDDeckLinkFrameMetadataID metadataID,
+                   double* value) override;
+  HRESULT GetFlag(BMDDeckLinkFrameMetadataID metadataID, bool* value) override;
+  HRESULT GetString(BMDDeckLinkFrameMetadataID metadataID,
+                    CFStringRef* value) override;
+  HRESULT GetBytes(BMDDeckLinkFrameMetadataID metadataID,
+                   void* buffer,
+                   uint32_t* bufferSize) override;
+
+  const HDRMetadata& metadata() const { return m_metadata; }
+  // PQ or HLG; SDR frames carry no metadata so the device signals SDR
+  bool hdr() const { return m_metadata.EOTF == 2 || m_metadata.EOTF == 3; }
+
+ private:
+  ~HDRMetadataProvider();
+
+  const HDRMetadata m_metadata;
+  const BMDColorspace m_colorspace;
+  std::atomic<ULONG> m_refCount;
+};
+
+class HDRMetadataTable {
+ public:
+  HDRMetadataTable();
+  ~HDRMetadataTable();
+
+  // Id (from 1) of the entry holding @p metadata, added if new. Returns -1
+  // for an EOTF outside 0-3, -5 if the table is full.
+  int intern(const HDRMetadata& metadata);
+  // New reference to entry @p id; nullptr if there is none
+  HDRMetadataProvider* acquire(int id) const;
+  // Drops every entry and invalidates the ids. Frames already carrying a
+  // provider keep their reference.
+  void clear();
+
+  // Signals @p provider on @p frame, or clears the HDR flag (and any
+  // provider) for SDR or a null provider
+  void attach(IDeckLinkMutableVideoFrame* frame, HDRMetadataProvider* provider);
+
+  HDRMetadataTableStats stats() const;
+
+ private:
+  mutable std::mutex m_mutex;
+  TrackedVector<HDRMetadataProvider*, kMemoryCaches> m_entries;  // By id - 1
+  std::unordered_multimap<uint64_t, int> m_index;  // Value hash to id
+  int64_t m_interned;
+  int64_t m_reused;
+  std::atomic<int64_t> m_attached;
+  std::atomic<int64_t> m_fallbacks;
+};
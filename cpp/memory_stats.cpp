@@ -0,0 +1,61 @@
+#include "memory_stats.h"
+
+#include <atomic>
+
+namespace {
+
+struct SubsystemCounters {
+  std::atomic<int64_t> current{0};
+  std::atomic<int64_t> peak{0};
+  std::atomic<int64_t> allocations{0};
+  std::atomic<int64_t> frees{0};
+};
+
+SubsystemCounters g_counters[kMemorySubsystemCount];
+
+}  // namespace
+
+void memory_track_alloc(MemorySubsystem subsystem, size_t bytes) {
+  if (subsystem < 0 || subsystem >= kMemorySubsystemCount)
+    return;
+  SubsystemCounters& c = g_counters[subsystem];
+  const int64_t now =
+      c.current.fetch_add(static_cast<int64_t>(bytes),
+                          std::memory_order_relaxed) +
+      static_cast<int64_t>(bytes);
+  c.allocations.fetch_add(1, std::memory_order_relaxed);
+
+  int64_t peak = c.peak.load(std::memory_order_relaxed);
+  while (now > peak &&
+         !c.peak.compare_exchange_weak(peak, now, std::memory_order_relaxed)) {
+  }
+}
+
+void memory_track_free(MemorySubsystem subsystem, size_t bytes) {
+  if (subsystem < 0 || subsystem >= kMemorySubsystemCount)
+    return;
+  SubsystemCounters& c = g_counters[subsystem];
+  c.current.fetch_sub(static_cast<int64_t>(bytes), std::memory_order_relaxed);
+  c.frees.fetch_add(1, std::memory_order_relaxed);
+}
+
+int memory_get_stats(MemoryStats* out, int maxCount) {
+  if (!out || maxCount <= 0)
+    return 0;
+  const int count =
+      maxCount < kMemorySubsystemCount ? maxCount : kMemorySubsystemCount;
+  for (int i = 0; i < count; i++) {
+    const SubsystemCounters& c = g_counters[i];
+    out[i].currentBytes = c.current.load(std::memory_order_relaxed);
+    out[i].peakBytes = c.peak.load(std::memory_order_relaxed);
+    out[i].allocations = c.allocations.load(std::memory_order_relaxed);
+    out[i].frees = c.frees.load(std::memory_order_relaxed);
+  }
+  return count;
+}
+
+void memory_reset_peaks() {
+  for (SubsystemCounters& c : g_counters)
+    c.peak.store(c.current.load(std::memory_order_relaxed),
+                 std::memory_order_relaxed);
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/*
+ * Per-subsystem memory accounting
+ *
+ * Every heap allocation the library makes is attributed to a subsystem, either
+ * through TrackedAllocator (for std::vector storage) or by calling
+ * memory_track_alloc() / memory_track_free() directly. Counters are
+ * process-wide atomics, so accounting costs two relaxed atomic adds per
+ * allocation and never allocates itself.
+ *
+ * A block that is allocated but never freed keeps allocations - frees above
+ * zero, so leaks (e.g. frames the SDK never releases) show up as a live count
+ * that does not return to its steady-state value.
+ */
+
+enum MemorySubsystem : int32_t {
+  kMemoryPendingInput = 0,  // Unpacked RGB frame data from setFrameData()
+  kMemoryPackScratch,       // Temporary buffers used while packing
+  kMemoryFramePool,         // Page-aligned frame buffers handed to the SDK
+  kMemoryOverlays,          // Overlay sprites
+  kMemoryCaches,            // Packed base frame, supported format list
+  kMemoryLogger,            // Frame timing histograms and outlier log
+  kMemoryFrameCache,        // Compressed frame cache entries
+  kMemoryTrace,             // Span tracing rings
+  kMemoryRecorder,          // Output recording slots and replayed frames
+  kMemorySubsystemCount
+};
+
+struct MemoryStats {
+  int64_t currentBytes;
+  int64_t peakBytes;    // Since start or memory_reset_peaks()
+  int64_t allocations;  // Blocks allocated since start
+  int64_t frees;        // Blocks freed since start
+};
+
+void memory_track_alloc(MemorySubsystem subsystem, size_t bytes);
+void memory_track_free(MemorySubsystem subsystem, size_t bytes);
+
+// Copies up to maxCount subsystems, in enum order; returns the number copied
+int memory_get_stats(MemoryStats* out, int maxCount);
+// Resets every peak to the current value
+void memory_reset_peaks();
+
+template <typename T, MemorySubsystem Subsystem>
+struct TrackedAllocator {
+  using value_type = T;
+
+  TrackedAllocator() = default;
+  template <typename U>
+  TrackedAllocator(const TrackedAllocator<U, Subsystem>&) {}
+
+  template <typename U>
+  struct rebind {
+    using other = TrackedAllocator<U, Subsystem>;
+  };
+
+  T* allocate(size_t n) {
+    T* p = std::allocator<T>().allocate(n);
+    memory_track_alloc(Subsystem, n * sizeof(T));
+    return p;
+  }
+
+  void deallocate(T* p, size_t n) {
+    memory_track_free(Subsystem, n * sizeof(T));
+    std::allocator<T>().deallocate(p, n);
+  }
+
+  template <typename U>
+  bool operator==(const TrackedAllocator<U, Subsystem>&) const {
+    return true;
+  }
+};
+
+template <typename T, MemorySubsystem Subsystem>
+using TrackedVector = std::vector<T, TrackedAllocator<T, Subsystem>>;
@@ -0,0 +1,220 @@
+#include "output_pipeline.h"
+
+#include <algorithm>
+#include <iostream>
+
+#include "frame_timing.h"
+#include "trace.h"
+
+OutputPipeline::OutputPipeline()
+    : m_inputWidth(0),
+      m_inputHeight(0),
+      m_inputSubmitNs(0),
+      m_inputTraceFrameId(0),
+      m_inputFull(false),
+      m_inputWriting(false),
+      m_packBusy(false),
+      m_ready{},
+      m_readyFull(false),
+      m_displayBusy(false),
+      m_running(false),
+      m_stopping(false),
+      m_pendingError(0),
+      m_stats{},
+      m_totalPackNs(0) {}
+
+OutputPipeline::~OutputPipeline() {
+  stop();
+}
+
+void OutputPipeline::start(PackFn pack,
+                           DisplayFn display,
+                           ThreadInitFn displayInit) {
+  stop();
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_pack = std::move(pack);
+  m_display = std::move(display);
+  m_stopping = false;
+  m_pendingError = 0;
+  m_stats = {};
+  m_totalPackNs = 0;
+  m_running = true;
+  m_stats.running = 1;
+  m_packThread = std::thread(&OutputPipeline::packLoop, this);
+  m_displayThread =
+      std::thread(&OutputPipeline::displayLoop, this, std::move(displayInit));
+}
+
+void OutputPipeline::stop() {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_running)
+      return;
+    m_stopping = true;
+  }
+  m_changed.notify_all();
+  m_packThread.join();
+  m_displayThread.join();
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_running = false;
+  m_stats.running = 0;
+  m_pack = nullptr;
+  m_display = nullptr;
+}
+
+bool OutputPipeline::running() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_running;
+}
+
+/**
+ * @brief Queues a frame for packing and display
+ *
+ * Blocks only while the input slot still holds the previous submission,
+ * i.e. while both the pack and the display stage are busy. The copy into
+ * the slot happens outside the lock so the other stages are never stalled
+ * by it.
+ *
+ * @return int 0, the last pack or display error, or -1 if not running
+ */
+int OutputPipeline::submit(const uint16_t* data, int width, int height) {
+  if (!data || width <= 0 || height <= 0)
+    return -1;
+
+  std::unique_lock<std::mutex> lock(m_mutex);
+  if (!m_running || m_stopping)
+    return -1;
+  const int64_t waitStart = FrameTimingAnalyzer::nowNs();
+  m_changed.wait(lock, [this] { return !m_inputFull && !m_inputWriting; });
+  const int64_t now = FrameTimingAnalyzer::nowNs();
+  m_stats.submitBlockedNs += now - waitStart;
+  m_inputWriting = true;
+  lock.unlock();
+
+  const int64_t traceFrameId = trace_current_frame();
+  trace_record(kTraceWait, waitStart, now, traceFrameId);
+  {
+    TraceScope span(kTraceCopy);
+    const size_t size = static_cast<size_t>(width) * height * 3;
+    m_input.assign(data, data + size);
+  }
+
+  lock.lock();
+  m_inputWidth = width;
+  m_inputHeight = height;
+  m_inputSubmitNs = now;
+  m_inputTraceFrameId = traceFrameId;
+  m_inputWriting = false;
+  m_inputFull = true;
+  m_stats.submitted++;
+  const int err = m_pendingError;
+  m_pendingError = 0;
+  lock.unlock();
+  m_changed.notify_all();
+  return err;
+}
+
+void OutputPipeline::flush() {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  if (!m_running)
+    return;
+  m_changed.wait(lock, [this] { return idleLocked(); });
+}
+
+bool OutputPipeline::idleLocked() const {
+  return !m_inputFull && !m_inputWriting && !m_packBusy && !m_readyFull &&
+         !m_displayBusy;
+}
+
+PipelineStats OutputPipeline::stats() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_stats;
+}
+
+void OutputPipeline::packLoop() {
+  trace_name_thread("pipeline pack");
+  std::unique_lock<std::mutex> lock(m_mutex);
+  while (true) {
+    m_changed.wait(lock, [this] { return m_inputFull || m_stopping; });
+    if (!m_inputFull)
+      break;
+
+    m_packing.swap(m_input);
+    const int width = m_inputWidth;
+    const int height = m_inputHeight;
+    const int64_t submitNs = m_inputSubmitNs;
+    const int64_t traceFrameId = m_inputTraceFrameId;
+    m_inputFull = false;
+    m_packBusy = true;
+    m_changed.notify_all();
+    lock.unlock();
+
+    trace_set_frame(traceFrameId);
+    const int64_t packStart = FrameTimingAnalyzer::nowNs();
+    PipelineFrame frame = {};
+    const int err = m_pack(m_packing, width, height, &frame);
+    const int64_t packNs = FrameTimingAnalyzer::nowNs() - packStart;
+
+    lock.lock();
+    if (err) {
+      std::cerr << "[OutputPipeline] Pack failed (error " << err << ")"
+                << std::endl;
+      m_stats.errors++;
+      m_stats.lastError = err;
+      m_pendingError = err;
+      m_packBusy = false;
+      m_changed.notify_all();
+      continue;
+    }
+    m_stats.packed++;
+    m_totalPackNs += packNs;
+    m_stats.meanPackNs = m_totalPackNs / m_stats.packed;
+    m_stats.maxPackNs = std::max(m_stats.maxPackNs, packNs);
+
+    frame.submitNs = submitNs;
+    frame.traceFrameId = traceFrameId;
+    m_changed.wait(lock, [this] { return !m_readyFull; });
+    m_ready = frame;
+    m_readyFull = true;
+    m_packBusy = false;
+    m_changed.notify_all();
+  }
+}
+
+void OutputPipeline::displayLoop(ThreadInitFn init) {
+  trace_name_thread("pipeline display");
+  if (init)
+    init();
+
+  std::unique_lock<std::mutex> lock(m_mutex);
+  while (true) {
+    m_changed.wait(lock, [this] {
+      return m_readyFull || (m_stopping && !m_inputFull && !m_packBusy);
+    });
+    if (!m_readyFull)
+      break;
+
+    const PipelineFrame frame = m_ready;
+    m_ready = {};
+    m_readyFull = false;
+    m_displayBusy = true;
+    m_changed.notify_all();
+    lock.unlock();
+
+    trace_set_frame(frame.traceFrameId);
+    const int err = m_display(frame);
+
+    lock.lock();
+    m_displayBusy = false;
+    if (err) {
+      m_stats.errors++;
+      m_stats.lastError = err;
+      m_pendingError = err;
+    } else {
+      m_stats.displayed++;
+    }
+    m_changed.notify_all();
+  }
+}
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include "DeckLinkAPI.h"
+#include "memory_stats.h"
+
+/*
+ * Pack-while-display pipeline for synchronous output
+ *
+ * submit() copies a frame into the input slot and returns; a pack thread
+ * turns it into a packed frame while a display thread is blocked in
+ * DisplayVideoFrameSync() on the previous one. Each stage holds at most one
+ * frame, so a caller is only held up when every stage is busy, and the
+ * sequence runs at the display rate as long as packing takes less than one
+ * frame time.
+ */
+
+using PipelineInput = TrackedVector<uint16_t, kMemoryPendingInput>;
+
+struct PipelineFrame {
+  IDeckLinkMutableVideoFrame* frame;
+  void* bytes;
+  int64_t submitNs;  // When the frame data was submitted
+  int64_t traceFrameId;
+};
+
+struct PipelineStats {
+  int32_t running;
+  int32_t lastError;  // Most recent pack or display error, 0 if none
+  int64_t submitted;
+  int64_t packed;
+  int64_t displayed;
+  int64_t errors;
+  int64_t submitBlockedNs;  // Total time submit() waited for the input slot
+  int64_t meanPackNs;
+  int64_t maxPackNs;
+};
+
+class OutputPipeline {
+ public:
+  // Packs an input (which it may swap with other storage) into a new frame
+  using PackFn =
+      std::function<int(PipelineInput& data, int width, int height,
+                        PipelineFrame* out)>;
+  // Displays a packed frame; takes over the frame reference
+  using DisplayFn = std::function<int(const PipelineFrame& frame)>;
+  // Runs once on the display thread before the first frame
+  using ThreadInitFn = std::function<void()>;
+
+  OutputPipeline();
+  ~OutputPipeline();
+
+  void start(PackFn pack, DisplayFn display, ThreadInitFn displayInit);
+  // Displays everything already submitted, then joins the threads
+  void stop();
+  bool running() const;
+
+  // Waits for the input slot, copies the frame into it and returns; the
+  // result is the last pack or display error (cleared by reading it)
+  int submit(const uint16_t* data, int width, int height);
+  // Waits until every submitted frame has been displayed
+  void flush();
+
+  PipelineStats stats() const;
+
+ private:
+  void packLoop();
+  void displayLoop(ThreadInitFn init);
+  bool idleLocked() const;
+
+  PackFn m_pack;
+  DisplayFn m_display;
+
+  mutable std::mutex m_mutex;
+  std::condition_variable m_changed;
+  std::thread m_packThread;
+  std::thread m_displayThread;
+
+  // Input slot and the buffer the pack thread is reading
+  PipelineInput m_input;
+  PipelineInput m_packing;
+  int m_inputWidth;
+  int m_inputHeight;
+  int64_t m_inputSubmitNs;
+  int64_t m_inputTraceFrameId;
+  bool m_inputFull;
+  bool m_inputWriting;  // submit() is copying into m_input outside the lock
+  bool m_packBusy;
+
+  // Packed frame waiting for the display thread
+  PipelineFrame m_ready;
+  bool m_readyFull;
+  bool m_displayBusy;
+
+  bool m_running;
+  bool m_stopping;
+  int m_pendingError;
+  PipelineStats m_stats;
+  int64_t m_totalPackNs;
+};
@@ -0,0 +1,143 @@
+#include "overlay.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "pixel_packing.h"
+#include "trace.h"
+
+int32_t OverlayCompositor::add(int32_t x,
+                               int32_t y,
+                               uint16_t width,
+                               uint16_t height,
+                               const uint16_t* rgba,
+                               bool enabled) {
+  if (!rgba || width == 0 || height == 0)
+    return -1;
+
+  Sprite sprite{m_nextId++, x, y, width, height, enabled, {}, {}, {}};
+  sprite.rgba.assign(rgba, rgba + static_cast<size_t>(width) * height * 4);
+
+  // Fully transparent margins are never touched; precompute per row
+  sprite.spanBegin.resize(height);
+  sprite.spanEnd.resize(height);
+  for (int row = 0; row < height; row++) {
+    const uint16_t* src = sprite.rgba.data() + row * width * 4;
+    int first = width;
+    int last = 0;
+    for (int col = 0; col < width; col++) {
+      if (src[col * 4 + 3] != 0) {
+        first = std::min(first, col);
+        last = col + 1;
+      }
+    }
+    sprite.spanBegin[row] = static_cast<uint16_t>(first);
+    sprite.spanEnd[row] = static_cast<uint16_t>(last);
+  }
+
+  m_sprites.push_back(std::move(sprite));
+  return m_sprites.back().id;
+}
+
+OverlayCompositor::Sprite* OverlayCompositor::find(int32_t id) {
+  for (Sprite& sprite : m_sprites) {
+    if (sprite.id == id)
+      return &sprite;
+  }
+  return nullptr;
+}
+
+bool OverlayCompositor::remove(int32_t id) {
+  auto it = std::find_if(m_sprites.begin(), m_sprites.end(),
+                         [id](const Sprite& s) { return s.id == id; });
+  if (it == m_sprites.end())
+    return false;
+  m_sprites.erase(it);
+  return true;
+}
+
+bool OverlayCompositor::setEnabled(int32_t id, bool enabled) {
+  Sprite* sprite = find(id);
+  if (!sprite)
+    return false;
+  sprite->enabled = enabled;
+  return true;
+}
+
+bool OverlayCompositor::move(int32_t id, int32_t x, int32_t y) {
+  Sprite* sprite = find(id);
+  if (!sprite)
+    return false;
+  sprite->x = x;
+  sprite->y = y;
+  return true;
+}
+
+bool OverlayCompositor::hasVisible() const {
+  return std::any_of(m_sprites.begin(), m_sprites.end(),
+                     [](const Sprite& s) { return s.enabled; });
+}
+
+/**
+ * @brief Blends the enabled sprites into a packed frame
+ *
+ * For each sprite row the covered columns are widened to whole pixel groups,
+ * decoded, alpha-blended and re-encoded; everything else in the frame is left
+ * as packed. Sprites are clipped to the frame.
+ *
+ * @return int 0 on success, -8 if the pixel format has no packer
+ */
+int OverlayCompositor::composite(void* destData,
+                                 BMDPixelFormat pixelFormat,
+                                 uint16_t width,
+                                 uint16_t height,
+                                 uint16_t rowBytes) {
+  TraceScope span(kTraceOverlay);
+  const int group = pixel_group_size(pixelFormat);
+  uint8_t* frame = static_cast<uint8_t*>(destData);
+
+  for (const Sprite& sprite : m_sprites) {
+    if (!sprite.enabled)
+      continue;
+
+    const int rowFirst = std::max(0, -sprite.y);
+    const int rowLast = std::min<int>(sprite.height, height - sprite.y);
+    for (int row = rowFirst; row < rowLast; row++) {
+      // Visible columns of this sprite row, in frame coordinates
+      const int x0 = std::max<int>(sprite.x + sprite.spanBegin[row], 0);
+      const int x1 = std::min<int>(sprite.x + sprite.spanEnd[row], width);
+      if (x0 >= x1)
+        continue;
+
+      const int groupFirst = x0 / group * group;
+      const int groupLast = (x1 + group - 1) / group * group;
+      const int count = groupLast - groupFirst;
+      m_scratch.resize(static_cast<size_t>(count) * 3);
+
+      void* rowData = frame + static_cast<size_t>(sprite.y + row) * rowBytes;
+      int err = unpack_pixel_span(rowData, pixelFormat, m_scratch.data(),
+                                  groupFirst, count);
+      if (err)
+        return err;
+
+      const uint16_t* src = sprite.rgba.data() + row * sprite.width * 4;
+      for (int x = x0; x < x1; x++) {
+        const uint16_t* s = src + (x - sprite.x) * 4;
+        const uint32_t alpha = std::min<uint16_t>(s[3], 255);
+        if (alpha == 0)
+          continue;
+        uint16_t* d = m_scratch.data() + (x - groupFirst) * 3;
+        for (int c = 0; c < 3; c++) {
+          d[c] = static_cast<uint16_t>(
+              (s[c] * alpha + d[c] * (255 - alpha) + 127) / 255);
+        }
+      }
+
+      err = pack_pixel_span(rowData, pixelFormat, m_scratch.data(), groupFirst,
+                            count);
+      if (err)
+        return err;
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "DeckLinkAPI.h"
+#include "memory_stats.h"
+
+/*
+ * Packed-domain overlay compositing
+ *
+ * Overlays (crosshairs, labels, markers) are small RGBA sprites blended
+ * directly into an already packed frame. Only the pixel groups each sprite
+ * covers are decoded, blended and re-encoded, so toggling or moving an
+ * overlay never repacks the full-resolution source image.
+ *
+ * Sprite RGB samples are code values at the output bit depth (the same range
+ * as setFrameData()); alpha is 0-255. Sprites are composited in the order
+ * they were added.
+ */
+
+class OverlayCompositor {
+ public:
+  // Copies the sprite; returns its id (> 0) or -1 on invalid arguments
+  int32_t add(int32_t x,
+              int32_t y,
+              uint16_t width,
+              uint16_t height,
+              const uint16_t* rgba,
+              bool enabled);
+  bool remove(int32_t id);
+  bool setEnabled(int32_t id, bool enabled);
+  bool move(int32_t id, int32_t x, int32_t y);
+  void clear() { m_sprites.clear(); }
+
+  // True if at least one sprite would be drawn
+  bool hasVisible() const;
+
+  // Blends every enabled sprite into @p destData in place
+  int composite(void* destData,
+                BMDPixelFormat pixelFormat,
+                uint16_t width,
+                uint16_t height,
+                uint16_t rowBytes);
+
+ private:
+  struct Sprite {
+    int32_t id;
+    int32_t x;
+    int32_t y;
+    uint16_t width;
+    uint16_t height;
+    bool enabled;
+    TrackedVector<uint16_t, kMemoryOverlays> rgba;
+    // Per sprite row: [first, last) columns with non-zero alpha
+    TrackedVector<uint16_t, kMemoryOverlays> spanBegin;
+    TrackedVector<uint16_t, kMemoryOverlays> spanEnd;
+  };
+
+  Sprite* find(int32_t id);
+
+  TrackedVector<Sprite, kMemoryOverlays> m_sprites;
+  int32_t m_nextId = 1;
+  TrackedVector<uint16_t, kMemoryPackScratch> m_scratch;
+};
@@ -0,0 +1,227 @@
+#include "pack_workers.h"
+
+#include <algorithm>
+#include <iostream>
+
+#include "pixel_packing.h"
+#include "thread_policy.h"
+#include "trace.h"
+
+PackWorkerPool::PackWorkerPool()
+    : m_job{},
+      m_bandScratch(1),
+      m_generation(0),
+      m_pending(0),
+      m_result(0),
+      m_pinned(0),
+      m_stopping(false),
+      m_loggedPlacement{} {}
+
+PackWorkerPool::~PackWorkerPool() {
+  stop();
+}
+
+int PackWorkerPool::start(int count, int firstCore) {
+  std::lock_guard<std::mutex> dispatchLock(m_dispatchMutex);
+  stopWorkers();
+  if (count <= 0)
+    return 0;
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stopping = false;
+    m_pinned = 0;
+    // Workers wait for the generation to move past this value
+    m_pending = count;
+    m_bandStats.assign(count + 1, PixelStats{});
+    m_bandScratch.resize(count + 1);
+  }
+  for (int i = 0; i < count; i++)
+    m_threads.emplace_back(&PackWorkerPool::run, this, i,
+                           firstCore >= 0 ? firstCore + i : -1);
+
+  // Wait until every worker has applied its pin so the result is accurate
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_done.wait(lock, [this] { return m_pending == 0; });
+  return m_pinned;
+}
+
+void PackWorkerPool::stop() {
+  std::lock_guard<std::mutex> dispatchLock(m_dispatchMutex);
+  stopWorkers();
+}
+
+void PackWorkerPool::stopWorkers() {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stopping = true;
+  }
+  m_wake.notify_all();
+  for (std::thread& thread : m_threads)
+    thread.join();
+  m_threads.clear();
+}
+
+void PackWorkerPool::bandFor(int band,
+                             uint16_t* firstRow,
+                             uint16_t* lastRow) const {
+  const int bands = workerCount() + 1;
+  const int height = m_job.height;
+  *firstRow = static_cast<uint16_t>(height * band / bands);
+  *lastRow = static_cast<uint16_t>(height * (band + 1) / bands);
+}
+
+void PackWorkerPool::run(int index, int core) {
+  trace_name_thread("pack worker");
+  int32_t pinned = pin_current_thread(core);
+  uint64_t seen;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (pinned == kThreadPinHard || pinned == kThreadPinHint)
+      m_pinned++;
+    seen = m_generation;
+    if (--m_pending == 0)
+      m_done.notify_one();
+  }
+
+  for (;;) {
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_wake.wait(lock,
+                  [this, seen] { return m_stopping || m_generation != seen; });
+      if (m_stopping)
+        return;
+      seen = m_generation;
+    }
+
+    PixelStats* stats = nullptr;
+    if (m_job.stats) {
+      stats = &m_bandStats[index + 1];
+      pixel_stats_reset(stats);
+    }
+    trace_set_frame(m_job.traceFrameId);
+    int result;
+    {
+      TraceScope span(kTracePack);
+      result = packBand(index + 1, stats);
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (result != 0)
+      m_result = result;
+    if (--m_pending == 0)
+      m_done.notify_one();
+  }
+}
+
+int PackWorkerPool::packBand(int band, PixelStats* stats) {
+  uint16_t firstRow, lastRow;
+  bandFor(band, &firstRow, &lastRow);
+  if (m_job.placement)
+    return pack_placed_rows(m_job.destData, m_job.pixelFormat, m_job.srcData,
+                            *m_job.placement, m_job.rowBytes, firstRow,
+                            lastRow, &m_bandScratch[band], stats,
+                            m_job.nitsLut);
+  return pack_pixel_format_rows(m_job.destData, m_job.pixelFormat,
+                                m_job.srcData, m_job.width, m_job.height,
+                                m_job.rowBytes, firstRow, lastRow, stats,
+                                m_job.nitsLut);
+}
+
+/**
+ * @brief Packs a frame using the workers plus the calling thread
+ *
+ * Each participant packs a contiguous band of rows, so writes never overlap.
+ * Statistics are likewise kept per band and merged once every band is done.
+ * Falls back to pack_pixel_format() when no workers are running.
+ *
+ * @return int 0 on success, -8 if the pixel format has no packer
+ */
+int PackWorkerPool::pack(void* destData,
+                         BMDPixelFormat pixelFormat,
+                         const uint16_t* srcData,
+                         uint16_t width,
+                         uint16_t height,
+                         uint16_t rowBytes,
+                         PixelStats* stats,
+                         const float* nitsLut) {
+  std::lock_guard<std::mutex> dispatchLock(m_dispatchMutex);
+  if (stats)
+    pixel_stats_reset(stats);
+  if (m_threads.empty())
+    return pack_pixel_format(destData, pixelFormat, srcData, width, height,
+                             rowBytes, stats, nitsLut);
+  return dispatch({destData, pixelFormat, srcData, width, height, rowBytes,
+                   stats != nullptr, nitsLut, nullptr, trace_current_frame()},
+                  stats);
+}
+
+int PackWorkerPool::packPlaced(void* destData,
+                               BMDPixelFormat pixelFormat,
+                               const uint16_t* srcData,
+                               const PlacementMap& map,
+                               int32_t rowBytes,
+                               PixelStats* stats,
+                               const float* nitsLut) {
+  if (map.identity)
+    return pack(destData, pixelFormat, srcData,
+                static_cast<uint16_t>(map.outputWidth),
+                static_cast<uint16_t>(map.outputHeight),
+                static_cast<uint16_t>(rowBytes), stats, nitsLut);
+  std::lock_guard<std::mutex> dispatchLock(m_dispatchMutex);
+  if (stats)
+    pixel_stats_reset(stats);
+  int err = dispatch({destData, pixelFormat, srcData,
+                      static_cast<uint16_t>(map.outputWidth),
+                      static_cast<uint16_t>(map.outputHeight),
+                      static_cast<uint16_t>(rowBytes), stats != nullptr,
+                      nitsLut, &map, trace_current_frame()},
+                     stats);
+  // Logged when the layout changes, not for every frame placed with it
+  const int32_t layout[6] = {map.cropWidth,   map.cropHeight,
+                             map.destWidth,   map.destHeight,
+                             map.outputWidth, map.outputHeight};
+  if (!err && !std::equal(std::begin(layout), std::end(layout),
+                          std::begin(m_loggedPlacement))) {
+    std::copy(std::begin(layout), std::end(layout),
+              std::begin(m_loggedPlacement));
+    std::cerr << "[PixelPacking] Placed " << map.cropWidth << "x"
+              << map.cropHeight << " source at " << map.destWidth << "x"
+              << map.destHeight << " in " << map.outputWidth << "x"
+              << map.outputHeight << std::endl;
+  }
+  return err;
+}
+
+// Runs @p job on every band, the calling thread taking band 0. Requires
+// m_dispatchMutex.
+int PackWorkerPool::dispatch(const Job& job, PixelStats* stats) {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_job = job;
+    m_pending = workerCount();
+    m_result = 0;
+    m_generation++;
+  }
+  if (!m_threads.empty())
+    m_wake.notify_all();
+
+  int result = packBand(0, stats);
+
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_done.wait(lock, [this] { return m_pending == 0; });
+  if (result == 0)
+    result = m_result;
+  if (stats) {
+    for (int band = 1; band <= workerCount(); band++)
+      pixel_stats_merge(stats, m_bandStats[band]);
+  }
+
+  if (result == -8)
+    std::cerr << "[DeckLink] Unsupported pixel format: 0x" << std::hex
+              << job.pixelFormat << std::dec << std::endl;
+  else if (result)
+    std::cerr << "[PixelPacking] Packing " << job.width << "x" << job.height
+              << " frame failed (error " << result << ")" << std::endl;
+  return result;
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "DeckLinkAPI.h"
+#include "frame_placement.h"
+#include "pixel_packing.h"
+
+/*
+ * Persistent threads that split pack_pixel_format() across row bands
+ *
+ * The calling thread packs the first band itself, so N workers give N + 1-way
+ * parallelism and zero workers is equivalent to a plain pack_pixel_format().
+ * Workers are created once and can be pinned, avoiding per-frame thread
+ * creation on the output path.
+ */
+
+class PackWorkerPool {
+ public:
+  PackWorkerPool();
+  ~PackWorkerPool();
+
+  // Starts `count` workers; worker i is pinned to firstCore + i when
+  // firstCore >= 0. Returns the number of workers pinned.
+  int start(int count, int firstCore);
+  void stop();
+
+  int workerCount() const { return static_cast<int>(m_threads.size()); }
+
+  // Same contract as pack_pixel_format(); each band gathers its own
+  // statistics and they are merged into @p stats afterwards
+  int pack(void* destData,
+           BMDPixelFormat pixelFormat,
+           const uint16_t* srcData,
+           uint16_t width,
+           uint16_t height,
+           uint16_t rowBytes,
+           PixelStats* stats = nullptr,
+           const float* nitsLut = nullptr);
+
+  // pack() through a placement: bands are rows of the output raster and
+  // each participant resamples into its own scratch
+  int packPlaced(void* destData,
+                 BMDPixelFormat pixelFormat,
+                 const uint16_t* srcData,
+                 const PlacementMap& map,
+                 int32_t rowBytes,
+                 PixelStats* stats = nullptr,
+                 const float* nitsLut = nullptr);
+
+ private:
+  struct Job {
+    void* destData;
+    BMDPixelFormat pixelFormat;
+    const uint16_t* srcData;
+    uint16_t width;
+    uint16_t height;
+    uint16_t rowBytes;
+    bool stats;
+    const float* nitsLut;
+    const PlacementMap* placement;  // Null for a plain pack
+    int64_t traceFrameId;
+  };
+
+  void stopWorkers();
+  void run(int index, int core);
+  void bandFor(int band, uint16_t* firstRow, uint16_t* lastRow) const;
+  int packBand(int band, PixelStats* stats);
+  int dispatch(const Job& job, PixelStats* stats);
+
+  std::vector<std::thread> m_threads;
+  // One job at a time: dispatch() owns m_job and the band state until every
+  // band is done, and start()/stop() must not replace workers under it
+  std::mutex m_dispatchMutex;
+  std::mutex m_mutex;
+  std::condition_variable m_wake;
+  std::condition_variable m_done;
+  Job m_job;
+  std::vector<PixelStats> m_bandStats;  // One per band, band 0 is the caller
+  std::vector<PlacementScratch> m_bandScratch;
+  uint64_t m_generation;
+  int m_pending;
+  int m_result;
+  int m_pinned;
+  bool m_stopping;
+  // Crop, destination and output sizes of the last placement logged
+  int32_t m_loggedPlacement[6];
+};
@@ -1,12 +1,16 @@
 #include "pixel_packing.h"
 #include <algorithm>
 #include <bit>
+#include <cmath>
 #include <cstdint>
 #include <cstring>
 #include <iostream>
+#include <iterator>
 #include <numeric>
 #include <vector>
 
+#include "memory_stats.h"
+
 /*
  * Pixel Packing for Blackmagic DeckLink API
  *
@@ -26,61 +30,213 @@
  * perform any RGB to YUV conversion
  */
 
+// Reads one channel of an interleaved RGB sample, clamped to maxval
+static inline uint32_t channel(const uint16_t* srcData,
+                               size_t pixel,
+                               int c,
+                               uint16_t maxval) {
+  return std::min(srcData[pixel * 3 + c], maxval);
+}
+
+// Adds one row of source pixels to @p stats while it is in cache for
+// packing; samples above maxval count as clipped. Samples are accumulated in
+// lanes of eight whole pixels so the loop vectorizes despite the interleaved
+// channels; lane j holds channel j % 3. The per-pixel pass (largest
+// component) only runs when there is a light level table or clipping.
+static void observe_row(PixelStats* stats,
+                        const uint16_t* row,
+                        uint16_t width,
+                        uint16_t maxval,
+                        const float* nitsLut) {
+  constexpr int kLanes = 24;
+  // A lane sees at most 65535 / 8 samples of 16 bits, so 32 bits suffice
+  uint32_t sum[kLanes] = {}, clipped[kLanes] = {};
+  uint16_t lo[kLanes], hi[kLanes] = {};
+  std::fill(std::begin(lo), std::end(lo), 0xFFFF);
+
+  auto observe = [&](int lane, uint16_t value) {
+    clipped[lane] += value > maxval;
+    value = std::min(value, maxval);
+    sum[lane] += value;
+    lo[lane] = std::min(lo[lane], value);
+    hi[lane] = std::max(hi[lane], value);
+  };
+  const int samples = width * 3;
+  int i = 0;
+  for (; i + kLanes <= samples; i += kLanes) {
+    for (int lane = 0; lane < kLanes; lane++)
+      observe(lane, row[i + lane]);
+  }
+  for (int lane = 0; lane < kLanes && i + lane < samples; lane++)
+    observe(lane, row[i + lane]);
+
+  uint64_t anyClipped = 0;
+  for (int lane = 0; lane < kLanes; lane++) {
+    const int c = lane % 3;
+    stats->sum[c] += sum[lane];
+    stats->clipped[c] += clipped[lane];
+    stats->min[c] = std::min(stats->min[c], lo[lane]);
+    stats->max[c] = std::max(stats->max[c], hi[lane]);
+    anyClipped += clipped[lane];
+  }
+  if (!anyClipped && !nitsLut)
+    return;
+
+  uint64_t clippedPixels = 0;
+  float light = 0.0f;
+  for (int x = 0; x < width; x++) {
+    const uint16_t* pixel = row + x * 3;
+    const uint16_t peak = std::max({pixel[0], pixel[1], pixel[2]});
+    clippedPixels += peak > maxval;
+    if (nitsLut)
+      light += nitsLut[std::min(peak, maxval)];
+  }
+  stats->clippedPixels += clippedPixels;
+  stats->lightSum += light;
+}
+
+// 8-bit BGRA/ARGB word with opaque alpha
+static inline uint32_t encode_8bpc(uint32_t r,
+                                   uint32_t g,
+                                   uint32_t b,
+                                   bool isBGRA) {
+  if (isBGRA) {
+    // BGRA format: AABBGGRR
+    return (0xFFu << 24) | (r << 16) | (g << 8) | b;
+  }
+  // ARGB format: AARRGGBB
+  return (0xFFu << 24) | (b << 16) | (g << 8) | r;
+}
+
+static inline void decode_8bpc(uint32_t color, bool isBGRA, uint16_t* rgb) {
+  const uint16_t hi = (color >> 16) & 0xFF;
+  const uint16_t lo = color & 0xFF;
+  rgb[0] = isBGRA ? hi : lo;
+  rgb[1] = (color >> 8) & 0xFF;
+  rgb[2] = isBGRA ? lo : hi;
+}
+
+static inline uint32_t byteswap32(uint32_t v) {
+  return ((v & 0xFF000000) >> 24) | ((v & 0x00FF0000) >> 8) |
+         ((v & 0x0000FF00) << 8) | ((v & 0x000000FF) << 24);
+}
+
+// r210 word from 10-bit components
+static inline uint32_t encode_r210(uint32_t r_10,
+                                   uint32_t g_10,
+                                   uint32_t b_10) {
+  // Pack using Blackmagic's reference implementation in ColorBars.cpp
+  // Refer to DeckLink SDK Manual, section 2.7.4 for packing structure
+
+  // r210 is big-endian, so we pack the 10-bit components into a 32-bit
+  // integer in R, G, B order from the most significant bits. The top 2 bits
+  // are unused.
+  uint32_t pixel = (r_10 << 20) | (g_10 << 10) | b_10;
+
+  // If the system is little-endian, we need to byte-swap the result.
+  if (std::endian::native == std::endian::little)
+    pixel = byteswap32(pixel);
+  return pixel;
+}
+
+static inline void decode_r210(uint32_t pixel, uint16_t* rgb) {
+  if (std::endian::native == std::endian::little)
+    pixel = byteswap32(pixel);
+  rgb[0] = (pixel >> 20) & 0x3FF;
+  rgb[1] = (pixel >> 10) & 0x3FF;
+  rgb[2] = pixel & 0x3FF;
+}
+
+// One R12L group: 8 pixels of 12-bit components in nine 32-bit words
+static inline void encode_r12l_group(uint32_t* groupPtr,
+                                     const uint32_t* r,
+                                     const uint32_t* g,
+                                     const uint32_t* b) {
+  // Based on Blackmagic's reference implementation in ColorBars.cpp
+  groupPtr[0] = ((b[0] & 0x0FF) << 24) | ((g[0] & 0xFFF) << 12) |
+                (r[0] & 0xFFF);
+  groupPtr[1] = ((b[1] & 0x00F) << 28) | ((g[1] & 0xFFF) << 16) |
+                ((r[1] & 0xFFF) << 4) | ((b[0] & 0xF00) >> 8);
+  groupPtr[2] = ((g[2] & 0xFFF) << 20) | ((r[2] & 0xFFF) << 8) |
+                ((b[1] & 0xFF0) >> 4);
+  groupPtr[3] = ((g[3] & 0x0FF) << 24) | ((r[3] & 0xFFF) << 12) |
+                (b[2] & 0xFFF);
+  groupPtr[4] = ((g[4] & 0x00F) << 28) | ((r[4] & 0xFFF) << 16) |
+                ((b[3] & 0xFFF) << 4) | ((g[3] & 0xF00) >> 8);
+  groupPtr[5] = ((r[5] & 0xFFF) << 20) | ((b[4] & 0xFFF) << 8) |
+                ((g[4] & 0xFF0) >> 4);
+  groupPtr[6] = ((r[6] & 0x0FF) << 24) | ((b[5] & 0xFFF) << 12) |
+                (g[5] & 0xFFF);
+  groupPtr[7] = ((r[7] & 0x00F) << 28) | ((b[6] & 0xFFF) << 16) |
+                ((g[6] & 0xFFF) << 4) | ((r[6] & 0xF00) >> 8);
+  groupPtr[8] = ((b[7] & 0xFFF) << 20) | ((g[7] & 0xFFF) << 8) |
+                ((r[7] & 0xFF0) >> 4);
+}
+
+static inline void decode_r12l_group(const uint32_t* w, uint16_t* rgb) {
+  const uint32_t r[8] = {w[0] & 0xFFF,
+                         (w[1] >> 4) & 0xFFF,
+                         (w[2] >> 8) & 0xFFF,
+                         (w[3] >> 12) & 0xFFF,
+                         (w[4] >> 16) & 0xFFF,
+                         (w[5] >> 20) & 0xFFF,
+                         (w[6] >> 24) | ((w[7] & 0xF) << 8),
+                         (w[7] >> 28) | ((w[8] & 0xFF) << 4)};
+  const uint32_t g[8] = {(w[0] >> 12) & 0xFFF,
+                         (w[1] >> 16) & 0xFFF,
+                         (w[2] >> 20) & 0xFFF,
+                         (w[3] >> 24) | ((w[4] & 0xF) << 8),
+                         (w[4] >> 28) | ((w[5] & 0xFF) << 4),
+                         w[6] & 0xFFF,
+                         (w[7] >> 4) & 0xFFF,
+                         (w[8] >> 8) & 0xFFF};
+  const uint32_t b[8] = {(w[0] >> 24) | ((w[1] & 0xF) << 8),
+                         (w[1] >> 28) | ((w[2] & 0xFF) << 4),
+                         w[3] & 0xFFF,
+                         (w[4] >> 4) & 0xFFF,
+                         (w[5] >> 8) & 0xFFF,
+                         (w[6] >> 12) & 0xFFF,
+                         (w[7] >> 16) & 0xFFF,
+                         (w[8] >> 20) & 0xFFF};
+  for (int i = 0; i < 8; i++) {
+    rgb[i * 3 + 0] = static_cast<uint16_t>(r[i]);
+    rgb[i * 3 + 1] = static_cast<uint16_t>(g[i]);
+    rgb[i * 3 + 2] = static_cast<uint16_t>(b[i]);
+  }
+}
+
 /**
  * Pack 8-bit RGB image data into BGRA/ARGB format
  *
  * Packs existing 8-bit RGB image data into BGRA or ARGB format.
  *
  * @param destData Pointer to destination frame buffer
- * @param srcR Pointer to source red channel data (8-bit, 0-255)
- * @param srcG Pointer to source green channel data (8-bit, 0-255)
- * @param srcB Pointer to source blue channel data (8-bit, 0-255)
+ * @param srcData Interleaved RGB source data (8-bit, 0-255)
  * @param width Frame width in pixels
- * @param height Frame height in pixels
  * @param rowBytes Bytes per row (including padding)
+ * @param firstRow First row to pack
+ * @param lastRow One past the last row to pack
  * @param isBGRA true for BGRA format, false for ARGB format
  */
-void pack_8bpc_rgb_image(void* destData,
-                         const uint16_t* srcR,
-                         const uint16_t* srcG,
-                         const uint16_t* srcB,
-                         uint16_t width,
-                         uint16_t height,
-                         uint16_t rowBytes,
-                         bool isBGRA) {
-  /*
-   * Pack 8-bit RGB image data into BGRA/ARGB format
-   *
-   * Packs existing 8-bit RGB image data into BGRA or ARGB format.
-   */
-
+static void pack_8bpc_rgb_rows(void* destData,
+                               const uint16_t* srcData,
+                               uint16_t width,
+                               uint16_t rowBytes,
+                               uint16_t firstRow,
+                               uint16_t lastRow,
+                               bool isBGRA) {
   uint32_t* pixels = static_cast<uint32_t*>(destData);
 
-  for (int y = 0; y < height; y++) {
+  for (int y = firstRow; y < lastRow; y++) {
+    uint32_t* row = pixels + y * (rowBytes / 4);
     for (int x = 0; x < width; x++) {
-      int srcIndex = y * width + x;
-      int destIndex = y * (rowBytes / 4) + x;
-
-      uint8_t r = srcR[srcIndex];
-      uint8_t g = srcG[srcIndex];
-      uint8_t b = srcB[srcIndex];
-
-      uint32_t color;
-      if (isBGRA) {
-        // BGRA format: AABBGGRR
-        color = (0xFF << 24) | (r << 16) | (g << 8) | b;
-      } else {
-        // ARGB format: AARRGGBB
-        color = (0xFF << 24) | (b << 16) | (g << 8) | r;
-      }
+      const size_t srcIndex = static_cast<size_t>(y) * width + x;
 
-      pixels[destIndex] = color;
+      row[x] = encode_8bpc(channel(srcData, srcIndex, 0, 0xFF),
+                           channel(srcData, srcIndex, 1, 0xFF),
+                           channel(srcData, srcIndex, 2, 0xFF), isBGRA);
     }
   }
-
-  std::cerr << "[PixelPacking] 8-bit RGB image packed: " << width << "x"
-            << height << " into " << (isBGRA ? "BGRA" : "ARGB") << " format"
-            << std::endl;
 }
 
 /**
@@ -101,54 +257,30 @@ void pack_8bpc_rgb_image(void* destData,
  * number of rows in the frame.
  *
  * @param destData Pointer to destination frame buffer
- * @param srcR Pointer to source red channel data (10-bit, 0-1023)
- * @param srcG Pointer to source green channel data (10-bit, 0-1023)
- * @param srcB Pointer to source blue channel data (10-bit, 0-1023)
+ * @param srcData Interleaved RGB source data (10-bit, 0-1023)
  * @param width Frame width in pixels
- * @param height Frame height in pixels
  * @param rowBytes Bytes per row (including padding)
+ * @param firstRow First row to pack
+ * @param lastRow One past the last row to pack
  */
-void pack_10bpc_rgb_image(void* destData,
-                          const uint16_t* srcR,
-                          const uint16_t* srcG,
-                          const uint16_t* srcB,
-                          uint16_t width,
-                          uint16_t height,
-                          uint16_t rowBytes) {
+static void pack_10bpc_rgb_rows(void* destData,
+                                const uint16_t* srcData,
+                                uint16_t width,
+                                uint16_t rowBytes,
+                                uint16_t firstRow,
+                                uint16_t lastRow) {
   uint32_t* pixels = static_cast<uint32_t*>(destData);
 
-  for (int y = 0; y < height; y++) {
+  for (int y = firstRow; y < lastRow; y++) {
+    uint32_t* row = pixels + y * (rowBytes / 4);
     for (int x = 0; x < width; x++) {
-      int srcIndex = y * width + x;
-      int destIndex = y * (rowBytes / 4) + x;
-
-      uint16_t r = srcR[srcIndex];
-      uint16_t g = srcG[srcIndex];
-      uint16_t b = srcB[srcIndex];
-
-      // Pack using Blackmagic's reference implementation in ColorBars.cpp
-      // Refer to DeckLink SDK Manual, section 2.7.4 for packing structure
-      uint32_t r_10 = r & 0x3FF;
-      uint32_t g_10 = g & 0x3FF;
-      uint32_t b_10 = b & 0x3FF;
-
-      // r210 is big-endian, so we pack the 10-bit components into a 32-bit
-      // integer in R, G, B order from the most significant bits. The top 2 bits
-      // are unused.
-      uint32_t pixel = (r_10 << 20) | (g_10 << 10) | b_10;
-
-      // If the system is little-endian, we need to byte-swap the result.
-      if (std::endian::native == std::endian::little) {
-        pixel = ((pixel & 0xFF000000) >> 24) | ((pixel & 0x00FF0000) >> 8) |
-                ((pixel & 0x0000FF00) << 8) | ((pixel & 0x000000FF) << 24);
-      }
+      const size_t srcIndex = static_cast<size_t>(y) * width + x;
 
-      pixels[destIndex] = pixel;
+      row[x] = encode_r210(channel(srcData, srcIndex, 0, 0x3FF),
+                           channel(srcData, srcIndex, 1, 0x3FF),
+                           channel(srcData, srcIndex, 2, 0x3FF));
     }
   }
-
-  std::cerr << "[PixelPacking] big-endian 10-bit RGB image packed: " << width
-            << "x" << height << std::endl;
 }
 
 /**
@@ -165,88 +297,104 @@ void pack_10bpc_rgb_image(void* destData,
  *
  * In this format, 8 pixels fit into 36 bytes.
  *
+ * Groups that run past the right edge are padded with black.
+ *
  * @param destData Pointer to destination frame buffer
- * @param srcR Pointer to source red channel data (12-bit, 0-4095)
- * @param srcG Pointer to source green channel data (12-bit, 0-4095)
- * @param srcB Pointer to source blue channel data (12-bit, 0-4095)
+ * @param srcData Interleaved RGB source data (12-bit, 0-4095)
  * @param width Frame width in pixels
- * @param height Frame height in pixels
  * @param rowBytes Bytes per row (including padding)
+ * @param firstRow First row to pack
+ * @param lastRow One past the last row to pack
  */
-void pack_12bpc_rgble_image(void* destData,
-                            const uint16_t* srcR,
-                            const uint16_t* srcG,
-                            const uint16_t* srcB,
-                            uint16_t width,
-                            uint16_t height,
-                            uint16_t rowBytes) {
+static void pack_12bpc_rgble_rows(void* destData,
+                                  const uint16_t* srcData,
+                                  uint16_t width,
+                                  uint16_t rowBytes,
+                                  uint16_t firstRow,
+                                  uint16_t lastRow) {
   uint32_t* pixels = static_cast<uint32_t*>(destData);
 
-  if (std::endian::native != std::endian::little) {
-    std::cerr << "[PixelPacking] System is not little endian, but 12b packing "
-                 "implementation likely depends on it for byte ordering. "
-                 "Proceed with caution"
-              << std::endl;
-  }
-
-  std::cerr << "[PixelPacking] Packing little-endian 12-bit RGB image: "
-            << width << "x" << height << ", rowBytes: " << rowBytes
-            << std::endl;
-
-  for (int y = 0; y < height; y++) {
+  for (int y = firstRow; y < lastRow; y++) {
     uint32_t* row = pixels + (y * (rowBytes / 4));
     for (int x = 0; x < width; x += 8) {
       uint32_t* groupPtr = row + ((x / 8) * 9);
-      // Based on Blackmagic's reference implementation in ColorBars.cpp
-      int base = y * width + x;
-      groupPtr[0] = ((srcB[base + 0] & 0x0FF) << 24) |
-                    ((srcG[base + 0] & 0xFFF) << 12) | (srcR[base + 0] & 0xFFF);
-      groupPtr[1] =
-          ((srcB[base + 1] & 0x00F) << 28) | ((srcG[base + 1] & 0xFFF) << 16) |
-          ((srcR[base + 1] & 0xFFF) << 4) | ((srcB[base + 0] & 0xF00) >> 8);
-      groupPtr[2] = ((srcG[base + 2] & 0xFFF) << 20) |
-                    ((srcR[base + 2] & 0xFFF) << 8) |
-                    ((srcB[base + 1] & 0xFF0) >> 4);
-      groupPtr[3] = ((srcG[base + 3] & 0x0FF) << 24) |
-                    ((srcR[base + 3] & 0xFFF) << 12) | (srcB[base + 2] & 0xFFF);
-      groupPtr[4] =
-          ((srcG[base + 4] & 0x00F) << 28) | ((srcR[base + 4] & 0xFFF) << 16) |
-          ((srcB[base + 3] & 0xFFF) << 4) | ((srcG[base + 3] & 0xF00) >> 8);
-      groupPtr[5] = ((srcR[base + 5] & 0xFFF) << 20) |
-                    ((srcB[base + 4] & 0xFFF) << 8) |
-                    ((srcG[base + 4] & 0xFF0) >> 4);
-      groupPtr[6] = ((srcR[base + 6] & 0x0FF) << 24) |
-                    ((srcB[base + 5] & 0xFFF) << 12) | (srcG[base + 5] & 0xFFF);
-      groupPtr[7] =
-          ((srcR[base + 7] & 0x00F) << 28) | ((srcB[base + 6] & 0xFFF) << 16) |
-          ((srcG[base + 6] & 0xFFF) << 4) | ((srcR[base + 6] & 0xF00) >> 8);
-      groupPtr[8] = ((srcB[base + 7] & 0xFFF) << 20) |
-                    ((srcG[base + 7] & 0xFFF) << 8) |
-                    ((srcR[base + 7] & 0xFF0) >> 4);
+
+      uint32_t r[8], g[8], b[8];
+      for (int i = 0; i < 8; i++) {
+        if (x + i < width) {
+          const size_t srcIndex = static_cast<size_t>(y) * width + x + i;
+          r[i] = channel(srcData, srcIndex, 0, 0xFFF);
+          g[i] = channel(srcData, srcIndex, 1, 0xFFF);
+          b[i] = channel(srcData, srcIndex, 2, 0xFFF);
+        } else {
+          r[i] = g[i] = b[i] = 0;
+        }
+      }
+
+      encode_r12l_group(groupPtr, r, g, b);
     }
   }
-
-  std::cerr
-      << "[PixelPacking] little-endian 12-bit RGB image packed successfully"
-      << std::endl;
 }
 
-// Clamp a channel buffer to a given bit depth
-static void clamp_channel(std::vector<uint16_t>& channel, int bits) {
-  uint16_t maxval = (1u << bits) - 1;
-  for (auto& v : channel) {
-    v = std::min(v, maxval);
+static int pack_rows(void* destData,
+                     BMDPixelFormat pixelFormat,
+                     const uint16_t* srcData,
+                     uint16_t width,
+                     uint16_t rowBytes,
+                     uint16_t firstRow,
+                     uint16_t lastRow) {
+  // Pack the data according to the pixel format
+  switch (pixelFormat) {
+    case bmdFormat8BitBGRA:
+      pack_8bpc_rgb_rows(destData, srcData, width, rowBytes, firstRow, lastRow,
+                         true);
+      break;
+    case bmdFormat8BitARGB:
+      pack_8bpc_rgb_rows(destData, srcData, width, rowBytes, firstRow, lastRow,
+                         false);
+      break;
+    case bmdFormat10BitRGB:
+      pack_10bpc_rgb_rows(destData, srcData, width, rowBytes, firstRow,
+                          lastRow);
+      break;
+    case bmdFormat12BitRGBLE:
+      pack_12bpc_rgble_rows(destData, srcData, width, rowBytes, firstRow,
+                            lastRow);
+      break;
+    default:
+      return -8;
   }
+  return 0;
 }
 
-// Clamp all channels to a given bit depth
-static void clamp_image_channels(std::vector<uint16_t>& r,
-                                 std::vector<uint16_t>& g,
-                                 std::vector<uint16_t>& b,
-                                 int bits) {
-  clamp_channel(r, bits);
-  clamp_channel(g, bits);
-  clamp_channel(b, bits);
+int pack_pixel_format_rows(void* destData,
+                           BMDPixelFormat pixelFormat,
+                           const uint16_t* srcData,
+                           uint16_t width,
+                           uint16_t height,
+                           uint16_t rowBytes,
+                           uint16_t firstRow,
+                           uint16_t lastRow,
+                           PixelStats* stats,
+                           const float* nitsLut) {
+  lastRow = std::min(lastRow, height);
+  if (firstRow >= lastRow)
+    return 0;
+  if (!stats)
+    return pack_rows(destData, pixelFormat, srcData, width, rowBytes,
+                     firstRow, lastRow);
+
+  // Observe each row right before packing it, so the source is only read
+  // from memory once
+  const int maxval = pixel_max_code(pixelFormat);
+  if (maxval == 0)
+    return -8;
+  for (int y = firstRow; y < lastRow; y++) {
+    observe_row(stats, srcData + static_cast<size_t>(y) * width * 3, width,
+                static_cast<uint16_t>(maxval), nitsLut);
+    pack_rows(destData, pixelFormat, srcData, width, rowBytes, y, y + 1);
+  }
+  return 0;
 }
 
 int pack_pixel_format(void* destData,
@@ -254,44 +402,232 @@ int pack_pixel_format(void* destData,
                       const uint16_t* srcData,
                       uint16_t width,
                       uint16_t height,
-                      uint16_t rowBytes) {
-  // Extract RGB channels from the raw data (3 uint16_t per pixel: R, G, B)
-  std::vector<uint16_t> r_channel(width * height);
-  std::vector<uint16_t> g_channel(width * height);
-  std::vector<uint16_t> b_channel(width * height);
-
-  for (int i = 0; i < width * height; i++) {
-    r_channel[i] = srcData[i * 3 + 0];
-    g_channel[i] = srcData[i * 3 + 1];
-    b_channel[i] = srcData[i * 3 + 2];
+                      uint16_t rowBytes,
+                      PixelStats* stats,
+                      const float* nitsLut) {
+  int err = pack_pixel_format_rows(destData, pixelFormat, srcData, width,
+                                   height, rowBytes, 0, height, stats,
+                                   nitsLut);
+  if (err) {
+    std::cerr << "[DeckLink] Unsupported pixel format: 0x" << std::hex
+              << pixelFormat << std::dec << std::endl;
+    return err;
   }
+  return 0;
+}
+
+void pixel_stats_reset(PixelStats* stats) {
+  *stats = {};
+  std::fill(std::begin(stats->min), std::end(stats->min), 0xFFFF);
+}
+
+void pixel_stats_merge(PixelStats* into, const PixelStats& from) {
+  for (int c = 0; c < 3; c++) {
+    into->sum[c] += from.sum[c];
+    into->clipped[c] += from.clipped[c];
+    into->min[c] = std::min(into->min[c], from.min[c]);
+    into->max[c] = std::max(into->max[c], from.max[c]);
+  }
+  into->clippedPixels += from.clippedPixels;
+  into->lightSum += from.lightSum;
+}
+
+int pq_nits_table(BMDPixelFormat pixelFormat, float* table) {
+  const int maxCode = pixel_max_code(pixelFormat);
+  if (maxCode == 0)
+    return 0;
+  // SMPTE ST 2084 EOTF constants
+  const double m1 = 2610.0 / 16384.0;
+  const double m2 = 2523.0 / 4096.0 * 128.0;
+  const double c1 = 3424.0 / 4096.0;
+  const double c2 = 2413.0 / 4096.0 * 32.0;
+  const double c3 = 2392.0 / 4096.0 * 32.0;
+  for (int code = 0; code <= maxCode; code++) {
+    const double e = std::pow(static_cast<double>(code) / maxCode, 1.0 / m2);
+    const double y =
+        std::pow(std::max(e - c1, 0.0) / (c2 - c3 * e), 1.0 / m1);
+    table[code] = static_cast<float>(10000.0 * y);
+  }
+  return maxCode + 1;
+}
+
+int pixel_group_size(BMDPixelFormat pixelFormat) {
+  return pixelFormat == bmdFormat12BitRGBLE ? 8 : 1;
+}
+
+int unpack_pixel_span(const void* rowData,
+                      BMDPixelFormat pixelFormat,
+                      uint16_t* destRGB,
+                      uint16_t firstPixel,
+                      uint16_t count) {
+  const uint32_t* row = static_cast<const uint32_t*>(rowData);
 
-  // Pack the data according to the pixel format
   switch (pixelFormat) {
     case bmdFormat8BitBGRA:
-      clamp_image_channels(r_channel, g_channel, b_channel, 8);
-      pack_8bpc_rgb_image(destData, r_channel.data(), g_channel.data(),
-                          b_channel.data(), width, height, rowBytes, true);
+    case bmdFormat8BitARGB: {
+      const bool isBGRA = pixelFormat == bmdFormat8BitBGRA;
+      for (int i = 0; i < count; i++)
+        decode_8bpc(row[firstPixel + i], isBGRA, destRGB + i * 3);
       break;
-    case bmdFormat8BitARGB:
-      clamp_image_channels(r_channel, g_channel, b_channel, 8);
-      pack_8bpc_rgb_image(destData, r_channel.data(), g_channel.data(),
-                          b_channel.data(), width, height, rowBytes, false);
+    }
+    case bmdFormat10BitRGB:
+      for (int i = 0; i < count; i++)
+        decode_r210(row[firstPixel + i], destRGB + i * 3);
+      break;
+    case bmdFormat12BitRGBLE:
+      if (firstPixel % 8 || count % 8)
+        return -1;
+      for (int i = 0; i < count; i += 8)
+        decode_r12l_group(row + ((firstPixel + i) / 8) * 9, destRGB + i * 3);
+      break;
+    default:
+      return -8;
+  }
+  return 0;
+}
+
+int unpack_pixel_samples(const void* rowData,
+                         BMDPixelFormat pixelFormat,
+                         const int* xs,
+                         int count,
+                         uint16_t* destRGB) {
+  const uint32_t* row = static_cast<const uint32_t*>(rowData);
+
+  switch (pixelFormat) {
+    case bmdFormat8BitBGRA:
+    case bmdFormat8BitARGB: {
+      const bool isBGRA = pixelFormat == bmdFormat8BitBGRA;
+      for (int i = 0; i < count; i++)
+        decode_8bpc(row[xs[i]], isBGRA, destRGB + i * 3);
       break;
+    }
     case bmdFormat10BitRGB:
-      clamp_image_channels(r_channel, g_channel, b_channel, 10);
-      pack_10bpc_rgb_image(destData, r_channel.data(), g_channel.data(),
-                           b_channel.data(), width, height, rowBytes);
+      for (int i = 0; i < count; i++)
+        decode_r210(row[xs[i]], destRGB + i * 3);
+      break;
+    case bmdFormat12BitRGBLE: {
+      // Neighbouring samples often share a group, so keep the last one
+      uint16_t group[24];
+      int decoded = -1;
+      for (int i = 0; i < count; i++) {
+        const int index = xs[i] / 8;
+        if (index != decoded) {
+          decode_r12l_group(row + index * 9, group);
+          decoded = index;
+        }
+        const uint16_t* rgb = group + (xs[i] % 8) * 3;
+        destRGB[i * 3 + 0] = rgb[0];
+        destRGB[i * 3 + 1] = rgb[1];
+        destRGB[i * 3 + 2] = rgb[2];
+      }
+      break;
+    }
+    default:
+      return -8;
+  }
+  return 0;
+}
+
+int pack_pixel_span(void* rowData,
+                    BMDPixelFormat pixelFormat,
+                    const uint16_t* srcRGB,
+                    uint16_t firstPixel,
+                    uint16_t count) {
+  uint32_t* row = static_cast<uint32_t*>(rowData);
+
+  switch (pixelFormat) {
+    case bmdFormat8BitBGRA:
+    case bmdFormat8BitARGB: {
+      const bool isBGRA = pixelFormat == bmdFormat8BitBGRA;
+      for (int i = 0; i < count; i++) {
+        row[firstPixel + i] = encode_8bpc(channel(srcRGB, i, 0, 0xFF),
+                                          channel(srcRGB, i, 1, 0xFF),
+                                          channel(srcRGB, i, 2, 0xFF), isBGRA);
+      }
+      break;
+    }
+    case bmdFormat10BitRGB:
+      for (int i = 0; i < count; i++) {
+        row[firstPixel + i] = encode_r210(channel(srcRGB, i, 0, 0x3FF),
+                                          channel(srcRGB, i, 1, 0x3FF),
+                                          channel(srcRGB, i, 2, 0x3FF));
+      }
       break;
     case bmdFormat12BitRGBLE:
-      clamp_image_channels(r_channel, g_channel, b_channel, 12);
-      pack_12bpc_rgble_image(destData, r_channel.data(), g_channel.data(),
-                             b_channel.data(), width, height, rowBytes);
+      if (firstPixel % 8 || count % 8)
+        return -1;
+      for (int i = 0; i < count; i += 8) {
+        uint32_t r[8], g[8], b[8];
+        for (int j = 0; j < 8; j++) {
+          r[j] = channel(srcRGB, i + j, 0, 0xFFF);
+          g[j] = channel(srcRGB, i + j, 1, 0xFFF);
+          b[j] = channel(srcRGB, i + j, 2, 0xFFF);
+        }
+        encode_r12l_group(row + ((firstPixel + i) / 8) * 9, r, g, b);
+      }
       break;
     default:
-      std::cerr << "[DeckLink] Unsupported pixel format: 0x" << std::hex
-                << pixelFormat << std::dec << std::endl;
       return -8;
   }
   return 0;
-}
\ No newline at end of file
+}
+
+int pixel_max_code(BMDPixelFormat pixelFormat) {
+  switch (pixelFormat) {
+    case bmdFormat8BitBGRA:
+    case bmdFormat8BitARGB:
+      return 0xFF;
+    case bmdFormat10BitRGB:
+      return 0x3FF;
+    case bmdFormat12BitRGBLE:
+      return 0xFFF;
+    default:
+      return 0;
+  }
+}
+
+int fill_pixel_rect(void* destData,
+                    BMDPixelFormat pixelFormat,
+                    uint16_t rowBytes,
+                    uint16_t x,
+                    uint16_t y,
+                    uint16_t width,
+                    uint16_t height,
+                    const uint16_t rgb[3]) {
+  if (!destData || !rgb)
+    return -1;
+  if (width == 0 || height == 0)
+    return 0;
+
+  const int group = pixel_group_size(pixelFormat);
+  const int groupFirst = x / group * group;
+  const int groupLast = (x + width + group - 1) / group * group;
+  const int count = groupLast - groupFirst;
+  // Whole groups covered: nothing around the rectangle to preserve
+  const bool aligned = groupFirst == x && groupLast == x + width;
+
+  TrackedVector<uint16_t, kMemoryPackScratch> span(static_cast<size_t>(count) *
+                                                   3);
+  if (aligned) {
+    for (int i = 0; i < count; i++)
+      std::copy(rgb, rgb + 3, span.data() + i * 3);
+  }
+
+  uint8_t* frame = static_cast<uint8_t*>(destData);
+  for (int row = y; row < y + height; row++) {
+    void* rowData = frame + static_cast<size_t>(row) * rowBytes;
+    if (!aligned) {
+      int err = unpack_pixel_span(rowData, pixelFormat, span.data(),
+                                  groupFirst, count);
+      if (err)
+        return err;
+      for (int px = x; px < x + width; px++)
+        std::copy(rgb, rgb + 3, span.data() + (px - groupFirst) * 3);
+    }
+    int err =
+        pack_pixel_span(rowData, pixelFormat, span.data(), groupFirst, count);
+    if (err)
+      return err;
+  }
+  return 0;
+}
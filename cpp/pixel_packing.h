@@ -22,13 +22,97 @@
  * These functions are focused purely on packing existing image data.
  * Specifically, the YUV packing functions simply pack the data, they do not
  * perform any RGB to YUV conversion
+ *
+ * Source data is interleaved R, G, B samples, one uint16_t each. Formats
+ * without a packer return -8.
  */
 
+// Source statistics gathered in the same pass as packing. Values are the
+// code values actually packed, i.e. after clamping.
+struct PixelStats {
+  uint64_t sum[3];
+  uint64_t clipped[3];     // Samples above the format's largest code value
+  uint64_t clippedPixels;  // Pixels with at least one clipped sample
+  uint16_t min[3];
+  uint16_t max[3];
+  double lightSum;  // Sum over pixels of the nits of max(R, G, B)
+};
+
+// Prepares @p stats for accumulation (min at the largest value)
+void pixel_stats_reset(PixelStats* stats);
+void pixel_stats_merge(PixelStats* into, const PixelStats& from);
+
+// Fills @p table (pixel_max_code() + 1 entries) with the SMPTE ST 2084 light
+// level in nits of each full-range code value; returns the entry count
+int pq_nits_table(BMDPixelFormat pixelFormat, float* table);
+
+// With @p stats, also accumulates the source statistics of the packed rows
+// into it (reset it first); @p nitsLut (from pq_nits_table) adds the light
+// level sum.
 int pack_pixel_format(void* destData,
                       BMDPixelFormat pixelFormat,
                       const uint16_t* srcData,
                       uint16_t width,
                       uint16_t height,
-                      uint16_t rowBytes);
+                      uint16_t rowBytes,
+                      PixelStats* stats = nullptr,
+                      const float* nitsLut = nullptr);
+
+// Packs only rows [firstRow, lastRow) so a frame can be split across threads.
+// Does not log; pack_pixel_format() reports once per frame.
+int pack_pixel_format_rows(void* destData,
+                           BMDPixelFormat pixelFormat,
+                           const uint16_t* srcData,
+                           uint16_t width,
+                           uint16_t height,
+                           uint16_t rowBytes,
+                           uint16_t firstRow,
+                           uint16_t lastRow,
+                           PixelStats* stats = nullptr,
+                           const float* nitsLut = nullptr);
+
+// Pixels per packing group: spans passed to the span functions below must
+// start and end on a group boundary (8 for R12L, 1 otherwise).
+int pixel_group_size(BMDPixelFormat pixelFormat);
+
+// Decodes @p count pixels of one packed row, starting at @p firstPixel, into
+// interleaved RGB code values. Returns -1 for a misaligned span, -8 for an
+// unsupported format.
+int unpack_pixel_span(const void* rowData,
+                      BMDPixelFormat pixelFormat,
+                      uint16_t* destRGB,
+                      uint16_t firstPixel,
+                      uint16_t count);
+
+// Decodes the @p count pixels of one packed row at positions @p xs (any
+// order) into interleaved RGB code values; -8 for an unsupported format.
+int unpack_pixel_samples(const void* rowData,
+                         BMDPixelFormat pixelFormat,
+                         const int* xs,
+                         int count,
+                         uint16_t* destRGB);
+
+// Inverse of unpack_pixel_span(): re-encodes only the given pixels of a row,
+// leaving the rest of the packed row untouched.
+int pack_pixel_span(void* rowData,
+                    BMDPixelFormat pixelFormat,
+                    const uint16_t* srcRGB,
+                    uint16_t firstPixel,
+                    uint16_t count);
+
+// Largest code value a packer keeps (255, 1023 or 4095); 0 if unsupported
+int pixel_max_code(BMDPixelFormat pixelFormat);
+
+// Sets every pixel in a rectangle of a packed frame to one RGB value. Pixel
+// groups the rectangle only partly covers are decoded and re-encoded, so the
+// pixels around it keep their values. The rectangle must lie in the frame.
+int fill_pixel_rect(void* destData,
+                    BMDPixelFormat pixelFormat,
+                    uint16_t rowBytes,
+                    uint16_t x,
+                    uint16_t y,
+                    uint16_t width,
+                    uint16_t height,
+                    const uint16_t rgb[3]);
 
 #endif  // PIXEL_PACKING_H
\ No newline at end of file
@@ -0,0 +1,96 @@
+#include "thread_policy.h"
+
+#include <pthread.h>
+#include <sched.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+
+#ifdef __APPLE__
+#include <mach/mach.h>
+#include <mach/thread_policy.h>
+#endif
+
+int32_t pin_current_thread(int core) {
+  if (core < 0)
+    return kThreadPinNone;
+
+#if defined(__linux__)
+  cpu_set_t cpus;
+  CPU_ZERO(&cpus);
+  CPU_SET(core, &cpus);
+  int err = pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+  if (err != 0) {
+    std::cerr << "[ThreadPolicy] Could not pin thread to core " << core << ": "
+              << std::strerror(err) << std::endl;
+    return kThreadPinFailed;
+  }
+  return kThreadPinHard;
+#elif defined(__APPLE__)
+  // Threads sharing a non-zero tag are kept on the same L2; a distinct tag
+  // per core is the closest macOS gets to pinning
+  thread_affinity_policy_data_t policy = {core + 1};
+  kern_return_t kr = thread_policy_set(
+      pthread_mach_thread_np(pthread_self()), THREAD_AFFINITY_POLICY,
+      reinterpret_cast<thread_policy_t>(&policy), THREAD_AFFINITY_POLICY_COUNT);
+  if (kr != KERN_SUCCESS) {
+    // Apple silicon does not implement affinity tags at all
+    std::cerr << "[ThreadPolicy] Affinity hints unsupported on this host"
+              << std::endl;
+    return kThreadPinFailed;
+  }
+  return kThreadPinHint;
+#else
+  return kThreadPinFailed;
+#endif
+}
+
+int apply_current_thread_sched(int32_t policy,
+                               int32_t priority,
+                               int32_t* effectivePolicy,
+                               int32_t* effectivePriority) {
+  int osPolicy;
+  switch (policy) {
+    case kThreadSchedOther:
+      osPolicy = SCHED_OTHER;
+      break;
+    case kThreadSchedFIFO:
+      osPolicy = SCHED_FIFO;
+      break;
+    case kThreadSchedRR:
+      osPolicy = SCHED_RR;
+      break;
+    default:
+      return -1;
+  }
+
+  sched_param param{};
+  if (osPolicy != SCHED_OTHER) {
+    param.sched_priority =
+        std::clamp(priority, sched_get_priority_min(osPolicy),
+                   sched_get_priority_max(osPolicy));
+  }
+
+  int err = pthread_setschedparam(pthread_self(), osPolicy, &param);
+  if (err == 0) {
+    if (effectivePolicy)
+      *effectivePolicy = policy;
+    if (effectivePriority)
+      *effectivePriority = param.sched_priority;
+    return 0;
+  }
+
+  // EPERM without CAP_SYS_NICE / rtprio limits; keep the thread usable
+  std::cerr << "[ThreadPolicy] Real-time policy " << policy << " refused ("
+            << std::strerror(err) << "), falling back to default scheduling"
+            << std::endl;
+  sched_param fallback{};
+  pthread_setschedparam(pthread_self(), SCHED_OTHER, &fallback);
+  if (effectivePolicy)
+    *effectivePolicy = kThreadSchedOther;
+  if (effectivePriority)
+    *effectivePriority = 0;
+  return 1;
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstdint>
+
+/*
+ * Thread placement and real-time scheduling for output and packing threads
+ *
+ * Linux pins with pthread_setaffinity_np. macOS has no hard affinity, so a
+ * THREAD_AFFINITY_POLICY tag is set instead and reported as a hint. Real-time
+ * policies fall back to the default time-sharing policy when the process is
+ * not permitted to use them.
+ */
+
+// Scheduling policies accepted in ThreadPolicyConfig::schedPolicy
+enum ThreadSchedPolicy : int32_t {
+  kThreadSchedOther = 0,  // Default time-sharing
+  kThreadSchedFIFO = 1,   // SCHED_FIFO
+  kThreadSchedRR = 2,     // SCHED_RR
+};
+
+// Outcome of a pin request in ThreadPolicyStatus
+enum ThreadPinResult : int32_t {
+  kThreadPinNone = 0,    // Not requested or not applied
+  kThreadPinHard = 1,    // Thread restricted to the core
+  kThreadPinHint = 2,    // Scheduler hint only (macOS affinity tags)
+  kThreadPinFailed = -1  // Requested but rejected
+};
+
+// Requested placement/scheduling. Negative cores mean "do not pin".
+struct ThreadPolicyConfig {
+  int32_t outputCore;
+  int32_t schedPolicy;
+  int32_t schedPriority;
+  int32_t packWorkers;    // Extra packing threads (0 = pack on caller)
+  int32_t packCoreFirst;  // Worker i is pinned to packCoreFirst + i
+  int32_t lockMemory;     // mlock frame pool buffers
+};
+
+// Policy actually in effect after applying a ThreadPolicyConfig
+struct ThreadPolicyStatus {
+  int32_t outputCore;
+  int32_t outputPinned;  // ThreadPinResult
+  int32_t schedPolicy;   // ThreadSchedPolicy actually in effect
+  int32_t schedPriority;
+  int32_t schedFallback;  // Non-zero if the requested policy was refused
+  int32_t packWorkers;
+  int32_t packWorkersPinned;  // Workers with kThreadPinHard or kThreadPinHint
+  int32_t memoryLocked;       // Non-zero if every pool buffer is mlocked
+  int64_t lockedBytes;
+};
+
+// Pins the calling thread to a core; returns a ThreadPinResult
+int32_t pin_current_thread(int core);
+
+// Applies a scheduling policy to the calling thread, falling back to
+// kThreadSchedOther if the request is refused. Returns 0 if the requested
+// policy was applied, 1 on fallback, -1 on invalid arguments.
+int apply_current_thread_sched(int32_t policy,
+                               int32_t priority,
+                               int32_t* effectivePolicy,
+                               int32_t* effectivePriority);
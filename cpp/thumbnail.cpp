@@ -0,0 +1,213 @@
+#include "thumbnail.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+#include "pixel_packing.h"
+
+static int64_t steadyNowNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+// IEC 61966-2-1 encoding of relative linear light in [0, 1]
+static uint8_t srgb_encode(double linear) {
+  linear = std::clamp(linear, 0.0, 1.0);
+  const double v = linear <= 0.0031308
+                       ? 12.92 * linear
+                       : 1.055 * std::pow(linear, 1.0 / 2.4) - 0.055;
+  return static_cast<uint8_t>(std::lround(v * 255.0));
+}
+
+int render_thumbnail(const void* frameData,
+                     BMDPixelFormat pixelFormat,
+                     int width,
+                     int height,
+                     int32_t rowBytes,
+                     const uint8_t* table,
+                     int samples,
+                     uint8_t* dest,
+                     int destWidth,
+                     int destHeight,
+                     uint16_t* scratch,
+                     uint32_t* sums,
+                     int* columns) {
+  if (!pixel_max_code(pixelFormat))
+    return -8;
+  if (!frameData || !table || !dest || !scratch || !sums || !columns ||
+      width <= 0 || height <= 0 || destWidth <= 0 || destHeight <= 0 ||
+      samples <= 0)
+    return -1;
+
+  const uint8_t* bytes = static_cast<const uint8_t*>(frameData);
+  const uint32_t count = static_cast<uint32_t>(samples * samples);
+
+  // Sample columns are the same for every row
+  for (int tx = 0; tx < destWidth; tx++) {
+    const int x0 =
+        static_cast<int>(static_cast<int64_t>(tx) * width / destWidth);
+    const int x1 =
+        static_cast<int>(static_cast<int64_t>(tx + 1) * width / destWidth);
+    const int xSpan = std::max(x1 - x0, 1);
+    for (int sx = 0; sx < samples; sx++)
+      columns[tx * samples + sx] = x0 + (2 * sx + 1) * xSpan / (2 * samples);
+  }
+
+  for (int ty = 0; ty < destHeight; ty++) {
+    const int y0 = static_cast<int>(static_cast<int64_t>(ty) * height /
+                                    destHeight);
+    const int y1 = static_cast<int>(static_cast<int64_t>(ty + 1) * height /
+                                    destHeight);
+    const int ySpan = std::max(y1 - y0, 1);
+    std::fill(sums, sums + destWidth * 3, 0u);
+
+    // Sample the centres of a samples x samples grid over each box, one
+    // source row at a time so reads move forward through memory
+    for (int sy = 0; sy < samples; sy++) {
+      const int y = y0 + (2 * sy + 1) * ySpan / (2 * samples);
+      unpack_pixel_samples(bytes + static_cast<size_t>(y) * rowBytes,
+                           pixelFormat, columns, destWidth * samples, scratch);
+      const uint16_t* rgb = scratch;
+      for (int tx = 0; tx < destWidth; tx++) {
+        uint32_t* sum = sums + tx * 3;
+        for (int sx = 0; sx < samples; sx++, rgb += 3) {
+          sum[0] += table[rgb[0]];
+          sum[1] += table[rgb[1]];
+          sum[2] += table[rgb[2]];
+        }
+      }
+    }
+
+    uint8_t* out = dest + static_cast<size_t>(ty) * destWidth * 3;
+    for (int i = 0; i < destWidth * 3; i++)
+      out[i] = static_cast<uint8_t>((sums[i] + count / 2) / count);
+  }
+  return 0;
+}
+
+FrameThumbnail::FrameThumbnail()
+    : m_config{320, 0, 2, 250, 203.0f},
+      m_info{},
+      m_tableFormat(bmdFormatUnspecified),
+      m_tablePq(false),
+      m_tableReferenceNits(0.0f) {}
+
+int FrameThumbnail::configure(const ThumbnailConfig& config) {
+  if (config.width < 0 || config.width > kThumbnailMaxWidth ||
+      config.height < 0 || config.height > kThumbnailMaxHeight ||
+      config.samples < 1 || config.samples > kThumbnailMaxSamples ||
+      config.intervalMs < 0 || !(config.referenceNits > 0.0f))
+    return -1;
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_config = config;
+  // Keep the sequence increasing so consumers never see a number reused
+  const int64_t sequence = m_info.sequence;
+  m_info = {};
+  m_info.sequence = sequence;
+  m_tableFormat = bmdFormatUnspecified;
+  if (!config.width) {
+    // Disabled: give the memory back
+    TrackedVector<uint8_t, kMemoryCaches>().swap(m_pixels);
+    TrackedVector<uint8_t, kMemoryCaches>().swap(m_table);
+  }
+  return 0;
+}
+
+ThumbnailConfig FrameThumbnail::config() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_config;
+}
+
+int FrameThumbnail::buildTableLocked(BMDPixelFormat pixelFormat, bool pq) {
+  if (m_tableFormat == pixelFormat && m_tablePq == pq &&
+      m_tableReferenceNits == m_config.referenceNits)
+    return 0;
+
+  const int maxCode = pixel_max_code(pixelFormat);
+  if (!maxCode)
+    return -8;
+  m_table.resize(maxCode + 1);
+  if (pq) {
+    std::vector<float> nits(maxCode + 1);
+    pq_nits_table(pixelFormat, nits.data());
+    for (int code = 0; code <= maxCode; code++)
+      m_table[code] = srgb_encode(nits[code] / m_config.referenceNits);
+  } else {
+    // SDR code values are already display-encoded
+    for (int code = 0; code <= maxCode; code++)
+      m_table[code] =
+          static_cast<uint8_t>((code * 255 + maxCode / 2) / maxCode);
+  }
+  m_tableFormat = pixelFormat;
+  m_tablePq = pq;
+  m_tableReferenceNits = m_config.referenceNits;
+  return 0;
+}
+
+void FrameThumbnail::capture(const void* frameData,
+                             BMDPixelFormat pixelFormat,
+                             int width,
+                             int height,
+                             int32_t rowBytes,
+                             bool pq,
+                             bool force) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (!m_config.width || !frameData || width <= 0 || height <= 0)
+    return;
+
+  const int64_t startNs = steadyNowNs();
+  if (!force && m_info.valid &&
+      startNs - m_info.capturedNs <
+          static_cast<int64_t>(m_config.intervalMs) * 1000000)
+    return;
+  if (buildTableLocked(pixelFormat, pq))
+    return;
+
+  const int destWidth = std::min<int>(m_config.width, width);
+  const int destHeight =
+      m_config.height
+          ? std::min<int>(m_config.height, height)
+          : std::max(1, static_cast<int>(std::lround(
+                            static_cast<double>(destWidth) * height / width)));
+  m_pixels.resize(static_cast<size_t>(destWidth) * destHeight * 3);
+  m_scratch.resize(static_cast<size_t>(destWidth) * m_config.samples * 3);
+  m_sums.resize(static_cast<size_t>(destWidth) * 3);
+  m_columns.resize(static_cast<size_t>(destWidth) * m_config.samples);
+  if (render_thumbnail(frameData, pixelFormat, width, height, rowBytes,
+                       m_table.data(), m_config.samples, m_pixels.data(),
+                       destWidth, destHeight, m_scratch.data(), m_sums.data(),
+                       m_columns.data()))
+    return;
+
+  const int64_t endNs = steadyNowNs();
+  m_info.valid = 1;
+  m_info.width = destWidth;
+  m_info.height = destHeight;
+  m_info.sourceWidth = width;
+  m_info.sourceHeight = height;
+  m_info.pq = pq;
+  m_info.sequence++;
+  m_info.capturedNs = endNs;
+  m_info.renderNs = endNs - startNs;
+}
+
+int FrameThumbnail::copy(uint8_t* dest, int capacity, ThumbnailInfo* info)
+    const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (info)
+    *info = m_info;
+  if (!m_info.valid)
+    return 0;
+  const int size = m_info.width * m_info.height * 3;
+  if (!dest)
+    return size;
+  if (capacity < size)
+    return -1;
+  std::memcpy(dest, m_pixels.data(), size);
+  return size;
+}
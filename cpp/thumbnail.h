@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+
+#include "DeckLinkAPI.h"
+#include "memory_stats.h"
+
+/*
+ * Monitoring thumbnails of the output
+ *
+ * A small 8-bit sRGB preview is decimated from each packed frame as it leaves
+ * the library, after overlays, so it shows what goes on the wire. Every
+ * thumbnail pixel is a box filter over a samples x samples grid of the
+ * source pixels it covers. Only those samples are decoded: at the default
+ * two per axis, a 320x180 preview of a 4K frame reads under 3% of its
+ * pixels. Streamed output is captured at most every intervalMs. Code values
+ * map through a per-format table: SDR signals are shown as-is, PQ is
+ * converted to light and scaled so referenceNits is sRGB white.
+ */
+
+constexpr int kThumbnailMaxWidth = 1920;
+constexpr int kThumbnailMaxHeight = 1080;
+constexpr int kThumbnailMaxSamples = 8;
+
+struct ThumbnailConfig {
+  int32_t width;       // 0 disables thumbnails
+  int32_t height;      // 0 keeps the source aspect ratio
+  int32_t samples;     // Samples per thumbnail pixel along each axis (1-8)
+  int32_t intervalMs;  // Minimum time between captures of streamed output
+  float referenceNits;  // PQ light level shown as sRGB white
+};
+
+struct ThumbnailInfo {
+  int32_t valid;
+  int32_t width;
+  int32_t height;
+  int32_t sourceWidth;
+  int32_t sourceHeight;
+  int32_t pq;
+  int64_t sequence;   // Increments with every capture
+  int64_t capturedNs;  // steady_clock time of the capture
+  int64_t renderNs;    // Time the capture took
+};
+
+class FrameThumbnail {
+ public:
+  FrameThumbnail();
+
+  // Applies @p config (and clears the current thumbnail); -1 if invalid
+  int configure(const ThumbnailConfig& config);
+  ThumbnailConfig config() const;
+
+  // Renders a thumbnail of a packed frame if enabled and, unless @p force,
+  // intervalMs has passed since the last one. Safe from any output thread.
+  void capture(const void* frameData,
+               BMDPixelFormat pixelFormat,
+               int width,
+               int height,
+               int32_t rowBytes,
+               bool pq,
+               bool force);
+
+  // Copies the latest thumbnail as interleaved RGB8 into @p dest; returns
+  // the bytes copied (the size needed if @p dest is null), 0 if there is no
+  // thumbnail yet, -1 if @p capacity is too small
+  int copy(uint8_t* dest, int capacity, ThumbnailInfo* info) const;
+
+ private:
+  int buildTableLocked(BMDPixelFormat pixelFormat, bool pq);
+
+  mutable std::mutex m_mutex;
+  ThumbnailConfig m_config;
+  ThumbnailInfo m_info;
+  TrackedVector<uint8_t, kMemoryCaches> m_pixels;
+  TrackedVector<uint8_t, kMemoryCaches> m_table;  // Code value to sRGB8
+  BMDPixelFormat m_tableFormat;
+  bool m_tablePq;
+  float m_tableReferenceNits;
+  TrackedVector<uint16_t, kMemoryCaches> m_scratch;
+  TrackedVector<uint32_t, kMemoryCaches> m_sums;
+  TrackedVector<int, kMemoryCaches> m_columns;
+};
+
+// Box-filters @p destWidth x @p destHeight RGB8 pixels out of a packed frame,
+// decoding samples x samples source pixels per destination pixel and mapping
+// code values through @p table (pixel_max_code() + 1 entries). @p columns
+// holds destWidth * samples positions, @p scratch three values per position
+// and @p sums 3 * destWidth. Returns -8 for unsupported formats.
+int render_thumbnail(const void* frameData,
+                     BMDPixelFormat pixelFormat,
+                     int width,
+                     int height,
+                     int32_t rowBytes,
+                     const uint8_t* table,
+                     int samples,
+                     uint8_t* dest,
+                     int destWidth,
+                     int destHeight,
+                     uint16_t* scratch,
+                     uint32_t* sums,
+                     int* columns);
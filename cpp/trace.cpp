@@ -0,0 +1,205 @@
+#include "trace.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <mutex>
+
+#if defined(__APPLE__)
+#include <pthread.h>
+#elif defined(__linux__)
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "memory_stats.h"
+
+namespace {
+
+// Spans of one thread. Only the owner writes spans and head (the count of
+// spans ever written); everything else is guarded by g_registryMutex.
+struct TraceRing {
+  std::atomic<int64_t> head{0};
+  int64_t tail = 0;  // Next span to collect
+  bool owned = false;
+  TraceSpan spans[kTraceRingSpans];
+};
+
+std::atomic<bool> g_enabled{false};
+std::mutex g_registryMutex;
+// Rings are kept for the life of the process and reused once their thread
+// has exited; g_threads lists every thread that has ever had one
+TrackedVector<TraceRing*, kMemoryTrace> g_rings;
+TrackedVector<TraceThread, kMemoryTrace> g_threads;
+int64_t g_collected = 0;
+int64_t g_lost = 0;
+
+thread_local int64_t t_frameId = 0;
+thread_local const char* t_name = nullptr;
+
+int64_t osThreadId() {
+#if defined(__APPLE__)
+  uint64_t id = 0;
+  pthread_threadid_np(nullptr, &id);
+  return static_cast<int64_t>(id);
+#elif defined(__linux__)
+  return static_cast<int64_t>(syscall(SYS_gettid));
+#else
+  return 0;
+#endif
+}
+
+// The calling thread's ring, handed back for reuse when the thread exits
+struct RingOwner {
+  TraceRing* ring = nullptr;
+  int64_t threadId = 0;
+
+  ~RingOwner() {
+    if (!ring)
+      return;
+    std::lock_guard<std::mutex> lock(g_registryMutex);
+    ring->owned = false;
+  }
+};
+
+thread_local RingOwner t_ring;
+
+TraceRing* acquireRing() {
+  std::lock_guard<std::mutex> lock(g_registryMutex);
+  auto it = std::find_if(g_rings.begin(), g_rings.end(),
+                         [](const TraceRing* r) { return !r->owned; });
+  TraceRing* ring = nullptr;
+  if (it != g_rings.end()) {
+    ring = *it;
+  } else {
+    ring = new TraceRing();
+    memory_track_alloc(kMemoryTrace, sizeof(TraceRing));
+    g_rings.push_back(ring);
+  }
+  ring->owned = true;
+
+  TraceThread thread = {};
+  thread.threadId = osThreadId();
+  if (t_name)
+    std::strncpy(thread.name, t_name, kTraceThreadNameSize - 1);
+  g_threads.push_back(thread);
+  t_ring.threadId = thread.threadId;
+  return ring;
+}
+
+}  // namespace
+
+void trace_set_enabled(bool enabled) {
+  std::lock_guard<std::mutex> lock(g_registryMutex);
+  if (enabled && !g_enabled.load(std::memory_order_relaxed)) {
+    // A new trace starts without the spans left over from the last one
+    for (TraceRing* ring : g_rings)
+      ring->tail = ring->head.load(std::memory_order_acquire);
+    g_collected = 0;
+    g_lost = 0;
+  }
+  g_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool trace_enabled() {
+  return g_enabled.load(std::memory_order_relaxed);
+}
+
+int64_t trace_now_ns() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+void trace_set_frame(int64_t frameId) {
+  t_frameId = frameId;
+}
+
+int64_t trace_current_frame() {
+  return t_frameId;
+}
+
+void trace_name_thread(const char* name) {
+  t_name = name;
+}
+
+void trace_record(TraceStage stage,
+                  int64_t startNs,
+                  int64_t endNs,
+                  int64_t frameId) {
+  if (!g_enabled.load(std::memory_order_relaxed))
+    return;
+  TraceRing* ring = t_ring.ring;
+  if (!ring)
+    ring = t_ring.ring = acquireRing();
+
+  const int64_t head = ring->head.load(std::memory_order_relaxed);
+  ring->spans[head & (kTraceRingSpans - 1)] = {startNs, endNs, frameId,
+                                               t_ring.threadId, stage, 0};
+  ring->head.store(head + 1, std::memory_order_release);
+}
+
+/**
+ * @brief Moves recorded spans out of the per-thread rings
+ *
+ * Spans the owner overwrote before they were copied, including any it
+ * overwrote while they were being copied, are dropped and counted as lost.
+ */
+int trace_collect(TraceSpan* out, int maxCount) {
+  if (!out || maxCount <= 0)
+    return 0;
+  std::lock_guard<std::mutex> lock(g_registryMutex);
+  int count = 0;
+  for (TraceRing* ring : g_rings) {
+    if (count == maxCount)
+      break;
+    const int64_t head = ring->head.load(std::memory_order_acquire);
+    if (head - ring->tail > kTraceRingSpans) {
+      g_lost += head - kTraceRingSpans - ring->tail;
+      ring->tail = head - kTraceRingSpans;
+    }
+    const int take = static_cast<int>(
+        std::min<int64_t>(head - ring->tail, maxCount - count));
+    for (int i = 0; i < take; i++)
+      out[count + i] = ring->spans[(ring->tail + i) & (kTraceRingSpans - 1)];
+
+    // The slot of index i is rewritten by the span of index
+    // i + kTraceRingSpans, which may be in progress at the current head
+    std::atomic_thread_fence(std::memory_order_acquire);
+    const int64_t intact = ring->head.load(std::memory_order_relaxed) + 1 -
+                           kTraceRingSpans;
+    const int torn =
+        static_cast<int>(std::clamp<int64_t>(intact - ring->tail, 0, take));
+    if (torn) {
+      std::memmove(out + count, out + count + torn,
+                   sizeof(TraceSpan) * (take - torn));
+      g_lost += torn;
+    }
+    ring->tail += take;
+    count += take - torn;
+  }
+  g_collected += count;
+  return count;
+}
+
+int trace_threads(TraceThread* out, int maxCount) {
+  if (!out || maxCount <= 0)
+    return 0;
+  std::lock_guard<std::mutex> lock(g_registryMutex);
+  const int count = std::min(static_cast<int>(g_threads.size()), maxCount);
+  std::copy(g_threads.begin(), g_threads.begin() + count, out);
+  return count;
+}
+
+TraceStats trace_stats() {
+  std::lock_guard<std::mutex> lock(g_registryMutex);
+  TraceStats stats = {};
+  stats.enabled = g_enabled.load(std::memory_order_relaxed) ? 1 : 0;
+  stats.threads = static_cast<int32_t>(g_threads.size());
+  for (const TraceRing* ring : g_rings)
+    stats.recorded += ring->head.load(std::memory_order_relaxed);
+  stats.collected = g_collected;
+  stats.lost = g_lost;
+  return stats;
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cstdint>
+
+/*
+ * Opt-in span tracing of the frame path
+ *
+ * Each thread that records gets a ring of kTraceRingSpans spans of its own on
+ * its first span, so recording takes no lock and does not allocate after
+ * that; while tracing is off a span costs one relaxed atomic load. The rings
+ * are drained by trace_collect(). A thread that records a whole ring ahead of
+ * the reader overwrites its oldest spans, and they are counted as lost.
+ *
+ * A span carries the frame id last set on its thread with trace_set_frame().
+ * Work handed to another thread (the pipeline stages, the scheduler's
+ * dispatch and completion) carries the id along, so every span of a frame
+ * shares it from the request to the completion. Times are steady_clock
+ * nanoseconds and threads are identified by their OS thread id, so spans can
+ * be merged with ones recorded by the caller on the same threads.
+ */
+
+// Per thread; a power of two
+constexpr int kTraceRingSpans = 8192;
+constexpr int kTraceThreadNameSize = 32;
+
+enum TraceStage : int32_t {
+  kTraceCopy = 0,     // Caller frame data copied into the library
+  kTraceWait,         // Caller held up waiting for a free pipeline stage
+  kTracePack,         // Packing, with placement and frame statistics
+  kTraceCacheLoad,    // Cached packed frame decompressed into a buffer
+  kTraceOverlay,      // Overlay compositing
+  kTraceMetadata,     // HDR metadata attached to the frame
+  kTraceDisplay,      // DisplayVideoFrameSync, returning once on screen
+  kTraceQueue,        // Scheduled frame waiting for its dispatch
+  kTraceDispatch,     // ScheduleVideoFrame handing a frame to the SDK
+  kTraceOnDevice,     // Dispatched frame until its completion callback
+  kTraceStageCount
+};
+
+struct TraceSpan {
+  int64_t startNs;
+  int64_t endNs;
+  int64_t frameId;   // 0 if not part of a frame
+  int64_t threadId;  // OS thread id
+  int32_t stage;     // TraceStage
+  int32_t reserved;
+};
+
+struct TraceThread {
+  int64_t threadId;
+  // Set by the threads the library starts, empty for the caller's threads
+  char name[kTraceThreadNameSize];
+};
+
+struct TraceStats {
+  int32_t enabled;
+  int32_t threads;  // Threads that have recorded a span
+  int64_t recorded;  // Since the process started
+  int64_t collected;
+  int64_t lost;  // Overwritten before they were collected
+};
+
+void trace_set_enabled(bool enabled);
+bool trace_enabled();
+int64_t trace_now_ns();
+
+// Frame id of the calling thread's spans from now on (0 for none)
+void trace_set_frame(int64_t frameId);
+int64_t trace_current_frame();
+// Names the calling thread in traces; @p name must outlive the thread
+void trace_name_thread(const char* name);
+
+// Records a finished span on the calling thread
+void trace_record(TraceStage stage,
+                  int64_t startNs,
+                  int64_t endNs,
+                  int64_t frameId);
+
+// Moves up to maxCount spans out of the rings, each thread's in order;
+// returns the number copied
+int trace_collect(TraceSpan* out, int maxCount);
+// Copies up to maxCount threads that have recorded; returns the number
+int trace_threads(TraceThread* out, int maxCount);
+TraceStats trace_stats();
+
+// Records its own lifetime as a span of the thread's current frame
+class TraceScope {
+ public:
+  explicit TraceScope(TraceStage stage)
+      : m_stage(stage), m_startNs(trace_enabled() ? trace_now_ns() : 0) {}
+  ~TraceScope() {
+    if (m_startNs)
+      trace_record(m_stage, m_startNs, trace_now_ns(), trace_current_frame());
+  }
+
+  TraceScope(const TraceScope&) = delete;
+  TraceScope& operator=(const TraceScope&) = delete;
+
+ private:
+  TraceStage m_stage;
+  int64_t m_startNs;  // 0 if tracing was off
+};
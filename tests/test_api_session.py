@@ -0,0 +1,99 @@
+"""
+Tests for API session recording and replay.
+"""
+
+import threading
+from http.server import BaseHTTPRequestHandler, ThreadingHTTPServer
+
+import pytest
+
+from bmd_sg.api.session import (
+    RecordedRequest,
+    SessionRecorder,
+    load_session,
+    replay_session,
+)
+
+
+class _EchoHandler(BaseHTTPRequestHandler):
+    """Answers every request with 200, except /missing with 404."""
+
+    def _reply(self) -> None:
+        length = int(self.headers.get("Content-Length", 0))
+        self.rfile.read(length)
+        self.send_response(404 if self.path == "/missing" else 200)
+        self.send_header("Content-Length", "0")
+        self.end_headers()
+
+    do_GET = do_POST = do_PATCH = do_DELETE = _reply
+
+    def log_message(self, format, *args) -> None:
+        pass
+
+
+@pytest.fixture
+def echo_server():
+    server = ThreadingHTTPServer(("127.0.0.1", 0), _EchoHandler)
+    thread = threading.Thread(target=server.serve_forever, daemon=True)
+    thread.start()
+    yield f"http://127.0.0.1:{server.server_address[1]}"
+    server.shutdown()
+    server.server_close()
+
+
+def _entry(t: float, method: str, path: str, status: int = 200) -> RecordedRequest:
+    return RecordedRequest(
+        t=t,
+        method=method,
+        path=path,
+        route=path,
+        query="",
+        body={"colors": [[1, 2, 3]]} if method == "POST" else None,
+        status=status,
+        duration_ms=1.0,
+    )
+
+
+class TestApiSession:
+    """Test session files and replay reports."""
+
+    def test_record_and_load_round_trip(self, tmp_path):
+        """Recorded entries load back unchanged."""
+        path = tmp_path / "session.jsonl"
+        recorder = SessionRecorder()
+        recorder.start(path)
+        entries = [_entry(0.0, "POST", "/update_color"), _entry(0.1, "GET", "/status")]
+        for entry in entries:
+            recorder.record(entry)
+        recorder.stop()
+
+        assert not recorder.active
+        assert load_session(path) == entries
+
+    def test_load_rejects_other_files(self, tmp_path):
+        """Files without a session header are rejected."""
+        path = tmp_path / "other.jsonl"
+        path.write_text('{"t": 0}\n')
+        with pytest.raises(RuntimeError):
+            load_session(path)
+
+    def test_replay_reports_latency_and_mismatches(self, echo_server):
+        """Replay counts requests per route and flags status changes."""
+        session = [
+            _entry(0.0, "POST", "/update_color"),
+            _entry(0.01, "POST", "/update_color"),
+            _entry(0.02, "GET", "/missing"),
+        ]
+        report = replay_session(session, echo_server, speed=None)
+
+        assert report.requests == 3
+        assert report.errors == 0
+        assert report.status_mismatches == 1
+        assert report.latency.count == 3
+        assert report.routes["POST /update_color"].count == 2
+        assert report.throughput > 0
+
+    def test_replay_rejects_non_positive_speed(self):
+        """Speed must be positive."""
+        with pytest.raises(ValueError):
+            replay_session([], "http://127.0.0.1:1", speed=0)
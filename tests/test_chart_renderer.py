@@ -0,0 +1,104 @@
+"""
+Tests for tiled chart rendering.
+
+Tiled rendering must give the same pixels as rendering the whole canvas at
+once. Small odd tile sizes put tile edges inside patches, checkerboards and
+text, where a phase or clipping error would show.
+"""
+
+import numpy as np
+import pytest
+
+from bmd_sg.charts.color_types import (
+    AnnotationLayout,
+    AnnotationStripe,
+    Canvas,
+    ChartLayout,
+    ColorSpace,
+    ColorValue,
+    Patch,
+    PatternType,
+    TransferFunction,
+)
+from bmd_sg.charts.renderer import (
+    _render_chart_content,
+    _surround_code_values,
+    render_chart_tiled,
+)
+
+
+@pytest.fixture
+def labelled_layout() -> ChartLayout:
+    """A small chart with labels, checkerboards and annotation stripes."""
+    layout = ChartLayout(
+        name="Tiles",
+        canvas=Canvas(width=211, height=121, surround=(0.1, 0.2, 0.3)),
+        annotations=AnnotationLayout(
+            top_stripe=AnnotationStripe(0.0, 0.12),
+            bottom_stripe=AnnotationStripe(0.88, 1.0),
+        ),
+    )
+    colors = [(0.9, 0.9, 0.9), (0.05, 0.1, 0.6), (0.7, 0.2, 0.1), (0.3, 0.8, 0.4)]
+    patterns = [
+        PatternType.SOLID,
+        PatternType.CHECKERBOARD_50,
+        PatternType.SOLID,
+        PatternType.CHECKERBOARD_25,
+    ]
+    for i, (rgb, pattern) in enumerate(zip(colors, patterns, strict=True)):
+        layout.add_patch(
+            Patch(
+                name=f"P{i}",
+                x_pct=0.03 + 0.24 * i,
+                y_pct=0.2,
+                width_pct=0.21,
+                height_pct=0.6,
+                color=ColorValue.from_rgb(*rgb),
+                pattern=pattern,
+                label_text=f"P{i}",
+            )
+        )
+    return layout
+
+
+class TestRenderChartTiled:
+    """Tests for tile-by-tile chart rendering."""
+
+    @pytest.mark.parametrize("tile_size", [7, 33])
+    def test_matches_full_render_embedded(
+        self, labelled_layout: ChartLayout, tile_size: int
+    ) -> None:
+        """Test that tiles reproduce a full render embedded in the output."""
+        canvas = labelled_layout.canvas
+        assert canvas is not None
+        options = {
+            "bit_depth": 10,
+            "target_space": ColorSpace.REC709,
+            "transfer_function": TransferFunction.GAMMA_22,
+            "reference_white_Y": 100.0,
+            "include_labels": True,
+        }
+
+        expected = np.empty((150, 260, 3), dtype=np.uint16)
+        expected[:] = _surround_code_values(canvas, 10)
+        expected[: canvas.height, : canvas.width] = _render_chart_content(
+            labelled_layout, canvas.width, canvas.height, **options
+        )
+
+        tiled = render_chart_tiled(
+            labelled_layout,
+            output_width=260,
+            output_height=150,
+            tile_size=tile_size,
+            workers=3,
+            **options,
+        )
+
+        np.testing.assert_array_equal(tiled, expected)
+
+    def test_rejects_output_smaller_than_canvas(
+        self, labelled_layout: ChartLayout
+    ) -> None:
+        """Test that an output smaller than the canvas is refused."""
+        with pytest.raises(ValueError, match="smaller than"):
+            render_chart_tiled(labelled_layout, output_width=100, tile_size=7)
@@ -0,0 +1,190 @@
+"""
+Tests for live chart patch updates and chart file hot reload.
+
+A scene updated a patch at a time must hold the same frame a full render of
+the updated layout gives, and only the changed rectangles may be sent to the
+device. The device side runs against the mock DeckLink device.
+"""
+
+import os
+from collections.abc import Generator
+from pathlib import Path
+
+import numpy as np
+import pytest
+
+from bmd_sg.charts.color_types import ColorValue, PatternType
+from bmd_sg.charts.loaders import load_chart
+from bmd_sg.charts.renderer import render_chart
+from bmd_sg.charts.scene import ChartFileWatcher, ChartScene
+from bmd_sg.decklink.mock import MockBMDDeckLink, reset_mock_state
+
+CHART_YAML = """
+name: "Scene test"
+colorimetry:
+  color_space: "Rec.709"
+canvas:
+  width: 160
+  height: 90
+  surround: [0.1, 0.1, 0.1]
+annotations:
+  top_stripe: {{y_start: 0.0, y_end: 0.1}}
+patches:
+  - name: "Grey"
+    color: [0.5, 0.5, 0.5]
+    pos: [0.05, 0.2]
+    size: [0.25, 0.6]
+  - name: "Red"
+    color: {red}
+    pos: [0.375, 0.2]
+    size: [0.25, 0.6]
+  - name: "Blue"
+    color: [0.1, 0.1, 0.8]
+    pos: [0.7, 0.2]
+    size: [0.25, 0.6]
+"""
+
+
+def write_chart(path: Path, red: str = "[0.8, 0.1, 0.1]") -> None:
+    """Write the test chart, forcing a new modification time."""
+    path.write_text(CHART_YAML.format(red=red))
+    stat = path.stat()
+    os.utime(path, ns=(stat.st_atime_ns, stat.st_mtime_ns + 1_000_000_000))
+
+
+@pytest.fixture
+def chart_path(tmp_path: Path) -> Path:
+    """A small labelled YAML chart."""
+    path = tmp_path / "chart.yaml"
+    write_chart(path)
+    return path
+
+
+@pytest.fixture
+def scene(chart_path: Path) -> ChartScene:
+    """Scene of the test chart in a larger 10-bit frame."""
+    return ChartScene(
+        load_chart(chart_path),
+        output_width=192,
+        output_height=108,
+        bit_depth=10,
+        include_labels=True,
+    )
+
+
+@pytest.fixture
+def running_device() -> Generator[MockBMDDeckLink]:
+    """Open a mock device with output started."""
+    reset_mock_state()
+    device = MockBMDDeckLink(0)
+    device.start_playback()
+    yield device
+    device.close()
+
+
+def full_render(scene: ChartScene) -> np.ndarray:
+    """Render the scene's current layout from scratch."""
+    return render_chart(
+        scene.layout,
+        output_width=192,
+        output_height=108,
+        bit_depth=10,
+        include_labels=True,
+    )
+
+
+class TestChartScene:
+    """Tests for updating a rendered chart a patch at a time."""
+
+    def test_update_matches_full_render(self, scene: ChartScene) -> None:
+        """Test that a patch update leaves the frame a full render gives."""
+        regions = scene.update_patch(
+            "Red", color=ColorValue.from_rgb(0.2, 0.9, 0.3), pattern=None
+        )
+
+        assert regions
+        assert scene.full_renders == 1
+        assert scene.region_renders == len(regions)
+        np.testing.assert_array_equal(scene.image, full_render(scene))
+
+    def test_update_regions_cover_only_the_patch(self, scene: ChartScene) -> None:
+        """Test that the changed regions stay clear of the other patches."""
+        before = scene.image.copy()
+        regions = scene.update_patch(1, pattern=PatternType.CHECKERBOARD_50)
+
+        changed = np.zeros(before.shape[:2], dtype=bool)
+        for x, y, w, h in regions:
+            changed[y : y + h, x : x + w] = True
+        assert not changed[:, :50].any() and not changed[:, 110:].any()
+        np.testing.assert_array_equal(scene.image[~changed], before[~changed])
+
+    def test_unchanged_update_redraws_nothing(self, scene: ChartScene) -> None:
+        """Test that setting a patch to its current color is a no-op."""
+        color = scene.layout.patches[0].color
+
+        assert scene.update_patch("Grey", color=color) == []
+        assert scene.region_renders == 0
+
+    def test_unknown_patch_rejected(self, scene: ChartScene) -> None:
+        """Test that a missing patch name or index raises ValueError."""
+        with pytest.raises(ValueError, match="Unknown patch"):
+            scene.update_patch("Green", color=ColorValue.from_rgb(0, 1, 0))
+        with pytest.raises(ValueError, match="Unknown patch"):
+            scene.update_patch(3, color=ColorValue.from_rgb(0, 1, 0))
+
+    def test_present_sends_only_changed_regions(
+        self, scene: ChartScene, running_device: MockBMDDeckLink
+    ) -> None:
+        """Test that the device ends up showing the updated frame."""
+        scene.present(running_device, scene.render())
+        regions = scene.update_patch("Blue", color=ColorValue.from_rgb(1, 1, 0))
+        scene.present(running_device, regions)
+
+        calls = running_device.get_method_calls("update_frame_regions")
+        assert [call["regions"] for call in calls] == [regions]
+        np.testing.assert_array_equal(running_device.get_last_frame(), scene.image)
+
+
+class TestChartFileWatcher:
+    """Tests for reloading an edited chart file."""
+
+    def test_reload_applies_only_edited_patch(
+        self, chart_path: Path, scene: ChartScene
+    ) -> None:
+        """Test that an edit re-renders the edited patch, not the chart."""
+        applied: list[list[tuple[int, int, int, int]]] = []
+        watcher = ChartFileWatcher(chart_path, scene, applied.append)
+        write_chart(chart_path, red="[0.3, 0.6, 0.9]")
+
+        regions = watcher.poll()
+
+        assert regions and applied == [regions]
+        assert watcher.reloads == 1
+        assert scene.full_renders == 1
+        np.testing.assert_allclose(
+            scene.layout.patches[1].color.values, [0.3, 0.6, 0.9]
+        )
+        np.testing.assert_array_equal(scene.image, full_render(scene))
+
+    def test_unchanged_file_is_not_reloaded(
+        self, chart_path: Path, scene: ChartScene
+    ) -> None:
+        """Test that polling an untouched file does nothing."""
+        watcher = ChartFileWatcher(chart_path, scene, lambda regions: None)
+
+        assert watcher.poll() is None
+        assert watcher.reloads == 0
+
+    def test_broken_file_keeps_frame(self, chart_path: Path, scene: ChartScene) -> None:
+        """Test that a file that fails to parse leaves the scene as it was."""
+        before = scene.image.copy()
+        watcher = ChartFileWatcher(chart_path, scene, lambda regions: None)
+        chart_path.write_text("patches: [unterminated")
+
+        assert watcher.poll() is None
+        assert watcher.last_error is not None
+        np.testing.assert_array_equal(scene.image, before)
+
+        write_chart(chart_path, red="[0.8, 0.1, 0.2]")
+        assert watcher.poll() is not None
+        assert watcher.last_error is None
@@ -0,0 +1,189 @@
+"""
+Tests for chart sweeps across simulated light sources.
+
+A sweep converts every XYZ patch under every light at once and must give the
+frames ``render_chart`` gives one light at a time. Clips are cached on the
+mock DeckLink device.
+"""
+
+from collections.abc import Generator
+
+import numpy as np
+import pytest
+
+from bmd_sg.charts.color_types import (
+    AnnotationLayout,
+    AnnotationStripe,
+    Canvas,
+    ChartLayout,
+    Colorimetry,
+    ColorValue,
+    Illuminant,
+    LightSource,
+    Patch,
+    PatternType,
+    TransferFunction,
+)
+from bmd_sg.charts.conversion import (
+    light_source_xy,
+    xyz_to_display_rgb,
+    xyz_to_display_rgb_sweep,
+)
+from bmd_sg.charts.renderer import render_chart
+from bmd_sg.charts.sweep import cache_sweep_clip, render_chart_sweep
+from bmd_sg.decklink.mock import MockBMDDeckLink, reset_mock_state
+
+LIGHTS = [
+    LightSource(cct=2800),
+    LightSource(cct=4300),
+    LightSource(illuminant=Illuminant.D50),
+    LightSource(cct=6500),
+]
+
+PATCH_XYZ = np.array(
+    [[95.05, 100.0, 108.9], [41.2, 21.3, 1.9], [18.0, 7.2, 95.0], [20.0, 21.0, 22.0]]
+)
+
+
+@pytest.fixture
+def mixed_layout() -> ChartLayout:
+    """A small chart of XYZ, RGB and checkerboard patches with annotations."""
+    layout = ChartLayout(
+        name="Sweep",
+        canvas=Canvas(width=200, height=100, surround=(0.1, 0.1, 0.1)),
+        colorimetry=Colorimetry(illuminant=Illuminant.D50),
+        annotations=AnnotationLayout(
+            top_stripe=AnnotationStripe(0.0, 0.15),
+            bottom_stripe=AnnotationStripe(0.85, 1.0),
+        ),
+    )
+    colors = [
+        ColorValue.from_xyz(*PATCH_XYZ[1]),
+        ColorValue.from_rgb(0.2, 0.6, 0.3),
+        ColorValue.from_xyz(*PATCH_XYZ[2]),
+        ColorValue.from_xyz(*PATCH_XYZ[3]),
+    ]
+    patterns = [None, None, PatternType.CHECKERBOARD_50, None]
+    for i, (color, pattern) in enumerate(zip(colors, patterns, strict=True)):
+        layout.add_patch(
+            Patch(
+                name=f"P{i}",
+                x_pct=0.02 + 0.245 * i,
+                y_pct=0.25,
+                width_pct=0.22,
+                height_pct=0.5,
+                color=color,
+                pattern=pattern,
+                label_text=f"P{i}",
+            )
+        )
+    return layout
+
+
+@pytest.fixture
+def mock_device() -> Generator[MockBMDDeckLink]:
+    """Open a mock device with default configuration."""
+    reset_mock_state()
+    device = MockBMDDeckLink(0)
+    yield device
+    device.close()
+
+
+class TestXyzToDisplayRgbSweep:
+    """Tests for converting XYZ colors under several lights at once."""
+
+    def test_light_xy_matches_single_conversion(self) -> None:
+        """Test that batched CCTs give each light's own chromaticity."""
+        expected = [light.to_xy() for light in LIGHTS]
+
+        np.testing.assert_allclose(light_source_xy(LIGHTS), expected)
+
+    @pytest.mark.parametrize(
+        "transfer_function", [TransferFunction.SRGB, TransferFunction.GAMMA_22]
+    )
+    def test_matches_per_light_conversion(
+        self, transfer_function: TransferFunction
+    ) -> None:
+        """Test that each light gives what xyz_to_display_rgb gives."""
+        rgb = xyz_to_display_rgb_sweep(
+            PATCH_XYZ,
+            LIGHTS,
+            transfer_function=transfer_function,
+            illuminant=Illuminant.D50,
+        )
+
+        assert rgb.shape == (len(LIGHTS), len(PATCH_XYZ), 3)
+        for n, light in enumerate(LIGHTS):
+            for p, xyz in enumerate(PATCH_XYZ):
+                expected = xyz_to_display_rgb(
+                    ColorValue.from_xyz(*xyz),
+                    transfer_function=transfer_function,
+                    illuminant=Illuminant.D50,
+                    simulation_light_source=light,
+                )
+                np.testing.assert_allclose(rgb[n, p], expected, atol=1e-12)
+
+    def test_warmer_light_shifts_white_to_red(self) -> None:
+        """Test that a lower CCT renders the chart white redder."""
+        rgb = xyz_to_display_rgb_sweep(
+            PATCH_XYZ[:1], [LightSource(cct=2800), LightSource(cct=6500)]
+        )
+
+        warm, neutral = rgb[:, 0]
+        assert warm[0] > warm[2]
+        assert warm[0] - warm[2] > neutral[0] - neutral[2]
+
+
+class TestRenderChartSweep:
+    """Tests for rendering a chart once per light source."""
+
+    @pytest.mark.parametrize(
+        ("output_size", "include_labels"), [(None, False), ((240, 120), True)]
+    )
+    def test_frames_match_render_chart(
+        self,
+        mixed_layout: ChartLayout,
+        output_size: tuple[int, int] | None,
+        include_labels: bool,
+    ) -> None:
+        """Test that every frame is the one render_chart gives for its light."""
+        width, height = output_size if output_size else (None, None)
+        options = {
+            "output_width": width,
+            "output_height": height,
+            "bit_depth": 10,
+            "include_labels": include_labels,
+        }
+
+        frames = list(render_chart_sweep(mixed_layout, LIGHTS, **options))
+
+        assert len(frames) == len(LIGHTS)
+        for frame, light in zip(frames, LIGHTS, strict=True):
+            expected = render_chart(
+                mixed_layout, simulation_light_source=light, **options
+            )
+            np.testing.assert_array_equal(frame, expected)
+
+    def test_no_lights_yields_nothing(self, mixed_layout: ChartLayout) -> None:
+        """Test that an empty sweep renders no frames."""
+        assert list(render_chart_sweep(mixed_layout, [])) == []
+
+
+class TestCacheSweepClip:
+    """Tests for caching a sweep as a clip on the device."""
+
+    def test_frames_cached_under_consecutive_keys(
+        self, mixed_layout: ChartLayout, mock_device: MockBMDDeckLink
+    ) -> None:
+        """Test that each frame is cached in order and plays back unchanged."""
+        frames = list(render_chart_sweep(mixed_layout, LIGHTS, bit_depth=10))
+
+        keys = cache_sweep_clip(mock_device, iter(frames), first_key=40)
+
+        assert keys == [40, 41, 42, 43]
+        calls = mock_device.get_method_calls("cache_frame")
+        assert [call["key"] for call in calls] == keys
+        mock_device.start_playback()
+        for key, frame in zip(keys, frames, strict=True):
+            mock_device.display_cached_frame(key)
+            np.testing.assert_array_equal(mock_device.get_last_frame(), frame)
@@ -0,0 +1,149 @@
+"""
+Tests for the persistent device daemon.
+
+The daemon serves a mock device from a background thread; clients talk to it
+over a Unix socket in a short temporary directory (socket paths are length
+limited).
+"""
+
+import tempfile
+import threading
+import time
+from collections.abc import Generator
+from pathlib import Path
+
+import numpy as np
+import pytest
+
+from bmd_sg.cli.shared import describe_daemon_thread_policy
+from bmd_sg.daemon import DeviceDaemon, connect_daemon
+from bmd_sg.decklink.bmd_decklink import DecklinkSettings, PixelFormatType
+from bmd_sg.decklink.mock import reset_mock_state
+
+
+@pytest.fixture
+def running_daemon(
+    default_settings: DecklinkSettings,
+) -> Generator[DeviceDaemon]:
+    """Serve a mock device on a temporary socket."""
+    reset_mock_state()
+    with tempfile.TemporaryDirectory(dir="/tmp") as tmp:
+        daemon = DeviceDaemon(
+            default_settings,
+            use_mock=True,
+            socket_path=Path(tmp) / "d.sock",
+            connection_timeout=1.0,
+        )
+        daemon.open()
+        thread = threading.Thread(target=daemon.serve_forever, daemon=True)
+        thread.start()
+        yield daemon
+        daemon.stop()
+        thread.join(timeout=5)
+
+
+class TestDeviceDaemon:
+    """Tests for routing output through the daemon."""
+
+    def test_no_daemon_returns_none(self) -> None:
+        """Test that connecting without a listening daemon returns None."""
+        assert connect_daemon("/tmp/no-such-bmd-daemon.sock") is None
+
+    def test_display_reaches_device(
+        self, running_daemon: DeviceDaemon, default_settings: DecklinkSettings
+    ) -> None:
+        """Test that frames sent by a client are displayed unchanged."""
+        client = connect_daemon(running_daemon.socket_path)
+        assert client is not None
+        device = client.configure(default_settings)
+        frame = np.arange(4 * 8 * 3, dtype=np.uint16).reshape(4, 8, 3)
+
+        device.display_frame(frame)
+        device.close()
+
+        shown = running_daemon.decklink.get_last_frame()
+        np.testing.assert_array_equal(shown, frame)
+
+    def test_configure_applies_only_differences(
+        self, running_daemon: DeviceDaemon, default_settings: DecklinkSettings
+    ) -> None:
+        """Test that an unchanged configuration does not reconfigure."""
+        client = connect_daemon(running_daemon.socket_path)
+        assert client is not None
+
+        assert client.configure(default_settings).changed == []
+
+        default_settings.pixel_format = PixelFormatType.FORMAT_10BIT_RGB
+        device = client.configure(default_settings)
+        assert device.changed == ["pixel_format"]
+        assert device.pixel_format == PixelFormatType.FORMAT_10BIT_RGB
+        assert len(running_daemon.decklink.get_method_calls("reconfigure")) == 1
+        client.close()
+
+    def test_display_releases_connection(
+        self, running_daemon: DeviceDaemon, default_settings: DecklinkSettings
+    ) -> None:
+        """Test that a client holding a pattern does not block other clients."""
+        client = connect_daemon(running_daemon.socket_path)
+        assert client is not None
+        device = client.configure(default_settings)
+        device.display_frame(np.zeros((4, 8, 3), dtype=np.uint16))
+
+        # Well inside the daemon's idle timeout, so only a released
+        # connection lets this through
+        other = connect_daemon(running_daemon.socket_path, response_timeout=0.5)
+        assert other is not None
+        assert other.status()["frames_displayed"] == 1
+        other.close()
+
+        device.display_frame(np.ones((4, 8, 3), dtype=np.uint16))
+        assert client.status()["frames_displayed"] == 2
+        device.close()
+
+    def test_status_reports_effective_thread_policy(
+        self, running_daemon: DeviceDaemon
+    ) -> None:
+        """Test that status carries the policy the device reports, unapplied."""
+        client = connect_daemon(running_daemon.socket_path)
+        assert client is not None
+        applied = running_daemon.decklink.get_method_calls("apply_output_thread_policy")
+
+        policy = client.status()["thread_policy"]
+        client.close()
+
+        status = running_daemon.decklink.thread_policy_status
+        assert policy["outputPinned"] == status.outputPinned
+        assert policy["packWorkers"] == status.packWorkers
+        assert not policy["lockRequested"]
+        lines = describe_daemon_thread_policy(policy)
+        assert lines[0].startswith("Output thread: unpinned, OTHER")
+        calls = running_daemon.decklink.get_method_calls("apply_output_thread_policy")
+        assert len(calls) == len(applied) == 1
+
+    def test_idle_connection_is_dropped(self, running_daemon: DeviceDaemon) -> None:
+        """Test that a silent client is disconnected after the timeout."""
+        idle = connect_daemon(running_daemon.socket_path)
+        assert idle is not None
+
+        other = connect_daemon(running_daemon.socket_path, response_timeout=5.0)
+        assert other is not None
+        started = time.monotonic()
+        assert other.status()["ok"]
+        assert time.monotonic() - started < 3.0
+        other.close()
+        idle.close()
+
+    def test_stop_releases_socket(self, running_daemon: DeviceDaemon) -> None:
+        """Test that a stop request shuts the daemon down cleanly."""
+        client = connect_daemon(running_daemon.socket_path)
+        assert client is not None
+
+        client.stop()
+        client.close()
+
+        for _ in range(50):
+            if not running_daemon.socket_path.exists():
+                break
+            threading.Event().wait(0.1)
+        assert not running_daemon.socket_path.exists()
+        assert running_daemon.decklink is None
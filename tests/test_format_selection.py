@@ -0,0 +1,116 @@
+"""
+Tests for cost-model pixel format selection.
+
+These tests run against the mock DeckLink device, whose benchmark reports
+fixed synthetic pack costs and rejects formats without a packer.
+"""
+
+from collections.abc import Generator
+from pathlib import Path
+
+import pytest
+
+from bmd_sg.decklink.bmd_decklink import PixelFormatType
+from bmd_sg.decklink.format_selection import (
+    FormatCost,
+    choose_cheapest_format,
+    format_cost_cache_key,
+    load_format_costs,
+    select_pixel_format,
+)
+from bmd_sg.decklink.mock import MockBMDDeckLink, reset_mock_state
+
+
+@pytest.fixture
+def mock_device() -> Generator[MockBMDDeckLink]:
+    """Open a mock device with default configuration."""
+    reset_mock_state()
+    device = MockBMDDeckLink(0)
+    yield device
+    device.close()
+
+
+class TestChooseCheapestFormat:
+    """Tests for the pure cost-model choice."""
+
+    def test_cheapest_format_meeting_bit_depth(self) -> None:
+        """Test that cheaper formats below the bit depth are skipped."""
+        costs = [
+            FormatCost(PixelFormatType.FORMAT_8BIT_BGRA, 1.0),
+            FormatCost(PixelFormatType.FORMAT_10BIT_RGB, 3.0),
+            FormatCost(PixelFormatType.FORMAT_12BIT_RGBLE, 2.0),
+        ]
+        supported = [c.pixel_format for c in costs]
+
+        choice = choose_cheapest_format(costs, supported, min_bit_depth=10)
+
+        assert choice is not None
+        assert choice.pixel_format == PixelFormatType.FORMAT_12BIT_RGBLE
+
+    def test_unsupported_formats_are_ignored(self) -> None:
+        """Test that measured but unsupported formats are never chosen."""
+        costs = [
+            FormatCost(PixelFormatType.FORMAT_10BIT_RGB, 1.0),
+            FormatCost(PixelFormatType.FORMAT_12BIT_RGBLE, 2.0),
+        ]
+
+        choice = choose_cheapest_format(
+            costs, [PixelFormatType.FORMAT_12BIT_RGBLE], min_bit_depth=10
+        )
+
+        assert choice is not None
+        assert choice.pixel_format == PixelFormatType.FORMAT_12BIT_RGBLE
+
+    def test_no_candidate_returns_none(self) -> None:
+        """Test that no qualifying format yields None."""
+        costs = [FormatCost(PixelFormatType.FORMAT_8BIT_BGRA, 1.0)]
+
+        assert (
+            choose_cheapest_format(
+                costs, [PixelFormatType.FORMAT_8BIT_BGRA], min_bit_depth=10
+            )
+            is None
+        )
+
+
+class TestSelectPixelFormat:
+    """Tests for benchmarking and per-host caching."""
+
+    def test_selects_and_caches(
+        self, mock_device: MockBMDDeckLink, tmp_path: Path
+    ) -> None:
+        """Test that the first selection benchmarks and writes the cache."""
+        cache_path = tmp_path / "costs.json"
+
+        choice = select_pixel_format(
+            mock_device, "Mock", min_bit_depth=10, cache_path=cache_path
+        )
+
+        assert choice.pixel_format == PixelFormatType.FORMAT_10BIT_RGB
+        key = format_cost_cache_key("Mock", mock_device.display_mode)
+        cached = {c.pixel_format for c in load_format_costs(key, cache_path)}
+        assert set(mock_device.get_supported_pixel_formats()) == cached
+
+    def test_second_selection_uses_cache(
+        self, mock_device: MockBMDDeckLink, tmp_path: Path
+    ) -> None:
+        """Test that cached costs avoid re-benchmarking."""
+        cache_path = tmp_path / "costs.json"
+        select_pixel_format(mock_device, "Mock", cache_path=cache_path)
+        mock_device.clear_history()
+
+        choice = select_pixel_format(
+            mock_device, "Mock", min_bit_depth=12, cache_path=cache_path
+        )
+
+        assert choice.pixel_format == PixelFormatType.FORMAT_12BIT_RGBLE
+        assert mock_device.get_method_calls("benchmark_pixel_format") == []
+
+    def test_unreachable_bit_depth_raises(
+        self, mock_device: MockBMDDeckLink, tmp_path: Path
+    ) -> None:
+        """Test that an unsatisfiable bit depth raises RuntimeError."""
+        with pytest.raises(RuntimeError):
+            select_pixel_format(
+                mock_device, "Mock", min_bit_depth=16, cache_path=tmp_path / "c.json"
+            )
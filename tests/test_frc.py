@@ -0,0 +1,146 @@
+"""
+Tests for temporal dithering (FRC).
+
+The duty split and cycle layout are the library's own, run without a device
+through ``plan_frc``. The mock DeckLink device lays out its frames with the
+same call, so the frame tests check the patch and background around them.
+"""
+
+from collections.abc import Generator
+
+import numpy as np
+import pytest
+
+from bmd_sg.decklink.bmd_decklink import PixelFormatType, plan_frc
+from bmd_sg.decklink.mock import MockBMDDeckLink, reset_mock_state
+
+ROI = (4, 2, 6, 3)
+
+
+@pytest.fixture
+def running_device() -> Generator[MockBMDDeckLink]:
+    """Open a 10-bit mock device with output started and a small frame."""
+    reset_mock_state()
+    device = MockBMDDeckLink(0)
+    device.pixel_format = PixelFormatType.FORMAT_10BIT_RGB
+    device.start_playback()
+    device.display_frame(np.zeros((8, 16, 3), dtype=np.uint16))
+    yield device
+    device.close()
+
+
+def roi_levels(device: MockBMDDeckLink) -> np.ndarray:
+    """Patch code values per cycle frame, shape (cycle_frames, 3)."""
+    x, y, _, _ = ROI
+    return np.array([frame[y, x] for frame in device.get_frc_sequence()], dtype=int)
+
+
+class TestFrcDutySplit:
+    """Tests for splitting fractional targets into code values and duty."""
+
+    def test_fractions_become_duty_frames(self) -> None:
+        """Test that each fraction is quantized to a duty per cycle."""
+        status, _ = plan_frc([100.25, 200.5, 300.0], 8, 1023)
+
+        assert list(status.low) == [100, 200, 300]
+        assert list(status.dutyFrames) == [2, 4, 0]
+        assert list(status.achieved) == pytest.approx([100.25, 200.5, 300.0])
+        assert status.cycleFrames == 8
+
+    def test_fraction_rounding_to_full_duty_carries(self) -> None:
+        """Test that a fraction rounding to a full cycle moves up one code."""
+        status, _ = plan_frc([99.99, 0.01, 512.5], 4, 1023)
+
+        assert list(status.low) == [100, 0, 512]
+        assert list(status.dutyFrames) == [0, 0, 2]
+
+    def test_half_duty_rounds_up(self) -> None:
+        """Test that a fraction of exactly half a frame gets the frame."""
+        status, _ = plan_frc([10.0625, 20.1875, 30.0], 8, 1023)
+
+        assert list(status.dutyFrames) == [1, 2, 0]
+
+    def test_target_clamped_to_max_code(self) -> None:
+        """Test that targets at or above full scale hold the maximum code."""
+        status, _ = plan_frc([1023.5, 2000.0, 1022.5], 8, 1023)
+
+        assert list(status.low) == [1023, 1023, 1022]
+        assert list(status.dutyFrames) == [0, 0, 4]
+
+    @pytest.mark.parametrize(
+        ("target", "cycle_frames"), [([1.0, -0.5, 2.0], 8), ([1.0, 1.0, 1.0], 65)]
+    )
+    def test_invalid_request_rejected(
+        self, target: list[float], cycle_frames: int
+    ) -> None:
+        """Test that a negative target or an oversized cycle is refused."""
+        with pytest.raises(ValueError, match="non-negative"):
+            plan_frc(target, cycle_frames, 1023)
+
+    def test_device_reports_planned_levels(
+        self, running_device: MockBMDDeckLink
+    ) -> None:
+        """Test that the device starts the levels the planner gives."""
+        status = running_device.start_frc([64.375, 128.75, 256.125], ROI)
+        planned, _ = plan_frc([64.375, 128.75, 256.125], 8, 1023)
+
+        assert list(status.low) == list(planned.low)
+        assert list(status.dutyFrames) == list(planned.dutyFrames)
+
+
+class TestFrcSequence:
+    """Tests for the frames of one dither cycle."""
+
+    @pytest.mark.parametrize("cycle_frames", [5, 8, 13])
+    def test_upper_frames_spread_evenly(self, cycle_frames: int) -> None:
+        """Test that upper frames follow the Bresenham running count."""
+        status, high = plan_frc([10.2, 20.55, 30.9], cycle_frames, 1023)
+
+        assert high.shape == (cycle_frames, 3)
+        assert set(np.unique(high)) <= {0, 1}
+        for c in range(3):
+            duty = status.dutyFrames[c]
+            prefix = np.cumsum(high[:, c])
+            expected = [(k + 1) * duty // cycle_frames for k in range(cycle_frames)]
+            assert list(prefix) == expected
+
+    def test_patch_follows_planned_cycle(self, running_device: MockBMDDeckLink) -> None:
+        """Test that each frame's patch shows the planned level for it."""
+        status = running_device.start_frc([10.2, 20.55, 30.9], ROI, cycle_frames=13)
+        _, high = plan_frc([10.2, 20.55, 30.9], 13, 1023)
+
+        np.testing.assert_array_equal(
+            roi_levels(running_device), np.array(status.low) + high
+        )
+
+    def test_cycle_mean_is_achieved_level(
+        self, running_device: MockBMDDeckLink
+    ) -> None:
+        """Test that the patch averages to the reported level over a cycle."""
+        status = running_device.start_frc([64.375, 128.75, 256.125], ROI)
+
+        assert roi_levels(running_device).mean(axis=0) == pytest.approx(
+            list(status.achieved)
+        )
+
+    def test_background_outside_patch_untouched(
+        self, running_device: MockBMDDeckLink
+    ) -> None:
+        """Test that only the patch is dithered."""
+        background = np.full((8, 16, 3), 7, dtype=np.uint16)
+        running_device.start_frc([50.5, 50.5, 50.5], ROI, background=background)
+
+        x, y, w, h = ROI
+        for frame in running_device.get_frc_sequence():
+            outside = frame.copy()
+            outside[y : y + h, x : x + w] = 7
+            np.testing.assert_array_equal(outside, background)
+
+    def test_start_requires_running_output(self) -> None:
+        """Test that dithering is refused before output is started."""
+        reset_mock_state()
+        device = MockBMDDeckLink(0)
+
+        with pytest.raises(RuntimeError, match="error -1"):
+            device.start_frc([1.5, 1.5, 1.5])
+        device.close()
@@ -0,0 +1,137 @@
+"""
+Tests for pipelined measurement runs.
+
+These tests drive ``MeasurementOrchestrator`` against the mock DeckLink
+device, whose frame cache they inspect from inside the meter while a run is
+in progress.
+"""
+
+from collections.abc import Generator, Iterator
+from typing import Any
+
+import numpy as np
+import pytest
+
+from bmd_sg.decklink.mock import MockBMDDeckLink, reset_mock_state
+from bmd_sg.measurement import MeasurementOrchestrator, MeterReading, SimulatedMeter
+from bmd_sg.measurement.orchestrator import DEFAULT_FIRST_KEY
+
+PATCHES = [(code, code, code) for code in range(0, 1024, 128)]
+
+
+@pytest.fixture
+def mock_device() -> Generator[MockBMDDeckLink]:
+    """Open a mock device with default configuration."""
+    reset_mock_state()
+    device = MockBMDDeckLink(0)
+    yield device
+    device.close()
+
+
+def render(patch: tuple[int, int, int]) -> np.ndarray:
+    """Draw a patch as a small flat frame."""
+    return np.full((4, 8, 3), patch, dtype=np.uint16)
+
+
+class ProbeMeter(SimulatedMeter):
+    """Simulated meter that snapshots the device's frame cache per reading."""
+
+    def __init__(self, device: MockBMDDeckLink, fail_at: int = -1) -> None:
+        super().__init__(integration_s=0.0)
+        self.device = device
+        self.fail_at = fail_at
+        self.patches: list[Any] = []
+        self.cached: list[set[int]] = []
+
+    def measure(self, patch: Any) -> MeterReading:
+        """Record the patch and cache contents, then read or fail."""
+        if len(self.patches) == self.fail_at:
+            raise RuntimeError("Meter lost")
+        self.patches.append(patch)
+        self.cached.append(set(self.device._frame_cache))
+        return super().measure(patch)
+
+
+class TestMeasurementOrchestrator:
+    """Tests for measurement order, cache cleanup and lookahead."""
+
+    def test_readings_follow_patch_order(self, mock_device: MockBMDDeckLink) -> None:
+        """Test that patches are shown, read and reported in order."""
+        meter = ProbeMeter(mock_device)
+        reported: list[int] = []
+
+        run = MeasurementOrchestrator(mock_device, meter, lookahead=3).run(
+            PATCHES, render, on_measurement=lambda m: reported.append(m.index)
+        )
+
+        assert [m.patch for m in run.measurements] == PATCHES
+        assert [m.index for m in run.measurements] == list(range(len(PATCHES)))
+        assert meter.patches == PATCHES
+        assert reported == list(range(len(PATCHES)))
+        shown = mock_device.get_method_calls("display_cached_frame")
+        assert [call["key"] for call in shown] == [
+            DEFAULT_FIRST_KEY + i for i in range(len(PATCHES))
+        ]
+
+    def test_cache_entry_removed_after_each_reading(
+        self, mock_device: MockBMDDeckLink
+    ) -> None:
+        """Test that a patch's cache entry is gone by the next reading."""
+        meter = ProbeMeter(mock_device)
+
+        MeasurementOrchestrator(mock_device, meter, lookahead=2).run(PATCHES, render)
+
+        for index, cached in enumerate(meter.cached):
+            assert DEFAULT_FIRST_KEY + index in cached
+            assert not any(key < DEFAULT_FIRST_KEY + index for key in cached)
+        assert mock_device._frame_cache == {}
+
+    def test_cache_entries_removed_on_error(self, mock_device: MockBMDDeckLink) -> None:
+        """Test that a failing meter leaves no prepared frames behind."""
+        meter = ProbeMeter(mock_device, fail_at=3)
+
+        with pytest.raises(RuntimeError, match="Meter lost"):
+            MeasurementOrchestrator(mock_device, meter, lookahead=4).run(
+                PATCHES, render
+            )
+
+        assert len(meter.patches) == 3
+        assert mock_device._frame_cache == {}
+
+    @pytest.mark.parametrize("lookahead", [1, 3])
+    def test_lookahead_bounds_prepared_patches(
+        self, mock_device: MockBMDDeckLink, lookahead: int
+    ) -> None:
+        """Test that no more than the lookahead is consumed or cached ahead."""
+        consumed: list[int] = []
+
+        def patches() -> Iterator[tuple[int, int, int]]:
+            for patch in PATCHES:
+                consumed.append(len(consumed))
+                yield patch
+
+        meter = ProbeMeter(mock_device)
+        ahead: list[int] = []
+        original = meter.measure
+
+        def measure(patch: Any) -> MeterReading:
+            ahead.append(len(consumed) - len(meter.patches) - 1)
+            return original(patch)
+
+        meter.measure = measure  # type: ignore[method-assign]
+        MeasurementOrchestrator(mock_device, meter, lookahead=lookahead).run(
+            patches(), render
+        )
+
+        assert max(ahead) == lookahead
+        assert all(len(cached) <= lookahead + 1 for cached in meter.cached)
+
+    @pytest.mark.parametrize("lookahead", [0, 17])
+    def test_lookahead_out_of_range(
+        self, mock_device: MockBMDDeckLink, lookahead: int
+    ) -> None:
+        """Test that a lookahead outside 1-16 is rejected."""
+        with pytest.raises(ValueError, match="lookahead"):
+            MeasurementOrchestrator(
+                mock_device, SimulatedMeter(integration_s=0.0), lookahead=lookahead
+            )
@@ -0,0 +1,75 @@
+"""
+Tests for the reconfigure contract of the mock DeckLink device.
+
+The mock can be told to refuse enabling output in given display modes, the
+way EnableVideoOutput does for modes a card or link cannot carry. These
+tests check that the mock then keeps its previous configuration, which is
+what callers of ``BMDDeckLink.reconfigure`` rely on. They do not run the
+library's own commit and restore path, which needs a device.
+"""
+
+from collections.abc import Generator
+
+import pytest
+
+from bmd_sg.decklink.bmd_decklink import PixelFormatType
+from bmd_sg.decklink.mock import (
+    MockBMDDeckLink,
+    reset_mock_state,
+    set_rejected_display_modes,
+)
+
+HP30 = 0x48703330
+HP60 = 0x48703630
+
+
+@pytest.fixture
+def running_device() -> Generator[MockBMDDeckLink]:
+    """Open a mock device with output started."""
+    reset_mock_state()
+    device = MockBMDDeckLink(0)
+    device.start_playback()
+    yield device
+    device.close()
+
+
+class TestReconfigure:
+    """Tests for in-place reconfiguration of the mock output."""
+
+    def test_reconfigure_applies_changes(self, running_device: MockBMDDeckLink) -> None:
+        """Test that an accepted reconfigure changes format and mode."""
+        stats = running_device.reconfigure(
+            pixel_format=PixelFormatType.FORMAT_10BIT_RGB, display_mode=HP60
+        )
+
+        assert stats.pixelFormatChanged == 1
+        assert stats.displayModeChanged == 1
+        assert running_device.pixel_format == PixelFormatType.FORMAT_10BIT_RGB
+        assert running_device.display_mode == HP60
+
+    def test_failed_enable_keeps_previous_configuration(
+        self, running_device: MockBMDDeckLink
+    ) -> None:
+        """Test that a refused display mode leaves the old output running."""
+        set_rejected_display_modes([HP60])
+        pixel_format = running_device.pixel_format
+
+        with pytest.raises(RuntimeError, match="error -3"):
+            running_device.reconfigure(
+                pixel_format=PixelFormatType.FORMAT_10BIT_RGB, display_mode=HP60
+            )
+
+        assert running_device.pixel_format == pixel_format
+        assert running_device.display_mode == HP30
+        assert running_device.started
+
+    def test_rejected_mode_ignored_while_stopped(self) -> None:
+        """Test that a stopped output takes any mode without enabling it."""
+        reset_mock_state()
+        set_rejected_display_modes([HP60])
+        device = MockBMDDeckLink(0)
+
+        device.reconfigure(display_mode=HP60)
+
+        assert device.display_mode == HP60
+        device.close()
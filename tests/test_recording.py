@@ -0,0 +1,263 @@
+"""
+Tests for recording the output stream and replaying it.
+
+Files are written by the library's recorder and replays laid out by its
+replay planner, both run without a device. The mock DeckLink device records
+its uint16 RGB frames in place of packed data through ``RecordingWriter`` and
+replays through ``plan_replay``.
+"""
+
+from collections.abc import Generator
+from pathlib import Path
+
+import numpy as np
+import pytest
+
+from bmd_sg.decklink.bmd_decklink import (
+    HDRMetadata,
+    PixelFormatType,
+    RecordedFrame,
+    RecordingWriter,
+    plan_replay,
+    read_recording,
+)
+from bmd_sg.decklink.mock import MockBMDDeckLink, reset_mock_state
+
+# Matches kRecordingAlign in frame_recorder.h
+ALIGN = 4096
+
+# Nominal frame interval of the mock's default 1080p30 mode
+INTERVAL_NS = round(1e9 / 30.0)
+
+FORMAT = PixelFormatType.FORMAT_10BIT_RGB.sdk_format_code
+
+
+@pytest.fixture
+def running_device() -> Generator[MockBMDDeckLink]:
+    """Open a mock device with output started."""
+    reset_mock_state()
+    device = MockBMDDeckLink(0)
+    device.start_playback()
+    yield device
+    device.close()
+
+
+def flat(level: int) -> np.ndarray:
+    """A small flat frame."""
+    return np.full((4, 8, 3), level, dtype=np.uint16)
+
+
+def record(device: MockBMDDeckLink, path: Path, levels: list[int]) -> None:
+    """Record one flat frame per level."""
+    device.start_recording(path)
+    for level in levels:
+        device.display_frame(flat(level))
+    device.stop_recording()
+
+
+def retime(path: Path, timestamps: list[int]) -> None:
+    """Rewrite the frame timestamps of a recording in place."""
+    with open(path, "r+b") as f:
+        offset = ALIGN
+        for timestamp in timestamps:
+            f.seek(offset)
+            frame = RecordedFrame.from_buffer_copy(f.read(ALIGN))
+            frame.timestampNs = timestamp
+            f.seek(offset)
+            f.write(bytes(frame))
+            offset += ALIGN + -(-frame.frameBytes // ALIGN) * ALIGN
+
+
+class TestReadRecording:
+    """Tests for reading back a recorded output stream."""
+
+    def test_round_trip(self, running_device: MockBMDDeckLink, tmp_path: Path) -> None:
+        """Test that every output frame reads back in order, unchanged."""
+        path = tmp_path / "out.bmdrec"
+        levels = [100, 200, 200, 300]
+        record(running_device, path, levels)
+
+        frames = list(read_recording(path))
+
+        assert [frame.sequence for frame, _ in frames] == [0, 1, 2, 3]
+        for (frame, data), level in zip(frames, levels, strict=True):
+            assert (frame.width, frame.height) == (8, 4)
+            image = np.frombuffer(data, dtype=np.uint16).reshape(4, 8, 3)
+            np.testing.assert_array_equal(image, flat(level))
+        stats = running_device.recorder_stats()
+        assert stats.recorded == 4 and not stats.running
+        assert stats.bytesWritten == path.stat().st_size
+
+    def test_corrupt_frame_fails_crc(
+        self, running_device: MockBMDDeckLink, tmp_path: Path
+    ) -> None:
+        """Test that a changed data byte is caught, unless not verifying."""
+        path = tmp_path / "out.bmdrec"
+        record(running_device, path, [100, 200])
+        contents = bytearray(path.read_bytes())
+        contents[4 * ALIGN + 10] ^= 0xFF
+        path.write_bytes(bytes(contents))
+
+        with pytest.raises(ValueError, match="Frame 1 fails its CRC"):
+            list(read_recording(path))
+        assert len(list(read_recording(path, verify=False))) == 2
+
+    def test_truncated_file_rejected(
+        self, running_device: MockBMDDeckLink, tmp_path: Path
+    ) -> None:
+        """Test that a recording cut inside a frame raises ValueError."""
+        path = tmp_path / "out.bmdrec"
+        record(running_device, path, [100, 200])
+        path.write_bytes(path.read_bytes()[: 3 * ALIGN + 100])
+
+        with pytest.raises(ValueError, match="ends inside"):
+            list(read_recording(path))
+
+    def test_other_file_rejected(self, tmp_path: Path) -> None:
+        """Test that a file without the recording header is refused."""
+        path = tmp_path / "not.bmdrec"
+        path.write_bytes(bytes(ALIGN))
+
+        with pytest.raises(ValueError, match="not a recording"):
+            list(read_recording(path))
+
+
+def write(path: Path, frames: list[tuple[bytes, int]]) -> None:
+    """Record (data, timestamp) pairs with the library's recorder."""
+    writer = RecordingWriter(path, 0, FORMAT, INTERVAL_NS, 1 << 16, slots=8)
+    for data, timestamp in frames:
+        frame = RecordedFrame(
+            timestampNs=timestamp,
+            frameBytes=len(data),
+            pixelFormat=FORMAT,
+            width=len(data) // 4,
+            height=1,
+            rowBytes=len(data),
+        )
+        writer.record(data, frame)
+    assert writer.close().recorded == len(frames)
+
+
+class TestRecordingWriter:
+    """Tests for the library's recorder run without a device."""
+
+    def test_header_and_records_filled_in(self, tmp_path: Path) -> None:
+        """Test that the library numbers the frames and computes their CRCs."""
+        path = tmp_path / "out.bmdrec"
+        write(path, [(b"\x01" * 64, 10), (b"\x02" * 4100, 20)])
+
+        frames = list(read_recording(path))
+
+        assert [frame.sequence for frame, _ in frames] == [0, 1]
+        assert [len(data) for _, data in frames] == [64, 4100]
+        assert frames[1][0].timestampNs == 20
+        assert path.stat().st_size == ALIGN * (1 + 2 + 1 + 2)
+
+    def test_oversized_frame_counted_not_written(self, tmp_path: Path) -> None:
+        """Test that a frame larger than a slot is left out."""
+        path = tmp_path / "out.bmdrec"
+        writer = RecordingWriter(path, 0, FORMAT, INTERVAL_NS, 64)
+        writer.record(bytes(65), RecordedFrame(frameBytes=65, height=1))
+        writer.record(bytes(64), RecordedFrame(frameBytes=64, height=1))
+        stats = writer.close()
+
+        assert (stats.offered, stats.recorded, stats.oversized) == (2, 1, 1)
+        assert [frame.sequence for frame, _ in read_recording(path)] == [1]
+
+
+class TestPlanReplay:
+    """Tests for the library's replay layout run without a device."""
+
+    def test_repeats_share_and_frames_hold(self, tmp_path: Path) -> None:
+        """Test that equal frames share an index and each holds its duration."""
+        path = tmp_path / "out.bmdrec"
+        a, b = bytes(64), b"\x01" * 64
+        write(path, [(a, 0), (b, 2 * INTERVAL_NS), (a, 3 * INTERVAL_NS)])
+
+        sequence = plan_replay(path, FORMAT, INTERVAL_NS)
+
+        assert list(sequence) == [0, 0, 1, 0]
+
+    def test_other_pixel_format_refused(self, tmp_path: Path) -> None:
+        """Test that a recording in another format cannot be replayed."""
+        path = tmp_path / "out.bmdrec"
+        write(path, [(bytes(64), 0)])
+
+        other = PixelFormatType.FORMAT_8BIT_BGRA.sdk_format_code
+        with pytest.raises(ValueError, match="error -1"):
+            plan_replay(path, other, INTERVAL_NS)
+
+    def test_unreadable_file_refused(self, tmp_path: Path) -> None:
+        """Test that a missing file is reported as unreadable."""
+        with pytest.raises(ValueError, match="error -2"):
+            plan_replay(tmp_path / "missing.bmdrec", FORMAT, INTERVAL_NS)
+
+
+class TestPlayRecording:
+    """Tests for replaying a recording through the clip player."""
+
+    def test_identical_frames_share_a_buffer(
+        self, running_device: MockBMDDeckLink, tmp_path: Path
+    ) -> None:
+        """Test that repeated frames are kept once but still played."""
+        path = tmp_path / "out.bmdrec"
+        record(running_device, path, [100, 200, 100, 200, 200, 300])
+
+        stats = running_device.play_recording(path)
+
+        assert stats.frames == 3
+        assert stats.sequenceLength == 6
+        assert stats.running
+
+    def test_metadata_keeps_frames_apart(
+        self, running_device: MockBMDDeckLink, tmp_path: Path
+    ) -> None:
+        """Test that equal pixels sent with different metadata are not merged."""
+        path = tmp_path / "out.bmdrec"
+        running_device.start_recording(path)
+        running_device.display_frame(flat(100))
+        running_device.set_hdr_metadata(HDRMetadata(max_cll=1000, max_fall=400))
+        running_device.display_frame(flat(100))
+        running_device.stop_recording()
+
+        assert running_device.play_recording(path).frames == 2
+
+    def test_frames_held_for_recorded_duration(
+        self, running_device: MockBMDDeckLink, tmp_path: Path
+    ) -> None:
+        """Test that a frame shown for several intervals is replayed as long."""
+        path = tmp_path / "out.bmdrec"
+        record(running_device, path, [100, 200, 300])
+        # Held for three intervals, then 1.6 which rounds to two, then the last
+        retime(path, [0, 3 * INTERVAL_NS, 4 * INTERVAL_NS + 6 * INTERVAL_NS // 10])
+
+        stats = running_device.play_recording(path)
+
+        assert stats.frames == 3
+        assert stats.sequenceLength == 3 + 2 + 1
+
+    def test_replay_requires_running_output(self, tmp_path: Path) -> None:
+        """Test that a replay is refused before output is started."""
+        reset_mock_state()
+        device = MockBMDDeckLink(0)
+        path = tmp_path / "out.bmdrec"
+        device.start_playback()
+        record(device, path, [100])
+        device.stop_playback()
+
+        with pytest.raises(RuntimeError, match="error -1"):
+            device.play_recording(path)
+        device.close()
+
+    def test_corrupt_recording_refused(
+        self, running_device: MockBMDDeckLink, tmp_path: Path
+    ) -> None:
+        """Test that a recording failing its CRC check is not replayed."""
+        path = tmp_path / "out.bmdrec"
+        record(running_device, path, [100])
+        contents = bytearray(path.read_bytes())
+        contents[2 * ALIGN] ^= 0xFF
+        path.write_bytes(bytes(contents))
+
+        with pytest.raises(RuntimeError, match="error -5"):
+            running_device.play_recording(path)
@@ -0,0 +1,290 @@
+"""
+Tests for the Chrome trace exporter.
+
+The library side of a trace runs against a fake of the library's tracing
+entry points, whose clock runs a fixed offset behind Python's.
+"""
+
+import json
+import threading
+import time
+from collections.abc import Generator
+from pathlib import Path
+from typing import Any
+
+import pytest
+
+from bmd_sg.decklink.bmd_decklink import TRACE_STAGES, TraceStats, TraceThread
+from bmd_sg.utilities import tracing
+from bmd_sg.utilities.tracing import Tracer, traced, tracer
+
+LIBRARY_CLOCK_OFFSET_NS = 5_000_000_000
+WORKER_THREAD_ID = 999_001
+
+
+class FakeTraceLibrary:
+    """The library's tracing entry points, recording into a list."""
+
+    def __init__(self) -> None:
+        self.enabled = False
+        self.frame_ids: list[int] = []
+        self.pending: list[tuple[int, int, int, int, int]] = []
+        self.lost = 3
+
+    def emit(self, stage: str, thread_id: int, frame_id: int | None = None) -> None:
+        """Record a short span of a stage on a thread, in the library clock."""
+        start = self.decklink_trace_now_ns()
+        frame = self.frame_ids[-1] if frame_id is None else frame_id
+        self.pending.append(
+            (start, start + 2_000, frame, thread_id, TRACE_STAGES.index(stage))
+        )
+
+    def decklink_trace_set_enabled(self, enabled: bool) -> None:
+        self.enabled = enabled
+
+    def decklink_trace_set_frame(self, frame_id: int) -> None:
+        self.frame_ids.append(frame_id)
+
+    def decklink_trace_now_ns(self) -> int:
+        return time.monotonic_ns() - LIBRARY_CLOCK_OFFSET_NS
+
+    def decklink_trace_collect(self, buffer: Any, capacity: int) -> int:
+        count = min(len(self.pending), capacity)
+        for i, (start, end, frame, thread, stage) in enumerate(self.pending[:count]):
+            span = buffer[i]
+            span.startNs, span.endNs, span.frameId = start, end, frame
+            span.threadId, span.stage = thread, stage
+        del self.pending[:count]
+        return count
+
+    def decklink_trace_get_stats(self, stats: Any) -> int:
+        target: TraceStats = stats._obj
+        target.threads = 1
+        target.lost = self.lost
+        return 0
+
+    def decklink_trace_get_threads(self, buffer: Any, capacity: int) -> int:
+        buffer[0] = TraceThread(WORKER_THREAD_ID, b"output worker")
+        return 1
+
+
+@pytest.fixture
+def python_only(monkeypatch: pytest.MonkeyPatch) -> None:
+    """Trace without the library."""
+    monkeypatch.setattr(tracing, "_load_library", lambda: (None, ()))
+
+
+@pytest.fixture
+def library(monkeypatch: pytest.MonkeyPatch) -> FakeTraceLibrary:
+    """Trace with the fake library loaded."""
+    fake = FakeTraceLibrary()
+    monkeypatch.setattr(tracing, "_load_library", lambda: (fake, TRACE_STAGES))
+    return fake
+
+
+@pytest.fixture
+def global_tracer(python_only: None) -> Generator[Tracer]:
+    """The module tracer, started and stopped around the test."""
+    tracer.start()
+    yield tracer
+    if tracer.active:
+        tracer.stop()
+
+
+def events(trace: dict[str, Any], phase: str) -> list[dict[str, Any]]:
+    """Events of one phase, in trace order."""
+    return [event for event in trace["traceEvents"] if event["ph"] == phase]
+
+
+class TestTracer:
+    """Tests for recording Python spans."""
+
+    def test_inactive_tracer_records_nothing(self) -> None:
+        """Test that spans outside a trace are shared no-ops."""
+        inactive = Tracer()
+
+        with inactive.frame("request") as frame_id, inactive.span("work") as inner:
+            assert frame_id == inner == 0
+        assert inactive.span("a") is inactive.frame("b")
+
+    def test_nested_spans_share_the_frame(self, python_only: None) -> None:
+        """Test that nested spans and frames join the outer frame."""
+        session = Tracer()
+        session.start()
+        with session.frame("request", route="/pattern") as frame_id:
+            with session.span("render", "render"):
+                pass
+            with session.frame("display") as joined:
+                assert joined == frame_id
+        with session.frame("next") as second, session.span("pack") as inner:
+            assert inner == second != frame_id
+        with session.span("idle") as none:
+            assert none == 0
+        trace = session.stop()
+
+        spans = {event["name"]: event for event in events(trace, "X")}
+        assert spans["request"]["args"] == {"route": "/pattern", "frame": frame_id}
+        assert spans["render"]["cat"] == "render"
+        assert spans["display"]["args"]["frame"] == frame_id
+        assert "frame" not in spans["idle"]["args"]
+        assert trace["otherData"]["frames"] == 2
+        assert trace["otherData"]["python_spans"] == 6
+
+    def test_frame_lifetime_slice(self, python_only: None) -> None:
+        """Test that each frame gets a begin and end around its spans."""
+        session = Tracer()
+        session.start()
+        with session.frame("request"), session.span("render"):
+            time.sleep(0.001)
+        trace = session.stop()
+
+        request = next(e for e in events(trace, "X") if e["name"] == "request")
+        (begin,), (end,) = events(trace, "b"), events(trace, "e")
+        assert begin["ts"] == request["ts"]
+        assert end["ts"] == pytest.approx(request["ts"] + request["dur"], abs=0.002)
+        assert begin["id"] == end["id"] == request["args"]["frame"]
+        assert not events(trace, "s")
+
+    def test_spans_over_limit_dropped(
+        self, python_only: None, monkeypatch: pytest.MonkeyPatch
+    ) -> None:
+        """Test that spans past MAX_PYTHON_SPANS are counted, not kept."""
+        monkeypatch.setattr(tracing, "MAX_PYTHON_SPANS", 2)
+        session = Tracer()
+        session.start()
+        for _ in range(5):
+            with session.span("work"):
+                pass
+        trace = session.stop()
+
+        assert len(events(trace, "X")) == 2
+        assert trace["otherData"]["python_spans_dropped"] == 3
+
+    def test_start_and_stop_out_of_order(self, python_only: None) -> None:
+        """Test that a second start or an unmatched stop raises."""
+        session = Tracer()
+        with pytest.raises(RuntimeError, match="No trace"):
+            session.stop()
+        session.start()
+        with pytest.raises(RuntimeError, match="already in progress"):
+            session.start()
+        session.stop()
+
+    def test_trace_written_as_json(self, python_only: None, tmp_path: Path) -> None:
+        """Test that the file holds the returned trace and names threads."""
+        session = Tracer()
+        session.start()
+        with session.frame("request"):
+            pass
+        path = tmp_path / "trace.json"
+        trace = session.stop(path)
+
+        assert json.loads(path.read_text()) == trace
+        names = {e["tid"]: e["args"]["name"] for e in events(trace, "M") if "tid" in e}
+        assert names[threading.get_native_id()] == threading.current_thread().name
+
+
+class TestLibraryTrace:
+    """Tests for merging library spans into the trace."""
+
+    def test_library_follows_current_frame(self, library: FakeTraceLibrary) -> None:
+        """Test that the library is given each frame id and then cleared."""
+        session = Tracer()
+        session.start()
+        assert library.enabled
+        with session.frame("request") as frame_id:
+            with session.frame("display"):
+                pass
+            assert library.frame_ids == [frame_id, frame_id, frame_id]
+        session.stop()
+
+        assert library.frame_ids[-1] == 0
+        assert not library.enabled
+
+    def test_library_spans_on_python_clock(self, library: FakeTraceLibrary) -> None:
+        """Test that library spans are shifted onto the Python clock."""
+        session = Tracer()
+        session.start()
+        with session.frame("request") as frame_id:
+            library.emit("pack", threading.get_native_id())
+        library.emit("on_device", WORKER_THREAD_ID, frame_id)
+        trace = session.stop()
+
+        request, *native = events(trace, "X")
+        assert [e["name"] for e in native] == ["pack", "on_device"]
+        assert all(e["cat"] == "decklink" for e in native)
+        assert all(e["args"] == {"frame": frame_id} for e in native)
+        offset = trace["otherData"]["clock_offset_ns"]
+        assert offset == pytest.approx(LIBRARY_CLOCK_OFFSET_NS, abs=1_000_000)
+        # Emitted inside the request span, so it lies within it once shifted
+        assert request["ts"] - 50 <= native[0]["ts"]
+        assert native[0]["ts"] <= request["ts"] + request["dur"] + 50
+        assert native[0]["dur"] == 2.0
+        assert trace["otherData"]["library_spans"] == 2
+        assert trace["otherData"]["library_spans_lost"] == 3
+
+    def test_flow_links_threads_of_a_frame(self, library: FakeTraceLibrary) -> None:
+        """Test that a frame crossing threads gets start and finish flows."""
+        session = Tracer()
+        session.start()
+        with session.frame("request") as frame_id:
+            library.emit("copy", threading.get_native_id())
+        library.emit("dispatch", WORKER_THREAD_ID, frame_id)
+        library.emit("on_device", WORKER_THREAD_ID, frame_id)
+        trace = session.stop()
+
+        (start,), (finish,) = events(trace, "s"), events(trace, "f")
+        assert start["tid"] == threading.get_native_id()
+        assert finish["tid"] == WORKER_THREAD_ID
+        assert start["id"] == finish["id"] == frame_id
+        assert not events(trace, "t")
+        names = {e["tid"]: e["args"]["name"] for e in events(trace, "M") if "tid" in e}
+        assert names[WORKER_THREAD_ID] == "output worker"
+
+    def test_unknown_stage_named_by_index(self, library: FakeTraceLibrary) -> None:
+        """Test that a stage this version does not know still shows."""
+        session = Tracer()
+        session.start()
+        library.pending.append((0, 1_000, 0, WORKER_THREAD_ID, len(TRACE_STAGES)))
+        trace = session.stop()
+
+        (native,) = events(trace, "X")
+        assert native["name"] == f"stage {len(TRACE_STAGES)}"
+        assert native["args"] == {}
+
+
+class TestTraced:
+    """Tests for the span decorator."""
+
+    def test_calls_recorded_as_spans(self, global_tracer: Tracer) -> None:
+        """Test that each call is a span, and frame=True starts a frame."""
+
+        @traced("render", "render")
+        def render(value: int) -> int:
+            return value * 2
+
+        @traced("request", frame=True)
+        def request() -> int:
+            return render(3)
+
+        assert request() == 6
+        assert render(1) == 2
+        trace = global_tracer.stop()
+
+        spans = events(trace, "X")
+        assert [e["name"] for e in spans] == ["render", "request", "render"]
+        assert spans[0]["args"]["frame"] == spans[1]["args"]["frame"]
+        assert "frame" not in spans[2]["args"]
+
+    def test_untraced_call_passes_through(self) -> None:
+        """Test that the wrapper keeps the function's name and result."""
+
+        @traced("render")
+        def render(value: int) -> int:
+            """Double a value."""
+            return value * 2
+
+        assert not tracer.active
+        assert render(4) == 8
+        assert render.__name__ == "render"
+        assert render.__doc__ == "Double a value."